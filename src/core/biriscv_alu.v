@@ -25,7 +25,7 @@
 module biriscv_alu
 (
     // Inputs
-     input  [  3:0]  alu_op_i
+     input  [  4:0]  alu_op_i
     ,input  [ 31:0]  alu_a_i
     ,input  [ 31:0]  alu_b_i
 
@@ -56,10 +56,47 @@ reg [31:0]      shift_left_8_r;
 
 wire [31:0]     sub_res_w = alu_a_i - alu_b_i;
 
+//-----------------------------------------------------------------
+// Bit manipulation helpers (Zbb)
+//-----------------------------------------------------------------
+reg [5:0]       clz_r;
+reg [5:0]       ctz_r;
+reg [5:0]       cpop_r;
+reg [63:0]      rotate_r;
+integer         i;
+
+/* verilator lint_off WIDTH */
+always @ *
+begin
+    clz_r  = 6'd32;
+    ctz_r  = 6'd32;
+    cpop_r = 6'd0;
+
+    for (i = 0; i < 32; i = i + 1)
+    begin
+        if (alu_a_i[i])
+            clz_r = 6'd31 - i;
+        if (alu_a_i[31-i])
+            ctz_r = 6'd31 - i;
+        cpop_r = cpop_r + {5'b0, alu_a_i[i]};
+    end
+
+    // Rotate right by shift amount (rotate left by 32 - amount)
+    if (alu_op_i == `ALU_ROL)
+        rotate_r = {alu_a_i, alu_a_i} >> (6'd32 - {1'b0, alu_b_i[4:0]});
+    else
+        rotate_r = {alu_a_i, alu_a_i} >> alu_b_i[4:0];
+end
+/* verilator lint_on WIDTH */
+
+// Signed / unsigned less than
+wire            lt_signed_w   = (alu_a_i[31] != alu_b_i[31]) ? alu_a_i[31] : sub_res_w[31];
+wire            lt_unsigned_w = (alu_a_i < alu_b_i);
+
 //-----------------------------------------------------------------
 // ALU
 //-----------------------------------------------------------------
-always @ (alu_op_i or alu_a_i or alu_b_i or sub_res_w)
+always @ (alu_op_i or alu_a_i or alu_b_i or sub_res_w or clz_r or ctz_r or cpop_r or rotate_r or lt_signed_w or lt_unsigned_w)
 begin
     shift_right_fill_r = 16'b0;
     shift_right_1_r = 32'b0;
@@ -179,6 +216,57 @@ begin
             else
                 result_r  = sub_res_w[31] ? 32'h1 : 32'h0;            
        end       
+       //----------------------------------------------
+       // Bit manipulation (Zbb)
+       //----------------------------------------------
+       `ALU_MIN : 
+       begin
+            result_r      = lt_signed_w ? alu_a_i : alu_b_i;
+       end
+       `ALU_MAX : 
+       begin
+            result_r      = lt_signed_w ? alu_b_i : alu_a_i;
+       end
+       `ALU_MINU : 
+       begin
+            result_r      = lt_unsigned_w ? alu_a_i : alu_b_i;
+       end
+       `ALU_MAXU : 
+       begin
+            result_r      = lt_unsigned_w ? alu_b_i : alu_a_i;
+       end
+       `ALU_CLZ : 
+       begin
+            result_r      = {26'b0, clz_r};
+       end
+       `ALU_CTZ : 
+       begin
+            result_r      = {26'b0, ctz_r};
+       end
+       `ALU_CPOP : 
+       begin
+            result_r      = {26'b0, cpop_r};
+       end
+       `ALU_SEXTB : 
+       begin
+            result_r      = {{24{alu_a_i[7]}}, alu_a_i[7:0]};
+       end
+       `ALU_SEXTH : 
+       begin
+            result_r      = {{16{alu_a_i[15]}}, alu_a_i[15:0]};
+       end
+       `ALU_ROL, `ALU_ROR:
+       begin
+            result_r      = rotate_r[31:0];
+       end
+       `ALU_ORCB : 
+       begin
+            result_r      = {{8{|alu_a_i[31:24]}}, {8{|alu_a_i[23:16]}}, {8{|alu_a_i[15:8]}}, {8{|alu_a_i[7:0]}}};
+       end
+       `ALU_REV8 : 
+       begin
+            result_r      = {alu_a_i[7:0], alu_a_i[15:8], alu_a_i[23:16], alu_a_i[31:24]};
+       end
        default  : 
        begin
             result_r      = alu_a_i;
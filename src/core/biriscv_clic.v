@@ -0,0 +1,211 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+module biriscv_clic
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+     input           clk_i
+    ,input           rst_i
+
+    // Interrupt sources
+    ,input  [31:0]   intr_i
+    ,input           msip_i
+    ,input           mtip_i
+
+    // CSR read port
+    ,input  [11:0]   csr_raddr_i
+    ,output          csr_hit_o
+    ,output [31:0]   csr_rdata_o
+
+    // CSR write port
+    ,input  [11:0]   csr_waddr_i
+    ,input  [31:0]   csr_wdata_i
+
+    // Interrupt taken (clears edge triggered pending)
+    ,input           ack_i
+    ,input  [5:0]    ack_id_i
+
+    // Highest priority pending + enabled source
+    ,output          irq_valid_o
+    ,output [5:0]    irq_id_o
+    ,output [7:0]    irq_level_o
+    ,output          irq_shv_o
+);
+
+//-----------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------
+`include "biriscv_defs.v"
+
+//-----------------------------------------------------------------
+// Sources:
+// 3      - Machine software interrupt (mip.MSIP)
+// 7      - Machine timer interrupt (mip.MTIP)
+// 16..47 - intr_i[0..31]
+//
+// Each source has a clicint CSR (CSR_CLICINT + id);
+// [0] ip, [8] ie, [16] shv, [17] edge triggered, [31:24] level
+//-----------------------------------------------------------------
+localparam NUM_SRC   = 48;
+
+wire [NUM_SRC-1:0] src_w;
+
+assign src_w[2:0]   = 3'b0;
+assign src_w[3]     = msip_i;
+assign src_w[6:4]   = 3'b0;
+assign src_w[7]     = mtip_i;
+assign src_w[15:8]  = 8'b0;
+assign src_w[47:16] = intr_i;
+
+//-----------------------------------------------------------------
+// Per source state
+//-----------------------------------------------------------------
+reg [NUM_SRC-1:0] src_q;
+reg [NUM_SRC-1:0] ip_q;
+reg [NUM_SRC-1:0] ie_q;
+reg [NUM_SRC-1:0] shv_q;
+reg [NUM_SRC-1:0] edge_q;
+reg [7:0]         level_q[NUM_SRC-1:0];
+
+wire [11:0] csr_woff_w = csr_waddr_i - `CSR_CLICINT;
+wire [11:0] csr_roff_w = csr_raddr_i - `CSR_CLICINT;
+
+/* verilator lint_off WIDTH */
+wire        csr_wsel_w = (csr_waddr_i >= `CSR_CLICINT) && (csr_woff_w < NUM_SRC);
+wire        csr_rsel_w = (csr_raddr_i >= `CSR_CLICINT) && (csr_roff_w < NUM_SRC);
+/* verilator lint_on WIDTH */
+wire [5:0]  csr_wid_w  = csr_woff_w[5:0];
+wire [5:0]  csr_rid_w  = csr_roff_w[5:0];
+
+integer i;
+
+/* verilator lint_off WIDTH */
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    src_q   <= {NUM_SRC{1'b0}};
+    ip_q    <= {NUM_SRC{1'b0}};
+    ie_q    <= {NUM_SRC{1'b0}};
+    shv_q   <= {NUM_SRC{1'b0}};
+    edge_q  <= {NUM_SRC{1'b0}};
+
+    for (i=0;i<NUM_SRC;i=i+1)
+        level_q[i] <= 8'b0;
+end
+else
+begin
+    src_q   <= src_w;
+
+    for (i=0;i<NUM_SRC;i=i+1)
+    begin
+        // Edge triggered: latch rising edge until taken or cleared by SW
+        if (edge_q[i])
+        begin
+            if (src_w[i] && !src_q[i])
+                ip_q[i] <= 1'b1;
+            else if (ack_i && ack_id_i == i)
+                ip_q[i] <= 1'b0;
+            else if (csr_wsel_w && csr_wid_w == i)
+                ip_q[i] <= csr_wdata_i[0];
+        end
+        // Level triggered: follows source
+        else
+            ip_q[i] <= src_w[i];
+    end
+
+    if (csr_wsel_w)
+    begin
+        ie_q[csr_wid_w]    <= csr_wdata_i[8];
+        shv_q[csr_wid_w]   <= csr_wdata_i[16];
+        edge_q[csr_wid_w]  <= csr_wdata_i[17];
+        level_q[csr_wid_w] <= csr_wdata_i[31:24];
+    end
+end
+/* verilator lint_on WIDTH */
+
+assign csr_hit_o   = csr_rsel_w;
+assign csr_rdata_o = {level_q[csr_rid_w], 6'b0, edge_q[csr_rid_w], shv_q[csr_rid_w],
+                      7'b0, ie_q[csr_rid_w], 7'b0, ip_q[csr_rid_w]};
+
+//-----------------------------------------------------------------
+// Arbitration: highest level wins, ties go to the highest ID.
+// Result is registered - the level vs threshold check is done
+// by the CSR file against the live mil / mintthresh.
+//-----------------------------------------------------------------
+reg       best_valid_r;
+reg [5:0] best_id_r;
+reg [7:0] best_level_r;
+reg       best_shv_r;
+
+/* verilator lint_off WIDTH */
+always @ *
+begin
+    best_valid_r = 1'b0;
+    best_id_r    = 6'b0;
+    best_level_r = 8'b0;
+    best_shv_r   = 1'b0;
+
+    for (i=0;i<NUM_SRC;i=i+1)
+    begin
+        if (ip_q[i] && ie_q[i] && (!best_valid_r || level_q[i] >= best_level_r))
+        begin
+            best_valid_r = 1'b1;
+            best_id_r    = i;
+            best_level_r = level_q[i];
+            best_shv_r   = shv_q[i];
+        end
+    end
+end
+/* verilator lint_on WIDTH */
+
+reg       irq_valid_q;
+reg [5:0] irq_id_q;
+reg [7:0] irq_level_q;
+reg       irq_shv_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    irq_valid_q <= 1'b0;
+    irq_id_q    <= 6'b0;
+    irq_level_q <= 8'b0;
+    irq_shv_q   <= 1'b0;
+end
+else
+begin
+    // Don't re-present a source in the cycle its pending bit is cleared
+    irq_valid_q <= best_valid_r && !(ack_i && ack_id_i == best_id_r && edge_q[best_id_r]);
+    irq_id_q    <= best_id_r;
+    irq_level_q <= best_level_r;
+    irq_shv_q   <= best_shv_r;
+end
+
+assign irq_valid_o = irq_valid_q;
+assign irq_id_o    = irq_id_q;
+assign irq_level_o = irq_level_q;
+assign irq_shv_o   = irq_shv_q;
+
+endmodule
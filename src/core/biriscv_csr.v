@@ -30,6 +30,8 @@ module biriscv_csr
 #(
      parameter SUPPORT_MULDIV   = 1
     ,parameter SUPPORT_SUPER    = 1
+    ,parameter SUPPORT_RVC      = 0
+    ,parameter SUPPORT_CLIC     = 0
 )
 //-----------------------------------------------------------------
 // Ports
@@ -38,7 +40,8 @@ module biriscv_csr
     // Inputs
      input           clk_i
     ,input           rst_i
-    ,input           intr_i
+    ,input  [ 31:0]  intr_i
+    ,input           timer_intr_i
     ,input           opcode_valid_i
     ,input  [ 31:0]  opcode_opcode_i
     ,input  [ 31:0]  opcode_pc_i
@@ -67,12 +70,15 @@ module biriscv_csr
     ,output [ 31:0]  branch_csr_pc_o
     ,output [  1:0]  branch_csr_priv_o
     ,output          take_interrupt_o
+    ,output          irq_pending_o
     ,output          ifence_o
     ,output [  1:0]  mmu_priv_d_o
     ,output          mmu_sum_o
     ,output          mmu_mxr_o
     ,output          mmu_flush_o
     ,output [ 31:0]  mmu_satp_o
+    ,output [  2:0]  cbo_enable_o
+    ,output          cbo_inval_flush_o
 );
 
 
@@ -133,12 +139,15 @@ end
 
 wire satp_update_w = (opcode_valid_i && (set_r || clr_r) && csr_write_r && (opcode_opcode_i[31:20] == `CSR_SATP));
 
+// Younger instructions were decoded with the old cache block operation enables
+wire envcfg_update_w = (opcode_valid_i && (set_r || clr_r) && csr_write_r &&
+                        ((opcode_opcode_i[31:20] == `CSR_MENVCFG) || (opcode_opcode_i[31:20] == `CSR_SENVCFG)));
+
 //-----------------------------------------------------------------
 // CSR register file
 //-----------------------------------------------------------------
-wire timer_irq_w = 1'b0;
-
-wire [31:0] misa_w = SUPPORT_MULDIV ? (`MISA_RV32 | `MISA_RVI | `MISA_RVM): (`MISA_RV32 | `MISA_RVI);
+wire [31:0] misa_w = SUPPORT_MULDIV ? (`MISA_RV32 | `MISA_RVI | `MISA_RVM | `MISA_RVA): (`MISA_RV32 | `MISA_RVI | `MISA_RVA);
+wire [31:0] misa_c_w = SUPPORT_RVC ? `MISA_RVC : 32'b0;
 
 wire [31:0] csr_rdata_w;
 
@@ -148,19 +157,23 @@ wire [31:0] csr_target_w;
 wire [31:0] interrupt_w;
 wire [31:0] status_reg_w;
 wire [31:0] satp_reg_w;
+wire [31:0] menvcfg_reg_w;
+wire [31:0] senvcfg_reg_w;
 
 biriscv_csr_regfile
 #( .SUPPORT_MTIMECMP(1)
-  ,.SUPPORT_SUPER(SUPPORT_SUPER) )
+  ,.SUPPORT_SUPER(SUPPORT_SUPER)
+  ,.SUPPORT_CLIC(SUPPORT_CLIC) )
 u_csrfile
 (
      .clk_i(clk_i)
     ,.rst_i(rst_i)
 
-    ,.ext_intr_i(intr_i)
-    ,.timer_intr_i(timer_irq_w)
+    ,.ext_intr_i(|intr_i)
+    ,.timer_intr_i(timer_intr_i)
+    ,.clic_intr_i(intr_i)
     ,.cpu_id_i(cpu_id_i)
-    ,.misa_i(misa_w)
+    ,.misa_i(misa_w | misa_c_w)
 
     // Issue
     ,.csr_ren_i(opcode_valid_i)
@@ -184,9 +197,12 @@ u_csrfile
     ,.priv_o(current_priv_w)
     ,.status_o(status_reg_w)
     ,.satp_o(satp_reg_w)
+    ,.menvcfg_o(menvcfg_reg_w)
+    ,.senvcfg_o(senvcfg_reg_w)
 
     // Masked interrupt output
     ,.interrupt_o(interrupt_w)
+    ,.irq_pending_o(irq_pending_o)
 );
 
 //-----------------------------------------------------------------
@@ -232,7 +248,7 @@ begin
     else if (opcode_invalid_i || csr_fault_r)
         exception_e1_q  <= `EXCEPTION_ILLEGAL_INSTRUCTION;
     // Fence / MMU settings cause a pipeline flush
-    else if (satp_update_w || ifence_w || sfence_w)
+    else if (satp_update_w || envcfg_update_w || ifence_w || sfence_w)
         exception_e1_q  <= `EXCEPTION_FENCE;
     else
         exception_e1_q  <= `EXCEPTION_W'b0;
@@ -280,7 +296,7 @@ always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
     tlb_flush_q <= 1'b0;
 else
-    tlb_flush_q <= satp_update_w || sfence_w;
+    tlb_flush_q <= sfence_w; // TLB entries are ASID tagged
 
 //-----------------------------------------------------------------
 // ifence
@@ -334,4 +350,15 @@ assign mmu_flush_o      = tlb_flush_q;
 assign mmu_sum_o        = status_reg_w[`SR_SUM_R];
 assign mmu_mxr_o        = status_reg_w[`SR_MXR_R];
 
+//-----------------------------------------------------------------
+// Cache block operations
+//-----------------------------------------------------------------
+// Always enabled in M-mode, S-mode is controlled by menvcfg and U-mode by
+// both menvcfg and senvcfg.  CBIE = 01 (in either) makes cbo.inval a flush.
+wire [31:0] envcfg_w = (current_priv_w == `PRIV_MACHINE) ? 32'hFFFFFFFF :
+                       (current_priv_w == `PRIV_SUPER)   ? menvcfg_reg_w : (menvcfg_reg_w & senvcfg_reg_w);
+
+assign cbo_enable_o      = {envcfg_w[`ENVCFG_CBZE_R], envcfg_w[`ENVCFG_CBCFE_R], (envcfg_w[`ENVCFG_CBIE_R] != 2'b00)};
+assign cbo_inval_flush_o = (envcfg_w[`ENVCFG_CBIE_R] == `ENVCFG_CBIE_FLUSH);
+
 endmodule
@@ -28,7 +28,8 @@ module biriscv_csr_regfile
 //-----------------------------------------------------------------
 #(
      parameter SUPPORT_MTIMECMP    = 1,
-     parameter SUPPORT_SUPER       = 0
+     parameter SUPPORT_SUPER       = 0,
+     parameter SUPPORT_CLIC        = 0
 )
 //-----------------------------------------------------------------
 // Ports
@@ -39,6 +40,7 @@ module biriscv_csr_regfile
 
     ,input           ext_intr_i
     ,input           timer_intr_i
+    ,input  [31:0]   clic_intr_i
 
     ,input [31:0]    cpu_id_i
     ,input [31:0]    misa_i
@@ -63,9 +65,14 @@ module biriscv_csr_regfile
     ,output [1:0]    priv_o
     ,output [31:0]   status_o
     ,output [31:0]   satp_o
+    ,output [31:0]   menvcfg_o
+    ,output [31:0]   senvcfg_o
 
     // Masked interrupt output
     ,output [31:0]   interrupt_o
+
+    // Enabled interrupt pending (ignores global enables, for WFI)
+    ,output          irq_pending_o
 );
 
 //-----------------------------------------------------------------
@@ -89,9 +96,15 @@ reg [31:0]  csr_mcycle_h_q;
 reg [31:0]  csr_mscratch_q;
 reg [31:0]  csr_mtval_q;
 reg [31:0]  csr_mtimecmp_q;
+reg [31:0]  csr_mtimecmp_h_q;
 reg         csr_mtime_ie_q;
+reg [31:0]  csr_mtime_q;
+reg [31:0]  csr_mtime_h_q;
+reg [15:0]  csr_mtime_div_q;
+reg [15:0]  csr_mtime_pre_q;
 reg [31:0]  csr_medeleg_q;
 reg [31:0]  csr_mideleg_q;
+reg [31:0]  csr_menvcfg_q;
 
 // CSR - Supervisor
 reg [31:0]  csr_sepc_q;
@@ -100,6 +113,76 @@ reg [31:0]  csr_scause_q;
 reg [31:0]  csr_stval_q;
 reg [31:0]  csr_satp_q;
 reg [31:0]  csr_sscratch_q;
+reg [31:0]  csr_senvcfg_q;
+
+// CSR - CLIC
+reg [31:0]  csr_mtvt_q;
+reg [7:0]   csr_mil_q;
+reg [7:0]   csr_mpil_q;
+reg [7:0]   csr_mintthresh_q;
+
+// CLIC source selected for the interrupt that will be taken
+reg [5:0]   irq_clic_id_q;
+reg [7:0]   irq_clic_level_q;
+reg         irq_clic_shv_q;
+
+//-----------------------------------------------------------------
+// CLIC: Vectored, level prioritised interrupts (mtvec.mode = 3)
+//-----------------------------------------------------------------
+wire        clic_mode_w = SUPPORT_CLIC && (csr_mtvec_q[1:0] == `MTVEC_MODE_CLIC);
+
+wire        clic_valid_w;
+wire [5:0]  clic_id_w;
+wire [7:0]  clic_level_w;
+wire        clic_shv_w;
+wire        clic_hit_w;
+wire [31:0] clic_rdata_w;
+wire        clic_ack_w;
+
+generate
+if (SUPPORT_CLIC)
+begin
+    biriscv_clic
+    u_clic
+    (
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+
+        ,.intr_i(clic_intr_i)
+        ,.msip_i(csr_mip_q[`SR_IP_MSIP_R])
+        ,.mtip_i(csr_mip_q[`SR_IP_MTIP_R])
+
+        ,.csr_raddr_i(csr_raddr_i)
+        ,.csr_hit_o(clic_hit_w)
+        ,.csr_rdata_o(clic_rdata_w)
+
+        ,.csr_waddr_i((|exception_i) ? 12'b0 : csr_waddr_i)
+        ,.csr_wdata_i(csr_wdata_i)
+
+        ,.ack_i(clic_ack_w)
+        ,.ack_id_i(irq_clic_id_q)
+
+        ,.irq_valid_o(clic_valid_w)
+        ,.irq_id_o(clic_id_w)
+        ,.irq_level_o(clic_level_w)
+        ,.irq_shv_o(clic_shv_w)
+    );
+end
+else
+begin
+    assign clic_valid_w = 1'b0;
+    assign clic_id_w    = 6'b0;
+    assign clic_level_w = 8'b0;
+    assign clic_shv_w   = 1'b0;
+    assign clic_hit_w   = 1'b0;
+    assign clic_rdata_w = 32'b0;
+end
+endgenerate
+
+// Preempt only if above the current interrupt level (and threshold when in M-mode)
+wire [7:0]  clic_cur_level_w = (csr_mpriv_q != `PRIV_MACHINE)   ? 8'b0 :
+                               (csr_mil_q > csr_mintthresh_q)   ? csr_mil_q : csr_mintthresh_q;
+wire        clic_take_w      = clic_mode_w && clic_valid_w && (clic_level_w > clic_cur_level_w);
 
 //-----------------------------------------------------------------
 // Masked Interrupts
@@ -115,7 +198,18 @@ reg [31:0] s_interrupts_r;
 
 always @ *
 begin
-    if (SUPPORT_SUPER)
+    // CLIC mode: mie unused, the CLIC presents a single M-mode interrupt
+    if (clic_mode_w)
+    begin
+        irq_pending_r   = clic_take_w ? (32'b1 << `IRQ_M_EXT) : 32'b0;
+        m_enabled_r     = (csr_mpriv_q < `PRIV_MACHINE) || csr_sr_q[`SR_MIE_R];
+        s_enabled_r     = 1'b0;
+        m_interrupts_r  = m_enabled_r ? irq_pending_r : 32'b0;
+        s_interrupts_r  = 32'b0;
+        irq_masked_r    = m_interrupts_r;
+        irq_priv_r      = `PRIV_MACHINE;
+    end
+    else if (SUPPORT_SUPER)
     begin
         irq_pending_r   = (csr_mip_q & csr_mie_q);
         m_enabled_r     = (csr_mpriv_q < `PRIV_MACHINE) || (csr_mpriv_q == `PRIV_MACHINE && csr_sr_q[`SR_MIE_R]);
@@ -140,7 +234,24 @@ if (rst_i)
 else if (|irq_masked_r)
     irq_priv_q <= irq_priv_r;
 
-assign interrupt_o = irq_masked_r;
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    irq_clic_id_q    <= 6'b0;
+    irq_clic_level_q <= 8'b0;
+    irq_clic_shv_q   <= 1'b0;
+end
+else if (|irq_masked_r)
+begin
+    irq_clic_id_q    <= clic_id_w;
+    irq_clic_level_q <= clic_level_w;
+    irq_clic_shv_q   <= clic_shv_w;
+end
+
+assign clic_ack_w = clic_mode_w && ((exception_i & `EXCEPTION_TYPE_MASK) == `EXCEPTION_INTERRUPT);
+
+assign interrupt_o   = irq_masked_r;
+assign irq_pending_o = |irq_pending_r;
 
 
 reg csr_mip_upd_q;
@@ -155,6 +266,13 @@ else if (csr_waddr_i == `CSR_MIP || csr_waddr_i == `CSR_SIP || (|exception_i))
 
 wire buffer_mip_w = (csr_ren_i && csr_raddr_i == `CSR_MIP) | (csr_ren_i && csr_raddr_i == `CSR_SIP) | csr_mip_upd_q;
 
+//-----------------------------------------------------------------
+// Timer: 64-bit mtime, prescaled from the core clock by MTIMEDIV + 1
+//-----------------------------------------------------------------
+// NOTE: >= so that the prescaler or late mtimecmp writes cannot step over the match
+wire mtime_tick_w  = (csr_mtime_pre_q >= csr_mtime_div_q);
+wire mtime_match_w = ({csr_mtime_h_q, csr_mtime_q} >= {csr_mtimecmp_h_q, csr_mtimecmp_q});
+
 //-----------------------------------------------------------------
 // CSR Read Port
 //-----------------------------------------------------------------
@@ -168,20 +286,30 @@ begin
     `CSR_MSCRATCH: rdata_r = csr_mscratch_q & `CSR_MSCRATCH_MASK;
     `CSR_MEPC:     rdata_r = csr_mepc_q & `CSR_MEPC_MASK;
     `CSR_MTVEC:    rdata_r = csr_mtvec_q & `CSR_MTVEC_MASK;
-    `CSR_MCAUSE:   rdata_r = csr_mcause_q & `CSR_MCAUSE_MASK;
+    `CSR_MCAUSE:   rdata_r = clic_mode_w ? ((csr_mcause_q & `CSR_MCAUSE_CLIC_MASK) | {2'b0, csr_sr_q[`SR_MPP_R], csr_sr_q[`SR_MPIE_R], 3'b0, csr_mpil_q, 16'b0}) :
+                                           (csr_mcause_q & `CSR_MCAUSE_MASK);
     `CSR_MTVAL:    rdata_r = csr_mtval_q & `CSR_MTVAL_MASK;
     `CSR_MSTATUS:  rdata_r = csr_sr_q & `CSR_MSTATUS_MASK;
     `CSR_MIP:      rdata_r = csr_mip_q & `CSR_MIP_MASK;
     `CSR_MIE:      rdata_r = csr_mie_q & `CSR_MIE_MASK;
-    `CSR_MCYCLE,
-    `CSR_MTIME:    rdata_r = csr_mcycle_q;
-    `CSR_MTIMEH:   rdata_r = csr_mcycle_h_q;
+    `CSR_MCYCLE:   rdata_r = csr_mcycle_q;
+    `CSR_MCYCLEH:  rdata_r = csr_mcycle_h_q;
+    `CSR_MTIME:    rdata_r = csr_mtime_q;
+    `CSR_MTIMEH:   rdata_r = csr_mtime_h_q;
     `CSR_MHARTID:  rdata_r = cpu_id_i;
     `CSR_MISA:     rdata_r = misa_i;
     `CSR_MEDELEG:  rdata_r = SUPPORT_SUPER ? (csr_medeleg_q & `CSR_MEDELEG_MASK) : 32'b0;
     `CSR_MIDELEG:  rdata_r = SUPPORT_SUPER ? (csr_mideleg_q & `CSR_MIDELEG_MASK) : 32'b0;
+    `CSR_MENVCFG:  rdata_r = csr_menvcfg_q & `CSR_MENVCFG_MASK;
+    `CSR_MENVCFGH: rdata_r = 32'b0;
     // Non-std behaviour
-    `CSR_MTIMECMP: rdata_r = SUPPORT_MTIMECMP ? csr_mtimecmp_q : 32'b0;
+    `CSR_MTIMECMP:  rdata_r = SUPPORT_MTIMECMP ? csr_mtimecmp_q   : 32'b0;
+    `CSR_MTIMECMPH: rdata_r = SUPPORT_MTIMECMP ? csr_mtimecmp_h_q : 32'b0;
+    `CSR_MTIMEDIV:  rdata_r = {16'b0, csr_mtime_div_q};
+    // CLIC
+    `CSR_MTVT:       rdata_r = SUPPORT_CLIC ? (csr_mtvt_q & `CSR_MTVT_MASK) : 32'b0;
+    `CSR_MINTTHRESH: rdata_r = SUPPORT_CLIC ? {24'b0, csr_mintthresh_q}    : 32'b0;
+    `CSR_MINTSTATUS: rdata_r = SUPPORT_CLIC ? {csr_mil_q, 24'b0}           : 32'b0;
     // CSR - Super
     `CSR_SSTATUS:  rdata_r = SUPPORT_SUPER ? (csr_sr_q       & `CSR_SSTATUS_MASK)  : 32'b0;
     `CSR_SIP:      rdata_r = SUPPORT_SUPER ? (csr_mip_q      & `CSR_SIP_MASK)      : 32'b0;
@@ -192,7 +320,8 @@ begin
     `CSR_STVAL:    rdata_r = SUPPORT_SUPER ? (csr_stval_q    & `CSR_STVAL_MASK)    : 32'b0;
     `CSR_SATP:     rdata_r = SUPPORT_SUPER ? (csr_satp_q     & `CSR_SATP_MASK)     : 32'b0;
     `CSR_SSCRATCH: rdata_r = SUPPORT_SUPER ? (csr_sscratch_q & `CSR_SSCRATCH_MASK) : 32'b0;
-    default:       rdata_r = 32'b0;
+    `CSR_SENVCFG:  rdata_r = SUPPORT_SUPER ? (csr_senvcfg_q  & `CSR_SENVCFG_MASK)  : 32'b0;
+    default:       rdata_r = clic_hit_w ? clic_rdata_w : 32'b0;
     endcase
 end
 
@@ -200,6 +329,8 @@ assign csr_rdata_o = rdata_r;
 assign priv_o      = csr_mpriv_q;
 assign status_o    = csr_sr_q;
 assign satp_o      = csr_satp_q;
+assign menvcfg_o   = csr_menvcfg_q;
+assign senvcfg_o   = csr_senvcfg_q;
 
 //-----------------------------------------------------------------
 // CSR register next state
@@ -216,9 +347,12 @@ reg [1:0]   csr_mpriv_r;
 reg [31:0]  csr_mcycle_r;
 reg [31:0]  csr_mscratch_r;
 reg [31:0]  csr_mtimecmp_r;
+reg [31:0]  csr_mtimecmp_h_r;
 reg         csr_mtime_ie_r;
+reg [15:0]  csr_mtime_div_r;
 reg [31:0]  csr_medeleg_r;
 reg [31:0]  csr_mideleg_r;
+reg [31:0]  csr_menvcfg_r;
 
 reg [31:0]  csr_mip_next_q;
 reg [31:0]  csr_mip_next_r;
@@ -230,6 +364,13 @@ reg [31:0]  csr_scause_r;
 reg [31:0]  csr_stval_r;
 reg [31:0]  csr_satp_r;
 reg [31:0]  csr_sscratch_r;
+reg [31:0]  csr_senvcfg_r;
+
+// CSR - CLIC
+reg [31:0]  csr_mtvt_r;
+reg [7:0]   csr_mil_r;
+reg [7:0]   csr_mpil_r;
+reg [7:0]   csr_mintthresh_r;
 
 wire is_exception_w = ((exception_i & `EXCEPTION_TYPE_MASK) == `EXCEPTION_EXCEPTION);
 wire exception_s_w  = SUPPORT_SUPER ? ((csr_mpriv_q <= `PRIV_SUPER) & is_exception_w & csr_medeleg_q[{1'b0, exception_i[`EXCEPTION_SUBTYPE_R]}]) : 1'b0;
@@ -249,9 +390,12 @@ begin
     csr_mscratch_r  = csr_mscratch_q;
     csr_mcycle_r    = csr_mcycle_q + 32'd1;
     csr_mtimecmp_r  = csr_mtimecmp_q;
+    csr_mtimecmp_h_r = csr_mtimecmp_h_q;
     csr_mtime_ie_r  = csr_mtime_ie_q;
+    csr_mtime_div_r = csr_mtime_div_q;
     csr_medeleg_r   = csr_medeleg_q;
     csr_mideleg_r   = csr_mideleg_q;
+    csr_menvcfg_r   = csr_menvcfg_q;
 
     // CSR - Super
     csr_sepc_r      = csr_sepc_q;
@@ -260,6 +404,13 @@ begin
     csr_stval_r     = csr_stval_q;
     csr_satp_r      = csr_satp_q;
     csr_sscratch_r  = csr_sscratch_q;
+    csr_senvcfg_r   = csr_senvcfg_q;
+
+    // CSR - CLIC
+    csr_mtvt_r       = csr_mtvt_q;
+    csr_mil_r        = csr_mil_q;
+    csr_mpil_r       = csr_mpil_q;
+    csr_mintthresh_r = csr_mintthresh_q;
 
     // Interrupts
     if ((exception_i & `EXCEPTION_TYPE_MASK) == `EXCEPTION_INTERRUPT)
@@ -281,8 +432,15 @@ begin
             csr_mepc_r           = exception_pc_i;
             csr_mtval_r          = 32'b0;
 
+            // CLIC: cause is the source ID, raise interrupt level
+            if (clic_mode_w)
+            begin
+                csr_mcause_r = `MCAUSE_INTERRUPT + {26'b0, irq_clic_id_q};
+                csr_mpil_r   = csr_mil_q;
+                csr_mil_r    = irq_clic_level_q;
+            end
             // Piority encoded interrupt cause
-            if (interrupt_o[`IRQ_M_SOFT])
+            else if (interrupt_o[`IRQ_M_SOFT])
                 csr_mcause_r = `MCAUSE_INTERRUPT + 32'd`IRQ_M_SOFT;
             else if (interrupt_o[`IRQ_M_TIMER])
                 csr_mcause_r = `MCAUSE_INTERRUPT + 32'd`IRQ_M_TIMER;
@@ -330,6 +488,10 @@ begin
 
             // TODO: Set next MPP to user mode??
             csr_sr_r[`SR_MPP_R] = `SR_MPP_U;
+
+            // Interrupt level pop
+            if (clic_mode_w)
+                csr_mil_r = csr_mpil_q;
         end
         // SRET (return from supervisor)
         else
@@ -412,6 +574,10 @@ begin
 
         // Fault cause
         csr_mcause_r = {28'b0, exception_i[3:0]};
+
+        // Interrupt level unchanged (restored by MRET)
+        if (clic_mode_w)
+            csr_mpil_r = csr_mil_q;
     end
     else
     begin
@@ -420,19 +586,49 @@ begin
         `CSR_MSCRATCH: csr_mscratch_r = csr_wdata_i & `CSR_MSCRATCH_MASK;
         `CSR_MEPC:     csr_mepc_r     = csr_wdata_i & `CSR_MEPC_MASK;
         `CSR_MTVEC:    csr_mtvec_r    = csr_wdata_i & `CSR_MTVEC_MASK;
-        `CSR_MCAUSE:   csr_mcause_r   = csr_wdata_i & `CSR_MCAUSE_MASK;
+        `CSR_MCAUSE:
+        begin
+            // CLIC: mcause.mpp / mpie are aliases of mstatus
+            if (clic_mode_w)
+            begin
+                csr_mcause_r         = csr_wdata_i & `CSR_MCAUSE_CLIC_MASK;
+                csr_mpil_r           = csr_wdata_i[23:16];
+                csr_sr_r[`SR_MPP_R]  = csr_wdata_i[29:28];
+                csr_sr_r[`SR_MPIE_R] = csr_wdata_i[27];
+            end
+            else
+                csr_mcause_r = csr_wdata_i & `CSR_MCAUSE_MASK;
+        end
         `CSR_MTVAL:    csr_mtval_r    = csr_wdata_i & `CSR_MTVAL_MASK;
         `CSR_MSTATUS:  csr_sr_r       = csr_wdata_i & `CSR_MSTATUS_MASK;
         `CSR_MIP:      csr_mip_r      = csr_wdata_i & `CSR_MIP_MASK;
         `CSR_MIE:      csr_mie_r      = csr_wdata_i & `CSR_MIE_MASK;
         `CSR_MEDELEG:  csr_medeleg_r  = csr_wdata_i & `CSR_MEDELEG_MASK;
         `CSR_MIDELEG:  csr_mideleg_r  = csr_wdata_i & `CSR_MIDELEG_MASK;
+        `CSR_MENVCFG:
+        begin
+            csr_menvcfg_r = csr_wdata_i & `CSR_MENVCFG_MASK;
+            // CBIE = 10 is reserved - keep the previous setting
+            if (csr_wdata_i[`ENVCFG_CBIE_R] == 2'b10)
+                csr_menvcfg_r[`ENVCFG_CBIE_R] = csr_menvcfg_q[`ENVCFG_CBIE_R];
+        end
         // Non-std behaviour
         `CSR_MTIMECMP:
         begin
             csr_mtimecmp_r = csr_wdata_i & `CSR_MTIMECMP_MASK;
             csr_mtime_ie_r = 1'b1;
         end
+        // Upper half disarms the compare until the lower half is written
+        `CSR_MTIMECMPH:
+        begin
+            csr_mtimecmp_h_r = csr_wdata_i & `CSR_MTIMECMPH_MASK;
+            csr_mtime_ie_r   = 1'b0;
+        end
+        `CSR_MTIMEDIV:
+            csr_mtime_div_r  = csr_wdata_i[15:0] & `CSR_MTIMEDIV_MASK;
+        // CLIC
+        `CSR_MTVT:       csr_mtvt_r       = csr_wdata_i & `CSR_MTVT_MASK;
+        `CSR_MINTTHRESH: csr_mintthresh_r = csr_wdata_i[7:0];
         // CSR - Super
         `CSR_SEPC:     csr_sepc_r     = csr_wdata_i & `CSR_SEPC_MASK;
         `CSR_STVEC:    csr_stvec_r    = csr_wdata_i & `CSR_STVEC_MASK;
@@ -440,6 +636,13 @@ begin
         `CSR_STVAL:    csr_stval_r    = csr_wdata_i & `CSR_STVAL_MASK;
         `CSR_SATP:     csr_satp_r     = csr_wdata_i & `CSR_SATP_MASK;
         `CSR_SSCRATCH: csr_sscratch_r = csr_wdata_i & `CSR_SSCRATCH_MASK;
+        `CSR_SENVCFG:
+        begin
+            csr_senvcfg_r = csr_wdata_i & `CSR_SENVCFG_MASK;
+            // CBIE = 10 is reserved - keep the previous setting
+            if (csr_wdata_i[`ENVCFG_CBIE_R] == 2'b10)
+                csr_senvcfg_r[`ENVCFG_CBIE_R] = csr_senvcfg_q[`ENVCFG_CBIE_R];
+        end
         `CSR_SSTATUS:  csr_sr_r       = (csr_sr_r & ~`CSR_SSTATUS_MASK) | (csr_wdata_i & `CSR_SSTATUS_MASK);
         `CSR_SIP:      csr_mip_r      = (csr_mip_r & ~`CSR_SIP_MASK) | (csr_wdata_i & `CSR_SIP_MASK);
         `CSR_SIE:      csr_mie_r      = (csr_mie_r & ~`CSR_SIE_MASK) | (csr_wdata_i & `CSR_SIE_MASK);
@@ -455,13 +658,13 @@ begin
     if (timer_intr_i &&  csr_mideleg_q[`SR_IP_MTIP_R]) csr_mip_next_r[`SR_IP_STIP_R] = 1'b1;
     if (timer_intr_i && ~csr_mideleg_q[`SR_IP_MTIP_R]) csr_mip_next_r[`SR_IP_MTIP_R] = 1'b1;
 
-    // Optional: Internal timer compare interrupt
-    if (SUPPORT_MTIMECMP && csr_mcycle_q == csr_mtimecmp_q)
+    // Optional: Internal timer compare interrupt (once per mtimecmp write)
+    if (SUPPORT_MTIMECMP && csr_mtime_ie_q && mtime_match_w)
     begin
         if (csr_mideleg_q[`SR_IP_MTIP_R])
-            csr_mip_next_r[`SR_IP_STIP_R] = csr_mtime_ie_q;
+            csr_mip_next_r[`SR_IP_STIP_R] = 1'b1;
         else
-            csr_mip_next_r[`SR_IP_MTIP_R] = csr_mtime_ie_q;
+            csr_mip_next_r[`SR_IP_MTIP_R] = 1'b1;
         csr_mtime_ie_r  = 1'b0;
     end
 
@@ -478,6 +681,13 @@ end
 `define HAS_SIM_CTRL
 `endif
 
+`ifdef HAS_SIM_CTRL
+// Exit code of SIM_CTRL_EXIT - blocking assignment so it is already
+// visible when $finish is handled (vl_finish in the testbench)
+reg [7:0] sim_exit_code_q;
+initial sim_exit_code_q = 8'b0;
+`endif
+
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
 begin
@@ -494,9 +704,15 @@ begin
     csr_mcycle_h_q     <= 32'b0;
     csr_mscratch_q     <= 32'b0;
     csr_mtimecmp_q     <= 32'b0;
+    csr_mtimecmp_h_q   <= 32'b0;
     csr_mtime_ie_q     <= 1'b0;
+    csr_mtime_q        <= 32'b0;
+    csr_mtime_h_q      <= 32'b0;
+    csr_mtime_div_q    <= 16'b0;
+    csr_mtime_pre_q    <= 16'b0;
     csr_medeleg_q      <= 32'b0;
     csr_mideleg_q      <= 32'b0;
+    csr_menvcfg_q      <= 32'b0;
 
     // CSR - Super
     csr_sepc_q         <= 32'b0;
@@ -505,6 +721,13 @@ begin
     csr_stval_q        <= 32'b0;
     csr_satp_q         <= 32'b0;
     csr_sscratch_q     <= 32'b0;
+    csr_senvcfg_q      <= 32'b0;
+
+    // CSR - CLIC
+    csr_mtvt_q         <= 32'b0;
+    csr_mil_q          <= 8'b0;
+    csr_mpil_q         <= 8'b0;
+    csr_mintthresh_q   <= 8'b0;
 
     csr_mip_next_q     <= 32'b0;
 end
@@ -522,9 +745,12 @@ begin
     csr_mcycle_q       <= csr_mcycle_r;
     csr_mscratch_q     <= csr_mscratch_r;
     csr_mtimecmp_q     <= SUPPORT_MTIMECMP ? csr_mtimecmp_r : 32'b0;
+    csr_mtimecmp_h_q   <= SUPPORT_MTIMECMP ? csr_mtimecmp_h_r : 32'b0;
     csr_mtime_ie_q     <= SUPPORT_MTIMECMP ? csr_mtime_ie_r : 1'b0;
+    csr_mtime_div_q    <= csr_mtime_div_r;
     csr_medeleg_q      <= SUPPORT_SUPER ? (csr_medeleg_r   & `CSR_MEDELEG_MASK) : 32'b0;
     csr_mideleg_q      <= SUPPORT_SUPER ? (csr_mideleg_r   & `CSR_MIDELEG_MASK) : 32'b0;
+    csr_menvcfg_q      <= csr_menvcfg_r & `CSR_MENVCFG_MASK;
 
     // CSR - Super
     csr_sepc_q         <= SUPPORT_SUPER ? (csr_sepc_r     & `CSR_SEPC_MASK)     : 32'b0;
@@ -533,6 +759,13 @@ begin
     csr_stval_q        <= SUPPORT_SUPER ? (csr_stval_r    & `CSR_STVAL_MASK)    : 32'b0;
     csr_satp_q         <= SUPPORT_SUPER ? (csr_satp_r     & `CSR_SATP_MASK)     : 32'b0;
     csr_sscratch_q     <= SUPPORT_SUPER ? (csr_sscratch_r & `CSR_SSCRATCH_MASK) : 32'b0;
+    csr_senvcfg_q      <= SUPPORT_SUPER ? (csr_senvcfg_r  & `CSR_SENVCFG_MASK)  : 32'b0;
+
+    // CSR - CLIC
+    csr_mtvt_q         <= SUPPORT_CLIC ? csr_mtvt_r       : 32'b0;
+    csr_mil_q          <= SUPPORT_CLIC ? csr_mil_r        : 8'b0;
+    csr_mpil_q         <= SUPPORT_CLIC ? csr_mpil_r       : 8'b0;
+    csr_mintthresh_q   <= SUPPORT_CLIC ? csr_mintthresh_r : 8'b0;
 
     csr_mip_next_q     <= buffer_mip_w ? csr_mip_next_r : 32'b0;
 
@@ -540,6 +773,15 @@ begin
     if (csr_mcycle_q == 32'hFFFFFFFF)
         csr_mcycle_h_q <= csr_mcycle_h_q + 32'd1;
 
+    // Timer: mtime advances once every (MTIMEDIV + 1) cycles
+    if (mtime_tick_w)
+    begin
+        csr_mtime_pre_q <= 16'b0;
+        {csr_mtime_h_q, csr_mtime_q} <= {csr_mtime_h_q, csr_mtime_q} + 64'd1;
+    end
+    else
+        csr_mtime_pre_q <= csr_mtime_pre_q + 16'd1;
+
 `ifdef HAS_SIM_CTRL
     // CSR SIM_CTRL (or DSCRATCH)
     if ((csr_waddr_i == `CSR_DSCRATCH || csr_waddr_i == `CSR_SIM_CTRL) && ~(|exception_i))
@@ -547,7 +789,7 @@ begin
         case (csr_wdata_i & 32'hFF000000)
         `CSR_SIM_CTRL_EXIT:
         begin
-            //exit(csr_wdata_i[7:0]);
+            sim_exit_code_q = csr_wdata_i[7:0];
             $finish;
             $finish;
         end
@@ -566,6 +808,9 @@ end
 reg        branch_r;
 reg [31:0] branch_target_r;
 
+// CLIC mode: mtvec is 64 byte aligned, mode bits excluded from the trap address
+wire [31:0] mtvec_base_w = clic_mode_w ? {csr_mtvec_q[31:6], 6'b0} : csr_mtvec_q;
+
 always @ *
 begin
     branch_r        = 1'b0;
@@ -575,7 +820,11 @@ begin
     if (exception_i == `EXCEPTION_INTERRUPT)
     begin
         branch_r        = 1'b1;
-        branch_target_r = (irq_priv_q == `PRIV_MACHINE) ? csr_mtvec_q : csr_stvec_q;
+        branch_target_r = (irq_priv_q == `PRIV_MACHINE) ? mtvec_base_w : csr_stvec_q;
+
+        // CLIC: selective hardware vectoring - jump into the mtvt table entry for this source
+        if (clic_mode_w && irq_clic_shv_q)
+            branch_target_r = csr_mtvt_q + {24'b0, irq_clic_id_q, 2'b0};
     end
     // Exception return
     else if (exception_i >= `EXCEPTION_ERET_U && exception_i <= `EXCEPTION_ERET_M)
@@ -603,7 +852,7 @@ begin
     else if (is_exception_w)
     begin
         branch_r        = 1'b1;
-        branch_target_r = csr_mtvec_q;
+        branch_target_r = mtvec_base_w;
     end
     // Fence / SATP register writes cause pipeline flushes
     else if (exception_i == `EXCEPTION_FENCE)
@@ -617,11 +866,109 @@ assign csr_branch_o = branch_r;
 assign csr_target_o = branch_target_r;
 
 `ifdef verilator
+// Interrupt entry count (testbench latency measurement)
+reg [31:0] stats_irq_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    stats_irq_q <= 32'b0;
+else if ((exception_i & `EXCEPTION_TYPE_MASK) == `EXCEPTION_INTERRUPT)
+    stats_irq_q <= stats_irq_q + 32'd1;
+
 function [31:0] get_mcycle; /*verilator public*/
 begin
     get_mcycle = csr_mcycle_q;
 end
 endfunction
+function [31:0] get_irq_count; /*verilator public*/
+begin
+    get_irq_count = stats_irq_q;
+end
+endfunction
+
+// Idle skipping: the testbench stops clocking the core whilst it
+// sleeps in WFI, then advances mcycle / mtime by the cycles it skipped.
+// Cycles until an armed mtimecmp matches (all ones if none / far off)
+function [31:0] get_timer_cycles; /*verilator public*/
+    reg [63:0] mtime;
+    reg [63:0] delta;
+    reg [63:0] first;
+    reg [63:0] cycles;
+begin
+    mtime = {csr_mtime_h_q, csr_mtime_q};
+    delta = {csr_mtimecmp_h_q, csr_mtimecmp_q} - mtime;
+    first = (csr_mtime_pre_q >= csr_mtime_div_q) ? 64'd1 : {48'b0, csr_mtime_div_q - csr_mtime_pre_q} + 64'd1;
+
+    if (!SUPPORT_MTIMECMP || !csr_mtime_ie_q)
+        get_timer_cycles = 32'hFFFFFFFF;
+    else if (mtime_match_w)
+        get_timer_cycles = 32'b0;
+    else if (delta[63:32] != 32'b0)
+        get_timer_cycles = 32'hFFFFFFFF;
+    else
+    begin
+        // First tick, then one tick per (MTIMEDIV + 1) cycles
+        cycles = first + (delta - 64'd1) * ({48'b0, csr_mtime_div_q} + 64'd1);
+        get_timer_cycles = (cycles[63:32] != 32'b0) ? 32'hFFFFFFFF : cycles[31:0];
+    end
+end
+endfunction
+function [0:0] skip_cycles; /*verilator public*/
+    input [31:0] cycles;
+    reg   [32:0] sum;
+    reg   [47:0] pre;
+    reg   [47:0] ticks;
+    reg   [47:0] rem;
+begin
+    sum            = {1'b0, csr_mcycle_q} + {1'b0, cycles};
+    csr_mcycle_q   = sum[31:0];
+    csr_mcycle_h_q = csr_mcycle_h_q + {31'b0, sum[32]};
+
+    // mtime: as if the prescaler had counted through the skipped cycles
+    if (csr_mtime_pre_q > csr_mtime_div_q)
+        pre = {32'b0, csr_mtime_div_q} + {16'b0, cycles};
+    else
+        pre = {32'b0, csr_mtime_pre_q} + {16'b0, cycles};
+    ticks           = pre / ({32'b0, csr_mtime_div_q} + 48'd1);
+    rem             = pre % ({32'b0, csr_mtime_div_q} + 48'd1);
+    csr_mtime_pre_q = rem[15:0];
+    {csr_mtime_h_q, csr_mtime_q} = {csr_mtime_h_q, csr_mtime_q} + {16'b0, ticks};
+    skip_cycles     = 1'b1;
+end
+endfunction
+
+// Semihosting doorbell: writing CSR_SIM_HOST posts the request block
+// at the written address, the testbench services it from memory.
+reg [31:0] sim_host_addr_q;
+reg [31:0] sim_host_req_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    sim_host_addr_q <= 32'b0;
+    sim_host_req_q  <= 32'b0;
+end
+else if (csr_waddr_i == `CSR_SIM_HOST && ~(|exception_i))
+begin
+    sim_host_addr_q <= csr_wdata_i;
+    sim_host_req_q  <= sim_host_req_q + 32'd1;
+end
+
+function [31:0] get_host_req_count; /*verilator public*/
+begin
+    get_host_req_count = sim_host_req_q;
+end
+endfunction
+function [31:0] get_host_req_addr; /*verilator public*/
+begin
+    get_host_req_addr = sim_host_addr_q;
+end
+endfunction
+function [7:0] get_exit_code; /*verilator public*/
+begin
+    get_exit_code = sim_exit_code_q;
+end
+endfunction
 `endif
 
 endmodule
@@ -30,6 +30,8 @@ module biriscv_decode
 #(
      parameter SUPPORT_MULDIV   = 1
     ,parameter EXTRA_DECODE_STAGE = 0
+    ,parameter SUPPORT_RVC      = 0
+    ,parameter SUPPORT_BITMANIP = 0
 )
 //-----------------------------------------------------------------
 // Ports
@@ -40,7 +42,7 @@ module biriscv_decode
     ,input           rst_i
     ,input           fetch_in_valid_i
     ,input  [ 63:0]  fetch_in_instr_i
-    ,input  [  1:0]  fetch_in_pred_branch_i
+    ,input  [  3:0]  fetch_in_pred_branch_i
     ,input           fetch_in_fault_fetch_i
     ,input           fetch_in_fault_page_i
     ,input  [ 31:0]  fetch_in_pc_i
@@ -49,6 +51,7 @@ module biriscv_decode
     ,input           branch_request_i
     ,input  [ 31:0]  branch_pc_i
     ,input  [  1:0]  branch_priv_i
+    ,input  [  2:0]  cbo_enable_i
 
     // Outputs
     ,output          fetch_in_accept_o
@@ -65,6 +68,7 @@ module biriscv_decode
     ,output          fetch_out0_instr_csr_o
     ,output          fetch_out0_instr_rd_valid_o
     ,output          fetch_out0_instr_invalid_o
+    ,output          fetch_out0_instr_rvc_o
     ,output          fetch_out1_valid_o
     ,output [ 31:0]  fetch_out1_instr_o
     ,output [ 31:0]  fetch_out1_pc_o
@@ -78,33 +82,183 @@ module biriscv_decode
     ,output          fetch_out1_instr_csr_o
     ,output          fetch_out1_instr_rd_valid_o
     ,output          fetch_out1_instr_invalid_o
+    ,output          fetch_out1_instr_rvc_o
+    ,output          btb_stale_o
+    ,output [ 31:0]  btb_stale_pc_o
 );
 
 
 
 wire        enable_muldiv_w     = SUPPORT_MULDIV;
+wire        enable_bitmanip_w   = SUPPORT_BITMANIP;
 
 //-----------------------------------------------------------------
-// 2 cycle frontend latency
+// 2 cycle frontend latency (16-bit aligner + decode)
 //-----------------------------------------------------------------
 generate
-if (EXTRA_DECODE_STAGE)
+if (SUPPORT_RVC)
+begin
+    wire        align0_valid_w;
+    wire [31:0] align0_instr_w;
+    wire [31:0] align0_pc_w;
+    wire        align0_rvc_w;
+    wire        align0_fault_fetch_w;
+    wire        align0_fault_page_w;
+    wire        align1_valid_w;
+    wire [31:0] align1_instr_w;
+    wire [31:0] align1_pc_w;
+    wire        align1_rvc_w;
+    wire        align1_fault_fetch_w;
+    wire        align1_fault_page_w;
+    wire        align_accept_w;
+
+    fetch_align
+    u_align
+    (
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+
+        ,.flush_i(branch_request_i)
+
+        // Input side
+        ,.valid_i(fetch_in_valid_i)
+        ,.instr_i(fetch_in_instr_i)
+        ,.pred_i(fetch_in_pred_branch_i)
+        ,.fault_fetch_i(fetch_in_fault_fetch_i)
+        ,.fault_page_i(fetch_in_fault_page_i)
+        ,.pc_i(fetch_in_pc_i)
+        ,.accept_o(fetch_in_accept_o)
+
+        // Outputs
+        ,.valid0_o(align0_valid_w)
+        ,.instr0_o(align0_instr_w)
+        ,.pc0_o(align0_pc_w)
+        ,.rvc0_o(align0_rvc_w)
+        ,.fault_fetch0_o(align0_fault_fetch_w)
+        ,.fault_page0_o(align0_fault_page_w)
+        ,.valid1_o(align1_valid_w)
+        ,.instr1_o(align1_instr_w)
+        ,.pc1_o(align1_pc_w)
+        ,.rvc1_o(align1_rvc_w)
+        ,.fault_fetch1_o(align1_fault_fetch_w)
+        ,.fault_page1_o(align1_fault_page_w)
+        ,.accept_i(align_accept_w)
+
+        ,.btb_stale_o(btb_stale_o)
+        ,.btb_stale_pc_o(btb_stale_pc_o)
+    );
+
+    wire [7:0]  info0_in_w;
+    wire [7:0]  info1_in_w;
+    wire [31:1] fetch_out0_pc_w;
+    wire [31:1] fetch_out1_pc_w;
+
+    biriscv_decoder
+    u_dec0
+    (
+         .valid_i(align0_valid_w)
+        ,.fetch_fault_i(align0_fault_fetch_w | align0_fault_page_w)
+        ,.enable_muldiv_i(enable_muldiv_w)
+        ,.enable_bitmanip_i(enable_bitmanip_w)
+        ,.enable_cbo_i(cbo_enable_i)
+        ,.opcode_i(align0_instr_w)
+
+        ,.invalid_o(info0_in_w[7])
+        ,.exec_o(info0_in_w[6])
+        ,.lsu_o(info0_in_w[5])
+        ,.branch_o(info0_in_w[4])
+        ,.mul_o(info0_in_w[3])
+        ,.div_o(info0_in_w[2])
+        ,.csr_o(info0_in_w[1])
+        ,.rd_valid_o(info0_in_w[0])
+    );
+
+    biriscv_decoder
+    u_dec1
+    (
+         .valid_i(align1_valid_w)
+        ,.fetch_fault_i(align1_fault_fetch_w | align1_fault_page_w)
+        ,.enable_muldiv_i(enable_muldiv_w)
+        ,.enable_bitmanip_i(enable_bitmanip_w)
+        ,.enable_cbo_i(cbo_enable_i)
+        ,.opcode_i(align1_instr_w)
+
+        ,.invalid_o(info1_in_w[7])
+        ,.exec_o(info1_in_w[6])
+        ,.lsu_o(info1_in_w[5])
+        ,.branch_o(info1_in_w[4])
+        ,.mul_o(info1_in_w[3])
+        ,.div_o(info1_in_w[2])
+        ,.csr_o(info1_in_w[1])
+        ,.rd_valid_o(info1_in_w[0])
+    );
+
+    // Instruction PCs are no longer implied by the fetch block - carry them with the decode info
+    fetch_fifo
+    #( .OPC_INFO_W(42) )
+    u_fifo
+    (
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+
+        ,.flush_i(branch_request_i)
+
+        // Input side
+        ,.push_i(align0_valid_w)
+        ,.pc_in_i(align0_pc_w)
+        ,.valid1_in_i(align1_valid_w)
+        ,.data_in_i({align1_instr_w, align0_instr_w})
+        ,.info0_in_i({align0_pc_w[31:1], align0_rvc_w, info0_in_w, align0_fault_page_w, align0_fault_fetch_w})
+        ,.info1_in_i({align1_pc_w[31:1], align1_rvc_w, info1_in_w, align1_fault_page_w, align1_fault_fetch_w})
+        ,.accept_o(align_accept_w)
+
+        // Outputs
+        ,.valid0_o(fetch_out0_valid_o)
+        ,.pc0_out_o()
+        ,.data0_out_o(fetch_out0_instr_o)
+        ,.info0_out_o({fetch_out0_pc_w,            fetch_out0_instr_rvc_o,
+                       fetch_out0_instr_invalid_o, fetch_out0_instr_exec_o,
+                       fetch_out0_instr_lsu_o,     fetch_out0_instr_branch_o,
+                       fetch_out0_instr_mul_o,     fetch_out0_instr_div_o,
+                       fetch_out0_instr_csr_o,     fetch_out0_instr_rd_valid_o,
+                       fetch_out0_fault_page_o,    fetch_out0_fault_fetch_o})
+        ,.pop0_i(fetch_out0_accept_i)
+
+        ,.valid1_o(fetch_out1_valid_o)
+        ,.pc1_out_o()
+        ,.data1_out_o(fetch_out1_instr_o)
+        ,.info1_out_o({fetch_out1_pc_w,            fetch_out1_instr_rvc_o,
+                       fetch_out1_instr_invalid_o, fetch_out1_instr_exec_o,
+                       fetch_out1_instr_lsu_o,     fetch_out1_instr_branch_o,
+                       fetch_out1_instr_mul_o,     fetch_out1_instr_div_o,
+                       fetch_out1_instr_csr_o,     fetch_out1_instr_rd_valid_o,
+                       fetch_out1_fault_page_o,    fetch_out1_fault_fetch_o})
+        ,.pop1_i(fetch_out1_accept_i)
+    );
+
+    assign fetch_out0_pc_o = {fetch_out0_pc_w, 1'b0};
+    assign fetch_out1_pc_o = {fetch_out1_pc_w, 1'b0};
+end
+//-----------------------------------------------------------------
+// 2 cycle frontend latency
+//-----------------------------------------------------------------
+else if (EXTRA_DECODE_STAGE)
 begin
     wire        fetch_in_fault_page_w;
     wire        fetch_in_fault_fetch_w;
-    wire [1:0]  fetch_in_pred_branch_w;
+    wire [3:0]  fetch_in_pred_branch_w;
     wire [63:0] fetch_in_instr_raw_w;
     wire [63:0] fetch_in_instr_w;
     wire [31:0] fetch_in_pc_w;
     wire        fetch_in_valid_w;
 
-    reg [100:0] fetch_buffer_q;
+    reg [102:0] fetch_buffer_q;
 
     always @ (posedge clk_i or posedge rst_i)
     if (rst_i)
-        fetch_buffer_q <= 101'b0;
+        fetch_buffer_q <= 103'b0;
     else if (branch_request_i)
-        fetch_buffer_q <= 101'b0;
+        fetch_buffer_q <= 103'b0;
     else if (!fetch_in_valid_w || fetch_in_accept_o)
         fetch_buffer_q <= {fetch_in_fault_page_i, fetch_in_fault_fetch_i, fetch_in_pred_branch_i, fetch_in_instr_i, fetch_in_pc_i, fetch_in_valid_i};
 
@@ -129,6 +283,8 @@ begin
          .valid_i(fetch_in_valid_w)
         ,.fetch_fault_i(fetch_in_fault_fetch_w | fetch_in_fault_page_w)
         ,.enable_muldiv_i(enable_muldiv_w)
+        ,.enable_bitmanip_i(enable_bitmanip_w)
+        ,.enable_cbo_i(cbo_enable_i)
         ,.opcode_i(fetch_in_instr_w[31:0])
 
         ,.invalid_o(info0_in_w[7])
@@ -147,6 +303,8 @@ begin
          .valid_i(fetch_in_valid_w)
         ,.fetch_fault_i(fetch_in_fault_fetch_w | fetch_in_fault_page_w)
         ,.enable_muldiv_i(enable_muldiv_w)
+        ,.enable_bitmanip_i(enable_bitmanip_w)
+        ,.enable_cbo_i(cbo_enable_i)
         ,.opcode_i(fetch_in_instr_w[63:32])
 
         ,.invalid_o(info1_in_w[7])
@@ -171,7 +329,7 @@ begin
         // Input side
         ,.push_i(fetch_in_valid_w)
         ,.pc_in_i(fetch_in_pc_w)
-        ,.pred_in_i(fetch_in_pred_branch_w)
+        ,.valid1_in_i(~fetch_in_pred_branch_w[1])
         ,.data_in_i(fetch_in_instr_w)
         ,.info0_in_i({info0_in_w, fetch_in_fault_page_w, fetch_in_fault_fetch_w})
         ,.info1_in_i({info1_in_w, fetch_in_fault_page_w, fetch_in_fault_fetch_w})
@@ -198,6 +356,11 @@ begin
                        fetch_out1_fault_page_o,    fetch_out1_fault_fetch_o})
         ,.pop1_i(fetch_out1_accept_i)
     );
+
+    assign fetch_out0_instr_rvc_o = 1'b0;
+    assign fetch_out1_instr_rvc_o = 1'b0;
+    assign btb_stale_o            = 1'b0;
+    assign btb_stale_pc_o         = 32'b0;
 end
 //-----------------------------------------------------------------
 // 1 cycle frontend latency
@@ -216,7 +379,7 @@ begin
         // Input side
         ,.push_i(fetch_in_valid_i)
         ,.pc_in_i(fetch_in_pc_i)
-        ,.pred_in_i(fetch_in_pred_branch_i)
+        ,.valid1_in_i(~fetch_in_pred_branch_i[1])
         ,.data_in_i((fetch_in_fault_page_i | fetch_in_fault_fetch_i) ? 64'b0 : fetch_in_instr_i)
         ,.info0_in_i({fetch_in_fault_page_i, fetch_in_fault_fetch_i})
         ,.info1_in_i({fetch_in_fault_page_i, fetch_in_fault_fetch_i})
@@ -242,6 +405,8 @@ begin
          .valid_i(fetch_out0_valid_o)
         ,.fetch_fault_i(fetch_out0_fault_fetch_o | fetch_out0_fault_page_o)
         ,.enable_muldiv_i(enable_muldiv_w)
+        ,.enable_bitmanip_i(enable_bitmanip_w)
+        ,.enable_cbo_i(cbo_enable_i)
         ,.opcode_i(fetch_out0_instr_o)
 
         ,.invalid_o(fetch_out0_instr_invalid_o)
@@ -260,6 +425,8 @@ begin
          .valid_i(fetch_out1_valid_o)
         ,.fetch_fault_i(fetch_out1_fault_fetch_o | fetch_out1_fault_page_o)
         ,.enable_muldiv_i(enable_muldiv_w)
+        ,.enable_bitmanip_i(enable_bitmanip_w)
+        ,.enable_cbo_i(cbo_enable_i)
         ,.opcode_i(fetch_out1_instr_o)
 
         ,.invalid_o(fetch_out1_instr_invalid_o)
@@ -271,6 +438,11 @@ begin
         ,.csr_o(fetch_out1_instr_csr_o)
         ,.rd_valid_o(fetch_out1_instr_rd_valid_o)
     );
+
+    assign fetch_out0_instr_rvc_o = 1'b0;
+    assign fetch_out1_instr_rvc_o = 1'b0;
+    assign btb_stale_o            = 1'b0;
+    assign btb_stale_pc_o         = 32'b0;
 end
 endgenerate
 
@@ -298,7 +470,7 @@ module fetch_fifo
     // Input side
     ,input                  push_i
     ,input  [31:0]          pc_in_i
-    ,input  [1:0]           pred_in_i
+    ,input                  valid1_in_i
     ,input  [WIDTH-1:0]     data_in_i
     ,input [OPC_INFO_W-1:0] info0_in_i
     ,input [OPC_INFO_W-1:0] info1_in_i
@@ -387,7 +559,7 @@ begin
         info0_q[wr_ptr_q]   <= info0_in_i;
         info1_q[wr_ptr_q]   <= info1_in_i;
         valid0_q[wr_ptr_q]  <= 1'b1;
-        valid1_q[wr_ptr_q]  <= ~pred_in_i[0];
+        valid1_q[wr_ptr_q]  <= valid1_in_i;
         wr_ptr_q            <= wr_ptr_q + 1;
     end
 
@@ -425,4 +597,377 @@ assign info1_out_o   = info1_q[rd_ptr_q];
 
 
 
+endmodule
+
+module fetch_align
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+     input                  clk_i
+    ,input                  rst_i
+
+    ,input                  flush_i
+
+    // Input side (64-bit fetch block, 1 prediction bit per halfword)
+    ,input                  valid_i
+    ,input  [63:0]          instr_i
+    ,input  [3:0]           pred_i
+    ,input                  fault_fetch_i
+    ,input                  fault_page_i
+    ,input  [31:0]          pc_i
+    ,output                 accept_o
+
+    // Outputs (up to 2 expanded instructions per cycle)
+    ,output                 valid0_o
+    ,output [31:0]          instr0_o
+    ,output [31:0]          pc0_o
+    ,output                 rvc0_o
+    ,output                 fault_fetch0_o
+    ,output                 fault_page0_o
+    ,output                 valid1_o
+    ,output [31:0]          instr1_o
+    ,output [31:0]          pc1_o
+    ,output                 rvc1_o
+    ,output                 fault_fetch1_o
+    ,output                 fault_page1_o
+    ,input                  accept_i
+
+    // Prediction found on a halfword which does not end an instruction
+    ,output                 btb_stale_o
+    ,output [31:0]          btb_stale_pc_o
+);
+
+//-----------------------------------------------------------------
+// RVC expansion (illegal encodings expand to 0 - decoded as invalid)
+//-----------------------------------------------------------------
+function [31:0] rvc_expand;
+    input [15:0] c;
+    reg   [4:0]  rd_p;
+    reg   [4:0]  rs1_p;
+    reg   [4:0]  rd;
+    reg   [4:0]  rs2;
+begin
+    rd_p       = {2'b01, c[4:2]};
+    rs1_p      = {2'b01, c[9:7]};
+    rd         = c[11:7];
+    rs2        = c[6:2];
+    rvc_expand = 32'b0;
+
+    case ({c[1:0], c[15:13]})
+    // C.ADDI4SPN
+    5'b00_000:
+        if (c[12:5] != 8'b0)
+            rvc_expand = {2'b0, c[10:7], c[12:11], c[5], c[6], 2'b0, 5'd2, 3'b000, rd_p, 7'b0010011};
+    // C.LW
+    5'b00_010:
+        rvc_expand = {5'b0, c[5], c[12:10], c[6], 2'b0, rs1_p, 3'b010, rd_p, 7'b0000011};
+    // C.SW
+    5'b00_110:
+        rvc_expand = {5'b0, c[5], c[12], rd_p, rs1_p, 3'b010, c[11:10], c[6], 2'b0, 7'b0100011};
+    // C.ADDI / C.NOP
+    5'b01_000:
+        rvc_expand = {{7{c[12]}}, c[6:2], rd, 3'b000, rd, 7'b0010011};
+    // C.JAL
+    5'b01_001:
+        rvc_expand = {c[12], c[8], c[10:9], c[6], c[7], c[2], c[11], c[5:3], c[12], {8{c[12]}}, 5'd1, 7'b1101111};
+    // C.LI
+    5'b01_010:
+        rvc_expand = {{7{c[12]}}, c[6:2], 5'd0, 3'b000, rd, 7'b0010011};
+    // C.ADDI16SP / C.LUI
+    5'b01_011:
+        if ({c[12], c[6:2]} == 6'b0)
+            rvc_expand = 32'b0;
+        else if (rd == 5'd2)
+            rvc_expand = {{3{c[12]}}, c[4:3], c[5], c[2], c[6], 4'b0, 5'd2, 3'b000, 5'd2, 7'b0010011};
+        else
+            rvc_expand = {{15{c[12]}}, c[6:2], rd, 7'b0110111};
+    // C.SRLI / C.SRAI / C.ANDI / C.SUB / C.XOR / C.OR / C.AND
+    5'b01_100:
+        case (c[11:10])
+        2'b00:   if (!c[12]) rvc_expand = {7'b0000000, c[6:2], rs1_p, 3'b101, rs1_p, 7'b0010011};
+        2'b01:   if (!c[12]) rvc_expand = {7'b0100000, c[6:2], rs1_p, 3'b101, rs1_p, 7'b0010011};
+        2'b10:   rvc_expand = {{7{c[12]}}, c[6:2], rs1_p, 3'b111, rs1_p, 7'b0010011};
+        default:
+            if (!c[12])
+            case (c[6:5])
+            2'b00:   rvc_expand = {7'b0100000, rd_p, rs1_p, 3'b000, rs1_p, 7'b0110011};
+            2'b01:   rvc_expand = {7'b0000000, rd_p, rs1_p, 3'b100, rs1_p, 7'b0110011};
+            2'b10:   rvc_expand = {7'b0000000, rd_p, rs1_p, 3'b110, rs1_p, 7'b0110011};
+            default: rvc_expand = {7'b0000000, rd_p, rs1_p, 3'b111, rs1_p, 7'b0110011};
+            endcase
+        endcase
+    // C.J
+    5'b01_101:
+        rvc_expand = {c[12], c[8], c[10:9], c[6], c[7], c[2], c[11], c[5:3], c[12], {8{c[12]}}, 5'd0, 7'b1101111};
+    // C.BEQZ
+    5'b01_110:
+        rvc_expand = {{4{c[12]}}, c[6:5], c[2], 5'd0, rs1_p, 3'b000, c[11:10], c[4:3], c[12], 7'b1100011};
+    // C.BNEZ
+    5'b01_111:
+        rvc_expand = {{4{c[12]}}, c[6:5], c[2], 5'd0, rs1_p, 3'b001, c[11:10], c[4:3], c[12], 7'b1100011};
+    // C.SLLI
+    5'b10_000:
+        if (!c[12])
+            rvc_expand = {7'b0000000, c[6:2], rd, 3'b001, rd, 7'b0010011};
+    // C.LWSP
+    5'b10_010:
+        if (rd != 5'd0)
+            rvc_expand = {4'b0, c[3:2], c[12], c[6:4], 2'b0, 5'd2, 3'b010, rd, 7'b0000011};
+    // C.JR / C.MV / C.EBREAK / C.JALR / C.ADD
+    5'b10_100:
+        if (!c[12])
+        begin
+            if (rs2 != 5'd0)
+                rvc_expand = {7'b0000000, rs2, 5'd0, 3'b000, rd, 7'b0110011};
+            else if (rd != 5'd0)
+                rvc_expand = {12'b0, rd, 3'b000, 5'd0, 7'b1100111};
+        end
+        else
+        begin
+            if (rs2 != 5'd0)
+                rvc_expand = {7'b0000000, rs2, rd, 3'b000, rd, 7'b0110011};
+            else if (rd != 5'd0)
+                rvc_expand = {12'b0, rd, 3'b000, 5'd1, 7'b1100111};
+            else
+                rvc_expand = 32'h00100073;
+        end
+    // C.SWSP
+    5'b10_110:
+        rvc_expand = {4'b0, c[8:7], c[12], rs2, 5'd2, 3'b010, c[11:9], 2'b0, 7'b0100011};
+    default:
+        rvc_expand = 32'b0;
+    endcase
+end
+endfunction
+
+//-----------------------------------------------------------------
+// Registers
+//-----------------------------------------------------------------
+// Current fetch block
+reg                  blk_valid_q;
+reg [63:0]           blk_data_q;
+reg [31:3]           blk_pc_q;
+reg [1:0]            blk_idx_q;
+reg [3:0]            blk_pred_q;
+reg                  blk_fault_fetch_q;
+reg                  blk_fault_page_q;
+
+// Lower half of a 32-bit instruction which straddles two fetch blocks
+reg                  half_valid_q;
+reg [15:0]           half_data_q;
+reg [31:1]           half_pc_q;
+
+wire [15:0] h0_w = blk_data_q[15:0];
+
+// Residual halfword continues into this block
+wire join_w = half_valid_q && (blk_idx_q == 2'd0) && (blk_pc_q == (half_pc_q[31:3] + 29'd1));
+
+//-----------------------------------------------------------------
+// Instruction extraction
+//-----------------------------------------------------------------
+reg        valid0_r;
+reg [31:0] instr0_r;
+reg [31:0] pc0_r;
+reg        rvc0_r;
+reg        valid1_r;
+reg [31:0] instr1_r;
+reg [31:0] pc1_r;
+reg        rvc1_r;
+reg [2:0]  pos_r;
+reg        term_r;
+reg        save_half_r;
+reg        stale_r;
+reg [1:0]  stale_idx_r;
+reg [15:0] lo_r;
+reg [15:0] hi_r;
+
+/* verilator lint_off WIDTH */
+always @ *
+begin
+    valid0_r    = 1'b0;
+    instr0_r    = 32'b0;
+    pc0_r       = 32'b0;
+    rvc0_r      = 1'b0;
+    valid1_r    = 1'b0;
+    instr1_r    = 32'b0;
+    pc1_r       = 32'b0;
+    rvc1_r      = 1'b0;
+    pos_r       = {1'b0, blk_idx_q};
+    term_r      = 1'b0;
+    save_half_r = 1'b0;
+    stale_r     = 1'b0;
+    stale_idx_r = 2'b0;
+    lo_r        = 16'b0;
+    hi_r        = 16'b0;
+
+    if (!blk_valid_q)
+        ;
+    // Faulting block - single instruction carrying the fault
+    else if (blk_fault_fetch_q || blk_fault_page_q)
+    begin
+        valid0_r = 1'b1;
+        pc0_r    = join_w ? {half_pc_q, 1'b0} : {blk_pc_q, blk_idx_q, 1'b0};
+        term_r   = 1'b1;
+    end
+    else
+    begin
+        //-------------------------------------------------------------
+        // Slot 0
+        //-------------------------------------------------------------
+        if (join_w)
+        begin
+            valid0_r = 1'b1;
+            instr0_r = {h0_w, half_data_q};
+            pc0_r    = {half_pc_q, 1'b0};
+            term_r   = blk_pred_q[0];
+            pos_r    = 3'd1;
+        end
+        else
+        begin
+            lo_r = blk_data_q >> {pos_r[1:0], 4'b0};
+            hi_r = blk_data_q >> {pos_r[1:0] + 2'd1, 4'b0};
+
+            if (lo_r[1:0] != 2'b11)
+            begin
+                valid0_r = 1'b1;
+                instr0_r = {16'b0, lo_r};
+                pc0_r    = {blk_pc_q, pos_r[1:0], 1'b0};
+                rvc0_r   = 1'b1;
+                term_r   = blk_pred_q[pos_r[1:0]];
+                pos_r    = pos_r + 3'd1;
+            end
+            else if (pos_r[1:0] == 2'd3)
+            begin
+                save_half_r = !blk_pred_q[3];
+                stale_r     = blk_pred_q[3];
+                stale_idx_r = 2'd3;
+                pos_r       = 3'd4;
+            end
+            else
+            begin
+                valid0_r    = 1'b1;
+                instr0_r    = {hi_r, lo_r};
+                pc0_r       = {blk_pc_q, pos_r[1:0], 1'b0};
+                term_r      = blk_pred_q[pos_r[1:0]] | blk_pred_q[pos_r[1:0] + 2'd1];
+                stale_r     = blk_pred_q[pos_r[1:0]];
+                stale_idx_r = pos_r[1:0];
+                pos_r       = pos_r + 3'd2;
+            end
+        end
+
+        //-------------------------------------------------------------
+        // Slot 1
+        //-------------------------------------------------------------
+        if (valid0_r && !term_r && !pos_r[2])
+        begin
+            lo_r = blk_data_q >> {pos_r[1:0], 4'b0};
+            hi_r = blk_data_q >> {pos_r[1:0] + 2'd1, 4'b0};
+
+            if (lo_r[1:0] != 2'b11)
+            begin
+                valid1_r = 1'b1;
+                instr1_r = {16'b0, lo_r};
+                pc1_r    = {blk_pc_q, pos_r[1:0], 1'b0};
+                rvc1_r   = 1'b1;
+                term_r   = blk_pred_q[pos_r[1:0]];
+                pos_r    = pos_r + 3'd1;
+            end
+            else if (pos_r[1:0] == 2'd3)
+            begin
+                save_half_r = !blk_pred_q[3];
+                stale_r     = blk_pred_q[3];
+                stale_idx_r = 2'd3;
+                pos_r       = 3'd4;
+            end
+            else
+            begin
+                valid1_r    = 1'b1;
+                instr1_r    = {hi_r, lo_r};
+                pc1_r       = {blk_pc_q, pos_r[1:0], 1'b0};
+                term_r      = blk_pred_q[pos_r[1:0]] | blk_pred_q[pos_r[1:0] + 2'd1];
+                stale_r     = blk_pred_q[pos_r[1:0]];
+                stale_idx_r = pos_r[1:0];
+                pos_r       = pos_r + 3'd2;
+            end
+        end
+    end
+end
+/* verilator lint_on WIDTH */
+
+// Block fully consumed (or remainder discarded due to a predicted branch)
+wire done_w    = term_r || pos_r[2];
+wire advance_w = blk_valid_q && (accept_i || !valid0_r);
+
+//-----------------------------------------------------------------
+// Sequential
+//-----------------------------------------------------------------
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    blk_valid_q       <= 1'b0;
+    blk_data_q        <= 64'b0;
+    blk_pc_q          <= 29'b0;
+    blk_idx_q         <= 2'b0;
+    blk_pred_q        <= 4'b0;
+    blk_fault_fetch_q <= 1'b0;
+    blk_fault_page_q  <= 1'b0;
+    half_valid_q      <= 1'b0;
+    half_data_q       <= 16'b0;
+    half_pc_q         <= 31'b0;
+end
+else if (flush_i)
+begin
+    blk_valid_q       <= 1'b0;
+    half_valid_q      <= 1'b0;
+end
+else
+begin
+    if (advance_w)
+    begin
+        // Residual is only joined on the first pass through a block
+        half_valid_q  <= save_half_r;
+        half_data_q   <= blk_data_q[63:48];
+        half_pc_q     <= {blk_pc_q, 2'b11};
+
+        if (done_w)
+            blk_valid_q <= 1'b0;
+        else
+            blk_idx_q   <= pos_r[1:0];
+    end
+
+    if (valid_i && accept_o)
+    begin
+        blk_valid_q       <= 1'b1;
+        blk_data_q        <= instr_i;
+        blk_pc_q          <= pc_i[31:3];
+        blk_idx_q         <= pc_i[2:1];
+        blk_pred_q        <= pred_i;
+        blk_fault_fetch_q <= fault_fetch_i;
+        blk_fault_page_q  <= fault_page_i;
+    end
+end
+
+//-------------------------------------------------------------------
+// Combinatorial
+//-------------------------------------------------------------------
+assign accept_o       = !blk_valid_q || (advance_w && done_w);
+
+assign valid0_o       = valid0_r;
+assign instr0_o       = rvc0_r ? rvc_expand(instr0_r[15:0]) : instr0_r;
+assign pc0_o          = pc0_r;
+assign rvc0_o         = rvc0_r;
+assign fault_fetch0_o = blk_fault_fetch_q;
+assign fault_page0_o  = blk_fault_page_q;
+
+assign valid1_o       = valid1_r;
+assign instr1_o       = rvc1_r ? rvc_expand(instr1_r[15:0]) : instr1_r;
+assign pc1_o          = pc1_r;
+assign rvc1_o         = rvc1_r;
+assign fault_fetch1_o = 1'b0;
+assign fault_page1_o  = 1'b0;
+
+assign btb_stale_o    = advance_w && stale_r;
+assign btb_stale_pc_o = {blk_pc_q, stale_idx_r, 1'b0};
+
 endmodule
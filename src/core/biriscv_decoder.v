@@ -29,6 +29,8 @@ module biriscv_decoder
      input                        valid_i
     ,input                        fetch_fault_i
     ,input                        enable_muldiv_i
+    ,input                        enable_bitmanip_i
+    ,input  [2:0]                 enable_cbo_i
     ,input  [31:0]                opcode_i
 
     ,output                       invalid_o
@@ -41,6 +43,49 @@ module biriscv_decoder
     ,output                       rd_valid_o
 );
 
+// Atomics (RV32A)
+wire atomic_w =     ((opcode_i & `INST_LR_W_MASK) == `INST_LR_W)              ||
+                    ((opcode_i & `INST_SC_W_MASK) == `INST_SC_W)              ||
+                    ((opcode_i & `INST_AMOSWAP_W_MASK) == `INST_AMOSWAP_W)    ||
+                    ((opcode_i & `INST_AMOADD_W_MASK) == `INST_AMOADD_W)      ||
+                    ((opcode_i & `INST_AMOXOR_W_MASK) == `INST_AMOXOR_W)      ||
+                    ((opcode_i & `INST_AMOAND_W_MASK) == `INST_AMOAND_W)      ||
+                    ((opcode_i & `INST_AMOOR_W_MASK) == `INST_AMOOR_W)        ||
+                    ((opcode_i & `INST_AMOMIN_W_MASK) == `INST_AMOMIN_W)      ||
+                    ((opcode_i & `INST_AMOMAX_W_MASK) == `INST_AMOMAX_W)      ||
+                    ((opcode_i & `INST_AMOMINU_W_MASK) == `INST_AMOMINU_W)    ||
+                    ((opcode_i & `INST_AMOMAXU_W_MASK) == `INST_AMOMAXU_W);
+
+// Cache block operations (Zicbom / Zicboz) - illegal unless enabled for the
+// current privilege level: [0] cbo.inval, [1] cbo.clean / cbo.flush, [2] cbo.zero
+wire cbo_w =        (enable_cbo_i[0] && (opcode_i & `INST_CBO_INVAL_MASK) == `INST_CBO_INVAL) ||
+                    (enable_cbo_i[1] && (opcode_i & `INST_CBO_CLEAN_MASK) == `INST_CBO_CLEAN) ||
+                    (enable_cbo_i[1] && (opcode_i & `INST_CBO_FLUSH_MASK) == `INST_CBO_FLUSH) ||
+                    (enable_cbo_i[2] && (opcode_i & `INST_CBO_ZERO_MASK) == `INST_CBO_ZERO);
+
+// Bit manipulation (Zba / Zbb)
+wire bitmanip_w =   ((opcode_i & `INST_SH1ADD_MASK) == `INST_SH1ADD) ||
+                    ((opcode_i & `INST_SH2ADD_MASK) == `INST_SH2ADD) ||
+                    ((opcode_i & `INST_SH3ADD_MASK) == `INST_SH3ADD) ||
+                    ((opcode_i & `INST_ANDN_MASK) == `INST_ANDN)     ||
+                    ((opcode_i & `INST_ORN_MASK) == `INST_ORN)       ||
+                    ((opcode_i & `INST_XNOR_MASK) == `INST_XNOR)     ||
+                    ((opcode_i & `INST_CLZ_MASK) == `INST_CLZ)       ||
+                    ((opcode_i & `INST_CTZ_MASK) == `INST_CTZ)       ||
+                    ((opcode_i & `INST_CPOP_MASK) == `INST_CPOP)     ||
+                    ((opcode_i & `INST_MIN_MASK) == `INST_MIN)       ||
+                    ((opcode_i & `INST_MAX_MASK) == `INST_MAX)       ||
+                    ((opcode_i & `INST_MINU_MASK) == `INST_MINU)     ||
+                    ((opcode_i & `INST_MAXU_MASK) == `INST_MAXU)     ||
+                    ((opcode_i & `INST_SEXT_B_MASK) == `INST_SEXT_B) ||
+                    ((opcode_i & `INST_SEXT_H_MASK) == `INST_SEXT_H) ||
+                    ((opcode_i & `INST_ZEXT_H_MASK) == `INST_ZEXT_H) ||
+                    ((opcode_i & `INST_ROL_MASK) == `INST_ROL)       ||
+                    ((opcode_i & `INST_ROR_MASK) == `INST_ROR)       ||
+                    ((opcode_i & `INST_RORI_MASK) == `INST_RORI)     ||
+                    ((opcode_i & `INST_ORC_B_MASK) == `INST_ORC_B)   ||
+                    ((opcode_i & `INST_REV8_MASK) == `INST_REV8);
+
 // Invalid instruction
 wire invalid_w =    valid_i && 
                    ~(((opcode_i & `INST_ANDI_MASK) == `INST_ANDI)             ||
@@ -81,6 +126,9 @@ wire invalid_w =    valid_i &&
                     ((opcode_i & `INST_SB_MASK) == `INST_SB)                  ||
                     ((opcode_i & `INST_SH_MASK) == `INST_SH)                  ||
                     ((opcode_i & `INST_SW_MASK) == `INST_SW)                  ||
+                    atomic_w                                                  ||
+                    cbo_w                                                     ||
+                    (enable_bitmanip_i && bitmanip_w)                         ||
                     ((opcode_i & `INST_ECALL_MASK) == `INST_ECALL)            ||
                     ((opcode_i & `INST_EBREAK_MASK) == `INST_EBREAK)          ||
                     ((opcode_i & `INST_ERET_MASK) == `INST_ERET)              ||
@@ -134,6 +182,8 @@ assign rd_valid_o = ((opcode_i & `INST_JALR_MASK) == `INST_JALR)     ||
                     ((opcode_i & `INST_LBU_MASK) == `INST_LBU)       ||
                     ((opcode_i & `INST_LHU_MASK) == `INST_LHU)       ||
                     ((opcode_i & `INST_LWU_MASK) == `INST_LWU)       ||
+                    atomic_w                                         ||
+                    bitmanip_w                                       ||
                     ((opcode_i & `INST_MUL_MASK) == `INST_MUL)       ||
                     ((opcode_i & `INST_MULH_MASK) == `INST_MULH)     ||
                     ((opcode_i & `INST_MULHSU_MASK) == `INST_MULHSU) ||
@@ -169,7 +219,8 @@ assign exec_o =     ((opcode_i & `INST_ANDI_MASK) == `INST_ANDI)  ||
                     ((opcode_i & `INST_AND_MASK) == `INST_AND)    ||
                     ((opcode_i & `INST_SLL_MASK) == `INST_SLL)    ||
                     ((opcode_i & `INST_SRL_MASK) == `INST_SRL)    ||
-                    ((opcode_i & `INST_SRA_MASK) == `INST_SRA);
+                    ((opcode_i & `INST_SRA_MASK) == `INST_SRA)    ||
+                    bitmanip_w;
 
 assign lsu_o =      ((opcode_i & `INST_LB_MASK) == `INST_LB)   ||
                     ((opcode_i & `INST_LH_MASK) == `INST_LH)   ||
@@ -179,7 +230,9 @@ assign lsu_o =      ((opcode_i & `INST_LB_MASK) == `INST_LB)   ||
                     ((opcode_i & `INST_LWU_MASK) == `INST_LWU) ||
                     ((opcode_i & `INST_SB_MASK) == `INST_SB)   ||
                     ((opcode_i & `INST_SH_MASK) == `INST_SH)   ||
-                    ((opcode_i & `INST_SW_MASK) == `INST_SW);
+                    ((opcode_i & `INST_SW_MASK) == `INST_SW)   ||
+                    atomic_w                                   ||
+                    cbo_w;
 
 assign branch_o =   ((opcode_i & `INST_JAL_MASK) == `INST_JAL)   ||
                     ((opcode_i & `INST_JALR_MASK) == `INST_JALR) ||
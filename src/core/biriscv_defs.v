@@ -25,17 +25,30 @@
 //--------------------------------------------------------------------
 // ALU Operations
 //--------------------------------------------------------------------
-`define ALU_NONE                                4'b0000
-`define ALU_SHIFTL                              4'b0001
-`define ALU_SHIFTR                              4'b0010
-`define ALU_SHIFTR_ARITH                        4'b0011
-`define ALU_ADD                                 4'b0100
-`define ALU_SUB                                 4'b0110
-`define ALU_AND                                 4'b0111
-`define ALU_OR                                  4'b1000
-`define ALU_XOR                                 4'b1001
-`define ALU_LESS_THAN                           4'b1010
-`define ALU_LESS_THAN_SIGNED                    4'b1011
+`define ALU_NONE                                5'b00000
+`define ALU_SHIFTL                              5'b00001
+`define ALU_SHIFTR                              5'b00010
+`define ALU_SHIFTR_ARITH                        5'b00011
+`define ALU_ADD                                 5'b00100
+`define ALU_SUB                                 5'b00110
+`define ALU_AND                                 5'b00111
+`define ALU_OR                                  5'b01000
+`define ALU_XOR                                 5'b01001
+`define ALU_LESS_THAN                           5'b01010
+`define ALU_LESS_THAN_SIGNED                    5'b01011
+`define ALU_MIN                                 5'b10000
+`define ALU_MAX                                 5'b10001
+`define ALU_MINU                                5'b10010
+`define ALU_MAXU                                5'b10011
+`define ALU_CLZ                                 5'b10100
+`define ALU_CTZ                                 5'b10101
+`define ALU_CPOP                                5'b10110
+`define ALU_SEXTB                               5'b10111
+`define ALU_SEXTH                               5'b11000
+`define ALU_ROL                                 5'b11001
+`define ALU_ROR                                 5'b11010
+`define ALU_ORCB                                5'b11011
+`define ALU_REV8                                5'b11100
 
 //--------------------------------------------------------------------
 // Instructions Masks
@@ -192,6 +205,50 @@
 `define INST_SW 32'h2023
 `define INST_SW_MASK 32'h707f
 
+// lr.w
+`define INST_LR_W 32'h1000202f
+`define INST_LR_W_MASK 32'hf9f0707f
+
+// sc.w
+`define INST_SC_W 32'h1800202f
+`define INST_SC_W_MASK 32'hf800707f
+
+// amoswap.w
+`define INST_AMOSWAP_W 32'h0800202f
+`define INST_AMOSWAP_W_MASK 32'hf800707f
+
+// amoadd.w
+`define INST_AMOADD_W 32'h0000202f
+`define INST_AMOADD_W_MASK 32'hf800707f
+
+// amoxor.w
+`define INST_AMOXOR_W 32'h2000202f
+`define INST_AMOXOR_W_MASK 32'hf800707f
+
+// amoand.w
+`define INST_AMOAND_W 32'h6000202f
+`define INST_AMOAND_W_MASK 32'hf800707f
+
+// amoor.w
+`define INST_AMOOR_W 32'h4000202f
+`define INST_AMOOR_W_MASK 32'hf800707f
+
+// amomin.w
+`define INST_AMOMIN_W 32'h8000202f
+`define INST_AMOMIN_W_MASK 32'hf800707f
+
+// amomax.w
+`define INST_AMOMAX_W 32'ha000202f
+`define INST_AMOMAX_W_MASK 32'hf800707f
+
+// amominu.w
+`define INST_AMOMINU_W 32'hc000202f
+`define INST_AMOMINU_W_MASK 32'hf800707f
+
+// amomaxu.w
+`define INST_AMOMAXU_W 32'he000202f
+`define INST_AMOMAXU_W_MASK 32'hf800707f
+
 // ecall
 `define INST_ECALL 32'h73
 `define INST_ECALL_MASK 32'hffffffff
@@ -260,6 +317,90 @@
 `define INST_REMU 32'h2007033
 `define INST_REMU_MASK 32'hfe00707f
 
+// sh1add
+`define INST_SH1ADD 32'h20002033
+`define INST_SH1ADD_MASK 32'hfe00707f
+
+// sh2add
+`define INST_SH2ADD 32'h20004033
+`define INST_SH2ADD_MASK 32'hfe00707f
+
+// sh3add
+`define INST_SH3ADD 32'h20006033
+`define INST_SH3ADD_MASK 32'hfe00707f
+
+// andn
+`define INST_ANDN 32'h40007033
+`define INST_ANDN_MASK 32'hfe00707f
+
+// orn
+`define INST_ORN 32'h40006033
+`define INST_ORN_MASK 32'hfe00707f
+
+// xnor
+`define INST_XNOR 32'h40004033
+`define INST_XNOR_MASK 32'hfe00707f
+
+// clz
+`define INST_CLZ 32'h60001013
+`define INST_CLZ_MASK 32'hfff0707f
+
+// ctz
+`define INST_CTZ 32'h60101013
+`define INST_CTZ_MASK 32'hfff0707f
+
+// cpop
+`define INST_CPOP 32'h60201013
+`define INST_CPOP_MASK 32'hfff0707f
+
+// max
+`define INST_MAX 32'ha006033
+`define INST_MAX_MASK 32'hfe00707f
+
+// maxu
+`define INST_MAXU 32'ha007033
+`define INST_MAXU_MASK 32'hfe00707f
+
+// min
+`define INST_MIN 32'ha004033
+`define INST_MIN_MASK 32'hfe00707f
+
+// minu
+`define INST_MINU 32'ha005033
+`define INST_MINU_MASK 32'hfe00707f
+
+// sext.b
+`define INST_SEXT_B 32'h60401013
+`define INST_SEXT_B_MASK 32'hfff0707f
+
+// sext.h
+`define INST_SEXT_H 32'h60501013
+`define INST_SEXT_H_MASK 32'hfff0707f
+
+// zext.h
+`define INST_ZEXT_H 32'h8004033
+`define INST_ZEXT_H_MASK 32'hfff0707f
+
+// rol
+`define INST_ROL 32'h60001033
+`define INST_ROL_MASK 32'hfe00707f
+
+// ror
+`define INST_ROR 32'h60005033
+`define INST_ROR_MASK 32'hfe00707f
+
+// rori
+`define INST_RORI 32'h60005013
+`define INST_RORI_MASK 32'hfe00707f
+
+// orc.b
+`define INST_ORC_B 32'h28705013
+`define INST_ORC_B_MASK 32'hfff0707f
+
+// rev8
+`define INST_REV8 32'h69805013
+`define INST_REV8_MASK 32'hfff0707f
+
 // wfi
 `define INST_WFI 32'h10500073
 `define INST_WFI_MASK 32'hffff8fff
@@ -276,6 +417,22 @@
 `define INST_IFENCE 32'h100f
 `define INST_IFENCE_MASK 32'h707f
 
+// cbo.inval
+`define INST_CBO_INVAL 32'h200f
+`define INST_CBO_INVAL_MASK 32'hfff07fff
+
+// cbo.clean
+`define INST_CBO_CLEAN 32'h10200f
+`define INST_CBO_CLEAN_MASK 32'hfff07fff
+
+// cbo.flush
+`define INST_CBO_FLUSH 32'h20200f
+`define INST_CBO_FLUSH_MASK 32'hfff07fff
+
+// cbo.zero
+`define INST_CBO_ZERO 32'h40200f
+`define INST_CBO_ZERO_MASK 32'hfff07fff
+
 //--------------------------------------------------------------------
 // Privilege levels
 //--------------------------------------------------------------------
@@ -311,6 +468,7 @@
 `define CSR_SIM_CTRL_MASK  32'hFFFFFFFF
     `define CSR_SIM_CTRL_EXIT (0 << 24)
     `define CSR_SIM_CTRL_PUTC (1 << 24)
+`define CSR_SIM_HOST       12'h8b3
 
 //--------------------------------------------------------------------
 // CSR Registers
@@ -333,6 +491,9 @@
 `define CSR_MEDELEG_MASK  32'h0000FFFF
 `define CSR_MIDELEG       12'h303
 `define CSR_MIDELEG_MASK  32'h0000FFFF
+`define CSR_MENVCFG       12'h30a
+`define CSR_MENVCFG_MASK  32'h000000F0
+`define CSR_MENVCFGH      12'h31a
 `define CSR_MIE           12'h304
 `define CSR_MIE_MASK      `IRQ_MASK
 `define CSR_MTVEC         12'h305
@@ -349,6 +510,8 @@
 `define CSR_MIP_MASK      `IRQ_MASK
 `define CSR_MCYCLE        12'hc00
 `define CSR_MCYCLE_MASK   32'hFFFFFFFF
+`define CSR_MCYCLEH       12'hc80
+`define CSR_MCYCLEH_MASK  32'hFFFFFFFF
 `define CSR_MTIME         12'hc01
 `define CSR_MTIME_MASK    32'hFFFFFFFF
 `define CSR_MTIMEH        12'hc81
@@ -359,6 +522,20 @@
 // Non-std
 `define CSR_MTIMECMP        12'h7c0
 `define CSR_MTIMECMP_MASK   32'hFFFFFFFF
+`define CSR_MTIMECMPH       12'h7c1
+`define CSR_MTIMECMPH_MASK  32'hFFFFFFFF
+`define CSR_MTIMEDIV        12'h7c2 // mtime tick = (MTIMEDIV + 1) cycles
+`define CSR_MTIMEDIV_MASK   16'hFFFF
+
+// CLIC (SUPPORT_CLIC)
+`define CSR_MTVT            12'h307
+`define CSR_MTVT_MASK       32'hFFFFFFC0
+`define CSR_MINTTHRESH      12'h347
+`define CSR_MINTTHRESH_MASK 32'h000000FF
+`define CSR_MINTSTATUS      12'hFB1
+`define CSR_MCAUSE_CLIC_MASK 32'h80000FFF
+`define CSR_CLICINT         12'hbd0
+    `define MTVEC_MODE_CLIC  2'b11
 
 //-----------------------------------------------------------------
 // CSR Registers - Supervisor
@@ -381,6 +558,8 @@
 `define CSR_SIP_MASK      ((1 << `IRQ_S_EXT) | (1 << `IRQ_S_TIMER) | (1 << `IRQ_S_SOFT))
 `define CSR_SATP          12'h180
 `define CSR_SATP_MASK     32'hFFFFFFFF
+`define CSR_SENVCFG       12'h10a
+`define CSR_SENVCFG_MASK  32'h000000F0
 
 //--------------------------------------------------------------------
 // CSR Registers - DCACHE control
@@ -392,6 +571,14 @@
 `define CSR_DINVALIDATE       12'h3a2 // pmpcfg2
 `define CSR_DINVALIDATE_MASK  32'hFFFFFFFF
 
+//--------------------------------------------------------------------
+// Data memory request tag bits (mem_d_req_tag_o / mem_d_resp_tag_i)
+//--------------------------------------------------------------------
+`define MEM_TAG_LR            0 // LR.W read (sets reservation)
+`define MEM_TAG_LOCK          1 // AMO read (line held until AMO write)
+`define MEM_TAG_SC            2 // SC.W write
+`define MEM_TAG_SC_FAIL       3 // Response: SC dropped (reservation lost)
+
 //--------------------------------------------------------------------
 // Status Register
 //--------------------------------------------------------------------
@@ -435,6 +622,15 @@
 `define SATP_ASID_R       30:22
 `define SATP_MODE_R       31
 
+//--------------------------------------------------------------------
+// menvcfg / senvcfg definitions
+//--------------------------------------------------------------------
+`define ENVCFG_CBIE_R     5:4 // cbo.inval: 00 illegal, 01 flush, 11 invalidate
+`define ENVCFG_CBCFE_R    6   // cbo.clean / cbo.flush
+`define ENVCFG_CBZE_R     7   // cbo.zero
+`define ENVCFG_CBIE_FLUSH 2'b01
+`define ENVCFG_CBIE_INVAL 2'b11
+
 //--------------------------------------------------------------------
 // MMU Defs (SV32)
 //--------------------------------------------------------------------
@@ -24,6 +24,16 @@
 //-----------------------------------------------------------------
 
 module biriscv_divider
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter DIV_BITS_PER_CYCLE = 1
+    ,parameter DIV_EARLY_OUT    = 0
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk_i
@@ -59,6 +69,10 @@ reg  [31:0]  wb_result_q;
 //-------------------------------------------------------------
 // Divider
 //-------------------------------------------------------------
+// Restoring divider producing DIV_BITS_PER_CYCLE quotient bits per
+// cycle (1, 2 or 4 - radix 2/4/16).  With DIV_EARLY_OUT=1, the
+// leading zero counts of the operands are used to skip quotient bits
+// which must be zero, so small quotients complete in a few cycles.
 wire inst_div_w         = (opcode_opcode_i & `INST_DIV_MASK) == `INST_DIV;
 wire inst_divu_w        = (opcode_opcode_i & `INST_DIVU_MASK) == `INST_DIVU;
 wire inst_rem_w         = (opcode_opcode_i & `INST_REM_MASK) == `INST_REM;
@@ -90,6 +104,68 @@ reg        last_remu_q;
 wire div_start_w    = opcode_valid_i & div_rem_inst_w;
 wire div_complete_w = !(|q_mask_q) & div_busy_q;
 
+wire [31:0] dividend_abs_w = (signed_operation_w && opcode_ra_operand_i[31]) ? -opcode_ra_operand_i : opcode_ra_operand_i;
+wire [31:0] divisor_abs_w  = (signed_operation_w && opcode_rb_operand_i[31]) ? -opcode_rb_operand_i : opcode_rb_operand_i;
+
+//-------------------------------------------------------------
+// Early out: leading zero count of the operands
+//-------------------------------------------------------------
+function [5:0] clz32;
+    input [31:0] value;
+    integer i;
+begin
+    clz32 = 6'd32;
+    for (i = 0; i < 32; i = i + 1)
+        if (value[i])
+/* verilator lint_off WIDTH */
+            clz32 = 31 - i;
+/* verilator lint_on WIDTH */
+end
+endfunction
+
+wire [5:0]  dividend_clz_w = clz32(dividend_abs_w);
+wire [5:0]  divisor_clz_w  = clz32(divisor_abs_w);
+
+// Quotient is zero - divisor has more significant bits than the dividend
+wire        div_zero_q_w   = (dividend_clz_w > divisor_clz_w);
+
+// Position of the most significant (possibly) non-zero quotient bit
+wire [4:0]  div_shift_w    = divisor_clz_w[4:0] - dividend_clz_w[4:0];
+
+wire        div_early_w    = DIV_EARLY_OUT && (|divisor_abs_w);
+
+//-------------------------------------------------------------
+// Divide step(s)
+//-------------------------------------------------------------
+reg [31:0] dividend_r;
+reg [62:0] divisor_r;
+reg [31:0] quotient_r;
+reg [31:0] q_mask_r;
+integer    i0;
+
+always @ *
+begin
+    dividend_r = dividend_q;
+    divisor_r  = divisor_q;
+    quotient_r = quotient_q;
+    q_mask_r   = q_mask_q;
+
+    for (i0 = 0; i0 < DIV_BITS_PER_CYCLE; i0 = i0 + 1)
+    begin
+        if (|q_mask_r)
+        begin
+            if (divisor_r <= {31'b0, dividend_r})
+            begin
+                dividend_r = dividend_r - divisor_r[31:0];
+                quotient_r = quotient_r | q_mask_r;
+            end
+
+            divisor_r = {1'b0, divisor_r[62:1]};
+            q_mask_r  = {1'b0, q_mask_r[31:1]};
+        end
+    end
+end
+
 always @(posedge clk_i or posedge rst_i)
 if (rst_i)
 begin
@@ -131,21 +207,29 @@ begin
         div_busy_q     <= 1'b1;
         div_inst_q     <= div_operation_w;
 
-        if (signed_operation_w && opcode_ra_operand_i[31])
-            dividend_q <= -opcode_ra_operand_i;
-        else
-            dividend_q <= opcode_ra_operand_i;
-
-        if (signed_operation_w && opcode_rb_operand_i[31])
-            divisor_q <= {-opcode_rb_operand_i, 31'b0};
-        else
-            divisor_q <= {opcode_rb_operand_i, 31'b0};
+        dividend_q     <= dividend_abs_w;
 
         invert_res_q  <= (((opcode_opcode_i & `INST_DIV_MASK) == `INST_DIV) && (opcode_ra_operand_i[31] != opcode_rb_operand_i[31]) && |opcode_rb_operand_i) || 
                          (((opcode_opcode_i & `INST_REM_MASK) == `INST_REM) && opcode_ra_operand_i[31]);
 
         quotient_q     <= 32'b0;
-        q_mask_q       <= 32'h80000000;
+
+        // Start at the first quotient bit which can be set
+        if (div_early_w && div_zero_q_w)
+        begin
+            divisor_q  <= {divisor_abs_w, 31'b0};
+            q_mask_q   <= 32'b0;
+        end
+        else if (div_early_w)
+        begin
+            divisor_q  <= {31'b0, divisor_abs_w} << div_shift_w;
+            q_mask_q   <= 32'b1 << div_shift_w;
+        end
+        else
+        begin
+            divisor_q  <= {divisor_abs_w, 31'b0};
+            q_mask_q   <= 32'h80000000;
+        end
     end
 end
 else if (div_complete_w)
@@ -154,14 +238,10 @@ begin
 end
 else if (div_busy_q)
 begin
-    if (divisor_q <= {31'b0, dividend_q})
-    begin
-        dividend_q <= dividend_q - divisor_q[31:0];
-        quotient_q <= quotient_q | q_mask_q;
-    end
-
-    divisor_q <= {1'b0, divisor_q[62:1]};
-    q_mask_q  <= {1'b0, q_mask_q[31:1]};
+    dividend_q <= dividend_r;
+    divisor_q  <= divisor_r;
+    quotient_q <= quotient_r;
+    q_mask_q   <= q_mask_r;
 end
 
 reg [31:0] div_result_r;
@@ -24,6 +24,15 @@
 //-----------------------------------------------------------------
 
 module biriscv_exec
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter SUPPORT_BITMANIP = 0
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk_i
@@ -32,6 +41,7 @@ module biriscv_exec
     ,input  [ 31:0]  opcode_opcode_i
     ,input  [ 31:0]  opcode_pc_i
     ,input           opcode_invalid_i
+    ,input           opcode_rvc_i
     ,input  [  4:0]  opcode_rd_idx_i
     ,input  [  4:0]  opcode_ra_idx_i
     ,input  [  4:0]  opcode_rb_idx_i
@@ -44,6 +54,7 @@ module biriscv_exec
     ,output          branch_is_taken_o
     ,output          branch_is_not_taken_o
     ,output [ 31:0]  branch_source_o
+    ,output          branch_is_rvc_o
     ,output          branch_is_call_o
     ,output          branch_is_ret_o
     ,output          branch_is_jmp_o
@@ -64,6 +75,9 @@ module biriscv_exec
 //-------------------------------------------------------------
 // Opcode decode
 //-------------------------------------------------------------
+// Size of the (possibly compressed) instruction - link / fall-through address
+wire [31:0] opcode_size_w = opcode_rvc_i ? 32'd2 : 32'd4;
+
 reg [31:0]  imm20_r;
 reg [31:0]  imm12_r;
 reg [31:0]  bimm_r;
@@ -82,7 +96,7 @@ end
 //-------------------------------------------------------------
 // Execute - ALU operations
 //-------------------------------------------------------------
-reg [3:0]  alu_func_r;
+reg [4:0]  alu_func_r;
 reg [31:0] alu_input_a_r;
 reg [31:0] alu_input_b_r;
 
@@ -220,7 +234,129 @@ begin
     begin
         alu_func_r     = `ALU_ADD;
         alu_input_a_r  = opcode_pc_i;
-        alu_input_b_r  = 32'd4;
+        alu_input_b_r  = opcode_size_w;
+    end
+    //-------------------------------------------------------------
+    // Bit manipulation (Zba / Zbb)
+    //-------------------------------------------------------------
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_SH1ADD_MASK) == `INST_SH1ADD) // sh1add
+    begin
+        alu_func_r     = `ALU_ADD;
+        alu_input_a_r  = {opcode_ra_operand_i[30:0], 1'b0};
+        alu_input_b_r  = opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_SH2ADD_MASK) == `INST_SH2ADD) // sh2add
+    begin
+        alu_func_r     = `ALU_ADD;
+        alu_input_a_r  = {opcode_ra_operand_i[29:0], 2'b0};
+        alu_input_b_r  = opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_SH3ADD_MASK) == `INST_SH3ADD) // sh3add
+    begin
+        alu_func_r     = `ALU_ADD;
+        alu_input_a_r  = {opcode_ra_operand_i[28:0], 3'b0};
+        alu_input_b_r  = opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_ANDN_MASK) == `INST_ANDN) // andn
+    begin
+        alu_func_r     = `ALU_AND;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = ~opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_ORN_MASK) == `INST_ORN) // orn
+    begin
+        alu_func_r     = `ALU_OR;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = ~opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_XNOR_MASK) == `INST_XNOR) // xnor
+    begin
+        alu_func_r     = `ALU_XOR;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = ~opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_CLZ_MASK) == `INST_CLZ) // clz
+    begin
+        alu_func_r     = `ALU_CLZ;
+        alu_input_a_r  = opcode_ra_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_CTZ_MASK) == `INST_CTZ) // ctz
+    begin
+        alu_func_r     = `ALU_CTZ;
+        alu_input_a_r  = opcode_ra_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_CPOP_MASK) == `INST_CPOP) // cpop
+    begin
+        alu_func_r     = `ALU_CPOP;
+        alu_input_a_r  = opcode_ra_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_MIN_MASK) == `INST_MIN) // min
+    begin
+        alu_func_r     = `ALU_MIN;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_MAX_MASK) == `INST_MAX) // max
+    begin
+        alu_func_r     = `ALU_MAX;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_MINU_MASK) == `INST_MINU) // minu
+    begin
+        alu_func_r     = `ALU_MINU;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_MAXU_MASK) == `INST_MAXU) // maxu
+    begin
+        alu_func_r     = `ALU_MAXU;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_SEXT_B_MASK) == `INST_SEXT_B) // sext.b
+    begin
+        alu_func_r     = `ALU_SEXTB;
+        alu_input_a_r  = opcode_ra_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_SEXT_H_MASK) == `INST_SEXT_H) // sext.h
+    begin
+        alu_func_r     = `ALU_SEXTH;
+        alu_input_a_r  = opcode_ra_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_ZEXT_H_MASK) == `INST_ZEXT_H) // zext.h
+    begin
+        alu_func_r     = `ALU_AND;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = 32'h0000ffff;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_ROL_MASK) == `INST_ROL) // rol
+    begin
+        alu_func_r     = `ALU_ROL;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_ROR_MASK) == `INST_ROR) // ror
+    begin
+        alu_func_r     = `ALU_ROR;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = opcode_rb_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_RORI_MASK) == `INST_RORI) // rori
+    begin
+        alu_func_r     = `ALU_ROR;
+        alu_input_a_r  = opcode_ra_operand_i;
+        alu_input_b_r  = {27'b0, shamt_r};
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_ORC_B_MASK) == `INST_ORC_B) // orc.b
+    begin
+        alu_func_r     = `ALU_ORCB;
+        alu_input_a_r  = opcode_ra_operand_i;
+    end
+    else if (SUPPORT_BITMANIP && (opcode_opcode_i & `INST_REV8_MASK) == `INST_REV8) // rev8
+    begin
+        alu_func_r     = `ALU_REV8;
+        alu_input_a_r  = opcode_ra_operand_i;
     end
 end
 
@@ -364,6 +500,7 @@ reg [31:0] pc_m_q;
 reg        branch_call_q;
 reg        branch_ret_q;
 reg        branch_jmp_q;
+reg        branch_rvc_q;
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
@@ -375,22 +512,25 @@ begin
     branch_call_q    <= 1'b0;
     branch_ret_q     <= 1'b0;
     branch_jmp_q     <= 1'b0;
+    branch_rvc_q     <= 1'b0;
 end
 else if (opcode_valid_i)
 begin
     branch_taken_q   <= branch_r && opcode_valid_i & branch_taken_r;
     branch_ntaken_q  <= branch_r && opcode_valid_i & ~branch_taken_r;
-    pc_x_q           <= branch_taken_r ? branch_target_r : opcode_pc_i + 32'd4;
+    pc_x_q           <= branch_taken_r ? branch_target_r : opcode_pc_i + opcode_size_w;
     branch_call_q    <= branch_r && opcode_valid_i && branch_call_r;
     branch_ret_q     <= branch_r && opcode_valid_i && branch_ret_r;
     branch_jmp_q     <= branch_r && opcode_valid_i && branch_jmp_r;
     pc_m_q           <= opcode_pc_i;
+    branch_rvc_q     <= opcode_rvc_i;
 end
 
 assign branch_request_o   = branch_taken_q | branch_ntaken_q;
 assign branch_is_taken_o  = branch_taken_q;
 assign branch_is_not_taken_o = branch_ntaken_q;
 assign branch_source_o    = pc_m_q;
+assign branch_is_rvc_o    = branch_rvc_q;
 assign branch_pc_o        = pc_x_q;
 assign branch_is_call_o   = branch_call_q;
 assign branch_is_ret_o    = branch_ret_q;
@@ -48,12 +48,12 @@ module biriscv_fetch
     ,input  [ 31:0]  branch_pc_i
     ,input  [  1:0]  branch_priv_i
     ,input  [ 31:0]  next_pc_f_i
-    ,input  [  1:0]  next_taken_f_i
+    ,input  [  3:0]  next_taken_f_i
 
     // Outputs
     ,output          fetch_valid_o
     ,output [ 63:0]  fetch_instr_o
-    ,output [  1:0]  fetch_pred_branch_o
+    ,output [  3:0]  fetch_pred_branch_o
     ,output          fetch_fault_fetch_o
     ,output          fetch_fault_page_o
     ,output [ 31:0]  fetch_pc_o
@@ -189,7 +189,7 @@ else
 //-------------------------------------------------------------
 reg [31:0]  pc_f_q;
 reg [31:0]  pc_d_q;
-reg [1:0]   pred_d_q;
+reg [3:0]   pred_d_q;
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
@@ -251,11 +251,11 @@ else if (icache_rd_o && icache_accept_i)
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
-    pred_d_q <= 2'b0;
+    pred_d_q <= 4'b0;
 else if (icache_rd_o && icache_accept_i)
     pred_d_q <= next_taken_f_i;
 else if (icache_valid_i)
-    pred_d_q <= 2'b0;
+    pred_d_q <= 4'b0;
 
 //-------------------------------------------------------------
 // Outputs
@@ -271,13 +271,13 @@ assign icache_busy_w       =  icache_fetch_q && !icache_valid_i;
 //-------------------------------------------------------------
 // Response Buffer
 //-------------------------------------------------------------
-reg [99:0]  skid_buffer_q;
+reg [101:0] skid_buffer_q;
 reg         skid_valid_q;
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
 begin
-    skid_buffer_q  <= 100'b0;
+    skid_buffer_q  <= 102'b0;
     skid_valid_q   <= 1'b0;
 end 
 // Instruction output back-pressured - hold in skid buffer
@@ -289,17 +289,17 @@ end
 else
 begin
     skid_valid_q  <= 1'b0;
-    skid_buffer_q <= 100'b0;
+    skid_buffer_q <= 102'b0;
 end
 
 assign fetch_valid_o       = (icache_valid_i || skid_valid_q) & !fetch_resp_drop_w;
-assign fetch_pc_o          = skid_valid_q ? skid_buffer_q[95:64] : {pc_d_q[31:3],3'b0};
+assign fetch_pc_o          = skid_valid_q ? skid_buffer_q[95:64] : {pc_d_q[31:1],1'b0};
 assign fetch_instr_o       = skid_valid_q ? skid_buffer_q[63:0]  : icache_inst_i;
-assign fetch_pred_branch_o = skid_valid_q ? skid_buffer_q[97:96] : pred_d_q;
+assign fetch_pred_branch_o = skid_valid_q ? skid_buffer_q[99:96] : pred_d_q;
 
 // Faults
-assign fetch_fault_fetch_o = skid_valid_q ? skid_buffer_q[98] : icache_error_i;
-assign fetch_fault_page_o  = skid_valid_q ? skid_buffer_q[99] : icache_page_fault_i;
+assign fetch_fault_fetch_o = skid_valid_q ? skid_buffer_q[100] : icache_error_i;
+assign fetch_fault_page_o  = skid_valid_q ? skid_buffer_q[101] : icache_page_fault_i;
 
 assign pc_f_o              = icache_pc_w;
 assign pc_accept_o         = ~stall_w;
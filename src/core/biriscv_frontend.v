@@ -41,6 +41,8 @@ module biriscv_frontend
     ,parameter BHT_ENABLE       = 1
     ,parameter NUM_RAS_ENTRIES  = 8
     ,parameter NUM_RAS_ENTRIES_W = 3
+    ,parameter SUPPORT_RVC      = 0
+    ,parameter SUPPORT_BITMANIP = 0
 )
 //-----------------------------------------------------------------
 // Ports
@@ -64,10 +66,12 @@ module biriscv_frontend
     ,input           branch_info_is_taken_i
     ,input           branch_info_is_not_taken_i
     ,input  [ 31:0]  branch_info_source_i
+    ,input           branch_info_is_rvc_i
     ,input           branch_info_is_call_i
     ,input           branch_info_is_ret_i
     ,input           branch_info_is_jmp_i
     ,input  [ 31:0]  branch_info_pc_i
+    ,input  [  2:0]  cbo_enable_i
 
     // Outputs
     ,output          icache_rd_o
@@ -88,6 +92,7 @@ module biriscv_frontend
     ,output          fetch0_instr_csr_o
     ,output          fetch0_instr_rd_valid_o
     ,output          fetch0_instr_invalid_o
+    ,output          fetch0_instr_rvc_o
     ,output          fetch1_valid_o
     ,output [ 31:0]  fetch1_instr_o
     ,output [ 31:0]  fetch1_pc_o
@@ -101,19 +106,22 @@ module biriscv_frontend
     ,output          fetch1_instr_csr_o
     ,output          fetch1_instr_rd_valid_o
     ,output          fetch1_instr_invalid_o
+    ,output          fetch1_instr_rvc_o
 );
 
 wire           fetch_valid_w;
 wire  [ 63:0]  fetch_instr_w;
 wire           fetch_fault_page_w;
 wire  [ 31:0]  next_pc_f_w;
-wire  [  1:0]  next_taken_f_w;
+wire  [  3:0]  next_taken_f_w;
 wire  [ 31:0]  fetch_pc_f_w;
 wire           fetch_accept_w;
-wire  [  1:0]  fetch_pred_branch_w;
+wire  [  3:0]  fetch_pred_branch_w;
 wire  [ 31:0]  fetch_pc_w;
 wire           fetch_fault_fetch_w;
 wire           fetch_pc_accept_w;
+wire           btb_stale_w;
+wire  [ 31:0]  btb_stale_pc_w;
 
 
 biriscv_npc
@@ -128,6 +136,7 @@ biriscv_npc
     ,.NUM_BHT_ENTRIES(NUM_BHT_ENTRIES)
     ,.RAS_ENABLE(RAS_ENABLE)
     ,.NUM_RAS_ENTRIES(NUM_RAS_ENTRIES)
+    ,.SUPPORT_RVC(SUPPORT_RVC)
 )
 u_npc
 (
@@ -139,12 +148,15 @@ u_npc
     ,.branch_is_taken_i(branch_info_is_taken_i)
     ,.branch_is_not_taken_i(branch_info_is_not_taken_i)
     ,.branch_source_i(branch_info_source_i)
+    ,.branch_is_rvc_i(branch_info_is_rvc_i)
     ,.branch_is_call_i(branch_info_is_call_i)
     ,.branch_is_ret_i(branch_info_is_ret_i)
     ,.branch_is_jmp_i(branch_info_is_jmp_i)
     ,.branch_pc_i(branch_info_pc_i)
     ,.pc_f_i(fetch_pc_f_w)
     ,.pc_accept_i(fetch_pc_accept_w)
+    ,.btb_invalidate_i(btb_stale_w)
+    ,.btb_invalidate_pc_i(btb_stale_pc_w)
 
     // Outputs
     ,.next_pc_f_o(next_pc_f_w)
@@ -156,6 +168,8 @@ biriscv_decode
 #(
      .EXTRA_DECODE_STAGE(EXTRA_DECODE_STAGE)
     ,.SUPPORT_MULDIV(SUPPORT_MULDIV)
+    ,.SUPPORT_RVC(SUPPORT_RVC)
+    ,.SUPPORT_BITMANIP(SUPPORT_BITMANIP)
 )
 u_decode
 (
@@ -173,6 +187,7 @@ u_decode
     ,.branch_request_i(branch_request_i)
     ,.branch_pc_i(branch_pc_i)
     ,.branch_priv_i(branch_priv_i)
+    ,.cbo_enable_i(cbo_enable_i)
 
     // Outputs
     ,.fetch_in_accept_o(fetch_accept_w)
@@ -189,6 +204,7 @@ u_decode
     ,.fetch_out0_instr_csr_o(fetch0_instr_csr_o)
     ,.fetch_out0_instr_rd_valid_o(fetch0_instr_rd_valid_o)
     ,.fetch_out0_instr_invalid_o(fetch0_instr_invalid_o)
+    ,.fetch_out0_instr_rvc_o(fetch0_instr_rvc_o)
     ,.fetch_out1_valid_o(fetch1_valid_o)
     ,.fetch_out1_instr_o(fetch1_instr_o)
     ,.fetch_out1_pc_o(fetch1_pc_o)
@@ -202,6 +218,9 @@ u_decode
     ,.fetch_out1_instr_csr_o(fetch1_instr_csr_o)
     ,.fetch_out1_instr_rd_valid_o(fetch1_instr_rd_valid_o)
     ,.fetch_out1_instr_invalid_o(fetch1_instr_invalid_o)
+    ,.fetch_out1_instr_rvc_o(fetch1_instr_rvc_o)
+    ,.btb_stale_o(btb_stale_w)
+    ,.btb_stale_pc_o(btb_stale_pc_w)
 );
 
 
@@ -33,6 +33,13 @@ module biriscv_issue
     ,parameter SUPPORT_LOAD_BYPASS = 1
     ,parameter SUPPORT_MUL_BYPASS = 1
     ,parameter SUPPORT_REGFILE_XILINX = 0
+    ,parameter SUPPORT_RVC      = 0
+    ,parameter SUPPORT_FUSION   = 0
+    ,parameter SUPPORT_NONBLOCKING_LOAD = 0
+    ,parameter SUPPORT_DUAL_LSU = 0
+    ,parameter SUPPORT_STORE_FWD = 0
+    ,parameter MEM_CACHE_ADDR_MIN = 32'h80000000
+    ,parameter MEM_CACHE_ADDR_MAX = 32'h8fffffff
 )
 //-----------------------------------------------------------------
 // Ports
@@ -54,6 +61,7 @@ module biriscv_issue
     ,input           fetch0_instr_csr_i
     ,input           fetch0_instr_rd_valid_i
     ,input           fetch0_instr_invalid_i
+    ,input           fetch0_instr_rvc_i
     ,input           fetch1_valid_i
     ,input  [ 31:0]  fetch1_instr_i
     ,input  [ 31:0]  fetch1_pc_i
@@ -67,10 +75,12 @@ module biriscv_issue
     ,input           fetch1_instr_csr_i
     ,input           fetch1_instr_rd_valid_i
     ,input           fetch1_instr_invalid_i
+    ,input           fetch1_instr_rvc_i
     ,input           branch_exec0_request_i
     ,input           branch_exec0_is_taken_i
     ,input           branch_exec0_is_not_taken_i
     ,input  [ 31:0]  branch_exec0_source_i
+    ,input           branch_exec0_is_rvc_i
     ,input           branch_exec0_is_call_i
     ,input           branch_exec0_is_ret_i
     ,input           branch_exec0_is_jmp_i
@@ -82,6 +92,7 @@ module biriscv_issue
     ,input           branch_exec1_is_taken_i
     ,input           branch_exec1_is_not_taken_i
     ,input  [ 31:0]  branch_exec1_source_i
+    ,input           branch_exec1_is_rvc_i
     ,input           branch_exec1_is_call_i
     ,input           branch_exec1_is_ret_i
     ,input           branch_exec1_is_jmp_i
@@ -105,7 +116,18 @@ module biriscv_issue
     ,input  [ 31:0]  csr_result_e1_wdata_i
     ,input  [  5:0]  csr_result_e1_exception_i
     ,input           lsu_stall_i
+    ,input           lsu_release_i
+    ,input           lsu_store_accept_i
+    ,input           lsu_store_empty_i
+    ,input           lsu_store_error_i
+    ,input  [ 31:0]  lsu_store_error_addr_i
+    ,input           mem_store_empty_i
+    ,input           mem_store_error_i
+    ,input  [ 31:0]  mem_store_error_addr_i
+    ,input           mem_fill_error_i
+    ,input  [ 31:0]  mem_fill_error_addr_i
     ,input           take_interrupt_i
+    ,input           irq_pending_i
 
     // Outputs
     ,output          fetch0_accept_o
@@ -117,6 +139,7 @@ module biriscv_issue
     ,output          branch_info_is_taken_o
     ,output          branch_info_is_not_taken_o
     ,output [ 31:0]  branch_info_source_o
+    ,output          branch_info_is_rvc_o
     ,output          branch_info_is_call_o
     ,output          branch_info_is_ret_o
     ,output          branch_info_is_jmp_o
@@ -130,6 +153,7 @@ module biriscv_issue
     ,output [ 31:0]  opcode0_opcode_o
     ,output [ 31:0]  opcode0_pc_o
     ,output          opcode0_invalid_o
+    ,output          opcode0_rvc_o
     ,output [  4:0]  opcode0_rd_idx_o
     ,output [  4:0]  opcode0_ra_idx_o
     ,output [  4:0]  opcode0_rb_idx_o
@@ -138,6 +162,7 @@ module biriscv_issue
     ,output [ 31:0]  opcode1_opcode_o
     ,output [ 31:0]  opcode1_pc_o
     ,output          opcode1_invalid_o
+    ,output          opcode1_rvc_o
     ,output [  4:0]  opcode1_rd_idx_o
     ,output [  4:0]  opcode1_ra_idx_o
     ,output [  4:0]  opcode1_rb_idx_o
@@ -151,6 +176,12 @@ module biriscv_issue
     ,output [  4:0]  lsu_opcode_rb_idx_o
     ,output [ 31:0]  lsu_opcode_ra_operand_o
     ,output [ 31:0]  lsu_opcode_rb_operand_o
+    ,output          lsu_store_valid_o
+    ,output [ 31:0]  lsu_store_opcode_o
+    ,output [ 31:0]  lsu_store_ra_operand_o
+    ,output [ 31:0]  lsu_store_rb_operand_o
+    ,output          lsu_store_commit_o
+    ,output [  1:0]  lsu_store_kill_o
     ,output [ 31:0]  mul_opcode_opcode_o
     ,output [ 31:0]  mul_opcode_pc_o
     ,output          mul_opcode_invalid_o
@@ -195,7 +226,12 @@ wire squash_w;
 //-------------------------------------------------------------
 wire        single_issue_w;
 wire        dual_issue_w;
+wire        opcode_a_rvc_w;
+wire        opcode_b_rvc_w;
 reg  [31:0] pc_x_q;
+
+wire [31:0] opcode_a_size_w = opcode_a_rvc_w ? 32'd2 : 32'd4;
+wire [31:0] opcode_b_size_w = opcode_b_rvc_w ? 32'd2 : 32'd4;
 reg   [1:0] priv_x_q;
 
 always @ (posedge clk_i or posedge rst_i)
@@ -208,9 +244,9 @@ else if (branch_d_exec1_request_i)
 else if (branch_d_exec0_request_i)
     pc_x_q <= branch_d_exec0_pc_i;
 else if (dual_issue_w)
-    pc_x_q <= pc_x_q + 32'd8;
+    pc_x_q <= pc_x_q + opcode_a_size_w + opcode_b_size_w;
 else if (single_issue_w)
-    pc_x_q <= pc_x_q + 32'd4;
+    pc_x_q <= pc_x_q + opcode_a_size_w;
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
@@ -225,6 +261,10 @@ reg mispredicted_r;
 reg slot0_valid_r;
 reg slot1_valid_r;
 
+// Compressed instructions are halfword aligned
+wire fetch0_pc_match_w = SUPPORT_RVC ? (fetch0_pc_i[31:1] == pc_x_q[31:1]) : ({fetch0_pc_i[31:2], 2'b0} == {pc_x_q[31:2], 2'b0});
+wire fetch1_pc_match_w = SUPPORT_RVC ? (fetch1_pc_i[31:1] == pc_x_q[31:1]) : ({fetch1_pc_i[31:2], 2'b0} == {pc_x_q[31:2], 2'b0});
+
 always @ *
 begin
     mispredicted_r = 1'b0;
@@ -238,10 +278,10 @@ begin
         slot1_valid_r  = 1'b0;
     end
     // Word 0 valid and expected PC (word 1 may also be valid)
-    else if (fetch0_valid_i && {fetch0_pc_i[31:2], 2'b0} == {pc_x_q[31:2], 2'b0})
+    else if (fetch0_valid_i && fetch0_pc_match_w)
         slot0_valid_r  = 1'b1;
     // Word 1 valid and expected PC
-    else if (fetch1_valid_i && {fetch1_pc_i[31:2], 2'b0} == {pc_x_q[31:2], 2'b0})
+    else if (fetch1_valid_i && fetch1_pc_match_w)
         slot1_valid_r  = 1'b1;
     // Neither word is the expected PC - must be a branch misprediction
     else if (fetch0_valid_i || fetch1_valid_i)
@@ -304,17 +344,26 @@ begin
     end
 end
 
+// Slot a carries a late load / store fault (no side effects, see non-blocking loads)
+wire        nb_inject_w;
+wire        nb_fault_wb_w;
+wire [31:0] nb_fault_addr_w;
+wire        nb_fault_store_w;
+
+wire [`EXCEPTION_W-1:0] nb_fault_code_w = nb_fault_store_w ? `EXCEPTION_FAULT_STORE : `EXCEPTION_FAULT_LOAD;
+
 wire [4:0] issue_a_ra_idx_w   = opcode_a_r[19:15];
 wire [4:0] issue_a_rb_idx_w   = opcode_a_r[24:20];
 wire [4:0] issue_a_rd_idx_w   = opcode_a_r[11:7];
-wire       issue_a_sb_alloc_w = (slot0_valid_r ? fetch0_instr_rd_valid_i : fetch1_instr_rd_valid_i);
-wire       issue_a_exec_w     = (slot0_valid_r ? fetch0_instr_exec_i     : fetch1_instr_exec_i);
-wire       issue_a_lsu_w      = (slot0_valid_r ? fetch0_instr_lsu_i      : fetch1_instr_lsu_i);
-wire       issue_a_branch_w   = (slot0_valid_r ? fetch0_instr_branch_i   : fetch1_instr_branch_i);
-wire       issue_a_mul_w      = (slot0_valid_r ? fetch0_instr_mul_i      : fetch1_instr_mul_i);
-wire       issue_a_div_w      = (slot0_valid_r ? fetch0_instr_div_i      : fetch1_instr_div_i);
-wire       issue_a_csr_w      = (slot0_valid_r ? fetch0_instr_csr_i      : fetch1_instr_csr_i);
+wire       issue_a_sb_alloc_w = ~nb_inject_w & (slot0_valid_r ? fetch0_instr_rd_valid_i : fetch1_instr_rd_valid_i);
+wire       issue_a_exec_w     =  nb_inject_w | (slot0_valid_r ? fetch0_instr_exec_i     : fetch1_instr_exec_i);
+wire       issue_a_lsu_w      = ~nb_inject_w & (slot0_valid_r ? fetch0_instr_lsu_i      : fetch1_instr_lsu_i);
+wire       issue_a_branch_w   = ~nb_inject_w & (slot0_valid_r ? fetch0_instr_branch_i   : fetch1_instr_branch_i);
+wire       issue_a_mul_w      = ~nb_inject_w & (slot0_valid_r ? fetch0_instr_mul_i      : fetch1_instr_mul_i);
+wire       issue_a_div_w      = ~nb_inject_w & (slot0_valid_r ? fetch0_instr_div_i      : fetch1_instr_div_i);
+wire       issue_a_csr_w      = ~nb_inject_w & (slot0_valid_r ? fetch0_instr_csr_i      : fetch1_instr_csr_i);
 wire       issue_a_invalid_w  = (slot0_valid_r ? fetch0_instr_invalid_i  : fetch1_instr_invalid_i);
+wire       issue_a_rvc_w      = (slot0_valid_r ? fetch0_instr_rvc_i      : fetch1_instr_rvc_i);
 
 
 wire [4:0] issue_b_ra_idx_w   = opcode_b_r[19:15];
@@ -328,6 +377,30 @@ wire       issue_b_mul_w      = fetch1_instr_mul_i;
 wire       issue_b_div_w      = fetch1_instr_div_i;
 wire       issue_b_csr_w      = fetch1_instr_csr_i;
 wire       issue_b_invalid_w  = fetch1_instr_invalid_i;
+wire       issue_b_rvc_w      = fetch1_instr_rvc_i;
+
+assign opcode_a_rvc_w = SUPPORT_RVC && issue_a_rvc_w;
+assign opcode_b_rvc_w = SUPPORT_RVC && issue_b_rvc_w;
+
+//-------------------------------------------------------------
+// Macro-op fusion
+//-------------------------------------------------------------
+// Dependent pairs where the result of slot a can be formed at issue
+// (lui+addi, auipc+jalr, slli(<=3)+add) are issued together, with
+// slot b taking the result of slot a directly as its operand.
+wire fuse_lui_w   = ((opcode_a_r & `INST_LUI_MASK)   == `INST_LUI)   &&
+                    ((opcode_b_r & `INST_ADDI_MASK)  == `INST_ADDI);
+wire fuse_auipc_w = ((opcode_a_r & `INST_AUIPC_MASK) == `INST_AUIPC) &&
+                    ((opcode_b_r & `INST_JALR_MASK)  == `INST_JALR);
+wire fuse_slli_w  = ((opcode_a_r & `INST_SLLI_MASK)  == `INST_SLLI)  &&
+                    ((opcode_b_r & `INST_ADD_MASK)   == `INST_ADD)   &&
+                    (opcode_a_r[24:22] == 3'b0);
+
+wire fuse_ra_w    = (issue_b_ra_idx_w == issue_a_rd_idx_w);
+wire fuse_rb_w    = (issue_b_rb_idx_w == issue_a_rd_idx_w) && fuse_slli_w;
+
+wire fuse_w       = SUPPORT_FUSION && opcode_a_valid_r && opcode_b_valid_r && (|issue_a_rd_idx_w) &&
+                    (fuse_lui_w || fuse_auipc_w || fuse_slli_w) && (fuse_ra_w || fuse_rb_w);
 
 //-------------------------------------------------------------
 // Pipe0 - Status tracking
@@ -365,13 +438,21 @@ wire [31:0] pipe0_ra_val_wb_w;
 wire [31:0] pipe0_rb_val_wb_w;
 wire [`EXCEPTION_W-1:0] pipe0_exception_wb_w;
 
-wire [`EXCEPTION_W-1:0] issue_a_fault_w = opcode_a_fault_r[0] ? `EXCEPTION_FAULT_FETCH:
+wire        issue_a_rd_dead_w;
+
+wire        mem_complete_w;
+wire        mem_release_w;
+reg [1:0]   st_e2_q;
+
+wire [`EXCEPTION_W-1:0] issue_a_fault_w = nb_inject_w         ? nb_fault_code_w:
+                                          opcode_a_fault_r[0] ? `EXCEPTION_FAULT_FETCH:
                                           opcode_a_fault_r[1] ? `EXCEPTION_PAGE_FAULT_INST: `EXCEPTION_W'b0;
 
 biriscv_pipe_ctrl
 #( 
      .SUPPORT_LOAD_BYPASS(SUPPORT_LOAD_BYPASS)
     ,.SUPPORT_MUL_BYPASS(SUPPORT_MUL_BYPASS)
+    ,.SUPPORT_RVC(SUPPORT_RVC)
 )
 u_pipe0_ctrl
 (
@@ -387,7 +468,7 @@ u_pipe0_ctrl
     ,.issue_div_i(issue_a_div_w)
     ,.issue_mul_i(issue_a_mul_w)
     ,.issue_branch_i(issue_a_branch_w)
-    ,.issue_rd_valid_i(issue_a_sb_alloc_w)
+    ,.issue_rd_valid_i(issue_a_sb_alloc_w & ~issue_a_rd_dead_w)
     ,.issue_rd_i(issue_a_rd_idx_w)
     ,.issue_exception_i(issue_a_fault_w)
     ,.issue_pc_i(opcode0_pc_o)
@@ -417,9 +498,10 @@ u_pipe0_ctrl
     ,.operand_rb_e1_o(pipe0_operand_rb_e1_w)
 
     // Execution stage 2: Other results
-    ,.mem_complete_i(writeback_mem_valid_i)
+    ,.mem_complete_i(mem_complete_w | st_e2_q[0])
+    ,.mem_release_i(mem_release_w)
     ,.mem_result_e2_i(writeback_mem_value_i)
-    ,.mem_exception_e2_i(writeback_mem_exception_i)
+    ,.mem_exception_e2_i(st_e2_q[0] ? `EXCEPTION_W'b0 : writeback_mem_exception_i)
     ,.mul_result_e2_i(writeback_mul_value_i)
 
     // Execution stage 2
@@ -494,6 +576,7 @@ biriscv_pipe_ctrl
 #( 
      .SUPPORT_LOAD_BYPASS(SUPPORT_LOAD_BYPASS)
     ,.SUPPORT_MUL_BYPASS(SUPPORT_MUL_BYPASS)
+    ,.SUPPORT_RVC(SUPPORT_RVC)
 )
 u_pipe1_ctrl
 (
@@ -539,9 +622,10 @@ u_pipe1_ctrl
     ,.operand_rb_e1_o(pipe1_operand_rb_e1_w)
 
     // Execution stage 2: Other results
-    ,.mem_complete_i(writeback_mem_valid_i)
+    ,.mem_complete_i(mem_complete_w | st_e2_q[1])
+    ,.mem_release_i(mem_release_w)
     ,.mem_result_e2_i(writeback_mem_value_i)
-    ,.mem_exception_e2_i(writeback_mem_exception_i)
+    ,.mem_exception_e2_i(st_e2_q[1] ? `EXCEPTION_W'b0 : writeback_mem_exception_i)
     ,.mul_result_e2_i(writeback_mul_value_i)
 
     // Execution stage 2
@@ -578,7 +662,7 @@ assign exec1_hold_o = stall_w;
 
 assign csr_writeback_exception_o      = pipe0_exception_wb_w | pipe1_exception_wb_w;
 assign csr_writeback_exception_pc_o   = (|pipe0_exception_wb_w) ? pipe0_pc_wb_w     : pipe1_pc_wb_w;
-assign csr_writeback_exception_addr_o = (|pipe0_exception_wb_w) ? pipe0_result_wb_w : pipe1_result_wb_w;
+assign csr_writeback_exception_addr_o = (|pipe0_exception_wb_w) ? (nb_fault_wb_w ? nb_fault_addr_w : pipe0_result_wb_w) : pipe1_result_wb_w;
 
 //-------------------------------------------------------------
 // Branch predictor info
@@ -592,6 +676,7 @@ assign branch_info_is_call_o      = (pipe1_branch_e1_w & branch_exec1_is_call_i)
 assign branch_info_is_ret_o       = (pipe1_branch_e1_w & branch_exec1_is_ret_i)       | (pipe0_branch_e1_w & branch_exec0_is_ret_i);
 assign branch_info_is_jmp_o       = (pipe1_branch_e1_w & branch_exec1_is_jmp_i)       | (pipe0_branch_e1_w & branch_exec0_is_jmp_i);
 assign branch_info_source_o       = (pipe1_branch_e1_w & branch_exec1_request_i)      ? branch_exec1_source_i : branch_exec0_source_i;
+assign branch_info_is_rvc_o       = (pipe1_branch_e1_w & branch_exec1_request_i)      ? branch_exec1_is_rvc_i : branch_exec0_is_rvc_i;
 assign branch_info_pc_o           = (pipe1_branch_e1_w & branch_exec1_request_i)      ? branch_exec1_pc_i     : branch_exec0_pc_i;
 
 //-------------------------------------------------------------
@@ -626,6 +711,291 @@ else if (pipe0_csr_wb_w)
 
 assign squash_w = pipe0_squash_e1_e2_w || pipe1_squash_e1_e2_w;
 
+//-------------------------------------------------------------
+// WFI: once the WFI has written back, stop issuing until an
+// enabled interrupt is pending (the global enables do not apply).
+//-------------------------------------------------------------
+wire issue_a_wfi_w = issue_a_csr_w && ((opcode_a_r & `INST_WFI_MASK) == `INST_WFI);
+
+reg  wfi_pending_q;
+reg  wfi_sleep_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    wfi_pending_q <= 1'b0;
+else if (squash_w)
+    wfi_pending_q <= 1'b0;
+else if (csr_opcode_valid_o && issue_a_csr_w)
+    wfi_pending_q <= issue_a_wfi_w;
+else if (pipe0_csr_wb_w)
+    wfi_pending_q <= 1'b0;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    wfi_sleep_q <= 1'b0;
+else if (irq_pending_i)
+    wfi_sleep_q <= 1'b0;
+else if (wfi_pending_q && pipe0_csr_wb_w && !squash_w)
+    wfi_sleep_q <= 1'b1;
+
+//-------------------------------------------------------------
+// Non-blocking loads
+//-------------------------------------------------------------
+// A cacheable load whose response is late leaves the pipeline without
+// its result. Its destination register stays in the scoreboard (blocking
+// readers and writers of it only) until the response returns, and is
+// then written through the pipe0 register file port when that is free.
+// A bus error on such a load can no longer be precise - it is raised
+// as a load access fault on the next instruction to issue.
+reg         nb_valid_q;
+reg         nb_wait_q;
+reg [4:0]   nb_rd_q;
+reg [31:0]  nb_value_q;
+wire        nb_fault_w;
+reg         nb_fault_sent_q;
+reg [31:0]  nb_fault_pc_q;
+
+// Response for the released load
+wire        nb_ack_w        = nb_wait_q & writeback_mem_valid_i;
+wire        nb_ack_err_w    = nb_ack_w & (|writeback_mem_exception_i);
+
+assign mem_complete_w       = writeback_mem_valid_i & ~nb_wait_q;
+assign mem_release_w        = SUPPORT_NONBLOCKING_LOAD && lsu_release_i && !nb_valid_q && !nb_wait_q && !squash_w;
+
+wire        nb_release_w    = mem_release_w && (pipe0_load_e2_w || pipe1_load_e2_w) && !writeback_mem_valid_i && !stall_w;
+wire [4:0]  nb_release_rd_w = pipe0_load_e2_w ? pipe0_rd_e2_w : pipe1_rd_e2_w;
+
+// Register file write (pipe0 port unused this cycle)
+wire        nb_write_w      = nb_valid_q && ((nb_ack_w && !nb_ack_err_w) || !nb_wait_q) && (pipe0_rd_wb_w == 5'b0);
+wire [31:0] nb_write_value_w= nb_wait_q ? writeback_mem_value_i : nb_value_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    nb_valid_q <= 1'b0;
+    nb_wait_q  <= 1'b0;
+    nb_rd_q    <= 5'b0;
+    nb_value_q <= 32'b0;
+end
+else if (nb_release_w)
+begin
+    nb_valid_q <= (|nb_release_rd_w);
+    nb_wait_q  <= 1'b1;
+    nb_rd_q    <= nb_release_rd_w;
+end
+else if (nb_ack_err_w)
+begin
+    nb_valid_q <= 1'b0;
+    nb_wait_q  <= 1'b0;
+end
+else
+begin
+    if (nb_ack_w)
+    begin
+        nb_wait_q  <= 1'b0;
+        nb_value_q <= writeback_mem_value_i;
+    end
+
+    if (nb_write_w)
+        nb_valid_q <= 1'b0;
+end
+
+// Late load fault reaches writeback (on the instruction that carried it)
+assign nb_fault_wb_w = nb_fault_w && (pipe0_exception_wb_w == nb_fault_code_w) && (pipe0_pc_wb_w == nb_fault_pc_q);
+
+//-------------------------------------------------------------
+// Late fault queue
+//-------------------------------------------------------------
+// Late faults from the released load and from buffered stores failing
+// whilst draining are raised in arrival order, one per carrier.  Several
+// may arrive in the same cycle, and every store buffered ahead of the
+// first trap may still fail, so the queue is sized for all stores which
+// can be in flight (store buffers, pending drains and line fills) plus
+// the released load - none is overwritten or dropped.
+localparam FAULT_QUEUE   = 16;
+localparam FAULT_QUEUE_W = 4;
+
+reg [31:0]              fault_addr_q[FAULT_QUEUE-1:0];
+reg [FAULT_QUEUE-1:0]   fault_store_q;
+reg [FAULT_QUEUE_W-1:0] fault_rd_q;
+reg [FAULT_QUEUE_W-1:0] fault_wr_q;
+reg [FAULT_QUEUE_W:0]   fault_count_q;
+
+// Sources in priority order: released load, LSU store buffer, data cache store buffer,
+// data cache line fill (store miss already acknowledged)
+wire                     fault_push0_w = nb_ack_err_w;
+wire                     fault_push1_w = lsu_store_error_i;
+wire                     fault_push2_w = mem_store_error_i;
+wire                     fault_push3_w = mem_fill_error_i;
+wire [FAULT_QUEUE_W-1:0] fault_idx0_w  = fault_wr_q;
+wire [FAULT_QUEUE_W-1:0] fault_idx1_w  = fault_idx0_w + {{(FAULT_QUEUE_W-1){1'b0}}, fault_push0_w};
+wire [FAULT_QUEUE_W-1:0] fault_idx2_w  = fault_idx1_w + {{(FAULT_QUEUE_W-1){1'b0}}, fault_push1_w};
+wire [FAULT_QUEUE_W-1:0] fault_idx3_w  = fault_idx2_w + {{(FAULT_QUEUE_W-1){1'b0}}, fault_push2_w};
+wire [FAULT_QUEUE_W-1:0] fault_next_w  = fault_idx3_w + {{(FAULT_QUEUE_W-1){1'b0}}, fault_push3_w};
+wire [FAULT_QUEUE_W:0]   fault_push_w  = {{FAULT_QUEUE_W{1'b0}}, fault_push0_w} + {{FAULT_QUEUE_W{1'b0}}, fault_push1_w} +
+                                         {{FAULT_QUEUE_W{1'b0}}, fault_push2_w} + {{FAULT_QUEUE_W{1'b0}}, fault_push3_w};
+
+integer f;
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    for (f=0;f<FAULT_QUEUE;f=f+1)
+        fault_addr_q[f] <= 32'b0;
+
+    fault_store_q <= {FAULT_QUEUE{1'b0}};
+    fault_rd_q    <= {FAULT_QUEUE_W{1'b0}};
+    fault_wr_q    <= {FAULT_QUEUE_W{1'b0}};
+    fault_count_q <= {(FAULT_QUEUE_W+1){1'b0}};
+end
+else
+begin
+    if (fault_push0_w)
+    begin
+        fault_addr_q[fault_idx0_w]  <= writeback_mem_value_i;
+        fault_store_q[fault_idx0_w] <= 1'b0;
+    end
+
+    if (fault_push1_w)
+    begin
+        fault_addr_q[fault_idx1_w]  <= lsu_store_error_addr_i;
+        fault_store_q[fault_idx1_w] <= 1'b1;
+    end
+
+    if (fault_push2_w)
+    begin
+        fault_addr_q[fault_idx2_w]  <= mem_store_error_addr_i;
+        fault_store_q[fault_idx2_w] <= 1'b1;
+    end
+
+    if (fault_push3_w)
+    begin
+        fault_addr_q[fault_idx3_w]  <= mem_fill_error_addr_i;
+        fault_store_q[fault_idx3_w] <= 1'b1;
+    end
+
+    if (nb_fault_wb_w)
+        fault_rd_q <= fault_rd_q + 1;
+
+    fault_wr_q    <= fault_next_w;
+    fault_count_q <= fault_count_q + fault_push_w - {{FAULT_QUEUE_W{1'b0}}, nb_fault_wb_w};
+end
+
+assign nb_fault_w       = (fault_count_q != {(FAULT_QUEUE_W+1){1'b0}});
+assign nb_fault_store_w = fault_store_q[fault_rd_q];
+assign nb_fault_addr_w  = fault_addr_q[fault_rd_q];
+
+// Carrier squashed by an older exception - inject again (or the
+// next queued fault once this one has been raised)
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    nb_fault_sent_q <= 1'b0;
+    nb_fault_pc_q   <= 32'b0;
+end
+else if (squash_w || !nb_fault_w || nb_fault_wb_w)
+    nb_fault_sent_q <= 1'b0;
+else if (nb_inject_w && opcode_a_issue_r)
+begin
+    nb_fault_sent_q <= 1'b1;
+    nb_fault_pc_q   <= opcode_a_pc_r;
+end
+
+assign nb_inject_w = nb_fault_w && !nb_fault_sent_q;
+
+//-------------------------------------------------------------
+// Load / store pairing
+//-------------------------------------------------------------
+// A plain load and a plain store may issue together (in either order).
+// The load takes the LSU port and the store is written into the LSU
+// store buffer, which drains to the data cache when the port is idle.
+// The buffered store is speculative until it leaves E2 (committed),
+// or is killed if squashed before then.
+// Pairs are formed for aligned, cacheable accesses only, and not when
+// the younger load reads the word written by the older store.
+// With store forwarding every aligned, cacheable store is buffered
+// (paired or not), and younger loads of its word read it from there.
+wire issue_a_load_w  = issue_a_lsu_w && (((opcode_a_r & `INST_LB_MASK)  == `INST_LB)  ||
+                                         ((opcode_a_r & `INST_LH_MASK)  == `INST_LH)  ||
+                                         ((opcode_a_r & `INST_LW_MASK)  == `INST_LW)  ||
+                                         ((opcode_a_r & `INST_LBU_MASK) == `INST_LBU) ||
+                                         ((opcode_a_r & `INST_LHU_MASK) == `INST_LHU) ||
+                                         ((opcode_a_r & `INST_LWU_MASK) == `INST_LWU));
+wire issue_a_store_w = issue_a_lsu_w && (((opcode_a_r & `INST_SB_MASK)  == `INST_SB)  ||
+                                         ((opcode_a_r & `INST_SH_MASK)  == `INST_SH)  ||
+                                         ((opcode_a_r & `INST_SW_MASK)  == `INST_SW));
+wire issue_b_load_w  = issue_b_lsu_w && (((opcode_b_r & `INST_LB_MASK)  == `INST_LB)  ||
+                                         ((opcode_b_r & `INST_LH_MASK)  == `INST_LH)  ||
+                                         ((opcode_b_r & `INST_LW_MASK)  == `INST_LW)  ||
+                                         ((opcode_b_r & `INST_LBU_MASK) == `INST_LBU) ||
+                                         ((opcode_b_r & `INST_LHU_MASK) == `INST_LHU) ||
+                                         ((opcode_b_r & `INST_LWU_MASK) == `INST_LWU));
+wire issue_b_store_w = issue_b_lsu_w && (((opcode_b_r & `INST_SB_MASK)  == `INST_SB)  ||
+                                         ((opcode_b_r & `INST_SH_MASK)  == `INST_SH)  ||
+                                         ((opcode_b_r & `INST_SW_MASK)  == `INST_SW));
+
+// Effective addresses (I-type offset for loads, S-type for stores)
+wire [31:0] pair_a_addr_w = opcode0_ra_operand_o + (issue_a_store_w ? {{20{opcode_a_r[31]}}, opcode_a_r[31:25], opcode_a_r[11:7]} :
+                                                                      {{20{opcode_a_r[31]}}, opcode_a_r[31:20]});
+wire [31:0] pair_b_addr_w = opcode1_ra_operand_o + (issue_b_store_w ? {{20{opcode_b_r[31]}}, opcode_b_r[31:25], opcode_b_r[11:7]} :
+                                                                      {{20{opcode_b_r[31]}}, opcode_b_r[31:20]});
+
+wire [31:0] pair_st_opcode_w  = issue_a_store_w ? opcode_a_r    : opcode_b_r;
+wire [31:0] pair_st_addr_w    = issue_a_store_w ? pair_a_addr_w : pair_b_addr_w;
+
+// sb: any, sh: halfword aligned, sw: word aligned
+wire        pair_st_aligned_w = (pair_st_opcode_w[13:12] == 2'd0) ||
+                                (pair_st_opcode_w[13:12] == 2'd1 && !pair_st_addr_w[0]) ||
+                                (pair_st_addr_w[1:0] == 2'b0);
+
+/* verilator lint_off UNSIGNED */
+/* verilator lint_off CMPCONST */
+wire pair_a_cacheable_w = (pair_a_addr_w >= MEM_CACHE_ADDR_MIN && pair_a_addr_w <= MEM_CACHE_ADDR_MAX);
+wire pair_b_cacheable_w = (pair_b_addr_w >= MEM_CACHE_ADDR_MIN && pair_b_addr_w <= MEM_CACHE_ADDR_MAX);
+/* verilator lint_on CMPCONST */
+/* verilator lint_on UNSIGNED */
+
+// Address conflict between the pipes: younger load of the older store's word
+wire pair_conflict_w = issue_a_store_w && issue_b_load_w && (pair_a_addr_w[31:2] == pair_b_addr_w[31:2]);
+
+wire pair_ok_w       = SUPPORT_DUAL_LSU && lsu_store_accept_i &&
+                       ((issue_a_load_w && issue_b_store_w) || (issue_a_store_w && issue_b_load_w)) &&
+                       !pair_conflict_w && pair_st_aligned_w && pair_a_cacheable_w && pair_b_cacheable_w &&
+                       (opcode_a_fault_r == 2'b0) && (opcode_b_fault_r == 2'b0);
+
+// Store not taking the LSU port (paired, or any bufferable store with forwarding)
+wire st_buf_a_w      = issue_a_store_w && (pair_ok_w ||
+                       (SUPPORT_STORE_FWD && lsu_store_accept_i && pair_st_aligned_w && pair_a_cacheable_w && (opcode_a_fault_r == 2'b0)));
+wire st_buf_b_w      = issue_b_store_w && !issue_a_store_w && (pair_ok_w ||
+                       (SUPPORT_STORE_FWD && lsu_store_accept_i && pair_st_aligned_w && pair_b_cacheable_w && (opcode_b_fault_r == 2'b0)));
+
+assign lsu_store_valid_o      = ((opcode_a_issue_r & ~nb_inject_w & st_buf_a_w) | (opcode_b_issue_r & st_buf_b_w)) & ~take_interrupt_i;
+assign lsu_store_opcode_o     = pair_st_opcode_w;
+assign lsu_store_ra_operand_o = issue_a_store_w ? opcode0_ra_operand_o : opcode1_ra_operand_o;
+assign lsu_store_rb_operand_o = issue_a_store_w ? opcode0_rb_operand_o : opcode1_rb_operand_o;
+
+// Pipe holding a buffered store (follows the pipe_ctrl E1 / E2 stages)
+reg [1:0] st_e1_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    st_e1_q <= 2'b0;
+    st_e2_q <= 2'b0;
+end
+else if (!stall_w)
+begin
+    st_e1_q <= {lsu_store_valid_o & ~issue_a_store_w, lsu_store_valid_o & issue_a_store_w};
+    st_e2_q <= squash_w ? 2'b0 : st_e1_q;
+end
+
+// Leaving E2 - pipe0 always reaches writeback, pipe1 not if pipe0 faults
+assign lsu_store_commit_o = !stall_w && (st_e2_q[0] || (st_e2_q[1] && !pipe0_squash_e1_e2_w));
+
+// Squashed (always the youngest buffered stores)
+wire   st_kill_e1_w       = !stall_w && squash_w && (|st_e1_q);
+wire   st_kill_e2_w       = !stall_w && st_e2_q[1] && pipe0_squash_e1_e2_w;
+assign lsu_store_kill_o   = {st_kill_e1_w & st_kill_e2_w, st_kill_e1_w ^ st_kill_e2_w};
+
 //-------------------------------------------------------------
 // Issue / scheduling logic
 //-------------------------------------------------------------
@@ -643,8 +1013,9 @@ wire dual_issue_ok_w =   enable_dual_issue_w &&  // Second pipe switched on
                         (((issue_a_exec_w | issue_a_lsu_w | issue_a_mul_w) && issue_b_exec_w)   ||
                          ((issue_a_exec_w | issue_a_lsu_w | issue_a_mul_w) && issue_b_branch_w) ||
                          ((issue_a_exec_w | issue_a_mul_w) && issue_b_lsu_w)                    ||
-                         ((issue_a_exec_w | issue_a_lsu_w) && issue_b_mul_w)
-                         ) && ~take_interrupt_i;
+                         ((issue_a_exec_w | issue_a_lsu_w) && issue_b_mul_w)                    ||
+                         pair_ok_w                                                                // Load / store pair
+                         ) && ~take_interrupt_i && ~nb_inject_w;
 
 always @ *
 begin
@@ -678,28 +1049,41 @@ begin
     if (pipe1_load_e1_w || pipe1_mul_e1_w)
         scoreboard_r[pipe1_rd_e1_w] = 1'b1;
 
+    // Released load destination (until written back)
+    if (nb_valid_q)
+        scoreboard_r[nb_rd_q] = 1'b1;
+    if (nb_release_w && (|nb_release_rd_w))
+        scoreboard_r[nb_release_rd_w] = 1'b1;
+
     // Do not start multiply, division or CSR operation in the cycle after a load (leaving only ALU operations and branches)
     if ((pipe0_load_e1_w || pipe0_store_e1_w || pipe1_load_e1_w || pipe1_store_e1_w ) && (issue_a_mul_w || issue_a_div_w || issue_a_csr_w))
         scoreboard_r = 32'hFFFFFFFF;
 
+    // CSR unit operations (fence, ecall, ...) wait for buffered stores to drain and
+    // for posted data cache stores (including uncached MMIO writes) to complete
+    if ((!lsu_store_empty_i || !mem_store_empty_i) && issue_a_csr_w)
+        scoreboard_r = 32'hFFFFFFFF;
+
     // Stall - no issues...
-    if (lsu_stall_i || stall_w || div_pending_q || csr_pending_q)
+    if (lsu_stall_i || stall_w || div_pending_q || csr_pending_q || wfi_sleep_q)
         ;
     // Primary slot (lsu, branch, alu, mul, div, csr)
-    else if (opcode_a_valid_r &&
+    // (late load fault carrier has no operands or result)
+    else if (opcode_a_valid_r && (nb_inject_w ||
         !(scoreboard_r[issue_a_ra_idx_w] || 
           scoreboard_r[issue_a_rb_idx_w] ||
-          scoreboard_r[issue_a_rd_idx_w]))
+          scoreboard_r[issue_a_rd_idx_w])))
     begin
         opcode_a_issue_r  = 1'b1;
         opcode_a_accept_r = 1'b1;
 
-        if (opcode_a_accept_r && issue_a_sb_alloc_w && (|issue_a_rd_idx_w))
+        // Fused pair: slot b receives the result of slot a at issue
+        if (opcode_a_accept_r && issue_a_sb_alloc_w && (|issue_a_rd_idx_w) && !fuse_w)
             scoreboard_r[issue_a_rd_idx_w] = 1'b1;
     end
 
     // Stall - no issues...
-    if (lsu_stall_i || stall_w || div_pending_q || csr_pending_q)
+    if (lsu_stall_i || stall_w || div_pending_q || csr_pending_q || wfi_sleep_q)
         ;
     // Secondary Slot (lsu, branch, alu, mul)
     else if (dual_issue_ok_w && opcode_b_valid_r && opcode_a_accept_r &&
@@ -709,7 +1093,7 @@ begin
     begin
         opcode_b_issue_r  = 1'b1;
         opcode_b_accept_r = 1'b1;
-        pipe1_mux_lsu_r   = issue_b_lsu_w;
+        pipe1_mux_lsu_r   = issue_b_lsu_w & ~(pair_ok_w & issue_b_store_w); // (paired store is buffered)
         pipe1_mux_mul_r   = issue_b_mul_w;
 
         if (opcode_b_accept_r && issue_b_sb_alloc_w && (|issue_b_rd_idx_w))
@@ -717,10 +1101,10 @@ begin
     end    
 end
 
-assign lsu_opcode_valid_o   = (pipe1_mux_lsu_r ? opcode_b_issue_r : opcode_a_issue_r) & ~take_interrupt_i;
-assign exec0_opcode_valid_o = opcode_a_issue_r;
-assign mul_opcode_valid_o   = enable_muldiv_w & (pipe1_mux_mul_r ? opcode_b_issue_r : opcode_a_issue_r);
-assign div_opcode_valid_o   = enable_muldiv_w & (opcode_a_issue_r);
+assign lsu_opcode_valid_o   = (pipe1_mux_lsu_r ? (opcode_b_issue_r & ~st_buf_b_w) : (opcode_a_issue_r & ~nb_inject_w & ~st_buf_a_w)) & ~take_interrupt_i;
+assign exec0_opcode_valid_o = opcode_a_issue_r & ~nb_inject_w;
+assign mul_opcode_valid_o   = enable_muldiv_w & (pipe1_mux_mul_r ? opcode_b_issue_r : (opcode_a_issue_r & ~nb_inject_w));
+assign div_opcode_valid_o   = enable_muldiv_w & (opcode_a_issue_r & ~nb_inject_w);
 assign interrupt_inhibit_o  = csr_pending_q || issue_a_csr_w;
 
 assign exec1_opcode_valid_o = opcode_b_issue_r;
@@ -733,6 +1117,8 @@ assign fetch1_accept_o      = ((slot1_valid_r & opcode_a_accept_r) | (opcode_b_a
 
 assign stall_w              = pipe0_stall_raw_w | pipe1_stall_raw_w;
 
+wire fuse_issue_w           = fuse_w & dual_issue_w;
+
 //-------------------------------------------------------------
 // Register File
 //------------------------------------------------------------- 
@@ -753,8 +1139,8 @@ u_regfile
     .rst_i(rst_i),
 
     // Write ports
-    .rd0_i(pipe0_rd_wb_w),
-    .rd0_value_i(pipe0_result_wb_w),
+    .rd0_i(nb_write_w ? nb_rd_q : pipe0_rd_wb_w),
+    .rd0_value_i(nb_write_w ? nb_write_value_w : pipe0_result_wb_w),
     .rd1_i(pipe1_rd_wb_w),
     .rd1_value_i(pipe1_result_wb_w),
 
@@ -779,6 +1165,7 @@ assign opcode0_rd_idx_o = issue_a_rd_idx_w;
 assign opcode0_ra_idx_o = issue_a_ra_idx_w;
 assign opcode0_rb_idx_o = issue_a_rb_idx_w;
 assign opcode0_invalid_o= 1'b0; 
+assign opcode0_rvc_o    = opcode_a_rvc_w;
 
 reg [31:0] issue_a_ra_value_r;
 reg [31:0] issue_a_rb_value_r;
@@ -841,10 +1228,26 @@ assign opcode1_rd_idx_o = issue_b_rd_idx_w;
 assign opcode1_ra_idx_o = issue_b_ra_idx_w;
 assign opcode1_rb_idx_o = issue_b_rb_idx_w;
 assign opcode1_invalid_o= 1'b0;
+assign opcode1_rvc_o    = opcode_b_rvc_w;
 
 reg [31:0] issue_b_ra_value_r;
 reg [31:0] issue_b_rb_value_r;
 
+// Result of slot a for a fused pair
+wire [31:0] fuse_value_w = fuse_lui_w   ? {opcode_a_r[31:12], 12'b0} :
+                           fuse_auipc_w ? (opcode_a_pc_r + {opcode_a_r[31:12], 12'b0}) :
+                                          (issue_a_ra_value_r << opcode_a_r[21:20]);
+
+// Slot b of a fused pair can still trap (fetch fault, misaligned jalr target)
+wire [31:0] fuse_jalr_target_w = fuse_value_w + {{20{opcode_b_r[31]}}, opcode_b_r[31:20]};
+wire        fuse_b_trap_w      = (opcode_b_fault_r != 2'b0) ||
+                                 (fuse_auipc_w && !SUPPORT_RVC && fuse_jalr_target_w[1]);
+
+// Both halves of a fused pair write the same register - the slot a write is dead
+// (and would otherwise win over slot b in the register file).  It is kept when
+// slot b traps, so the exception sees slot a complete.
+assign issue_a_rd_dead_w = fuse_issue_w && (issue_a_rd_idx_w == issue_b_rd_idx_w) && !fuse_b_trap_w;
+
 always @ *
 begin
     // NOTE: Newest version of operand takes priority
@@ -889,6 +1292,12 @@ begin
         issue_b_ra_value_r = 32'b0;
     if (issue_b_rb_idx_w == 5'b0)
         issue_b_rb_value_r = 32'b0;
+
+    // Fused pair - slot a result is not yet in the pipeline
+    if (fuse_w && fuse_ra_w)
+        issue_b_ra_value_r = fuse_value_w;
+    if (fuse_w && fuse_rb_w)
+        issue_b_rb_value_r = fuse_value_w;
 end
 
 assign opcode1_ra_operand_o = issue_b_ra_value_r;
@@ -921,7 +1330,7 @@ assign mul_opcode_invalid_o     = 1'b0;
 //-------------------------------------------------------------
 // CSR unit
 //-------------------------------------------------------------
-assign csr_opcode_valid_o       = opcode_a_issue_r & ~take_interrupt_i;
+assign csr_opcode_valid_o       = opcode_a_issue_r & ~nb_inject_w & ~take_interrupt_i;
 assign csr_opcode_opcode_o      = opcode0_opcode_o;
 assign csr_opcode_pc_o          = opcode0_pc_o;
 assign csr_opcode_rd_idx_o      = opcode0_rd_idx_o;
@@ -946,6 +1355,11 @@ u_pipe0_dec0_verif
 wire [4:0] v_pipe0_rs1_w = pipe0_opc_wb_w[19:15];
 wire [4:0] v_pipe0_rs2_w = pipe0_opc_wb_w[24:20];
 
+function [0:0] get_wfi_sleep; /*verilator public*/
+begin
+    get_wfi_sleep = wfi_sleep_q;
+end
+endfunction
 function [0:0] complete_valid0; /*verilator public*/
 begin
     complete_valid0 = pipe0_valid_wb_w;
@@ -1059,6 +1473,79 @@ begin
     complete_exception = pipe0_exception_wb_w | pipe1_exception_wb_w;
 end
 endfunction
+
+reg [31:0] stat_issue_q;
+reg [31:0] stat_fused_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    stat_issue_q <= 32'b0;
+    stat_fused_q <= 32'b0;
+end
+else
+begin
+    if (dual_issue_w)
+        stat_issue_q <= stat_issue_q + 32'd2;
+    else if (single_issue_w)
+        stat_issue_q <= stat_issue_q + 32'd1;
+
+    if (fuse_issue_w)
+        stat_fused_q <= stat_fused_q + 32'd1;
+end
+
+reg [31:0] stat_lsu_pair_q;
+reg [31:0] stat_lsu_conflict_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    stat_lsu_pair_q     <= 32'b0;
+    stat_lsu_conflict_q <= 32'b0;
+end
+else
+begin
+    if (lsu_store_valid_o)
+        stat_lsu_pair_q     <= stat_lsu_pair_q + 32'd1;
+
+    // Store / load pair split by an address conflict
+    if (SUPPORT_DUAL_LSU && opcode_a_issue_r && opcode_b_valid_r && pair_conflict_w)
+        stat_lsu_conflict_q <= stat_lsu_conflict_q + 32'd1;
+end
+
+reg [31:0] stat_load_release_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    stat_load_release_q <= 32'b0;
+else if (nb_release_w)
+    stat_load_release_q <= stat_load_release_q + 32'd1;
+
+function [31:0] get_issue_count; /*verilator public*/
+begin
+    get_issue_count = stat_issue_q;
+end
+endfunction
+function [31:0] get_fused_count; /*verilator public*/
+begin
+    get_fused_count = stat_fused_q;
+end
+endfunction
+function [31:0] get_load_release_count; /*verilator public*/
+begin
+    get_load_release_count = stat_load_release_q;
+end
+endfunction
+function [31:0] get_lsu_pair_count; /*verilator public*/
+begin
+    get_lsu_pair_count = stat_lsu_pair_q;
+end
+endfunction
+function [31:0] get_lsu_conflict_count; /*verilator public*/
+begin
+    get_lsu_conflict_count = stat_lsu_conflict_q;
+end
+endfunction
 `endif
 
 
@@ -30,6 +30,12 @@ module biriscv_lsu
 #(
      parameter MEM_CACHE_ADDR_MIN = 0
     ,parameter MEM_CACHE_ADDR_MAX = 32'hffffffff
+    ,parameter SUPPORT_NONBLOCKING_LOAD = 0
+    ,parameter SUPPORT_DUAL_LSU = 0
+    ,parameter SUPPORT_STORE_FWD = 0
+    ,parameter CBO_ZERO_ALLOC   = 0
+    ,parameter CBO_BLOCK_SIZE   = 32
+    ,parameter CBO_BLOCK_SIZE_W = 5
 )
 //-----------------------------------------------------------------
 // Ports
@@ -54,6 +60,13 @@ module biriscv_lsu
     ,input  [ 10:0]  mem_resp_tag_i
     ,input           mem_load_fault_i
     ,input           mem_store_fault_i
+    ,input           store_valid_i
+    ,input  [ 31:0]  store_opcode_i
+    ,input  [ 31:0]  store_ra_operand_i
+    ,input  [ 31:0]  store_rb_operand_i
+    ,input           store_commit_i
+    ,input  [  1:0]  store_kill_i
+    ,input           cbo_inval_flush_i
 
     // Outputs
     ,output [ 31:0]  mem_addr_o
@@ -65,10 +78,16 @@ module biriscv_lsu
     ,output          mem_invalidate_o
     ,output          mem_writeback_o
     ,output          mem_flush_o
+    ,output [ 31:0]  mem_pc_o
     ,output          writeback_valid_o
     ,output [ 31:0]  writeback_value_o
     ,output [  5:0]  writeback_exception_o
     ,output          stall_o
+    ,output          load_release_o
+    ,output          store_accept_o
+    ,output          store_empty_o
+    ,output          store_error_o
+    ,output [ 31:0]  store_error_addr_o
 );
 
 
@@ -91,34 +110,90 @@ reg          mem_writeback_q;
 reg          mem_flush_q;
 reg          mem_unaligned_e1_q;
 reg          mem_unaligned_e2_q;
+reg          mem_sc_fail_e1_q;
+reg          mem_sc_fail_e2_q;
 
 reg          mem_load_q;
+reg          mem_nb_q;
 reg          mem_xb_q;
 reg          mem_xh_q;
 reg          mem_ls_q;
+reg [ 31:0]  mem_pc_q;
+
+reg          mem_amo_rd_q;
+reg          mem_amo_wr_q;
+reg          mem_lr_q;
+reg          mem_sc_q;
+reg          mem_zero_q;
+reg          zero_busy_q;
+reg          amo_busy_q;
+reg [  4:0]  amo_op_q;
+reg [ 31:0]  amo_operand_q;
+reg [ 31:0]  amo_old_q;
+
+reg          res_valid_q;
+reg [ 31:2]  res_addr_q;
+
+wire         resp_load_w;
+wire [ 31:0] resp_addr_w;
+wire         resp_byte_w;
+wire         resp_half_w;
+wire         resp_signed_w;
+wire         resp_amo_rd_w;
+wire         resp_amo_wr_w;
+wire         resp_zero_w;
+wire         resp_drain_w;
+
+wire         sb_hold_w;
+wire         sb_drain_w;
+wire         sb_fwd_w;
+
+// Response from memory, or from the store buffer (forwarded load)
+reg          fwd_ack_q;
+reg  [ 31:0] fwd_data_q;
+
+wire         resp_ack_w   = mem_ack_i | fwd_ack_q;
+wire         resp_error_w = mem_error_i & ~fwd_ack_q;
+wire [ 31:0] resp_data_w  = fwd_ack_q ? fwd_data_q : mem_data_rd_i;
+
+integer      i;
 
 //-----------------------------------------------------------------
 // Outstanding Access Tracking
 //-----------------------------------------------------------------
 reg pending_lsu_e2_q;
+reg pending_nb_e2_q;
 
-wire issue_lsu_e1_w    = (mem_rd_o || (|mem_wr_o) || mem_writeback_o || mem_invalidate_o || mem_flush_o) && mem_accept_i;
-wire complete_ok_e2_w  = mem_ack_i & ~mem_error_i;
-wire complete_err_e2_w = mem_ack_i & mem_error_i;
+wire issue_lsu_e1_w    = ((mem_rd_o || (|mem_wr_o) || mem_writeback_o || mem_invalidate_o || mem_flush_o) && mem_accept_i) || sb_fwd_w;
+wire complete_ok_e2_w  = resp_ack_w & ~resp_error_w;
+wire complete_err_e2_w = resp_ack_w & resp_error_w & ~resp_drain_w; // (buffered store errors are reported late)
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
     pending_lsu_e2_q <= 1'b0;
 else if (issue_lsu_e1_w)
     pending_lsu_e2_q <= 1'b1;
-else if (complete_ok_e2_w || complete_err_e2_w)
+else if (resp_ack_w)
     pending_lsu_e2_q <= 1'b0;
 
+// Outstanding access is a plain cacheable load (may complete after leaving the pipeline)
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    pending_nb_e2_q <= 1'b0;
+else if (issue_lsu_e1_w)
+    pending_nb_e2_q <= mem_nb_q & mem_cacheable_q & ~sb_drain_w;
+else if (resp_ack_w)
+    pending_nb_e2_q <= 1'b0;
+
 // Delay next instruction if outstanding response is late
 wire delay_lsu_e2_w = pending_lsu_e2_q && !complete_ok_e2_w;
 
+// Request waiting in E1 behind the outstanding response
+wire busy_lsu_e1_w  = mem_rd_q || (|mem_wr_q) || mem_unaligned_e1_q || mem_sc_fail_e1_q ||
+                      mem_writeback_q || mem_invalidate_q || mem_flush_q;
+
 //-----------------------------------------------------------------
-// Dummy Ack (unaligned access /E2)
+// Dummy Ack (unaligned access, failed SC /E2)
 //-----------------------------------------------------------------
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
@@ -126,6 +201,12 @@ if (rst_i)
 else
     mem_unaligned_e2_q <= mem_unaligned_e1_q & ~delay_lsu_e2_w;
 
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    mem_sc_fail_e2_q <= 1'b0;
+else
+    mem_sc_fail_e2_q <= mem_sc_fail_e1_q & ~delay_lsu_e2_w;
+
 //-----------------------------------------------------------------
 // Opcode decode
 //-----------------------------------------------------------------
@@ -152,7 +233,30 @@ wire req_sb_w = ((opcode_opcode_i & `INST_LB_MASK) == `INST_SB);
 wire req_sh_w = ((opcode_opcode_i & `INST_LH_MASK) == `INST_SH);
 wire req_sw_w = ((opcode_opcode_i & `INST_LW_MASK) == `INST_SW);
 
-wire req_sw_lw_w = ((opcode_opcode_i & `INST_SW_MASK) == `INST_SW) || ((opcode_opcode_i & `INST_LW_MASK) == `INST_LW) || ((opcode_opcode_i & `INST_LWU_MASK) == `INST_LWU);
+wire lr_inst_w = ((opcode_opcode_i & `INST_LR_W_MASK) == `INST_LR_W);
+wire sc_inst_w = ((opcode_opcode_i & `INST_SC_W_MASK) == `INST_SC_W);
+
+wire amo_inst_w = (((opcode_opcode_i & `INST_AMOSWAP_W_MASK) == `INST_AMOSWAP_W) || 
+                   ((opcode_opcode_i & `INST_AMOADD_W_MASK) == `INST_AMOADD_W)   || 
+                   ((opcode_opcode_i & `INST_AMOXOR_W_MASK) == `INST_AMOXOR_W)   || 
+                   ((opcode_opcode_i & `INST_AMOAND_W_MASK) == `INST_AMOAND_W)   || 
+                   ((opcode_opcode_i & `INST_AMOOR_W_MASK) == `INST_AMOOR_W)     || 
+                   ((opcode_opcode_i & `INST_AMOMIN_W_MASK) == `INST_AMOMIN_W)   || 
+                   ((opcode_opcode_i & `INST_AMOMAX_W_MASK) == `INST_AMOMAX_W)   || 
+                   ((opcode_opcode_i & `INST_AMOMINU_W_MASK) == `INST_AMOMINU_W) || 
+                   ((opcode_opcode_i & `INST_AMOMAXU_W_MASK) == `INST_AMOMAXU_W));
+
+wire atomic_inst_w = lr_inst_w || sc_inst_w || amo_inst_w;
+
+// cbo.inval is performed as a flush when not permitted to discard data (CBIE = 01)
+wire cbo_inval_op_w = ((opcode_opcode_i & `INST_CBO_INVAL_MASK) == `INST_CBO_INVAL);
+wire cbo_inval_w = cbo_inval_op_w && !cbo_inval_flush_i;
+wire cbo_clean_w = ((opcode_opcode_i & `INST_CBO_CLEAN_MASK) == `INST_CBO_CLEAN);
+wire cbo_flush_w = ((opcode_opcode_i & `INST_CBO_FLUSH_MASK) == `INST_CBO_FLUSH) || (cbo_inval_op_w && cbo_inval_flush_i);
+wire cbo_zero_w  = ((opcode_opcode_i & `INST_CBO_ZERO_MASK) == `INST_CBO_ZERO);
+wire cbo_inst_w  = cbo_inval_w || cbo_clean_w || cbo_flush_w || cbo_zero_w;
+
+wire req_sw_lw_w = ((opcode_opcode_i & `INST_SW_MASK) == `INST_SW) || ((opcode_opcode_i & `INST_LW_MASK) == `INST_LW) || ((opcode_opcode_i & `INST_LWU_MASK) == `INST_LWU) || atomic_inst_w;
 wire req_sh_lh_w = ((opcode_opcode_i & `INST_SH_MASK) == `INST_SH) || ((opcode_opcode_i & `INST_LH_MASK) == `INST_LH) || ((opcode_opcode_i & `INST_LHU_MASK) == `INST_LHU);
 
 reg [31:0]  mem_addr_r;
@@ -160,6 +264,7 @@ reg         mem_unaligned_r;
 reg [31:0]  mem_data_r;
 reg         mem_rd_r;
 reg [3:0]   mem_wr_r;
+reg         mem_sc_fail_r;
 
 always @ *
 begin
@@ -168,9 +273,15 @@ begin
     mem_unaligned_r = 1'b0;
     mem_wr_r        = 4'b0;
     mem_rd_r        = 1'b0;
+    mem_sc_fail_r   = 1'b0;
 
     if (opcode_valid_i && ((opcode_opcode_i & `INST_CSRRW_MASK) == `INST_CSRRW))
         mem_addr_r = opcode_ra_operand_i;
+    else if (opcode_valid_i && atomic_inst_w)
+        mem_addr_r = opcode_ra_operand_i;
+    // Cache block operations - block aligned
+    else if (opcode_valid_i && cbo_inst_w)
+        mem_addr_r = {opcode_ra_operand_i[31:CBO_BLOCK_SIZE_W], {(CBO_BLOCK_SIZE_W){1'b0}}};
     else if (opcode_valid_i && load_inst_w)
         mem_addr_r = opcode_ra_operand_i + {{20{opcode_opcode_i[31]}}, opcode_opcode_i[31:20]};
     else
@@ -181,13 +292,24 @@ begin
     else if (opcode_valid_i && req_sh_lh_w)
         mem_unaligned_r = mem_addr_r[0];
 
-    mem_rd_r = (opcode_valid_i && load_inst_w && !mem_unaligned_r);
+    // AMOs read first, the write is issued once the old value returns
+    mem_rd_r = (opcode_valid_i && (load_inst_w || lr_inst_w || amo_inst_w) && !mem_unaligned_r);
 
-    if (opcode_valid_i && ((opcode_opcode_i & `INST_SW_MASK) == `INST_SW) && !mem_unaligned_r)
+    // SC without a matching reservation completes without accessing memory
+    if (opcode_valid_i && sc_inst_w && !mem_unaligned_r)
+        mem_sc_fail_r = !(res_valid_q && (res_addr_q == mem_addr_r[31:2]));
+
+    if (opcode_valid_i && (((opcode_opcode_i & `INST_SW_MASK) == `INST_SW) || (sc_inst_w && !mem_sc_fail_r)) && !mem_unaligned_r)
     begin
         mem_data_r  = opcode_rb_operand_i;
         mem_wr_r    = 4'hF;
     end
+    // Block zero starts with the first word of the block
+    else if (opcode_valid_i && cbo_zero_w)
+    begin
+        mem_data_r  = 32'b0;
+        mem_wr_r    = 4'hF;
+    end
     else if (opcode_valid_i && ((opcode_opcode_i & `INST_SH_MASK) == `INST_SH) && !mem_unaligned_r)
     begin
         case (mem_addr_r[1:0])
@@ -238,6 +360,297 @@ wire dcache_flush_w      = ((opcode_opcode_i & `INST_CSRRW_MASK) == `INST_CSRRW)
 wire dcache_writeback_w  = ((opcode_opcode_i & `INST_CSRRW_MASK) == `INST_CSRRW) && (opcode_opcode_i[31:20] == `CSR_DWRITEBACK);
 wire dcache_invalidate_w = ((opcode_opcode_i & `INST_CSRRW_MASK) == `INST_CSRRW) && (opcode_opcode_i[31:20] == `CSR_DINVALIDATE);
 
+// cbo.clean / cbo.flush / cbo.inval map onto the line writeback / invalidate
+// controls (cbo.flush requests both - the line is written back then invalidated).
+wire line_writeback_w    = dcache_writeback_w || cbo_clean_w || cbo_flush_w;
+wire line_invalidate_w   = dcache_invalidate_w || cbo_inval_w || cbo_flush_w;
+
+//-----------------------------------------------------------------
+// Cache block zero (cbo.zero)
+//-----------------------------------------------------------------
+// With CBO_ZERO_ALLOC, a cacheable block is zeroed by the data cache as a
+// single request (a full word write flagged as invalidate) which allocates
+// the line without a refill.  Otherwise the block is written a word at a
+// time, each write issued once the previous one is acknowledged, and only
+// the final write completes the instruction.
+/* verilator lint_off UNSIGNED */
+/* verilator lint_off CMPCONST */
+wire zero_alloc_w = CBO_ZERO_ALLOC && cbo_zero_w &&
+                    (mem_addr_r >= MEM_CACHE_ADDR_MIN && mem_addr_r <= MEM_CACHE_ADDR_MAX);
+/* verilator lint_on CMPCONST */
+/* verilator lint_on UNSIGNED */
+
+wire        zero_ack_w     = mem_ack_i && !mem_error_i && resp_zero_w;
+wire [31:0] zero_next_w    = resp_addr_w + 32'd4;
+wire        zero_more_w    = (zero_next_w[CBO_BLOCK_SIZE_W-1:2] != {(CBO_BLOCK_SIZE_W-2){1'b1}});
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    zero_busy_q <= 1'b0;
+else if (complete_err_e2_w)
+    zero_busy_q <= 1'b0;
+else if (opcode_valid_i && cbo_zero_w && !zero_alloc_w)
+    zero_busy_q <= 1'b1;
+else if (issue_lsu_e1_w && !mem_zero_q)
+    zero_busy_q <= 1'b0;
+
+//-----------------------------------------------------------------
+// Atomic memory operations
+//-----------------------------------------------------------------
+// The read is acknowledged without completing the instruction, the
+// new value is then written back to the same word and the old value
+// returned on the write ack.  No other LSU request is accepted until
+// the write has been issued.
+wire amo_rd_ack_w = mem_ack_i && !mem_error_i && resp_amo_rd_w;
+
+reg [31:0] amo_result_r;
+
+always @ *
+begin
+    case (amo_op_q)
+    5'b00001: amo_result_r = amo_operand_q;                                // amoswap
+    5'b00000: amo_result_r = mem_data_rd_i + amo_operand_q;                // amoadd
+    5'b00100: amo_result_r = mem_data_rd_i ^ amo_operand_q;                // amoxor
+    5'b01100: amo_result_r = mem_data_rd_i & amo_operand_q;                // amoand
+    5'b01000: amo_result_r = mem_data_rd_i | amo_operand_q;                // amoor
+    5'b10000: amo_result_r = ({~mem_data_rd_i[31], mem_data_rd_i[30:0]} < {~amo_operand_q[31], amo_operand_q[30:0]}) ?
+                             mem_data_rd_i : amo_operand_q;                // amomin
+    5'b10100: amo_result_r = ({~mem_data_rd_i[31], mem_data_rd_i[30:0]} > {~amo_operand_q[31], amo_operand_q[30:0]}) ?
+                             mem_data_rd_i : amo_operand_q;                // amomax
+    5'b11000: amo_result_r = (mem_data_rd_i < amo_operand_q) ? mem_data_rd_i : amo_operand_q; // amominu
+    5'b11100: amo_result_r = (mem_data_rd_i > amo_operand_q) ? mem_data_rd_i : amo_operand_q; // amomaxu
+    default:  amo_result_r = amo_operand_q;
+    endcase
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    amo_busy_q    <= 1'b0;
+    amo_op_q      <= 5'b0;
+    amo_operand_q <= 32'b0;
+end
+else if (complete_err_e2_w || mem_unaligned_e2_q)
+    amo_busy_q    <= 1'b0;
+else if (opcode_valid_i && amo_inst_w && !mem_unaligned_r)
+begin
+    amo_busy_q    <= 1'b1;
+    amo_op_q      <= opcode_opcode_i[31:27];
+    amo_operand_q <= opcode_rb_operand_i;
+end
+else if (issue_lsu_e1_w && mem_amo_wr_q)
+    amo_busy_q    <= 1'b0;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    amo_old_q <= 32'b0;
+else if (amo_rd_ack_w)
+    amo_old_q <= mem_data_rd_i;
+
+//-----------------------------------------------------------------
+// Store buffer (load / store pairing)
+//-----------------------------------------------------------------
+// A plain store issued alongside a load is written here instead of
+// taking the memory port.  Entries are kept in program order and are
+// speculative until the issue stage commits them (the store leaving E2)
+// - a pipeline squash kills the youngest.  Committed entries drain to
+// memory whenever the port is free.  A request in E1 waits for stores
+// buffered ahead of it: plain cacheable loads only for those to the
+// same word, any other access for all of them.
+// With SUPPORT_STORE_FWD all aligned, cacheable stores are buffered, and
+// a load whose bytes are all written by older entries takes its data
+// from them (one cycle, without a memory access) rather than waiting.
+// Ordering with the data cache store buffer (dcache_store_buf): every
+// access other than a plain cacheable load waits for the older entries
+// here, so stores reach the data cache port in program order and the
+// entries here are always younger than those posted in the data cache.
+// The issue stage waits for both buffers (and for drains still awaiting
+// their response) before fences / CSR / system instructions.  A drain
+// acknowledged with an error is reported on store_error_o - one posted
+// by the data cache is acked cleanly and any later error is raised by
+// the data cache, so each store is reported by one layer only.
+localparam SB_ENABLE  = SUPPORT_DUAL_LSU || SUPPORT_STORE_FWD;
+localparam SB_DEPTH   = 4;
+localparam SB_COUNT_W = 3;
+
+reg [31:2]           sb_addr_q[SB_DEPTH-1:0];
+reg [31:0]           sb_data_q[SB_DEPTH-1:0];
+reg [3:0]            sb_mask_q[SB_DEPTH-1:0];
+reg [SB_COUNT_W-1:0] sb_count_q;
+reg [SB_COUNT_W-1:0] sb_commit_q;
+
+// Drains issued but not yet acknowledged
+reg [1:0]            sb_drain_pend_q;
+
+// Entries ahead of the request in E1
+reg [SB_DEPTH-1:0]   mem_sb_older_q;
+
+// Store address / byte lanes
+wire [31:0] st_addr_w = store_ra_operand_i + {{20{store_opcode_i[31]}}, store_opcode_i[31:25], store_opcode_i[11:7]};
+
+reg [31:0] st_data_r;
+reg [3:0]  st_mask_r;
+
+always @ *
+begin
+    case (store_opcode_i[13:12])
+    2'd0: // sb
+    begin
+        st_data_r = {4{store_rb_operand_i[7:0]}};
+        st_mask_r = 4'b0001 << st_addr_w[1:0];
+    end
+    2'd1: // sh
+    begin
+        st_data_r = {2{store_rb_operand_i[15:0]}};
+        st_mask_r = st_addr_w[1] ? 4'b1100 : 4'b0011;
+    end
+    default: // sw
+    begin
+        st_data_r = store_rb_operand_i;
+        st_mask_r = 4'b1111;
+    end
+    endcase
+end
+
+reg [SB_DEPTH-1:0] sb_valid_r;
+reg                sb_match_r;
+reg [31:0]         sb_fwd_data_r;
+reg [3:0]          sb_fwd_mask_r;
+
+// Older entries to the same word, merged oldest first (youngest byte wins)
+always @ *
+begin
+    sb_match_r    = 1'b0;
+    sb_fwd_data_r = 32'b0;
+    sb_fwd_mask_r = 4'b0;
+
+    for (i=0;i<SB_DEPTH;i=i+1)
+    begin
+        /* verilator lint_off WIDTH */
+        sb_valid_r[i] = (sb_count_q > i);
+        /* verilator lint_on WIDTH */
+
+        if (sb_valid_r[i] && mem_sb_older_q[i] && (sb_addr_q[i] == mem_addr_q[31:2]))
+        begin
+            sb_match_r = 1'b1;
+
+            if (sb_mask_q[i][0]) sb_fwd_data_r[7:0]   = sb_data_q[i][7:0];
+            if (sb_mask_q[i][1]) sb_fwd_data_r[15:8]  = sb_data_q[i][15:8];
+            if (sb_mask_q[i][2]) sb_fwd_data_r[23:16] = sb_data_q[i][23:16];
+            if (sb_mask_q[i][3]) sb_fwd_data_r[31:24] = sb_data_q[i][31:24];
+
+            sb_fwd_mask_r = sb_fwd_mask_r | sb_mask_q[i];
+        end
+    end
+end
+
+wire mem_access_e1_w = mem_rd_q || (|mem_wr_q) || mem_writeback_q || mem_invalidate_q || mem_flush_q;
+
+// Bytes read by the load in E1
+wire [3:0] mem_ld_mask_w = mem_xb_q ? (4'b0001 << mem_addr_q[1:0]) :
+                           mem_xh_q ? (mem_addr_q[1] ? 4'b1100 : 4'b0011) : 4'b1111;
+
+// Every byte of the load is held in the buffer (full or partial word)
+wire sb_fwd_hit_w = SUPPORT_STORE_FWD && ((mem_ld_mask_w & ~sb_fwd_mask_r) == 4'b0);
+
+assign sb_hold_w  = SB_ENABLE && mem_access_e1_w &&
+                    ((mem_nb_q && mem_cacheable_q) ? (sb_match_r && !sb_fwd_hit_w) : (|(sb_valid_r & mem_sb_older_q)));
+
+// Load completed from the buffer instead of the memory port
+assign sb_fwd_w   = SUPPORT_STORE_FWD && mem_rd_q && mem_nb_q && mem_cacheable_q &&
+                    sb_match_r && sb_fwd_hit_w && !delay_lsu_e2_w;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    fwd_ack_q  <= 1'b0;
+    fwd_data_q <= 32'b0;
+end
+else
+begin
+    fwd_ack_q  <= sb_fwd_w;
+    fwd_data_q <= sb_fwd_data_r;
+end
+
+// Drain the oldest committed entry when the port is idle (or the request is waiting on it).
+// An AMO / cbo.zero held in E1 must be allowed to drain the stores ahead of it,
+// only the idle cycles between its own accesses are closed to the buffer.
+assign sb_drain_w = SB_ENABLE && (sb_commit_q != {SB_COUNT_W{1'b0}}) && !delay_lsu_e2_w &&
+                    (busy_lsu_e1_w ? sb_hold_w : !(amo_busy_q || zero_busy_q));
+
+wire                  sb_pop_w  = sb_drain_w && mem_accept_i;
+wire [SB_COUNT_W-1:0] sb_tail_w = sb_count_q - {{(SB_COUNT_W-1){1'b0}}, sb_pop_w};
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    for (i=0;i<SB_DEPTH;i=i+1)
+    begin
+        sb_addr_q[i] <= 30'b0;
+        sb_data_q[i] <= 32'b0;
+        sb_mask_q[i] <= 4'b0;
+    end
+end
+else
+begin
+    if (sb_pop_w)
+    begin
+        for (i=0;i<SB_DEPTH-1;i=i+1)
+        begin
+            sb_addr_q[i] <= sb_addr_q[i+1];
+            sb_data_q[i] <= sb_data_q[i+1];
+            sb_mask_q[i] <= sb_mask_q[i+1];
+        end
+    end
+
+    if (store_valid_i)
+    begin
+        sb_addr_q[sb_tail_w] <= st_addr_w[31:2];
+        sb_data_q[sb_tail_w] <= st_data_r;
+        sb_mask_q[sb_tail_w] <= st_mask_r;
+    end
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    sb_count_q  <= {SB_COUNT_W{1'b0}};
+    sb_commit_q <= {SB_COUNT_W{1'b0}};
+end
+else
+begin
+    sb_count_q  <= sb_count_q + {{(SB_COUNT_W-1){1'b0}}, store_valid_i} - {{(SB_COUNT_W-1){1'b0}}, sb_pop_w} - {1'b0, store_kill_i};
+    sb_commit_q <= sb_commit_q + {{(SB_COUNT_W-1){1'b0}}, store_commit_i} - {{(SB_COUNT_W-1){1'b0}}, sb_pop_w};
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    sb_drain_pend_q <= 2'b0;
+else
+    sb_drain_pend_q <= sb_drain_pend_q + {1'b0, sb_pop_w} - {1'b0, mem_ack_i && resp_drain_w};
+
+// Taken along with a new request in E1 (see below), then follows the drains
+wire mem_capture_w = !(complete_err_e2_w || mem_unaligned_e2_q) && !amo_rd_ack_w && !zero_ack_w &&
+                     !(busy_lsu_e1_w && (delay_lsu_e2_w || sb_hold_w)) &&
+                     !((mem_writeback_o || mem_invalidate_o || mem_flush_o || mem_rd_o || mem_wr_o != 4'b0) && !mem_accept_i);
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    mem_sb_older_q <= {SB_DEPTH{1'b0}};
+else if (mem_capture_w)
+    mem_sb_older_q <= sb_valid_r >> sb_pop_w;
+else if (sb_pop_w)
+    mem_sb_older_q <= mem_sb_older_q >> 1;
+
+/* verilator lint_off WIDTH */
+assign store_accept_o     = SB_ENABLE && (sb_count_q != SB_DEPTH);
+/* verilator lint_on WIDTH */
+assign store_empty_o      = (sb_count_q == {SB_COUNT_W{1'b0}}) && (sb_drain_pend_q == 2'b0);
+
+// Bus error on a drained store (raised late by the issue stage)
+assign store_error_o      = mem_ack_i && mem_error_i && resp_drain_w;
+assign store_error_addr_o = resp_addr_w;
+
 //-----------------------------------------------------------------
 // Sequential
 //-----------------------------------------------------------------
@@ -255,9 +668,19 @@ begin
     mem_flush_q        <= 1'b0;
     mem_unaligned_e1_q <= 1'b0;
     mem_load_q         <= 1'b0;
+    mem_nb_q           <= 1'b0;
     mem_xb_q           <= 1'b0;
     mem_xh_q           <= 1'b0;
     mem_ls_q           <= 1'b0;
+    mem_pc_q           <= 32'b0;
+    mem_sc_fail_e1_q   <= 1'b0;
+    mem_amo_rd_q       <= 1'b0;
+    mem_amo_wr_q       <= 1'b0;
+    mem_lr_q           <= 1'b0;
+    mem_sc_q           <= 1'b0;
+    mem_zero_q         <= 1'b0;
+    res_valid_q        <= 1'b0;
+    res_addr_q         <= 30'b0;
 end
 // Memory access fault - squash next operation (exception coming...)
 else if (complete_err_e2_w || mem_unaligned_e2_q)
@@ -272,11 +695,79 @@ begin
     mem_flush_q        <= 1'b0;
     mem_unaligned_e1_q <= 1'b0;
     mem_load_q         <= 1'b0;
+    mem_nb_q           <= 1'b0;
     mem_xb_q           <= 1'b0;
     mem_xh_q           <= 1'b0;
     mem_ls_q           <= 1'b0;
+    mem_pc_q           <= 32'b0;
+    mem_sc_fail_e1_q   <= 1'b0;
+    mem_amo_rd_q       <= 1'b0;
+    mem_amo_wr_q       <= 1'b0;
+    mem_lr_q           <= 1'b0;
+    mem_sc_q           <= 1'b0;
+    mem_zero_q         <= 1'b0;
+    res_valid_q        <= 1'b0;
+    res_addr_q         <= 30'b0;
 end
-else if ((mem_rd_q || (|mem_wr_q) || mem_unaligned_e1_q) && delay_lsu_e2_w)
+// AMO read response - issue the write phase
+else if (amo_rd_ack_w)
+begin
+    mem_addr_q         <= resp_addr_w;
+    mem_data_wr_q      <= amo_result_r;
+    mem_rd_q           <= 1'b0;
+    mem_wr_q           <= 4'hF;
+    mem_invalidate_q   <= 1'b0;
+    mem_writeback_q    <= 1'b0;
+    mem_flush_q        <= 1'b0;
+    mem_unaligned_e1_q <= 1'b0;
+    mem_sc_fail_e1_q   <= 1'b0;
+    mem_load_q         <= 1'b0;
+    mem_nb_q           <= 1'b0;
+    mem_xb_q           <= 1'b0;
+    mem_xh_q           <= 1'b0;
+    mem_ls_q           <= 1'b0;
+    mem_amo_rd_q       <= 1'b0;
+    mem_amo_wr_q       <= 1'b1;
+    mem_lr_q           <= 1'b0;
+    mem_sc_q           <= 1'b0;
+    mem_zero_q         <= 1'b0;
+
+/* verilator lint_off UNSIGNED */
+/* verilator lint_off CMPCONST */
+    mem_cacheable_q    <= (resp_addr_w >= MEM_CACHE_ADDR_MIN && resp_addr_w <= MEM_CACHE_ADDR_MAX);
+/* verilator lint_on CMPCONST */
+/* verilator lint_on UNSIGNED */
+end
+// Block zero write acknowledged - issue the next word
+else if (zero_ack_w)
+begin
+    mem_addr_q         <= zero_next_w;
+    mem_data_wr_q      <= 32'b0;
+    mem_rd_q           <= 1'b0;
+    mem_wr_q           <= 4'hF;
+    mem_invalidate_q   <= 1'b0;
+    mem_writeback_q    <= 1'b0;
+    mem_flush_q        <= 1'b0;
+    mem_unaligned_e1_q <= 1'b0;
+    mem_sc_fail_e1_q   <= 1'b0;
+    mem_load_q         <= 1'b0;
+    mem_nb_q           <= 1'b0;
+    mem_xb_q           <= 1'b0;
+    mem_xh_q           <= 1'b0;
+    mem_ls_q           <= 1'b0;
+    mem_amo_rd_q       <= 1'b0;
+    mem_amo_wr_q       <= 1'b0;
+    mem_lr_q           <= 1'b0;
+    mem_sc_q           <= 1'b0;
+    mem_zero_q         <= zero_more_w;
+
+/* verilator lint_off UNSIGNED */
+/* verilator lint_off CMPCONST */
+    mem_cacheable_q    <= (zero_next_w >= MEM_CACHE_ADDR_MIN && zero_next_w <= MEM_CACHE_ADDR_MAX);
+/* verilator lint_on CMPCONST */
+/* verilator lint_on UNSIGNED */
+end
+else if (busy_lsu_e1_w && (delay_lsu_e2_w || sb_hold_w))
     ;
 else if (!((mem_writeback_o || mem_invalidate_o || mem_flush_o || mem_rd_o || mem_wr_o != 4'b0) && !mem_accept_i))
 begin
@@ -289,46 +780,65 @@ begin
     mem_writeback_q    <= 1'b0;
     mem_flush_q        <= 1'b0;
     mem_unaligned_e1_q <= mem_unaligned_r;
-    mem_load_q         <= opcode_valid_i && load_inst_w;
+    mem_sc_fail_e1_q   <= mem_sc_fail_r;
+    mem_load_q         <= opcode_valid_i && (load_inst_w || lr_inst_w);
+    mem_nb_q           <= opcode_valid_i && load_inst_w && !mem_unaligned_r;
+    mem_amo_rd_q       <= mem_rd_r && amo_inst_w;
+    mem_amo_wr_q       <= 1'b0;
+    mem_lr_q           <= mem_rd_r && lr_inst_w;
+    mem_sc_q           <= opcode_valid_i && sc_inst_w && !mem_sc_fail_r && !mem_unaligned_r;
+    mem_zero_q         <= opcode_valid_i && cbo_zero_w && !zero_alloc_w;
     mem_xb_q           <= req_lb_w | req_sb_w;
     mem_xh_q           <= req_lh_w | req_sh_w;
     mem_ls_q           <= load_signed_inst_w;
+    mem_pc_q           <= opcode_pc_i;
 
 /* verilator lint_off UNSIGNED */
 /* verilator lint_off CMPCONST */
     mem_cacheable_q  <= (mem_addr_r >= MEM_CACHE_ADDR_MIN && mem_addr_r <= MEM_CACHE_ADDR_MAX) ||
-                        (opcode_valid_i && (dcache_invalidate_w || dcache_writeback_w || dcache_flush_w));
+                        (opcode_valid_i && (line_invalidate_w || line_writeback_w || dcache_flush_w));
 /* verilator lint_on CMPCONST */
 /* verilator lint_on UNSIGNED */
 
-    mem_invalidate_q <= opcode_valid_i & dcache_invalidate_w;
-    mem_writeback_q  <= opcode_valid_i & dcache_writeback_w;
+    mem_invalidate_q <= opcode_valid_i & (line_invalidate_w | zero_alloc_w);
+    mem_writeback_q  <= opcode_valid_i & line_writeback_w;
     mem_flush_q      <= opcode_valid_i & dcache_flush_w;
     mem_addr_q       <= mem_addr_r;
+
+    // Reservation set by LR, cleared by any SC
+    if (opcode_valid_i && lr_inst_w && !mem_unaligned_r)
+    begin
+        res_valid_q    <= 1'b1;
+        res_addr_q     <= mem_addr_r[31:2];
+    end
+    else if (opcode_valid_i && sc_inst_w)
+        res_valid_q    <= 1'b0;
 end
 
-assign mem_addr_o       = {mem_addr_q[31:2], 2'b0};
-assign mem_data_wr_o    = mem_data_wr_q;
-assign mem_rd_o         = mem_rd_q & ~delay_lsu_e2_w;
-assign mem_wr_o         = mem_wr_q & ~{4{delay_lsu_e2_w}};
-assign mem_cacheable_o  = mem_cacheable_q;
-assign mem_req_tag_o    = 11'b0;
-assign mem_invalidate_o = mem_invalidate_q;
-assign mem_writeback_o  = mem_writeback_q;
-assign mem_flush_o      = mem_flush_q;
+// (buffered stores are to the cacheable region only - checked at issue)
+assign mem_addr_o       = sb_drain_w ? {sb_addr_q[0], 2'b0} : {mem_addr_q[31:2], 2'b0};
+assign mem_data_wr_o    = sb_drain_w ? sb_data_q[0] : mem_data_wr_q;
+assign mem_rd_o         = mem_rd_q & ~delay_lsu_e2_w & ~sb_hold_w & ~sb_fwd_w;
+assign mem_wr_o         = sb_drain_w ? sb_mask_q[0] : (mem_wr_q & ~{4{delay_lsu_e2_w | sb_hold_w}});
+assign mem_cacheable_o  = sb_drain_w | mem_cacheable_q;
+// Atomic access flags (used by the SMP coherence port, echoed otherwise)
+assign mem_req_tag_o    = sb_drain_w ? 11'b0 : {7'b0, 1'b0, mem_sc_q, mem_amo_rd_q, mem_lr_q};
+assign mem_invalidate_o = mem_invalidate_q & ~delay_lsu_e2_w & ~sb_hold_w;
+assign mem_writeback_o  = mem_writeback_q & ~delay_lsu_e2_w & ~sb_hold_w;
+assign mem_flush_o      = mem_flush_q & ~delay_lsu_e2_w & ~sb_hold_w;
+assign mem_pc_o         = mem_pc_q;
 
 // Stall upstream if cache is busy
-assign stall_o          = ((mem_writeback_o || mem_invalidate_o || mem_flush_o || mem_rd_o || mem_wr_o != 4'b0) && !mem_accept_i) || delay_lsu_e2_w || mem_unaligned_e1_q;
+// (with non-blocking loads, a late response only holds a request queued behind it)
+wire   delay_stall_w    = SUPPORT_NONBLOCKING_LOAD ? (delay_lsu_e2_w && busy_lsu_e1_w) : delay_lsu_e2_w;
+assign stall_o          = ((mem_writeback_o || mem_invalidate_o || mem_flush_o || mem_rd_o || mem_wr_o != 4'b0) && !mem_accept_i) || delay_stall_w || mem_unaligned_e1_q || amo_busy_q || zero_busy_q || sb_hold_w;
 
-wire        resp_load_w;
-wire [31:0] resp_addr_w;
-wire        resp_byte_w;
-wire        resp_half_w;
-wire        resp_signed_w;
+// Late response belongs to a load which may leave the pipeline without it
+assign load_release_o   = SUPPORT_NONBLOCKING_LOAD && delay_lsu_e2_w && pending_nb_e2_q;
 
 biriscv_lsu_fifo
 #(
-     .WIDTH(36)
+     .WIDTH(40)
     ,.DEPTH(2)
     ,.ADDR_W(1)
 )
@@ -337,13 +847,14 @@ u_lsu_request
      .clk_i(clk_i)
     ,.rst_i(rst_i)
 
-    ,.push_i(((mem_rd_o || (|mem_wr_o) || mem_writeback_o || mem_invalidate_o || mem_flush_o) && mem_accept_i) || (mem_unaligned_e1_q && ~delay_lsu_e2_w))
-    ,.data_in_i({mem_addr_q, mem_ls_q, mem_xh_q, mem_xb_q, mem_load_q})
+    ,.push_i(issue_lsu_e1_w || ((mem_unaligned_e1_q || mem_sc_fail_e1_q) && ~delay_lsu_e2_w))
+    ,.data_in_i(sb_drain_w ? {sb_addr_q[0], 2'b0, 7'b0, 1'b1} :
+                             {mem_addr_q, mem_zero_q, mem_amo_wr_q, mem_amo_rd_q, mem_ls_q, mem_xh_q, mem_xb_q, mem_load_q, 1'b0})
     ,.accept_o()
 
     ,.valid_o()
-    ,.data_out_o({resp_addr_w, resp_signed_w, resp_half_w, resp_byte_w, resp_load_w})
-    ,.pop_i(mem_ack_i || mem_unaligned_e2_q)
+    ,.data_out_o({resp_addr_w, resp_zero_w, resp_amo_wr_w, resp_amo_rd_w, resp_signed_w, resp_half_w, resp_byte_w, resp_load_w, resp_drain_w})
+    ,.pop_i(resp_ack_w || mem_unaligned_e2_q || mem_sc_fail_e2_q)
 );
 
 //-----------------------------------------------------------------
@@ -366,18 +877,27 @@ begin
     load_signed_r = resp_signed_w;
 
     // Access fault - pass badaddr on writeback result bus
-    if ((mem_ack_i && mem_error_i) || mem_unaligned_e2_q)
+    if ((resp_ack_w && resp_error_w) || mem_unaligned_e2_q)
         wb_result_r = resp_addr_w;
+    // SC without reservation
+    else if (mem_sc_fail_e2_q)
+        wb_result_r = 32'd1;
+    // SC dropped by the memory system (reservation lost to another hart)
+    else if (mem_ack_i && mem_resp_tag_i[`MEM_TAG_SC_FAIL])
+        wb_result_r = 32'd1;
+    // AMO write complete - return original memory value
+    else if (mem_ack_i && resp_amo_wr_w)
+        wb_result_r = amo_old_q;
     // Handle responses
-    else if (mem_ack_i && resp_load_w)
+    else if (resp_ack_w && resp_load_w)
     begin
         if (load_byte_r)
         begin
             case (addr_lsb_r[1:0])
-            2'h3: wb_result_r = {24'b0, mem_data_rd_i[31:24]};
-            2'h2: wb_result_r = {24'b0, mem_data_rd_i[23:16]};
-            2'h1: wb_result_r = {24'b0, mem_data_rd_i[15:8]};
-            2'h0: wb_result_r = {24'b0, mem_data_rd_i[7:0]};
+            2'h3: wb_result_r = {24'b0, resp_data_w[31:24]};
+            2'h2: wb_result_r = {24'b0, resp_data_w[23:16]};
+            2'h1: wb_result_r = {24'b0, resp_data_w[15:8]};
+            2'h0: wb_result_r = {24'b0, resp_data_w[7:0]};
             endcase
 
             if (load_signed_r && wb_result_r[7])
@@ -386,27 +906,27 @@ begin
         else if (load_half_r)
         begin
             if (addr_lsb_r[1])
-                wb_result_r = {16'b0, mem_data_rd_i[31:16]};
+                wb_result_r = {16'b0, resp_data_w[31:16]};
             else
-                wb_result_r = {16'b0, mem_data_rd_i[15:0]};
+                wb_result_r = {16'b0, resp_data_w[15:0]};
 
             if (load_signed_r && wb_result_r[15])
                 wb_result_r = {16'hFFFF, wb_result_r[15:0]};
         end
         else
-            wb_result_r = mem_data_rd_i;
+            wb_result_r = resp_data_w;
     end
 end
 
-assign writeback_valid_o    = mem_ack_i | mem_unaligned_e2_q;
+assign writeback_valid_o    = (resp_ack_w & ~amo_rd_ack_w & ~zero_ack_w & ~resp_drain_w) | mem_unaligned_e2_q | mem_sc_fail_e2_q;
 assign writeback_value_o    = wb_result_r;
 
 wire fault_load_align_w     = mem_unaligned_e2_q & resp_load_w;
 wire fault_store_align_w    = mem_unaligned_e2_q & ~resp_load_w;
-wire fault_load_bus_w       = mem_error_i &&  resp_load_w;
-wire fault_store_bus_w      = mem_error_i && ~resp_load_w;
-wire fault_load_page_w      = mem_error_i && mem_load_fault_i;
-wire fault_store_page_w     = mem_error_i && mem_store_fault_i;
+wire fault_load_bus_w       = resp_error_w &&  resp_load_w;
+wire fault_store_bus_w      = resp_error_w && ~resp_load_w;
+wire fault_load_page_w      = resp_error_w && mem_load_fault_i && resp_load_w;
+wire fault_store_page_w     = resp_error_w && (mem_store_fault_i || (mem_load_fault_i && ~resp_load_w)); // AMO read
 
 
 assign writeback_exception_o         = fault_load_align_w  ? `EXCEPTION_MISALIGNED_LOAD:
@@ -417,6 +937,34 @@ assign writeback_exception_o         = fault_load_align_w  ? `EXCEPTION_MISALIGN
                                        fault_store_bus_w   ? `EXCEPTION_FAULT_STORE:
                                        `EXCEPTION_W'b0;
 
+`ifdef verilator
+reg [31:0] stat_sb_wait_q;
+reg [31:0] stat_sb_fwd_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    stat_sb_wait_q <= 32'b0;
+else if (sb_hold_w)
+    stat_sb_wait_q <= stat_sb_wait_q + 32'd1;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    stat_sb_fwd_q <= 32'b0;
+else if (sb_fwd_w)
+    stat_sb_fwd_q <= stat_sb_fwd_q + 32'd1;
+
+function [31:0] get_store_wait_count; /*verilator public*/
+begin
+    get_store_wait_count = stat_sb_wait_q;
+end
+endfunction
+function [31:0] get_store_fwd_count; /*verilator public*/
+begin
+    get_store_fwd_count = stat_sb_fwd_q;
+end
+endfunction
+`endif
+
 endmodule 
 
 module biriscv_lsu_fifo
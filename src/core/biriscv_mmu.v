@@ -31,6 +31,12 @@ module biriscv_mmu
      parameter MEM_CACHE_ADDR_MIN = 0
     ,parameter MEM_CACHE_ADDR_MAX = 32'hffffffff
     ,parameter SUPPORT_MMU      = 1
+    ,parameter ITLB_ENTRIES     = 8
+    ,parameter ITLB_ENTRIES_W   = 3
+    ,parameter DTLB_ENTRIES     = 8
+    ,parameter DTLB_ENTRIES_W   = 3
+    ,parameter PTW_CACHE_ENTRIES   = 4
+    ,parameter PTW_CACHE_ENTRIES_W = 2
 )
 //-----------------------------------------------------------------
 // Ports
@@ -112,6 +118,10 @@ localparam  STATE_LEVEL_FIRST  = 1;
 localparam  STATE_LEVEL_SECOND = 2;
 localparam  STATE_UPDATE       = 3;
 
+// Page table walks started (TLB misses)
+wire        itlb_walk_w;
+wire        dtlb_walk_w;
+
 //-----------------------------------------------------------------
 // Basic MMU support
 //-----------------------------------------------------------------
@@ -154,15 +164,20 @@ begin
     wire       load_w  = lsu_in_rd_i | load_q;
     wire [3:0] store_w = lsu_in_wr_i | store_q;
 
+    // Line writeback / invalidate (held by the LSU until accepted) are
+    // translated and permission checked as stores
+    wire       line_op_w = (lsu_in_invalidate_i | lsu_in_writeback_i) & ~(|lsu_in_wr_i);
+    wire       access_w  = load_w || (|store_w) || line_op_w;
+
     reg [31:0] lsu_in_addr_q;
 
     always @ (posedge clk_i or posedge rst_i)
     if (rst_i)
         lsu_in_addr_q <= 32'b0;
-    else if (load_w || (|store_w))
+    else if (access_w)
         lsu_in_addr_q <= lsu_in_addr_i;
 
-    wire [31:0] lsu_addr_w = (load_w || (|store_w)) ? lsu_in_addr_i : lsu_in_addr_q;
+    wire [31:0] lsu_addr_w = access_w ? lsu_in_addr_i : lsu_in_addr_q;
 
     //-----------------------------------------------------------------
     // Page table walker
@@ -175,6 +190,7 @@ begin
     // Global enable
     wire        vm_enable_w = satp_i[`SATP_MODE_R];
     wire [31:0] ptbr_w      = {satp_i[`SATP_PPN_R], 12'b0};
+    wire [8:0]  asid_w      = satp_i[`SATP_ASID_R];
 
     wire        ifetch_vm_w = (fetch_in_priv_i != `PRIV_MACHINE);
     wire        dfetch_vm_w = (priv_d_i != `PRIV_MACHINE);
@@ -187,7 +203,7 @@ begin
 
     // TLB entry does not match request address
     wire        itlb_miss_w = fetch_in_rd_i & vm_i_enable_w & ~itlb_hit_w;
-    wire        dtlb_miss_w = (load_w || (|store_w)) & vm_d_enable_w & ~dtlb_hit_w;
+    wire        dtlb_miss_w = access_w & vm_d_enable_w & ~dtlb_hit_w;
 
     // Data miss is higher priority than instruction...
     wire [31:0] request_addr_w = idle_w ? 
@@ -197,6 +213,62 @@ begin
     reg [31:0]  pte_addr_q;
     reg [31:0]  pte_entry_q;
     reg [31:0]  virt_addr_q;
+    reg [8:0]   walk_asid_q;
+    reg         walk_abort_q;
+
+    //-----------------------------------------------------------------
+    // Page walk cache (first level, non-leaf PTEs)
+    //-----------------------------------------------------------------
+    reg [PTW_CACHE_ENTRIES-1:0]   pwc_valid_q;
+    reg [31:22]                   pwc_va_addr_q[0:PTW_CACHE_ENTRIES-1];
+    reg [8:0]                     pwc_asid_q[0:PTW_CACHE_ENTRIES-1];
+    reg [19:0]                    pwc_ppn_q[0:PTW_CACHE_ENTRIES-1];
+    reg [PTW_CACHE_ENTRIES_W-1:0] pwc_next_q;
+
+    reg                           pwc_hit_r;
+    reg [19:0]                    pwc_ppn_r;
+    integer                       p;
+
+    always @ *
+    begin
+        pwc_hit_r = 1'b0;
+        pwc_ppn_r = 20'b0;
+
+        for (p=0;p<PTW_CACHE_ENTRIES;p=p+1)
+        begin
+            if (pwc_valid_q[p] && pwc_va_addr_q[p] == request_addr_w[31:22] && pwc_asid_q[p] == asid_w)
+            begin
+                pwc_hit_r = 1'b1;
+                pwc_ppn_r = pwc_ppn_q[p];
+            end
+        end
+    end
+
+    // Valid pointer to next level table
+    wire pwc_fill_w = (state_q == STATE_LEVEL_FIRST) && resp_valid_w && !resp_error_w && resp_data_w[`PAGE_PRESENT] &&
+                      !(resp_data_w[`PAGE_READ] || resp_data_w[`PAGE_WRITE] || resp_data_w[`PAGE_EXEC]) && !walk_abort_q;
+
+    always @ (posedge clk_i or posedge rst_i)
+    if (rst_i)
+    begin
+        pwc_valid_q <= {PTW_CACHE_ENTRIES{1'b0}};
+        pwc_next_q  <= {PTW_CACHE_ENTRIES_W{1'b0}};
+    end
+    else if (flush_i)
+        pwc_valid_q <= {PTW_CACHE_ENTRIES{1'b0}};
+    else if (pwc_fill_w)
+    begin
+        pwc_valid_q[pwc_next_q] <= 1'b1;
+        pwc_next_q              <= pwc_next_q + 1;
+    end
+
+    always @ (posedge clk_i)
+    if (pwc_fill_w)
+    begin
+        pwc_va_addr_q[pwc_next_q] <= virt_addr_q[31:22];
+        pwc_asid_q[pwc_next_q]    <= walk_asid_q;
+        pwc_ppn_q[pwc_next_q]     <= resp_data_w[29:10];
+    end
 
     wire [31:0] pte_ppn_w   = {`PAGE_PFN_SHIFT'b0, resp_data_w[31:`PAGE_PFN_SHIFT]};
     wire [9:0]  pte_flags_w = resp_data_w[9:0];
@@ -207,16 +279,28 @@ begin
         pte_addr_q  <= 32'b0;
         pte_entry_q <= 32'b0;
         virt_addr_q <= 32'b0;
+        walk_asid_q <= 9'b0;
         dtlb_req_q  <= 1'b0;
         state_q     <= STATE_IDLE;
     end
     else
     begin
+        // TLB miss, first level PTE cached - skip to second level
+        if (state_q == STATE_IDLE && (itlb_miss_w || dtlb_miss_w) && pwc_hit_r)
+        begin
+            pte_addr_q  <= {pwc_ppn_r, 12'b0} + {20'b0, request_addr_w[21:12], 2'b0};
+            virt_addr_q <= request_addr_w;
+            walk_asid_q <= asid_w;
+            dtlb_req_q  <= dtlb_miss_w;
+
+            state_q     <= STATE_LEVEL_SECOND;
+        end
         // TLB miss, walk page table
-        if (state_q == STATE_IDLE && (itlb_miss_w || dtlb_miss_w))
+        else if (state_q == STATE_IDLE && (itlb_miss_w || dtlb_miss_w))
         begin
             pte_addr_q  <= ptbr_w + {20'b0, request_addr_w[31:22], 2'b0};
             virt_addr_q <= request_addr_w;
+            walk_asid_q <= asid_w;
             dtlb_req_q  <= dtlb_miss_w;
 
             state_q     <= STATE_LEVEL_FIRST;
@@ -265,37 +349,107 @@ begin
         end
     end
 
+    // TLB flush whilst walking - result must not be inserted
+    always @ (posedge clk_i or posedge rst_i)
+    if (rst_i)
+        walk_abort_q <= 1'b0;
+    else if (state_q == STATE_IDLE)
+        walk_abort_q <= 1'b0;
+    else if (flush_i)
+        walk_abort_q <= 1'b1;
+
+    assign itlb_walk_w = (state_q == STATE_IDLE) && itlb_miss_w && !dtlb_miss_w;
+    assign dtlb_walk_w = (state_q == STATE_IDLE) && dtlb_miss_w;
+
     //-----------------------------------------------------------------
     // IMMU TLB
     //-----------------------------------------------------------------
-    reg         itlb_valid_q;
-    reg [31:12] itlb_va_addr_q;
-    reg [31:0]  itlb_entry_q;
+    reg [ITLB_ENTRIES-1:0] itlb_valid_q;
+    reg [ITLB_ENTRIES-1:0] itlb_used_q;
+    reg [31:12]            itlb_va_addr_q[0:ITLB_ENTRIES-1];
+    reg [8:0]              itlb_asid_q[0:ITLB_ENTRIES-1];
+    reg [31:0]             itlb_entry_q[0:ITLB_ENTRIES-1];
+
+    // Fully associative lookup (global pages match any ASID)
+    reg [ITLB_ENTRIES-1:0] itlb_match_r;
+    reg [31:0]             itlb_entry_r;
+    integer                i;
+
+    always @ *
+    begin
+        itlb_match_r = {ITLB_ENTRIES{1'b0}};
+        itlb_entry_r = 32'b0;
+
+        for (i=0;i<ITLB_ENTRIES;i=i+1)
+        begin
+            if (itlb_valid_q[i] && itlb_va_addr_q[i] == fetch_in_pc_i[31:12] &&
+               (itlb_entry_q[i][`PAGE_GLOBAL] || itlb_asid_q[i] == asid_w))
+            begin
+                itlb_match_r[i] = 1'b1;
+                itlb_entry_r    = itlb_entry_q[i];
+            end
+        end
+    end
+
+    // Replacement: first invalid entry, else first not recently used entry
+    reg [ITLB_ENTRIES_W-1:0] itlb_victim_r;
+
+    always @ *
+    begin
+        itlb_victim_r = {ITLB_ENTRIES_W{1'b0}};
+
+        for (i=ITLB_ENTRIES-1;i>=0;i=i-1)
+            if (!itlb_used_q[i])
+                itlb_victim_r = i;
+
+        for (i=ITLB_ENTRIES-1;i>=0;i=i-1)
+            if (!itlb_valid_q[i])
+                itlb_victim_r = i;
+    end
+
+    wire itlb_fill_w = (state_q == STATE_UPDATE) && !dtlb_req_q && !walk_abort_q;
 
     always @ (posedge clk_i or posedge rst_i)
     if (rst_i)
-        itlb_valid_q <= 1'b0;
+        itlb_valid_q <= {ITLB_ENTRIES{1'b0}};
     else if (flush_i)
-        itlb_valid_q <= 1'b0;
-    else if (state_q == STATE_UPDATE && !dtlb_req_q)
-        itlb_valid_q <= (itlb_va_addr_q == fetch_in_pc_i[31:12]); // Fetch TLB still matches incoming request
-    else if (state_q != STATE_IDLE && !dtlb_req_q)
-        itlb_valid_q <= 1'b0;
+        itlb_valid_q <= {ITLB_ENTRIES{1'b0}};
+    else if (itlb_fill_w)
+        itlb_valid_q[itlb_victim_r] <= 1'b1;
 
-    always @ (posedge clk_i or posedge rst_i)
-    if (rst_i)
+    always @ (posedge clk_i)
+    if (itlb_fill_w)
     begin
-        itlb_va_addr_q <= 20'b0;
-        itlb_entry_q   <= 32'b0;
+        itlb_va_addr_q[itlb_victim_r] <= virt_addr_q[31:12];
+        itlb_asid_q[itlb_victim_r]    <= walk_asid_q;
+        itlb_entry_q[itlb_victim_r]   <= pte_entry_q;
     end
-    else if (state_q == STATE_UPDATE && !dtlb_req_q)
+
+    // TLB address matched (even on page fault)
+    assign itlb_hit_w   = fetch_in_rd_i & (|itlb_match_r);
+
+    // Pseudo-LRU: mark entries as used, clearing all others when every entry is marked
+    reg [ITLB_ENTRIES-1:0] itlb_touch_r;
+
+    always @ *
     begin
-        itlb_va_addr_q <= virt_addr_q[31:12];
-        itlb_entry_q   <= pte_entry_q;
+        itlb_touch_r = {ITLB_ENTRIES{1'b0}};
+
+        if (itlb_fill_w)
+            itlb_touch_r[itlb_victim_r] = 1'b1;
+        else if (itlb_hit_w)
+            itlb_touch_r = itlb_match_r;
     end
 
-    // TLB address matched (even on page fault)
-    assign itlb_hit_w   = fetch_in_rd_i & itlb_valid_q & (itlb_va_addr_q == fetch_in_pc_i[31:12]);
+    always @ (posedge clk_i or posedge rst_i)
+    if (rst_i)
+        itlb_used_q <= {ITLB_ENTRIES{1'b0}};
+    else if (flush_i)
+        itlb_used_q <= {ITLB_ENTRIES{1'b0}};
+    else if (&(itlb_used_q | itlb_touch_r))
+        itlb_used_q <= itlb_touch_r;
+    else
+        itlb_used_q <= itlb_used_q | itlb_touch_r;
 
     reg pc_fault_r;
     always @ *
@@ -308,15 +462,15 @@ begin
             if (supervisor_i_w)
             begin
                 // User page, supervisor cannot execute
-                if (itlb_entry_q[`PAGE_USER])
+                if (itlb_entry_r[`PAGE_USER])
                     pc_fault_r = 1'b1;
                 // Check exec permissions
                 else
-                    pc_fault_r = ~itlb_entry_q[`PAGE_EXEC];
+                    pc_fault_r = ~itlb_entry_r[`PAGE_EXEC];
             end
             // User mode
             else
-                pc_fault_r = (~itlb_entry_q[`PAGE_EXEC]) | (~itlb_entry_q[`PAGE_USER]);
+                pc_fault_r = (~itlb_entry_r[`PAGE_EXEC]) | (~itlb_entry_r[`PAGE_USER]);
         end
     end
 
@@ -329,7 +483,7 @@ begin
         pc_fault_q <= pc_fault_r;
 
     assign fetch_out_rd_o         = (~vm_i_enable_w & fetch_in_rd_i) || (itlb_hit_w & ~pc_fault_r);
-    assign fetch_out_pc_o         = vm_i_enable_w ? {itlb_entry_q[31:12], fetch_in_pc_i[11:0]} : fetch_in_pc_i;
+    assign fetch_out_pc_o         = vm_i_enable_w ? {itlb_entry_r[31:12], fetch_in_pc_i[11:0]} : fetch_in_pc_i;
     assign fetch_out_flush_o      = fetch_in_flush_i;
     assign fetch_out_invalidate_o = fetch_in_invalidate_i; // TODO: ...
 
@@ -342,32 +496,92 @@ begin
     //-----------------------------------------------------------------
     // DMMU TLB
     //-----------------------------------------------------------------
-    reg         dtlb_valid_q;
-    reg [31:12] dtlb_va_addr_q;
-    reg [31:0]  dtlb_entry_q;
+    reg [DTLB_ENTRIES-1:0] dtlb_valid_q;
+    reg [DTLB_ENTRIES-1:0] dtlb_used_q;
+    reg [31:12]            dtlb_va_addr_q[0:DTLB_ENTRIES-1];
+    reg [8:0]              dtlb_asid_q[0:DTLB_ENTRIES-1];
+    reg [31:0]             dtlb_entry_q[0:DTLB_ENTRIES-1];
+
+    // Fully associative lookup (global pages match any ASID)
+    reg [DTLB_ENTRIES-1:0] dtlb_match_r;
+    reg [31:0]             dtlb_entry_r;
+    integer                d;
+
+    always @ *
+    begin
+        dtlb_match_r = {DTLB_ENTRIES{1'b0}};
+        dtlb_entry_r = 32'b0;
+
+        for (d=0;d<DTLB_ENTRIES;d=d+1)
+        begin
+            if (dtlb_valid_q[d] && dtlb_va_addr_q[d] == lsu_addr_w[31:12] &&
+               (dtlb_entry_q[d][`PAGE_GLOBAL] || dtlb_asid_q[d] == asid_w))
+            begin
+                dtlb_match_r[d] = 1'b1;
+                dtlb_entry_r    = dtlb_entry_q[d];
+            end
+        end
+    end
+
+    // Replacement: first invalid entry, else first not recently used entry
+    reg [DTLB_ENTRIES_W-1:0] dtlb_victim_r;
+
+    always @ *
+    begin
+        dtlb_victim_r = {DTLB_ENTRIES_W{1'b0}};
+
+        for (d=DTLB_ENTRIES-1;d>=0;d=d-1)
+            if (!dtlb_used_q[d])
+                dtlb_victim_r = d;
+
+        for (d=DTLB_ENTRIES-1;d>=0;d=d-1)
+            if (!dtlb_valid_q[d])
+                dtlb_victim_r = d;
+    end
+
+    wire dtlb_fill_w = (state_q == STATE_UPDATE) && dtlb_req_q && !walk_abort_q;
 
     always @ (posedge clk_i or posedge rst_i)
     if (rst_i)
-        dtlb_valid_q <= 1'b0;
+        dtlb_valid_q <= {DTLB_ENTRIES{1'b0}};
     else if (flush_i)
-        dtlb_valid_q <= 1'b0;
-    else if (state_q == STATE_UPDATE && dtlb_req_q)
-        dtlb_valid_q <= 1'b1;
+        dtlb_valid_q <= {DTLB_ENTRIES{1'b0}};
+    else if (dtlb_fill_w)
+        dtlb_valid_q[dtlb_victim_r] <= 1'b1;
 
-    always @ (posedge clk_i or posedge rst_i)
-    if (rst_i)
+    always @ (posedge clk_i)
+    if (dtlb_fill_w)
     begin
-        dtlb_va_addr_q <= 20'b0;
-        dtlb_entry_q   <= 32'b0;
+        dtlb_va_addr_q[dtlb_victim_r] <= virt_addr_q[31:12];
+        dtlb_asid_q[dtlb_victim_r]    <= walk_asid_q;
+        dtlb_entry_q[dtlb_victim_r]   <= pte_entry_q;
     end
-    else if (state_q == STATE_UPDATE && dtlb_req_q)
+
+    // TLB address matched (even on page fault)
+    assign dtlb_hit_w   = |dtlb_match_r;
+
+    // Pseudo-LRU: mark entries as used, clearing all others when every entry is marked
+    reg [DTLB_ENTRIES-1:0] dtlb_touch_r;
+
+    always @ *
     begin
-        dtlb_va_addr_q <= virt_addr_q[31:12];
-        dtlb_entry_q   <= pte_entry_q;
+        dtlb_touch_r = {DTLB_ENTRIES{1'b0}};
+
+        if (dtlb_fill_w)
+            dtlb_touch_r[dtlb_victim_r] = 1'b1;
+        else if (access_w && dtlb_hit_w)
+            dtlb_touch_r = dtlb_match_r;
     end
 
-    // TLB address matched (even on page fault)
-    assign dtlb_hit_w   = dtlb_valid_q & (dtlb_va_addr_q == lsu_addr_w[31:12]);
+    always @ (posedge clk_i or posedge rst_i)
+    if (rst_i)
+        dtlb_used_q <= {DTLB_ENTRIES{1'b0}};
+    else if (flush_i)
+        dtlb_used_q <= {DTLB_ENTRIES{1'b0}};
+    else if (&(dtlb_used_q | dtlb_touch_r))
+        dtlb_used_q <= dtlb_touch_r;
+    else
+        dtlb_used_q <= dtlb_used_q | dtlb_touch_r;
 
     reg load_fault_r;
     always @ *
@@ -380,15 +594,15 @@ begin
             if (supervisor_d_w)
             begin
                 // User page, supervisor user mode not enabled
-                if (dtlb_entry_q[`PAGE_USER] && !sum_i)
+                if (dtlb_entry_r[`PAGE_USER] && !sum_i)
                     load_fault_r = 1'b1;
                 // Check exec permissions
                 else
-                    load_fault_r = ~(dtlb_entry_q[`PAGE_READ] | (mxr_i & dtlb_entry_q[`PAGE_EXEC]));
+                    load_fault_r = ~(dtlb_entry_r[`PAGE_READ] | (mxr_i & dtlb_entry_r[`PAGE_EXEC]));
             end
             // User mode
             else
-                load_fault_r = (~dtlb_entry_q[`PAGE_READ]) | (~dtlb_entry_q[`PAGE_USER]);
+                load_fault_r = (~dtlb_entry_r[`PAGE_READ]) | (~dtlb_entry_r[`PAGE_USER]);
         end
     end
 
@@ -397,21 +611,21 @@ begin
     begin
         store_fault_r = 1'b0;
 
-        if (vm_d_enable_w && (|store_w) && dtlb_hit_w)
+        if (vm_d_enable_w && ((|store_w) || line_op_w) && dtlb_hit_w)
         begin
             // Supervisor mode
             if (supervisor_d_w)
             begin
                 // User page, supervisor user mode not enabled
-                if (dtlb_entry_q[`PAGE_USER] && !sum_i)
+                if (dtlb_entry_r[`PAGE_USER] && !sum_i)
                     store_fault_r = 1'b1;
                 // Check exec permissions
                 else
-                    store_fault_r = (~dtlb_entry_q[`PAGE_READ]) | (~dtlb_entry_q[`PAGE_WRITE]);
+                    store_fault_r = (~dtlb_entry_r[`PAGE_READ]) | (~dtlb_entry_r[`PAGE_WRITE]);
             end
             // User mode
             else
-                store_fault_r = (~dtlb_entry_q[`PAGE_READ]) | (~dtlb_entry_q[`PAGE_WRITE]) | (~dtlb_entry_q[`PAGE_USER]);
+                store_fault_r = (~dtlb_entry_r[`PAGE_READ]) | (~dtlb_entry_r[`PAGE_WRITE]) | (~dtlb_entry_r[`PAGE_USER]);
         end
     end
 
@@ -432,11 +646,13 @@ begin
 
     wire        lsu_out_rd_w         = vm_d_enable_w ? (load_w  & dtlb_hit_w & ~load_fault_r)       : lsu_in_rd_i;
     wire [3:0]  lsu_out_wr_w         = vm_d_enable_w ? (store_w & {4{dtlb_hit_w & ~store_fault_r}}) : lsu_in_wr_i;
-    wire [31:0] lsu_out_addr_w       = vm_d_enable_w ? {dtlb_entry_q[31:12], lsu_addr_w[11:0]}      : lsu_addr_w;
+    wire [31:0] lsu_out_addr_w       = vm_d_enable_w ? {dtlb_entry_r[31:12], lsu_addr_w[11:0]}      : lsu_addr_w;
     wire [31:0] lsu_out_data_wr_w    = lsu_in_data_wr_i;
 
-    wire        lsu_out_invalidate_w = lsu_in_invalidate_i;
-    wire        lsu_out_writeback_w  = lsu_in_writeback_i;
+    // Held with the access whilst translating (a line zero is a store flagged as invalidate)
+    wire        lsu_out_op_en_w      = ~vm_d_enable_w | (dtlb_hit_w & ~store_fault_r);
+    wire        lsu_out_invalidate_w = lsu_in_invalidate_i & lsu_out_op_en_w;
+    wire        lsu_out_writeback_w  = lsu_in_writeback_i & lsu_out_op_en_w;
 
     reg         lsu_out_cacheable_r;
     always @ *
@@ -548,7 +764,43 @@ begin
     assign lsu_in_load_fault_o    = 1'b0;
 
     assign lsu_in_accept_o        = lsu_out_accept_i;
+
+    assign itlb_walk_w            = 1'b0;
+    assign dtlb_walk_w            = 1'b0;
 end
 endgenerate
 
+//-----------------------------------------------------------------
+// Stats
+//-----------------------------------------------------------------
+`ifdef verilator
+reg [31:0] stat_itlb_miss_q;
+reg [31:0] stat_dtlb_miss_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    stat_itlb_miss_q <= 32'b0;
+    stat_dtlb_miss_q <= 32'b0;
+end
+else
+begin
+    if (itlb_walk_w)
+        stat_itlb_miss_q <= stat_itlb_miss_q + 32'd1;
+    if (dtlb_walk_w)
+        stat_dtlb_miss_q <= stat_dtlb_miss_q + 32'd1;
+end
+
+function [31:0] get_itlb_miss_count; /*verilator public*/
+begin
+    get_itlb_miss_count = stat_itlb_miss_q;
+end
+endfunction
+function [31:0] get_dtlb_miss_count; /*verilator public*/
+begin
+    get_dtlb_miss_count = stat_dtlb_miss_q;
+end
+endfunction
+`endif
+
 endmodule
@@ -38,6 +38,7 @@ module biriscv_npc
     ,parameter BHT_ENABLE       = 1
     ,parameter NUM_RAS_ENTRIES  = 8
     ,parameter NUM_RAS_ENTRIES_W = 3
+    ,parameter SUPPORT_RVC      = 0
 )
 //-----------------------------------------------------------------
 // Ports
@@ -51,21 +52,25 @@ module biriscv_npc
     ,input           branch_is_taken_i
     ,input           branch_is_not_taken_i
     ,input  [ 31:0]  branch_source_i
+    ,input           branch_is_rvc_i
     ,input           branch_is_call_i
     ,input           branch_is_ret_i
     ,input           branch_is_jmp_i
     ,input  [ 31:0]  branch_pc_i
     ,input  [ 31:0]  pc_f_i
     ,input           pc_accept_i
+    ,input           btb_invalidate_i
+    ,input  [ 31:0]  btb_invalidate_pc_i
 
     // Outputs
     ,output [ 31:0]  next_pc_f_o
-    ,output [  1:0]  next_taken_f_o
+    ,output [  3:0]  next_taken_f_o
 );
 
 
 
 localparam RAS_INVALID = 32'h00000001;
+localparam BTB_INVALID = 32'h00000001;
 
 //-----------------------------------------------------------------
 // Branch prediction (BTB, BHT, RAS)
@@ -83,6 +88,12 @@ wire        btb_upper_w;
 wire [31:0] btb_next_pc_w;
 wire        btb_is_call_w;
 wire        btb_is_ret_w;
+wire [31:0] btb_key_w;
+
+// BTB entries are keyed on the last halfword of the branch (RVC), so a 32-bit
+// branch straddling two fetch blocks is predicted in the block it completes in.
+wire [31:0] branch_key_w = (SUPPORT_RVC && !branch_is_rvc_i) ? (branch_source_i + 32'd2) : branch_source_i;
+wire [31:0] branch_ret_w = branch_source_i + ((SUPPORT_RVC && branch_is_rvc_i) ? 32'd2 : 32'd4);
 
 //-----------------------------------------------------------------
 // Return Address Stack (actual)
@@ -148,13 +159,13 @@ end
 // On a call push return address onto RAS stack (current PC + 4)
 else if (branch_request_i & branch_is_call_i)
 begin
-    ras_stack_q[ras_index_r] <= branch_source_i + 32'd4;
+    ras_stack_q[ras_index_r] <= branch_ret_w;
     ras_index_q              <= ras_index_r;
 end
 // On a call push return address onto RAS stack (current PC + 4)
 else if (ras_call_pred_w & pc_accept_i)
 begin
-    ras_stack_q[ras_index_r] <= (btb_upper_w ? (pc_f_i | 32'd4) : pc_f_i) + 32'd4;
+    ras_stack_q[ras_index_r] <= btb_key_w + (SUPPORT_RVC ? 32'd2 : 32'd4);
     ras_index_q              <= ras_index_r;
 end
 // Return - pop item from stack
@@ -189,16 +200,19 @@ else if (branch_request_i)
 else if (pred_taken_w || pred_ntaken_w)
     global_history_q <= {global_history_q[NUM_BHT_ENTRIES_W-2:0], pred_taken_w};
 
-wire [NUM_BHT_ENTRIES_W-1:0] gshare_wr_entry_w = (branch_request_i ? global_history_real_q : global_history_q) ^ branch_source_i[2+NUM_BHT_ENTRIES_W-1:2];
-wire [NUM_BHT_ENTRIES_W-1:0] gshare_rd_entry_w = global_history_q ^ {pc_f_i[3+NUM_BHT_ENTRIES_W-2:3],btb_upper_w};
+wire [NUM_BHT_ENTRIES_W-1:0] bht_src_wr_w = SUPPORT_RVC ? branch_key_w[NUM_BHT_ENTRIES_W:1] : branch_source_i[2+NUM_BHT_ENTRIES_W-1:2];
+wire [NUM_BHT_ENTRIES_W-1:0] bht_src_rd_w = SUPPORT_RVC ? btb_key_w[NUM_BHT_ENTRIES_W:1]    : {pc_f_i[3+NUM_BHT_ENTRIES_W-2:3],btb_upper_w};
+
+wire [NUM_BHT_ENTRIES_W-1:0] gshare_wr_entry_w = (branch_request_i ? global_history_real_q : global_history_q) ^ bht_src_wr_w;
+wire [NUM_BHT_ENTRIES_W-1:0] gshare_rd_entry_w = global_history_q ^ bht_src_rd_w;
 
 //-----------------------------------------------------------------
 // Branch prediction bits
 //-----------------------------------------------------------------
 reg [1:0]                    bht_sat_q[NUM_BHT_ENTRIES-1:0];
 
-wire [NUM_BHT_ENTRIES_W-1:0] bht_wr_entry_w = GSHARE_ENABLE ? gshare_wr_entry_w : branch_source_i[2+NUM_BHT_ENTRIES_W-1:2];
-wire [NUM_BHT_ENTRIES_W-1:0] bht_rd_entry_w = GSHARE_ENABLE ? gshare_rd_entry_w : {pc_f_i[3+NUM_BHT_ENTRIES_W-2:3],btb_upper_w};
+wire [NUM_BHT_ENTRIES_W-1:0] bht_wr_entry_w = GSHARE_ENABLE ? gshare_wr_entry_w : bht_src_wr_w;
+wire [NUM_BHT_ENTRIES_W-1:0] bht_rd_entry_w = GSHARE_ENABLE ? gshare_rd_entry_w : bht_src_rd_w;
 
 integer i4;
 always @ (posedge clk_i or posedge rst_i)
@@ -231,6 +245,7 @@ reg         btb_is_call_r;
 reg         btb_is_ret_r;
 reg [31:0]  btb_next_pc_r;
 reg         btb_is_jmp_r;
+reg [31:0]  btb_key_r;
 
 reg [NUM_BTB_ENTRIES_W-1:0] btb_entry_r;
 integer i0;
@@ -243,11 +258,33 @@ begin
     btb_is_ret_r  = 1'b0;
     btb_is_jmp_r  = 1'b0;
     btb_next_pc_r = {pc_f_i[31:3],3'b0} + 32'd8;
+    btb_key_r     = pc_f_i;
     btb_entry_r   = {NUM_BTB_ENTRIES_W{1'b0}};
 
+    // RVC: first branch ending at or after the fetch PC within the 64-bit block
+    if (SUPPORT_RVC)
+        for (i0 = 0; i0 < NUM_BTB_ENTRIES; i0 = i0 + 1)
+        begin
+            if (btb_pc_q[i0][31:3] == pc_f_i[31:3] && !btb_pc_q[i0][0] &&
+                btb_pc_q[i0][2:1] >= pc_f_i[2:1] &&
+                (!btb_valid_r || btb_pc_q[i0][2:1] < btb_key_r[2:1]))
+            begin
+                btb_valid_r   = 1'b1;
+                btb_upper_r   = btb_pc_q[i0][2];
+                btb_is_call_r = btb_is_call_q[i0];
+                btb_is_ret_r  = btb_is_ret_q[i0];
+                btb_is_jmp_r  = btb_is_jmp_q[i0];
+                btb_next_pc_r = btb_target_q[i0];
+                btb_key_r     = btb_pc_q[i0];
+/* verilator lint_off WIDTH */
+                btb_entry_r   = i0;
+/* verilator lint_on WIDTH */
+            end
+        end
+
     for (i0 = 0; i0 < NUM_BTB_ENTRIES; i0 = i0 + 1)
     begin
-        if (btb_pc_q[i0] == pc_f_i)
+        if (!SUPPORT_RVC && btb_pc_q[i0] == pc_f_i)
         begin
             btb_valid_r   = 1'b1;
             btb_upper_r   = pc_f_i[2];
@@ -261,13 +298,14 @@ begin
         end
     end
 
-    if (~btb_valid_r && ~pc_f_i[2])
+    if (!SUPPORT_RVC && ~btb_valid_r && ~pc_f_i[2])
         for (i0 = 0; i0 < NUM_BTB_ENTRIES; i0 = i0 + 1)
         begin
             if (btb_pc_q[i0] == (pc_f_i | 32'd4))
             begin
                 btb_valid_r   = 1'b1;
                 btb_upper_r   = 1'b1;
+                btb_key_r     = pc_f_i | 32'd4;
                 btb_is_call_r = btb_is_call_q[i0];
                 btb_is_ret_r  = btb_is_ret_q[i0];
                 btb_is_jmp_r  = btb_is_jmp_q[i0];
@@ -296,7 +334,7 @@ begin
     begin
         for (i1 = 0; i1 < NUM_BTB_ENTRIES; i1 = i1 + 1)
         begin
-            if (btb_pc_q[i1] == branch_source_i)
+            if (btb_pc_q[i1] == branch_key_w)
             begin
                 btb_hit_r      = 1'b1;
     /* verilator lint_off WIDTH */
@@ -324,7 +362,7 @@ end
 // Hit - update entry
 else if (btb_hit_r)
 begin
-    btb_pc_q[btb_wr_entry_r]     <= branch_source_i;
+    btb_pc_q[btb_wr_entry_r]     <= branch_key_w;
     if (branch_is_taken_i)
         btb_target_q[btb_wr_entry_r] <= branch_pc_i;
     btb_is_call_q[btb_wr_entry_r]<= branch_is_call_i;
@@ -334,12 +372,19 @@ end
 // Miss - allocate entry
 else if (btb_miss_r)
 begin
-    btb_pc_q[btb_wr_alloc_w]     <= branch_source_i;
+    btb_pc_q[btb_wr_alloc_w]     <= branch_key_w;
     btb_target_q[btb_wr_alloc_w] <= branch_pc_i;
     btb_is_call_q[btb_wr_alloc_w]<= branch_is_call_i;
     btb_is_ret_q[btb_wr_alloc_w] <= branch_is_ret_i;
     btb_is_jmp_q[btb_wr_alloc_w] <= branch_is_jmp_i;
 end
+// Stale entry (prediction not on the end of an instruction) - drop it
+else if (btb_invalidate_i)
+begin
+    for (i2 = 0; i2 < NUM_BTB_ENTRIES; i2 = i2 + 1)
+        if (btb_pc_q[i2] == btb_invalidate_pc_i)
+            btb_pc_q[i2] <= BTB_INVALID;
+end
 
 //-----------------------------------------------------------------
 // Replacement Selection
@@ -368,13 +413,14 @@ assign btb_valid_w   = btb_valid_r;
 assign btb_upper_w   = btb_upper_r;
 assign btb_is_call_w = btb_is_call_r;
 assign btb_is_ret_w  = btb_is_ret_r;
+assign btb_key_w     = btb_key_r;
 assign next_pc_f_o   = ras_ret_pred_w      ? ras_pc_pred_w : 
                        (bht_predict_taken_w | btb_is_jmp_r) ? btb_next_pc_r :
                        {pc_f_i[31:3],3'b0} + 32'd8;
 
+// Taken flag per halfword - set on the last halfword of the predicted branch
 assign next_taken_f_o = (btb_valid_w & (ras_ret_pred_w | bht_predict_taken_w | btb_is_jmp_r)) ? 
-                        pc_f_i[2] ? {btb_upper_r, 1'b0} :
-                        {btb_upper_r, ~btb_upper_r} : 2'b0;
+                        (4'b0001 << (SUPPORT_RVC ? btb_key_w[2:1] : {btb_key_w[2], 1'b1})) : 4'b0;
 
 assign pred_taken_w   = btb_valid_w & (ras_ret_pred_w | bht_predict_taken_w | btb_is_jmp_r) & pc_accept_i;
 assign pred_ntaken_w  = btb_valid_w & ~pred_taken_w & pc_accept_i;
@@ -388,7 +434,7 @@ else
 begin: NO_BRANCH_PREDICTION
 
 assign next_pc_f_o    = {pc_f_i[31:3],3'b0} + 32'd8;
-assign next_taken_f_o = 2'b0;
+assign next_taken_f_o = 4'b0;
 
 end
 endgenerate
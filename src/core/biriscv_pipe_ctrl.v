@@ -29,6 +29,7 @@ module biriscv_pipe_ctrl
 #(
      parameter SUPPORT_LOAD_BYPASS = 1
     ,parameter SUPPORT_MUL_BYPASS  = 1
+    ,parameter SUPPORT_RVC         = 0
 )
 //-----------------------------------------------------------------
 // Ports
@@ -79,6 +80,7 @@ module biriscv_pipe_ctrl
 
     // Execution stage 2: Other results
     ,input           mem_complete_i
+    ,input           mem_release_i
     ,input [31:0]    mem_result_e2_i
     ,input  [5:0]    mem_exception_e2_i
     ,input [31:0]    mul_result_e2_i
@@ -119,7 +121,7 @@ module biriscv_pipe_ctrl
 `include "biriscv_defs.v"
 
 wire squash_e1_e2_w;
-wire branch_misaligned_w = (issue_branch_taken_i && issue_branch_target_i[1:0] != 2'b0);
+wire branch_misaligned_w = (issue_branch_taken_i && (SUPPORT_RVC ? issue_branch_target_i[0] : (issue_branch_target_i[1:0] != 2'b0)));
 
 //-------------------------------------------------------------
 // E1 / Address
@@ -312,8 +314,11 @@ assign mul_e2_o        = ctrl_e2_q[`PCINFO_MUL];
 assign rd_e2_o         = {5{(valid_e2_w && ctrl_e2_q[`PCINFO_RD_VALID] && ~stall_o)}} & opcode_e2_q[`RD_IDX_R];
 assign result_e2_o     = result_e2_r;
 
+// Load result not ready, but may be written back later (outside of the pipeline)
+wire   load_release_w  = mem_release_i & ctrl_e2_q[`PCINFO_LOAD] & ~mem_complete_i;
+
 // Load store result not ready when reaching E2
-assign stall_o         = (ctrl_e1_q[`PCINFO_DIV] && ~div_complete_i) || ((ctrl_e2_q[`PCINFO_LOAD] | ctrl_e2_q[`PCINFO_STORE]) & ~mem_complete_i);
+assign stall_o         = (ctrl_e1_q[`PCINFO_DIV] && ~div_complete_i) || ((ctrl_e2_q[`PCINFO_LOAD] | ctrl_e2_q[`PCINFO_STORE]) & ~mem_complete_i & ~load_release_w);
 
 reg [`EXCEPTION_W-1:0] exception_e2_r;
 always @ *
@@ -401,8 +406,8 @@ begin
     csr_wr_wb_q     <= csr_wr_e2_q;  // TODO: Fault disable???
     csr_wdata_wb_q  <= csr_wdata_e2_q;
 
-    // Exception - squash writeback
-    if (|exception_e2_r)
+    // Exception (or released load) - squash writeback
+    if ((|exception_e2_r) || load_release_w)
         ctrl_wb_q       <= ctrl_e2_q & ~(1 << `PCINFO_RD_VALID);
     else
         ctrl_wb_q       <= ctrl_e2_q;
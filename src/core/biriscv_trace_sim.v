@@ -168,6 +168,31 @@ begin
             ((opcode_i & `INST_REM_MASK) == `INST_REM)    : dbg_inst_str = "rem";
             ((opcode_i & `INST_REMU_MASK) == `INST_REMU)   : dbg_inst_str = "remu";
             ((opcode_i & `INST_IFENCE_MASK) == `INST_IFENCE)  : dbg_inst_str = "fence.i";
+            ((opcode_i & `INST_CBO_INVAL_MASK) == `INST_CBO_INVAL) : dbg_inst_str = "cbo.inval";
+            ((opcode_i & `INST_CBO_CLEAN_MASK) == `INST_CBO_CLEAN) : dbg_inst_str = "cbo.clean";
+            ((opcode_i & `INST_CBO_FLUSH_MASK) == `INST_CBO_FLUSH) : dbg_inst_str = "cbo.flush";
+            ((opcode_i & `INST_CBO_ZERO_MASK) == `INST_CBO_ZERO)   : dbg_inst_str = "cbo.zero";
+            ((opcode_i & `INST_SH1ADD_MASK) == `INST_SH1ADD)    : dbg_inst_str = "sh1add";
+            ((opcode_i & `INST_SH2ADD_MASK) == `INST_SH2ADD)    : dbg_inst_str = "sh2add";
+            ((opcode_i & `INST_SH3ADD_MASK) == `INST_SH3ADD)    : dbg_inst_str = "sh3add";
+            ((opcode_i & `INST_ANDN_MASK) == `INST_ANDN)        : dbg_inst_str = "andn";
+            ((opcode_i & `INST_ORN_MASK) == `INST_ORN)          : dbg_inst_str = "orn";
+            ((opcode_i & `INST_XNOR_MASK) == `INST_XNOR)        : dbg_inst_str = "xnor";
+            ((opcode_i & `INST_CLZ_MASK) == `INST_CLZ)          : dbg_inst_str = "clz";
+            ((opcode_i & `INST_CTZ_MASK) == `INST_CTZ)          : dbg_inst_str = "ctz";
+            ((opcode_i & `INST_CPOP_MASK) == `INST_CPOP)        : dbg_inst_str = "cpop";
+            ((opcode_i & `INST_MIN_MASK) == `INST_MIN)          : dbg_inst_str = "min";
+            ((opcode_i & `INST_MAX_MASK) == `INST_MAX)          : dbg_inst_str = "max";
+            ((opcode_i & `INST_MINU_MASK) == `INST_MINU)        : dbg_inst_str = "minu";
+            ((opcode_i & `INST_MAXU_MASK) == `INST_MAXU)        : dbg_inst_str = "maxu";
+            ((opcode_i & `INST_SEXT_B_MASK) == `INST_SEXT_B)    : dbg_inst_str = "sext.b";
+            ((opcode_i & `INST_SEXT_H_MASK) == `INST_SEXT_H)    : dbg_inst_str = "sext.h";
+            ((opcode_i & `INST_ZEXT_H_MASK) == `INST_ZEXT_H)    : dbg_inst_str = "zext.h";
+            ((opcode_i & `INST_ROL_MASK) == `INST_ROL)          : dbg_inst_str = "rol";
+            ((opcode_i & `INST_ROR_MASK) == `INST_ROR)          : dbg_inst_str = "ror";
+            ((opcode_i & `INST_RORI_MASK) == `INST_RORI)        : dbg_inst_str = "rori";
+            ((opcode_i & `INST_ORC_B_MASK) == `INST_ORC_B)      : dbg_inst_str = "orc.b";
+            ((opcode_i & `INST_REV8_MASK) == `INST_REV8)        : dbg_inst_str = "rev8";
         endcase
 
         case (1'b1)
@@ -191,12 +216,36 @@ begin
 
             ((opcode_i & `INST_SLLI_MASK) == `INST_SLLI) , // slli
             ((opcode_i & `INST_SRLI_MASK) == `INST_SRLI) , // srli
-            ((opcode_i & `INST_SRAI_MASK) == `INST_SRAI) : // srai
+            ((opcode_i & `INST_SRAI_MASK) == `INST_SRAI) , // srai
+            ((opcode_i & `INST_RORI_MASK) == `INST_RORI) : // rori
             begin
                 dbg_inst_rb  = "-";
                 dbg_inst_imm = {27'b0, `DBG_IMM_SHAMT};
             end
 
+            // clz ctz cpop sext.b sext.h zext.h orc.b rev8
+            ((opcode_i & `INST_CLZ_MASK) == `INST_CLZ) ,
+            ((opcode_i & `INST_CTZ_MASK) == `INST_CTZ) ,
+            ((opcode_i & `INST_CPOP_MASK) == `INST_CPOP) ,
+            ((opcode_i & `INST_SEXT_B_MASK) == `INST_SEXT_B) ,
+            ((opcode_i & `INST_SEXT_H_MASK) == `INST_SEXT_H) ,
+            ((opcode_i & `INST_ZEXT_H_MASK) == `INST_ZEXT_H) ,
+            ((opcode_i & `INST_ORC_B_MASK) == `INST_ORC_B) ,
+            ((opcode_i & `INST_REV8_MASK) == `INST_REV8) :
+            begin
+                dbg_inst_rb  = "-";
+            end
+
+            // cbo.inval cbo.clean cbo.flush cbo.zero
+            ((opcode_i & `INST_CBO_INVAL_MASK) == `INST_CBO_INVAL) ,
+            ((opcode_i & `INST_CBO_CLEAN_MASK) == `INST_CBO_CLEAN) ,
+            ((opcode_i & `INST_CBO_FLUSH_MASK) == `INST_CBO_FLUSH) ,
+            ((opcode_i & `INST_CBO_ZERO_MASK) == `INST_CBO_ZERO) :
+            begin
+                dbg_inst_rd  = "-";
+                dbg_inst_rb  = "-";
+            end
+
             ((opcode_i & `INST_LUI_MASK) == `INST_LUI) : // lui
             begin
                 dbg_inst_ra  = "-";
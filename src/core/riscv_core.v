@@ -48,6 +48,24 @@ module riscv_core
     ,parameter BHT_ENABLE       = 1
     ,parameter NUM_RAS_ENTRIES  = 8
     ,parameter NUM_RAS_ENTRIES_W = 3
+    ,parameter DIV_BITS_PER_CYCLE = 1
+    ,parameter DIV_EARLY_OUT    = 0
+    ,parameter SUPPORT_RVC      = 0
+    ,parameter SUPPORT_BITMANIP = 0
+    ,parameter SUPPORT_FUSION   = 0
+    ,parameter SUPPORT_NONBLOCKING_LOAD = 0
+    ,parameter SUPPORT_DUAL_LSU = 0
+    ,parameter SUPPORT_STORE_FWD = 0
+    ,parameter SUPPORT_CLIC     = 0
+    ,parameter CBO_ZERO_ALLOC   = 0
+    ,parameter CBO_BLOCK_SIZE   = 32
+    ,parameter CBO_BLOCK_SIZE_W = 5
+    ,parameter ITLB_ENTRIES     = 8
+    ,parameter ITLB_ENTRIES_W   = 3
+    ,parameter DTLB_ENTRIES     = 8
+    ,parameter DTLB_ENTRIES_W   = 3
+    ,parameter PTW_CACHE_ENTRIES   = 4
+    ,parameter PTW_CACHE_ENTRIES_W = 2
 )
 //-----------------------------------------------------------------
 // Ports
@@ -61,11 +79,17 @@ module riscv_core
     ,input           mem_d_ack_i
     ,input           mem_d_error_i
     ,input  [ 10:0]  mem_d_resp_tag_i
+    ,input           mem_d_store_error_i
+    ,input  [ 31:0]  mem_d_store_error_addr_i
+    ,input           mem_d_store_empty_i
+    ,input           mem_d_fill_error_i
+    ,input  [ 31:0]  mem_d_fill_error_addr_i
     ,input           mem_i_accept_i
     ,input           mem_i_valid_i
     ,input           mem_i_error_i
     ,input  [ 63:0]  mem_i_inst_i
-    ,input           intr_i
+    ,input  [ 31:0]  intr_i
+    ,input           timer_intr_i
     ,input  [ 31:0]  reset_vector_i
     ,input  [ 31:0]  cpu_id_i
 
@@ -79,6 +103,7 @@ module riscv_core
     ,output          mem_d_invalidate_o
     ,output          mem_d_writeback_o
     ,output          mem_d_flush_o
+    ,output [ 31:0]  mem_d_pc_o
     ,output          mem_i_rd_o
     ,output          mem_i_flush_o
     ,output          mem_i_invalidate_o
@@ -93,6 +118,7 @@ wire           branch_d_exec1_request_w;
 wire           mmu_flush_w;
 wire  [ 31:0]  lsu_opcode_pc_w;
 wire  [ 31:0]  branch_exec0_source_w;
+wire           branch_exec0_is_rvc_w;
 wire  [  1:0]  fetch_in_priv_w;
 wire  [ 31:0]  csr_opcode_rb_operand_w;
 wire  [ 31:0]  writeback_mem_value_w;
@@ -106,6 +132,8 @@ wire           branch_exec0_is_call_w;
 wire           mul_opcode_valid_w;
 wire           branch_exec0_request_w;
 wire           mmu_mxr_w;
+wire  [  2:0]  cbo_enable_w;
+wire           cbo_inval_flush_w;
 wire  [ 31:0]  branch_exec0_pc_w;
 wire  [ 31:0]  opcode0_pc_w;
 wire  [ 31:0]  opcode0_ra_operand_w;
@@ -121,6 +149,7 @@ wire  [ 31:0]  opcode0_rb_operand_w;
 wire  [ 31:0]  fetch1_instr_w;
 wire  [ 31:0]  csr_writeback_exception_addr_w;
 wire           fetch1_instr_invalid_w;
+wire           fetch1_instr_rvc_w;
 wire  [  3:0]  mmu_lsu_wr_w;
 wire           fetch_in_fault_w;
 wire           fetch0_instr_rd_valid_w;
@@ -138,12 +167,24 @@ wire  [ 10:0]  mmu_lsu_resp_tag_w;
 wire  [ 10:0]  mmu_lsu_req_tag_w;
 wire           fetch1_instr_div_w;
 wire  [ 31:0]  branch_exec1_source_w;
+wire           branch_exec1_is_rvc_w;
 wire  [ 31:0]  mul_opcode_opcode_w;
 wire  [ 31:0]  branch_d_exec0_pc_w;
 wire  [ 31:0]  branch_pc_w;
 wire  [  4:0]  mul_opcode_ra_idx_w;
 wire  [  4:0]  csr_opcode_rb_idx_w;
 wire           lsu_stall_w;
+wire           lsu_release_w;
+wire           lsu_store_valid_w;
+wire  [ 31:0]  lsu_store_opcode_w;
+wire  [ 31:0]  lsu_store_ra_operand_w;
+wire  [ 31:0]  lsu_store_rb_operand_w;
+wire           lsu_store_commit_w;
+wire  [  1:0]  lsu_store_kill_w;
+wire           lsu_store_accept_w;
+wire           lsu_store_empty_w;
+wire           lsu_store_error_w;
+wire  [ 31:0]  lsu_store_error_addr_w;
 wire  [ 31:0]  opcode1_pc_w;
 wire           branch_info_is_not_taken_w;
 wire  [ 31:0]  branch_csr_pc_w;
@@ -215,9 +256,11 @@ wire  [ 31:0]  csr_writeback_wdata_w;
 wire           fetch1_accept_w;
 wire           csr_writeback_write_w;
 wire           take_interrupt_w;
+wire           irq_pending_w;
 wire  [ 31:0]  csr_result_e1_value_w;
 wire  [  4:0]  opcode1_rb_idx_w;
 wire           fetch0_instr_invalid_w;
+wire           fetch0_instr_rvc_w;
 wire  [ 11:0]  csr_writeback_waddr_w;
 wire           fetch1_fault_fetch_w;
 wire           fetch1_valid_w;
@@ -225,9 +268,11 @@ wire  [ 31:0]  fetch0_instr_w;
 wire           mmu_lsu_cacheable_w;
 wire           branch_d_exec0_request_w;
 wire           opcode1_invalid_w;
+wire           opcode1_rvc_w;
 wire           exec0_hold_w;
 wire  [  4:0]  opcode0_rb_idx_w;
 wire           opcode0_invalid_w;
+wire           opcode0_rvc_w;
 wire           lsu_opcode_valid_w;
 wire           branch_info_request_w;
 wire  [  1:0]  mmu_priv_d_w;
@@ -244,6 +289,7 @@ wire           fetch1_instr_rd_valid_w;
 wire  [ 31:0]  lsu_opcode_rb_operand_w;
 wire           mmu_sum_w;
 wire  [ 31:0]  branch_info_source_w;
+wire           branch_info_is_rvc_w;
 wire           branch_info_is_call_w;
 wire  [  4:0]  opcode0_rd_idx_w;
 wire  [ 31:0]  branch_d_exec1_pc_w;
@@ -268,6 +314,8 @@ biriscv_frontend
     ,.NUM_BHT_ENTRIES(NUM_BHT_ENTRIES)
     ,.RAS_ENABLE(RAS_ENABLE)
     ,.NUM_RAS_ENTRIES(NUM_RAS_ENTRIES)
+    ,.SUPPORT_RVC(SUPPORT_RVC)
+    ,.SUPPORT_BITMANIP(SUPPORT_BITMANIP)
 )
 u_frontend
 (
@@ -289,10 +337,12 @@ u_frontend
     ,.branch_info_is_taken_i(branch_info_is_taken_w)
     ,.branch_info_is_not_taken_i(branch_info_is_not_taken_w)
     ,.branch_info_source_i(branch_info_source_w)
+    ,.branch_info_is_rvc_i(branch_info_is_rvc_w)
     ,.branch_info_is_call_i(branch_info_is_call_w)
     ,.branch_info_is_ret_i(branch_info_is_ret_w)
     ,.branch_info_is_jmp_i(branch_info_is_jmp_w)
     ,.branch_info_pc_i(branch_info_pc_w)
+    ,.cbo_enable_i(cbo_enable_w)
 
     // Outputs
     ,.icache_rd_o(mmu_ifetch_rd_w)
@@ -313,6 +363,7 @@ u_frontend
     ,.fetch0_instr_csr_o(fetch0_instr_csr_w)
     ,.fetch0_instr_rd_valid_o(fetch0_instr_rd_valid_w)
     ,.fetch0_instr_invalid_o(fetch0_instr_invalid_w)
+    ,.fetch0_instr_rvc_o(fetch0_instr_rvc_w)
     ,.fetch1_valid_o(fetch1_valid_w)
     ,.fetch1_instr_o(fetch1_instr_w)
     ,.fetch1_pc_o(fetch1_pc_w)
@@ -326,6 +377,7 @@ u_frontend
     ,.fetch1_instr_csr_o(fetch1_instr_csr_w)
     ,.fetch1_instr_rd_valid_o(fetch1_instr_rd_valid_w)
     ,.fetch1_instr_invalid_o(fetch1_instr_invalid_w)
+    ,.fetch1_instr_rvc_o(fetch1_instr_rvc_w)
 );
 
 
@@ -334,6 +386,12 @@ biriscv_mmu
      .MEM_CACHE_ADDR_MAX(MEM_CACHE_ADDR_MAX)
     ,.SUPPORT_MMU(SUPPORT_MMU)
     ,.MEM_CACHE_ADDR_MIN(MEM_CACHE_ADDR_MIN)
+    ,.ITLB_ENTRIES(ITLB_ENTRIES)
+    ,.ITLB_ENTRIES_W(ITLB_ENTRIES_W)
+    ,.DTLB_ENTRIES(DTLB_ENTRIES)
+    ,.DTLB_ENTRIES_W(DTLB_ENTRIES_W)
+    ,.PTW_CACHE_ENTRIES(PTW_CACHE_ENTRIES)
+    ,.PTW_CACHE_ENTRIES_W(PTW_CACHE_ENTRIES_W)
 )
 u_mmu
 (
@@ -402,6 +460,12 @@ biriscv_lsu
 #(
      .MEM_CACHE_ADDR_MAX(MEM_CACHE_ADDR_MAX)
     ,.MEM_CACHE_ADDR_MIN(MEM_CACHE_ADDR_MIN)
+    ,.SUPPORT_NONBLOCKING_LOAD(SUPPORT_NONBLOCKING_LOAD)
+    ,.SUPPORT_DUAL_LSU(SUPPORT_DUAL_LSU && !SUPPORT_MMU)
+    ,.SUPPORT_STORE_FWD(SUPPORT_STORE_FWD && !SUPPORT_MMU)
+    ,.CBO_ZERO_ALLOC(CBO_ZERO_ALLOC)
+    ,.CBO_BLOCK_SIZE(CBO_BLOCK_SIZE)
+    ,.CBO_BLOCK_SIZE_W(CBO_BLOCK_SIZE_W)
 )
 u_lsu
 (
@@ -424,6 +488,13 @@ u_lsu
     ,.mem_resp_tag_i(mmu_lsu_resp_tag_w)
     ,.mem_load_fault_i(mmu_load_fault_w)
     ,.mem_store_fault_i(mmu_store_fault_w)
+    ,.store_valid_i(lsu_store_valid_w)
+    ,.store_opcode_i(lsu_store_opcode_w)
+    ,.store_ra_operand_i(lsu_store_ra_operand_w)
+    ,.store_rb_operand_i(lsu_store_rb_operand_w)
+    ,.store_commit_i(lsu_store_commit_w)
+    ,.store_kill_i(lsu_store_kill_w)
+    ,.cbo_inval_flush_i(cbo_inval_flush_w)
 
     // Outputs
     ,.mem_addr_o(mmu_lsu_addr_w)
@@ -435,10 +506,16 @@ u_lsu
     ,.mem_invalidate_o(mmu_lsu_invalidate_w)
     ,.mem_writeback_o(mmu_lsu_writeback_w)
     ,.mem_flush_o(mmu_lsu_flush_w)
+    ,.mem_pc_o(mem_d_pc_o)
     ,.writeback_valid_o(writeback_mem_valid_w)
     ,.writeback_value_o(writeback_mem_value_w)
     ,.writeback_exception_o(writeback_mem_exception_w)
     ,.stall_o(lsu_stall_w)
+    ,.load_release_o(lsu_release_w)
+    ,.store_accept_o(lsu_store_accept_w)
+    ,.store_empty_o(lsu_store_empty_w)
+    ,.store_error_o(lsu_store_error_w)
+    ,.store_error_addr_o(lsu_store_error_addr_w)
 );
 
 
@@ -446,6 +523,8 @@ biriscv_csr
 #(
      .SUPPORT_SUPER(SUPPORT_SUPER)
     ,.SUPPORT_MULDIV(SUPPORT_MULDIV)
+    ,.SUPPORT_RVC(SUPPORT_RVC)
+    ,.SUPPORT_CLIC(SUPPORT_CLIC)
 )
 u_csr
 (
@@ -453,6 +532,7 @@ u_csr
      .clk_i(clk_i)
     ,.rst_i(rst_i)
     ,.intr_i(intr_i)
+    ,.timer_intr_i(timer_intr_i)
     ,.opcode_valid_i(csr_opcode_valid_w)
     ,.opcode_opcode_i(csr_opcode_opcode_w)
     ,.opcode_pc_i(csr_opcode_pc_w)
@@ -481,12 +561,15 @@ u_csr
     ,.branch_csr_pc_o(branch_csr_pc_w)
     ,.branch_csr_priv_o(branch_csr_priv_w)
     ,.take_interrupt_o(take_interrupt_w)
+    ,.irq_pending_o(irq_pending_w)
     ,.ifence_o(ifence_w)
     ,.mmu_priv_d_o(mmu_priv_d_w)
     ,.mmu_sum_o(mmu_sum_w)
     ,.mmu_mxr_o(mmu_mxr_w)
     ,.mmu_flush_o(mmu_flush_w)
     ,.mmu_satp_o(mmu_satp_w)
+    ,.cbo_enable_o(cbo_enable_w)
+    ,.cbo_inval_flush_o(cbo_inval_flush_w)
 );
 
 
@@ -513,6 +596,10 @@ u_mul
 
 
 biriscv_divider
+#(
+     .DIV_BITS_PER_CYCLE(DIV_BITS_PER_CYCLE)
+    ,.DIV_EARLY_OUT(DIV_EARLY_OUT)
+)
 u_div
 (
     // Inputs
@@ -541,6 +628,13 @@ biriscv_issue
     ,.SUPPORT_MULDIV(SUPPORT_MULDIV)
     ,.SUPPORT_MUL_BYPASS(SUPPORT_MUL_BYPASS)
     ,.SUPPORT_DUAL_ISSUE(SUPPORT_DUAL_ISSUE)
+    ,.SUPPORT_RVC(SUPPORT_RVC)
+    ,.SUPPORT_FUSION(SUPPORT_FUSION)
+    ,.SUPPORT_NONBLOCKING_LOAD(SUPPORT_NONBLOCKING_LOAD)
+    ,.SUPPORT_DUAL_LSU(SUPPORT_DUAL_LSU && !SUPPORT_MMU)
+    ,.SUPPORT_STORE_FWD(SUPPORT_STORE_FWD && !SUPPORT_MMU)
+    ,.MEM_CACHE_ADDR_MIN(MEM_CACHE_ADDR_MIN)
+    ,.MEM_CACHE_ADDR_MAX(MEM_CACHE_ADDR_MAX)
 )
 u_issue
 (
@@ -560,6 +654,7 @@ u_issue
     ,.fetch0_instr_csr_i(fetch0_instr_csr_w)
     ,.fetch0_instr_rd_valid_i(fetch0_instr_rd_valid_w)
     ,.fetch0_instr_invalid_i(fetch0_instr_invalid_w)
+    ,.fetch0_instr_rvc_i(fetch0_instr_rvc_w)
     ,.fetch1_valid_i(fetch1_valid_w)
     ,.fetch1_instr_i(fetch1_instr_w)
     ,.fetch1_pc_i(fetch1_pc_w)
@@ -573,10 +668,12 @@ u_issue
     ,.fetch1_instr_csr_i(fetch1_instr_csr_w)
     ,.fetch1_instr_rd_valid_i(fetch1_instr_rd_valid_w)
     ,.fetch1_instr_invalid_i(fetch1_instr_invalid_w)
+    ,.fetch1_instr_rvc_i(fetch1_instr_rvc_w)
     ,.branch_exec0_request_i(branch_exec0_request_w)
     ,.branch_exec0_is_taken_i(branch_exec0_is_taken_w)
     ,.branch_exec0_is_not_taken_i(branch_exec0_is_not_taken_w)
     ,.branch_exec0_source_i(branch_exec0_source_w)
+    ,.branch_exec0_is_rvc_i(branch_exec0_is_rvc_w)
     ,.branch_exec0_is_call_i(branch_exec0_is_call_w)
     ,.branch_exec0_is_ret_i(branch_exec0_is_ret_w)
     ,.branch_exec0_is_jmp_i(branch_exec0_is_jmp_w)
@@ -588,6 +685,7 @@ u_issue
     ,.branch_exec1_is_taken_i(branch_exec1_is_taken_w)
     ,.branch_exec1_is_not_taken_i(branch_exec1_is_not_taken_w)
     ,.branch_exec1_source_i(branch_exec1_source_w)
+    ,.branch_exec1_is_rvc_i(branch_exec1_is_rvc_w)
     ,.branch_exec1_is_call_i(branch_exec1_is_call_w)
     ,.branch_exec1_is_ret_i(branch_exec1_is_ret_w)
     ,.branch_exec1_is_jmp_i(branch_exec1_is_jmp_w)
@@ -611,7 +709,18 @@ u_issue
     ,.csr_result_e1_wdata_i(csr_result_e1_wdata_w)
     ,.csr_result_e1_exception_i(csr_result_e1_exception_w)
     ,.lsu_stall_i(lsu_stall_w)
+    ,.lsu_release_i(lsu_release_w)
+    ,.lsu_store_accept_i(lsu_store_accept_w)
+    ,.lsu_store_empty_i(lsu_store_empty_w)
+    ,.mem_store_empty_i(mem_d_store_empty_i)
+    ,.lsu_store_error_i(lsu_store_error_w)
+    ,.lsu_store_error_addr_i(lsu_store_error_addr_w)
+    ,.mem_store_error_i(mem_d_store_error_i)
+    ,.mem_store_error_addr_i(mem_d_store_error_addr_i)
+    ,.mem_fill_error_i(mem_d_fill_error_i)
+    ,.mem_fill_error_addr_i(mem_d_fill_error_addr_i)
     ,.take_interrupt_i(take_interrupt_w)
+    ,.irq_pending_i(irq_pending_w)
 
     // Outputs
     ,.fetch0_accept_o(fetch0_accept_w)
@@ -623,6 +732,7 @@ u_issue
     ,.branch_info_is_taken_o(branch_info_is_taken_w)
     ,.branch_info_is_not_taken_o(branch_info_is_not_taken_w)
     ,.branch_info_source_o(branch_info_source_w)
+    ,.branch_info_is_rvc_o(branch_info_is_rvc_w)
     ,.branch_info_is_call_o(branch_info_is_call_w)
     ,.branch_info_is_ret_o(branch_info_is_ret_w)
     ,.branch_info_is_jmp_o(branch_info_is_jmp_w)
@@ -636,6 +746,7 @@ u_issue
     ,.opcode0_opcode_o(opcode0_opcode_w)
     ,.opcode0_pc_o(opcode0_pc_w)
     ,.opcode0_invalid_o(opcode0_invalid_w)
+    ,.opcode0_rvc_o(opcode0_rvc_w)
     ,.opcode0_rd_idx_o(opcode0_rd_idx_w)
     ,.opcode0_ra_idx_o(opcode0_ra_idx_w)
     ,.opcode0_rb_idx_o(opcode0_rb_idx_w)
@@ -644,6 +755,7 @@ u_issue
     ,.opcode1_opcode_o(opcode1_opcode_w)
     ,.opcode1_pc_o(opcode1_pc_w)
     ,.opcode1_invalid_o(opcode1_invalid_w)
+    ,.opcode1_rvc_o(opcode1_rvc_w)
     ,.opcode1_rd_idx_o(opcode1_rd_idx_w)
     ,.opcode1_ra_idx_o(opcode1_ra_idx_w)
     ,.opcode1_rb_idx_o(opcode1_rb_idx_w)
@@ -657,6 +769,12 @@ u_issue
     ,.lsu_opcode_rb_idx_o(lsu_opcode_rb_idx_w)
     ,.lsu_opcode_ra_operand_o(lsu_opcode_ra_operand_w)
     ,.lsu_opcode_rb_operand_o(lsu_opcode_rb_operand_w)
+    ,.lsu_store_valid_o(lsu_store_valid_w)
+    ,.lsu_store_opcode_o(lsu_store_opcode_w)
+    ,.lsu_store_ra_operand_o(lsu_store_ra_operand_w)
+    ,.lsu_store_rb_operand_o(lsu_store_rb_operand_w)
+    ,.lsu_store_commit_o(lsu_store_commit_w)
+    ,.lsu_store_kill_o(lsu_store_kill_w)
     ,.mul_opcode_opcode_o(mul_opcode_opcode_w)
     ,.mul_opcode_pc_o(mul_opcode_pc_w)
     ,.mul_opcode_invalid_o(mul_opcode_invalid_w)
@@ -687,6 +805,9 @@ u_issue
 
 
 biriscv_exec
+#(
+     .SUPPORT_BITMANIP(SUPPORT_BITMANIP)
+)
 u_exec0
 (
     // Inputs
@@ -696,6 +817,7 @@ u_exec0
     ,.opcode_opcode_i(opcode0_opcode_w)
     ,.opcode_pc_i(opcode0_pc_w)
     ,.opcode_invalid_i(opcode0_invalid_w)
+    ,.opcode_rvc_i(opcode0_rvc_w)
     ,.opcode_rd_idx_i(opcode0_rd_idx_w)
     ,.opcode_ra_idx_i(opcode0_ra_idx_w)
     ,.opcode_rb_idx_i(opcode0_rb_idx_w)
@@ -708,6 +830,7 @@ u_exec0
     ,.branch_is_taken_o(branch_exec0_is_taken_w)
     ,.branch_is_not_taken_o(branch_exec0_is_not_taken_w)
     ,.branch_source_o(branch_exec0_source_w)
+    ,.branch_is_rvc_o(branch_exec0_is_rvc_w)
     ,.branch_is_call_o(branch_exec0_is_call_w)
     ,.branch_is_ret_o(branch_exec0_is_ret_w)
     ,.branch_is_jmp_o(branch_exec0_is_jmp_w)
@@ -720,6 +843,9 @@ u_exec0
 
 
 biriscv_exec
+#(
+     .SUPPORT_BITMANIP(SUPPORT_BITMANIP)
+)
 u_exec1
 (
     // Inputs
@@ -729,6 +855,7 @@ u_exec1
     ,.opcode_opcode_i(opcode1_opcode_w)
     ,.opcode_pc_i(opcode1_pc_w)
     ,.opcode_invalid_i(opcode1_invalid_w)
+    ,.opcode_rvc_i(opcode1_rvc_w)
     ,.opcode_rd_idx_i(opcode1_rd_idx_w)
     ,.opcode_ra_idx_i(opcode1_ra_idx_w)
     ,.opcode_rb_idx_i(opcode1_rb_idx_w)
@@ -741,6 +868,7 @@ u_exec1
     ,.branch_is_taken_o(branch_exec1_is_taken_w)
     ,.branch_is_not_taken_o(branch_exec1_is_not_taken_w)
     ,.branch_source_o(branch_exec1_source_w)
+    ,.branch_is_rvc_o(branch_exec1_is_rvc_w)
     ,.branch_is_call_o(branch_exec1_is_call_w)
     ,.branch_is_ret_o(branch_exec1_is_ret_w)
     ,.branch_is_jmp_o(branch_exec1_is_jmp_w)
@@ -29,6 +29,23 @@ module dcache
 //-----------------------------------------------------------------
 #(
      parameter AXI_ID           = 0
+    ,parameter DCACHE_NUM_WAYS  = 2
+    ,parameter DCACHE_NUM_WAYS_W = 1
+    ,parameter DCACHE_NUM_LINES = 256
+    ,parameter DCACHE_NUM_LINES_W = 8
+    ,parameter DCACHE_LINE_SIZE = 32
+    ,parameter DCACHE_LINE_SIZE_W = 5
+    ,parameter DCACHE_PLRU_ENABLE = 0
+    ,parameter DCACHE_NON_BLOCKING = 0
+    ,parameter DCACHE_NUM_MSHR  = 2
+    ,parameter DCACHE_NUM_MSHR_W = 1
+    ,parameter DCACHE_STORE_BUF = 0
+    ,parameter DCACHE_STORE_BUF_ENTRIES = 4
+    ,parameter DCACHE_STORE_BUF_ENTRIES_W = 2
+    ,parameter DCACHE_PREFETCH  = 0
+    ,parameter DCACHE_PREFETCH_ENTRIES = 8
+    ,parameter DCACHE_PREFETCH_ENTRIES_W = 3
+    ,parameter AXI_DATA_W       = 32
 )
 //-----------------------------------------------------------------
 // Ports
@@ -46,6 +63,7 @@ module dcache
     ,input           mem_invalidate_i
     ,input           mem_writeback_i
     ,input           mem_flush_i
+    ,input  [ 31:0]  mem_pc_i
     ,input           axi_awready_i
     ,input           axi_wready_i
     ,input           axi_bvalid_i
@@ -53,7 +71,7 @@ module dcache
     ,input  [  3:0]  axi_bid_i
     ,input           axi_arready_i
     ,input           axi_rvalid_i
-    ,input  [ 31:0]  axi_rdata_i
+    ,input  [AXI_DATA_W-1:0] axi_rdata_i
     ,input  [  1:0]  axi_rresp_i
     ,input  [  3:0]  axi_rid_i
     ,input           axi_rlast_i
@@ -64,14 +82,19 @@ module dcache
     ,output          mem_ack_o
     ,output          mem_error_o
     ,output [ 10:0]  mem_resp_tag_o
+    ,output          mem_store_error_o
+    ,output [ 31:0]  mem_store_error_addr_o
+    ,output          mem_store_empty_o
+    ,output          mem_fill_error_o
+    ,output [ 31:0]  mem_fill_error_addr_o
     ,output          axi_awvalid_o
     ,output [ 31:0]  axi_awaddr_o
     ,output [  3:0]  axi_awid_o
     ,output [  7:0]  axi_awlen_o
     ,output [  1:0]  axi_awburst_o
     ,output          axi_wvalid_o
-    ,output [ 31:0]  axi_wdata_o
-    ,output [  3:0]  axi_wstrb_o
+    ,output [AXI_DATA_W-1:0] axi_wdata_o
+    ,output [(AXI_DATA_W/8)-1:0] axi_wstrb_o
     ,output          axi_wlast_o
     ,output          axi_bready_o
     ,output          axi_arvalid_o
@@ -138,7 +161,106 @@ wire           pmem_uncached_rd_w;
 wire  [ 31:0]  pmem_read_data_w;
 wire           mem_cached_ack_w;
 wire           mem_cached_writeback_w;
+wire           mem_cached_busy_w;
+wire  [  3:0]  pmem_cache_id_w;
+wire  [  3:0]  pmem_cache_resp_id_w;
+wire  [  3:0]  pmem_id_w;
+wire  [  3:0]  pmem_resp_id_w;
+wire  [ 31:0]  mem_sb_addr_w;
+wire  [ 31:0]  mem_sb_data_wr_w;
+wire           mem_sb_rd_w;
+wire  [  3:0]  mem_sb_wr_w;
+wire           mem_sb_cacheable_w;
+wire  [ 10:0]  mem_sb_req_tag_w;
+wire           mem_sb_invalidate_w;
+wire           mem_sb_writeback_w;
+wire           mem_sb_flush_w;
+wire  [ 31:0]  mem_sb_data_rd_w;
+wire           mem_sb_accept_w;
+wire           mem_sb_ack_w;
+wire           mem_sb_error_w;
+wire  [ 10:0]  mem_sb_resp_tag_w;
+wire           store_buf_empty_w;
+wire           uncached_idle_w;
 
+//-----------------------------------------------------------------
+// Optional store buffer (posted / merged stores)
+//-----------------------------------------------------------------
+generate
+if (DCACHE_STORE_BUF)
+begin: STORE_BUF
+    dcache_store_buf
+    #(
+         .NUM_ENTRIES(DCACHE_STORE_BUF_ENTRIES)
+        ,.NUM_ENTRIES_W(DCACHE_STORE_BUF_ENTRIES_W)
+    )
+    u_store_buf
+    (
+        // Inputs
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.mem_addr_i(mem_addr_i)
+        ,.mem_data_wr_i(mem_data_wr_i)
+        ,.mem_rd_i(mem_rd_i)
+        ,.mem_wr_i(mem_wr_i)
+        ,.mem_cacheable_i(mem_cacheable_i)
+        ,.mem_req_tag_i(mem_req_tag_i)
+        ,.mem_invalidate_i(mem_invalidate_i)
+        ,.mem_writeback_i(mem_writeback_i)
+        ,.mem_flush_i(mem_flush_i)
+        ,.outport_data_rd_i(mem_sb_data_rd_w)
+        ,.outport_accept_i(mem_sb_accept_w)
+        ,.outport_ack_i(mem_sb_ack_w)
+        ,.outport_error_i(mem_sb_error_w)
+        ,.outport_resp_tag_i(mem_sb_resp_tag_w)
+
+        // Outputs
+        ,.mem_data_rd_o(mem_data_rd_o)
+        ,.mem_accept_o(mem_accept_o)
+        ,.mem_ack_o(mem_ack_o)
+        ,.mem_error_o(mem_error_o)
+        ,.mem_resp_tag_o(mem_resp_tag_o)
+        ,.outport_addr_o(mem_sb_addr_w)
+        ,.outport_data_wr_o(mem_sb_data_wr_w)
+        ,.outport_rd_o(mem_sb_rd_w)
+        ,.outport_wr_o(mem_sb_wr_w)
+        ,.outport_cacheable_o(mem_sb_cacheable_w)
+        ,.outport_req_tag_o(mem_sb_req_tag_w)
+        ,.outport_invalidate_o(mem_sb_invalidate_w)
+        ,.outport_writeback_o(mem_sb_writeback_w)
+        ,.outport_flush_o(mem_sb_flush_w)
+        ,.store_error_o(mem_store_error_o)
+        ,.store_error_addr_o(mem_store_error_addr_o)
+        ,.empty_o(store_buf_empty_w)
+    );
+end
+else
+begin: NO_STORE_BUF
+    assign mem_sb_addr_w       = mem_addr_i;
+    assign mem_sb_data_wr_w    = mem_data_wr_i;
+    assign mem_sb_rd_w         = mem_rd_i;
+    assign mem_sb_wr_w         = mem_wr_i;
+    assign mem_sb_cacheable_w  = mem_cacheable_i;
+    assign mem_sb_req_tag_w    = mem_req_tag_i;
+    assign mem_sb_invalidate_w = mem_invalidate_i;
+    assign mem_sb_writeback_w  = mem_writeback_i;
+    assign mem_sb_flush_w      = mem_flush_i;
+
+    assign mem_data_rd_o       = mem_sb_data_rd_w;
+    assign mem_accept_o        = mem_sb_accept_w;
+    assign mem_ack_o           = mem_sb_ack_w;
+    assign mem_error_o         = mem_sb_error_w;
+    assign mem_resp_tag_o      = mem_sb_resp_tag_w;
+
+    assign mem_store_error_o      = 1'b0;
+    assign mem_store_error_addr_o = 32'b0;
+    assign store_buf_empty_w      = 1'b1;
+end
+endgenerate
+
+// No posted store outstanding, and no line fill which may still fail
+// after its store has been acknowledged (see mem_fill_error_o)
+assign mem_store_empty_o = store_buf_empty_w & ~mem_cached_busy_w;
 
 dcache_if_pmem
 u_uncached
@@ -184,17 +306,20 @@ u_pmem_mux
     ,.outport_ack_i(pmem_ack_w)
     ,.outport_error_i(pmem_error_w)
     ,.outport_read_data_i(pmem_read_data_w)
+    ,.outport_resp_id_i(pmem_resp_id_w)
     ,.select_i(pmem_select_w)
     ,.inport0_wr_i(pmem_uncached_wr_w)
     ,.inport0_rd_i(pmem_uncached_rd_w)
     ,.inport0_len_i(pmem_uncached_len_w)
     ,.inport0_addr_i(pmem_uncached_addr_w)
     ,.inport0_write_data_i(pmem_uncached_write_data_w)
+    ,.inport0_id_i(4'b0)
     ,.inport1_wr_i(pmem_cache_wr_w)
     ,.inport1_rd_i(pmem_cache_rd_w)
     ,.inport1_len_i(pmem_cache_len_w)
     ,.inport1_addr_i(pmem_cache_addr_w)
     ,.inport1_write_data_i(pmem_cache_write_data_w)
+    ,.inport1_id_i(pmem_cache_id_w)
 
     // Outputs
     ,.outport_wr_o(pmem_wr_w)
@@ -202,14 +327,17 @@ u_pmem_mux
     ,.outport_len_o(pmem_len_w)
     ,.outport_addr_o(pmem_addr_w)
     ,.outport_write_data_o(pmem_write_data_w)
+    ,.outport_id_o(pmem_id_w)
     ,.inport0_accept_o(pmem_uncached_accept_w)
     ,.inport0_ack_o(pmem_uncached_ack_w)
     ,.inport0_error_o(pmem_uncached_error_w)
     ,.inport0_read_data_o(pmem_uncached_read_data_w)
+    ,.inport0_resp_id_o()
     ,.inport1_accept_o(pmem_cache_accept_w)
     ,.inport1_ack_o(pmem_cache_ack_w)
     ,.inport1_error_o(pmem_cache_error_w)
     ,.inport1_read_data_o(pmem_cache_read_data_w)
+    ,.inport1_resp_id_o(pmem_cache_resp_id_w)
 );
 
 
@@ -219,20 +347,21 @@ u_mux
     // Inputs
      .clk_i(clk_i)
     ,.rst_i(rst_i)
-    ,.mem_addr_i(mem_addr_i)
-    ,.mem_data_wr_i(mem_data_wr_i)
-    ,.mem_rd_i(mem_rd_i)
-    ,.mem_wr_i(mem_wr_i)
-    ,.mem_cacheable_i(mem_cacheable_i)
-    ,.mem_req_tag_i(mem_req_tag_i)
-    ,.mem_invalidate_i(mem_invalidate_i)
-    ,.mem_writeback_i(mem_writeback_i)
-    ,.mem_flush_i(mem_flush_i)
+    ,.mem_addr_i(mem_sb_addr_w)
+    ,.mem_data_wr_i(mem_sb_data_wr_w)
+    ,.mem_rd_i(mem_sb_rd_w)
+    ,.mem_wr_i(mem_sb_wr_w)
+    ,.mem_cacheable_i(mem_sb_cacheable_w)
+    ,.mem_req_tag_i(mem_sb_req_tag_w)
+    ,.mem_invalidate_i(mem_sb_invalidate_w)
+    ,.mem_writeback_i(mem_sb_writeback_w)
+    ,.mem_flush_i(mem_sb_flush_w)
     ,.mem_cached_data_rd_i(mem_cached_data_rd_w)
     ,.mem_cached_accept_i(mem_cached_accept_w)
     ,.mem_cached_ack_i(mem_cached_ack_w)
     ,.mem_cached_error_i(mem_cached_error_w)
     ,.mem_cached_resp_tag_i(mem_cached_resp_tag_w)
+    ,.mem_cached_busy_i(mem_cached_busy_w)
     ,.mem_uncached_data_rd_i(mem_uncached_data_rd_w)
     ,.mem_uncached_accept_i(mem_uncached_accept_w)
     ,.mem_uncached_ack_i(mem_uncached_ack_w)
@@ -240,11 +369,11 @@ u_mux
     ,.mem_uncached_resp_tag_i(mem_uncached_resp_tag_w)
 
     // Outputs
-    ,.mem_data_rd_o(mem_data_rd_o)
-    ,.mem_accept_o(mem_accept_o)
-    ,.mem_ack_o(mem_ack_o)
-    ,.mem_error_o(mem_error_o)
-    ,.mem_resp_tag_o(mem_resp_tag_o)
+    ,.mem_data_rd_o(mem_sb_data_rd_w)
+    ,.mem_accept_o(mem_sb_accept_w)
+    ,.mem_ack_o(mem_sb_ack_w)
+    ,.mem_error_o(mem_sb_error_w)
+    ,.mem_resp_tag_o(mem_sb_resp_tag_w)
     ,.mem_cached_addr_o(mem_cached_addr_w)
     ,.mem_cached_data_wr_o(mem_cached_data_wr_w)
     ,.mem_cached_rd_o(mem_cached_rd_w)
@@ -264,10 +393,26 @@ u_mux
     ,.mem_uncached_writeback_o(mem_uncached_writeback_w)
     ,.mem_uncached_flush_o(mem_uncached_flush_w)
     ,.cache_active_o(pmem_select_w)
+    ,.uncached_idle_o(uncached_idle_w)
 );
 
 
 dcache_core
+#(
+     .DCACHE_NUM_WAYS(DCACHE_NUM_WAYS)
+    ,.DCACHE_NUM_WAYS_W(DCACHE_NUM_WAYS_W)
+    ,.DCACHE_NUM_LINES(DCACHE_NUM_LINES)
+    ,.DCACHE_NUM_LINES_W(DCACHE_NUM_LINES_W)
+    ,.DCACHE_LINE_SIZE(DCACHE_LINE_SIZE)
+    ,.DCACHE_LINE_SIZE_W(DCACHE_LINE_SIZE_W)
+    ,.DCACHE_PLRU_ENABLE(DCACHE_PLRU_ENABLE)
+    ,.DCACHE_NON_BLOCKING(DCACHE_NON_BLOCKING)
+    ,.DCACHE_NUM_MSHR(DCACHE_NUM_MSHR)
+    ,.DCACHE_NUM_MSHR_W(DCACHE_NUM_MSHR_W)
+    ,.DCACHE_PREFETCH(DCACHE_PREFETCH)
+    ,.DCACHE_PREFETCH_ENTRIES(DCACHE_PREFETCH_ENTRIES)
+    ,.DCACHE_PREFETCH_ENTRIES_W(DCACHE_PREFETCH_ENTRIES_W)
+)
 u_core
 (
     // Inputs
@@ -282,10 +427,13 @@ u_core
     ,.mem_invalidate_i(mem_cached_invalidate_w)
     ,.mem_writeback_i(mem_cached_writeback_w)
     ,.mem_flush_i(mem_cached_flush_w)
+    ,.mem_pc_i(mem_pc_i)
+    ,.uncached_idle_i(uncached_idle_w)
     ,.outport_accept_i(pmem_cache_accept_w)
     ,.outport_ack_i(pmem_cache_ack_w)
     ,.outport_error_i(pmem_cache_error_w)
     ,.outport_read_data_i(pmem_cache_read_data_w)
+    ,.outport_resp_id_i(pmem_cache_resp_id_w)
 
     // Outputs
     ,.mem_data_rd_o(mem_cached_data_rd_w)
@@ -293,17 +441,23 @@ u_core
     ,.mem_ack_o(mem_cached_ack_w)
     ,.mem_error_o(mem_cached_error_w)
     ,.mem_resp_tag_o(mem_cached_resp_tag_w)
+    ,.mem_busy_o(mem_cached_busy_w)
+    ,.fill_error_o(mem_fill_error_o)
+    ,.fill_error_addr_o(mem_fill_error_addr_o)
     ,.outport_wr_o(pmem_cache_wr_w)
     ,.outport_rd_o(pmem_cache_rd_w)
     ,.outport_len_o(pmem_cache_len_w)
     ,.outport_addr_o(pmem_cache_addr_w)
     ,.outport_write_data_o(pmem_cache_write_data_w)
+    ,.outport_id_o(pmem_cache_id_w)
 );
 
 
 dcache_axi
 #(
      .AXI_ID(AXI_ID)
+    ,.MAX_OUTSTANDING((DCACHE_NON_BLOCKING && DCACHE_NUM_MSHR > 2) ? DCACHE_NUM_MSHR : 2)
+    ,.AXI_DATA_W(AXI_DATA_W)
 )
 u_axi
 (
@@ -326,6 +480,7 @@ u_axi
     ,.inport_len_i(pmem_len_w)
     ,.inport_addr_i(pmem_addr_w)
     ,.inport_write_data_i(pmem_write_data_w)
+    ,.inport_id_i(pmem_id_w)
 
     // Outputs
     ,.outport_awvalid_o(axi_awvalid_o)
@@ -348,6 +503,7 @@ u_axi
     ,.inport_ack_o(pmem_ack_w)
     ,.inport_error_o(pmem_error_w)
     ,.inport_read_data_o(pmem_read_data_w)
+    ,.inport_resp_id_o(pmem_resp_id_w)
 );
 
 
@@ -29,6 +29,8 @@ module dcache_axi
 //-----------------------------------------------------------------
 #(
      parameter AXI_ID           = 0
+    ,parameter MAX_OUTSTANDING  = 2
+    ,parameter AXI_DATA_W       = 32
 )
 //-----------------------------------------------------------------
 // Ports
@@ -44,7 +46,7 @@ module dcache_axi
     ,input  [  3:0]  outport_bid_i
     ,input           outport_arready_i
     ,input           outport_rvalid_i
-    ,input  [ 31:0]  outport_rdata_i
+    ,input  [AXI_DATA_W-1:0] outport_rdata_i
     ,input  [  1:0]  outport_rresp_i
     ,input  [  3:0]  outport_rid_i
     ,input           outport_rlast_i
@@ -53,6 +55,7 @@ module dcache_axi
     ,input  [  7:0]  inport_len_i
     ,input  [ 31:0]  inport_addr_i
     ,input  [ 31:0]  inport_write_data_i
+    ,input  [  3:0]  inport_id_i
 
     // Outputs
     ,output          outport_awvalid_o
@@ -61,8 +64,8 @@ module dcache_axi
     ,output [  7:0]  outport_awlen_o
     ,output [  1:0]  outport_awburst_o
     ,output          outport_wvalid_o
-    ,output [ 31:0]  outport_wdata_o
-    ,output [  3:0]  outport_wstrb_o
+    ,output [AXI_DATA_W-1:0] outport_wdata_o
+    ,output [(AXI_DATA_W/8)-1:0] outport_wstrb_o
     ,output          outport_wlast_o
     ,output          outport_bready_o
     ,output          outport_arvalid_o
@@ -75,11 +78,43 @@ module dcache_axi
     ,output          inport_ack_o
     ,output          inport_error_o
     ,output [ 31:0]  inport_read_data_o
+    ,output [  3:0]  inport_resp_id_o
 );
 
 
 
 
+//-------------------------------------------------------------
+// AXI (32-bit side, before any width conversion)
+//-------------------------------------------------------------
+wire        axi_awvalid_w;
+wire [31:0] axi_awaddr_w;
+wire [ 3:0] axi_awid_w;
+wire [ 7:0] axi_awlen_w;
+wire [ 1:0] axi_awburst_w;
+wire        axi_wvalid_w;
+wire [31:0] axi_wdata_w;
+wire [ 3:0] axi_wstrb_w;
+wire        axi_wlast_w;
+wire        axi_bready_w;
+wire        axi_arvalid_w;
+wire [31:0] axi_araddr_w;
+wire [ 3:0] axi_arid_w;
+wire [ 7:0] axi_arlen_w;
+wire [ 1:0] axi_arburst_w;
+wire        axi_rready_w;
+wire        axi_awready_w;
+wire        axi_wready_w;
+wire        axi_bvalid_w;
+wire [ 1:0] axi_bresp_w;
+wire [ 3:0] axi_bid_w;
+wire        axi_arready_w;
+wire        axi_rvalid_w;
+wire [31:0] axi_rdata_w;
+wire [ 1:0] axi_rresp_w;
+wire [ 3:0] axi_rid_w;
+wire        axi_rlast_w;
+
 //-------------------------------------------------------------
 // Request FIFO
 //-------------------------------------------------------------
@@ -95,17 +130,17 @@ wire          req_accept_w;
 
 wire          res_valid_w;
 wire          req_valid_w;
-wire [77-1:0] req_w;
+wire [81-1:0] req_w;
 
 // Push on transaction and other FIFO not full
 wire          req_push_w    = (inport_rd_i || inport_wr_i != 4'b0);
-wire [77-1:0] req_data_in_w = {inport_len_i, inport_rd_i, inport_wr_i, inport_write_data_i, inport_addr_i};
+wire [81-1:0] req_data_in_w = {inport_id_i, inport_len_i, inport_rd_i, inport_wr_i, inport_write_data_i, inport_addr_i};
 
 dcache_axi_fifo
 #( 
     .ADDR_W(1),
     .DEPTH(2),
-    .WIDTH(32+32+8+4+1)
+    .WIDTH(32+32+8+4+1+4)
 )
 u_req
 (
@@ -127,11 +162,20 @@ wire       req_can_issue_w = req_valid_w & res_accept_w;
 wire       req_is_read_w   = (req_can_issue_w ? req_w[68] : 1'b0);
 wire       req_is_write_w  = (req_can_issue_w ? ~req_w[68] : 1'b0);
 wire [7:0] req_len_w       = req_w[76:69];
+wire [3:0] req_id_w        = req_w[80:77];
+
+// Line refills are critical word first (WRAP), everything else INCR
+wire [1:0] req_burst_w     = (req_is_read_w && req_len_w != 8'd0) ? 2'b10 : 2'b01;
 
 assign inport_accept_o = req_accept_w;
 assign inport_ack_o    = bvalid_w || rvalid_w;
 assign inport_error_o  = bvalid_w ? (bresp_w != 2'b0) : (rresp_w != 2'b0);
 
+// Requests may use a range of IDs starting at AXI_ID (one per outstanding line fill)
+wire [3:0] bid_w;
+wire [3:0] rid_w;
+assign inport_resp_id_o = (bvalid_w ? bid_w : rid_w) - AXI_ID;
+
 //-------------------------------------------------------------
 // Write burst tracking
 //-------------------------------------------------------------
@@ -155,22 +199,24 @@ wire req_last_w = (req_is_write_w && req_len_w == 8'd0 && req_cnt_q == 8'd0);
 wire res_push_w = (req_is_write_w && req_last_w && accept_w) || (req_is_read_w && accept_w);
 
 // Pop on last tick of burst
-wire resp_pop_w = outport_bvalid_i || (outport_rvalid_i ? outport_rlast_i : 1'b0);
+wire resp_pop_w = axi_bvalid_w || (axi_rvalid_w ? axi_rlast_w : 1'b0);
 
-reg  [1:0] resp_outstanding_q;
+reg  [3:0] resp_outstanding_q;
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
-    resp_outstanding_q <= 2'b0;
+    resp_outstanding_q <= 4'b0;
 // Count up
 else if ((res_push_w & res_accept_w) & ~(resp_pop_w & res_valid_w))
-    resp_outstanding_q <= resp_outstanding_q + 2'd1;
+    resp_outstanding_q <= resp_outstanding_q + 4'd1;
 // Count down
 else if (~(res_push_w & res_accept_w) & (resp_pop_w & res_valid_w))
-    resp_outstanding_q <= resp_outstanding_q - 2'd1;
+    resp_outstanding_q <= resp_outstanding_q - 4'd1;
 
-assign res_valid_w   = (resp_outstanding_q != 2'd0);
-assign res_accept_w  = (resp_outstanding_q != 2'd2);
+assign res_valid_w   = (resp_outstanding_q != 4'd0);
+/* verilator lint_off WIDTH */
+assign res_accept_w  = (resp_outstanding_q != MAX_OUTSTANDING);
+/* verilator lint_on WIDTH */
 
 //-------------------------------------------------------------
 // AXI widget
@@ -186,51 +232,158 @@ u_axi
     .inport_wdata_i(req_w[63:32]),
     .inport_wstrb_i(req_w[67:64]),    
     .inport_addr_i({req_w[31:2], 2'b0}),
-    .inport_id_i(AXI_ID),
+    .inport_id_i(AXI_ID + req_id_w),
     .inport_len_i(req_len_w),
-    .inport_burst_i(2'b01),
+    .inport_burst_i(req_burst_w),
     .inport_accept_o(accept_w),
 
     .inport_bready_i(1'b1),
     .inport_rready_i(1'b1),
     .inport_bvalid_o(bvalid_w),
     .inport_bresp_o(bresp_w),
-    .inport_bid_o(),
+    .inport_bid_o(bid_w),
     .inport_rvalid_o(rvalid_w),
     .inport_rdata_o(inport_read_data_o),
     .inport_rresp_o(rresp_w),
-    .inport_rid_o(),
+    .inport_rid_o(rid_w),
     .inport_rlast_o(),
 
-    .outport_awvalid_o(outport_awvalid_o),
-    .outport_awaddr_o(outport_awaddr_o),
-    .outport_awid_o(outport_awid_o),
-    .outport_awlen_o(outport_awlen_o),
-    .outport_awburst_o(outport_awburst_o),
-    .outport_wvalid_o(outport_wvalid_o),
-    .outport_wdata_o(outport_wdata_o),
-    .outport_wstrb_o(outport_wstrb_o),
-    .outport_wlast_o(outport_wlast_o),
-    .outport_bready_o(outport_bready_o),
-    .outport_arvalid_o(outport_arvalid_o),
-    .outport_araddr_o(outport_araddr_o),
-    .outport_arid_o(outport_arid_o),
-    .outport_arlen_o(outport_arlen_o),
-    .outport_arburst_o(outport_arburst_o),
-    .outport_rready_o(outport_rready_o),
-    .outport_awready_i(outport_awready_i),
-    .outport_wready_i(outport_wready_i),
-    .outport_bvalid_i(outport_bvalid_i),
-    .outport_bresp_i(outport_bresp_i),
-    .outport_bid_i(outport_bid_i),
-    .outport_arready_i(outport_arready_i),
-    .outport_rvalid_i(outport_rvalid_i),
-    .outport_rdata_i(outport_rdata_i),
-    .outport_rresp_i(outport_rresp_i),
-    .outport_rid_i(outport_rid_i),
-    .outport_rlast_i(outport_rlast_i)
+    .outport_awvalid_o(axi_awvalid_w),
+    .outport_awaddr_o(axi_awaddr_w),
+    .outport_awid_o(axi_awid_w),
+    .outport_awlen_o(axi_awlen_w),
+    .outport_awburst_o(axi_awburst_w),
+    .outport_wvalid_o(axi_wvalid_w),
+    .outport_wdata_o(axi_wdata_w),
+    .outport_wstrb_o(axi_wstrb_w),
+    .outport_wlast_o(axi_wlast_w),
+    .outport_bready_o(axi_bready_w),
+    .outport_arvalid_o(axi_arvalid_w),
+    .outport_araddr_o(axi_araddr_w),
+    .outport_arid_o(axi_arid_w),
+    .outport_arlen_o(axi_arlen_w),
+    .outport_arburst_o(axi_arburst_w),
+    .outport_rready_o(axi_rready_w),
+    .outport_awready_i(axi_awready_w),
+    .outport_wready_i(axi_wready_w),
+    .outport_bvalid_i(axi_bvalid_w),
+    .outport_bresp_i(axi_bresp_w),
+    .outport_bid_i(axi_bid_w),
+    .outport_arready_i(axi_arready_w),
+    .outport_rvalid_i(axi_rvalid_w),
+    .outport_rdata_i(axi_rdata_w),
+    .outport_rresp_i(axi_rresp_w),
+    .outport_rid_i(axi_rid_w),
+    .outport_rlast_i(axi_rlast_w)
 );
 
+
+//-------------------------------------------------------------
+// Width conversion
+//-------------------------------------------------------------
+generate
+if (AXI_DATA_W == 32)
+begin : AXI_32
+    assign outport_awvalid_o = axi_awvalid_w;
+    assign outport_awaddr_o  = axi_awaddr_w;
+    assign outport_awid_o    = axi_awid_w;
+    assign outport_awlen_o   = axi_awlen_w;
+    assign outport_awburst_o = axi_awburst_w;
+    assign outport_wvalid_o  = axi_wvalid_w;
+    assign outport_wdata_o   = axi_wdata_w;
+    assign outport_wstrb_o   = axi_wstrb_w;
+    assign outport_wlast_o   = axi_wlast_w;
+    assign outport_bready_o  = axi_bready_w;
+    assign outport_arvalid_o = axi_arvalid_w;
+    assign outport_araddr_o  = axi_araddr_w;
+    assign outport_arid_o    = axi_arid_w;
+    assign outport_arlen_o   = axi_arlen_w;
+    assign outport_arburst_o = axi_arburst_w;
+    assign outport_rready_o  = axi_rready_w;
+
+    assign axi_awready_w     = outport_awready_i;
+    assign axi_wready_w      = outport_wready_i;
+    assign axi_bvalid_w      = outport_bvalid_i;
+    assign axi_bresp_w       = outport_bresp_i;
+    assign axi_bid_w         = outport_bid_i;
+    assign axi_arready_w     = outport_arready_i;
+    assign axi_rvalid_w      = outport_rvalid_i;
+    assign axi_rdata_w       = outport_rdata_i;
+    assign axi_rresp_w       = outport_rresp_i;
+    assign axi_rid_w         = outport_rid_i;
+    assign axi_rlast_w       = outport_rlast_i;
+end
+else
+begin : AXI_WIDE
+    dcache_axi_upsize
+    #(
+         .AXI_ID(AXI_ID)
+        ,.AXI_DATA_W(AXI_DATA_W)
+        ,.ID_W((MAX_OUTSTANDING > 8) ? 4 : (MAX_OUTSTANDING > 4) ? 3 : (MAX_OUTSTANDING > 2) ? 2 : 1)
+    )
+    u_upsize
+    (
+        .clk_i(clk_i),
+        .rst_i(rst_i),
+
+        .inport_awvalid_i(axi_awvalid_w),
+        .inport_awaddr_i(axi_awaddr_w),
+        .inport_awid_i(axi_awid_w),
+        .inport_awlen_i(axi_awlen_w),
+        .inport_awburst_i(axi_awburst_w),
+        .inport_wvalid_i(axi_wvalid_w),
+        .inport_wdata_i(axi_wdata_w),
+        .inport_wstrb_i(axi_wstrb_w),
+        .inport_wlast_i(axi_wlast_w),
+        .inport_bready_i(axi_bready_w),
+        .inport_arvalid_i(axi_arvalid_w),
+        .inport_araddr_i(axi_araddr_w),
+        .inport_arid_i(axi_arid_w),
+        .inport_arlen_i(axi_arlen_w),
+        .inport_arburst_i(axi_arburst_w),
+        .inport_rready_i(axi_rready_w),
+        .inport_awready_o(axi_awready_w),
+        .inport_wready_o(axi_wready_w),
+        .inport_bvalid_o(axi_bvalid_w),
+        .inport_bresp_o(axi_bresp_w),
+        .inport_bid_o(axi_bid_w),
+        .inport_arready_o(axi_arready_w),
+        .inport_rvalid_o(axi_rvalid_w),
+        .inport_rdata_o(axi_rdata_w),
+        .inport_rresp_o(axi_rresp_w),
+        .inport_rid_o(axi_rid_w),
+        .inport_rlast_o(axi_rlast_w),
+        .outport_awvalid_o(outport_awvalid_o),
+        .outport_awaddr_o(outport_awaddr_o),
+        .outport_awid_o(outport_awid_o),
+        .outport_awlen_o(outport_awlen_o),
+        .outport_awburst_o(outport_awburst_o),
+        .outport_wvalid_o(outport_wvalid_o),
+        .outport_wdata_o(outport_wdata_o),
+        .outport_wstrb_o(outport_wstrb_o),
+        .outport_wlast_o(outport_wlast_o),
+        .outport_bready_o(outport_bready_o),
+        .outport_arvalid_o(outport_arvalid_o),
+        .outport_araddr_o(outport_araddr_o),
+        .outport_arid_o(outport_arid_o),
+        .outport_arlen_o(outport_arlen_o),
+        .outport_arburst_o(outport_arburst_o),
+        .outport_rready_o(outport_rready_o),
+        .outport_awready_i(outport_awready_i),
+        .outport_wready_i(outport_wready_i),
+        .outport_bvalid_i(outport_bvalid_i),
+        .outport_bresp_i(outport_bresp_i),
+        .outport_bid_i(outport_bid_i),
+        .outport_arready_i(outport_arready_i),
+        .outport_rvalid_i(outport_rvalid_i),
+        .outport_rdata_i(outport_rdata_i),
+        .outport_rresp_i(outport_rresp_i),
+        .outport_rid_i(outport_rid_i),
+        .outport_rlast_i(outport_rlast_i)
+    );
+end
+endgenerate
+
 endmodule
 
 
@@ -316,4 +469,326 @@ assign data_out_o    = ram_q[rd_ptr_q];
 
 
 
+endmodule
+
+
+module dcache_axi_upsize
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter AXI_ID           = 0
+    ,parameter AXI_DATA_W       = 64
+    ,parameter ID_W             = 1
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input           inport_awvalid_i
+    ,input  [ 31:0]  inport_awaddr_i
+    ,input  [  3:0]  inport_awid_i
+    ,input  [  7:0]  inport_awlen_i
+    ,input  [  1:0]  inport_awburst_i
+    ,input           inport_wvalid_i
+    ,input  [ 31:0]  inport_wdata_i
+    ,input  [  3:0]  inport_wstrb_i
+    ,input           inport_wlast_i
+    ,input           inport_bready_i
+    ,input           inport_arvalid_i
+    ,input  [ 31:0]  inport_araddr_i
+    ,input  [  3:0]  inport_arid_i
+    ,input  [  7:0]  inport_arlen_i
+    ,input  [  1:0]  inport_arburst_i
+    ,input           inport_rready_i
+    ,input           outport_awready_i
+    ,input           outport_wready_i
+    ,input           outport_bvalid_i
+    ,input  [  1:0]  outport_bresp_i
+    ,input  [  3:0]  outport_bid_i
+    ,input           outport_arready_i
+    ,input           outport_rvalid_i
+    ,input  [AXI_DATA_W-1:0] outport_rdata_i
+    ,input  [  1:0]  outport_rresp_i
+    ,input  [  3:0]  outport_rid_i
+    ,input           outport_rlast_i
+
+    // Outputs
+    ,output          inport_awready_o
+    ,output          inport_wready_o
+    ,output          inport_bvalid_o
+    ,output [  1:0]  inport_bresp_o
+    ,output [  3:0]  inport_bid_o
+    ,output          inport_arready_o
+    ,output          inport_rvalid_o
+    ,output [ 31:0]  inport_rdata_o
+    ,output [  1:0]  inport_rresp_o
+    ,output [  3:0]  inport_rid_o
+    ,output          inport_rlast_o
+    ,output          outport_awvalid_o
+    ,output [ 31:0]  outport_awaddr_o
+    ,output [  3:0]  outport_awid_o
+    ,output [  7:0]  outport_awlen_o
+    ,output [  1:0]  outport_awburst_o
+    ,output          outport_wvalid_o
+    ,output [AXI_DATA_W-1:0] outport_wdata_o
+    ,output [(AXI_DATA_W/8)-1:0] outport_wstrb_o
+    ,output          outport_wlast_o
+    ,output          outport_bready_o
+    ,output          outport_arvalid_o
+    ,output [ 31:0]  outport_araddr_o
+    ,output [  3:0]  outport_arid_o
+    ,output [  7:0]  outport_arlen_o
+    ,output [  1:0]  outport_arburst_o
+    ,output          outport_rready_o
+);
+
+//-----------------------------------------------------------------
+// Converts the 32-bit AXI requests of the data cache to a wider bus.
+// Single word accesses use the byte lanes of their address.
+// Line bursts (always a multiple of the bus width) are packed into
+// full width beats - line refills are critical word first, so the
+// words of the first beat below the critical word are held and
+// returned after the last beat to keep the 32-bit WRAP ordering.
+//-----------------------------------------------------------------
+localparam RATIO   = AXI_DATA_W / 32;
+localparam RATIO_W = (AXI_DATA_W == 128) ? 2 : 1;
+localparam ADDR_L  = RATIO_W + 2;
+localparam NUM_ID  = 1 << ID_W;
+
+//-------------------------------------------------------------
+// Read Request
+//-------------------------------------------------------------
+wire [7:0] ar_beats_w = inport_arlen_i + 8'd1;
+wire       ar_single_w = (inport_arlen_i == 8'd0);
+
+assign outport_arvalid_o = inport_arvalid_i;
+assign outport_araddr_o  = ar_single_w ? inport_araddr_i : {inport_araddr_i[31:ADDR_L], {(ADDR_L){1'b0}}};
+assign outport_arid_o    = inport_arid_i;
+assign outport_arlen_o   = ar_single_w ? 8'd0 : ((ar_beats_w >> RATIO_W) - 8'd1);
+assign outport_arburst_o = inport_arburst_i;
+assign inport_arready_o  = outport_arready_i;
+
+// Per ID - starting word (lane) and single word flag
+reg [RATIO_W-1:0]    rd_lane_q[NUM_ID-1:0];
+reg [NUM_ID-1:0]     rd_single_q;
+reg [NUM_ID-1:0]     rd_first_q;
+
+wire [ID_W-1:0] ar_idx_w = inport_arid_i - AXI_ID;
+wire [ID_W-1:0] r_idx_w  = outport_rid_i - AXI_ID;
+
+//-------------------------------------------------------------
+// Read Response
+//-------------------------------------------------------------
+reg                  busy_q;
+reg [AXI_DATA_W-1:0] buf_q;
+reg [RATIO_W-1:0]    lane_q;
+reg [RATIO_W:0]      cnt_q;
+reg                  tail_q;
+reg                  last_q;
+reg [3:0]            id_q;
+reg [1:0]            resp_q;
+
+// Words of the first beat returned after the end of the burst
+reg [AXI_DATA_W-1:0] head_q[NUM_ID-1:0];
+reg [1:0]            head_resp_q[NUM_ID-1:0];
+
+wire [ID_W-1:0]      id_idx_w   = id_q - AXI_ID;
+
+wire                 r_accept_w = outport_rvalid_i && outport_rready_o;
+wire                 r_single_w = rd_single_q[r_idx_w];
+wire                 r_first_w  = rd_first_q[r_idx_w];
+wire [RATIO_W-1:0]   r_lane_w   = rd_lane_q[r_idx_w];
+
+// Words to return from this beat, starting lane and trailing head words
+wire [RATIO_W-1:0]   r_start_w  = (r_single_w || r_first_w) ? r_lane_w : {(RATIO_W){1'b0}};
+wire [RATIO_W:0]     r_count_w  = r_single_w ? 1 : r_first_w ? (RATIO - r_lane_w) : RATIO;
+wire                 r_tail_w   = !r_single_w && outport_rlast_i && (r_lane_w != {(RATIO_W){1'b0}});
+
+integer i0;
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    rd_single_q <= {(NUM_ID){1'b0}};
+    rd_first_q  <= {(NUM_ID){1'b0}};
+    for (i0 = 0; i0 < NUM_ID; i0 = i0 + 1)
+    begin
+        rd_lane_q[i0]   <= {(RATIO_W){1'b0}};
+        head_q[i0]      <= {(AXI_DATA_W){1'b0}};
+        head_resp_q[i0] <= 2'b0;
+    end
+end
+else
+begin
+    if (r_accept_w && r_first_w)
+    begin
+        rd_first_q[r_idx_w]  <= 1'b0;
+        head_q[r_idx_w]      <= outport_rdata_i;
+        head_resp_q[r_idx_w] <= outport_rresp_i;
+    end
+
+    if (inport_arvalid_i && inport_arready_o)
+    begin
+        rd_lane_q[ar_idx_w]   <= inport_araddr_i[ADDR_L-1:2];
+        rd_single_q[ar_idx_w] <= ar_single_w;
+        rd_first_q[ar_idx_w]  <= !ar_single_w;
+    end
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    busy_q <= 1'b0;
+    buf_q  <= {(AXI_DATA_W){1'b0}};
+    lane_q <= {(RATIO_W){1'b0}};
+    cnt_q  <= {(RATIO_W+1){1'b0}};
+    tail_q <= 1'b0;
+    last_q <= 1'b0;
+    id_q   <= 4'b0;
+    resp_q <= 2'b0;
+end
+// First word of the beat is returned directly, hold onto the rest
+else if (r_accept_w && (r_count_w > 1 || r_tail_w))
+begin
+    busy_q <= 1'b1;
+    buf_q  <= outport_rdata_i;
+    lane_q <= (r_count_w > 1) ? (r_start_w + 1'b1) : {(RATIO_W){1'b0}};
+    cnt_q  <= (r_count_w > 1) ? (r_count_w - 1'b1) : {1'b0, r_lane_w};
+    tail_q <= (r_count_w > 1) && r_tail_w;
+    last_q <= outport_rlast_i;
+    id_q   <= outport_rid_i;
+    resp_q <= outport_rresp_i;
+end
+else if (busy_q && inport_rready_i)
+begin
+    if (cnt_q > 1)
+    begin
+        lane_q <= lane_q + 1'b1;
+        cnt_q  <= cnt_q - 1'b1;
+    end
+    // Words of the first beat below the critical word
+    else if (tail_q)
+    begin
+        buf_q  <= head_q[id_idx_w];
+        resp_q <= head_resp_q[id_idx_w];
+        lane_q <= {(RATIO_W){1'b0}};
+        cnt_q  <= {1'b0, rd_lane_q[id_idx_w]};
+        tail_q <= 1'b0;
+    end
+    else
+        busy_q <= 1'b0;
+end
+
+assign outport_rready_o = !busy_q && inport_rready_i;
+
+assign inport_rvalid_o  = busy_q ? 1'b1 : outport_rvalid_i;
+assign inport_rdata_o   = busy_q ? buf_q[lane_q*32 +: 32] : outport_rdata_i[r_start_w*32 +: 32];
+assign inport_rresp_o   = busy_q ? resp_q : outport_rresp_i;
+assign inport_rid_o     = busy_q ? id_q   : outport_rid_i;
+assign inport_rlast_o   = busy_q ? (last_q && cnt_q == 1 && !tail_q) :
+                                   (outport_rlast_i && r_count_w == 1 && !r_tail_w);
+
+//-------------------------------------------------------------
+// Write Request
+//-------------------------------------------------------------
+wire [7:0] aw_beats_w  = inport_awlen_i + 8'd1;
+wire       aw_single_w = (inport_awlen_i == 8'd0);
+
+assign outport_awvalid_o = inport_awvalid_i;
+assign outport_awaddr_o  = aw_single_w ? inport_awaddr_i : {inport_awaddr_i[31:ADDR_L], {(ADDR_L){1'b0}}};
+assign outport_awid_o    = inport_awid_i;
+assign outport_awlen_o   = aw_single_w ? 8'd0 : ((aw_beats_w >> RATIO_W) - 8'd1);
+assign outport_awburst_o = inport_awburst_i;
+assign inport_awready_o  = outport_awready_i;
+
+//-------------------------------------------------------------
+// Write Data
+//-------------------------------------------------------------
+// Write data may be accepted before or after the address
+wire aw_accept_w = inport_awvalid_i && inport_awready_o;
+wire w_done_w    = inport_wvalid_i && inport_wready_o && inport_wlast_i;
+
+reg               wr_valid_q;
+reg               wr_early_q;
+reg [RATIO_W-1:0] wr_lane_q;
+reg               wr_single_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    wr_valid_q  <= 1'b0;
+    wr_early_q  <= 1'b0;
+    wr_lane_q   <= {(RATIO_W){1'b0}};
+    wr_single_q <= 1'b0;
+end
+else
+begin
+    if (aw_accept_w)
+    begin
+        wr_lane_q   <= inport_awaddr_i[ADDR_L-1:2];
+        wr_single_q <= aw_single_w;
+    end
+
+    if (aw_accept_w && !w_done_w)
+    begin
+        if (wr_early_q)
+            wr_early_q <= 1'b0;
+        else
+            wr_valid_q <= 1'b1;
+    end
+    else if (w_done_w && !aw_accept_w)
+    begin
+        if (wr_valid_q)
+            wr_valid_q <= 1'b0;
+        else
+            wr_early_q <= 1'b1;
+    end
+end
+
+wire               w_single_w = wr_valid_q ? wr_single_q : aw_single_w;
+wire [RATIO_W-1:0] w_lane_w   = wr_valid_q ? wr_lane_q   : inport_awaddr_i[ADDR_L-1:2];
+
+// Burst beats are collected until a full width beat is available
+reg [RATIO_W-1:0]        w_idx_q;
+reg [AXI_DATA_W-32-1:0]  w_data_q;
+reg [(AXI_DATA_W/8)-5:0] w_strb_q;
+
+wire w_full_w = (w_idx_q == {(RATIO_W){1'b1}});
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    w_idx_q  <= {(RATIO_W){1'b0}};
+    w_data_q <= {(AXI_DATA_W-32){1'b0}};
+    w_strb_q <= {((AXI_DATA_W/8)-4){1'b0}};
+end
+else if (inport_wvalid_i && inport_wready_o && !w_single_w)
+begin
+    w_idx_q  <= w_idx_q + 1'b1;
+/* verilator lint_off WIDTH */
+    w_data_q <= {inport_wdata_i, w_data_q} >> 32;
+    w_strb_q <= {inport_wstrb_i, w_strb_q} >> 4;
+/* verilator lint_on WIDTH */
+end
+
+assign outport_wvalid_o = inport_wvalid_i && (w_single_w || w_full_w);
+assign outport_wdata_o  = w_single_w ? {(RATIO){inport_wdata_i}} : {inport_wdata_i, w_data_q};
+assign outport_wstrb_o  = w_single_w ? ({{((AXI_DATA_W/8)-4){1'b0}}, inport_wstrb_i} << (w_lane_w * 4)) :
+                                       {inport_wstrb_i, w_strb_q};
+assign outport_wlast_o  = inport_wlast_i;
+// Burst beats are only collected once the burst address has been accepted
+assign inport_wready_o  = (w_single_w || w_full_w) ? outport_wready_i : (wr_valid_q || aw_accept_w);
+
+//-------------------------------------------------------------
+// Write Response
+//-------------------------------------------------------------
+assign inport_bvalid_o  = outport_bvalid_i;
+assign inport_bresp_o   = outport_bresp_i;
+assign inport_bid_o     = outport_bid_i;
+assign outport_bready_o = inport_bready_i;
+
+
 endmodule
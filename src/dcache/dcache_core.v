@@ -24,6 +24,27 @@
 //-----------------------------------------------------------------
 
 module dcache_core
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter DCACHE_NUM_WAYS  = 2
+    ,parameter DCACHE_NUM_WAYS_W = 1
+    ,parameter DCACHE_NUM_LINES = 256
+    ,parameter DCACHE_NUM_LINES_W = 8
+    ,parameter DCACHE_LINE_SIZE = 32
+    ,parameter DCACHE_LINE_SIZE_W = 5
+    ,parameter DCACHE_PLRU_ENABLE = 0
+    ,parameter DCACHE_NON_BLOCKING = 0
+    ,parameter DCACHE_NUM_MSHR  = 2
+    ,parameter DCACHE_NUM_MSHR_W = 1
+    ,parameter DCACHE_PREFETCH  = 0
+    ,parameter DCACHE_PREFETCH_ENTRIES = 8
+    ,parameter DCACHE_PREFETCH_ENTRIES_W = 3
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk_i
@@ -37,10 +58,13 @@ module dcache_core
     ,input           mem_invalidate_i
     ,input           mem_writeback_i
     ,input           mem_flush_i
+    ,input  [ 31:0]  mem_pc_i
+    ,input           uncached_idle_i
     ,input           outport_accept_i
     ,input           outport_ack_i
     ,input           outport_error_i
     ,input  [ 31:0]  outport_read_data_i
+    ,input  [  3:0]  outport_resp_id_i
 
     // Outputs
     ,output [ 31:0]  mem_data_rd_o
@@ -48,43 +72,60 @@ module dcache_core
     ,output          mem_ack_o
     ,output          mem_error_o
     ,output [ 10:0]  mem_resp_tag_o
+    ,output          mem_busy_o
+    ,output          fill_error_o
+    ,output [ 31:0]  fill_error_addr_o
     ,output [  3:0]  outport_wr_o
     ,output          outport_rd_o
     ,output [  7:0]  outport_len_o
     ,output [ 31:0]  outport_addr_o
     ,output [ 31:0]  outport_write_data_o
+    ,output [  3:0]  outport_id_o
 );
 
 
 
 //-----------------------------------------------------------------
-// This cache instance is 2 way set associative.
-// The total size is 16KB.
-// The replacement policy is a limited pseudo random scheme
-// (between lines, toggling on line thrashing).
+// This cache instance is DCACHE_NUM_WAYS way set associative.
+// The total size is DCACHE_NUM_WAYS * DCACHE_NUM_LINES * DCACHE_LINE_SIZE
+// (default: 2 ways x 256 lines x 32 bytes = 16KB).
+// The replacement policy is either a limited pseudo random scheme
+// (between lines, toggling on line thrashing) or tree pseudo-LRU
+// (DCACHE_PLRU_ENABLE=1).
 // The cache is a write back cache, with allocate on read and write.
+// Line refills are critical word first with the missed request
+// completed as soon as its word arrives.  New requests are still only
+// accepted once the rest of the line has been written.
+// With DCACHE_NON_BLOCKING=1, misses which do not require a dirty line
+// to be evicted are handed off to one of DCACHE_NUM_MSHR miss status
+// holding registers, each using its own AXI ID. Store misses are
+// completed immediately and lookups to other sets continue whilst
+// line fills are outstanding (hit-under-miss / miss-under-miss).
+// With DCACHE_PREFETCH=1, a stride (per load PC) and next-line
+// prefetcher requests lines which are looked up and refilled in
+// cycles where no request is presented.  Prefetches are never
+// acknowledged to the requester.
+// A full word write presented with invalidate set zeroes the whole
+// line (cbo.zero) - a missing line is allocated without a refill.
+// Writeback and invalidate presented together write back the line
+// (if dirty) and then invalidate it (cbo.flush).
 //-----------------------------------------------------------------
-// Number of ways
-localparam DCACHE_NUM_WAYS           = 2;
-
 // Number of cache lines
-localparam DCACHE_NUM_LINES          = 256;
-localparam DCACHE_LINE_ADDR_W        = 8;
+localparam DCACHE_LINE_ADDR_W        = DCACHE_NUM_LINES_W;
 
 // Line size (e.g. 32-bytes)
-localparam DCACHE_LINE_SIZE_W        = 5;
-localparam DCACHE_LINE_SIZE          = 32;
-localparam DCACHE_LINE_WORDS         = 8;
+localparam DCACHE_LINE_WORDS         = DCACHE_LINE_SIZE / 4;
+localparam [7:0] DCACHE_BURST_LEN    = DCACHE_LINE_WORDS - 1;
 
 // Request -> tag address mapping
-localparam DCACHE_TAG_REQ_LINE_L     = 5;  // DCACHE_LINE_SIZE_W
-localparam DCACHE_TAG_REQ_LINE_H     = 12; // DCACHE_LINE_ADDR_W+DCACHE_LINE_SIZE_W-1
-localparam DCACHE_TAG_REQ_LINE_W     = 8;  // DCACHE_LINE_ADDR_W
+localparam DCACHE_TAG_REQ_LINE_L     = DCACHE_LINE_SIZE_W;
+localparam DCACHE_TAG_REQ_LINE_H     = DCACHE_LINE_ADDR_W+DCACHE_LINE_SIZE_W-1;
+localparam DCACHE_TAG_REQ_LINE_W     = DCACHE_LINE_ADDR_W;
 `define DCACHE_TAG_REQ_RNG          DCACHE_TAG_REQ_LINE_H:DCACHE_TAG_REQ_LINE_L
 
 // Tag fields
-`define CACHE_TAG_ADDR_RNG          18:0
-localparam CACHE_TAG_ADDR_BITS       = 19;
+`define CACHE_TAG_ADDR_RNG          CACHE_TAG_ADDR_BITS-1:0
+localparam CACHE_TAG_ADDR_BITS       = 32 - (DCACHE_LINE_ADDR_W+DCACHE_LINE_SIZE_W);
 localparam CACHE_TAG_DIRTY_BIT       = CACHE_TAG_ADDR_BITS + 0;
 localparam CACHE_TAG_VALID_BIT       = CACHE_TAG_ADDR_BITS + 1;
 localparam CACHE_TAG_DATA_W          = CACHE_TAG_ADDR_BITS + 2;
@@ -93,9 +134,12 @@ localparam CACHE_TAG_DATA_W          = CACHE_TAG_ADDR_BITS + 2;
 localparam DCACHE_TAG_CMP_ADDR_L     = DCACHE_TAG_REQ_LINE_H + 1;
 localparam DCACHE_TAG_CMP_ADDR_H     = 32-1;
 localparam DCACHE_TAG_CMP_ADDR_W     = DCACHE_TAG_CMP_ADDR_H - DCACHE_TAG_CMP_ADDR_L + 1;
-`define   DCACHE_TAG_CMP_ADDR_RNG   31:13
+`define   DCACHE_TAG_CMP_ADDR_RNG   DCACHE_TAG_CMP_ADDR_H:DCACHE_TAG_CMP_ADDR_L
+
+// Data addressing
+localparam CACHE_DATA_ADDR_W = DCACHE_LINE_ADDR_W+DCACHE_LINE_SIZE_W-2;
 
-// Address mapping example:
+// Address mapping example (default configuration):
 //  31          16 15 14 13 12 11 10 09 08 07 06 05 04 03 02 01 00
 // |--------------|  |  |  |  |  |  |  |  |  |  |  |  |  |  |  |  |
 //  +--------------------+  +--------------------+   +------------+
@@ -115,13 +159,12 @@ localparam STATE_RESET       = 4'd0;
 localparam STATE_FLUSH_ADDR  = 4'd1;
 localparam STATE_FLUSH       = 4'd2;
 localparam STATE_LOOKUP      = 4'd3;
-localparam STATE_READ        = 4'd4;
-localparam STATE_WRITE       = 4'd5;
-localparam STATE_REFILL      = 4'd6;
-localparam STATE_EVICT       = 4'd7;
-localparam STATE_EVICT_WAIT  = 4'd8;
-localparam STATE_INVALIDATE  = 4'd9;
-localparam STATE_WRITEBACK   = 4'd10;
+localparam STATE_REFILL      = 4'd4;
+localparam STATE_EVICT       = 4'd5;
+localparam STATE_EVICT_WAIT  = 4'd6;
+localparam STATE_INVALIDATE  = 4'd7;
+localparam STATE_WRITEBACK   = 4'd8;
+localparam STATE_ZERO        = 4'd9;
 
 // States
 reg [STATE_W-1:0]           next_state_r;
@@ -138,6 +181,17 @@ reg [10:0] mem_tag_m_q;
 reg        mem_inval_m_q;
 reg        mem_writeback_m_q;
 reg        mem_flush_m_q;
+reg        mem_zero_m_q;
+reg        mem_pf_m_q;
+
+// Line zero request (full word write flagged as invalidate)
+wire       mem_zero_w = mem_invalidate_i && (&mem_wr_i);
+
+// Prefetch
+wire        pf_valid_w;
+wire [31:0] pf_addr_w;
+wire        pf_inject_w;
+wire        pf_done_w;
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
@@ -150,19 +204,23 @@ begin
     mem_inval_m_q     <= 1'b0;
     mem_writeback_m_q <= 1'b0;
     mem_flush_m_q     <= 1'b0;
+    mem_zero_m_q      <= 1'b0;
+    mem_pf_m_q        <= 1'b0;
 end
 else if (mem_accept_o)
 begin
-    mem_addr_m_q      <= mem_addr_i;
+    mem_addr_m_q      <= pf_inject_w ? pf_addr_w : mem_addr_i;
     mem_data_m_q      <= mem_data_wr_i;
-    mem_wr_m_q        <= mem_wr_i;
-    mem_rd_m_q        <= mem_rd_i;
+    mem_wr_m_q        <= mem_zero_w ? 4'b0 : mem_wr_i;
+    mem_rd_m_q        <= mem_rd_i | pf_inject_w;
     mem_tag_m_q       <= mem_req_tag_i;
-    mem_inval_m_q     <= mem_invalidate_i;
+    mem_inval_m_q     <= mem_invalidate_i & ~mem_zero_w;
     mem_writeback_m_q <= mem_writeback_i;
     mem_flush_m_q     <= mem_flush_i;
+    mem_zero_m_q      <= mem_zero_w;
+    mem_pf_m_q        <= pf_inject_w;
 end
-else if (mem_ack_o)
+else if (mem_ack_o || pf_done_w)
 begin
     mem_addr_m_q      <= 32'b0;
     mem_data_m_q      <= 32'b0;
@@ -172,6 +230,8 @@ begin
     mem_inval_m_q     <= 1'b0;
     mem_writeback_m_q <= 1'b0;
     mem_flush_m_q     <= 1'b0;
+    mem_zero_m_q      <= 1'b0;
+    mem_pf_m_q        <= 1'b0;
 end
 
 reg mem_accept_r;
@@ -182,12 +242,21 @@ begin
 
     if (state_q == STATE_LOOKUP)
     begin
-        // Previous access missed - do not accept new requests
-        if ((mem_rd_m_q || (mem_wr_m_q != 4'b0)) && !tag_hit_any_m_w)
+        // Current request held (line fill in progress / structural hazard)
+        if (lookup_stall_w)
+            mem_accept_r = 1'b0;
+        // Previous access missed - do not accept new requests (unless a store or prefetch posted to an MSHR)
+        else if ((mem_rd_m_q || (mem_wr_m_q != 4'b0)) && !tag_hit_any_m_w && !(mshr_alloc_w && ((|mem_wr_m_q) || mem_pf_m_q)))
+            mem_accept_r = 1'b0;
+        // Line zero in progress
+        else if (mem_zero_m_q)
             mem_accept_r = 1'b0;
         // Write followed by read - detect writes to the same line, or addresses which alias in tag lookups
         else if ((|mem_wr_m_q) && mem_rd_i && mem_addr_i[31:2] == mem_addr_m_q[31:2])
             mem_accept_r = 1'b0;
+        // Maintenance operations wait for outstanding line fills
+        else if ((mshr_busy_w || mshr_alloc_w) && (mem_writeback_i || mem_flush_i || mem_invalidate_i))
+            mem_accept_r = 1'b0;
         else
             mem_accept_r = 1'b1;
     end
@@ -195,6 +264,12 @@ end
 
 assign mem_accept_o = mem_accept_r;
 
+// Prefetch lookup inserted when no request is presented (and the memory port is not in use by uncached accesses)
+wire mem_req_x_w = mem_rd_i || (|mem_wr_i) || mem_invalidate_i || mem_writeback_i || mem_flush_i;
+assign pf_inject_w  = pf_valid_w && mem_accept_r && !mem_req_x_w && uncached_idle_i;
+
+wire [31:0] req_addr_x_w = pf_inject_w ? pf_addr_w : mem_addr_i;
+
 // Tag comparison address
 wire [DCACHE_TAG_CMP_ADDR_W-1:0] req_addr_tag_cmp_m_w = mem_addr_m_q[`DCACHE_TAG_CMP_ADDR_RNG];
 
@@ -203,7 +278,8 @@ assign mem_resp_tag_o = mem_tag_m_q;
 //-----------------------------------------------------------------
 // Registers / Wires
 //-----------------------------------------------------------------
-reg [0:0]  replace_way_q;
+reg [DCACHE_NUM_WAYS_W-1:0]  replace_way_q;
+wire [DCACHE_NUM_WAYS_W-1:0] replace_way_w;
 
 wire  [  3:0]  pmem_wr_w;
 wire           pmem_rd_w;
@@ -217,10 +293,91 @@ wire           pmem_error_w;
 wire [ 31:0]   pmem_read_data_w;
 
 wire           evict_way_w;
+wire [(DCACHE_NUM_WAYS*32)-1:0] data_out_m_w;
 wire           tag_dirty_any_m_w;
 wire           tag_hit_and_dirty_m_w;
 
 reg            flushing_q;
+wire           zero_last_w;
+
+// Non-blocking (MSHR) operation
+wire           lookup_stall_w;
+wire           mshr_busy_w;
+wire           mshr_set_hit_w;
+wire           mshr_alloc_req_w;
+wire           mshr_alloc_w;
+wire           mshr_beat_w;
+wire           mshr_last_w;
+wire           mshr_load_ack_w;
+wire           mshr_dirty_w;
+wire           mshr_error_w;
+wire [31:0]    mshr_addr_w;
+wire [31:0]    mshr_data_w;
+wire [DCACHE_NUM_WAYS_W-1:0] mshr_way_w;
+wire [CACHE_DATA_ADDR_W-1:0] mshr_data_addr_w;
+wire [  3:0]   pmem_id_w;
+wire [  3:0]   pmem_resp_id_w;
+
+//-----------------------------------------------------------------
+// Refill tracking
+//-----------------------------------------------------------------
+// The request is acknowledged on the first (critical) word of the
+// refill and the request buffer released, so hold onto the line
+// address and write intent until the remainder of the line arrives.
+reg [31:0] refill_addr_q;
+reg        refill_dirty_q;
+reg        refill_acked_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    refill_addr_q  <= 32'b0;
+    refill_dirty_q <= 1'b0;
+end
+else if (state_q != STATE_REFILL && next_state_r == STATE_REFILL)
+begin
+    refill_addr_q  <= mem_addr_m_q;
+    refill_dirty_q <= (|mem_wr_m_q);
+end
+
+// Line refill requested
+wire refill_request_w = (state_q != STATE_REFILL && next_state_r == STATE_REFILL);
+
+// Critical word returned - complete the original request
+wire refill_ack_w = (state_q == STATE_REFILL) && pmem_ack_w && !refill_acked_q;
+
+// Prefetch refill - release the request buffer without acknowledging
+assign pf_done_w  = refill_ack_w && mem_pf_m_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    refill_acked_q <= 1'b0;
+else if (state_q != STATE_REFILL)
+    refill_acked_q <= 1'b0;
+else if (refill_ack_w)
+    refill_acked_q <= 1'b1;
+
+// A beat of the refill returned an error (any beat / after the request was acknowledged).
+// The line is not validated, so later accesses miss and see the error on their own refill.
+reg refill_error_q;
+reg refill_late_error_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    refill_error_q      <= 1'b0;
+    refill_late_error_q <= 1'b0;
+end
+else if (refill_request_w)
+begin
+    refill_error_q      <= 1'b0;
+    refill_late_error_q <= 1'b0;
+end
+else if (state_q == STATE_REFILL && pmem_ack_w && pmem_error_w)
+begin
+    refill_error_q      <= 1'b1;
+    refill_late_error_q <= refill_late_error_q | refill_acked_q;
+end
 
 //-----------------------------------------------------------------
 // TAG RAMS
@@ -232,11 +389,15 @@ reg [DCACHE_TAG_REQ_LINE_W-1:0] tag_addr_m_r;
 always @ *
 begin
     // Read Port
-    tag_addr_x_r = mem_addr_i[`DCACHE_TAG_REQ_RNG];
+    tag_addr_x_r = req_addr_x_w[`DCACHE_TAG_REQ_RNG];
 
+    // Lookup held - re-read the current request's line
+    if (state_q == STATE_LOOKUP && lookup_stall_w)
+        tag_addr_x_r = mem_addr_m_q[`DCACHE_TAG_REQ_RNG];
     // Lookup
-    if (state_q == STATE_LOOKUP && (next_state_r == STATE_LOOKUP || next_state_r == STATE_WRITEBACK))
-        tag_addr_x_r = mem_addr_i[`DCACHE_TAG_REQ_RNG];
+    else if (state_q == STATE_LOOKUP && (next_state_r == STATE_LOOKUP || next_state_r == STATE_WRITEBACK ||
+                                         next_state_r == STATE_INVALIDATE))
+        tag_addr_x_r = req_addr_x_w[`DCACHE_TAG_REQ_RNG];
     // Cache flush
     else if (flushing_q)
         tag_addr_x_r = flush_addr_q;
@@ -249,7 +410,13 @@ begin
     // Cache flush
     if (flushing_q || state_q == STATE_RESET)
         tag_addr_m_r = flush_addr_q;
-    // Line refill / write
+    // Line refill
+    else if (state_q == STATE_REFILL)
+        tag_addr_m_r = refill_addr_q[`DCACHE_TAG_REQ_RNG];
+    // Line fill (MSHR)
+    else if (mshr_beat_w)
+        tag_addr_m_r = mshr_addr_w[`DCACHE_TAG_REQ_RNG];
+    // Line write
     else
         tag_addr_m_r = mem_addr_m_q[`DCACHE_TAG_REQ_RNG];
 end
@@ -263,12 +430,12 @@ begin
     // Cache flush
     if (state_q == STATE_FLUSH || state_q == STATE_RESET || flushing_q)
         tag_data_in_m_r = {(CACHE_TAG_DATA_W){1'b0}};
-    // Line refill
+    // Line refill (dirty if the refill reason was a write)
     else if (state_q == STATE_REFILL)
     begin
-        tag_data_in_m_r[CACHE_TAG_VALID_BIT] = 1'b1;
-        tag_data_in_m_r[CACHE_TAG_DIRTY_BIT] = 1'b0;
-        tag_data_in_m_r[`CACHE_TAG_ADDR_RNG] = mem_addr_m_q[`DCACHE_TAG_CMP_ADDR_RNG];
+        tag_data_in_m_r[CACHE_TAG_VALID_BIT] = !refill_error_q && !pmem_error_w;
+        tag_data_in_m_r[CACHE_TAG_DIRTY_BIT] = refill_dirty_q;
+        tag_data_in_m_r[`CACHE_TAG_ADDR_RNG] = refill_addr_q[`DCACHE_TAG_CMP_ADDR_RNG];
     end
     // Invalidate - mark entry (if matching line) not valid (even if dirty...)
     else if (state_q == STATE_INVALIDATE)
@@ -277,15 +444,30 @@ begin
         tag_data_in_m_r[CACHE_TAG_DIRTY_BIT] = 1'b0;
         tag_data_in_m_r[`CACHE_TAG_ADDR_RNG] = mem_addr_m_q[`DCACHE_TAG_CMP_ADDR_RNG];
     end
-    // Evict completion
+    // Evict completion (a line evicted to make way for an MSHR fill, or
+    // written back by a line flush, is left invalid)
     else if (state_q == STATE_EVICT_WAIT)
     begin
-        tag_data_in_m_r[CACHE_TAG_VALID_BIT] = 1'b1;
+        tag_data_in_m_r[CACHE_TAG_VALID_BIT] = !(DCACHE_NON_BLOCKING && !flushing_q && !mem_writeback_m_q) && !mem_inval_m_q;
         tag_data_in_m_r[CACHE_TAG_DIRTY_BIT] = 1'b0;
         tag_data_in_m_r[`CACHE_TAG_ADDR_RNG] = mem_addr_m_q[`DCACHE_TAG_CMP_ADDR_RNG];
     end
+    // Line fill complete (dirty if the miss was a write, not valid if any beat failed)
+    else if (mshr_beat_w)
+    begin
+        tag_data_in_m_r[CACHE_TAG_VALID_BIT] = !mshr_error_w;
+        tag_data_in_m_r[CACHE_TAG_DIRTY_BIT] = mshr_dirty_w;
+        tag_data_in_m_r[`CACHE_TAG_ADDR_RNG] = mshr_addr_w[`DCACHE_TAG_CMP_ADDR_RNG];
+    end
+    // Line zeroed - valid and dirty
+    else if (state_q == STATE_ZERO)
+    begin
+        tag_data_in_m_r[CACHE_TAG_VALID_BIT] = 1'b1;
+        tag_data_in_m_r[CACHE_TAG_DIRTY_BIT] = 1'b1;
+        tag_data_in_m_r[`CACHE_TAG_ADDR_RNG] = mem_addr_m_q[`DCACHE_TAG_CMP_ADDR_RNG];
+    end
     // Write - mark entry as dirty
-    else if (state_q == STATE_WRITE || (state_q == STATE_LOOKUP && (|mem_wr_m_q)))
+    else if (state_q == STATE_LOOKUP && (|mem_wr_m_q))
     begin
         tag_data_in_m_r[CACHE_TAG_VALID_BIT] = 1'b1;
         tag_data_in_m_r[CACHE_TAG_DIRTY_BIT] = 1'b1;
@@ -293,178 +475,145 @@ begin
     end
 end
 
-// Tag RAM write enable (way 0)
-reg tag0_write_m_r;
+// Tag RAM write enable (per way)
+reg [DCACHE_NUM_WAYS-1:0] tag_write_m_r;
+integer i0;
 always @ *
 begin
-    tag0_write_m_r = 1'b0;
+    for (i0 = 0; i0 < DCACHE_NUM_WAYS; i0 = i0 + 1)
+    begin
+        tag_write_m_r[i0] = 1'b0;
+
+        // Cache flush (reset)
+        if (state_q == STATE_RESET)
+            tag_write_m_r[i0] = 1'b1;
+        // Cache flush
+        else if (state_q == STATE_FLUSH)
+            tag_write_m_r[i0] = !tag_dirty_any_m_w;
+        // Line fill (MSHR) complete
+        else if (mshr_beat_w)
+/* verilator lint_off WIDTH */
+            tag_write_m_r[i0] = mshr_last_w && (mshr_way_w == i0);
+/* verilator lint_on WIDTH */
+        // Write - hit, mark as dirty
+        else if (state_q == STATE_LOOKUP && (|mem_wr_m_q))
+            tag_write_m_r[i0] = tag_hit_m_w[i0] && !lookup_stall_w;
+        // Write - mark entry as dirty
+        else if (state_q == STATE_EVICT_WAIT && pmem_ack_w)
+/* verilator lint_off WIDTH */
+            tag_write_m_r[i0] = (replace_way_q == i0);
+        // Line refill
+        else if (state_q == STATE_REFILL)
+            tag_write_m_r[i0] = pmem_ack_w && pmem_last_w && (replace_way_q == i0);
+        // Line zero complete
+        else if (state_q == STATE_ZERO)
+            tag_write_m_r[i0] = zero_last_w && (replace_way_q == i0);
+/* verilator lint_on WIDTH */
+        // Invalidate - line matches address - invalidate
+        else if (state_q == STATE_INVALIDATE)
+            tag_write_m_r[i0] = tag_hit_m_w[i0];
+    end
+end
 
-    // Cache flush (reset)
-    if (state_q == STATE_RESET)
-        tag0_write_m_r = 1'b1;
-    // Cache flush
-    else if (state_q == STATE_FLUSH)
-        tag0_write_m_r = !tag_dirty_any_m_w;
-    // Write - hit, mark as dirty
-    else if (state_q == STATE_LOOKUP && (|mem_wr_m_q))
-        tag0_write_m_r = tag0_hit_m_w;
-    // Write - write after refill
-    else if (state_q == STATE_WRITE)
-        tag0_write_m_r = (replace_way_q == 0);
-    // Write - mark entry as dirty
-    else if (state_q == STATE_EVICT_WAIT && pmem_ack_w)
-        tag0_write_m_r = (replace_way_q == 0);
-    // Line refill
-    else if (state_q == STATE_REFILL)
-        tag0_write_m_r = pmem_ack_w && pmem_last_w && (replace_way_q == 0);
-    // Invalidate - line matches address - invalidate
-    else if (state_q == STATE_INVALIDATE)
-        tag0_write_m_r = tag0_hit_m_w;
+wire [DCACHE_NUM_WAYS-1:0]                       tag_valid_m_w;
+wire [DCACHE_NUM_WAYS-1:0]                       tag_dirty_m_w;
+wire [(DCACHE_NUM_WAYS*CACHE_TAG_ADDR_BITS)-1:0] tag_addr_bits_m_w;
+wire [DCACHE_NUM_WAYS-1:0]                       tag_hit_m_w;
+
+genvar g_way;
+generate
+for (g_way = 0; g_way < DCACHE_NUM_WAYS; g_way = g_way + 1)
+begin : TAG_WAY
+    wire [CACHE_TAG_DATA_W-1:0] tag_data_out_m_w;
+
+    dcache_core_tag_ram
+    #(
+         .ADDR_W(DCACHE_TAG_REQ_LINE_W)
+        ,.DATA_W(CACHE_TAG_DATA_W)
+    )
+    u_tag
+    (
+      .clk0_i(clk_i),
+      .rst0_i(rst_i),
+      .clk1_i(clk_i),
+      .rst1_i(rst_i),
+
+      // Read
+      .addr0_i(tag_addr_x_r),
+      .data0_o(tag_data_out_m_w),
+
+      // Write
+      .addr1_i(tag_addr_m_r),
+      .data1_i(tag_data_in_m_r),
+      .wr1_i(tag_write_m_r[g_way])
+    );
+
+    assign tag_valid_m_w[g_way] = tag_data_out_m_w[CACHE_TAG_VALID_BIT];
+    assign tag_dirty_m_w[g_way] = tag_data_out_m_w[CACHE_TAG_DIRTY_BIT];
+    assign tag_addr_bits_m_w[(g_way*CACHE_TAG_ADDR_BITS) +: CACHE_TAG_ADDR_BITS] = tag_data_out_m_w[`CACHE_TAG_ADDR_RNG];
+
+    // Tag hit?
+    assign tag_hit_m_w[g_way] = tag_valid_m_w[g_way] ? (tag_data_out_m_w[`CACHE_TAG_ADDR_RNG] == req_addr_tag_cmp_m_w) : 1'b0;
 end
+endgenerate
 
-wire [CACHE_TAG_DATA_W-1:0] tag0_data_out_m_w;
+wire tag_hit_any_m_w = |tag_hit_m_w;
 
-dcache_core_tag_ram
-u_tag0
-(
-  .clk0_i(clk_i),
-  .rst0_i(rst_i),
-  .clk1_i(clk_i),
-  .rst1_i(rst_i),
-
-  // Read
-  .addr0_i(tag_addr_x_r),
-  .data0_o(tag0_data_out_m_w),
-
-  // Write
-  .addr1_i(tag_addr_m_r),
-  .data1_i(tag_data_in_m_r),
-  .wr1_i(tag0_write_m_r)
-);
-
-wire                           tag0_valid_m_w     = tag0_data_out_m_w[CACHE_TAG_VALID_BIT];
-wire                           tag0_dirty_m_w     = tag0_data_out_m_w[CACHE_TAG_DIRTY_BIT];
-wire [CACHE_TAG_ADDR_BITS-1:0] tag0_addr_bits_m_w = tag0_data_out_m_w[`CACHE_TAG_ADDR_RNG];
+assign tag_hit_and_dirty_m_w = |(tag_hit_m_w & tag_dirty_m_w);
 
-// Tag hit?
-wire                           tag0_hit_m_w = tag0_valid_m_w ? (tag0_addr_bits_m_w == req_addr_tag_cmp_m_w) : 1'b0;
+assign tag_dirty_any_m_w = |(tag_valid_m_w & tag_dirty_m_w);
 
-// Tag RAM write enable (way 1)
-reg tag1_write_m_r;
+// Way which hit on the current lookup
+reg [DCACHE_NUM_WAYS_W-1:0] hit_way_r;
+integer i1;
 always @ *
 begin
-    tag1_write_m_r = 1'b0;
-
-    // Cache flush (reset)
-    if (state_q == STATE_RESET)
-        tag1_write_m_r = 1'b1;
-    // Cache flush
-    else if (state_q == STATE_FLUSH)
-        tag1_write_m_r = !tag_dirty_any_m_w;
-    // Write - hit, mark as dirty
-    else if (state_q == STATE_LOOKUP && (|mem_wr_m_q))
-        tag1_write_m_r = tag1_hit_m_w;
-    // Write - write after refill
-    else if (state_q == STATE_WRITE)
-        tag1_write_m_r = (replace_way_q == 1);
-    // Write - mark entry as dirty
-    else if (state_q == STATE_EVICT_WAIT && pmem_ack_w)
-        tag1_write_m_r = (replace_way_q == 1);
-    // Line refill
-    else if (state_q == STATE_REFILL)
-        tag1_write_m_r = pmem_ack_w && pmem_last_w && (replace_way_q == 1);
-    // Invalidate - line matches address - invalidate
-    else if (state_q == STATE_INVALIDATE)
-        tag1_write_m_r = tag1_hit_m_w;
+    hit_way_r = {DCACHE_NUM_WAYS_W{1'b0}};
+    for (i1 = 0; i1 < DCACHE_NUM_WAYS; i1 = i1 + 1)
+        if (tag_hit_m_w[i1])
+/* verilator lint_off WIDTH */
+            hit_way_r = i1;
+/* verilator lint_on WIDTH */
 end
 
-wire [CACHE_TAG_DATA_W-1:0] tag1_data_out_m_w;
-
-dcache_core_tag_ram
-u_tag1
-(
-  .clk0_i(clk_i),
-  .rst0_i(rst_i),
-  .clk1_i(clk_i),
-  .rst1_i(rst_i),
-
-  // Read
-  .addr0_i(tag_addr_x_r),
-  .data0_o(tag1_data_out_m_w),
-
-  // Write
-  .addr1_i(tag_addr_m_r),
-  .data1_i(tag_data_in_m_r),
-  .wr1_i(tag1_write_m_r)
-);
-
-wire                           tag1_valid_m_w     = tag1_data_out_m_w[CACHE_TAG_VALID_BIT];
-wire                           tag1_dirty_m_w     = tag1_data_out_m_w[CACHE_TAG_DIRTY_BIT];
-wire [CACHE_TAG_ADDR_BITS-1:0] tag1_addr_bits_m_w = tag1_data_out_m_w[`CACHE_TAG_ADDR_RNG];
-
-// Tag hit?
-wire                           tag1_hit_m_w = tag1_valid_m_w ? (tag1_addr_bits_m_w == req_addr_tag_cmp_m_w) : 1'b0;
-
-
-wire tag_hit_any_m_w = 1'b0
-                   | tag0_hit_m_w
-                   | tag1_hit_m_w
-                    ;
-
-assign tag_hit_and_dirty_m_w = 1'b0
-                   | (tag0_hit_m_w & tag0_dirty_m_w)
-                   | (tag1_hit_m_w & tag1_dirty_m_w)
-                    ;
-
-assign tag_dirty_any_m_w = 1'b0
-                   | (tag0_valid_m_w & tag0_dirty_m_w)
-                   | (tag1_valid_m_w & tag1_dirty_m_w)
-                    ;
-
 localparam EVICT_ADDR_W = 32 - DCACHE_LINE_SIZE_W;
-reg        evict_way_r;
-reg [31:0] evict_data_r;
-reg [EVICT_ADDR_W-1:0] evict_addr_r;
+reg                           evict_way_r;
+reg [31:0]                    evict_data_r;
+reg [CACHE_TAG_ADDR_BITS-1:0] evict_tag_r;
+integer i2;
 always @ *
 begin
     evict_way_r  = 1'b0;
-    evict_addr_r = flushing_q ? {tag0_addr_bits_m_w, flush_addr_q} :
-                                {tag0_addr_bits_m_w, mem_addr_m_q[`DCACHE_TAG_REQ_RNG]};
-    evict_data_r = data0_data_out_m_w;
+    evict_tag_r  = tag_addr_bits_m_w[CACHE_TAG_ADDR_BITS-1:0];
+    evict_data_r = data_out_m_w[31:0];
 
-    case (replace_way_q)
-        1'd0:
-        begin
-            evict_way_r  = tag0_valid_m_w && tag0_dirty_m_w;
-            evict_addr_r = flushing_q ? {tag0_addr_bits_m_w, flush_addr_q} :
-                                        {tag0_addr_bits_m_w, mem_addr_m_q[`DCACHE_TAG_REQ_RNG]};
-            evict_data_r = data0_data_out_m_w;
-        end
-        1'd1:
+    for (i2 = 0; i2 < DCACHE_NUM_WAYS; i2 = i2 + 1)
+    begin
+/* verilator lint_off WIDTH */
+        if (replace_way_w == i2)
+/* verilator lint_on WIDTH */
         begin
-            evict_way_r  = tag1_valid_m_w && tag1_dirty_m_w;
-            evict_addr_r = flushing_q ? {tag1_addr_bits_m_w, flush_addr_q} :
-                                        {tag1_addr_bits_m_w, mem_addr_m_q[`DCACHE_TAG_REQ_RNG]};
-            evict_data_r = data1_data_out_m_w;
+            evict_way_r  = tag_valid_m_w[i2] && tag_dirty_m_w[i2];
+            evict_tag_r  = tag_addr_bits_m_w[(i2*CACHE_TAG_ADDR_BITS) +: CACHE_TAG_ADDR_BITS];
+            evict_data_r = data_out_m_w[(i2*32) +: 32];
         end
-    endcase
+    end
 end
 assign                  evict_way_w  = (flushing_q || !tag_hit_any_m_w) && evict_way_r;
-wire [EVICT_ADDR_W-1:0] evict_addr_w = evict_addr_r;
+wire [EVICT_ADDR_W-1:0] evict_addr_w = flushing_q ? {evict_tag_r, flush_addr_q} :
+                                                    {evict_tag_r, mem_addr_m_q[`DCACHE_TAG_REQ_RNG]};
 wire [31:0]             evict_data_w = evict_data_r;
 
 //-----------------------------------------------------------------
 // DATA RAMS
 //-----------------------------------------------------------------
-// Data addressing
-localparam CACHE_DATA_ADDR_W = DCACHE_LINE_ADDR_W+DCACHE_LINE_SIZE_W-2;
 
 
 reg [CACHE_DATA_ADDR_W-1:0] data_addr_x_r;
 reg [CACHE_DATA_ADDR_W-1:0] data_addr_m_r;
 reg [CACHE_DATA_ADDR_W-1:0] data_write_addr_q;
 
-// Data RAM refill write address
+// Data RAM refill write address (refill starts at the critical word, wraps within the line)
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
     data_write_addr_q <= {(CACHE_DATA_ADDR_W){1'b0}};
@@ -472,19 +621,27 @@ else if (state_q != STATE_REFILL && next_state_r == STATE_REFILL)
     data_write_addr_q <= pmem_addr_w[CACHE_DATA_ADDR_W+2-1:2];
 else if (state_q != STATE_EVICT && next_state_r == STATE_EVICT)
     data_write_addr_q <= data_addr_m_r + 1;
+else if (state_q != STATE_ZERO && next_state_r == STATE_ZERO)
+    data_write_addr_q <= {mem_addr_m_q[`DCACHE_TAG_REQ_RNG], {(DCACHE_LINE_SIZE_W-2){1'b0}}};
 else if (state_q == STATE_REFILL && pmem_ack_w)
-    data_write_addr_q <= data_write_addr_q + 1;
+    data_write_addr_q <= {data_write_addr_q[CACHE_DATA_ADDR_W-1:DCACHE_LINE_SIZE_W-2],
+                          data_write_addr_q[DCACHE_LINE_SIZE_W-3:0] + 1'b1};
 else if (state_q == STATE_EVICT && pmem_accept_w)
     data_write_addr_q <= data_write_addr_q + 1;
+else if (state_q == STATE_ZERO)
+    data_write_addr_q <= data_write_addr_q + 1;
+
+// Final word of the line being zeroed
+assign zero_last_w = (state_q == STATE_ZERO) && (&data_write_addr_q[DCACHE_LINE_SIZE_W-3:0]);
 
 // Data RAM address
 always @ *
 begin
-    data_addr_x_r = mem_addr_i[CACHE_DATA_ADDR_W+2-1:2];
+    data_addr_x_r = req_addr_x_w[CACHE_DATA_ADDR_W+2-1:2];
     data_addr_m_r = mem_addr_m_q[CACHE_DATA_ADDR_W+2-1:2];
 
-    // Line refill / evict
-    if (state_q == STATE_REFILL || state_q == STATE_EVICT)
+    // Line refill / evict / zero
+    if (state_q == STATE_REFILL || state_q == STATE_EVICT || state_q == STATE_ZERO)
     begin
         data_addr_x_r = data_write_addr_q;
         data_addr_m_r = data_addr_x_r;
@@ -499,90 +656,86 @@ begin
         data_addr_x_r = {mem_addr_m_q[`DCACHE_TAG_REQ_RNG], {(DCACHE_LINE_SIZE_W-2){1'b0}}};
         data_addr_m_r = data_addr_x_r;
     end
-    // Lookup post refill
-    else if (state_q == STATE_READ)
+    // Lookup held - re-read the current request's word
+    else if (state_q == STATE_LOOKUP && lookup_stall_w)
     begin
         data_addr_x_r = mem_addr_m_q[CACHE_DATA_ADDR_W+2-1:2];
+        data_addr_m_r = mem_addr_m_q[CACHE_DATA_ADDR_W+2-1:2];
     end
     // Possible line update on write
     else
         data_addr_m_r = mem_addr_m_q[CACHE_DATA_ADDR_W+2-1:2];
-end
 
-
-// Data RAM write enable (way 0)
-reg [3:0] data0_write_m_r;
-always @ *
-begin
-    data0_write_m_r = 4'b0;
-
-    if (state_q == STATE_REFILL)
-        data0_write_m_r = (pmem_ack_w && replace_way_q == 0) ? 4'b1111 : 4'b0000;
-    else if (state_q == STATE_WRITE || state_q == STATE_LOOKUP)
-        data0_write_m_r = mem_wr_m_q & {4{tag0_hit_m_w}};
+    // Line fill (MSHR) owns the write port
+    if (mshr_beat_w)
+        data_addr_m_r = mshr_data_addr_w;
 end
 
-wire [31:0] data0_data_out_m_w;
-wire [31:0] data0_data_in_m_w = (state_q == STATE_REFILL) ? pmem_read_data_w : mem_data_m_q;
-
-dcache_core_data_ram
-u_data0
-(
-  .clk0_i(clk_i),
-  .rst0_i(rst_i),
-  .clk1_i(clk_i),
-  .rst1_i(rst_i),
-
-  // Read
-  .addr0_i(data_addr_x_r),
-  .data0_i(32'b0),
-  .wr0_i(4'b0),
-  .data0_o(data0_data_out_m_w),
-
-  // Write
-  .addr1_i(data_addr_m_r),
-  .data1_i(data0_data_in_m_w),
-  .wr1_i(data0_write_m_r),
-  .data1_o()
-);
 
-
-// Data RAM write enable (way 1)
-reg [3:0] data1_write_m_r;
+// Refill data - a write miss is merged into the critical word as it arrives
+reg [31:0] refill_data_r;
 always @ *
 begin
-    data1_write_m_r = 4'b0;
+    refill_data_r = pmem_read_data_w;
 
-    if (state_q == STATE_REFILL)
-        data1_write_m_r = (pmem_ack_w && replace_way_q == 1) ? 4'b1111 : 4'b0000;
-    else if (state_q == STATE_WRITE || state_q == STATE_LOOKUP)
-        data1_write_m_r = mem_wr_m_q & {4{tag1_hit_m_w}};
+    if (refill_ack_w)
+    begin
+        if (mem_wr_m_q[0]) refill_data_r[7:0]   = mem_data_m_q[7:0];
+        if (mem_wr_m_q[1]) refill_data_r[15:8]  = mem_data_m_q[15:8];
+        if (mem_wr_m_q[2]) refill_data_r[23:16] = mem_data_m_q[23:16];
+        if (mem_wr_m_q[3]) refill_data_r[31:24] = mem_data_m_q[31:24];
+    end
 end
 
-wire [31:0] data1_data_out_m_w;
-wire [31:0] data1_data_in_m_w = (state_q == STATE_REFILL) ? pmem_read_data_w : mem_data_m_q;
-
-dcache_core_data_ram
-u_data1
-(
-  .clk0_i(clk_i),
-  .rst0_i(rst_i),
-  .clk1_i(clk_i),
-  .rst1_i(rst_i),
-
-  // Read
-  .addr0_i(data_addr_x_r),
-  .data0_i(32'b0),
-  .wr0_i(4'b0),
-  .data0_o(data1_data_out_m_w),
-
-  // Write
-  .addr1_i(data_addr_m_r),
-  .data1_i(data1_data_in_m_w),
-  .wr1_i(data1_write_m_r),
-  .data1_o()
-);
+// Data RAM (per way)
+wire [31:0] data_in_m_w = (state_q == STATE_REFILL) ? refill_data_r :
+                          (state_q == STATE_ZERO)   ? 32'b0         :
+                          mshr_beat_w                ? mshr_data_w   : mem_data_m_q;
+
+generate
+for (g_way = 0; g_way < DCACHE_NUM_WAYS; g_way = g_way + 1)
+begin : DATA_WAY
+    // Data RAM write enable
+    reg [3:0] data_write_m_r;
+    always @ *
+    begin
+        data_write_m_r = 4'b0;
+
+        if (state_q == STATE_REFILL)
+            data_write_m_r = (pmem_ack_w && replace_way_q == g_way) ? 4'b1111 : 4'b0000;
+        else if (state_q == STATE_ZERO)
+            data_write_m_r = (replace_way_q == g_way) ? 4'b1111 : 4'b0000;
+        else if (mshr_beat_w)
+            data_write_m_r = (mshr_way_w == g_way) ? 4'b1111 : 4'b0000;
+        else if (state_q == STATE_LOOKUP)
+            data_write_m_r = mem_wr_m_q & {4{tag_hit_m_w[g_way] && !lookup_stall_w}};
+    end
 
+    dcache_core_data_ram
+    #(
+         .ADDR_W(CACHE_DATA_ADDR_W)
+    )
+    u_data
+    (
+      .clk0_i(clk_i),
+      .rst0_i(rst_i),
+      .clk1_i(clk_i),
+      .rst1_i(rst_i),
+
+      // Read
+      .addr0_i(data_addr_x_r),
+      .data0_i(32'b0),
+      .wr0_i(4'b0),
+      .data0_o(data_out_m_w[(g_way*32) +: 32]),
+
+      // Write
+      .addr1_i(data_addr_m_r),
+      .data1_i(data_in_m_w),
+      .wr1_i(data_write_m_r),
+      .data1_o()
+    );
+end
+endgenerate
 
 //-----------------------------------------------------------------
 // Flush counter
@@ -617,45 +770,337 @@ else if (flush_addr_q == {(DCACHE_TAG_REQ_LINE_W){1'b1}})
 //-----------------------------------------------------------------
 // Replacement Policy
 //----------------------------------------------------------------- 
-// Using random replacement policy - this way we cycle through the ways
-// when needing to replace a line.
+// replace_way_q selects the way to evict / refill once a miss has been
+// detected, and walks the ways when flushing the cache.
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
-    replace_way_q <= 0;
-else if (state_q == STATE_WRITE || state_q == STATE_READ)
+    replace_way_q <= {DCACHE_NUM_WAYS_W{1'b0}};
+else if ((state_q == STATE_REFILL || state_q == STATE_ZERO) && next_state_r == STATE_LOOKUP)
     replace_way_q <= replace_way_q + 1;
+else if (mshr_alloc_w)
+    replace_way_q <= replace_way_w + 1;
+else if (state_q == STATE_LOOKUP && (next_state_r == STATE_EVICT || next_state_r == STATE_REFILL))
+    replace_way_q <= replace_way_w;
+// Line zero - zero the hit way in place, else allocate the (clean) victim
+else if (state_q == STATE_LOOKUP && next_state_r == STATE_ZERO)
+    replace_way_q <= tag_hit_any_m_w ? hit_way_r : replace_way_w;
 else if (flushing_q && tag_dirty_any_m_w && !evict_way_w && state_q != STATE_FLUSH_ADDR)
     replace_way_q <= replace_way_q + 1;
 else if (state_q == STATE_EVICT_WAIT && next_state_r == STATE_FLUSH_ADDR)
-    replace_way_q <= 0;
+    replace_way_q <= {DCACHE_NUM_WAYS_W{1'b0}};
 else if (state_q == STATE_FLUSH && next_state_r == STATE_LOOKUP)
-    replace_way_q <= 0;
+    replace_way_q <= {DCACHE_NUM_WAYS_W{1'b0}};
 else if (state_q == STATE_LOOKUP && next_state_r == STATE_FLUSH_ADDR)
-    replace_way_q <= 0;
+    replace_way_q <= {DCACHE_NUM_WAYS_W{1'b0}};
 else if (state_q == STATE_WRITEBACK)
-begin
-    case (1'b1)
-    tag0_hit_m_w: replace_way_q <= 0;
-    tag1_hit_m_w: replace_way_q <= 1;
-    endcase
+    replace_way_q <= hit_way_r;
+
+generate
+if (DCACHE_PLRU_ENABLE)
+begin : PLRU
+    // Tree pseudo-LRU - one bit per internal tree node per line (node 0 unused).
+    // A node bit of 0 points the victim search to the lower half of the ways.
+    reg [DCACHE_NUM_WAYS-1:0] plru_q[DCACHE_NUM_LINES-1:0];
+
+    function [DCACHE_NUM_WAYS_W-1:0] plru_victim;
+        input [DCACHE_NUM_WAYS-1:0] tree;
+        integer lvl;
+        integer node;
+    begin
+        node = 1;
+        for (lvl = 0; lvl < DCACHE_NUM_WAYS_W; lvl = lvl + 1)
+            node = (node * 2) + tree[node];
+/* verilator lint_off WIDTH */
+        plru_victim = node - DCACHE_NUM_WAYS;
+/* verilator lint_on WIDTH */
+    end
+    endfunction
+
+    function [DCACHE_NUM_WAYS-1:0] plru_touch;
+        input [DCACHE_NUM_WAYS-1:0]   tree;
+        input [DCACHE_NUM_WAYS_W-1:0] way;
+        integer lvl;
+        integer node;
+    begin
+        plru_touch = tree;
+        node       = 1;
+        for (lvl = DCACHE_NUM_WAYS_W-1; lvl >= 0; lvl = lvl - 1)
+        begin
+            // Point away from the most recently used way
+            plru_touch[node] = ~way[lvl];
+            node             = (node * 2) + way[lvl];
+        end
+    end
+    endfunction
+
+    wire [DCACHE_TAG_REQ_LINE_W-1:0] lookup_line_w = mem_addr_m_q[`DCACHE_TAG_REQ_RNG];
+    wire [DCACHE_TAG_REQ_LINE_W-1:0] refill_line_w = mshr_beat_w ? mshr_addr_w[`DCACHE_TAG_REQ_RNG] :
+                                                                   refill_addr_q[`DCACHE_TAG_REQ_RNG];
+    wire [DCACHE_NUM_WAYS_W-1:0]     refill_way_w  = mshr_beat_w ? mshr_way_w : replace_way_q;
+
+    integer i3;
+    always @ (posedge clk_i or posedge rst_i)
+    if (rst_i)
+    begin
+        for (i3 = 0; i3 < DCACHE_NUM_LINES; i3 = i3 + 1)
+            plru_q[i3] <= {DCACHE_NUM_WAYS{1'b0}};
+    end
+    // Line filled - now most recently used
+    else if ((state_q == STATE_REFILL && pmem_ack_w && pmem_last_w) || (mshr_beat_w && mshr_last_w))
+        plru_q[refill_line_w] <= plru_touch(plru_q[refill_line_w], refill_way_w);
+    // Line zeroed
+    else if (zero_last_w)
+        plru_q[lookup_line_w] <= plru_touch(plru_q[lookup_line_w], replace_way_q);
+    // Lookup hit
+    else if (state_q == STATE_LOOKUP && (mem_rd_m_q || (|mem_wr_m_q)) && tag_hit_any_m_w && !lookup_stall_w && !mem_pf_m_q)
+        plru_q[lookup_line_w] <= plru_touch(plru_q[lookup_line_w], hit_way_r);
+
+    // Least recently used way of the line being looked up
+    assign replace_way_w = (state_q == STATE_LOOKUP) ? plru_victim(plru_q[lookup_line_w]) : replace_way_q;
+end
+else
+begin : RANDOM
+    // Using random replacement policy - this way we cycle through the ways
+    // when needing to replace a line.
+    assign replace_way_w = replace_way_q;
 end
+endgenerate
+
+//-----------------------------------------------------------------
+// Miss Status Holding Registers (non-blocking operation)
+//-----------------------------------------------------------------
+wire lookup_req_w  = mem_rd_m_q || (|mem_wr_m_q);
+wire lookup_miss_w = lookup_req_w && !tag_hit_any_m_w;
+
+generate
+if (DCACHE_NON_BLOCKING)
+begin : MSHR
+    reg [DCACHE_NUM_MSHR-1:0]    mshr_valid_q;
+    reg [DCACHE_NUM_MSHR-1:0]    mshr_load_q;
+    reg [DCACHE_NUM_MSHR-1:0]    mshr_first_q;
+    reg [31:0]                   mshr_addr_q[DCACHE_NUM_MSHR-1:0];
+    reg [DCACHE_NUM_WAYS_W-1:0]  mshr_way_q[DCACHE_NUM_MSHR-1:0];
+    reg [3:0]                    mshr_wr_q[DCACHE_NUM_MSHR-1:0];
+    reg [31:0]                   mshr_data_q[DCACHE_NUM_MSHR-1:0];
+    reg [DCACHE_LINE_SIZE_W-3:0] mshr_word_q[DCACHE_NUM_MSHR-1:0];
+    reg [DCACHE_LINE_SIZE_W-3:0] mshr_cnt_q[DCACHE_NUM_MSHR-1:0];
+    reg [DCACHE_NUM_MSHR-1:0]    mshr_err_q;
+    reg                          load_wait_q;
+
+    // Response ID selects the MSHR being filled
+    wire [DCACHE_NUM_MSHR_W-1:0] resp_idx_w = pmem_resp_id_w[DCACHE_NUM_MSHR_W-1:0];
+
+    // Free entry / set conflict detection
+    reg [DCACHE_NUM_MSHR_W-1:0] alloc_idx_r;
+    reg                         free_r;
+    reg                         set_hit_r;
+    integer i5;
+    always @ *
+    begin
+        alloc_idx_r = {DCACHE_NUM_MSHR_W{1'b0}};
+        free_r      = 1'b0;
+        set_hit_r   = 1'b0;
+
+        for (i5 = DCACHE_NUM_MSHR-1; i5 >= 0; i5 = i5 - 1)
+        begin
+            if (!mshr_valid_q[i5])
+            begin
+/* verilator lint_off WIDTH */
+                alloc_idx_r = i5;
+/* verilator lint_on WIDTH */
+                free_r      = 1'b1;
+            end
+
+            // Line in this set being filled - the victim way's contents are in flux
+            if (mshr_valid_q[i5] && mshr_addr_q[i5][`DCACHE_TAG_REQ_RNG] == mem_addr_m_q[`DCACHE_TAG_REQ_RNG])
+                set_hit_r   = 1'b1;
+        end
+    end
+
+    assign mshr_busy_w      = |mshr_valid_q;
+    assign mshr_set_hit_w   = set_hit_r;
+
+    // Clean victim - request the line fill with this MSHR's ID
+    assign mshr_alloc_req_w = (state_q == STATE_LOOKUP) && lookup_miss_w && !evict_way_w && free_r &&
+                              !mshr_beat_w && !load_wait_q && !mshr_set_hit_w;
+    assign mshr_alloc_w     = mshr_alloc_req_w && pmem_accept_w;
+/* verilator lint_off WIDTH */
+    assign pmem_id_w        = mshr_alloc_req_w ? alloc_idx_r : 4'b0;
+/* verilator lint_on WIDTH */
+
+    // Refill beat
+    assign mshr_beat_w      = pmem_ack_w && mshr_busy_w;
+    assign mshr_last_w      = (mshr_cnt_q[resp_idx_w] == {(DCACHE_LINE_SIZE_W-2){1'b1}});
+    assign mshr_load_ack_w  = mshr_beat_w && mshr_first_q[resp_idx_w] && mshr_load_q[resp_idx_w];
+    assign mshr_dirty_w     = |mshr_wr_q[resp_idx_w];
+    assign mshr_error_w     = mshr_err_q[resp_idx_w] | pmem_error_w;
+    assign mshr_addr_w      = mshr_addr_q[resp_idx_w];
+    assign mshr_way_w       = mshr_way_q[resp_idx_w];
+    assign mshr_data_addr_w = {mshr_addr_q[resp_idx_w][`DCACHE_TAG_REQ_RNG], mshr_word_q[resp_idx_w]};
+
+    // Store miss merged into the critical word as it arrives
+    reg [31:0] fill_data_r;
+    always @ *
+    begin
+        fill_data_r = pmem_read_data_w;
+
+        if (mshr_first_q[resp_idx_w])
+        begin
+            if (mshr_wr_q[resp_idx_w][0]) fill_data_r[7:0]   = mshr_data_q[resp_idx_w][7:0];
+            if (mshr_wr_q[resp_idx_w][1]) fill_data_r[15:8]  = mshr_data_q[resp_idx_w][15:8];
+            if (mshr_wr_q[resp_idx_w][2]) fill_data_r[23:16] = mshr_data_q[resp_idx_w][23:16];
+            if (mshr_wr_q[resp_idx_w][3]) fill_data_r[31:24] = mshr_data_q[resp_idx_w][31:24];
+        end
+    end
+
+    assign mshr_data_w      = fill_data_r;
+
+    integer i6;
+    always @ (posedge clk_i or posedge rst_i)
+    if (rst_i)
+    begin
+        mshr_valid_q <= {DCACHE_NUM_MSHR{1'b0}};
+        mshr_load_q  <= {DCACHE_NUM_MSHR{1'b0}};
+        mshr_first_q <= {DCACHE_NUM_MSHR{1'b0}};
+        mshr_err_q   <= {DCACHE_NUM_MSHR{1'b0}};
+
+        for (i6 = 0; i6 < DCACHE_NUM_MSHR; i6 = i6 + 1)
+        begin
+            mshr_addr_q[i6] <= 32'b0;
+            mshr_way_q[i6]  <= {DCACHE_NUM_WAYS_W{1'b0}};
+            mshr_wr_q[i6]   <= 4'b0;
+            mshr_data_q[i6] <= 32'b0;
+            mshr_word_q[i6] <= {(DCACHE_LINE_SIZE_W-2){1'b0}};
+            mshr_cnt_q[i6]  <= {(DCACHE_LINE_SIZE_W-2){1'b0}};
+        end
+    end
+    else
+    begin
+        // Allocate (never on a refill beat cycle)
+        if (mshr_alloc_w)
+        begin
+            mshr_valid_q[alloc_idx_r] <= 1'b1;
+            mshr_load_q[alloc_idx_r]  <= mem_rd_m_q && !mem_pf_m_q;
+            mshr_first_q[alloc_idx_r] <= 1'b1;
+            mshr_err_q[alloc_idx_r]   <= 1'b0;
+            mshr_addr_q[alloc_idx_r]  <= mem_addr_m_q;
+            mshr_way_q[alloc_idx_r]   <= replace_way_w;
+            mshr_wr_q[alloc_idx_r]    <= mem_wr_m_q;
+            mshr_data_q[alloc_idx_r]  <= mem_data_m_q;
+            mshr_word_q[alloc_idx_r]  <= mem_addr_m_q[DCACHE_LINE_SIZE_W-1:2];
+            mshr_cnt_q[alloc_idx_r]   <= {(DCACHE_LINE_SIZE_W-2){1'b0}};
+        end
+        // Refill beat (WRAP burst - wraps within the line)
+        else if (mshr_beat_w)
+        begin
+            mshr_first_q[resp_idx_w] <= 1'b0;
+            mshr_err_q[resp_idx_w]   <= mshr_error_w;
+            mshr_word_q[resp_idx_w]  <= mshr_word_q[resp_idx_w] + 1;
+            mshr_cnt_q[resp_idx_w]   <= mshr_cnt_q[resp_idx_w] + 1;
+
+            if (mshr_last_w)
+                mshr_valid_q[resp_idx_w] <= 1'b0;
+        end
+    end
+
+    // Load miss - hold the request until its critical word returns
+    always @ (posedge clk_i or posedge rst_i)
+    if (rst_i)
+        load_wait_q <= 1'b0;
+    else if (mshr_alloc_w && mem_rd_m_q && !mem_pf_m_q)
+        load_wait_q <= 1'b1;
+    else if (mshr_load_ack_w)
+        load_wait_q <= 1'b0;
+
+    // Hold the current lookup whilst a refill beat owns the RAM write ports,
+    // a load waits on its MSHR, the set has a fill outstanding, or the miss
+    // cannot be handed off yet.
+    assign lookup_stall_w   = (state_q == STATE_LOOKUP) &&
+                              (mshr_beat_w || load_wait_q || (lookup_req_w && mshr_set_hit_w) ||
+                               (lookup_miss_w && (evict_way_w ? mshr_busy_w : !mshr_alloc_w)));
+end
+else
+begin : BLOCKING
+    assign lookup_stall_w   = 1'b0;
+    assign mshr_busy_w      = 1'b0;
+    assign mshr_set_hit_w   = 1'b0;
+    assign mshr_alloc_req_w = 1'b0;
+    assign mshr_alloc_w     = 1'b0;
+    assign mshr_beat_w      = 1'b0;
+    assign mshr_last_w      = 1'b0;
+    assign mshr_load_ack_w  = 1'b0;
+    assign mshr_dirty_w     = 1'b0;
+    assign mshr_error_w     = 1'b0;
+    assign mshr_addr_w      = 32'b0;
+    assign mshr_data_w      = 32'b0;
+    assign mshr_way_w       = {DCACHE_NUM_WAYS_W{1'b0}};
+    assign mshr_data_addr_w = {CACHE_DATA_ADDR_W{1'b0}};
+    assign pmem_id_w        = 4'b0;
+end
+endgenerate
+
+//-----------------------------------------------------------------
+// Prefetcher
+//-----------------------------------------------------------------
+// Demand access looked up (excludes prefetches and held lookups)
+wire demand_lookup_w = (state_q == STATE_LOOKUP) && lookup_req_w && !mem_pf_m_q && !lookup_stall_w;
+
+generate
+if (DCACHE_PREFETCH)
+begin : PREFETCH
+    dcache_core_prefetch
+    #(
+         .LINE_SIZE_W(DCACHE_LINE_SIZE_W)
+        ,.NUM_ENTRIES(DCACHE_PREFETCH_ENTRIES)
+        ,.NUM_ENTRIES_W(DCACHE_PREFETCH_ENTRIES_W)
+    )
+    u_prefetch
+    (
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+
+        // Demand loads (training)
+        ,.train_valid_i(mem_rd_i && mem_accept_o)
+        ,.train_pc_i(mem_pc_i)
+        ,.train_addr_i(mem_addr_i)
+
+        // Demand lookup result
+        ,.lookup_valid_i(demand_lookup_w)
+        ,.lookup_addr_i(mem_addr_m_q)
+        ,.lookup_hit_i(tag_hit_any_m_w)
+
+        // Prefetch missed - line fill requested
+        ,.fill_i(mem_pf_m_q && (refill_request_w || mshr_alloc_w))
+        ,.fill_addr_i(mem_addr_m_q)
+
+        ,.pf_accept_i(pf_inject_w)
+        ,.pf_valid_o(pf_valid_w)
+        ,.pf_addr_o(pf_addr_w)
+    );
+end
+else
+begin : NO_PREFETCH
+    assign pf_valid_w = 1'b0;
+    assign pf_addr_w  = 32'b0;
+end
+endgenerate
 
 //-----------------------------------------------------------------
 // Output Result
 //-----------------------------------------------------------------
 // Data output mux
 reg [31:0] data_r;
+integer i4;
 always @ *
 begin
-    data_r = data0_data_out_m_w;
+    data_r = data_out_m_w[31:0];
 
-    case (1'b1)
-    tag0_hit_m_w: data_r = data0_data_out_m_w;
-    tag1_hit_m_w: data_r = data1_data_out_m_w;
-    endcase
+    for (i4 = 0; i4 < DCACHE_NUM_WAYS; i4 = i4 + 1)
+        if (tag_hit_m_w[i4])
+            data_r = data_out_m_w[(i4*32) +: 32];
 end
 
-assign mem_data_rd_o  = data_r;
+assign mem_data_rd_o  = (refill_ack_w || mshr_load_ack_w) ? pmem_read_data_w : data_r;
 
 //-----------------------------------------------------------------
 // Next State Logic
@@ -701,16 +1146,27 @@ begin
     //-----------------------------------------
     STATE_LOOKUP :
     begin
+        // Request held (line fill in progress / structural hazard)
+        if (lookup_stall_w)
+            ;
         // Previous access missed in the cache
-        if ((mem_rd_m_q || (mem_wr_m_q != 4'b0)) && !tag_hit_any_m_w)
+        else if ((mem_rd_m_q || (mem_wr_m_q != 4'b0)) && !tag_hit_any_m_w)
         begin
             // Evict dirty line first
             if (evict_way_w)
                 next_state_r = STATE_EVICT;
-            // Allocate line and fill
-            else
+            // Allocate line and fill (non-blocking: fill handed to an MSHR)
+            else if (!DCACHE_NON_BLOCKING)
                 next_state_r = STATE_REFILL;
         end
+        // Zero a line (evicting a dirty victim first, no refill)
+        else if (mem_zero_m_q)
+        begin
+            if (evict_way_w)
+                next_state_r = STATE_EVICT;
+            else
+                next_state_r = STATE_ZERO;
+        end
         // Writeback a single line
         else if (mem_writeback_i && mem_accept_o)
             next_state_r = STATE_WRITEBACK;
@@ -718,7 +1174,7 @@ begin
         else if (mem_flush_i && mem_accept_o)
             next_state_r = STATE_FLUSH_ADDR;
         // Invalidate line (even if dirty)
-        else if (mem_invalidate_i && mem_accept_o)
+        else if (mem_invalidate_i && !mem_zero_w && mem_accept_o)
             next_state_r = STATE_INVALIDATE;
     end
     //-----------------------------------------
@@ -726,23 +1182,9 @@ begin
     //-----------------------------------------
     STATE_REFILL :
     begin
-        // End of refill
+        // End of refill (request already completed on the critical word)
         if (pmem_ack_w && pmem_last_w)
-        begin
-            // Refill reason was write
-            if (mem_wr_m_q != 4'b0)
-                next_state_r = STATE_WRITE;
-            // Refill reason was read
-            else
-                next_state_r = STATE_READ;
-        end
-    end
-    //-----------------------------------------
-    // STATE_WRITE/READ
-    //-----------------------------------------
-    STATE_WRITE, STATE_READ :
-    begin
-        next_state_r = STATE_LOOKUP;
+            next_state_r = STATE_LOOKUP;
     end
     //-----------------------------------------
     // STATE_EVICT
@@ -764,9 +1206,12 @@ begin
         // Evict due to flush
         else if (pmem_ack_w && flushing_q)
             next_state_r = STATE_FLUSH_ADDR;
-        // Write ack, start re-fill now
+        // Victim written back, zero the line
+        else if (pmem_ack_w && mem_zero_m_q)
+            next_state_r = STATE_ZERO;
+        // Write ack, start re-fill now (non-blocking: retry lookup to allocate an MSHR)
         else if (pmem_ack_w)
-            next_state_r = STATE_REFILL;
+            next_state_r = DCACHE_NON_BLOCKING ? STATE_LOOKUP : STATE_REFILL;
     end
     //-----------------------------------------
     // STATE_WRITEBACK: Writeback a cache line
@@ -776,7 +1221,9 @@ begin
         // Line is dirty - write back to memory
         if (tag_hit_and_dirty_m_w)
             next_state_r = STATE_EVICT;
-        // Line not dirty, carry on
+        // Line not dirty - invalidate it (line flush), else carry on
+        else if (mem_inval_m_q)
+            next_state_r = STATE_INVALIDATE;
         else
             next_state_r = STATE_LOOKUP;
     end
@@ -787,6 +1234,15 @@ begin
     begin
         next_state_r = STATE_LOOKUP;
     end
+    //-----------------------------------------
+    // STATE_ZERO: Zero a cache line
+    //-----------------------------------------
+    STATE_ZERO:
+    begin
+        // Final word written
+        if (zero_last_w)
+            next_state_r = STATE_LOOKUP;
+    end
     default:
         ;
    endcase
@@ -805,18 +1261,31 @@ always @ *
 begin
     mem_ack_r = 1'b0;
 
-    if (state_q == STATE_LOOKUP)
+    // Critical word of a load miss returned (MSHR)
+    if (mshr_load_ack_w)
+        mem_ack_r = 1'b1;
+    else if (state_q == STATE_LOOKUP && !lookup_stall_w)
     begin
         // Normal hit - read or write
         if ((mem_rd_m_q || (mem_wr_m_q != 4'b0)) && tag_hit_any_m_w)
             mem_ack_r = 1'b1;
+        // Store miss posted to an MSHR
+        else if (mshr_alloc_w && (|mem_wr_m_q))
+            mem_ack_r = 1'b1;
         // Flush, invalidate or writeback
         else if (mem_flush_m_q || mem_inval_m_q || mem_writeback_m_q)
             mem_ack_r = 1'b1;
     end
+    // Critical word of the refill
+    else if (refill_ack_w)
+        mem_ack_r = 1'b1;
+    // Line zeroed
+    else if (zero_last_w)
+        mem_ack_r = 1'b1;
 end
 
-assign mem_ack_o = mem_ack_r;
+// Prefetches are not acknowledged
+assign mem_ack_o = mem_ack_r & ~mem_pf_m_q;
 
 //-----------------------------------------------------------------
 // AXI Request
@@ -827,7 +1296,7 @@ reg pmem_wr0_q;
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
     pmem_rd_q   <= 1'b0;
-else if (pmem_rd_w)
+else if (refill_request_w || pmem_rd_q)
     pmem_rd_q   <= ~pmem_accept_w;
 
 always @ (posedge clk_i or posedge rst_i)
@@ -843,7 +1312,7 @@ always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
     pmem_len_q   <= 8'b0;
 else if (state_q != STATE_EVICT && next_state_r == STATE_EVICT)
-    pmem_len_q   <= 8'd7;
+    pmem_len_q   <= DCACHE_BURST_LEN;
 else if (pmem_rd_w && pmem_accept_w)
     pmem_len_q   <= pmem_len_w;
 else if (state_q == STATE_REFILL && pmem_ack_w)
@@ -890,28 +1359,44 @@ reg error_q;
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
     error_q   <= 1'b0;
-else if (pmem_ack_w && pmem_error_w)
+else if (refill_ack_w)
+    error_q   <= 1'b0;
+// Errors on the remainder of a refill are not attributed to later requests
+// (the line is left invalid, and a lost store is reported on fill_error_o)
+else if (pmem_ack_w && pmem_error_w && !(state_q == STATE_REFILL && refill_acked_q) && !mshr_beat_w)
     error_q   <= 1'b1;
 else if (mem_ack_o)
     error_q   <= 1'b0;
 
-assign mem_error_o = error_q;
+assign mem_error_o = error_q | ((refill_ack_w | mshr_load_ack_w) & pmem_error_w);
+
+// A store miss has already been acknowledged (merged into the critical word, or
+// posted to an MSHR) - if its line fill fails the store is lost with the line,
+// so report it once the fill completes (raised late by the core).
+wire refill_store_error_w = (state_q == STATE_REFILL) && pmem_ack_w && pmem_last_w && refill_dirty_q &&
+                            (refill_late_error_q || (pmem_error_w && refill_acked_q));
+wire mshr_store_error_w   = mshr_beat_w && mshr_last_w && mshr_dirty_w && mshr_error_w;
+
+assign fill_error_o      = refill_store_error_w | mshr_store_error_w;
+assign fill_error_addr_o = mshr_beat_w ? mshr_addr_w : refill_addr_q;
+
+// Memory port still in use after the request has been acknowledged
+assign mem_busy_o  = (state_q == STATE_REFILL) || mshr_busy_w || mem_pf_m_q;
 
 //-----------------------------------------------------------------
 // Outport
 //-----------------------------------------------------------------
-wire refill_request_w   = (state_q != STATE_REFILL && next_state_r == STATE_REFILL);
 wire evict_request_w    = (state_q == STATE_EVICT) && (evict_way_w || mem_writeback_m_q);
 
 // AXI Read channel
-assign pmem_rd_w         = (refill_request_w || pmem_rd_q);
+assign pmem_rd_w         = (refill_request_w || pmem_rd_q || mshr_alloc_req_w);
 assign pmem_wr_w         = (evict_request_w || (|pmem_wr_q)) ? 4'hF : 4'b0;
 assign pmem_addr_w       = (|pmem_len_w) ? 
-                           pmem_rd_w ? {mem_addr_m_q[31:DCACHE_LINE_SIZE_W], {(DCACHE_LINE_SIZE_W){1'b0}}} :
+                           pmem_rd_w ? {mem_addr_m_q[31:2], 2'b0} :
                            {evict_addr_w, {(DCACHE_LINE_SIZE_W){1'b0}}} :
                            pmem_addr_q;
 
-assign pmem_len_w        = (refill_request_w || pmem_rd_q || (state_q == STATE_EVICT && pmem_wr0_q)) ? 8'd7 : 8'd0;
+assign pmem_len_w        = (refill_request_w || pmem_rd_q || mshr_alloc_req_w || (state_q == STATE_EVICT && pmem_wr0_q)) ? DCACHE_BURST_LEN : 8'd0;
 assign pmem_write_data_w = (|pmem_wr_q) ? pmem_write_data_q : evict_data_w;
 
 assign outport_wr_o         = pmem_wr_w;
@@ -924,6 +1409,8 @@ assign pmem_accept_w        = outport_accept_i;
 assign pmem_ack_w           = outport_ack_i;
 assign pmem_error_w         = outport_error_i;
 assign pmem_read_data_w     = outport_read_data_i;
+assign pmem_resp_id_w       = outport_resp_id_i;
+assign outport_id_o         = pmem_id_w;
 
 //-------------------------------------------------------------------
 // Debug
@@ -944,10 +1431,6 @@ begin
         dbg_state = "FLUSH";
     STATE_LOOKUP:
         dbg_state = "LOOKUP";
-    STATE_READ:
-        dbg_state = "READ";
-    STATE_WRITE:
-        dbg_state = "WRITE";
     STATE_REFILL:
         dbg_state = "REFILL";
     STATE_EVICT:
@@ -958,11 +1441,40 @@ begin
         dbg_state = "INVAL";
     STATE_WRITEBACK:
         dbg_state = "WRITEBACK";
+    STATE_ZERO:
+        dbg_state = "ZERO";
     default:
         ;
     endcase
 end
 /* verilator lint_on WIDTH */
+
+reg [31:0] stat_access_q;
+reg [31:0] stat_hit_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    stat_access_q <= 32'b0;
+    stat_hit_q    <= 32'b0;
+end
+else if (demand_lookup_w)
+begin
+    stat_access_q <= stat_access_q + 32'd1;
+    if (tag_hit_any_m_w)
+        stat_hit_q <= stat_hit_q + 32'd1;
+end
+
+function [31:0] get_access_count; /*verilator public*/
+begin
+    get_access_count = stat_access_q;
+end
+endfunction
+function [31:0] get_hit_count; /*verilator public*/
+begin
+    get_hit_count = stat_hit_q;
+end
+endfunction
 `endif
 
 
@@ -24,16 +24,25 @@
 //-----------------------------------------------------------------
 
 module dcache_core_data_ram
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter ADDR_W           = 11
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk0_i
     ,input           rst0_i
-    ,input  [ 10:0]  addr0_i
+    ,input  [ADDR_W-1:0] addr0_i
     ,input  [ 31:0]  data0_i
     ,input  [  3:0]  wr0_i
     ,input           clk1_i
     ,input           rst1_i
-    ,input  [ 10:0]  addr1_i
+    ,input  [ADDR_W-1:0] addr1_i
     ,input  [ 31:0]  data1_i
     ,input  [  3:0]  wr1_i
 
@@ -45,11 +54,11 @@ module dcache_core_data_ram
 
 
 //-----------------------------------------------------------------
-// Dual Port RAM 8KB
+// Dual Port RAM ((2^ADDR_W) x 32)
 // Mode: Read First
 //-----------------------------------------------------------------
 /* verilator lint_off MULTIDRIVEN */
-reg [31:0]   ram [2047:0] /*verilator public*/;
+reg [31:0]   ram [(1 << ADDR_W)-1:0] /*verilator public*/;
 /* verilator lint_on MULTIDRIVEN */
 
 reg [31:0] ram_read0_q;
@@ -0,0 +1,334 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.6.0
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+
+module dcache_core_prefetch
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter LINE_SIZE_W      = 5
+    ,parameter NUM_ENTRIES      = 8
+    ,parameter NUM_ENTRIES_W    = 3
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input           train_valid_i
+    ,input  [ 31:0]  train_pc_i
+    ,input  [ 31:0]  train_addr_i
+    ,input           lookup_valid_i
+    ,input  [ 31:0]  lookup_addr_i
+    ,input           lookup_hit_i
+    ,input           fill_i
+    ,input  [ 31:0]  fill_addr_i
+    ,input           pf_accept_i
+
+    // Outputs
+    ,output          pf_valid_o
+    ,output [ 31:0]  pf_addr_o
+);
+
+//-----------------------------------------------------------------
+// Stride prefetching is trained on demand loads, indexed by the
+// PC of the load instruction.  Once the same stride has been seen
+// on consecutive accesses from a load, the line at addr + stride is
+// requested.  Next-line prefetching requests the following line on
+// a demand miss, or on the first demand hit to a prefetched line.
+// Prefetches never cross a 4KB page boundary (the cache sees physical
+// addresses, and the next page may not be memory at all).
+//
+// Lines which have been filled by a prefetch are remembered in a
+// small filter.  A demand hit to one of these counts as a useful
+// prefetch.  The ratio of useful to issued prefetches over a window
+// of demand accesses moves the throttle level up or down;
+//   0 - prefetching disabled (for one window)
+//   1 - stride prefetching only
+//   2 - stride and next-line prefetching
+//-----------------------------------------------------------------
+localparam LINE_ADDR_W      = 32 - LINE_SIZE_W;
+localparam FILTER_ENTRIES   = 8;
+localparam FILTER_ENTRIES_W = 3;
+
+localparam LEVEL_OFF        = 2'd0;
+localparam LEVEL_STRIDE     = 2'd1;
+localparam LEVEL_ALL        = 2'd2;
+
+reg [1:0] level_q;
+
+//-----------------------------------------------------------------
+// Stride table (direct mapped on load PC)
+//-----------------------------------------------------------------
+reg [NUM_ENTRIES-1:0] st_valid_q;
+reg [31:2]            st_pc_q[NUM_ENTRIES-1:0];
+reg [31:0]            st_addr_q[NUM_ENTRIES-1:0];
+reg [31:0]            st_stride_q[NUM_ENTRIES-1:0];
+reg [1:0]             st_conf_q[NUM_ENTRIES-1:0];
+
+wire [NUM_ENTRIES_W-1:0] st_idx_w    = train_pc_i[NUM_ENTRIES_W+2-1:2];
+wire                     st_hit_w    = st_valid_q[st_idx_w] && (st_pc_q[st_idx_w] == train_pc_i[31:2]);
+wire [31:0]              st_delta_w  = train_addr_i - st_addr_q[st_idx_w];
+wire                     st_match_w  = st_hit_w && (st_delta_w == st_stride_q[st_idx_w]) && (|st_delta_w);
+
+integer i0;
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    st_valid_q <= {NUM_ENTRIES{1'b0}};
+
+    for (i0 = 0; i0 < NUM_ENTRIES; i0 = i0 + 1)
+    begin
+        st_pc_q[i0]     <= 30'b0;
+        st_addr_q[i0]   <= 32'b0;
+        st_stride_q[i0] <= 32'b0;
+        st_conf_q[i0]   <= 2'b0;
+    end
+end
+else if (train_valid_i)
+begin
+    // New load - allocate entry
+    if (!st_hit_w)
+    begin
+        st_valid_q[st_idx_w]  <= 1'b1;
+        st_pc_q[st_idx_w]     <= train_pc_i[31:2];
+        st_addr_q[st_idx_w]   <= train_addr_i;
+        st_stride_q[st_idx_w] <= 32'b0;
+        st_conf_q[st_idx_w]   <= 2'b0;
+    end
+    else
+    begin
+        st_addr_q[st_idx_w] <= train_addr_i;
+
+        // Stride repeated - increase confidence
+        if (st_match_w)
+        begin
+            if (st_conf_q[st_idx_w] != 2'd3)
+                st_conf_q[st_idx_w] <= st_conf_q[st_idx_w] + 2'd1;
+        end
+        // Stride changed - lose confidence before learning the new stride
+        else if (st_conf_q[st_idx_w] != 2'd0)
+            st_conf_q[st_idx_w] <= st_conf_q[st_idx_w] - 2'd1;
+        else
+            st_stride_q[st_idx_w] <= st_delta_w;
+    end
+end
+
+wire [31:0] stride_addr_w = train_addr_i + st_delta_w;
+
+// Confident stride which moves onto another line (within the same 4KB page)
+wire stride_req_w = train_valid_i && st_match_w && (st_conf_q[st_idx_w] != 2'd0) &&
+                    (level_q != LEVEL_OFF) &&
+                    (stride_addr_w[31:LINE_SIZE_W] != train_addr_i[31:LINE_SIZE_W]) &&
+                    (stride_addr_w[31:12] == train_addr_i[31:12]);
+
+//-----------------------------------------------------------------
+// Prefetched line filter
+//-----------------------------------------------------------------
+reg [FILTER_ENTRIES-1:0]   flt_valid_q;
+reg [LINE_ADDR_W-1:0]      flt_line_q[FILTER_ENTRIES-1:0];
+reg [FILTER_ENTRIES_W-1:0] flt_ptr_q;
+
+reg                        useful_r;
+reg [FILTER_ENTRIES_W-1:0] useful_idx_r;
+integer i1;
+always @ *
+begin
+    useful_r     = 1'b0;
+    useful_idx_r = {FILTER_ENTRIES_W{1'b0}};
+
+    for (i1 = 0; i1 < FILTER_ENTRIES; i1 = i1 + 1)
+        if (flt_valid_q[i1] && flt_line_q[i1] == lookup_addr_i[31:LINE_SIZE_W])
+        begin
+            useful_r     = lookup_valid_i && lookup_hit_i;
+/* verilator lint_off WIDTH */
+            useful_idx_r = i1;
+/* verilator lint_on WIDTH */
+        end
+end
+
+integer i2;
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    flt_valid_q <= {FILTER_ENTRIES{1'b0}};
+    flt_ptr_q   <= {FILTER_ENTRIES_W{1'b0}};
+
+    for (i2 = 0; i2 < FILTER_ENTRIES; i2 = i2 + 1)
+        flt_line_q[i2] <= {LINE_ADDR_W{1'b0}};
+end
+else
+begin
+    // First demand access to a prefetched line
+    if (useful_r)
+        flt_valid_q[useful_idx_r] <= 1'b0;
+
+    // Prefetch line fill started (oldest entry replaced)
+    if (fill_i)
+    begin
+        flt_valid_q[flt_ptr_q] <= 1'b1;
+        flt_line_q[flt_ptr_q]  <= fill_addr_i[31:LINE_SIZE_W];
+        flt_ptr_q              <= flt_ptr_q + 1;
+    end
+end
+
+//-----------------------------------------------------------------
+// Next-line
+//-----------------------------------------------------------------
+wire [LINE_ADDR_W-1:0] next_line_w = lookup_addr_i[31:LINE_SIZE_W] + 1;
+
+wire next_req_w = (level_q == LEVEL_ALL) && lookup_valid_i && (!lookup_hit_i || useful_r) &&
+                  (next_line_w[LINE_ADDR_W-1:12-LINE_SIZE_W] == lookup_addr_i[31:12]);
+
+//-----------------------------------------------------------------
+// Request
+//-----------------------------------------------------------------
+reg                   pf_valid_q;
+reg [LINE_ADDR_W-1:0] pf_line_q;
+
+// Stride requests take priority over next-line
+wire                   cand_valid_w = stride_req_w || next_req_w;
+wire [LINE_ADDR_W-1:0] cand_line_w  = stride_req_w ? stride_addr_w[31:LINE_SIZE_W] : next_line_w;
+
+// Drop requests for lines recently prefetched or already pending
+reg cand_dup_r;
+integer i3;
+always @ *
+begin
+    cand_dup_r = pf_valid_q && (pf_line_q == cand_line_w);
+
+    for (i3 = 0; i3 < FILTER_ENTRIES; i3 = i3 + 1)
+        if (flt_valid_q[i3] && flt_line_q[i3] == cand_line_w)
+            cand_dup_r = 1'b1;
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    pf_valid_q <= 1'b0;
+    pf_line_q  <= {LINE_ADDR_W{1'b0}};
+end
+// Newest request replaces any not yet issued
+else if (cand_valid_w && !cand_dup_r)
+begin
+    pf_valid_q <= 1'b1;
+    pf_line_q  <= cand_line_w;
+end
+else if (pf_accept_i)
+    pf_valid_q <= 1'b0;
+
+assign pf_valid_o = pf_valid_q;
+assign pf_addr_o  = {pf_line_q, {LINE_SIZE_W{1'b0}}};
+
+//-----------------------------------------------------------------
+// Accuracy throttle
+//-----------------------------------------------------------------
+reg [5:0] win_count_q;
+reg [6:0] win_issued_q;
+reg [6:0] win_useful_q;
+
+wire win_end_w = lookup_valid_i && (win_count_q == 6'h3F);
+
+// Accurate: useful >= 3/4 issued, inaccurate: useful < 1/4 issued
+wire [8:0] useful_x4_w  = {win_useful_q, 2'b0};
+wire [8:0] issued_x3_w  = {1'b0, win_issued_q, 1'b0} + {2'b0, win_issued_q};
+wire       accurate_w   = (useful_x4_w >= issued_x3_w);
+wire       inaccurate_w = (useful_x4_w < {2'b0, win_issued_q});
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    level_q <= LEVEL_ALL;
+else if (win_end_w)
+begin
+    // Nothing issued - (re-)enable stride prefetching
+    if (win_issued_q == 7'b0)
+        level_q <= (level_q == LEVEL_OFF) ? LEVEL_STRIDE : level_q;
+    else if (accurate_w && level_q != LEVEL_ALL)
+        level_q <= level_q + 2'd1;
+    else if (inaccurate_w && level_q != LEVEL_OFF)
+        level_q <= level_q - 2'd1;
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    win_count_q  <= 6'b0;
+    win_issued_q <= 7'b0;
+    win_useful_q <= 7'b0;
+end
+else if (win_end_w)
+begin
+    win_count_q  <= 6'b0;
+    win_issued_q <= 7'b0;
+    win_useful_q <= 7'b0;
+end
+else
+begin
+    if (lookup_valid_i)
+        win_count_q  <= win_count_q + 6'd1;
+
+    if (fill_i && win_issued_q != 7'h7F)
+        win_issued_q <= win_issued_q + 7'd1;
+
+    if (useful_r && win_useful_q != 7'h7F)
+        win_useful_q <= win_useful_q + 7'd1;
+end
+
+//-------------------------------------------------------------------
+// Stats
+//-------------------------------------------------------------------
+`ifdef verilator
+reg [31:0] stat_issued_q;
+reg [31:0] stat_useful_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    stat_issued_q <= 32'b0;
+    stat_useful_q <= 32'b0;
+end
+else
+begin
+    if (fill_i)
+        stat_issued_q <= stat_issued_q + 32'd1;
+    if (useful_r)
+        stat_useful_q <= stat_useful_q + 32'd1;
+end
+
+function [31:0] get_prefetch_issued; /*verilator public*/
+begin
+    get_prefetch_issued = stat_issued_q;
+end
+endfunction
+function [31:0] get_prefetch_useful; /*verilator public*/
+begin
+    get_prefetch_useful = stat_useful_q;
+end
+endfunction
+`endif
+
+endmodule
@@ -24,32 +24,42 @@
 //-----------------------------------------------------------------
 
 module dcache_core_tag_ram
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter ADDR_W           = 8
+    ,parameter DATA_W           = 21
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk0_i
     ,input           rst0_i
-    ,input  [  7:0]  addr0_i
+    ,input  [ADDR_W-1:0] addr0_i
     ,input           clk1_i
     ,input           rst1_i
-    ,input  [  7:0]  addr1_i
-    ,input  [ 20:0]  data1_i
+    ,input  [ADDR_W-1:0] addr1_i
+    ,input  [DATA_W-1:0] data1_i
     ,input           wr1_i
 
     // Outputs
-    ,output [ 20:0]  data0_o
+    ,output [DATA_W-1:0] data0_o
 );
 
 
 
 //-----------------------------------------------------------------
-// Tag RAM 0KB (256 x 21)
+// Tag RAM ((2^ADDR_W) x DATA_W)
 // Mode: Write First
 //-----------------------------------------------------------------
 /* verilator lint_off MULTIDRIVEN */
-reg [20:0]   ram [255:0] /*verilator public*/;
+reg [DATA_W-1:0]   ram [(1 << ADDR_W)-1:0] /*verilator public*/;
 /* verilator lint_on MULTIDRIVEN */
 
-reg [20:0] ram_read0_q;
+reg [DATA_W-1:0] ram_read0_q;
 
 always @ (posedge clk1_i)
 begin
@@ -42,6 +42,7 @@ module dcache_mux
     ,input           mem_cached_ack_i
     ,input           mem_cached_error_i
     ,input  [ 10:0]  mem_cached_resp_tag_i
+    ,input           mem_cached_busy_i
     ,input  [ 31:0]  mem_uncached_data_rd_i
     ,input           mem_uncached_accept_i
     ,input           mem_uncached_ack_i
@@ -73,6 +74,7 @@ module dcache_mux
     ,output          mem_uncached_writeback_o
     ,output          mem_uncached_flush_o
     ,output          cache_active_o
+    ,output          uncached_idle_o
 );
 
 
@@ -132,9 +134,13 @@ if (rst_i)
 else if (request_w && mem_accept_o)
     cache_access_q <= mem_cacheable_i;
 
-assign hold_w = (|pending_q) && (cache_access_q != mem_cacheable_i);
+// Cache may still be completing a line refill after acknowledging the request
+assign hold_w = ((|pending_q) && (cache_access_q != mem_cacheable_i)) || (mem_cached_busy_i && !mem_cacheable_i);
 
-assign cache_active_o = (|pending_q) ? cache_access_q : mem_cacheable_i;
+assign cache_active_o = (|pending_q) ? cache_access_q : (mem_cacheable_i | mem_cached_busy_i);
+
+// No uncached access outstanding or requested (cache may start background refills)
+assign uncached_idle_o = !((|pending_q) && !cache_access_q) && !(request_w && !mem_cacheable_i);
 
 
 endmodule
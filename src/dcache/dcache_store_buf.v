@@ -0,0 +1,349 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.6.0
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+
+module dcache_store_buf
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter NUM_ENTRIES      = 4
+    ,parameter NUM_ENTRIES_W    = 2
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input  [ 31:0]  mem_addr_i
+    ,input  [ 31:0]  mem_data_wr_i
+    ,input           mem_rd_i
+    ,input  [  3:0]  mem_wr_i
+    ,input           mem_cacheable_i
+    ,input  [ 10:0]  mem_req_tag_i
+    ,input           mem_invalidate_i
+    ,input           mem_writeback_i
+    ,input           mem_flush_i
+    ,input  [ 31:0]  outport_data_rd_i
+    ,input           outport_accept_i
+    ,input           outport_ack_i
+    ,input           outport_error_i
+    ,input  [ 10:0]  outport_resp_tag_i
+
+    // Outputs
+    ,output [ 31:0]  mem_data_rd_o
+    ,output          mem_accept_o
+    ,output          mem_ack_o
+    ,output          mem_error_o
+    ,output [ 10:0]  mem_resp_tag_o
+    ,output [ 31:0]  outport_addr_o
+    ,output [ 31:0]  outport_data_wr_o
+    ,output          outport_rd_o
+    ,output [  3:0]  outport_wr_o
+    ,output          outport_cacheable_o
+    ,output [ 10:0]  outport_req_tag_o
+    ,output          outport_invalidate_o
+    ,output          outport_writeback_o
+    ,output          outport_flush_o
+    ,output          store_error_o
+    ,output [ 31:0]  store_error_addr_o
+    ,output          empty_o
+);
+
+//-----------------------------------------------------------------
+// Stores are acknowledged as soon as they are written into the
+// buffer and drained to the cache later.  Cacheable stores to a
+// word already held in the buffer are merged into that entry.
+// Uncached stores are posted but never merged so that the access
+// width seen by peripherals is unchanged.
+//-----------------------------------------------------------------
+// Drained stores are issued with this request tag bit set so that
+// their responses can be dropped on return.  A bus error on a drained
+// store is flagged on store_error_o (with its address) instead.
+localparam DRAIN_TAG    = 11'h400;
+
+// Drained stores awaiting a response (addresses held for error reporting)
+localparam DRAIN_MAX    = 4'd4;
+
+// Cycles a partially written head entry waits for merges
+localparam MERGE_WAIT   = 3'd7;
+
+//-----------------------------------------------------------------
+// Registers / Wires
+//-----------------------------------------------------------------
+reg [NUM_ENTRIES-1:0]   valid_q;
+reg [NUM_ENTRIES-1:0]   cacheable_q;
+reg [31:0]              addr_q[NUM_ENTRIES-1:0];
+reg [31:0]              data_q[NUM_ENTRIES-1:0];
+reg [3:0]               mask_q[NUM_ENTRIES-1:0];
+
+reg [NUM_ENTRIES_W-1:0] rd_ptr_q;
+reg [NUM_ENTRIES_W-1:0] wr_ptr_q;
+reg [NUM_ENTRIES_W:0]   count_q;
+reg [2:0]               age_q;
+reg [3:0]               drain_pend_q;
+
+wire empty_w = (count_q == {(NUM_ENTRIES_W+1){1'b0}});
+
+/* verilator lint_off WIDTH */
+wire full_w  = (count_q == NUM_ENTRIES);
+/* verilator lint_on WIDTH */
+
+//-----------------------------------------------------------------
+// Address match
+//-----------------------------------------------------------------
+reg                     match_r;
+reg [NUM_ENTRIES_W-1:0] match_idx_r;
+reg                     uncached_pend_r;
+integer i0;
+
+always @ *
+begin
+    match_r         = 1'b0;
+    match_idx_r     = {NUM_ENTRIES_W{1'b0}};
+    uncached_pend_r = 1'b0;
+
+    for (i0=0;i0<NUM_ENTRIES;i0=i0+1)
+    begin
+        // Only cacheable entries can be merged into or forwarded from
+        if (valid_q[i0] && cacheable_q[i0] && addr_q[i0][31:2] == mem_addr_i[31:2])
+        begin
+            match_r     = 1'b1;
+            /* verilator lint_off WIDTH */
+            match_idx_r = i0;
+            /* verilator lint_on WIDTH */
+        end
+
+        if (valid_q[i0] && !cacheable_q[i0])
+            uncached_pend_r = 1'b1;
+    end
+end
+
+wire [3:0]  match_mask_w = mask_q[match_idx_r];
+wire [31:0] match_data_w = data_q[match_idx_r];
+
+//-----------------------------------------------------------------
+// Request decode
+//-----------------------------------------------------------------
+// A full word write flagged as invalidate is a line zero (cbo.zero) - not buffered
+wire store_w        = (|mem_wr_i) && !mem_invalidate_i;
+wire op_w           = mem_invalidate_i | mem_writeback_i | mem_flush_i;
+
+// Load hits a fully written word - forward from the buffer
+wire fwd_w          = mem_rd_i && mem_cacheable_i && match_r && (match_mask_w == 4'hF);
+
+// Load overlaps buffered data (or must be ordered after uncached stores,
+// which may otherwise be overtaken on the AXI read channel)
+wire load_hold_w    = mem_rd_i && ((mem_cacheable_i && match_r && !fwd_w) ||
+                                   (!mem_cacheable_i && (uncached_pend_r || drain_pend_q != 4'b0)));
+
+// Maintenance operations are performed with the buffer empty
+wire op_hold_w      = op_w && !empty_w;
+
+wire merge_w        = store_w && mem_cacheable_i && match_r;
+
+// Requests passed straight through to the cache
+wire pass_w         = (mem_rd_i && !fwd_w && !load_hold_w) || (op_w && empty_w);
+
+//-----------------------------------------------------------------
+// Drain
+//-----------------------------------------------------------------
+wire [3:0] head_mask_w = mask_q[rd_ptr_q];
+
+// A lone partially written cacheable word is held back for a few
+// cycles to give adjacent byte / half-word stores a chance to merge.
+wire head_ready_w   = !cacheable_q[rd_ptr_q] || (head_mask_w == 4'hF) ||
+                      (count_q > {{(NUM_ENTRIES_W){1'b0}}, 1'b1}) || (age_q == MERGE_WAIT);
+
+wire demand_w       = load_hold_w || op_hold_w || (store_w && !merge_w && full_w);
+
+// Drain whenever the cache port is not needed by a passed through request
+wire drain_w        = !empty_w && !pass_w && (head_ready_w || demand_w) && (drain_pend_q != DRAIN_MAX);
+wire pop_w          = drain_w && outport_accept_i;
+
+// Stores cannot merge into the head entry whilst it is being drained
+wire store_accept_w = store_w && (merge_w ? !(drain_w && match_idx_r == rd_ptr_q) : !full_w);
+wire alloc_w        = store_accept_w && !merge_w;
+
+//-----------------------------------------------------------------
+// Entries
+//-----------------------------------------------------------------
+integer i1;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    valid_q     <= {NUM_ENTRIES{1'b0}};
+    cacheable_q <= {NUM_ENTRIES{1'b0}};
+
+    for (i1=0;i1<NUM_ENTRIES;i1=i1+1)
+    begin
+        addr_q[i1] <= 32'b0;
+        data_q[i1] <= 32'b0;
+        mask_q[i1] <= 4'b0;
+    end
+end
+else
+begin
+    if (pop_w)
+        valid_q[rd_ptr_q] <= 1'b0;
+
+    if (alloc_w)
+    begin
+        valid_q[wr_ptr_q]     <= 1'b1;
+        cacheable_q[wr_ptr_q] <= mem_cacheable_i;
+        addr_q[wr_ptr_q]      <= {mem_addr_i[31:2], 2'b0};
+        data_q[wr_ptr_q]      <= mem_data_wr_i;
+        mask_q[wr_ptr_q]      <= mem_wr_i;
+    end
+    else if (store_accept_w)
+    begin
+        for (i1=0;i1<4;i1=i1+1)
+            if (mem_wr_i[i1])
+                data_q[match_idx_r][i1*8 +: 8] <= mem_data_wr_i[i1*8 +: 8];
+
+        mask_q[match_idx_r] <= match_mask_w | mem_wr_i;
+    end
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    rd_ptr_q <= {NUM_ENTRIES_W{1'b0}};
+    wr_ptr_q <= {NUM_ENTRIES_W{1'b0}};
+    count_q  <= {(NUM_ENTRIES_W+1){1'b0}};
+end
+else
+begin
+    if (pop_w)
+        rd_ptr_q <= rd_ptr_q + 1;
+
+    if (alloc_w)
+        wr_ptr_q <= wr_ptr_q + 1;
+
+    if (alloc_w && !pop_w)
+        count_q <= count_q + 1;
+    else if (!alloc_w && pop_w)
+        count_q <= count_q - 1;
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    age_q <= 3'b0;
+else if (empty_w || pop_w)
+    age_q <= 3'b0;
+else if (age_q != MERGE_WAIT)
+    age_q <= age_q + 3'd1;
+
+//-----------------------------------------------------------------
+// Drained stores awaiting a response
+//-----------------------------------------------------------------
+wire drain_resp_w = outport_ack_i & outport_resp_tag_i[10];
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    drain_pend_q <= 4'b0;
+else if (pop_w && !drain_resp_w)
+    drain_pend_q <= drain_pend_q + 4'd1;
+else if (!pop_w && drain_resp_w)
+    drain_pend_q <= drain_pend_q - 4'd1;
+
+// Store responses are returned in order
+reg [31:0] drain_addr_q[3:0];
+reg [1:0]  drain_wr_q;
+reg [1:0]  drain_rd_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    drain_addr_q[0] <= 32'b0;
+    drain_addr_q[1] <= 32'b0;
+    drain_addr_q[2] <= 32'b0;
+    drain_addr_q[3] <= 32'b0;
+    drain_wr_q      <= 2'b0;
+    drain_rd_q      <= 2'b0;
+end
+else
+begin
+    if (pop_w)
+    begin
+        drain_addr_q[drain_wr_q] <= addr_q[rd_ptr_q];
+        drain_wr_q               <= drain_wr_q + 2'd1;
+    end
+
+    if (drain_resp_w)
+        drain_rd_q <= drain_rd_q + 2'd1;
+end
+
+//-----------------------------------------------------------------
+// Buffer response (posted stores, forwarded loads)
+//-----------------------------------------------------------------
+reg         ack_q;
+reg [31:0]  ack_data_q;
+reg [10:0]  ack_tag_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    ack_q       <= 1'b0;
+    ack_data_q  <= 32'b0;
+    ack_tag_q   <= 11'b0;
+end
+else
+begin
+    ack_q       <= store_accept_w || fwd_w;
+    ack_data_q  <= match_data_w;
+    ack_tag_q   <= mem_req_tag_i;
+end
+
+//-----------------------------------------------------------------
+// Outputs
+//-----------------------------------------------------------------
+assign outport_rd_o         = pass_w & mem_rd_i;
+assign outport_wr_o         = drain_w ? head_mask_w : (pass_w ? mem_wr_i : 4'b0);
+assign outport_addr_o       = drain_w ? addr_q[rd_ptr_q] : mem_addr_i;
+assign outport_data_wr_o    = drain_w ? data_q[rd_ptr_q] : mem_data_wr_i;
+assign outport_cacheable_o  = drain_w ? cacheable_q[rd_ptr_q] : mem_cacheable_i;
+assign outport_req_tag_o    = drain_w ? DRAIN_TAG : mem_req_tag_i;
+assign outport_invalidate_o = pass_w & mem_invalidate_i;
+assign outport_writeback_o  = pass_w & mem_writeback_i;
+assign outport_flush_o      = pass_w & mem_flush_i;
+
+// Responses to drained stores are not returned to the LSU, bus errors
+// on them are reported separately (raised late by the core).
+assign mem_accept_o         = store_accept_w | fwd_w | (pass_w & outport_accept_i);
+assign mem_ack_o            = ack_q | (outport_ack_i & ~outport_resp_tag_i[10]);
+assign mem_data_rd_o        = ack_q ? ack_data_q : outport_data_rd_i;
+assign mem_error_o          = ack_q ? 1'b0 : (outport_error_i & ~outport_resp_tag_i[10]);
+assign mem_resp_tag_o       = ack_q ? ack_tag_q : outport_resp_tag_i;
+
+assign store_error_o        = drain_resp_w & outport_error_i;
+assign store_error_addr_o   = drain_addr_q[drain_rd_q];
+
+// No posted store left to write or awaiting its response (any error already reported)
+assign empty_o              = empty_w && (drain_pend_q == 4'b0);
+
+endmodule
@@ -29,6 +29,14 @@ module icache
 //-----------------------------------------------------------------
 #(
      parameter AXI_ID           = 0
+    ,parameter ICACHE_NUM_WAYS  = 2
+    ,parameter ICACHE_NUM_WAYS_W = 1
+    ,parameter ICACHE_NUM_LINES = 256
+    ,parameter ICACHE_NUM_LINES_W = 8
+    ,parameter ICACHE_LINE_SIZE = 32
+    ,parameter ICACHE_LINE_SIZE_W = 5
+    ,parameter ICACHE_PLRU_ENABLE = 0
+    ,parameter AXI_DATA_W       = 32
 )
 //-----------------------------------------------------------------
 // Ports
@@ -48,7 +56,7 @@ module icache
     ,input  [  3:0]  axi_bid_i
     ,input           axi_arready_i
     ,input           axi_rvalid_i
-    ,input  [ 31:0]  axi_rdata_i
+    ,input  [AXI_DATA_W-1:0] axi_rdata_i
     ,input  [  1:0]  axi_rresp_i
     ,input  [  3:0]  axi_rid_i
     ,input           axi_rlast_i
@@ -64,8 +72,8 @@ module icache
     ,output [  7:0]  axi_awlen_o
     ,output [  1:0]  axi_awburst_o
     ,output          axi_wvalid_o
-    ,output [ 31:0]  axi_wdata_o
-    ,output [  3:0]  axi_wstrb_o
+    ,output [AXI_DATA_W-1:0] axi_wdata_o
+    ,output [(AXI_DATA_W/8)-1:0] axi_wstrb_o
     ,output          axi_wlast_o
     ,output          axi_bready_o
     ,output          axi_arvalid_o
@@ -79,34 +87,41 @@ module icache
 
 
 //-----------------------------------------------------------------
-// This cache instance is 2 way set associative.
-// The total size is 16KB.
-// The replacement policy is a limited pseudo random scheme
-// (between lines, toggling on line thrashing).
+// This cache instance is ICACHE_NUM_WAYS way set associative.
+// The total size is ICACHE_NUM_WAYS * ICACHE_NUM_LINES * ICACHE_LINE_SIZE
+// (default: 2 ways x 256 lines x 32 bytes = 16KB).
+// The replacement policy is either a limited pseudo random scheme
+// (between lines, toggling on line thrashing) or tree pseudo-LRU
+// (ICACHE_PLRU_ENABLE=1).
+// Line refills are critical word first (AXI WRAP bursts) with the
+// fetch released as soon as the requested 64-bit word arrives.
+// The AXI data width (AXI_DATA_W = 32, 64 or 128) sets the number of
+// refill beats per line - with 128-bit AXI the data RAM rows are
+// widened to a full beat and ICACHE_LINE_SIZE must be at least 32.
 //-----------------------------------------------------------------
-// Number of ways
-localparam ICACHE_NUM_WAYS           = 2;
-
 // Number of cache lines
-localparam ICACHE_NUM_LINES          = 256;
-localparam ICACHE_LINE_ADDR_W        = 8;
+localparam ICACHE_LINE_ADDR_W        = ICACHE_NUM_LINES_W;
 
 // Line size (e.g. 32-bytes)
-localparam ICACHE_LINE_SIZE_W        = 5;
-localparam ICACHE_LINE_SIZE          = 32;
-localparam ICACHE_LINE_WORDS         = 8;
+localparam ICACHE_LINE_BEATS         = ICACHE_LINE_SIZE / (AXI_DATA_W / 8);
+localparam [7:0] ICACHE_BURST_LEN    = ICACHE_LINE_BEATS - 1;
 
+// Fetch width
 localparam ICACHE_DATA_W             = 64;
 
+// Data RAM row width (at least one fetch word, else one AXI beat)
+localparam ICACHE_RAM_W              = (AXI_DATA_W > ICACHE_DATA_W) ? AXI_DATA_W : ICACHE_DATA_W;
+localparam ICACHE_RAM_BYTES_W        = (AXI_DATA_W > ICACHE_DATA_W) ? 4 : 3;
+
 // Request -> tag address mapping
-localparam ICACHE_TAG_REQ_LINE_L     = 5;  // ICACHE_LINE_SIZE_W
-localparam ICACHE_TAG_REQ_LINE_H     = 12; // ICACHE_LINE_ADDR_W+ICACHE_LINE_SIZE_W-1
-localparam ICACHE_TAG_REQ_LINE_W     = 8;  // ICACHE_LINE_ADDR_W
+localparam ICACHE_TAG_REQ_LINE_L     = ICACHE_LINE_SIZE_W;
+localparam ICACHE_TAG_REQ_LINE_H     = ICACHE_LINE_ADDR_W+ICACHE_LINE_SIZE_W-1;
+localparam ICACHE_TAG_REQ_LINE_W     = ICACHE_LINE_ADDR_W;
 `define ICACHE_TAG_REQ_RNG          ICACHE_TAG_REQ_LINE_H:ICACHE_TAG_REQ_LINE_L
 
 // Tag fields
-`define CACHE_TAG_ADDR_RNG          18:0
-localparam CACHE_TAG_ADDR_BITS       = 19;
+`define CACHE_TAG_ADDR_RNG          CACHE_TAG_ADDR_BITS-1:0
+localparam CACHE_TAG_ADDR_BITS       = 32 - (ICACHE_LINE_ADDR_W+ICACHE_LINE_SIZE_W);
 localparam CACHE_TAG_VALID_BIT       = CACHE_TAG_ADDR_BITS;
 localparam CACHE_TAG_DATA_W          = CACHE_TAG_VALID_BIT + 1;
 
@@ -114,9 +129,9 @@ localparam CACHE_TAG_DATA_W          = CACHE_TAG_VALID_BIT + 1;
 localparam ICACHE_TAG_CMP_ADDR_L     = ICACHE_TAG_REQ_LINE_H + 1;
 localparam ICACHE_TAG_CMP_ADDR_H     = 32-1;
 localparam ICACHE_TAG_CMP_ADDR_W     = ICACHE_TAG_CMP_ADDR_H - ICACHE_TAG_CMP_ADDR_L + 1;
-`define   ICACHE_TAG_CMP_ADDR_RNG   31:13
+`define   ICACHE_TAG_CMP_ADDR_RNG   ICACHE_TAG_CMP_ADDR_H:ICACHE_TAG_CMP_ADDR_L
 
-// Address mapping example:
+// Address mapping example (default configuration):
 //  31          16 15 14 13 12 11 10 09 08 07 06 05 04 03 02 01 00
 // |--------------|  |  |  |  |  |  |  |  |  |  |  |  |  |  |  |  |
 //  +--------------------+  +--------------------+   +------------+
@@ -132,8 +147,8 @@ localparam ICACHE_TAG_CMP_ADDR_W     = ICACHE_TAG_CMP_ADDR_H - ICACHE_TAG_CMP_AD
 wire [ICACHE_TAG_REQ_LINE_W-1:0] req_line_addr_w  = req_pc_i[`ICACHE_TAG_REQ_RNG];
 
 // Data addressing
-localparam CACHE_DATA_ADDR_W = ICACHE_LINE_ADDR_W+ICACHE_LINE_SIZE_W-3;
-wire [CACHE_DATA_ADDR_W-1:0] req_data_addr_w = req_pc_i[CACHE_DATA_ADDR_W+3-1:3];
+localparam CACHE_DATA_ADDR_W = ICACHE_LINE_ADDR_W+ICACHE_LINE_SIZE_W-ICACHE_RAM_BYTES_W;
+wire [CACHE_DATA_ADDR_W-1:0] req_data_addr_w = req_pc_i[CACHE_DATA_ADDR_W+ICACHE_RAM_BYTES_W-1:ICACHE_RAM_BYTES_W];
 
 //-----------------------------------------------------------------
 // States
@@ -154,7 +169,7 @@ reg [STATE_W-1:0]           state_q;
 
 reg                         invalidate_q;
 
-reg [0:0]  replace_way_q;
+reg [ICACHE_NUM_WAYS_W-1:0]  replace_way_q;
 
 //-----------------------------------------------------------------
 // Lookup validation
@@ -182,6 +197,31 @@ else if (req_rd_i && req_accept_o)
 
 wire [ICACHE_TAG_CMP_ADDR_W-1:0] req_pc_tag_cmp_w = lookup_addr_q[`ICACHE_TAG_CMP_ADDR_RNG];
 
+//-----------------------------------------------------------------
+// Refill address
+//-----------------------------------------------------------------
+// Lookups can be accepted whilst the rest of the line streams in,
+// so keep a separate copy of the address of the line being filled.
+reg [31:0] refill_addr_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    refill_addr_q <= 32'b0;
+else if (state_q == STATE_LOOKUP && next_state_r == STATE_REFILL)
+    refill_addr_q <= lookup_addr_q;
+
+// A beat of the refill returned an error - the line is not validated, so
+// later fetches from it miss and see the error on their own refill word.
+reg refill_error_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    refill_error_q <= 1'b0;
+else if (state_q == STATE_LOOKUP && next_state_r == STATE_REFILL)
+    refill_error_q <= 1'b0;
+else if (state_q == STATE_REFILL && axi_rvalid_i && axi_rresp_i != 2'b0)
+    refill_error_q <= 1'b1;
+
 //-----------------------------------------------------------------
 // TAG RAMS
 //-----------------------------------------------------------------
@@ -196,7 +236,10 @@ begin
     if (state_q == STATE_FLUSH)
         tag_addr_r = flush_addr_q;
     // Line refill
-    else if (state_q == STATE_REFILL || state_q == STATE_RELOOKUP)
+    else if (state_q == STATE_REFILL)
+        tag_addr_r = refill_addr_q[`ICACHE_TAG_REQ_RNG];
+    // Lookup after refill
+    else if (state_q == STATE_RELOOKUP)
         tag_addr_r = lookup_addr_q[`ICACHE_TAG_REQ_RNG];
     // Lookup
     else
@@ -215,113 +258,123 @@ begin
     // Line refill
     else if (state_q == STATE_REFILL)
     begin
-        tag_data_in_r[CACHE_TAG_VALID_BIT] = 1'b1;
-        tag_data_in_r[`CACHE_TAG_ADDR_RNG] = lookup_addr_q[`ICACHE_TAG_CMP_ADDR_RNG];
+        tag_data_in_r[CACHE_TAG_VALID_BIT] = !refill_error_q && (axi_rresp_i == 2'b0);
+        tag_data_in_r[`CACHE_TAG_ADDR_RNG] = refill_addr_q[`ICACHE_TAG_CMP_ADDR_RNG];
     end
 end
 
-// Tag RAM write enable (way 0)
-reg tag0_write_r;
+// Tag RAM write enable (per way)
+reg [ICACHE_NUM_WAYS-1:0] tag_write_r;
+integer i0;
 always @ *
 begin
-    tag0_write_r = 1'b0;
-
-    // Cache flush
-    if (state_q == STATE_FLUSH)
-        tag0_write_r = 1'b1;
-    // Line refill
-    else if (state_q == STATE_REFILL)
-        tag0_write_r = axi_rvalid_i && axi_rlast_i && (replace_way_q == 0);
+    for (i0 = 0; i0 < ICACHE_NUM_WAYS; i0 = i0 + 1)
+    begin
+        tag_write_r[i0] = 1'b0;
+
+        // Cache flush
+        if (state_q == STATE_FLUSH)
+            tag_write_r[i0] = 1'b1;
+        // Line refill
+        else if (state_q == STATE_REFILL)
+/* verilator lint_off WIDTH */
+            tag_write_r[i0] = axi_rvalid_i && axi_rlast_i && (replace_way_q == i0);
+/* verilator lint_on WIDTH */
+    end
 end
 
-wire [CACHE_TAG_DATA_W-1:0] tag0_data_out_w;
-
-icache_tag_ram
-u_tag0
-(
-  .clk_i(clk_i),
-  .rst_i(rst_i),
-  .addr_i(tag_addr_r),
-  .data_i(tag_data_in_r),
-  .wr_i(tag0_write_r),
-  .data_o(tag0_data_out_w)
-);
-
-wire                           tag0_valid_w     = tag0_data_out_w[CACHE_TAG_VALID_BIT];
-wire [CACHE_TAG_ADDR_BITS-1:0] tag0_addr_bits_w = tag0_data_out_w[`CACHE_TAG_ADDR_RNG];
-
-// Tag hit?
-wire                           tag0_hit_w = tag0_valid_w ? (tag0_addr_bits_w == req_pc_tag_cmp_w) : 1'b0;
-
-// Tag RAM write enable (way 1)
-reg tag1_write_r;
-always @ *
-begin
-    tag1_write_r = 1'b0;
-
-    // Cache flush
-    if (state_q == STATE_FLUSH)
-        tag1_write_r = 1'b1;
-    // Line refill
-    else if (state_q == STATE_REFILL)
-        tag1_write_r = axi_rvalid_i && axi_rlast_i && (replace_way_q == 1);
+wire [ICACHE_NUM_WAYS-1:0] tag_hit_w;
+
+genvar g_way;
+generate
+for (g_way = 0; g_way < ICACHE_NUM_WAYS; g_way = g_way + 1)
+begin : TAG_WAY
+    wire [CACHE_TAG_DATA_W-1:0] tag_data_out_w;
+
+    icache_tag_ram
+    #(
+         .ADDR_W(ICACHE_TAG_REQ_LINE_W)
+        ,.DATA_W(CACHE_TAG_DATA_W)
+    )
+    u_tag
+    (
+      .clk_i(clk_i),
+      .rst_i(rst_i),
+      .addr_i(tag_addr_r),
+      .data_i(tag_data_in_r),
+      .wr_i(tag_write_r[g_way]),
+      .data_o(tag_data_out_w)
+    );
+
+    wire                           tag_valid_w     = tag_data_out_w[CACHE_TAG_VALID_BIT];
+    wire [CACHE_TAG_ADDR_BITS-1:0] tag_addr_bits_w = tag_data_out_w[`CACHE_TAG_ADDR_RNG];
+
+    // Tag hit?
+    assign tag_hit_w[g_way] = tag_valid_w ? (tag_addr_bits_w == req_pc_tag_cmp_w) : 1'b0;
 end
+endgenerate
 
-wire [CACHE_TAG_DATA_W-1:0] tag1_data_out_w;
-
-icache_tag_ram
-u_tag1
-(
-  .clk_i(clk_i),
-  .rst_i(rst_i),
-  .addr_i(tag_addr_r),
-  .data_i(tag_data_in_r),
-  .wr_i(tag1_write_r),
-  .data_o(tag1_data_out_w)
-);
-
-wire                           tag1_valid_w     = tag1_data_out_w[CACHE_TAG_VALID_BIT];
-wire [CACHE_TAG_ADDR_BITS-1:0] tag1_addr_bits_w = tag1_data_out_w[`CACHE_TAG_ADDR_RNG];
-
-// Tag hit?
-wire                           tag1_hit_w = tag1_valid_w ? (tag1_addr_bits_w == req_pc_tag_cmp_w) : 1'b0;
-
-
-wire tag_hit_any_w = 1'b0
-                   | tag0_hit_w
-                   | tag1_hit_w
-                    ;
+wire tag_hit_any_w = |tag_hit_w;
 
 //-----------------------------------------------------------------
 // DATA RAMS
 //-----------------------------------------------------------------
 reg [CACHE_DATA_ADDR_W-1:0] data_addr_r;
 reg [CACHE_DATA_ADDR_W-1:0] data_write_addr_q;
-reg [2:0]  refill_word_idx_q;
+reg [ICACHE_LINE_SIZE_W-3:0] refill_word_idx_q;
 reg [31:0] refill_lower_q;
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
-    refill_word_idx_q <= 3'b0;
+    refill_word_idx_q <= {(ICACHE_LINE_SIZE_W-2){1'b0}};
 else if (axi_rvalid_i && axi_rlast_i)
-    refill_word_idx_q <= 3'b0;
+    refill_word_idx_q <= {(ICACHE_LINE_SIZE_W-2){1'b0}};
 else if (axi_rvalid_i)
-    refill_word_idx_q <= refill_word_idx_q + 3'd1;
+    refill_word_idx_q <= refill_word_idx_q + 1;
+
+reg refill_lower_err_q;
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
-    refill_lower_q <= 32'b0;
+begin
+    refill_lower_q     <= 32'b0;
+    refill_lower_err_q <= 1'b0;
+end
 else if (axi_rvalid_i)
-    refill_lower_q <= axi_rdata_i;
+begin
+    refill_lower_q     <= axi_rdata_i[31:0];
+    refill_lower_err_q <= (axi_rresp_i != 2'b0);
+end
+
+// Refill beat completes a data RAM row (32-bit AXI takes two beats per row)
+wire refill_row_w = (AXI_DATA_W != 32) || refill_word_idx_q[0];
+
+// Error on any beat of the row
+wire refill_row_err_w = (axi_rresp_i != 2'b0) || ((AXI_DATA_W == 32) && refill_lower_err_q);
+
+// Data RAM row assembled from the refill beat(s)
+wire [ICACHE_RAM_W-1:0] refill_data_w;
 
-// Data RAM refill write address
+generate
+if (AXI_DATA_W == 32)
+begin : REFILL_32
+    assign refill_data_w = {axi_rdata_i, refill_lower_q};
+end
+else
+begin : REFILL_WIDE
+    assign refill_data_w = axi_rdata_i;
+end
+endgenerate
+
+// Data RAM refill write address (starts at the critical word, wraps within the line)
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
     data_write_addr_q <= {(CACHE_DATA_ADDR_W){1'b0}};
 else if (state_q == STATE_LOOKUP && next_state_r == STATE_REFILL)
-    data_write_addr_q <= axi_araddr_o[CACHE_DATA_ADDR_W+3-1:3];
-else if (state_q == STATE_REFILL && axi_rvalid_i && refill_word_idx_q[0])
-    data_write_addr_q <= data_write_addr_q + 1;
+    data_write_addr_q <= axi_araddr_o[CACHE_DATA_ADDR_W+ICACHE_RAM_BYTES_W-1:ICACHE_RAM_BYTES_W];
+else if (state_q == STATE_REFILL && axi_rvalid_i && refill_row_w)
+    data_write_addr_q <= {data_write_addr_q[CACHE_DATA_ADDR_W-1:ICACHE_LINE_SIZE_W-ICACHE_RAM_BYTES_W],
+                          data_write_addr_q[ICACHE_LINE_SIZE_W-ICACHE_RAM_BYTES_W-1:0] + 1'b1};
 
 // Data RAM address
 always @ *
@@ -333,52 +386,38 @@ begin
         data_addr_r = data_write_addr_q;
     // Lookup after refill
     else if (state_q == STATE_RELOOKUP)
-        data_addr_r = lookup_addr_q[CACHE_DATA_ADDR_W+3-1:3];
+        data_addr_r = lookup_addr_q[CACHE_DATA_ADDR_W+ICACHE_RAM_BYTES_W-1:ICACHE_RAM_BYTES_W];
     // Lookup
     else
         data_addr_r = req_data_addr_w;
 end
 
 
-// Data RAM write enable (way 0)
-reg data0_write_r;
-always @ *
-begin
-    data0_write_r = axi_rvalid_i && replace_way_q == 0;
-end
-
-wire [ICACHE_DATA_W-1:0] data0_data_out_w;
-
-icache_data_ram
-u_data0
-(
-  .clk_i(clk_i),
-  .rst_i(rst_i),
-  .addr_i(data_addr_r),
-  .data_i({axi_rdata_i, refill_lower_q}),
-  .wr_i(data0_write_r),
-  .data_o(data0_data_out_w)
-);
-
-// Data RAM write enable (way 1)
-reg data1_write_r;
-always @ *
-begin
-    data1_write_r = axi_rvalid_i && replace_way_q == 1;
+// Data RAM (per way)
+wire [(ICACHE_NUM_WAYS*ICACHE_RAM_W)-1:0] data_out_w;
+
+generate
+for (g_way = 0; g_way < ICACHE_NUM_WAYS; g_way = g_way + 1)
+begin : DATA_WAY
+    // Data RAM write enable
+    wire data_write_w = axi_rvalid_i && (replace_way_q == g_way);
+
+    icache_data_ram
+    #(
+         .ADDR_W(CACHE_DATA_ADDR_W)
+        ,.DATA_W(ICACHE_RAM_W)
+    )
+    u_data
+    (
+      .clk_i(clk_i),
+      .rst_i(rst_i),
+      .addr_i(data_addr_r),
+      .data_i(refill_data_w),
+      .wr_i(data_write_w),
+      .data_o(data_out_w[(g_way*ICACHE_RAM_W) +: ICACHE_RAM_W])
+    );
 end
-
-wire [ICACHE_DATA_W-1:0] data1_data_out_w;
-
-icache_data_ram
-u_data1
-(
-  .clk_i(clk_i),
-  .rst_i(rst_i),
-  .addr_i(data_addr_r),
-  .data_i({axi_rdata_i, refill_lower_q}),
-  .wr_i(data1_write_r),
-  .data_o(data1_data_out_w)
-);
+endgenerate
 
 //-----------------------------------------------------------------
 // Flush counter
@@ -399,32 +438,138 @@ else
 //-----------------------------------------------------------------
 // Replacement Policy
 //----------------------------------------------------------------- 
-// Using random replacement policy - this way we cycle through the ways
-// when needing to replace a line.
-always @ (posedge clk_i or posedge rst_i)
-if (rst_i)
-    replace_way_q <= 0;
-else if (axi_rvalid_i && axi_rlast_i)
-    replace_way_q <= replace_way_q + 1;
+generate
+if (ICACHE_PLRU_ENABLE)
+begin : PLRU
+    // Tree pseudo-LRU - one bit per internal tree node per line (node 0 unused).
+    // A node bit of 0 points the victim search to the lower half of the ways.
+    reg [ICACHE_NUM_WAYS-1:0] plru_q[ICACHE_NUM_LINES-1:0];
+
+    function [ICACHE_NUM_WAYS_W-1:0] plru_victim;
+        input [ICACHE_NUM_WAYS-1:0] tree;
+        integer lvl;
+        integer node;
+    begin
+        node = 1;
+        for (lvl = 0; lvl < ICACHE_NUM_WAYS_W; lvl = lvl + 1)
+            node = (node * 2) + tree[node];
+/* verilator lint_off WIDTH */
+        plru_victim = node - ICACHE_NUM_WAYS;
+/* verilator lint_on WIDTH */
+    end
+    endfunction
+
+    function [ICACHE_NUM_WAYS-1:0] plru_touch;
+        input [ICACHE_NUM_WAYS-1:0]   tree;
+        input [ICACHE_NUM_WAYS_W-1:0] way;
+        integer lvl;
+        integer node;
+    begin
+        plru_touch = tree;
+        node       = 1;
+        for (lvl = ICACHE_NUM_WAYS_W-1; lvl >= 0; lvl = lvl - 1)
+        begin
+            // Point away from the most recently used way
+            plru_touch[node] = ~way[lvl];
+            node             = (node * 2) + way[lvl];
+        end
+    end
+    endfunction
+
+    // Way which hit on the current lookup
+    reg [ICACHE_NUM_WAYS_W-1:0] hit_way_r;
+    integer i1;
+    always @ *
+    begin
+        hit_way_r = {ICACHE_NUM_WAYS_W{1'b0}};
+        for (i1 = 0; i1 < ICACHE_NUM_WAYS; i1 = i1 + 1)
+            if (tag_hit_w[i1])
+/* verilator lint_off WIDTH */
+                hit_way_r = i1;
+/* verilator lint_on WIDTH */
+    end
+
+    wire [ICACHE_TAG_REQ_LINE_W-1:0] lookup_line_w = lookup_addr_q[`ICACHE_TAG_REQ_RNG];
+    wire [ICACHE_TAG_REQ_LINE_W-1:0] refill_line_w = refill_addr_q[`ICACHE_TAG_REQ_RNG];
+
+    integer i2;
+    always @ (posedge clk_i or posedge rst_i)
+    if (rst_i)
+    begin
+        for (i2 = 0; i2 < ICACHE_NUM_LINES; i2 = i2 + 1)
+            plru_q[i2] <= {ICACHE_NUM_WAYS{1'b0}};
+    end
+    // Line filled - now most recently used
+    else if (state_q == STATE_REFILL && axi_rvalid_i && axi_rlast_i)
+        plru_q[refill_line_w] <= plru_touch(plru_q[refill_line_w], replace_way_q);
+    // Lookup hit
+    else if (state_q == STATE_LOOKUP && req_valid_o)
+        plru_q[lookup_line_w] <= plru_touch(plru_q[lookup_line_w], hit_way_r);
+
+    // Select the least recently used way when a miss is detected
+    always @ (posedge clk_i or posedge rst_i)
+    if (rst_i)
+        replace_way_q <= {ICACHE_NUM_WAYS_W{1'b0}};
+    else if (state_q == STATE_LOOKUP && next_state_r == STATE_REFILL)
+        replace_way_q <= plru_victim(plru_q[lookup_line_w]);
+end
+else
+begin : RANDOM
+    // Using random replacement policy - this way we cycle through the ways
+    // when needing to replace a line.
+    always @ (posedge clk_i or posedge rst_i)
+    if (rst_i)
+        replace_way_q <= {ICACHE_NUM_WAYS_W{1'b0}};
+    else if (axi_rvalid_i && axi_rlast_i)
+        replace_way_q <= replace_way_q + 1;
+end
+endgenerate
+
+//-----------------------------------------------------------------
+// Early restart
+//-----------------------------------------------------------------
+// Complete data RAM row arriving from the refill burst
+wire refill_word_valid_w = (state_q == STATE_REFILL) && axi_rvalid_i && refill_row_w;
+
+// Pending lookup is for the row currently being written into the line
+wire refill_hit_w        = refill_word_valid_w &&
+                           (lookup_addr_q[31:ICACHE_LINE_SIZE_W] == refill_addr_q[31:ICACHE_LINE_SIZE_W]) &&
+                           (lookup_addr_q[ICACHE_LINE_SIZE_W-1:ICACHE_RAM_BYTES_W] ==
+                            data_write_addr_q[ICACHE_LINE_SIZE_W-ICACHE_RAM_BYTES_W-1:0]);
 
 //-----------------------------------------------------------------
 // Instruction Output
 //-----------------------------------------------------------------
-assign req_valid_o = lookup_valid_q && ((state_q == STATE_LOOKUP) ? tag_hit_any_w : 1'b0);
+assign req_valid_o = lookup_valid_q && ((state_q == STATE_LOOKUP) ? tag_hit_any_w : refill_hit_w);
 
 // Data output mux
-reg [ICACHE_DATA_W-1:0] inst_r;
+reg [ICACHE_RAM_W-1:0] row_r;
+integer i3;
 always @ *
 begin
-    inst_r = data0_data_out_w;
+    row_r = data_out_w[ICACHE_RAM_W-1:0];
 
-    case (1'b1)
-    tag0_hit_w: inst_r = data0_data_out_w;
-    tag1_hit_w: inst_r = data1_data_out_w;
-    endcase
+    if (state_q == STATE_REFILL)
+        row_r = refill_data_w;
+    else
+    begin
+        for (i3 = 0; i3 < ICACHE_NUM_WAYS; i3 = i3 + 1)
+            if (tag_hit_w[i3])
+                row_r = data_out_w[(i3*ICACHE_RAM_W) +: ICACHE_RAM_W];
+    end
 end
 
-assign req_inst_o    = inst_r;
+// Select the 64-bit fetch word from a wide row
+generate
+if (ICACHE_RAM_W > ICACHE_DATA_W)
+begin : INST_WIDE
+    assign req_inst_o = row_r[(lookup_addr_q[ICACHE_RAM_BYTES_W-1:3]*ICACHE_DATA_W) +: ICACHE_DATA_W];
+end
+else
+begin : INST_64
+    assign req_inst_o = row_r;
+end
+endgenerate
 
 //-----------------------------------------------------------------
 // Next State Logic
@@ -484,7 +629,11 @@ if (rst_i)
 else
     state_q   <= next_state_r;
 
-assign req_accept_o = (state_q == STATE_LOOKUP && next_state_r != STATE_REFILL);
+// Accept new lookups during a refill once the critical word has been returned.
+// These are serviced as their word streams in, else re-looked up after the refill.
+assign req_accept_o = (state_q == STATE_LOOKUP && next_state_r != STATE_REFILL) ||
+                      (state_q == STATE_REFILL && (!lookup_valid_q || refill_hit_w) &&
+                       !req_flush_i && !req_invalidate_i);
 
 //-----------------------------------------------------------------
 // Invalidate
@@ -512,16 +661,8 @@ else
 //-----------------------------------------------------------------
 // AXI Error Handling
 //-----------------------------------------------------------------
-reg axi_error_q;
-always @ (posedge clk_i or posedge rst_i)
-if (rst_i)
-    axi_error_q   <= 1'b0;
-else if (axi_rvalid_i && axi_rready_o && axi_rresp_i != 2'b0)
-    axi_error_q   <= 1'b1;
-else if (req_valid_o)
-    axi_error_q   <= 1'b0;
-
-assign req_error_o = axi_error_q;
+// Only a fetch served from a row which returned an error faults (see refill_error_q)
+assign req_error_o = refill_hit_w && refill_row_err_w;
 
 //-----------------------------------------------------------------
 // AXI
@@ -533,17 +674,18 @@ assign axi_awid_o    = 4'b0;
 assign axi_awlen_o   = 8'b0;
 assign axi_awburst_o = 2'b0;
 assign axi_wvalid_o  = 1'b0;
-assign axi_wdata_o   = 32'b0;
-assign axi_wstrb_o   = 4'b0;
+assign axi_wdata_o   = {(AXI_DATA_W){1'b0}};
+assign axi_wstrb_o   = {(AXI_DATA_W/8){1'b0}};
 assign axi_wlast_o   = 1'b0;
 assign axi_bready_o  = 1'b0;
 
 // AXI Read channel
 assign axi_arvalid_o = (state_q == STATE_LOOKUP && next_state_r == STATE_REFILL) || axi_arvalid_q;
-assign axi_araddr_o  = {lookup_addr_q[31:ICACHE_LINE_SIZE_W], {(ICACHE_LINE_SIZE_W){1'b0}}};
-assign axi_arburst_o = 2'd1; // INCR
+assign axi_araddr_o  = axi_arvalid_q ? {refill_addr_q[31:ICACHE_RAM_BYTES_W], {(ICACHE_RAM_BYTES_W){1'b0}}} :
+                                       {lookup_addr_q[31:ICACHE_RAM_BYTES_W], {(ICACHE_RAM_BYTES_W){1'b0}}};
+assign axi_arburst_o = 2'd2; // WRAP (critical word first)
 assign axi_arid_o    = AXI_ID;
-assign axi_arlen_o   = 8'd7;
+assign axi_arlen_o   = ICACHE_BURST_LEN;
 assign axi_rready_o  = 1'b1;
 
 
@@ -24,27 +24,37 @@
 //-----------------------------------------------------------------
 
 module icache_data_ram
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter ADDR_W           = 10
+    ,parameter DATA_W           = 64
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk_i
     ,input           rst_i
-    ,input  [  9:0]  addr_i
-    ,input  [ 63:0]  data_i
+    ,input  [ADDR_W-1:0] addr_i
+    ,input  [DATA_W-1:0] data_i
     ,input           wr_i
 
     // Outputs
-    ,output [ 63:0]  data_o
+    ,output [DATA_W-1:0] data_o
 );
 
 
 
 
 //-----------------------------------------------------------------
-// Single Port RAM 8KB
+// Single Port RAM ((2^ADDR_W) x DATA_W)
 // Mode: Read First
 //-----------------------------------------------------------------
-reg [63:0]   ram [1023:0] /*verilator public*/;
-reg [63:0]   ram_read_q;
+reg [DATA_W-1:0]   ram [(1 << ADDR_W)-1:0] /*verilator public*/;
+reg [DATA_W-1:0]   ram_read_q;
 
 // Synchronous write
 always @ (posedge clk_i)
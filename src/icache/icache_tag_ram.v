@@ -24,27 +24,37 @@
 //-----------------------------------------------------------------
 
 module icache_tag_ram
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter ADDR_W           = 8
+    ,parameter DATA_W           = 20
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk_i
     ,input           rst_i
-    ,input  [  7:0]  addr_i
-    ,input  [ 19:0]  data_i
+    ,input  [ADDR_W-1:0] addr_i
+    ,input  [DATA_W-1:0] data_i
     ,input           wr_i
 
     // Outputs
-    ,output [ 19:0]  data_o
+    ,output [DATA_W-1:0] data_o
 );
 
 
 
 
 //-----------------------------------------------------------------
-// Single Port RAM 0KB
+// Single Port RAM ((2^ADDR_W) x DATA_W)
 // Mode: Read First
 //-----------------------------------------------------------------
-reg [19:0]   ram [255:0] /*verilator public*/;
-reg [19:0]   ram_read_q;
+reg [DATA_W-1:0]   ram [(1 << ADDR_W)-1:0] /*verilator public*/;
+reg [DATA_W-1:0]   ram_read_q;
 
 // Synchronous write
 always @ (posedge clk_i)
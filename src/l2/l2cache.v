@@ -0,0 +1,519 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+module l2cache
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter L2_NUM_WAYS      = 4
+    ,parameter L2_NUM_WAYS_W    = 2
+    ,parameter L2_NUM_LINES     = 512
+    ,parameter L2_NUM_LINES_W   = 9
+    ,parameter L2_LINE_SIZE     = 32
+    ,parameter L2_LINE_SIZE_W   = 5
+    ,parameter L2_NUM_BANKS     = 2
+    ,parameter L2_NUM_BANKS_W   = 1
+    ,parameter AXI_DATA_W       = 32
+    ,parameter MEM_CACHE_ADDR_MIN = 32'h80000000
+    ,parameter MEM_CACHE_ADDR_MAX = 32'h8fffffff
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input           inport_i_awvalid_i
+    ,input  [ 31:0]  inport_i_awaddr_i
+    ,input  [  3:0]  inport_i_awid_i
+    ,input  [  7:0]  inport_i_awlen_i
+    ,input  [  1:0]  inport_i_awburst_i
+    ,input           inport_i_wvalid_i
+    ,input  [AXI_DATA_W-1:0] inport_i_wdata_i
+    ,input  [(AXI_DATA_W/8)-1:0] inport_i_wstrb_i
+    ,input           inport_i_wlast_i
+    ,input           inport_i_bready_i
+    ,input           inport_i_arvalid_i
+    ,input  [ 31:0]  inport_i_araddr_i
+    ,input  [  3:0]  inport_i_arid_i
+    ,input  [  7:0]  inport_i_arlen_i
+    ,input  [  1:0]  inport_i_arburst_i
+    ,input           inport_i_rready_i
+    ,input           inport_d_awvalid_i
+    ,input  [ 31:0]  inport_d_awaddr_i
+    ,input  [  3:0]  inport_d_awid_i
+    ,input  [  7:0]  inport_d_awlen_i
+    ,input  [  1:0]  inport_d_awburst_i
+    ,input           inport_d_wvalid_i
+    ,input  [AXI_DATA_W-1:0] inport_d_wdata_i
+    ,input  [(AXI_DATA_W/8)-1:0] inport_d_wstrb_i
+    ,input           inport_d_wlast_i
+    ,input           inport_d_bready_i
+    ,input           inport_d_arvalid_i
+    ,input  [ 31:0]  inport_d_araddr_i
+    ,input  [  3:0]  inport_d_arid_i
+    ,input  [  7:0]  inport_d_arlen_i
+    ,input  [  1:0]  inport_d_arburst_i
+    ,input           inport_d_rready_i
+    ,input           outport_awready_i
+    ,input           outport_wready_i
+    ,input           outport_bvalid_i
+    ,input  [  1:0]  outport_bresp_i
+    ,input  [  3:0]  outport_bid_i
+    ,input           outport_arready_i
+    ,input           outport_rvalid_i
+    ,input  [AXI_DATA_W-1:0] outport_rdata_i
+    ,input  [  1:0]  outport_rresp_i
+    ,input  [  3:0]  outport_rid_i
+    ,input           outport_rlast_i
+
+    // Outputs
+    ,output          inport_i_awready_o
+    ,output          inport_i_wready_o
+    ,output          inport_i_bvalid_o
+    ,output [  1:0]  inport_i_bresp_o
+    ,output [  3:0]  inport_i_bid_o
+    ,output          inport_i_arready_o
+    ,output          inport_i_rvalid_o
+    ,output [AXI_DATA_W-1:0] inport_i_rdata_o
+    ,output [  1:0]  inport_i_rresp_o
+    ,output [  3:0]  inport_i_rid_o
+    ,output          inport_i_rlast_o
+    ,output          inport_d_awready_o
+    ,output          inport_d_wready_o
+    ,output          inport_d_bvalid_o
+    ,output [  1:0]  inport_d_bresp_o
+    ,output [  3:0]  inport_d_bid_o
+    ,output          inport_d_arready_o
+    ,output          inport_d_rvalid_o
+    ,output [AXI_DATA_W-1:0] inport_d_rdata_o
+    ,output [  1:0]  inport_d_rresp_o
+    ,output [  3:0]  inport_d_rid_o
+    ,output          inport_d_rlast_o
+    ,output          outport_awvalid_o
+    ,output [ 31:0]  outport_awaddr_o
+    ,output [  3:0]  outport_awid_o
+    ,output [  7:0]  outport_awlen_o
+    ,output [  1:0]  outport_awburst_o
+    ,output          outport_wvalid_o
+    ,output [AXI_DATA_W-1:0] outport_wdata_o
+    ,output [(AXI_DATA_W/8)-1:0] outport_wstrb_o
+    ,output          outport_wlast_o
+    ,output          outport_bready_o
+    ,output          outport_arvalid_o
+    ,output [ 31:0]  outport_araddr_o
+    ,output [  3:0]  outport_arid_o
+    ,output [  7:0]  outport_arlen_o
+    ,output [  1:0]  outport_arburst_o
+    ,output          outport_rready_o
+);
+
+//-----------------------------------------------------------------
+// Shared L2 cache: write-back, allocate on read and write.
+// Port 0 serves the instruction cache, port 1 the data cache.
+// Lines are interleaved across L2_NUM_BANKS independent banks, each
+// with its own miss handling and memory AXI ID (= bank number).
+// Accesses outside MEM_CACHE_ADDR_MIN - MEM_CACHE_ADDR_MAX bypass
+// the cache (still serialised through the owning bank).
+//
+// The total size is L2_NUM_BANKS * L2_NUM_WAYS * L2_NUM_LINES * L2_LINE_SIZE
+//-----------------------------------------------------------------
+localparam LINE_W     = L2_LINE_SIZE * 8;
+localparam NUM_PORTS  = 2;
+
+//-----------------------------------------------------------------
+// L1 ports
+//-----------------------------------------------------------------
+wire [NUM_PORTS-1:0]            port_req_valid_w;
+wire [NUM_PORTS-1:0]            port_req_write_w;
+wire [(NUM_PORTS*32)-1:0]       port_req_addr_w;
+wire [(NUM_PORTS*8)-1:0]        port_req_len_w;
+wire [(NUM_PORTS*2)-1:0]        port_req_burst_w;
+wire [(NUM_PORTS*LINE_W)-1:0]   port_req_data_w;
+wire [(NUM_PORTS*L2_LINE_SIZE)-1:0] port_req_mask_w;
+wire [NUM_PORTS-1:0]            port_req_accept_w;
+wire [NUM_PORTS-1:0]            port_resp_valid_w;
+wire [(NUM_PORTS*LINE_W)-1:0]   port_resp_data_w;
+wire [NUM_PORTS-1:0]            port_resp_error_w;
+
+l2cache_port
+#(
+     .L2_LINE_SIZE(L2_LINE_SIZE)
+    ,.L2_LINE_SIZE_W(L2_LINE_SIZE_W)
+    ,.AXI_DATA_W(AXI_DATA_W)
+)
+u_port_i
+(
+     .clk_i(clk_i)
+    ,.rst_i(rst_i)
+    ,.axi_awvalid_i(inport_i_awvalid_i)
+    ,.axi_awaddr_i(inport_i_awaddr_i)
+    ,.axi_awid_i(inport_i_awid_i)
+    ,.axi_awlen_i(inport_i_awlen_i)
+    ,.axi_awburst_i(inport_i_awburst_i)
+    ,.axi_wvalid_i(inport_i_wvalid_i)
+    ,.axi_wdata_i(inport_i_wdata_i)
+    ,.axi_wstrb_i(inport_i_wstrb_i)
+    ,.axi_wlast_i(inport_i_wlast_i)
+    ,.axi_bready_i(inport_i_bready_i)
+    ,.axi_arvalid_i(inport_i_arvalid_i)
+    ,.axi_araddr_i(inport_i_araddr_i)
+    ,.axi_arid_i(inport_i_arid_i)
+    ,.axi_arlen_i(inport_i_arlen_i)
+    ,.axi_arburst_i(inport_i_arburst_i)
+    ,.axi_rready_i(inport_i_rready_i)
+    ,.req_accept_i(port_req_accept_w[0])
+    ,.resp_valid_i(port_resp_valid_w[0])
+    ,.resp_data_i(port_resp_data_w[0*LINE_W +: LINE_W])
+    ,.resp_error_i(port_resp_error_w[0])
+
+    ,.axi_awready_o(inport_i_awready_o)
+    ,.axi_wready_o(inport_i_wready_o)
+    ,.axi_bvalid_o(inport_i_bvalid_o)
+    ,.axi_bresp_o(inport_i_bresp_o)
+    ,.axi_bid_o(inport_i_bid_o)
+    ,.axi_arready_o(inport_i_arready_o)
+    ,.axi_rvalid_o(inport_i_rvalid_o)
+    ,.axi_rdata_o(inport_i_rdata_o)
+    ,.axi_rresp_o(inport_i_rresp_o)
+    ,.axi_rid_o(inport_i_rid_o)
+    ,.axi_rlast_o(inport_i_rlast_o)
+    ,.req_valid_o(port_req_valid_w[0])
+    ,.req_write_o(port_req_write_w[0])
+    ,.req_addr_o(port_req_addr_w[0*32 +: 32])
+    ,.req_len_o(port_req_len_w[0*8 +: 8])
+    ,.req_burst_o(port_req_burst_w[0*2 +: 2])
+    ,.req_data_o(port_req_data_w[0*LINE_W +: LINE_W])
+    ,.req_mask_o(port_req_mask_w[0*L2_LINE_SIZE +: L2_LINE_SIZE])
+);
+
+l2cache_port
+#(
+     .L2_LINE_SIZE(L2_LINE_SIZE)
+    ,.L2_LINE_SIZE_W(L2_LINE_SIZE_W)
+    ,.AXI_DATA_W(AXI_DATA_W)
+)
+u_port_d
+(
+     .clk_i(clk_i)
+    ,.rst_i(rst_i)
+    ,.axi_awvalid_i(inport_d_awvalid_i)
+    ,.axi_awaddr_i(inport_d_awaddr_i)
+    ,.axi_awid_i(inport_d_awid_i)
+    ,.axi_awlen_i(inport_d_awlen_i)
+    ,.axi_awburst_i(inport_d_awburst_i)
+    ,.axi_wvalid_i(inport_d_wvalid_i)
+    ,.axi_wdata_i(inport_d_wdata_i)
+    ,.axi_wstrb_i(inport_d_wstrb_i)
+    ,.axi_wlast_i(inport_d_wlast_i)
+    ,.axi_bready_i(inport_d_bready_i)
+    ,.axi_arvalid_i(inport_d_arvalid_i)
+    ,.axi_araddr_i(inport_d_araddr_i)
+    ,.axi_arid_i(inport_d_arid_i)
+    ,.axi_arlen_i(inport_d_arlen_i)
+    ,.axi_arburst_i(inport_d_arburst_i)
+    ,.axi_rready_i(inport_d_rready_i)
+    ,.req_accept_i(port_req_accept_w[1])
+    ,.resp_valid_i(port_resp_valid_w[1])
+    ,.resp_data_i(port_resp_data_w[1*LINE_W +: LINE_W])
+    ,.resp_error_i(port_resp_error_w[1])
+
+    ,.axi_awready_o(inport_d_awready_o)
+    ,.axi_wready_o(inport_d_wready_o)
+    ,.axi_bvalid_o(inport_d_bvalid_o)
+    ,.axi_bresp_o(inport_d_bresp_o)
+    ,.axi_bid_o(inport_d_bid_o)
+    ,.axi_arready_o(inport_d_arready_o)
+    ,.axi_rvalid_o(inport_d_rvalid_o)
+    ,.axi_rdata_o(inport_d_rdata_o)
+    ,.axi_rresp_o(inport_d_rresp_o)
+    ,.axi_rid_o(inport_d_rid_o)
+    ,.axi_rlast_o(inport_d_rlast_o)
+    ,.req_valid_o(port_req_valid_w[1])
+    ,.req_write_o(port_req_write_w[1])
+    ,.req_addr_o(port_req_addr_w[1*32 +: 32])
+    ,.req_len_o(port_req_len_w[1*8 +: 8])
+    ,.req_burst_o(port_req_burst_w[1*2 +: 2])
+    ,.req_data_o(port_req_data_w[1*LINE_W +: LINE_W])
+    ,.req_mask_o(port_req_mask_w[1*L2_LINE_SIZE +: L2_LINE_SIZE])
+);
+
+// Bank select (by line address)
+wire [L2_NUM_BANKS_W-1:0] port0_bank_w = port_req_addr_w[0*32 + L2_LINE_SIZE_W +: L2_NUM_BANKS_W];
+wire [L2_NUM_BANKS_W-1:0] port1_bank_w = port_req_addr_w[1*32 + L2_LINE_SIZE_W +: L2_NUM_BANKS_W];
+
+//-----------------------------------------------------------------
+// Banks
+//-----------------------------------------------------------------
+wire [(L2_NUM_BANKS*NUM_PORTS)-1:0]   bank_req_accept_w;
+wire [(L2_NUM_BANKS*NUM_PORTS)-1:0]   bank_resp_valid_w;
+wire [(L2_NUM_BANKS*LINE_W)-1:0]      bank_resp_data_w;
+wire [L2_NUM_BANKS-1:0]               bank_resp_error_w;
+wire [L2_NUM_BANKS-1:0]               bank_stat_hit_w;
+wire [L2_NUM_BANKS-1:0]               bank_stat_miss_w;
+wire [L2_NUM_BANKS-1:0]               bank_stat_evict_w;
+
+wire [L2_NUM_BANKS-1:0]               mem_awvalid_w;
+wire [(L2_NUM_BANKS*32)-1:0]          mem_awaddr_w;
+wire [(L2_NUM_BANKS*4)-1:0]           mem_awid_w;
+wire [(L2_NUM_BANKS*8)-1:0]           mem_awlen_w;
+wire [(L2_NUM_BANKS*2)-1:0]           mem_awburst_w;
+wire [L2_NUM_BANKS-1:0]               mem_wvalid_w;
+wire [(L2_NUM_BANKS*AXI_DATA_W)-1:0]  mem_wdata_w;
+wire [(L2_NUM_BANKS*AXI_DATA_W/8)-1:0] mem_wstrb_w;
+wire [L2_NUM_BANKS-1:0]               mem_wlast_w;
+wire [L2_NUM_BANKS-1:0]               mem_bready_w;
+wire [L2_NUM_BANKS-1:0]               mem_arvalid_w;
+wire [(L2_NUM_BANKS*32)-1:0]          mem_araddr_w;
+wire [(L2_NUM_BANKS*4)-1:0]           mem_arid_w;
+wire [(L2_NUM_BANKS*8)-1:0]           mem_arlen_w;
+wire [(L2_NUM_BANKS*2)-1:0]           mem_arburst_w;
+wire [L2_NUM_BANKS-1:0]               mem_rready_w;
+wire [L2_NUM_BANKS-1:0]               mem_awready_w;
+wire [L2_NUM_BANKS-1:0]               mem_wready_w;
+wire [L2_NUM_BANKS-1:0]               mem_bvalid_w;
+wire [(L2_NUM_BANKS*2)-1:0]           mem_bresp_w;
+wire [(L2_NUM_BANKS*4)-1:0]           mem_bid_w;
+wire [L2_NUM_BANKS-1:0]               mem_arready_w;
+wire [L2_NUM_BANKS-1:0]               mem_rvalid_w;
+wire [(L2_NUM_BANKS*AXI_DATA_W)-1:0]  mem_rdata_w;
+wire [(L2_NUM_BANKS*2)-1:0]           mem_rresp_w;
+wire [(L2_NUM_BANKS*4)-1:0]           mem_rid_w;
+wire [L2_NUM_BANKS-1:0]               mem_rlast_w;
+
+genvar g_bank;
+generate
+for (g_bank=0; g_bank<L2_NUM_BANKS; g_bank=g_bank+1)
+begin : BANK
+    wire [NUM_PORTS-1:0] req_valid_w;
+
+    assign req_valid_w[0] = port_req_valid_w[0] && (port0_bank_w == g_bank);
+    assign req_valid_w[1] = port_req_valid_w[1] && (port1_bank_w == g_bank);
+
+    l2cache_bank
+    #(
+         .L2_NUM_WAYS(L2_NUM_WAYS)
+        ,.L2_NUM_WAYS_W(L2_NUM_WAYS_W)
+        ,.L2_NUM_LINES(L2_NUM_LINES)
+        ,.L2_NUM_LINES_W(L2_NUM_LINES_W)
+        ,.L2_LINE_SIZE(L2_LINE_SIZE)
+        ,.L2_LINE_SIZE_W(L2_LINE_SIZE_W)
+        ,.L2_NUM_BANKS_W(L2_NUM_BANKS_W)
+        ,.AXI_DATA_W(AXI_DATA_W)
+        ,.AXI_ID(g_bank)
+        ,.MEM_CACHE_ADDR_MIN(MEM_CACHE_ADDR_MIN)
+        ,.MEM_CACHE_ADDR_MAX(MEM_CACHE_ADDR_MAX)
+    )
+    u_bank
+    (
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.req_valid_i(req_valid_w)
+        ,.req_write_i(port_req_write_w)
+        ,.req_addr_i(port_req_addr_w)
+        ,.req_len_i(port_req_len_w)
+        ,.req_burst_i(port_req_burst_w)
+        ,.req_data_i(port_req_data_w)
+        ,.req_mask_i(port_req_mask_w)
+        ,.axi_awready_i(mem_awready_w[g_bank])
+        ,.axi_wready_i(mem_wready_w[g_bank])
+        ,.axi_bvalid_i(mem_bvalid_w[g_bank])
+        ,.axi_bresp_i(mem_bresp_w[g_bank*2 +: 2])
+        ,.axi_bid_i(mem_bid_w[g_bank*4 +: 4])
+        ,.axi_arready_i(mem_arready_w[g_bank])
+        ,.axi_rvalid_i(mem_rvalid_w[g_bank])
+        ,.axi_rdata_i(mem_rdata_w[g_bank*AXI_DATA_W +: AXI_DATA_W])
+        ,.axi_rresp_i(mem_rresp_w[g_bank*2 +: 2])
+        ,.axi_rid_i(mem_rid_w[g_bank*4 +: 4])
+        ,.axi_rlast_i(mem_rlast_w[g_bank])
+
+        ,.req_accept_o(bank_req_accept_w[g_bank*NUM_PORTS +: NUM_PORTS])
+        ,.resp_valid_o(bank_resp_valid_w[g_bank*NUM_PORTS +: NUM_PORTS])
+        ,.resp_data_o(bank_resp_data_w[g_bank*LINE_W +: LINE_W])
+        ,.resp_error_o(bank_resp_error_w[g_bank])
+        ,.axi_awvalid_o(mem_awvalid_w[g_bank])
+        ,.axi_awaddr_o(mem_awaddr_w[g_bank*32 +: 32])
+        ,.axi_awid_o(mem_awid_w[g_bank*4 +: 4])
+        ,.axi_awlen_o(mem_awlen_w[g_bank*8 +: 8])
+        ,.axi_awburst_o(mem_awburst_w[g_bank*2 +: 2])
+        ,.axi_wvalid_o(mem_wvalid_w[g_bank])
+        ,.axi_wdata_o(mem_wdata_w[g_bank*AXI_DATA_W +: AXI_DATA_W])
+        ,.axi_wstrb_o(mem_wstrb_w[g_bank*(AXI_DATA_W/8) +: (AXI_DATA_W/8)])
+        ,.axi_wlast_o(mem_wlast_w[g_bank])
+        ,.axi_bready_o(mem_bready_w[g_bank])
+        ,.axi_arvalid_o(mem_arvalid_w[g_bank])
+        ,.axi_araddr_o(mem_araddr_w[g_bank*32 +: 32])
+        ,.axi_arid_o(mem_arid_w[g_bank*4 +: 4])
+        ,.axi_arlen_o(mem_arlen_w[g_bank*8 +: 8])
+        ,.axi_arburst_o(mem_arburst_w[g_bank*2 +: 2])
+        ,.axi_rready_o(mem_rready_w[g_bank])
+        ,.stat_hit_o(bank_stat_hit_w[g_bank])
+        ,.stat_miss_o(bank_stat_miss_w[g_bank])
+        ,.stat_evict_o(bank_stat_evict_w[g_bank])
+    );
+end
+endgenerate
+
+// Route bank handshakes / responses back to each port (port holds its
+// request address stable until the response arrives)
+assign port_req_accept_w[0] = bank_req_accept_w[port0_bank_w*NUM_PORTS + 0];
+assign port_req_accept_w[1] = bank_req_accept_w[port1_bank_w*NUM_PORTS + 1];
+assign port_resp_valid_w[0] = bank_resp_valid_w[port0_bank_w*NUM_PORTS + 0];
+assign port_resp_valid_w[1] = bank_resp_valid_w[port1_bank_w*NUM_PORTS + 1];
+assign port_resp_error_w[0] = bank_resp_error_w[port0_bank_w];
+assign port_resp_error_w[1] = bank_resp_error_w[port1_bank_w];
+assign port_resp_data_w[0*LINE_W +: LINE_W] = bank_resp_data_w[port0_bank_w*LINE_W +: LINE_W];
+assign port_resp_data_w[1*LINE_W +: LINE_W] = bank_resp_data_w[port1_bank_w*LINE_W +: LINE_W];
+
+//-----------------------------------------------------------------
+// Memory port arbitration (responses routed by bank AXI ID)
+//-----------------------------------------------------------------
+smp_axi_arb
+#(
+     .NUM_PORTS(L2_NUM_BANKS)
+    ,.NUM_PORTS_W(L2_NUM_BANKS_W)
+    ,.AXI_DATA_W(AXI_DATA_W)
+)
+u_axi_arb
+(
+     .clk_i(clk_i)
+    ,.rst_i(rst_i)
+    ,.inport_awvalid_i(mem_awvalid_w)
+    ,.inport_awaddr_i(mem_awaddr_w)
+    ,.inport_awid_i(mem_awid_w)
+    ,.inport_awlen_i(mem_awlen_w)
+    ,.inport_awburst_i(mem_awburst_w)
+    ,.inport_wvalid_i(mem_wvalid_w)
+    ,.inport_wdata_i(mem_wdata_w)
+    ,.inport_wstrb_i(mem_wstrb_w)
+    ,.inport_wlast_i(mem_wlast_w)
+    ,.inport_bready_i(mem_bready_w)
+    ,.inport_arvalid_i(mem_arvalid_w)
+    ,.inport_araddr_i(mem_araddr_w)
+    ,.inport_arid_i(mem_arid_w)
+    ,.inport_arlen_i(mem_arlen_w)
+    ,.inport_arburst_i(mem_arburst_w)
+    ,.inport_rready_i(mem_rready_w)
+    ,.outport_awready_i(outport_awready_i)
+    ,.outport_wready_i(outport_wready_i)
+    ,.outport_bvalid_i(outport_bvalid_i)
+    ,.outport_bresp_i(outport_bresp_i)
+    ,.outport_bid_i(outport_bid_i)
+    ,.outport_arready_i(outport_arready_i)
+    ,.outport_rvalid_i(outport_rvalid_i)
+    ,.outport_rdata_i(outport_rdata_i)
+    ,.outport_rresp_i(outport_rresp_i)
+    ,.outport_rid_i(outport_rid_i)
+    ,.outport_rlast_i(outport_rlast_i)
+
+    ,.inport_awready_o(mem_awready_w)
+    ,.inport_wready_o(mem_wready_w)
+    ,.inport_bvalid_o(mem_bvalid_w)
+    ,.inport_bresp_o(mem_bresp_w)
+    ,.inport_bid_o(mem_bid_w)
+    ,.inport_arready_o(mem_arready_w)
+    ,.inport_rvalid_o(mem_rvalid_w)
+    ,.inport_rdata_o(mem_rdata_w)
+    ,.inport_rresp_o(mem_rresp_w)
+    ,.inport_rid_o(mem_rid_w)
+    ,.inport_rlast_o(mem_rlast_w)
+    ,.outport_awvalid_o(outport_awvalid_o)
+    ,.outport_awaddr_o(outport_awaddr_o)
+    ,.outport_awid_o(outport_awid_o)
+    ,.outport_awlen_o(outport_awlen_o)
+    ,.outport_awburst_o(outport_awburst_o)
+    ,.outport_wvalid_o(outport_wvalid_o)
+    ,.outport_wdata_o(outport_wdata_o)
+    ,.outport_wstrb_o(outport_wstrb_o)
+    ,.outport_wlast_o(outport_wlast_o)
+    ,.outport_bready_o(outport_bready_o)
+    ,.outport_arvalid_o(outport_arvalid_o)
+    ,.outport_araddr_o(outport_araddr_o)
+    ,.outport_arid_o(outport_arid_o)
+    ,.outport_arlen_o(outport_arlen_o)
+    ,.outport_arburst_o(outport_arburst_o)
+    ,.outport_rready_o(outport_rready_o)
+);
+
+//-----------------------------------------------------------------
+// Stats
+//-----------------------------------------------------------------
+`ifdef verilator
+reg [31:0] stats_hit_q;
+reg [31:0] stats_miss_q;
+reg [31:0] stats_evict_q;
+
+integer i;
+reg [31:0] stats_hit_r;
+reg [31:0] stats_miss_r;
+reg [31:0] stats_evict_r;
+
+always @ *
+begin
+    stats_hit_r   = stats_hit_q;
+    stats_miss_r  = stats_miss_q;
+    stats_evict_r = stats_evict_q;
+
+    for (i=0;i<L2_NUM_BANKS;i=i+1)
+    begin
+        stats_hit_r   = stats_hit_r   + {31'b0, bank_stat_hit_w[i]};
+        stats_miss_r  = stats_miss_r  + {31'b0, bank_stat_miss_w[i]};
+        stats_evict_r = stats_evict_r + {31'b0, bank_stat_evict_w[i]};
+    end
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    stats_hit_q   <= 32'b0;
+    stats_miss_q  <= 32'b0;
+    stats_evict_q <= 32'b0;
+end
+else
+begin
+    stats_hit_q   <= stats_hit_r;
+    stats_miss_q  <= stats_miss_r;
+    stats_evict_q <= stats_evict_r;
+end
+
+function [31:0] get_hit_count; /*verilator public*/
+begin
+    get_hit_count = stats_hit_q;
+end
+endfunction
+function [31:0] get_miss_count; /*verilator public*/
+begin
+    get_miss_count = stats_miss_q;
+end
+endfunction
+function [31:0] get_evict_count; /*verilator public*/
+begin
+    get_evict_count = stats_evict_q;
+end
+endfunction
+`endif
+
+endmodule
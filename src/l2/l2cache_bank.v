@@ -0,0 +1,577 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+module l2cache_bank
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter L2_NUM_WAYS      = 4
+    ,parameter L2_NUM_WAYS_W    = 2
+    ,parameter L2_NUM_LINES     = 512
+    ,parameter L2_NUM_LINES_W   = 9
+    ,parameter L2_LINE_SIZE     = 32
+    ,parameter L2_LINE_SIZE_W   = 5
+    ,parameter L2_NUM_BANKS_W   = 1
+    ,parameter AXI_DATA_W       = 32
+    ,parameter AXI_ID           = 0
+    ,parameter MEM_CACHE_ADDR_MIN = 32'h80000000
+    ,parameter MEM_CACHE_ADDR_MAX = 32'h8fffffff
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input  [  1:0]  req_valid_i
+    ,input  [  1:0]  req_write_i
+    ,input  [ 63:0]  req_addr_i
+    ,input  [ 15:0]  req_len_i
+    ,input  [  3:0]  req_burst_i
+    ,input  [(2*L2_LINE_SIZE*8)-1:0] req_data_i
+    ,input  [(2*L2_LINE_SIZE)-1:0] req_mask_i
+    ,input           axi_awready_i
+    ,input           axi_wready_i
+    ,input           axi_bvalid_i
+    ,input  [  1:0]  axi_bresp_i
+    ,input  [  3:0]  axi_bid_i
+    ,input           axi_arready_i
+    ,input           axi_rvalid_i
+    ,input  [AXI_DATA_W-1:0] axi_rdata_i
+    ,input  [  1:0]  axi_rresp_i
+    ,input  [  3:0]  axi_rid_i
+    ,input           axi_rlast_i
+
+    // Outputs
+    ,output [  1:0]  req_accept_o
+    ,output [  1:0]  resp_valid_o
+    ,output [(L2_LINE_SIZE*8)-1:0] resp_data_o
+    ,output          resp_error_o
+    ,output          axi_awvalid_o
+    ,output [ 31:0]  axi_awaddr_o
+    ,output [  3:0]  axi_awid_o
+    ,output [  7:0]  axi_awlen_o
+    ,output [  1:0]  axi_awburst_o
+    ,output          axi_wvalid_o
+    ,output [AXI_DATA_W-1:0] axi_wdata_o
+    ,output [(AXI_DATA_W/8)-1:0] axi_wstrb_o
+    ,output          axi_wlast_o
+    ,output          axi_bready_o
+    ,output          axi_arvalid_o
+    ,output [ 31:0]  axi_araddr_o
+    ,output [  3:0]  axi_arid_o
+    ,output [  7:0]  axi_arlen_o
+    ,output [  1:0]  axi_arburst_o
+    ,output          axi_rready_o
+    ,output          stat_hit_o
+    ,output          stat_miss_o
+    ,output          stat_evict_o
+);
+
+//-----------------------------------------------------------------
+// This bank owns every L2_NUM_BANKS'th line (interleaved on the
+// line address) and serves one line request at a time from either
+// L1 port.  Banks run independently, so a miss in one bank does not
+// hold up hits (or other misses) in the others.
+//
+// Address = | TAG | SET (L2_NUM_LINES_W) | BANK | LINE OFFSET |
+// Tag entry = {valid, dirty, tag}
+//-----------------------------------------------------------------
+localparam STRB_W         = AXI_DATA_W / 8;
+localparam DATA_BYTES_W   = (AXI_DATA_W == 128) ? 4 : (AXI_DATA_W == 64) ? 3 : 2;
+localparam LINE_W         = L2_LINE_SIZE * 8;
+localparam LINE_BEATS     = L2_LINE_SIZE / STRB_W;
+localparam SET_LSB        = L2_LINE_SIZE_W + L2_NUM_BANKS_W;
+localparam TAG_W          = 32 - SET_LSB - L2_NUM_LINES_W;
+localparam TAG_ENTRY_W    = TAG_W + 2;
+localparam TAG_DIRTY_BIT  = TAG_W;
+localparam TAG_VALID_BIT  = TAG_W + 1;
+
+localparam STATE_W        = 4;
+localparam STATE_RESET    = 4'd0;
+localparam STATE_IDLE     = 4'd1;
+localparam STATE_LOOKUP   = 4'd2;
+localparam STATE_EVICT    = 4'd3;
+localparam STATE_REFILL   = 4'd4;
+localparam STATE_UPDATE   = 4'd5;
+localparam STATE_BYPASS_RD= 4'd6;
+localparam STATE_BYPASS_WR= 4'd7;
+localparam STATE_RESP     = 4'd8;
+
+reg [STATE_W-1:0]        state_q;
+reg                      port_q;
+reg                      last_port_q;
+reg                      write_q;
+reg [31:0]               addr_q;
+reg [7:0]                len_q;
+reg [1:0]                burst_q;
+reg [LINE_W-1:0]         data_q;
+reg [L2_LINE_SIZE-1:0]   mask_q;
+reg [LINE_W-1:0]         line_q;
+reg                      error_q;
+reg [L2_NUM_WAYS_W-1:0]  victim_q;
+reg [L2_NUM_WAYS_W-1:0]  replace_q;
+reg [L2_NUM_LINES_W-1:0] reset_addr_q;
+
+//-----------------------------------------------------------------
+// Next beat address (INCR / WRAP)
+//-----------------------------------------------------------------
+function [31:0] next_addr;
+    input [31:0] addr;
+    input [7:0]  len;
+    input [1:0]  burst;
+    reg   [31:0] mask;
+begin
+    /* verilator lint_off WIDTH */
+    mask = ((len + 32'd1) << DATA_BYTES_W) - 32'd1;
+    /* verilator lint_on WIDTH */
+
+    if (burst == 2'b10)
+        next_addr = (addr & ~mask) | ((addr + STRB_W) & mask);
+    else
+        next_addr = addr + STRB_W;
+end
+endfunction
+
+//-----------------------------------------------------------------
+// Request arbitration (alternate between ports when both waiting)
+//-----------------------------------------------------------------
+wire       pick_valid_w = (state_q == STATE_IDLE) && (|req_valid_i);
+wire       pick_port_w  = (req_valid_i == 2'b11) ? ~last_port_q : req_valid_i[1];
+
+wire [31:0] pick_addr_w = req_addr_i[pick_port_w*32 +: 32];
+
+/* verilator lint_off UNSIGNED */
+/* verilator lint_off CMPCONST */
+wire pick_cacheable_w = (pick_addr_w >= MEM_CACHE_ADDR_MIN && pick_addr_w <= MEM_CACHE_ADDR_MAX);
+/* verilator lint_on CMPCONST */
+/* verilator lint_on UNSIGNED */
+
+//-----------------------------------------------------------------
+// Tag / data RAMs (one of each per way)
+//-----------------------------------------------------------------
+reg  [L2_NUM_LINES_W-1:0]         ram_addr_r;
+reg  [L2_NUM_WAYS-1:0]            tag_write_r;
+reg  [TAG_ENTRY_W-1:0]            tag_data_r;
+reg  [L2_NUM_WAYS-1:0]            data_write_r;
+reg  [LINE_W-1:0]                 data_in_r;
+
+wire [(L2_NUM_WAYS*TAG_ENTRY_W)-1:0] tag_out_w;
+wire [(L2_NUM_WAYS*LINE_W)-1:0]      data_out_w;
+
+genvar g_way;
+generate
+for (g_way=0; g_way<L2_NUM_WAYS; g_way=g_way+1)
+begin : WAY
+    l2cache_ram
+    #(
+         .ADDR_W(L2_NUM_LINES_W)
+        ,.DATA_W(TAG_ENTRY_W)
+    )
+    u_tag
+    (
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.addr_i(ram_addr_r)
+        ,.data_i(tag_data_r)
+        ,.wr_i(tag_write_r[g_way])
+        ,.data_o(tag_out_w[g_way*TAG_ENTRY_W +: TAG_ENTRY_W])
+    );
+
+    l2cache_ram
+    #(
+         .ADDR_W(L2_NUM_LINES_W)
+        ,.DATA_W(LINE_W)
+    )
+    u_data
+    (
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.addr_i(ram_addr_r)
+        ,.data_i(data_in_r)
+        ,.wr_i(data_write_r[g_way])
+        ,.data_o(data_out_w[g_way*LINE_W +: LINE_W])
+    );
+end
+endgenerate
+
+//-----------------------------------------------------------------
+// Lookup
+//-----------------------------------------------------------------
+wire [TAG_W-1:0] req_tag_w = addr_q[31:32-TAG_W];
+
+reg                     hit_r;
+reg [L2_NUM_WAYS_W-1:0] hit_way_r;
+reg                     free_r;
+reg [L2_NUM_WAYS_W-1:0] free_way_r;
+
+integer i;
+
+/* verilator lint_off WIDTH */
+always @ *
+begin
+    hit_r      = 1'b0;
+    hit_way_r  = {L2_NUM_WAYS_W{1'b0}};
+    free_r     = 1'b0;
+    free_way_r = {L2_NUM_WAYS_W{1'b0}};
+
+    for (i=0;i<L2_NUM_WAYS;i=i+1)
+    begin
+        if (tag_out_w[i*TAG_ENTRY_W + TAG_VALID_BIT] &&
+            tag_out_w[i*TAG_ENTRY_W +: TAG_W] == req_tag_w)
+        begin
+            hit_r     = 1'b1;
+            hit_way_r = i;
+        end
+
+        if (!free_r && !tag_out_w[i*TAG_ENTRY_W + TAG_VALID_BIT])
+        begin
+            free_r     = 1'b1;
+            free_way_r = i;
+        end
+    end
+end
+/* verilator lint_on WIDTH */
+
+wire [L2_NUM_WAYS_W-1:0] victim_way_w   = free_r ? free_way_r : replace_q;
+wire [TAG_ENTRY_W-1:0]   victim_tag_w   = tag_out_w[victim_way_w*TAG_ENTRY_W +: TAG_ENTRY_W];
+wire                     victim_dirty_w = victim_tag_w[TAG_VALID_BIT] && victim_tag_w[TAG_DIRTY_BIT];
+wire [31:0]              victim_addr_w  = {victim_tag_w[TAG_W-1:0], addr_q[SET_LSB+L2_NUM_LINES_W-1:L2_LINE_SIZE_W], {L2_LINE_SIZE_W{1'b0}}};
+
+wire [LINE_W-1:0]        hit_data_w     = data_out_w[hit_way_r*LINE_W +: LINE_W];
+
+// A write covering the whole line doesn't need the old contents
+wire                     need_fill_w    = !write_q || !(&mask_q);
+
+//-----------------------------------------------------------------
+// Write merge
+//-----------------------------------------------------------------
+wire [LINE_W-1:0] mask_bits_w;
+
+genvar g_byte;
+generate
+for (g_byte=0; g_byte<L2_LINE_SIZE; g_byte=g_byte+1)
+begin : MASK
+    assign mask_bits_w[g_byte*8 +: 8] = {8{mask_q[g_byte]}};
+end
+endgenerate
+
+wire [LINE_W-1:0] hit_merge_w  = (hit_data_w & ~mask_bits_w) | (data_q & mask_bits_w);
+wire [LINE_W-1:0] fill_merge_w = write_q ? ((line_q & ~mask_bits_w) | (data_q & mask_bits_w)) : line_q;
+
+//-----------------------------------------------------------------
+// Memory side state
+//-----------------------------------------------------------------
+reg [31:0] mem_base_q;
+reg [31:0] mem_addr_q;
+reg [7:0]  mem_count_q;
+reg        ar_pending_q;
+reg        aw_pending_q;
+reg        w_done_q;
+
+wire       mem_bypass_w = (state_q == STATE_BYPASS_RD) || (state_q == STATE_BYPASS_WR);
+/* verilator lint_off WIDTH */
+wire [7:0] mem_len_w    = mem_bypass_w ? len_q   : (LINE_BEATS - 1);
+/* verilator lint_on WIDTH */
+wire [1:0] mem_burst_w  = mem_bypass_w ? burst_q : 2'b01;
+
+wire [L2_LINE_SIZE_W-DATA_BYTES_W-1:0] mem_beat_w = mem_addr_q[L2_LINE_SIZE_W-1:DATA_BYTES_W];
+
+wire r_accept_w   = axi_rvalid_i && axi_rready_o;
+wire w_accept_w   = axi_wvalid_o && axi_wready_i;
+wire b_accept_w   = axi_bvalid_i && axi_bready_o;
+
+//-----------------------------------------------------------------
+// RAM control
+//-----------------------------------------------------------------
+always @ *
+begin
+    tag_write_r  = {L2_NUM_WAYS{1'b0}};
+    tag_data_r   = {1'b1, write_q, req_tag_w};
+    data_write_r = {L2_NUM_WAYS{1'b0}};
+    data_in_r    = fill_merge_w;
+
+    if (state_q == STATE_RESET)
+        ram_addr_r = reset_addr_q;
+    else if (state_q == STATE_IDLE)
+        ram_addr_r = pick_addr_w[SET_LSB +: L2_NUM_LINES_W];
+    else
+        ram_addr_r = addr_q[SET_LSB +: L2_NUM_LINES_W];
+
+    case (state_q)
+    STATE_RESET:
+    begin
+        tag_write_r = {L2_NUM_WAYS{1'b1}};
+        tag_data_r  = {TAG_ENTRY_W{1'b0}};
+    end
+    STATE_LOOKUP:
+    begin
+        // Write hit - merge into the line and mark dirty
+        if (hit_r && write_q)
+        begin
+            tag_write_r[hit_way_r]  = 1'b1;
+            data_write_r[hit_way_r] = 1'b1;
+            data_in_r               = hit_merge_w;
+        end
+    end
+    STATE_UPDATE:
+    begin
+        tag_write_r[victim_q]  = 1'b1;
+        data_write_r[victim_q] = 1'b1;
+    end
+    default:
+        ;
+    endcase
+end
+
+//-----------------------------------------------------------------
+// State machine
+//-----------------------------------------------------------------
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    state_q      <= STATE_RESET;
+    port_q       <= 1'b0;
+    last_port_q  <= 1'b0;
+    write_q      <= 1'b0;
+    addr_q       <= 32'b0;
+    len_q        <= 8'b0;
+    burst_q      <= 2'b0;
+    data_q       <= {LINE_W{1'b0}};
+    mask_q       <= {L2_LINE_SIZE{1'b0}};
+    line_q       <= {LINE_W{1'b0}};
+    error_q      <= 1'b0;
+    victim_q     <= {L2_NUM_WAYS_W{1'b0}};
+    replace_q    <= {L2_NUM_WAYS_W{1'b0}};
+    reset_addr_q <= {L2_NUM_LINES_W{1'b0}};
+    mem_base_q   <= 32'b0;
+    mem_addr_q   <= 32'b0;
+    mem_count_q  <= 8'b0;
+    ar_pending_q <= 1'b0;
+    aw_pending_q <= 1'b0;
+    w_done_q     <= 1'b0;
+end
+else
+begin
+    if (axi_arvalid_o && axi_arready_i)
+        ar_pending_q <= 1'b0;
+    if (axi_awvalid_o && axi_awready_i)
+        aw_pending_q <= 1'b0;
+
+    case (state_q)
+    //-----------------------------------------
+    // STATE_RESET: invalidate all tags
+    //-----------------------------------------
+    STATE_RESET:
+    begin
+        reset_addr_q <= reset_addr_q + 1;
+
+        if (&reset_addr_q)
+            state_q <= STATE_IDLE;
+    end
+    //-----------------------------------------
+    // STATE_IDLE: accept a request
+    //-----------------------------------------
+    STATE_IDLE:
+    begin
+        if (pick_valid_w)
+        begin
+            port_q      <= pick_port_w;
+            last_port_q <= pick_port_w;
+            write_q     <= req_write_i[pick_port_w];
+            addr_q      <= pick_addr_w;
+            len_q       <= req_len_i[pick_port_w*8 +: 8];
+            burst_q     <= req_burst_i[pick_port_w*2 +: 2];
+            data_q      <= req_data_i[pick_port_w*LINE_W +: LINE_W];
+            mask_q      <= req_mask_i[pick_port_w*L2_LINE_SIZE +: L2_LINE_SIZE];
+            error_q     <= 1'b0;
+
+            // Uncached - replay the original burst to memory
+            if (!pick_cacheable_w)
+            begin
+                mem_base_q  <= pick_addr_w;
+                mem_addr_q  <= pick_addr_w;
+                mem_count_q <= 8'b0;
+                w_done_q    <= 1'b0;
+
+                if (req_write_i[pick_port_w])
+                begin
+                    aw_pending_q <= 1'b1;
+                    state_q      <= STATE_BYPASS_WR;
+                end
+                else
+                begin
+                    ar_pending_q <= 1'b1;
+                    state_q      <= STATE_BYPASS_RD;
+                end
+            end
+            else
+                state_q <= STATE_LOOKUP;
+        end
+    end
+    //-----------------------------------------
+    // STATE_LOOKUP: tag compare
+    //-----------------------------------------
+    STATE_LOOKUP:
+    begin
+        if (hit_r)
+            state_q <= STATE_IDLE;
+        else
+        begin
+            victim_q    <= victim_way_w;
+            mem_count_q <= 8'b0;
+            w_done_q    <= 1'b0;
+
+            if (!free_r)
+                replace_q <= replace_q + 1;
+
+            // Write back dirty victim first
+            if (victim_dirty_w)
+            begin
+                line_q       <= data_out_w[victim_way_w*LINE_W +: LINE_W];
+                mem_base_q   <= victim_addr_w;
+                mem_addr_q   <= victim_addr_w;
+                aw_pending_q <= 1'b1;
+                state_q      <= STATE_EVICT;
+            end
+            else if (need_fill_w)
+            begin
+                mem_base_q   <= {addr_q[31:L2_LINE_SIZE_W], {L2_LINE_SIZE_W{1'b0}}};
+                mem_addr_q   <= {addr_q[31:L2_LINE_SIZE_W], {L2_LINE_SIZE_W{1'b0}}};
+                ar_pending_q <= 1'b1;
+                state_q      <= STATE_REFILL;
+            end
+            else
+                state_q <= STATE_UPDATE;
+        end
+    end
+    //-----------------------------------------
+    // STATE_EVICT / STATE_BYPASS_WR: write burst
+    //-----------------------------------------
+    STATE_EVICT,
+    STATE_BYPASS_WR:
+    begin
+        if (w_accept_w)
+        begin
+            mem_addr_q  <= next_addr(mem_addr_q, mem_len_w, mem_burst_w);
+            mem_count_q <= mem_count_q + 8'd1;
+
+            if (axi_wlast_o)
+                w_done_q <= 1'b1;
+        end
+
+        if (b_accept_w)
+        begin
+            error_q <= error_q | (axi_bresp_i != 2'b00);
+
+            if (state_q == STATE_BYPASS_WR)
+                state_q <= STATE_RESP;
+            else if (need_fill_w)
+            begin
+                mem_base_q   <= {addr_q[31:L2_LINE_SIZE_W], {L2_LINE_SIZE_W{1'b0}}};
+                mem_addr_q   <= {addr_q[31:L2_LINE_SIZE_W], {L2_LINE_SIZE_W{1'b0}}};
+                mem_count_q  <= 8'b0;
+                ar_pending_q <= 1'b1;
+                state_q      <= STATE_REFILL;
+            end
+            else
+                state_q <= STATE_UPDATE;
+        end
+    end
+    //-----------------------------------------
+    // STATE_REFILL / STATE_BYPASS_RD: read burst
+    //-----------------------------------------
+    STATE_REFILL,
+    STATE_BYPASS_RD:
+    begin
+        if (r_accept_w)
+        begin
+            line_q[mem_beat_w*AXI_DATA_W +: AXI_DATA_W] <= axi_rdata_i;
+            mem_addr_q <= next_addr(mem_addr_q, mem_len_w, mem_burst_w);
+            error_q    <= error_q | (axi_rresp_i != 2'b00);
+
+            if (axi_rlast_i)
+                state_q <= (state_q == STATE_REFILL) ? STATE_UPDATE : STATE_RESP;
+        end
+    end
+    //-----------------------------------------
+    // STATE_UPDATE: allocate line, respond
+    //-----------------------------------------
+    STATE_UPDATE,
+    STATE_RESP:
+        state_q <= STATE_IDLE;
+    default:
+        state_q <= STATE_IDLE;
+    endcase
+end
+
+//-----------------------------------------------------------------
+// Port interface
+//-----------------------------------------------------------------
+wire resp_w = ((state_q == STATE_LOOKUP) && hit_r) ||
+              (state_q == STATE_UPDATE) ||
+              (state_q == STATE_RESP);
+
+assign req_accept_o = pick_valid_w ? (pick_port_w ? 2'b10 : 2'b01) : 2'b00;
+assign resp_valid_o = resp_w ? (port_q ? 2'b10 : 2'b01) : 2'b00;
+assign resp_data_o  = (state_q == STATE_LOOKUP) ? hit_data_w : line_q;
+assign resp_error_o = error_q;
+
+//-----------------------------------------------------------------
+// AXI master
+//-----------------------------------------------------------------
+wire mem_write_w = (state_q == STATE_EVICT) || (state_q == STATE_BYPASS_WR);
+wire mem_read_w  = (state_q == STATE_REFILL) || (state_q == STATE_BYPASS_RD);
+
+assign axi_arvalid_o = ar_pending_q;
+assign axi_araddr_o  = mem_base_q;
+assign axi_arid_o    = AXI_ID;
+assign axi_arlen_o   = mem_len_w;
+assign axi_arburst_o = mem_burst_w;
+assign axi_rready_o  = mem_read_w;
+
+assign axi_awvalid_o = aw_pending_q;
+assign axi_awaddr_o  = mem_base_q;
+assign axi_awid_o    = AXI_ID;
+assign axi_awlen_o   = mem_len_w;
+assign axi_awburst_o = mem_burst_w;
+
+assign axi_wvalid_o  = mem_write_w && !w_done_q;
+assign axi_wdata_o   = (state_q == STATE_EVICT) ? line_q[mem_beat_w*AXI_DATA_W +: AXI_DATA_W] :
+                                                  data_q[mem_beat_w*AXI_DATA_W +: AXI_DATA_W];
+assign axi_wstrb_o   = (state_q == STATE_EVICT) ? {STRB_W{1'b1}} :
+                                                  mask_q[mem_beat_w*STRB_W +: STRB_W];
+assign axi_wlast_o   = (mem_count_q == mem_len_w);
+assign axi_bready_o  = mem_write_w;
+
+//-----------------------------------------------------------------
+// Stats
+//-----------------------------------------------------------------
+assign stat_hit_o   = (state_q == STATE_LOOKUP) && hit_r;
+assign stat_miss_o  = (state_q == STATE_LOOKUP) && !hit_r;
+assign stat_evict_o = (state_q == STATE_LOOKUP) && !hit_r && victim_dirty_w;
+
+endmodule
@@ -0,0 +1,262 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+module l2cache_port
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter L2_LINE_SIZE     = 32
+    ,parameter L2_LINE_SIZE_W   = 5
+    ,parameter AXI_DATA_W       = 32
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input           axi_awvalid_i
+    ,input  [ 31:0]  axi_awaddr_i
+    ,input  [  3:0]  axi_awid_i
+    ,input  [  7:0]  axi_awlen_i
+    ,input  [  1:0]  axi_awburst_i
+    ,input           axi_wvalid_i
+    ,input  [AXI_DATA_W-1:0] axi_wdata_i
+    ,input  [(AXI_DATA_W/8)-1:0] axi_wstrb_i
+    ,input           axi_wlast_i
+    ,input           axi_bready_i
+    ,input           axi_arvalid_i
+    ,input  [ 31:0]  axi_araddr_i
+    ,input  [  3:0]  axi_arid_i
+    ,input  [  7:0]  axi_arlen_i
+    ,input  [  1:0]  axi_arburst_i
+    ,input           axi_rready_i
+    ,input           req_accept_i
+    ,input           resp_valid_i
+    ,input  [(L2_LINE_SIZE*8)-1:0] resp_data_i
+    ,input           resp_error_i
+
+    // Outputs
+    ,output          axi_awready_o
+    ,output          axi_wready_o
+    ,output          axi_bvalid_o
+    ,output [  1:0]  axi_bresp_o
+    ,output [  3:0]  axi_bid_o
+    ,output          axi_arready_o
+    ,output          axi_rvalid_o
+    ,output [AXI_DATA_W-1:0] axi_rdata_o
+    ,output [  1:0]  axi_rresp_o
+    ,output [  3:0]  axi_rid_o
+    ,output          axi_rlast_o
+    ,output          req_valid_o
+    ,output          req_write_o
+    ,output [ 31:0]  req_addr_o
+    ,output [  7:0]  req_len_o
+    ,output [  1:0]  req_burst_o
+    ,output [(L2_LINE_SIZE*8)-1:0] req_data_o
+    ,output [L2_LINE_SIZE-1:0] req_mask_o
+);
+
+//-----------------------------------------------------------------
+// AXI4 slave front end for one L1 cache.
+// One burst is handled at a time; write bursts are gathered into a
+// line buffer (+ byte mask) and read bursts are replayed from the
+// line returned by the bank, in the order of the original burst
+// (INCR or WRAP).
+//-----------------------------------------------------------------
+localparam STRB_W         = AXI_DATA_W / 8;
+localparam DATA_BYTES_W   = (AXI_DATA_W == 128) ? 4 : (AXI_DATA_W == 64) ? 3 : 2;
+localparam LINE_W         = L2_LINE_SIZE * 8;
+
+localparam STATE_W        = 3;
+localparam STATE_IDLE     = 3'd0;
+localparam STATE_WDATA    = 3'd1;
+localparam STATE_REQ      = 3'd2;
+localparam STATE_WAIT     = 3'd3;
+localparam STATE_RDATA    = 3'd4;
+localparam STATE_BRESP    = 3'd5;
+
+reg [STATE_W-1:0]     state_q;
+reg                   write_q;
+reg [3:0]             id_q;
+reg [31:0]            req_addr_q;
+reg [31:0]            addr_q;
+reg [7:0]             len_q;
+reg [1:0]             burst_q;
+reg [7:0]             count_q;
+reg [LINE_W-1:0]      line_q;
+reg [L2_LINE_SIZE-1:0] mask_q;
+reg                   error_q;
+
+//-----------------------------------------------------------------
+// Next beat address (INCR / WRAP)
+//-----------------------------------------------------------------
+function [31:0] next_addr;
+    input [31:0] addr;
+    input [7:0]  len;
+    input [1:0]  burst;
+    reg   [31:0] mask;
+begin
+    /* verilator lint_off WIDTH */
+    mask = ((len + 32'd1) << DATA_BYTES_W) - 32'd1;
+    /* verilator lint_on WIDTH */
+
+    if (burst == 2'b10)
+        next_addr = (addr & ~mask) | ((addr + STRB_W) & mask);
+    else
+        next_addr = addr + STRB_W;
+end
+endfunction
+
+wire [L2_LINE_SIZE_W-DATA_BYTES_W-1:0] beat_w = addr_q[L2_LINE_SIZE_W-1:DATA_BYTES_W];
+
+wire aw_accept_w = (state_q == STATE_IDLE) && axi_awvalid_i;
+wire ar_accept_w = (state_q == STATE_IDLE) && !axi_awvalid_i && axi_arvalid_i;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    state_q    <= STATE_IDLE;
+    write_q    <= 1'b0;
+    id_q       <= 4'b0;
+    req_addr_q <= 32'b0;
+    addr_q     <= 32'b0;
+    len_q      <= 8'b0;
+    burst_q    <= 2'b0;
+    count_q    <= 8'b0;
+    line_q     <= {LINE_W{1'b0}};
+    mask_q     <= {L2_LINE_SIZE{1'b0}};
+    error_q    <= 1'b0;
+end
+else
+begin
+    case (state_q)
+    STATE_IDLE:
+    begin
+        if (aw_accept_w)
+        begin
+            write_q    <= 1'b1;
+            id_q       <= axi_awid_i;
+            req_addr_q <= axi_awaddr_i;
+            addr_q     <= axi_awaddr_i;
+            len_q      <= axi_awlen_i;
+            burst_q    <= axi_awburst_i;
+            mask_q     <= {L2_LINE_SIZE{1'b0}};
+            state_q    <= STATE_WDATA;
+        end
+        else if (ar_accept_w)
+        begin
+            write_q    <= 1'b0;
+            id_q       <= axi_arid_i;
+            req_addr_q <= axi_araddr_i;
+            addr_q     <= axi_araddr_i;
+            len_q      <= axi_arlen_i;
+            burst_q    <= axi_arburst_i;
+            mask_q     <= {L2_LINE_SIZE{1'b0}};
+            state_q    <= STATE_REQ;
+        end
+    end
+    STATE_WDATA:
+    begin
+        if (axi_wvalid_i)
+        begin
+            line_q[beat_w*AXI_DATA_W +: AXI_DATA_W] <= axi_wdata_i;
+            mask_q[beat_w*STRB_W +: STRB_W]         <= axi_wstrb_i;
+            addr_q <= next_addr(addr_q, len_q, burst_q);
+
+            if (axi_wlast_i)
+                state_q <= STATE_REQ;
+        end
+    end
+    STATE_REQ:
+    begin
+        if (req_accept_i)
+            state_q <= STATE_WAIT;
+    end
+    STATE_WAIT:
+    begin
+        if (resp_valid_i)
+        begin
+            error_q <= resp_error_i;
+            addr_q  <= req_addr_q;
+            count_q <= 8'b0;
+
+            if (write_q)
+                state_q <= STATE_BRESP;
+            else
+            begin
+                line_q  <= resp_data_i;
+                state_q <= STATE_RDATA;
+            end
+        end
+    end
+    STATE_RDATA:
+    begin
+        if (axi_rready_i)
+        begin
+            addr_q  <= next_addr(addr_q, len_q, burst_q);
+            count_q <= count_q + 8'd1;
+
+            if (count_q == len_q)
+                state_q <= STATE_IDLE;
+        end
+    end
+    STATE_BRESP:
+    begin
+        if (axi_bready_i)
+            state_q <= STATE_IDLE;
+    end
+    default:
+        state_q <= STATE_IDLE;
+    endcase
+end
+
+//-----------------------------------------------------------------
+// Outputs
+//-----------------------------------------------------------------
+assign axi_awready_o = (state_q == STATE_IDLE);
+assign axi_arready_o = (state_q == STATE_IDLE) && !axi_awvalid_i;
+assign axi_wready_o  = (state_q == STATE_WDATA);
+
+assign axi_bvalid_o  = (state_q == STATE_BRESP);
+assign axi_bresp_o   = error_q ? 2'b10 : 2'b00;
+assign axi_bid_o     = id_q;
+
+assign axi_rvalid_o  = (state_q == STATE_RDATA);
+assign axi_rdata_o   = line_q[beat_w*AXI_DATA_W +: AXI_DATA_W];
+assign axi_rresp_o   = error_q ? 2'b10 : 2'b00;
+assign axi_rid_o     = id_q;
+assign axi_rlast_o   = (count_q == len_q);
+
+assign req_valid_o   = (state_q == STATE_REQ);
+assign req_write_o   = write_q;
+assign req_addr_o    = req_addr_q;
+assign req_len_o     = len_q;
+assign req_burst_o   = burst_q;
+assign req_data_o    = line_q;
+assign req_mask_o    = mask_q;
+
+endmodule
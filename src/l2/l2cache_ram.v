@@ -0,0 +1,66 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+module l2cache_ram
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter ADDR_W           = 9
+    ,parameter DATA_W           = 256
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input  [ADDR_W-1:0] addr_i
+    ,input  [DATA_W-1:0] data_i
+    ,input           wr_i
+
+    // Outputs
+    ,output [DATA_W-1:0] data_o
+);
+
+//-----------------------------------------------------------------
+// Single Port RAM ((2^ADDR_W) x DATA_W)
+// Mode: Read First
+//-----------------------------------------------------------------
+reg [DATA_W-1:0]   ram [(1 << ADDR_W)-1:0] /*verilator public*/;
+reg [DATA_W-1:0]   ram_read_q;
+
+// Synchronous write
+always @ (posedge clk_i)
+begin
+    if (wr_i)
+        ram[addr_i] <= data_i;
+
+    ram_read_q <= ram[addr_i];
+end
+
+assign data_o = ram_read_q;
+
+endmodule
@@ -0,0 +1,263 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+module smp_axi_arb
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter NUM_PORTS        = 4
+    ,parameter NUM_PORTS_W      = 2
+    ,parameter AXI_DATA_W       = 32
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input                                    clk_i
+    ,input                                    rst_i
+    ,input  [NUM_PORTS-1:0]                   inport_awvalid_i
+    ,input  [(NUM_PORTS*32)-1:0]              inport_awaddr_i
+    ,input  [(NUM_PORTS*4)-1:0]               inport_awid_i
+    ,input  [(NUM_PORTS*8)-1:0]               inport_awlen_i
+    ,input  [(NUM_PORTS*2)-1:0]               inport_awburst_i
+    ,input  [NUM_PORTS-1:0]                   inport_wvalid_i
+    ,input  [(NUM_PORTS*AXI_DATA_W)-1:0]      inport_wdata_i
+    ,input  [(NUM_PORTS*AXI_DATA_W/8)-1:0]    inport_wstrb_i
+    ,input  [NUM_PORTS-1:0]                   inport_wlast_i
+    ,input  [NUM_PORTS-1:0]                   inport_bready_i
+    ,input  [NUM_PORTS-1:0]                   inport_arvalid_i
+    ,input  [(NUM_PORTS*32)-1:0]              inport_araddr_i
+    ,input  [(NUM_PORTS*4)-1:0]               inport_arid_i
+    ,input  [(NUM_PORTS*8)-1:0]               inport_arlen_i
+    ,input  [(NUM_PORTS*2)-1:0]               inport_arburst_i
+    ,input  [NUM_PORTS-1:0]                   inport_rready_i
+    ,input                                    outport_awready_i
+    ,input                                    outport_wready_i
+    ,input                                    outport_bvalid_i
+    ,input  [  1:0]                           outport_bresp_i
+    ,input  [  3:0]                           outport_bid_i
+    ,input                                    outport_arready_i
+    ,input                                    outport_rvalid_i
+    ,input  [AXI_DATA_W-1:0]                  outport_rdata_i
+    ,input  [  1:0]                           outport_rresp_i
+    ,input  [  3:0]                           outport_rid_i
+    ,input                                    outport_rlast_i
+
+    // Outputs
+    ,output [NUM_PORTS-1:0]                   inport_awready_o
+    ,output [NUM_PORTS-1:0]                   inport_wready_o
+    ,output [NUM_PORTS-1:0]                   inport_bvalid_o
+    ,output [(NUM_PORTS*2)-1:0]               inport_bresp_o
+    ,output [(NUM_PORTS*4)-1:0]               inport_bid_o
+    ,output [NUM_PORTS-1:0]                   inport_arready_o
+    ,output [NUM_PORTS-1:0]                   inport_rvalid_o
+    ,output [(NUM_PORTS*AXI_DATA_W)-1:0]      inport_rdata_o
+    ,output [(NUM_PORTS*2)-1:0]               inport_rresp_o
+    ,output [(NUM_PORTS*4)-1:0]               inport_rid_o
+    ,output [NUM_PORTS-1:0]                   inport_rlast_o
+    ,output                                   outport_awvalid_o
+    ,output [ 31:0]                           outport_awaddr_o
+    ,output [  3:0]                           outport_awid_o
+    ,output [  7:0]                           outport_awlen_o
+    ,output [  1:0]                           outport_awburst_o
+    ,output                                   outport_wvalid_o
+    ,output [AXI_DATA_W-1:0]                  outport_wdata_o
+    ,output [(AXI_DATA_W/8)-1:0]              outport_wstrb_o
+    ,output                                   outport_wlast_o
+    ,output                                   outport_bready_o
+    ,output                                   outport_arvalid_o
+    ,output [ 31:0]                           outport_araddr_o
+    ,output [  3:0]                           outport_arid_o
+    ,output [  7:0]                           outport_arlen_o
+    ,output [  1:0]                           outport_arburst_o
+    ,output                                   outport_rready_o
+);
+
+//-----------------------------------------------------------------
+// N:1 AXI4 arbiter.
+// Each input port must issue a unique AXI ID equal to its port
+// index - read / write responses are routed back by ID.
+//-----------------------------------------------------------------
+localparam STRB_W = AXI_DATA_W / 8;
+
+integer i;
+
+//-----------------------------------------------------------------
+// Read address: round robin, held whilst the winner is stalled
+//-----------------------------------------------------------------
+reg                   ar_hold_q;
+reg [NUM_PORTS_W-1:0] ar_idx_q;
+reg [NUM_PORTS_W-1:0] ar_last_q;
+
+reg [NUM_PORTS_W-1:0] ar_pick_r;
+reg [NUM_PORTS_W:0]   ar_try_r;
+
+/* verilator lint_off WIDTH */
+always @ *
+begin
+    ar_pick_r = ar_last_q;
+
+    for (i=NUM_PORTS;i>0;i=i-1)
+    begin
+        ar_try_r = ar_last_q + i;
+        if (ar_try_r >= NUM_PORTS)
+            ar_try_r = ar_try_r - NUM_PORTS;
+
+        if (inport_arvalid_i[ar_try_r])
+            ar_pick_r = ar_try_r;
+    end
+end
+/* verilator lint_on WIDTH */
+
+wire [NUM_PORTS_W-1:0] ar_sel_w = ar_hold_q ? ar_idx_q : ar_pick_r;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    ar_hold_q <= 1'b0;
+    ar_idx_q  <= {NUM_PORTS_W{1'b0}};
+    ar_last_q <= {NUM_PORTS_W{1'b0}};
+end
+else
+begin
+    ar_hold_q <= outport_arvalid_o && !outport_arready_i;
+    ar_idx_q  <= ar_sel_w;
+
+    if (outport_arvalid_o && outport_arready_i)
+        ar_last_q <= ar_sel_w;
+end
+
+assign outport_arvalid_o = inport_arvalid_i[ar_sel_w];
+assign outport_araddr_o  = inport_araddr_i[ar_sel_w*32 +: 32];
+assign outport_arid_o    = inport_arid_i[ar_sel_w*4 +: 4];
+assign outport_arlen_o   = inport_arlen_i[ar_sel_w*8 +: 8];
+assign outport_arburst_o = inport_arburst_i[ar_sel_w*2 +: 2];
+
+assign inport_arready_o  = {{(NUM_PORTS-1){1'b0}}, outport_arready_i} << ar_sel_w;
+
+//-----------------------------------------------------------------
+// Write address + data: port owns both channels until its
+// address has been accepted and its last data beat sent.
+//-----------------------------------------------------------------
+reg                   wr_busy_q;
+reg [NUM_PORTS_W-1:0] wr_idx_q;
+reg                   aw_done_q;
+reg                   w_done_q;
+
+reg [NUM_PORTS_W-1:0] aw_pick_r;
+reg [NUM_PORTS_W:0]   aw_try_r;
+reg                   aw_pick_valid_r;
+
+/* verilator lint_off WIDTH */
+always @ *
+begin
+    aw_pick_r       = wr_idx_q;
+    aw_pick_valid_r = 1'b0;
+
+    for (i=NUM_PORTS;i>0;i=i-1)
+    begin
+        aw_try_r = wr_idx_q + i;
+        if (aw_try_r >= NUM_PORTS)
+            aw_try_r = aw_try_r - NUM_PORTS;
+
+        if (inport_awvalid_i[aw_try_r])
+        begin
+            aw_pick_r       = aw_try_r;
+            aw_pick_valid_r = 1'b1;
+        end
+    end
+end
+/* verilator lint_on WIDTH */
+
+wire aw_accept_w = outport_awvalid_o && outport_awready_i;
+wire w_accept_w  = outport_wvalid_o && outport_wready_i && outport_wlast_o;
+wire wr_done_w   = (aw_done_q || aw_accept_w) && (w_done_q || w_accept_w);
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    wr_busy_q <= 1'b0;
+    wr_idx_q  <= {NUM_PORTS_W{1'b0}};
+    aw_done_q <= 1'b0;
+    w_done_q  <= 1'b0;
+end
+else if (!wr_busy_q)
+begin
+    if (aw_pick_valid_r)
+    begin
+        wr_busy_q <= 1'b1;
+        wr_idx_q  <= aw_pick_r;
+    end
+    aw_done_q <= 1'b0;
+    w_done_q  <= 1'b0;
+end
+else if (wr_done_w)
+begin
+    wr_busy_q <= 1'b0;
+    aw_done_q <= 1'b0;
+    w_done_q  <= 1'b0;
+end
+else
+begin
+    if (aw_accept_w)
+        aw_done_q <= 1'b1;
+    if (w_accept_w)
+        w_done_q  <= 1'b1;
+end
+
+assign outport_awvalid_o = wr_busy_q && !aw_done_q && inport_awvalid_i[wr_idx_q];
+assign outport_awaddr_o  = inport_awaddr_i[wr_idx_q*32 +: 32];
+assign outport_awid_o    = inport_awid_i[wr_idx_q*4 +: 4];
+assign outport_awlen_o   = inport_awlen_i[wr_idx_q*8 +: 8];
+assign outport_awburst_o = inport_awburst_i[wr_idx_q*2 +: 2];
+
+assign outport_wvalid_o  = wr_busy_q && !w_done_q && inport_wvalid_i[wr_idx_q];
+assign outport_wdata_o   = inport_wdata_i[wr_idx_q*AXI_DATA_W +: AXI_DATA_W];
+assign outport_wstrb_o   = inport_wstrb_i[wr_idx_q*STRB_W +: STRB_W];
+assign outport_wlast_o   = inport_wlast_i[wr_idx_q];
+
+assign inport_awready_o  = {{(NUM_PORTS-1){1'b0}}, (wr_busy_q && !aw_done_q && outport_awready_i)} << wr_idx_q;
+assign inport_wready_o   = {{(NUM_PORTS-1){1'b0}}, (wr_busy_q && !w_done_q && outport_wready_i)} << wr_idx_q;
+
+//-----------------------------------------------------------------
+// Responses: routed by ID
+//-----------------------------------------------------------------
+wire [NUM_PORTS_W-1:0] r_idx_w = outport_rid_i[NUM_PORTS_W-1:0];
+wire [NUM_PORTS_W-1:0] b_idx_w = outport_bid_i[NUM_PORTS_W-1:0];
+
+assign inport_rvalid_o   = {{(NUM_PORTS-1){1'b0}}, outport_rvalid_i} << r_idx_w;
+assign inport_rdata_o    = {NUM_PORTS{outport_rdata_i}};
+assign inport_rresp_o    = {NUM_PORTS{outport_rresp_i}};
+assign inport_rid_o      = {NUM_PORTS{outport_rid_i}};
+assign inport_rlast_o    = {NUM_PORTS{outport_rlast_i}};
+assign outport_rready_o  = inport_rready_i[r_idx_w];
+
+assign inport_bvalid_o   = {{(NUM_PORTS-1){1'b0}}, outport_bvalid_i} << b_idx_w;
+assign inport_bresp_o    = {NUM_PORTS{outport_bresp_i}};
+assign inport_bid_o      = {NUM_PORTS{outport_bid_i}};
+assign outport_bready_o  = inport_bready_i[b_idx_w];
+
+endmodule
@@ -0,0 +1,150 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+module smp_coherence
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter NUM_CORES   = 2
+    ,parameter NUM_CORES_W = 1
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input                        clk_i
+    ,input                        rst_i
+    ,input  [NUM_CORES-1:0]       acq_req_i
+    ,input  [(NUM_CORES*32)-1:0]  acq_addr_i
+    ,input  [NUM_CORES-1:0]       snp_ack_i
+
+    // Outputs
+    ,output [NUM_CORES-1:0]       acq_gnt_o
+    ,output [NUM_CORES-1:0]       snp_req_o
+    ,output [31:0]                snp_addr_o
+);
+
+//-----------------------------------------------------------------
+// Ownership transactions are serialised: one requesting hart is
+// picked (round robin), every other hart is asked to give up the
+// line (flushing it from its cache if held), then the line is
+// granted to the requester.
+//-----------------------------------------------------------------
+reg                   busy_q;
+reg [NUM_CORES_W-1:0] owner_q;
+reg [31:0]            addr_q;
+reg [NUM_CORES-1:0]   done_q;
+reg [NUM_CORES_W-1:0] rr_q;
+
+wire [NUM_CORES-1:0]  done_w     = done_q | snp_ack_i;
+wire                  complete_w = busy_q && (&done_w);
+
+wire [NUM_CORES:0]    pick_sel_w;
+wire [NUM_CORES:0]    owner_sel_w;
+
+// Round robin pick
+reg                   pick_valid_r;
+reg [NUM_CORES_W-1:0] pick_r;
+reg [NUM_CORES_W:0]   idx_r;
+
+integer i;
+
+/* verilator lint_off WIDTH */
+always @ *
+begin
+    pick_valid_r = 1'b0;
+    pick_r       = {NUM_CORES_W{1'b0}};
+
+    for (i=NUM_CORES;i>0;i=i-1)
+    begin
+        idx_r = rr_q + i;
+        if (idx_r >= NUM_CORES)
+            idx_r = idx_r - NUM_CORES;
+
+        if (acq_req_i[idx_r])
+        begin
+            pick_valid_r = 1'b1;
+            pick_r       = idx_r;
+        end
+    end
+end
+/* verilator lint_on WIDTH */
+
+assign pick_sel_w  = {{NUM_CORES{1'b0}}, 1'b1} << pick_r;
+assign owner_sel_w = {{NUM_CORES{1'b0}}, 1'b1} << owner_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    busy_q  <= 1'b0;
+    owner_q <= {NUM_CORES_W{1'b0}};
+    addr_q  <= 32'b0;
+    done_q  <= {NUM_CORES{1'b0}};
+    rr_q    <= {NUM_CORES_W{1'b0}};
+end
+else if (!busy_q)
+begin
+    if (pick_valid_r)
+    begin
+        busy_q  <= 1'b1;
+        owner_q <= pick_r;
+        addr_q  <= acq_addr_i[pick_r*32 +: 32];
+        done_q  <= pick_sel_w[NUM_CORES-1:0];
+        rr_q    <= pick_r;
+    end
+end
+else if (complete_w)
+begin
+    busy_q  <= 1'b0;
+    done_q  <= {NUM_CORES{1'b0}};
+end
+else
+    done_q  <= done_w;
+
+assign snp_req_o  = busy_q ? ~done_q : {NUM_CORES{1'b0}};
+assign snp_addr_o = addr_q;
+assign acq_gnt_o  = complete_w ? owner_sel_w[NUM_CORES-1:0] : {NUM_CORES{1'b0}};
+
+//-----------------------------------------------------------------
+// Stats
+//-----------------------------------------------------------------
+`ifdef verilator
+reg [31:0] stats_acquire_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    stats_acquire_q <= 32'b0;
+else if (complete_w)
+    stats_acquire_q <= stats_acquire_q + 32'd1;
+
+function [31:0] get_acquire_count; /*verilator public*/
+begin
+    get_acquire_count = stats_acquire_q;
+end
+endfunction
+`endif
+
+endmodule
@@ -0,0 +1,501 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+module smp_dport
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter DCACHE_NUM_WAYS    = 2
+    ,parameter DCACHE_NUM_WAYS_W  = 1
+    ,parameter DCACHE_NUM_LINES   = 256
+    ,parameter DCACHE_NUM_LINES_W = 8
+    ,parameter DCACHE_LINE_SIZE_W = 5
+    ,parameter LR_HOLD_CYCLES     = 32
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input  [ 31:0]  mem_addr_i
+    ,input  [ 31:0]  mem_data_wr_i
+    ,input           mem_rd_i
+    ,input  [  3:0]  mem_wr_i
+    ,input           mem_cacheable_i
+    ,input  [ 10:0]  mem_req_tag_i
+    ,input           mem_invalidate_i
+    ,input           mem_writeback_i
+    ,input           mem_flush_i
+    ,input  [ 31:0]  mem_pc_i
+    ,input  [ 31:0]  outport_data_rd_i
+    ,input           outport_accept_i
+    ,input           outport_ack_i
+    ,input           outport_error_i
+    ,input  [ 10:0]  outport_resp_tag_i
+    ,input           acq_gnt_i
+    ,input           snp_req_i
+    ,input  [ 31:0]  snp_addr_i
+
+    // Outputs
+    ,output [ 31:0]  mem_data_rd_o
+    ,output          mem_accept_o
+    ,output          mem_ack_o
+    ,output          mem_error_o
+    ,output [ 10:0]  mem_resp_tag_o
+    ,output [ 31:0]  outport_addr_o
+    ,output [ 31:0]  outport_data_wr_o
+    ,output          outport_rd_o
+    ,output [  3:0]  outport_wr_o
+    ,output          outport_cacheable_o
+    ,output [ 10:0]  outport_req_tag_o
+    ,output          outport_invalidate_o
+    ,output          outport_writeback_o
+    ,output          outport_flush_o
+    ,output [ 31:0]  outport_pc_o
+    ,output          acq_req_o
+    ,output [ 31:0]  acq_addr_o
+    ,output          snp_ack_o
+);
+
+//-----------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------
+`include "biriscv_defs.v"
+
+//-----------------------------------------------------------------
+// Ownership directory:
+// A duplicate of the data cache tags (same sets / ways) holding
+// every line this hart may have in its cache.  A cacheable request
+// is only passed to the cache once its line is in the directory -
+// a miss first gains exclusive ownership via smp_coherence (which
+// flushes the line out of any other hart's cache).  Lines leaving
+// the directory (snooped by another hart, or replaced) are flushed
+// out of this hart's cache with a line writeback + invalidate.
+//-----------------------------------------------------------------
+localparam DIR_TAG_W   = 32 - DCACHE_NUM_LINES_W - DCACHE_LINE_SIZE_W;
+localparam DIR_ENTRIES = DCACHE_NUM_LINES * DCACHE_NUM_WAYS;
+localparam LINE_W      = 32 - DCACHE_LINE_SIZE_W;
+
+reg [DIR_TAG_W:0] dir_q[DIR_ENTRIES-1:0];
+
+wire [DCACHE_NUM_LINES_W-1:0] req_set_w  = mem_addr_i[DCACHE_LINE_SIZE_W +: DCACHE_NUM_LINES_W];
+wire [DIR_TAG_W-1:0]          req_tag_w  = mem_addr_i[31:32-DIR_TAG_W];
+wire [LINE_W-1:0]             req_line_w = mem_addr_i[31:DCACHE_LINE_SIZE_W];
+
+wire [DCACHE_NUM_LINES_W-1:0] snp_set_w  = snp_addr_i[DCACHE_LINE_SIZE_W +: DCACHE_NUM_LINES_W];
+wire [DIR_TAG_W-1:0]          snp_tag_w  = snp_addr_i[31:32-DIR_TAG_W];
+wire [LINE_W-1:0]             snp_line_w = snp_addr_i[31:DCACHE_LINE_SIZE_W];
+
+reg                         req_hit_r;
+reg                         snp_hit_r;
+reg [DCACHE_NUM_WAYS_W-1:0] snp_way_r;
+reg                         victim_valid_r;
+reg [DCACHE_NUM_WAYS_W-1:0] victim_way_r;
+reg [DIR_TAG_W-1:0]         victim_tag_r;
+reg                         victim_free_r;
+
+reg [DCACHE_NUM_WAYS_W-1:0] replace_way_q;
+
+integer i;
+
+/* verilator lint_off WIDTH */
+always @ *
+begin
+    req_hit_r      = 1'b0;
+    snp_hit_r      = 1'b0;
+    snp_way_r      = {DCACHE_NUM_WAYS_W{1'b0}};
+    victim_free_r  = 1'b0;
+    victim_way_r   = replace_way_q;
+
+    for (i=0;i<DCACHE_NUM_WAYS;i=i+1)
+    begin
+        if (dir_q[req_set_w * DCACHE_NUM_WAYS + i][DIR_TAG_W] &&
+            dir_q[req_set_w * DCACHE_NUM_WAYS + i][DIR_TAG_W-1:0] == req_tag_w)
+            req_hit_r = 1'b1;
+
+        if (dir_q[snp_set_w * DCACHE_NUM_WAYS + i][DIR_TAG_W] &&
+            dir_q[snp_set_w * DCACHE_NUM_WAYS + i][DIR_TAG_W-1:0] == snp_tag_w)
+        begin
+            snp_hit_r = 1'b1;
+            snp_way_r = i;
+        end
+
+        // Prefer a free way, otherwise round robin
+        if (!victim_free_r && !dir_q[req_set_w * DCACHE_NUM_WAYS + i][DIR_TAG_W])
+        begin
+            victim_free_r = 1'b1;
+            victim_way_r  = i;
+        end
+    end
+
+    victim_valid_r = dir_q[req_set_w * DCACHE_NUM_WAYS + victim_way_r][DIR_TAG_W];
+    victim_tag_r   = dir_q[req_set_w * DCACHE_NUM_WAYS + victim_way_r][DIR_TAG_W-1:0];
+end
+/* verilator lint_on WIDTH */
+
+//-----------------------------------------------------------------
+// Request classification
+//-----------------------------------------------------------------
+wire req_w     = mem_rd_i | (|mem_wr_i) | mem_invalidate_i | mem_writeback_i | mem_flush_i;
+
+// Cacheable line accesses (not whole cache flushes) need ownership
+wire req_own_w = req_w && mem_cacheable_i && !mem_flush_i;
+
+reg              res_valid_q;
+reg [LINE_W-1:0] res_line_q;
+
+// SC whose reservation has been lost (line snooped away / replaced)
+wire sc_fail_w = req_own_w && mem_req_tag_i[`MEM_TAG_SC] &&
+                 !(res_valid_q && res_line_q == req_line_w);
+
+//-----------------------------------------------------------------
+// Response routing: the cache responds in order, so a FIFO of the
+// request source is enough to steer each ack.
+//-----------------------------------------------------------------
+localparam SRC_CPU    = 2'd0;
+localparam SRC_VICTIM = 2'd1;
+localparam SRC_SNOOP  = 2'd2;
+
+reg [1:0] src_q[3:0];
+reg [1:0] src_rd_ptr_q;
+reg [1:0] src_wr_ptr_q;
+reg [2:0] src_count_q;
+
+wire      src_full_w   = (src_count_q == 3'd4);
+wire [1:0] src_head_w  = src_q[src_rd_ptr_q];
+
+wire      ack_cpu_w    = outport_ack_i && (src_head_w == SRC_CPU);
+wire      ack_victim_w = outport_ack_i && (src_head_w == SRC_VICTIM);
+wire      ack_snoop_w  = outport_ack_i && (src_head_w == SRC_SNOOP);
+
+//-----------------------------------------------------------------
+// State machines
+//-----------------------------------------------------------------
+localparam CPU_IDLE       = 3'd0;
+localparam CPU_EVICT      = 3'd1;
+localparam CPU_EVICT_WAIT = 3'd2;
+localparam CPU_ACQUIRE    = 3'd3;
+localparam CPU_FORWARD    = 3'd4;
+
+localparam SNP_IDLE       = 2'd0;
+localparam SNP_FLUSH      = 2'd1;
+localparam SNP_WAIT       = 2'd2;
+
+reg [2:0]        cpu_state_q;
+reg [1:0]        snp_state_q;
+
+reg [LINE_W-1:0] acq_line_q;
+reg [DCACHE_NUM_WAYS_W-1:0] acq_way_q;
+reg [LINE_W-1:0] victim_line_q;
+reg [LINE_W-1:0] snp_line_q;
+
+reg              lock_q;
+reg              lock_lr_q;
+reg [LINE_W-1:0] lock_line_q;
+reg [5:0]        lock_count_q;
+
+reg              sc_fail_q;
+reg [10:0]       sc_tag_q;
+reg [3:0]        cpu_pending_q;
+
+// Snoop lookup - deferred whilst a freshly acquired line is being used,
+// or whilst the line is held by an AMO / recent LR.
+wire snp_lookup_w  = (snp_state_q == SNP_IDLE) && snp_req_i && (cpu_state_q != CPU_FORWARD);
+wire snp_locked_w  = lock_q && (lock_line_q == snp_line_w);
+wire snp_start_w   = snp_lookup_w && snp_hit_r && !snp_locked_w;
+wire snp_miss_w    = snp_lookup_w && !snp_hit_r;
+
+// Internally generated line flushes (snoop has priority)
+wire inject_snp_w  = (snp_state_q == SNP_FLUSH);
+wire inject_vic_w  = (cpu_state_q == CPU_EVICT) && !inject_snp_w;
+wire inject_w      = (inject_snp_w || inject_vic_w) && !src_full_w;
+
+wire [LINE_W-1:0] inject_line_w = inject_snp_w ? snp_line_q : victim_line_q;
+
+// CPU requests pass through when they own the line (or don't need to)
+wire cpu_ready_w   = !inject_snp_w && !inject_vic_w && !snp_start_w && !sc_fail_q && !src_full_w &&
+                     ((cpu_state_q == CPU_IDLE) || (cpu_state_q == CPU_FORWARD));
+wire cpu_pass_w    = cpu_ready_w && req_w && (!req_own_w || (req_hit_r && !sc_fail_w));
+wire cpu_accept_w  = cpu_pass_w && outport_accept_i;
+
+// SC without reservation - completed here once older requests have drained
+wire sc_drop_w     = cpu_ready_w && (cpu_state_q == CPU_IDLE) && sc_fail_w && (cpu_pending_q == 4'd0);
+
+// Line not owned - replace a directory entry then acquire ownership
+wire cpu_miss_w    = cpu_ready_w && (cpu_state_q == CPU_IDLE) && req_own_w && !req_hit_r && !sc_fail_w;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    cpu_state_q <= CPU_IDLE;
+else
+begin
+    case (cpu_state_q)
+    CPU_IDLE:
+    begin
+        if (cpu_miss_w)
+            cpu_state_q <= victim_valid_r ? CPU_EVICT : CPU_ACQUIRE;
+    end
+    CPU_EVICT:
+    begin
+        if (inject_vic_w && !src_full_w && outport_accept_i)
+            cpu_state_q <= CPU_EVICT_WAIT;
+    end
+    CPU_EVICT_WAIT:
+    begin
+        if (ack_victim_w)
+            cpu_state_q <= CPU_ACQUIRE;
+    end
+    CPU_ACQUIRE:
+    begin
+        if (acq_gnt_i)
+            cpu_state_q <= CPU_FORWARD;
+    end
+    CPU_FORWARD:
+    begin
+        // Acquired line used (or request withdrawn / now for another line)
+        if (cpu_accept_w || !req_w || (req_own_w && !req_hit_r))
+            cpu_state_q <= CPU_IDLE;
+    end
+    default:
+        cpu_state_q <= CPU_IDLE;
+    endcase
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    acq_line_q    <= {LINE_W{1'b0}};
+    acq_way_q     <= {DCACHE_NUM_WAYS_W{1'b0}};
+    victim_line_q <= {LINE_W{1'b0}};
+    replace_way_q <= {DCACHE_NUM_WAYS_W{1'b0}};
+end
+else if (cpu_miss_w)
+begin
+    acq_line_q    <= req_line_w;
+    acq_way_q     <= victim_way_r;
+    victim_line_q <= {victim_tag_r, req_set_w};
+
+    if (!victim_free_r)
+        replace_way_q <= replace_way_q + 1;
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    snp_state_q <= SNP_IDLE;
+    snp_line_q  <= {LINE_W{1'b0}};
+end
+else
+begin
+    case (snp_state_q)
+    SNP_IDLE:
+    begin
+        if (snp_start_w)
+        begin
+            snp_state_q <= SNP_FLUSH;
+            snp_line_q  <= snp_line_w;
+        end
+    end
+    SNP_FLUSH:
+    begin
+        if (!src_full_w && outport_accept_i)
+            snp_state_q <= SNP_WAIT;
+    end
+    SNP_WAIT:
+    begin
+        if (ack_snoop_w)
+            snp_state_q <= SNP_IDLE;
+    end
+    default:
+        snp_state_q <= SNP_IDLE;
+    endcase
+end
+
+//-----------------------------------------------------------------
+// Directory update
+//-----------------------------------------------------------------
+/* verilator lint_off WIDTH */
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    for (i=0;i<DIR_ENTRIES;i=i+1)
+        dir_q[i] <= {(DIR_TAG_W+1){1'b0}};
+end
+else
+begin
+    // Line snooped by another hart
+    if (snp_start_w)
+        dir_q[snp_set_w * DCACHE_NUM_WAYS + snp_way_r] <= {(DIR_TAG_W+1){1'b0}};
+
+    // Replaced to make way for a new line
+    if (cpu_miss_w && victim_valid_r)
+        dir_q[req_set_w * DCACHE_NUM_WAYS + victim_way_r] <= {(DIR_TAG_W+1){1'b0}};
+
+    // Ownership granted
+    if (cpu_state_q == CPU_ACQUIRE && acq_gnt_i)
+        dir_q[acq_line_q[DCACHE_NUM_LINES_W-1:0] * DCACHE_NUM_WAYS + acq_way_q] <=
+            {1'b1, acq_line_q[LINE_W-1:DCACHE_NUM_LINES_W]};
+end
+/* verilator lint_on WIDTH */
+
+//-----------------------------------------------------------------
+// Reservation (LR/SC) and line lock (AMO, LR)
+//-----------------------------------------------------------------
+wire line_lost_w = (snp_start_w && res_line_q == snp_line_w) ||
+                   (cpu_miss_w && victim_valid_r && res_line_q == {victim_tag_r, req_set_w});
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    res_valid_q <= 1'b0;
+    res_line_q  <= {LINE_W{1'b0}};
+end
+else
+begin
+    if (cpu_accept_w && req_own_w && mem_req_tag_i[`MEM_TAG_LR])
+    begin
+        res_valid_q <= 1'b1;
+        res_line_q  <= req_line_w;
+    end
+    else if ((cpu_accept_w && req_own_w && mem_req_tag_i[`MEM_TAG_SC]) || sc_drop_w)
+        res_valid_q <= 1'b0;
+
+    if (line_lost_w)
+        res_valid_q <= 1'b0;
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    lock_q       <= 1'b0;
+    lock_lr_q    <= 1'b0;
+    lock_line_q  <= {LINE_W{1'b0}};
+    lock_count_q <= 6'b0;
+end
+// Access fault (e.g. AMO read) - the write which would release the line won't follow
+else if (ack_cpu_w && outport_error_i)
+    lock_q       <= 1'b0;
+else if (cpu_accept_w && req_own_w && (mem_req_tag_i[`MEM_TAG_LR] || mem_req_tag_i[`MEM_TAG_LOCK]))
+begin
+    lock_q       <= 1'b1;
+    lock_lr_q    <= mem_req_tag_i[`MEM_TAG_LR];
+    lock_line_q  <= req_line_w;
+/* verilator lint_off WIDTH */
+    lock_count_q <= LR_HOLD_CYCLES;
+/* verilator lint_on WIDTH */
+end
+else if (cpu_accept_w && (|mem_wr_i))
+    lock_q       <= 1'b0;
+// LR holds the line for a bounded time once complete (SC forward progress)
+else if (lock_q && lock_lr_q && cpu_pending_q == 4'd0)
+begin
+    lock_count_q <= lock_count_q - 6'd1;
+    if (lock_count_q == 6'd0)
+        lock_q   <= 1'b0;
+end
+
+//-----------------------------------------------------------------
+// Outstanding CPU requests / SC drop response
+//-----------------------------------------------------------------
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    cpu_pending_q <= 4'd0;
+else if (cpu_accept_w && !ack_cpu_w)
+    cpu_pending_q <= cpu_pending_q + 4'd1;
+else if (!cpu_accept_w && ack_cpu_w)
+    cpu_pending_q <= cpu_pending_q - 4'd1;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    sc_fail_q <= 1'b0;
+    sc_tag_q  <= 11'b0;
+end
+else
+begin
+    sc_fail_q <= sc_drop_w;
+    sc_tag_q  <= mem_req_tag_i;
+end
+
+//-----------------------------------------------------------------
+// Response source FIFO
+//-----------------------------------------------------------------
+wire       src_push_w = outport_accept_i && (inject_w || cpu_pass_w);
+wire [1:0] src_in_w   = inject_snp_w ? SRC_SNOOP : inject_vic_w ? SRC_VICTIM : SRC_CPU;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    src_rd_ptr_q <= 2'b0;
+    src_wr_ptr_q <= 2'b0;
+    src_count_q  <= 3'b0;
+    for (i=0;i<4;i=i+1)
+        src_q[i] <= SRC_CPU;
+end
+else
+begin
+    if (src_push_w)
+    begin
+        src_q[src_wr_ptr_q] <= src_in_w;
+        src_wr_ptr_q        <= src_wr_ptr_q + 2'd1;
+    end
+
+    if (outport_ack_i)
+        src_rd_ptr_q <= src_rd_ptr_q + 2'd1;
+
+    if (src_push_w && !outport_ack_i)
+        src_count_q <= src_count_q + 3'd1;
+    else if (!src_push_w && outport_ack_i)
+        src_count_q <= src_count_q - 3'd1;
+end
+
+//-----------------------------------------------------------------
+// Outputs
+//-----------------------------------------------------------------
+assign outport_addr_o       = inject_w ? {inject_line_w, {DCACHE_LINE_SIZE_W{1'b0}}} : mem_addr_i;
+assign outport_data_wr_o    = mem_data_wr_i;
+assign outport_rd_o         = inject_w ? 1'b0 : (cpu_pass_w & mem_rd_i);
+assign outport_wr_o         = inject_w ? 4'b0 : (mem_wr_i & {4{cpu_pass_w}});
+assign outport_cacheable_o  = inject_w ? 1'b1 : mem_cacheable_i;
+assign outport_req_tag_o    = inject_w ? 11'b0 : mem_req_tag_i;
+assign outport_invalidate_o = inject_w ? 1'b1 : (cpu_pass_w & mem_invalidate_i);
+assign outport_writeback_o  = inject_w ? 1'b1 : (cpu_pass_w & mem_writeback_i);
+assign outport_flush_o      = inject_w ? 1'b0 : (cpu_pass_w & mem_flush_i);
+assign outport_pc_o         = mem_pc_i;
+
+assign mem_accept_o         = cpu_accept_w | sc_drop_w;
+assign mem_ack_o            = ack_cpu_w | sc_fail_q;
+assign mem_error_o          = ack_cpu_w & outport_error_i;
+assign mem_data_rd_o        = outport_data_rd_i;
+assign mem_resp_tag_o       = sc_fail_q ? (sc_tag_q | (11'b1 << `MEM_TAG_SC_FAIL)) : outport_resp_tag_i;
+
+assign acq_req_o            = (cpu_state_q == CPU_ACQUIRE);
+assign acq_addr_o           = {acq_line_q, {DCACHE_LINE_SIZE_W{1'b0}}};
+
+assign snp_ack_o            = snp_miss_w | ack_snoop_w;
+
+endmodule
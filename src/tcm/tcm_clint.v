@@ -0,0 +1,179 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+module tcm_clint
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input  [ 31:0]  cfg_addr_i
+    ,input  [ 31:0]  cfg_data_wr_i
+    ,input           cfg_rd_i
+    ,input  [  3:0]  cfg_wr_i
+    ,input           cfg_cacheable_i
+    ,input  [ 10:0]  cfg_req_tag_i
+    ,input           cfg_invalidate_i
+    ,input           cfg_writeback_i
+    ,input           cfg_flush_i
+
+    // Outputs
+    ,output [ 31:0]  cfg_data_rd_o
+    ,output          cfg_accept_o
+    ,output          cfg_ack_o
+    ,output          cfg_error_o
+    ,output [ 10:0]  cfg_resp_tag_o
+    ,output          timer_irq_o
+);
+
+//-----------------------------------------------------------------
+// CLINT compatible timer (single hart).
+// mtime is 64-bit and advances once every (MTIMEDIV + 1) cycles.
+// timer_irq_o is level: mtime >= mtimecmp.
+//
+// Registers:
+// 0x0000 MSIP       Reads zero (no software interrupt)
+// 0x4000 MTIMECMP   [31:0]
+// 0x4004 MTIMECMPH  [63:32]
+// 0xBFF0 MTIMEDIV   [15:0] prescaler (non-standard)
+// 0xBFF8 MTIME      [31:0]
+// 0xBFFC MTIMEH     [63:32]
+//-----------------------------------------------------------------
+localparam REG_MTIMECMP  = 16'h4000;
+localparam REG_MTIMECMPH = 16'h4004;
+localparam REG_MTIMEDIV  = 16'hBFF0;
+localparam REG_MTIME     = 16'hBFF8;
+localparam REG_MTIMEH    = 16'hBFFC;
+
+reg [63:0] mtime_q;
+reg [63:0] mtimecmp_q;
+reg [15:0] div_q;
+reg [15:0] pre_q;
+
+wire cfg_write_w = (|cfg_wr_i);
+wire tick_w      = (pre_q >= div_q);
+
+//-----------------------------------------------------------------
+// Byte lane merge for partial writes
+//-----------------------------------------------------------------
+function [31:0] merge;
+    input [31:0] old;
+    input [31:0] data;
+    input [3:0]  strb;
+begin
+    merge[7:0]   = strb[0] ? data[7:0]   : old[7:0];
+    merge[15:8]  = strb[1] ? data[15:8]  : old[15:8];
+    merge[23:16] = strb[2] ? data[23:16] : old[23:16];
+    merge[31:24] = strb[3] ? data[31:24] : old[31:24];
+end
+endfunction
+
+wire [31:0] div_wr_w = merge({16'b0, div_q}, cfg_data_wr_i, cfg_wr_i);
+
+//-----------------------------------------------------------------
+// Registers
+//-----------------------------------------------------------------
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    mtime_q    <= 64'b0;
+    mtimecmp_q <= {64{1'b1}};
+    div_q      <= 16'b0;
+    pre_q      <= 16'b0;
+end
+else
+begin
+    if (tick_w)
+    begin
+        pre_q   <= 16'b0;
+        mtime_q <= mtime_q + 64'd1;
+    end
+    else
+        pre_q   <= pre_q + 16'd1;
+
+    if (cfg_write_w)
+    begin
+        case (cfg_addr_i[15:0])
+        REG_MTIMECMP:  mtimecmp_q[31:0]  <= merge(mtimecmp_q[31:0],  cfg_data_wr_i, cfg_wr_i);
+        REG_MTIMECMPH: mtimecmp_q[63:32] <= merge(mtimecmp_q[63:32], cfg_data_wr_i, cfg_wr_i);
+        REG_MTIMEDIV:
+        begin
+            div_q <= div_wr_w[15:0];
+            pre_q <= 16'b0;
+        end
+        REG_MTIME:     mtime_q[31:0]     <= merge(mtime_q[31:0],  cfg_data_wr_i, cfg_wr_i);
+        REG_MTIMEH:    mtime_q[63:32]    <= merge(mtime_q[63:32], cfg_data_wr_i, cfg_wr_i);
+        default: ;
+        endcase
+    end
+end
+
+//-----------------------------------------------------------------
+// Register read
+//-----------------------------------------------------------------
+reg [31:0] cfg_data_r;
+
+always @ *
+begin
+    cfg_data_r = 32'b0;
+
+    case (cfg_addr_i[15:0])
+    REG_MTIMECMP:  cfg_data_r = mtimecmp_q[31:0];
+    REG_MTIMECMPH: cfg_data_r = mtimecmp_q[63:32];
+    REG_MTIMEDIV:  cfg_data_r = {16'b0, div_q};
+    REG_MTIME:     cfg_data_r = mtime_q[31:0];
+    REG_MTIMEH:    cfg_data_r = mtime_q[63:32];
+    default: ;
+    endcase
+end
+
+reg        cfg_ack_q;
+reg [10:0] cfg_tag_q;
+reg [31:0] cfg_data_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    cfg_ack_q  <= 1'b0;
+    cfg_tag_q  <= 11'b0;
+    cfg_data_q <= 32'b0;
+end
+else
+begin
+    cfg_ack_q  <= cfg_rd_i || cfg_write_w || cfg_flush_i || cfg_invalidate_i || cfg_writeback_i;
+    cfg_tag_q  <= cfg_req_tag_i;
+    cfg_data_q <= cfg_data_r;
+end
+
+assign cfg_accept_o   = 1'b1;
+assign cfg_ack_o      = cfg_ack_q;
+assign cfg_error_o    = 1'b0;
+assign cfg_resp_tag_o = cfg_tag_q;
+assign cfg_data_rd_o  = cfg_data_q;
+
+assign timer_irq_o    = (mtime_q >= mtimecmp_q);
+
+endmodule
@@ -0,0 +1,584 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+module tcm_dma
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter TCM_MEM_BASE     = 0
+    ,parameter TCM_MEM_SIZE     = 65536
+    ,parameter AXI_ID           = 0
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input  [ 31:0]  cfg_addr_i
+    ,input  [ 31:0]  cfg_data_wr_i
+    ,input           cfg_rd_i
+    ,input  [  3:0]  cfg_wr_i
+    ,input           cfg_cacheable_i
+    ,input  [ 10:0]  cfg_req_tag_i
+    ,input           cfg_invalidate_i
+    ,input           cfg_writeback_i
+    ,input           cfg_flush_i
+    ,input           tcm_accept_i
+    ,input           tcm_ack_i
+    ,input  [ 31:0]  tcm_data_rd_i
+    ,input           axi_awready_i
+    ,input           axi_wready_i
+    ,input           axi_bvalid_i
+    ,input  [  1:0]  axi_bresp_i
+    ,input  [  3:0]  axi_bid_i
+    ,input           axi_arready_i
+    ,input           axi_rvalid_i
+    ,input  [ 31:0]  axi_rdata_i
+    ,input  [  1:0]  axi_rresp_i
+    ,input  [  3:0]  axi_rid_i
+    ,input           axi_rlast_i
+
+    // Outputs
+    ,output [ 31:0]  cfg_data_rd_o
+    ,output          cfg_accept_o
+    ,output          cfg_ack_o
+    ,output          cfg_error_o
+    ,output [ 10:0]  cfg_resp_tag_o
+    ,output          tcm_rd_o
+    ,output [  3:0]  tcm_wr_o
+    ,output [ 31:0]  tcm_addr_o
+    ,output [ 31:0]  tcm_data_wr_o
+    ,output          axi_awvalid_o
+    ,output [ 31:0]  axi_awaddr_o
+    ,output [  3:0]  axi_awid_o
+    ,output [  7:0]  axi_awlen_o
+    ,output [  1:0]  axi_awburst_o
+    ,output          axi_wvalid_o
+    ,output [ 31:0]  axi_wdata_o
+    ,output [  3:0]  axi_wstrb_o
+    ,output          axi_wlast_o
+    ,output          axi_bready_o
+    ,output          axi_arvalid_o
+    ,output [ 31:0]  axi_araddr_o
+    ,output [  3:0]  axi_arid_o
+    ,output [  7:0]  axi_arlen_o
+    ,output [  1:0]  axi_arburst_o
+    ,output          axi_rready_o
+    ,output          irq_o
+    ,output          busy_o
+);
+
+//-----------------------------------------------------------------
+// Descriptor based DMA engine.
+// Moves 32-bit words between TCM (tcm_*) and external memory
+// (AXI4 bursts); the side is picked by address, so TCM <-> AXI,
+// TCM -> TCM and AXI -> AXI copies are all possible.
+//
+// Registers:
+// 0x00 CTRL   [0] START (write 1, descriptor chain at DESC)
+//             [1] IRQ_EN (interrupt on chain done / error)
+// 0x04 STATUS [0] BUSY, [1] DONE (W1C), [2] ERROR (W1C),
+//             [3] DESC_IRQ (W1C)
+// 0x08 DESC   Address of first descriptor
+// 0x0C COUNT  Descriptors completed (cleared on START)
+// 0x10 BYTES  Bytes transferred (cleared on START)
+//
+// Descriptor (word aligned, 7 words):
+// +0x00 NEXT        Next descriptor (0 = end of chain)
+// +0x04 SRC         Source address (word aligned)
+// +0x08 DST         Destination address (word aligned)
+// +0x0C SIZE        [15:0] row length in bytes (multiple of 4),
+//                   [31:16] number of rows (0 = 1)
+// +0x10 SRC_STRIDE  Source row to row increment (2D)
+// +0x14 DST_STRIDE  Destination row to row increment (2D)
+// +0x18 CTRL        [0] set DESC_IRQ when this descriptor completes
+//-----------------------------------------------------------------
+localparam DESC_WORDS     = 5'd7;
+localparam MAX_BURST      = 16;
+
+localparam STATE_W        = 3;
+localparam STATE_IDLE     = 3'd0;
+localparam STATE_FETCH    = 3'd1;
+localparam STATE_LOAD     = 3'd2;
+localparam STATE_SETUP    = 3'd3;
+localparam STATE_READ     = 3'd4;
+localparam STATE_WRITE    = 3'd5;
+localparam STATE_DESC_END = 3'd6;
+
+reg [STATE_W-1:0] state_q;
+
+//-----------------------------------------------------------------
+// Descriptor / transfer state
+//-----------------------------------------------------------------
+reg        xfer_error_q;
+reg [31:0] next_desc_q;
+reg [31:0] src_row_q;
+reg [31:0] dst_row_q;
+reg [31:0] src_q;
+reg [31:0] dst_q;
+reg [15:0] row_len_q;
+reg [15:0] rows_q;
+reg [15:0] remain_q;
+reg [31:0] src_stride_q;
+reg [31:0] dst_stride_q;
+reg [31:0] desc_ctrl_q;
+
+// Current burst
+reg [31:0] rd_addr_q;
+reg [31:0] wr_addr_q;
+reg [4:0]  chunk_q;
+reg [4:0]  req_cnt_q;
+reg [4:0]  resp_cnt_q;
+reg        ar_pending_q;
+reg        aw_pending_q;
+reg        w_done_q;
+
+reg [31:0] buf_q[MAX_BURST-1:0];
+
+//-----------------------------------------------------------------
+// Registers
+//-----------------------------------------------------------------
+reg        irq_en_q;
+reg        done_q;
+reg        error_q;
+reg        desc_irq_q;
+reg [31:0] desc_base_q;
+reg [31:0] count_q;
+reg [31:0] bytes_q;
+
+wire cfg_write_w = (|cfg_wr_i);
+wire start_w     = cfg_write_w && (cfg_addr_i[7:0] == 8'h00) && cfg_data_wr_i[0] && (state_q == STATE_IDLE);
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    irq_en_q     <= 1'b0;
+    done_q       <= 1'b0;
+    error_q      <= 1'b0;
+    desc_irq_q   <= 1'b0;
+    desc_base_q  <= 32'b0;
+end
+else
+begin
+    if (cfg_write_w)
+    begin
+        case (cfg_addr_i[7:0])
+        8'h00: irq_en_q    <= cfg_data_wr_i[1];
+        8'h08: desc_base_q <= cfg_data_wr_i;
+        default: ;
+        endcase
+    end
+
+    // Status: write 1 to clear
+    if (cfg_write_w && cfg_addr_i[7:0] == 8'h04)
+    begin
+        if (cfg_data_wr_i[1]) done_q     <= 1'b0;
+        if (cfg_data_wr_i[2]) error_q    <= 1'b0;
+        if (cfg_data_wr_i[3]) desc_irq_q <= 1'b0;
+    end
+
+    if (start_w)
+    begin
+        done_q  <= 1'b0;
+        error_q <= 1'b0;
+    end
+    else if (state_q == STATE_DESC_END && xfer_error_q)
+        error_q <= 1'b1;
+    else if (state_q == STATE_DESC_END && next_desc_q == 32'b0)
+        done_q  <= 1'b1;
+
+    if (state_q == STATE_DESC_END && !xfer_error_q && desc_ctrl_q[0])
+        desc_irq_q <= 1'b1;
+end
+
+//-----------------------------------------------------------------
+// Register read
+//-----------------------------------------------------------------
+reg [31:0] cfg_data_r;
+
+always @ *
+begin
+    cfg_data_r = 32'b0;
+
+    case (cfg_addr_i[7:0])
+    8'h00: cfg_data_r = {30'b0, irq_en_q, (state_q != STATE_IDLE)};
+    8'h04: cfg_data_r = {28'b0, desc_irq_q, error_q, done_q, (state_q != STATE_IDLE)};
+    8'h08: cfg_data_r = desc_base_q;
+    8'h0c: cfg_data_r = count_q;
+    8'h10: cfg_data_r = bytes_q;
+    default: ;
+    endcase
+end
+
+reg        cfg_ack_q;
+reg [10:0] cfg_tag_q;
+reg [31:0] cfg_data_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    cfg_ack_q  <= 1'b0;
+    cfg_tag_q  <= 11'b0;
+    cfg_data_q <= 32'b0;
+end
+else
+begin
+    cfg_ack_q  <= cfg_rd_i || cfg_write_w || cfg_flush_i || cfg_invalidate_i || cfg_writeback_i;
+    cfg_tag_q  <= cfg_req_tag_i;
+    cfg_data_q <= cfg_data_r;
+end
+
+assign cfg_accept_o   = 1'b1;
+assign cfg_ack_o      = cfg_ack_q;
+assign cfg_error_o    = 1'b0;
+assign cfg_resp_tag_o = cfg_tag_q;
+assign cfg_data_rd_o  = cfg_data_q;
+
+assign irq_o          = (irq_en_q && (done_q || error_q)) || desc_irq_q;
+assign busy_o         = (state_q != STATE_IDLE);
+
+//-----------------------------------------------------------------
+// Address decode: TCM port or AXI master
+//-----------------------------------------------------------------
+function is_tcm;
+    input [31:0] addr;
+begin
+    /* verilator lint_off UNSIGNED */
+    is_tcm = (addr >= TCM_MEM_BASE) && (addr < (TCM_MEM_BASE + TCM_MEM_SIZE));
+    /* verilator lint_on UNSIGNED */
+end
+endfunction
+
+wire       rd_tcm_w   = is_tcm(rd_addr_q);
+wire       wr_tcm_w   = is_tcm(wr_addr_q);
+
+//-----------------------------------------------------------------
+// Burst sizing: up to MAX_BURST words, not crossing the end of the
+// row or an AXI 4KB boundary
+//-----------------------------------------------------------------
+wire [10:0] src_4k_w  = 11'd1024 - {1'b0, src_q[11:2]};
+wire [10:0] dst_4k_w  = 11'd1024 - {1'b0, dst_q[11:2]};
+wire [13:0] row_w     = remain_q[15:2];
+
+reg [4:0] chunk_r;
+
+/* verilator lint_off WIDTH */
+always @ *
+begin
+    chunk_r = MAX_BURST;
+
+    if ({2'b0, row_w} < {11'b0, chunk_r})
+        chunk_r = row_w[4:0];
+    if (!is_tcm(src_q) && ({3'b0, src_4k_w} < {9'b0, chunk_r}))
+        chunk_r = src_4k_w[4:0];
+    if (!is_tcm(dst_q) && ({3'b0, dst_4k_w} < {9'b0, chunk_r}))
+        chunk_r = dst_4k_w[4:0];
+end
+/* verilator lint_on WIDTH */
+
+wire [15:0] chunk_bytes_w = {9'b0, chunk_q, 2'b0};
+
+//-----------------------------------------------------------------
+// Data movement handshakes
+//-----------------------------------------------------------------
+wire reading_w  = (state_q == STATE_FETCH) || (state_q == STATE_READ);
+wire writing_w  = (state_q == STATE_WRITE);
+
+wire tcm_rd_w   = reading_w && rd_tcm_w && (req_cnt_q != chunk_q);
+wire tcm_wr_w   = writing_w && wr_tcm_w && (req_cnt_q != chunk_q);
+
+wire tcm_req_accept_w = (tcm_rd_w || tcm_wr_w) && tcm_accept_i;
+
+wire r_accept_w = axi_rvalid_i && axi_rready_o;
+wire w_accept_w = axi_wvalid_o && axi_wready_i;
+wire b_accept_w = axi_bvalid_i && axi_bready_o;
+
+wire rd_done_w  = reading_w && (rd_tcm_w ? (tcm_ack_i && (resp_cnt_q + 5'd1 == chunk_q)) :
+                                           (r_accept_w && axi_rlast_i));
+wire wr_done_w  = writing_w && (wr_tcm_w ? (tcm_ack_i && (resp_cnt_q + 5'd1 == chunk_q)) :
+                                           b_accept_w);
+
+integer i;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    state_q      <= STATE_IDLE;
+    count_q      <= 32'b0;
+    bytes_q      <= 32'b0;
+    xfer_error_q <= 1'b0;
+    next_desc_q  <= 32'b0;
+    src_row_q    <= 32'b0;
+    dst_row_q    <= 32'b0;
+    src_q        <= 32'b0;
+    dst_q        <= 32'b0;
+    row_len_q    <= 16'b0;
+    rows_q       <= 16'b0;
+    remain_q     <= 16'b0;
+    src_stride_q <= 32'b0;
+    dst_stride_q <= 32'b0;
+    desc_ctrl_q  <= 32'b0;
+    rd_addr_q    <= 32'b0;
+    wr_addr_q    <= 32'b0;
+    chunk_q      <= 5'b0;
+    req_cnt_q    <= 5'b0;
+    resp_cnt_q   <= 5'b0;
+    ar_pending_q <= 1'b0;
+    aw_pending_q <= 1'b0;
+    w_done_q     <= 1'b0;
+
+    for (i=0;i<MAX_BURST;i=i+1)
+        buf_q[i] <= 32'b0;
+end
+else
+begin
+    if (axi_arvalid_o && axi_arready_i)
+        ar_pending_q <= 1'b0;
+    if (axi_awvalid_o && axi_awready_i)
+        aw_pending_q <= 1'b0;
+
+    // Request / response counters (TCM words or AXI beats)
+    if (tcm_req_accept_w || w_accept_w)
+        req_cnt_q  <= req_cnt_q + 5'd1;
+    if (tcm_ack_i || r_accept_w)
+        resp_cnt_q <= resp_cnt_q + 5'd1;
+
+    // Read data capture
+    if (reading_w && tcm_ack_i)
+        buf_q[resp_cnt_q[3:0]] <= tcm_data_rd_i;
+    else if (reading_w && r_accept_w)
+        buf_q[resp_cnt_q[3:0]] <= axi_rdata_i;
+
+    if ((r_accept_w && axi_rresp_i != 2'b00) || (b_accept_w && axi_bresp_i != 2'b00))
+        xfer_error_q <= 1'b1;
+
+    case (state_q)
+    //-----------------------------------------
+    // STATE_IDLE
+    //-----------------------------------------
+    STATE_IDLE:
+    begin
+        if (start_w)
+        begin
+            count_q      <= 32'b0;
+            bytes_q      <= 32'b0;
+            xfer_error_q <= 1'b0;
+            desc_q       <= desc_base_q;
+            rd_addr_q    <= desc_base_q;
+            chunk_q      <= DESC_WORDS;
+            req_cnt_q    <= 5'b0;
+            resp_cnt_q   <= 5'b0;
+            ar_pending_q <= !is_tcm(desc_base_q);
+            state_q      <= STATE_FETCH;
+        end
+    end
+    //-----------------------------------------
+    // STATE_FETCH: read descriptor into buffer
+    //-----------------------------------------
+    STATE_FETCH:
+    begin
+        if (rd_done_w)
+            state_q <= STATE_LOAD;
+    end
+    //-----------------------------------------
+    // STATE_LOAD: unpack descriptor
+    //-----------------------------------------
+    STATE_LOAD:
+    begin
+        next_desc_q  <= buf_q[0];
+        src_row_q    <= buf_q[1];
+        src_q        <= buf_q[1];
+        dst_row_q    <= buf_q[2];
+        dst_q        <= buf_q[2];
+        row_len_q    <= {buf_q[3][15:2], 2'b0};
+        remain_q     <= {buf_q[3][15:2], 2'b0};
+        rows_q       <= (buf_q[3][31:16] == 16'd0) ? 16'd1 : buf_q[3][31:16];
+        src_stride_q <= buf_q[4];
+        dst_stride_q <= buf_q[5];
+        desc_ctrl_q  <= buf_q[6];
+
+        if (xfer_error_q || buf_q[3][15:2] == 14'd0)
+            state_q <= STATE_DESC_END;
+        else
+            state_q <= STATE_SETUP;
+    end
+    //-----------------------------------------
+    // STATE_SETUP: size next burst
+    //-----------------------------------------
+    STATE_SETUP:
+    begin
+        rd_addr_q    <= src_q;
+        wr_addr_q    <= dst_q;
+        chunk_q      <= chunk_r;
+        req_cnt_q    <= 5'b0;
+        resp_cnt_q   <= 5'b0;
+        ar_pending_q <= !is_tcm(src_q);
+        state_q      <= STATE_READ;
+    end
+    //-----------------------------------------
+    // STATE_READ: source -> buffer
+    //-----------------------------------------
+    STATE_READ:
+    begin
+        if (rd_done_w)
+        begin
+            req_cnt_q    <= 5'b0;
+            resp_cnt_q   <= 5'b0;
+            aw_pending_q <= !wr_tcm_w;
+            w_done_q     <= 1'b0;
+            state_q      <= STATE_WRITE;
+        end
+    end
+    //-----------------------------------------
+    // STATE_WRITE: buffer -> destination
+    //-----------------------------------------
+    STATE_WRITE:
+    begin
+        if (w_accept_w && axi_wlast_o)
+            w_done_q <= 1'b1;
+
+        if (wr_done_w)
+        begin
+            bytes_q  <= bytes_q + {16'b0, chunk_bytes_w};
+            src_q    <= src_q + {16'b0, chunk_bytes_w};
+            dst_q    <= dst_q + {16'b0, chunk_bytes_w};
+            remain_q <= remain_q - chunk_bytes_w;
+
+            // Abort chain on error
+            if (xfer_error_q)
+                state_q <= STATE_DESC_END;
+            // End of row
+            else if (remain_q == chunk_bytes_w)
+            begin
+                if (rows_q == 16'd1)
+                    state_q <= STATE_DESC_END;
+                else
+                begin
+                    rows_q    <= rows_q - 16'd1;
+                    src_row_q <= src_row_q + src_stride_q;
+                    dst_row_q <= dst_row_q + dst_stride_q;
+                    src_q     <= src_row_q + src_stride_q;
+                    dst_q     <= dst_row_q + dst_stride_q;
+                    remain_q  <= row_len_q;
+                    state_q   <= STATE_SETUP;
+                end
+            end
+            else
+                state_q <= STATE_SETUP;
+        end
+    end
+    //-----------------------------------------
+    // STATE_DESC_END: follow chain
+    //-----------------------------------------
+    STATE_DESC_END:
+    begin
+        if (!xfer_error_q)
+            count_q <= count_q + 32'd1;
+
+        if (xfer_error_q || next_desc_q == 32'b0)
+            state_q <= STATE_IDLE;
+        else
+        begin
+            desc_q       <= next_desc_q;
+            rd_addr_q    <= next_desc_q;
+            chunk_q      <= DESC_WORDS;
+            req_cnt_q    <= 5'b0;
+            resp_cnt_q   <= 5'b0;
+            ar_pending_q <= !is_tcm(next_desc_q);
+            state_q      <= STATE_FETCH;
+        end
+    end
+    default:
+        state_q <= STATE_IDLE;
+    endcase
+end
+
+//-----------------------------------------------------------------
+// TCM port
+//-----------------------------------------------------------------
+assign tcm_rd_o      = tcm_rd_w;
+assign tcm_wr_o      = tcm_wr_w ? 4'hF : 4'h0;
+assign tcm_addr_o    = (tcm_wr_w ? wr_addr_q : rd_addr_q) + {25'b0, req_cnt_q, 2'b0};
+assign tcm_data_wr_o = buf_q[req_cnt_q[3:0]];
+
+//-----------------------------------------------------------------
+// AXI master (incrementing bursts)
+//-----------------------------------------------------------------
+assign axi_arvalid_o = ar_pending_q;
+assign axi_araddr_o  = rd_addr_q;
+assign axi_arid_o    = AXI_ID;
+assign axi_arlen_o   = {3'b0, chunk_q} - 8'd1;
+assign axi_arburst_o = 2'b01;
+assign axi_rready_o  = reading_w && !rd_tcm_w;
+
+assign axi_awvalid_o = aw_pending_q;
+assign axi_awaddr_o  = wr_addr_q;
+assign axi_awid_o    = AXI_ID;
+assign axi_awlen_o   = {3'b0, chunk_q} - 8'd1;
+assign axi_awburst_o = 2'b01;
+
+assign axi_wvalid_o  = writing_w && !wr_tcm_w && !w_done_q;
+assign axi_wdata_o   = buf_q[req_cnt_q[3:0]];
+assign axi_wstrb_o   = 4'hF;
+assign axi_wlast_o   = (req_cnt_q + 5'd1 == chunk_q);
+assign axi_bready_o  = writing_w && !wr_tcm_w;
+
+//-----------------------------------------------------------------
+// Stats
+//-----------------------------------------------------------------
+`ifdef verilator
+reg [31:0] stats_busy_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    stats_busy_q <= 32'b0;
+else if (state_q != STATE_IDLE)
+    stats_busy_q <= stats_busy_q + 32'd1;
+
+function [31:0] get_busy_cycles; /*verilator public*/
+begin
+    get_busy_cycles = stats_busy_q;
+end
+endfunction
+function [31:0] get_bytes; /*verilator public*/
+begin
+    get_bytes = bytes_q;
+end
+endfunction
+function [31:0] get_desc_count; /*verilator public*/
+begin
+    get_desc_count = count_q;
+end
+endfunction
+function get_busy; /*verilator public*/
+begin
+    get_busy = (state_q != STATE_IDLE);
+end
+endfunction
+`endif
+
+endmodule
@@ -24,6 +24,18 @@
 //-----------------------------------------------------------------
 
 module tcm_mem
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter TCM_MEM_SIZE     = 65536
+    ,parameter TCM_MEM_SIZE_W   = 16
+    ,parameter TCM_NUM_BANKS    = 1
+    ,parameter TCM_NUM_BANKS_W  = 0
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk_i
@@ -57,6 +69,10 @@ module tcm_mem
     ,input  [  7:0]  axi_arlen_i
     ,input  [  1:0]  axi_arburst_i
     ,input           axi_rready_i
+    ,input           dma_rd_i
+    ,input  [  3:0]  dma_wr_i
+    ,input  [ 31:0]  dma_addr_i
+    ,input  [ 31:0]  dma_data_wr_i
 
     // Outputs
     ,output          mem_i_accept_o
@@ -79,6 +95,9 @@ module tcm_mem
     ,output [  1:0]  axi_rresp_o
     ,output [  3:0]  axi_rid_o
     ,output          axi_rlast_o
+    ,output          dma_accept_o
+    ,output          dma_ack_o
+    ,output [ 31:0]  dma_data_rd_o
 );
 
 
@@ -86,14 +105,14 @@ module tcm_mem
 //-------------------------------------------------------------
 // AXI -> PMEM Interface
 //-------------------------------------------------------------
-wire          ext_accept_w;
-wire          ext_ack_w;
-wire [ 31:0]  ext_read_data_w;
-wire [  3:0]  ext_wr_w;
-wire          ext_rd_w;
-wire [  7:0]  ext_len_w;
-wire [ 31:0]  ext_addr_w;
-wire [ 31:0]  ext_write_data_w;
+wire          pmem_accept_w;
+wire          pmem_ack_w;
+wire [ 31:0]  pmem_read_data_w;
+wire [  3:0]  pmem_wr_w;
+wire          pmem_rd_w;
+wire [  7:0]  pmem_len_w;
+wire [ 31:0]  pmem_addr_w;
+wire [ 31:0]  pmem_write_data_w;
 
 tcm_mem_pmem
 u_conv
@@ -117,10 +136,10 @@ u_conv
     .axi_arlen_i(axi_arlen_i),
     .axi_arburst_i(axi_arburst_i),
     .axi_rready_i(axi_rready_i),
-    .ram_accept_i(ext_accept_w),
-    .ram_ack_i(ext_ack_w),
+    .ram_accept_i(pmem_accept_w),
+    .ram_ack_i(pmem_ack_w),
     .ram_error_i(1'b0),
-    .ram_read_data_i(ext_read_data_w),
+    .ram_read_data_i(pmem_read_data_w),
 
     // Outputs
     .axi_awready_o(axi_awready_o),
@@ -134,55 +153,187 @@ u_conv
     .axi_rresp_o(axi_rresp_o),
     .axi_rid_o(axi_rid_o),
     .axi_rlast_o(axi_rlast_o),
-    .ram_wr_o(ext_wr_w),
-    .ram_rd_o(ext_rd_w),
-    .ram_len_o(ext_len_w),
-    .ram_addr_o(ext_addr_w),
-    .ram_write_data_o(ext_write_data_w)
+    .ram_wr_o(pmem_wr_w),
+    .ram_rd_o(pmem_rd_w),
+    .ram_len_o(pmem_len_w),
+    .ram_addr_o(pmem_addr_w),
+    .ram_write_data_o(pmem_write_data_w)
 );
 
 //-------------------------------------------------------------
-// Dual Port RAM
+// External requester mux: AXI target port vs DMA engine.
+// Alternate between the two when both are requesting.
 //-------------------------------------------------------------
+wire          ext_accept_w;
+wire          ext_ack_w;
+wire [ 31:0]  ext_read_data_w;
+
+wire          pmem_req_w = pmem_rd_w || (pmem_wr_w != 4'b0);
+wire          dma_req_w  = dma_rd_i  || (dma_wr_i  != 4'b0);
+
+reg           dma_prio_q;
+wire          dma_sel_w  = dma_req_w && (!pmem_req_w || dma_prio_q);
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    dma_prio_q <= 1'b0;
+else if (pmem_req_w && dma_req_w && ext_accept_w)
+    dma_prio_q <= !dma_sel_w;
+
+wire          ext_rd_w         = dma_sel_w ? dma_rd_i      : pmem_rd_w;
+wire [  3:0]  ext_wr_w         = dma_sel_w ? dma_wr_i      : pmem_wr_w;
+wire [ 31:0]  ext_addr_w       = dma_sel_w ? dma_addr_i    : pmem_addr_w;
+wire [ 31:0]  ext_write_data_w = dma_sel_w ? dma_data_wr_i : pmem_write_data_w;
+
+reg           ext_dma_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    ext_dma_q <= 1'b0;
+else
+    ext_dma_q <= dma_sel_w;
+
+assign pmem_accept_w    = ext_accept_w && !dma_sel_w;
+assign pmem_ack_w       = ext_ack_w && !ext_dma_q;
+assign pmem_read_data_w = ext_read_data_w;
+
+assign dma_accept_o     = ext_accept_w && dma_sel_w;
+assign dma_ack_o        = ext_ack_w && ext_dma_q;
+assign dma_data_rd_o    = ext_read_data_w;
+
+//-------------------------------------------------------------
+// Banked Dual Port RAM
+// 64-bit words are interleaved across TCM_NUM_BANKS banks; port 0
+// of each bank serves instruction fetch, port 1 is shared between
+// CPU data access and external (AXI target / DMA) access.  Data and external
+// accesses to different banks proceed in the same cycle.
+//-------------------------------------------------------------
+localparam ROW_W  = TCM_MEM_SIZE_W - 3 - TCM_NUM_BANKS_W;
+localparam BANK_W = (TCM_NUM_BANKS_W == 0) ? 1 : TCM_NUM_BANKS_W;
+
+wire [31:0]       i_word_w   = {3'b0, mem_i_pc_i[31:3]};
+wire [31:0]       d_word_w   = {3'b0, mem_d_addr_i[31:3]};
+wire [31:0]       ext_word_w = {3'b0, ext_addr_w[31:3]};
+
+/* verilator lint_off WIDTH */
+wire [BANK_W-1:0] i_bank_w   = i_word_w   & (TCM_NUM_BANKS - 1);
+wire [BANK_W-1:0] d_bank_w   = d_word_w   & (TCM_NUM_BANKS - 1);
+wire [BANK_W-1:0] ext_bank_w = ext_word_w & (TCM_NUM_BANKS - 1);
+wire [ROW_W-1:0]  i_row_w    = i_word_w   >> TCM_NUM_BANKS_W;
+wire [ROW_W-1:0]  d_row_w    = d_word_w   >> TCM_NUM_BANKS_W;
+wire [ROW_W-1:0]  ext_row_w  = ext_word_w >> TCM_NUM_BANKS_W;
+/* verilator lint_on WIDTH */
+
+wire              d_ram_req_w = mem_d_rd_i || (mem_d_wr_i != 4'b0);
+wire              ext_req_w   = ext_rd_w || (ext_wr_w != 4'b0);
 
-// Mux access to the 2nd port between external access and CPU data access
-wire                 muxed_hi_w   = ext_accept_w ? ext_addr_w[2] : mem_d_addr_i[2];
-wire [12:0] muxed_addr_w = ext_accept_w ? ext_addr_w[15:3] : mem_d_addr_i[15:3];
-wire [31:0] muxed_data_w = ext_accept_w ? ext_write_data_w : mem_d_data_wr_i;
-wire [3:0]  muxed_wr_w   = ext_accept_w ? ext_wr_w         : mem_d_wr_i;
-wire [63:0] data_r_w;
+// Same bank: alternate between external and data access
+wire              conflict_w  = d_ram_req_w && ext_req_w && (d_bank_w == ext_bank_w);
+reg               d_prio_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    d_prio_q <= 1'b0;
+else
+    d_prio_q <= conflict_w && !d_prio_q;
+
+assign ext_accept_w   = !(conflict_w && d_prio_q);
+assign mem_d_accept_o = !(conflict_w && !d_prio_q);
+
+reg [(TCM_NUM_BANKS*ROW_W)-1:0] addr0_r;
+reg [(TCM_NUM_BANKS*ROW_W)-1:0] addr1_r;
+reg [(TCM_NUM_BANKS*64)-1:0]    data1_r;
+reg [(TCM_NUM_BANKS*8)-1:0]     wr1_r;
+
+integer b;
+
+/* verilator lint_off WIDTH */
+always @ *
+begin
+    addr1_r = {(TCM_NUM_BANKS*ROW_W){1'b0}};
+    data1_r = {(TCM_NUM_BANKS*64){1'b0}};
+    wr1_r   = {(TCM_NUM_BANKS*8){1'b0}};
+
+    for (b=0;b<TCM_NUM_BANKS;b=b+1)
+    begin
+        addr0_r[b*ROW_W +: ROW_W] = i_row_w;
+
+        if (ext_req_w && ext_accept_w && ext_bank_w == b)
+        begin
+            addr1_r[b*ROW_W +: ROW_W] = ext_row_w;
+            data1_r[b*64 +: 64]       = {ext_write_data_w, ext_write_data_w};
+            wr1_r[b*8 +: 8]           = ext_addr_w[2] ? {ext_wr_w, 4'b0} : {4'b0, ext_wr_w};
+        end
+        else
+        begin
+            addr1_r[b*ROW_W +: ROW_W] = d_row_w;
+            data1_r[b*64 +: 64]       = {mem_d_data_wr_i, mem_d_data_wr_i};
+
+            if (mem_d_accept_o && d_bank_w == b)
+                wr1_r[b*8 +: 8]       = mem_d_addr_i[2] ? {mem_d_wr_i, 4'b0} : {4'b0, mem_d_wr_i};
+        end
+    end
+end
+/* verilator lint_on WIDTH */
+
+wire [(TCM_NUM_BANKS*64)-1:0] data0_w;
+wire [(TCM_NUM_BANKS*64)-1:0] data1_w;
 
 tcm_mem_ram
+#(
+     .TCM_NUM_BANKS(TCM_NUM_BANKS)
+    ,.ADDR_W(ROW_W)
+)
 u_ram
 (
     // Instruction fetch
      .clk0_i(clk_i)
     ,.rst0_i(rst_i)
-    ,.addr0_i(mem_i_pc_i[15:3])
-    ,.data0_i(64'b0)
-    ,.wr0_i(8'b0)
+    ,.addr0_i(addr0_r)
+    ,.data0_i({(TCM_NUM_BANKS*64){1'b0}})
+    ,.wr0_i({(TCM_NUM_BANKS*8){1'b0}})
 
     // External access / Data access
     ,.clk1_i(clk_i)
     ,.rst1_i(rst_i)
-    ,.addr1_i(muxed_addr_w)
-    ,.data1_i(muxed_hi_w ? {muxed_data_w, 32'b0} : {32'b0, muxed_data_w})
-    ,.wr1_i(muxed_hi_w ? {muxed_wr_w, 4'b0} : {4'b0, muxed_wr_w})
+    ,.addr1_i(addr1_r)
+    ,.data1_i(data1_r)
+    ,.wr1_i(wr1_r)
 
     // Outputs
-    ,.data0_o(mem_i_inst_o)
-    ,.data1_o(data_r_w)
+    ,.data0_o(data0_w)
+    ,.data1_o(data1_w)
 );
 
-reg muxed_hi_q;
+reg [BANK_W-1:0] i_bank_q;
+reg [BANK_W-1:0] d_bank_q;
+reg              d_hi_q;
+reg [BANK_W-1:0] ext_bank_q;
+reg              ext_hi_q;
 
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
-    muxed_hi_q <= 1'b0;
+begin
+    i_bank_q   <= {BANK_W{1'b0}};
+    d_bank_q   <= {BANK_W{1'b0}};
+    d_hi_q     <= 1'b0;
+    ext_bank_q <= {BANK_W{1'b0}};
+    ext_hi_q   <= 1'b0;
+end
 else
-    muxed_hi_q <= muxed_hi_w;
+begin
+    i_bank_q   <= i_bank_w;
+    d_bank_q   <= d_bank_w;
+    d_hi_q     <= mem_d_addr_i[2];
+    ext_bank_q <= ext_bank_w;
+    ext_hi_q   <= ext_addr_w[2];
+end
+
+wire [63:0] d_data_w   = data1_w[d_bank_q*64 +: 64];
+wire [63:0] ext_data_w = data1_w[ext_bank_q*64 +: 64];
 
-assign ext_read_data_w = muxed_hi_q ? data_r_w[63:32] : data_r_w[31:0];
+assign mem_i_inst_o    = data0_w[i_bank_q*64 +: 64];
+assign ext_read_data_w = ext_hi_q ? ext_data_w[63:32] : ext_data_w[31:0];
 
 //-------------------------------------------------------------
 // Instruction Fetch
@@ -202,20 +353,10 @@ assign mem_i_error_o   = 1'b0;
 //-------------------------------------------------------------
 // Data Access / Incoming external access
 //-------------------------------------------------------------
-reg        mem_d_accept_q;
 reg [10:0] mem_d_tag_q;
 reg        mem_d_ack_q;
 reg        ext_ack_q;
 
-always @ (posedge clk_i or posedge rst_i)
-if (rst_i)
-    mem_d_accept_q <= 1'b1;
-// External request, do not accept internal requests in next cycle
-else if (ext_rd_w || ext_wr_w != 4'b0)
-    mem_d_accept_q <= 1'b0;
-else
-    mem_d_accept_q <= 1'b1;
-
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
 begin
@@ -241,11 +382,8 @@ else
 
 assign mem_d_ack_o          = mem_d_ack_q;
 assign mem_d_resp_tag_o     = mem_d_tag_q;
-assign mem_d_data_rd_o      = muxed_hi_q ? data_r_w[63:32] : data_r_w[31:0];
+assign mem_d_data_rd_o      = d_hi_q ? d_data_w[63:32] : d_data_w[31:0];
 assign mem_d_error_o        = 1'b0;
-
-assign mem_d_accept_o       = mem_d_accept_q;
-assign ext_accept_w         = !mem_d_accept_q;
 assign ext_ack_w            = ext_ack_q;
 
 `ifdef verilator
@@ -255,17 +393,14 @@ assign ext_ack_w            = ext_ack_q;
 function write; /*verilator public*/
     input [31:0] addr;
     input [7:0]  data;
+    reg   [31:0] word;
+    reg   [31:0] bank;
+    reg   [31:0] row;
 begin
-    case (addr[2:0])
-    3'd0: u_ram.ram[addr/8][7:0]   = data;
-    3'd1: u_ram.ram[addr/8][15:8]  = data;
-    3'd2: u_ram.ram[addr/8][23:16] = data;
-    3'd3: u_ram.ram[addr/8][31:24] = data;
-    3'd4: u_ram.ram[addr/8][39:32] = data;
-    3'd5: u_ram.ram[addr/8][47:40] = data;
-    3'd6: u_ram.ram[addr/8][55:48] = data;
-    3'd7: u_ram.ram[addr/8][63:56] = data;
-    endcase
+    word = {3'b0, addr[31:3]};
+    bank = word & (TCM_NUM_BANKS - 1);
+    row  = (word >> TCM_NUM_BANKS_W) & ((1 << ROW_W) - 1);
+    u_ram.ram[bank][row][addr[2:0]*8 +: 8] = data;
 end
 endfunction
 //-------------------------------------------------------------
@@ -273,17 +408,22 @@ endfunction
 //-------------------------------------------------------------
 function [7:0] read; /*verilator public*/
     input [31:0] addr;
+    reg   [31:0] word;
+    reg   [31:0] bank;
+    reg   [31:0] row;
+begin
+    word = {3'b0, addr[31:3]};
+    bank = word & (TCM_NUM_BANKS - 1);
+    row  = (word >> TCM_NUM_BANKS_W) & ((1 << ROW_W) - 1);
+    read = u_ram.ram[bank][row][addr[2:0]*8 +: 8];
+end
+endfunction
+//-------------------------------------------------------------
+// get_size: TCM size in bytes
+//-------------------------------------------------------------
+function [31:0] get_size; /*verilator public*/
 begin
-    case (addr[2:0])
-    3'd0: read = u_ram.ram[addr/8][7:0];
-    3'd1: read = u_ram.ram[addr/8][15:8];
-    3'd2: read = u_ram.ram[addr/8][23:16];
-    3'd3: read = u_ram.ram[addr/8][31:24];
-    3'd4: read = u_ram.ram[addr/8][39:32];
-    3'd5: read = u_ram.ram[addr/8][47:40];
-    3'd6: read = u_ram.ram[addr/8][55:48];
-    3'd7: read = u_ram.ram[addr/8][63:56];
-    endcase
+    get_size = TCM_MEM_SIZE;
 end
 endfunction
 `endif
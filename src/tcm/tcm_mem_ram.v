@@ -24,85 +24,80 @@
 //-----------------------------------------------------------------
 
 module tcm_mem_ram
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter TCM_NUM_BANKS    = 1
+    ,parameter ADDR_W           = 13
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk0_i
     ,input           rst0_i
-    ,input  [ 12:0]  addr0_i
-    ,input  [ 63:0]  data0_i
-    ,input  [  7:0]  wr0_i
+    ,input  [(TCM_NUM_BANKS*ADDR_W)-1:0] addr0_i
+    ,input  [(TCM_NUM_BANKS*64)-1:0] data0_i
+    ,input  [(TCM_NUM_BANKS*8)-1:0] wr0_i
     ,input           clk1_i
     ,input           rst1_i
-    ,input  [ 12:0]  addr1_i
-    ,input  [ 63:0]  data1_i
-    ,input  [  7:0]  wr1_i
+    ,input  [(TCM_NUM_BANKS*ADDR_W)-1:0] addr1_i
+    ,input  [(TCM_NUM_BANKS*64)-1:0] data1_i
+    ,input  [(TCM_NUM_BANKS*8)-1:0] wr1_i
 
     // Outputs
-    ,output [ 63:0]  data0_o
-    ,output [ 63:0]  data1_o
+    ,output [(TCM_NUM_BANKS*64)-1:0] data0_o
+    ,output [(TCM_NUM_BANKS*64)-1:0] data1_o
 );
 
 
 
 //-----------------------------------------------------------------
-// Dual Port RAM 64KB
+// Dual Port RAM banks (TCM_NUM_BANKS x (2^ADDR_W) x 64)
 // Mode: Read First
 //-----------------------------------------------------------------
 /* verilator lint_off MULTIDRIVEN */
-reg [63:0]   ram [8191:0] /*verilator public*/;
+reg [63:0]   ram [TCM_NUM_BANKS-1:0][(1 << ADDR_W)-1:0] /*verilator public*/;
 /* verilator lint_on MULTIDRIVEN */
 
-reg [63:0] ram_read0_q;
-reg [63:0] ram_read1_q;
-
-
-// Synchronous write
-always @ (posedge clk0_i)
-begin
-    if (wr0_i[0])
-        ram[addr0_i][7:0] <= data0_i[7:0];
-    if (wr0_i[1])
-        ram[addr0_i][15:8] <= data0_i[15:8];
-    if (wr0_i[2])
-        ram[addr0_i][23:16] <= data0_i[23:16];
-    if (wr0_i[3])
-        ram[addr0_i][31:24] <= data0_i[31:24];
-    if (wr0_i[4])
-        ram[addr0_i][39:32] <= data0_i[39:32];
-    if (wr0_i[5])
-        ram[addr0_i][47:40] <= data0_i[47:40];
-    if (wr0_i[6])
-        ram[addr0_i][55:48] <= data0_i[55:48];
-    if (wr0_i[7])
-        ram[addr0_i][63:56] <= data0_i[63:56];
-
-    ram_read0_q <= ram[addr0_i];
-end
+genvar g_bank;
+generate
+for (g_bank=0; g_bank<TCM_NUM_BANKS; g_bank=g_bank+1)
+begin : BANK
+    wire [ADDR_W-1:0] addr0_w = addr0_i[g_bank*ADDR_W +: ADDR_W];
+    wire [ADDR_W-1:0] addr1_w = addr1_i[g_bank*ADDR_W +: ADDR_W];
 
-always @ (posedge clk1_i)
-begin
-    if (wr1_i[0])
-        ram[addr1_i][7:0] <= data1_i[7:0];
-    if (wr1_i[1])
-        ram[addr1_i][15:8] <= data1_i[15:8];
-    if (wr1_i[2])
-        ram[addr1_i][23:16] <= data1_i[23:16];
-    if (wr1_i[3])
-        ram[addr1_i][31:24] <= data1_i[31:24];
-    if (wr1_i[4])
-        ram[addr1_i][39:32] <= data1_i[39:32];
-    if (wr1_i[5])
-        ram[addr1_i][47:40] <= data1_i[47:40];
-    if (wr1_i[6])
-        ram[addr1_i][55:48] <= data1_i[55:48];
-    if (wr1_i[7])
-        ram[addr1_i][63:56] <= data1_i[63:56];
-
-    ram_read1_q <= ram[addr1_i];
-end
+    reg [63:0] ram_read0_q;
+    reg [63:0] ram_read1_q;
 
-assign data0_o = ram_read0_q;
-assign data1_o = ram_read1_q;
+    integer i0;
+    integer i1;
+
+    // Synchronous write
+    always @ (posedge clk0_i)
+    begin
+        for (i0=0;i0<8;i0=i0+1)
+            if (wr0_i[g_bank*8 + i0])
+                ram[g_bank][addr0_w][i0*8 +: 8] <= data0_i[g_bank*64 + i0*8 +: 8];
+
+        ram_read0_q <= ram[g_bank][addr0_w];
+    end
+
+    always @ (posedge clk1_i)
+    begin
+        for (i1=0;i1<8;i1=i1+1)
+            if (wr1_i[g_bank*8 + i1])
+                ram[g_bank][addr1_w][i1*8 +: 8] <= data1_i[g_bank*64 + i1*8 +: 8];
+
+        ram_read1_q <= ram[g_bank][addr1_w];
+    end
+
+    assign data0_o[g_bank*64 +: 64] = ram_read0_q;
+    assign data1_o[g_bank*64 +: 64] = ram_read1_q;
+end
+endgenerate
 
 
 
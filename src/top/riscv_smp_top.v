@@ -0,0 +1,580 @@
+//-----------------------------------------------------------------
+//                         biRISC-V CPU
+//                            V0.8.1
+//                     Ultra-Embedded.com
+//                     Copyright 2019-2020
+//
+//                   admin@ultra-embedded.com
+//
+//                     License: Apache 2.0
+//-----------------------------------------------------------------
+// Copyright 2020 Ultra-Embedded.com
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------
+
+module riscv_smp_top
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter NUM_CORES        = 2
+    ,parameter NUM_CORES_W      = 1
+    ,parameter CORE_ID          = 0
+    ,parameter SUPPORT_BRANCH_PREDICTION = 1
+    ,parameter SUPPORT_MULDIV   = 1
+    ,parameter SUPPORT_SUPER    = 0
+    ,parameter SUPPORT_MMU      = 0
+    ,parameter SUPPORT_DUAL_ISSUE = 1
+    ,parameter SUPPORT_LOAD_BYPASS = 1
+    ,parameter SUPPORT_MUL_BYPASS = 1
+    ,parameter SUPPORT_REGFILE_XILINX = 0
+    ,parameter EXTRA_DECODE_STAGE = 0
+    ,parameter MEM_CACHE_ADDR_MIN = 32'h80000000
+    ,parameter MEM_CACHE_ADDR_MAX = 32'h8fffffff
+    ,parameter NUM_BTB_ENTRIES  = 32
+    ,parameter NUM_BTB_ENTRIES_W = 5
+    ,parameter NUM_BHT_ENTRIES  = 512
+    ,parameter NUM_BHT_ENTRIES_W = 9
+    ,parameter RAS_ENABLE       = 1
+    ,parameter GSHARE_ENABLE    = 0
+    ,parameter BHT_ENABLE       = 1
+    ,parameter NUM_RAS_ENTRIES  = 8
+    ,parameter NUM_RAS_ENTRIES_W = 3
+    ,parameter DIV_BITS_PER_CYCLE = 1
+    ,parameter DIV_EARLY_OUT    = 0
+    ,parameter SUPPORT_RVC      = 0
+    ,parameter SUPPORT_BITMANIP = 0
+    ,parameter SUPPORT_FUSION   = 0
+    ,parameter SUPPORT_NONBLOCKING_LOAD = 0
+    ,parameter SUPPORT_DUAL_LSU = 0
+    ,parameter SUPPORT_STORE_FWD = 0
+    ,parameter SUPPORT_CLIC     = 0
+    ,parameter ITLB_ENTRIES     = 8
+    ,parameter ITLB_ENTRIES_W   = 3
+    ,parameter DTLB_ENTRIES     = 8
+    ,parameter DTLB_ENTRIES_W   = 3
+    ,parameter PTW_CACHE_ENTRIES   = 4
+    ,parameter PTW_CACHE_ENTRIES_W = 2
+    ,parameter ICACHE_NUM_WAYS  = 2
+    ,parameter ICACHE_NUM_WAYS_W = 1
+    ,parameter ICACHE_NUM_LINES = 256
+    ,parameter ICACHE_NUM_LINES_W = 8
+    ,parameter ICACHE_LINE_SIZE = 32
+    ,parameter ICACHE_LINE_SIZE_W = 5
+    ,parameter ICACHE_PLRU_ENABLE = 0
+    ,parameter DCACHE_NUM_WAYS  = 2
+    ,parameter DCACHE_NUM_WAYS_W = 1
+    ,parameter DCACHE_NUM_LINES = 256
+    ,parameter DCACHE_NUM_LINES_W = 8
+    ,parameter DCACHE_LINE_SIZE = 32
+    ,parameter DCACHE_LINE_SIZE_W = 5
+    ,parameter DCACHE_PLRU_ENABLE = 0
+    ,parameter AXI_DATA_W       = 32
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input           axi_awready_i
+    ,input           axi_wready_i
+    ,input           axi_bvalid_i
+    ,input  [  1:0]  axi_bresp_i
+    ,input  [  3:0]  axi_bid_i
+    ,input           axi_arready_i
+    ,input           axi_rvalid_i
+    ,input  [AXI_DATA_W-1:0] axi_rdata_i
+    ,input  [  1:0]  axi_rresp_i
+    ,input  [  3:0]  axi_rid_i
+    ,input           axi_rlast_i
+    ,input  [  7:0]  intr_i
+    ,input  [ 31:0]  reset_vector_i
+
+    // Outputs
+    ,output          axi_awvalid_o
+    ,output [ 31:0]  axi_awaddr_o
+    ,output [  3:0]  axi_awid_o
+    ,output [  7:0]  axi_awlen_o
+    ,output [  1:0]  axi_awburst_o
+    ,output          axi_wvalid_o
+    ,output [AXI_DATA_W-1:0] axi_wdata_o
+    ,output [(AXI_DATA_W/8)-1:0] axi_wstrb_o
+    ,output          axi_wlast_o
+    ,output          axi_bready_o
+    ,output          axi_arvalid_o
+    ,output [ 31:0]  axi_araddr_o
+    ,output [  3:0]  axi_arid_o
+    ,output [  7:0]  axi_arlen_o
+    ,output [  1:0]  axi_arburst_o
+    ,output          axi_rready_o
+);
+
+//-----------------------------------------------------------------
+// Cluster of NUM_CORES harts (up to 8) - each with private I/D caches.
+// Data caches are kept coherent by per-hart ownership directories
+// (smp_dport) and a serialising ownership controller (smp_coherence).
+// The data caches run in blocking mode without store buffer or
+// prefetcher so that every line they hold entered via smp_dport.
+//
+// All caches share a single AXI4 master port, hart N using AXI IDs
+// 2N (instruction) and 2N+1 (data).
+//-----------------------------------------------------------------
+localparam NUM_PORTS   = NUM_CORES * 2;
+localparam NUM_PORTS_W = NUM_CORES_W + 1;
+localparam STRB_W      = AXI_DATA_W / 8;
+
+// Arbiter inputs (port 2N = hart N icache, port 2N+1 = hart N dcache)
+wire [NUM_PORTS-1:0]              arb_awvalid_w;
+wire [(NUM_PORTS*32)-1:0]         arb_awaddr_w;
+wire [(NUM_PORTS*4)-1:0]          arb_awid_w;
+wire [(NUM_PORTS*8)-1:0]          arb_awlen_w;
+wire [(NUM_PORTS*2)-1:0]          arb_awburst_w;
+wire [NUM_PORTS-1:0]              arb_wvalid_w;
+wire [(NUM_PORTS*AXI_DATA_W)-1:0] arb_wdata_w;
+wire [(NUM_PORTS*STRB_W)-1:0]     arb_wstrb_w;
+wire [NUM_PORTS-1:0]              arb_wlast_w;
+wire [NUM_PORTS-1:0]              arb_bready_w;
+wire [NUM_PORTS-1:0]              arb_arvalid_w;
+wire [(NUM_PORTS*32)-1:0]         arb_araddr_w;
+wire [(NUM_PORTS*4)-1:0]          arb_arid_w;
+wire [(NUM_PORTS*8)-1:0]          arb_arlen_w;
+wire [(NUM_PORTS*2)-1:0]          arb_arburst_w;
+wire [NUM_PORTS-1:0]              arb_rready_w;
+wire [NUM_PORTS-1:0]              arb_awready_w;
+wire [NUM_PORTS-1:0]              arb_wready_w;
+wire [NUM_PORTS-1:0]              arb_bvalid_w;
+wire [(NUM_PORTS*2)-1:0]          arb_bresp_w;
+wire [(NUM_PORTS*4)-1:0]          arb_bid_w;
+wire [NUM_PORTS-1:0]              arb_arready_w;
+wire [NUM_PORTS-1:0]              arb_rvalid_w;
+wire [(NUM_PORTS*AXI_DATA_W)-1:0] arb_rdata_w;
+wire [(NUM_PORTS*2)-1:0]          arb_rresp_w;
+wire [(NUM_PORTS*4)-1:0]          arb_rid_w;
+wire [NUM_PORTS-1:0]              arb_rlast_w;
+
+// Coherence
+wire [NUM_CORES-1:0]              acq_req_w;
+wire [(NUM_CORES*32)-1:0]         acq_addr_w;
+wire [NUM_CORES-1:0]              acq_gnt_w;
+wire [NUM_CORES-1:0]              snp_req_w;
+wire [31:0]                       snp_addr_w;
+wire [NUM_CORES-1:0]              snp_ack_w;
+
+genvar g_hart;
+generate
+for (g_hart = 0; g_hart < NUM_CORES; g_hart = g_hart + 1)
+begin : HART
+    wire           icache_valid_w;
+    wire           icache_flush_w;
+    wire           icache_invalidate_w;
+    wire           icache_error_w;
+    wire           icache_accept_w;
+    wire  [ 63:0]  icache_inst_w;
+    wire  [ 31:0]  icache_pc_w;
+    wire           icache_rd_w;
+    wire  [ 31:0]  cpu_id_w = CORE_ID + g_hart;
+
+    // Core <-> coherence port
+    wire  [ 31:0]  cpu_addr_w;
+    wire  [ 31:0]  cpu_data_wr_w;
+    wire           cpu_rd_w;
+    wire  [  3:0]  cpu_wr_w;
+    wire           cpu_cacheable_w;
+    wire  [ 10:0]  cpu_req_tag_w;
+    wire           cpu_invalidate_w;
+    wire           cpu_writeback_w;
+    wire           cpu_flush_w;
+    wire  [ 31:0]  cpu_pc_w;
+    wire  [ 31:0]  cpu_data_rd_w;
+    wire           cpu_accept_w;
+    wire           cpu_ack_w;
+    wire           cpu_error_w;
+    wire  [ 10:0]  cpu_resp_tag_w;
+
+    // Coherence port <-> data cache
+    wire  [ 31:0]  dcache_addr_w;
+    wire  [ 31:0]  dcache_data_wr_w;
+    wire           dcache_rd_w;
+    wire  [  3:0]  dcache_wr_w;
+    wire           dcache_cacheable_w;
+    wire  [ 10:0]  dcache_req_tag_w;
+    wire           dcache_invalidate_w;
+    wire           dcache_writeback_w;
+    wire           dcache_flush_w;
+    wire  [ 31:0]  dcache_pc_w;
+    wire  [ 31:0]  dcache_data_rd_w;
+    wire           dcache_accept_w;
+    wire           dcache_ack_w;
+    wire           dcache_error_w;
+    wire           dcache_store_empty_w;
+    wire           dcache_fill_error_w;
+    wire  [ 31:0]  dcache_fill_error_addr_w;
+    wire  [ 10:0]  dcache_resp_tag_w;
+
+    riscv_core
+    #(
+         .MEM_CACHE_ADDR_MIN(MEM_CACHE_ADDR_MIN)
+        ,.MEM_CACHE_ADDR_MAX(MEM_CACHE_ADDR_MAX)
+        ,.SUPPORT_BRANCH_PREDICTION(SUPPORT_BRANCH_PREDICTION)
+        ,.SUPPORT_MULDIV(SUPPORT_MULDIV)
+        ,.SUPPORT_SUPER(SUPPORT_SUPER)
+        ,.SUPPORT_MMU(SUPPORT_MMU)
+        ,.SUPPORT_DUAL_ISSUE(SUPPORT_DUAL_ISSUE)
+        ,.SUPPORT_LOAD_BYPASS(SUPPORT_LOAD_BYPASS)
+        ,.SUPPORT_MUL_BYPASS(SUPPORT_MUL_BYPASS)
+        ,.SUPPORT_REGFILE_XILINX(SUPPORT_REGFILE_XILINX)
+        ,.EXTRA_DECODE_STAGE(EXTRA_DECODE_STAGE)
+        ,.NUM_BTB_ENTRIES(NUM_BTB_ENTRIES)
+        ,.NUM_BTB_ENTRIES_W(NUM_BTB_ENTRIES_W)
+        ,.NUM_BHT_ENTRIES(NUM_BHT_ENTRIES)
+        ,.NUM_BHT_ENTRIES_W(NUM_BHT_ENTRIES_W)
+        ,.RAS_ENABLE(RAS_ENABLE)
+        ,.GSHARE_ENABLE(GSHARE_ENABLE)
+        ,.BHT_ENABLE(BHT_ENABLE)
+        ,.NUM_RAS_ENTRIES(NUM_RAS_ENTRIES)
+        ,.NUM_RAS_ENTRIES_W(NUM_RAS_ENTRIES_W)
+        ,.DIV_BITS_PER_CYCLE(DIV_BITS_PER_CYCLE)
+        ,.DIV_EARLY_OUT(DIV_EARLY_OUT)
+        ,.SUPPORT_RVC(SUPPORT_RVC)
+        ,.SUPPORT_BITMANIP(SUPPORT_BITMANIP)
+        ,.SUPPORT_FUSION(SUPPORT_FUSION)
+        ,.SUPPORT_NONBLOCKING_LOAD(SUPPORT_NONBLOCKING_LOAD)
+        ,.SUPPORT_DUAL_LSU(SUPPORT_DUAL_LSU)
+        ,.SUPPORT_STORE_FWD(SUPPORT_STORE_FWD)
+        ,.SUPPORT_CLIC(SUPPORT_CLIC)
+        ,.CBO_ZERO_ALLOC(1)
+        ,.CBO_BLOCK_SIZE(DCACHE_LINE_SIZE)
+        ,.CBO_BLOCK_SIZE_W(DCACHE_LINE_SIZE_W)
+        ,.ITLB_ENTRIES(ITLB_ENTRIES)
+        ,.ITLB_ENTRIES_W(ITLB_ENTRIES_W)
+        ,.DTLB_ENTRIES(DTLB_ENTRIES)
+        ,.DTLB_ENTRIES_W(DTLB_ENTRIES_W)
+        ,.PTW_CACHE_ENTRIES(PTW_CACHE_ENTRIES)
+        ,.PTW_CACHE_ENTRIES_W(PTW_CACHE_ENTRIES_W)
+    )
+    u_core
+    (
+        // Inputs
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.mem_d_data_rd_i(cpu_data_rd_w)
+        ,.mem_d_accept_i(cpu_accept_w)
+        ,.mem_d_ack_i(cpu_ack_w)
+        ,.mem_d_error_i(cpu_error_w)
+        ,.mem_d_resp_tag_i(cpu_resp_tag_w)
+        ,.mem_d_store_error_i(1'b0)
+        ,.mem_d_store_error_addr_i(32'b0)
+        ,.mem_d_store_empty_i(dcache_store_empty_w)
+        ,.mem_d_fill_error_i(dcache_fill_error_w)
+        ,.mem_d_fill_error_addr_i(dcache_fill_error_addr_w)
+        ,.mem_i_accept_i(icache_accept_w)
+        ,.mem_i_valid_i(icache_valid_w)
+        ,.mem_i_error_i(icache_error_w)
+        ,.mem_i_inst_i(icache_inst_w)
+        ,.intr_i({31'b0, intr_i[g_hart]})
+        ,.timer_intr_i(1'b0)
+        ,.reset_vector_i(reset_vector_i)
+        ,.cpu_id_i(cpu_id_w)
+
+        // Outputs
+        ,.mem_d_addr_o(cpu_addr_w)
+        ,.mem_d_data_wr_o(cpu_data_wr_w)
+        ,.mem_d_rd_o(cpu_rd_w)
+        ,.mem_d_wr_o(cpu_wr_w)
+        ,.mem_d_cacheable_o(cpu_cacheable_w)
+        ,.mem_d_req_tag_o(cpu_req_tag_w)
+        ,.mem_d_invalidate_o(cpu_invalidate_w)
+        ,.mem_d_writeback_o(cpu_writeback_w)
+        ,.mem_d_flush_o(cpu_flush_w)
+        ,.mem_d_pc_o(cpu_pc_w)
+        ,.mem_i_rd_o(icache_rd_w)
+        ,.mem_i_flush_o(icache_flush_w)
+        ,.mem_i_invalidate_o(icache_invalidate_w)
+        ,.mem_i_pc_o(icache_pc_w)
+    );
+
+    smp_dport
+    #(
+         .DCACHE_NUM_WAYS(DCACHE_NUM_WAYS)
+        ,.DCACHE_NUM_WAYS_W(DCACHE_NUM_WAYS_W)
+        ,.DCACHE_NUM_LINES(DCACHE_NUM_LINES)
+        ,.DCACHE_NUM_LINES_W(DCACHE_NUM_LINES_W)
+        ,.DCACHE_LINE_SIZE_W(DCACHE_LINE_SIZE_W)
+    )
+    u_dport
+    (
+        // Inputs
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.mem_addr_i(cpu_addr_w)
+        ,.mem_data_wr_i(cpu_data_wr_w)
+        ,.mem_rd_i(cpu_rd_w)
+        ,.mem_wr_i(cpu_wr_w)
+        ,.mem_cacheable_i(cpu_cacheable_w)
+        ,.mem_req_tag_i(cpu_req_tag_w)
+        ,.mem_invalidate_i(cpu_invalidate_w)
+        ,.mem_writeback_i(cpu_writeback_w)
+        ,.mem_flush_i(cpu_flush_w)
+        ,.mem_pc_i(cpu_pc_w)
+        ,.outport_data_rd_i(dcache_data_rd_w)
+        ,.outport_accept_i(dcache_accept_w)
+        ,.outport_ack_i(dcache_ack_w)
+        ,.outport_error_i(dcache_error_w)
+        ,.outport_resp_tag_i(dcache_resp_tag_w)
+        ,.acq_gnt_i(acq_gnt_w[g_hart])
+        ,.snp_req_i(snp_req_w[g_hart])
+        ,.snp_addr_i(snp_addr_w)
+
+        // Outputs
+        ,.mem_data_rd_o(cpu_data_rd_w)
+        ,.mem_accept_o(cpu_accept_w)
+        ,.mem_ack_o(cpu_ack_w)
+        ,.mem_error_o(cpu_error_w)
+        ,.mem_resp_tag_o(cpu_resp_tag_w)
+        ,.outport_addr_o(dcache_addr_w)
+        ,.outport_data_wr_o(dcache_data_wr_w)
+        ,.outport_rd_o(dcache_rd_w)
+        ,.outport_wr_o(dcache_wr_w)
+        ,.outport_cacheable_o(dcache_cacheable_w)
+        ,.outport_req_tag_o(dcache_req_tag_w)
+        ,.outport_invalidate_o(dcache_invalidate_w)
+        ,.outport_writeback_o(dcache_writeback_w)
+        ,.outport_flush_o(dcache_flush_w)
+        ,.outport_pc_o(dcache_pc_w)
+        ,.acq_req_o(acq_req_w[g_hart])
+        ,.acq_addr_o(acq_addr_w[g_hart*32 +: 32])
+        ,.snp_ack_o(snp_ack_w[g_hart])
+    );
+
+    dcache
+    #(
+         .AXI_ID(g_hart*2 + 1)
+        ,.DCACHE_NUM_WAYS(DCACHE_NUM_WAYS)
+        ,.DCACHE_NUM_WAYS_W(DCACHE_NUM_WAYS_W)
+        ,.DCACHE_NUM_LINES(DCACHE_NUM_LINES)
+        ,.DCACHE_NUM_LINES_W(DCACHE_NUM_LINES_W)
+        ,.DCACHE_LINE_SIZE(DCACHE_LINE_SIZE)
+        ,.DCACHE_LINE_SIZE_W(DCACHE_LINE_SIZE_W)
+        ,.DCACHE_PLRU_ENABLE(DCACHE_PLRU_ENABLE)
+        ,.DCACHE_NON_BLOCKING(0)
+        ,.DCACHE_STORE_BUF(0)
+        ,.DCACHE_PREFETCH(0)
+        ,.AXI_DATA_W(AXI_DATA_W)
+    )
+    u_dcache
+    (
+        // Inputs
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.mem_addr_i(dcache_addr_w)
+        ,.mem_data_wr_i(dcache_data_wr_w)
+        ,.mem_rd_i(dcache_rd_w)
+        ,.mem_wr_i(dcache_wr_w)
+        ,.mem_cacheable_i(dcache_cacheable_w)
+        ,.mem_req_tag_i(dcache_req_tag_w)
+        ,.mem_invalidate_i(dcache_invalidate_w)
+        ,.mem_writeback_i(dcache_writeback_w)
+        ,.mem_flush_i(dcache_flush_w)
+        ,.mem_pc_i(dcache_pc_w)
+        ,.axi_awready_i(arb_awready_w[g_hart*2+1])
+        ,.axi_wready_i(arb_wready_w[g_hart*2+1])
+        ,.axi_bvalid_i(arb_bvalid_w[g_hart*2+1])
+        ,.axi_bresp_i(arb_bresp_w[(g_hart*2+1)*2 +: 2])
+        ,.axi_bid_i(arb_bid_w[(g_hart*2+1)*4 +: 4])
+        ,.axi_arready_i(arb_arready_w[g_hart*2+1])
+        ,.axi_rvalid_i(arb_rvalid_w[g_hart*2+1])
+        ,.axi_rdata_i(arb_rdata_w[(g_hart*2+1)*AXI_DATA_W +: AXI_DATA_W])
+        ,.axi_rresp_i(arb_rresp_w[(g_hart*2+1)*2 +: 2])
+        ,.axi_rid_i(arb_rid_w[(g_hart*2+1)*4 +: 4])
+        ,.axi_rlast_i(arb_rlast_w[g_hart*2+1])
+
+        // Outputs
+        ,.mem_data_rd_o(dcache_data_rd_w)
+        ,.mem_accept_o(dcache_accept_w)
+        ,.mem_ack_o(dcache_ack_w)
+        ,.mem_error_o(dcache_error_w)
+        ,.mem_resp_tag_o(dcache_resp_tag_w)
+        ,.mem_store_error_o()
+        ,.mem_store_error_addr_o()
+        ,.mem_store_empty_o(dcache_store_empty_w)
+        ,.mem_fill_error_o(dcache_fill_error_w)
+        ,.mem_fill_error_addr_o(dcache_fill_error_addr_w)
+        ,.axi_awvalid_o(arb_awvalid_w[g_hart*2+1])
+        ,.axi_awaddr_o(arb_awaddr_w[(g_hart*2+1)*32 +: 32])
+        ,.axi_awid_o(arb_awid_w[(g_hart*2+1)*4 +: 4])
+        ,.axi_awlen_o(arb_awlen_w[(g_hart*2+1)*8 +: 8])
+        ,.axi_awburst_o(arb_awburst_w[(g_hart*2+1)*2 +: 2])
+        ,.axi_wvalid_o(arb_wvalid_w[g_hart*2+1])
+        ,.axi_wdata_o(arb_wdata_w[(g_hart*2+1)*AXI_DATA_W +: AXI_DATA_W])
+        ,.axi_wstrb_o(arb_wstrb_w[(g_hart*2+1)*STRB_W +: STRB_W])
+        ,.axi_wlast_o(arb_wlast_w[g_hart*2+1])
+        ,.axi_bready_o(arb_bready_w[g_hart*2+1])
+        ,.axi_arvalid_o(arb_arvalid_w[g_hart*2+1])
+        ,.axi_araddr_o(arb_araddr_w[(g_hart*2+1)*32 +: 32])
+        ,.axi_arid_o(arb_arid_w[(g_hart*2+1)*4 +: 4])
+        ,.axi_arlen_o(arb_arlen_w[(g_hart*2+1)*8 +: 8])
+        ,.axi_arburst_o(arb_arburst_w[(g_hart*2+1)*2 +: 2])
+        ,.axi_rready_o(arb_rready_w[g_hart*2+1])
+    );
+
+    icache
+    #(
+         .AXI_ID(g_hart*2)
+        ,.ICACHE_NUM_WAYS(ICACHE_NUM_WAYS)
+        ,.ICACHE_NUM_WAYS_W(ICACHE_NUM_WAYS_W)
+        ,.ICACHE_NUM_LINES(ICACHE_NUM_LINES)
+        ,.ICACHE_NUM_LINES_W(ICACHE_NUM_LINES_W)
+        ,.ICACHE_LINE_SIZE(ICACHE_LINE_SIZE)
+        ,.ICACHE_LINE_SIZE_W(ICACHE_LINE_SIZE_W)
+        ,.ICACHE_PLRU_ENABLE(ICACHE_PLRU_ENABLE)
+        ,.AXI_DATA_W(AXI_DATA_W)
+    )
+    u_icache
+    (
+        // Inputs
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.req_rd_i(icache_rd_w)
+        ,.req_flush_i(icache_flush_w)
+        ,.req_invalidate_i(icache_invalidate_w)
+        ,.req_pc_i(icache_pc_w)
+        ,.axi_awready_i(arb_awready_w[g_hart*2])
+        ,.axi_wready_i(arb_wready_w[g_hart*2])
+        ,.axi_bvalid_i(arb_bvalid_w[g_hart*2])
+        ,.axi_bresp_i(arb_bresp_w[(g_hart*2)*2 +: 2])
+        ,.axi_bid_i(arb_bid_w[(g_hart*2)*4 +: 4])
+        ,.axi_arready_i(arb_arready_w[g_hart*2])
+        ,.axi_rvalid_i(arb_rvalid_w[g_hart*2])
+        ,.axi_rdata_i(arb_rdata_w[(g_hart*2)*AXI_DATA_W +: AXI_DATA_W])
+        ,.axi_rresp_i(arb_rresp_w[(g_hart*2)*2 +: 2])
+        ,.axi_rid_i(arb_rid_w[(g_hart*2)*4 +: 4])
+        ,.axi_rlast_i(arb_rlast_w[g_hart*2])
+
+        // Outputs
+        ,.req_accept_o(icache_accept_w)
+        ,.req_valid_o(icache_valid_w)
+        ,.req_error_o(icache_error_w)
+        ,.req_inst_o(icache_inst_w)
+        ,.axi_awvalid_o(arb_awvalid_w[g_hart*2])
+        ,.axi_awaddr_o(arb_awaddr_w[(g_hart*2)*32 +: 32])
+        ,.axi_awid_o(arb_awid_w[(g_hart*2)*4 +: 4])
+        ,.axi_awlen_o(arb_awlen_w[(g_hart*2)*8 +: 8])
+        ,.axi_awburst_o(arb_awburst_w[(g_hart*2)*2 +: 2])
+        ,.axi_wvalid_o(arb_wvalid_w[g_hart*2])
+        ,.axi_wdata_o(arb_wdata_w[(g_hart*2)*AXI_DATA_W +: AXI_DATA_W])
+        ,.axi_wstrb_o(arb_wstrb_w[(g_hart*2)*STRB_W +: STRB_W])
+        ,.axi_wlast_o(arb_wlast_w[g_hart*2])
+        ,.axi_bready_o(arb_bready_w[g_hart*2])
+        ,.axi_arvalid_o(arb_arvalid_w[g_hart*2])
+        ,.axi_araddr_o(arb_araddr_w[(g_hart*2)*32 +: 32])
+        ,.axi_arid_o(arb_arid_w[(g_hart*2)*4 +: 4])
+        ,.axi_arlen_o(arb_arlen_w[(g_hart*2)*8 +: 8])
+        ,.axi_arburst_o(arb_arburst_w[(g_hart*2)*2 +: 2])
+        ,.axi_rready_o(arb_rready_w[g_hart*2])
+    );
+end
+endgenerate
+
+smp_coherence
+#(
+     .NUM_CORES(NUM_CORES)
+    ,.NUM_CORES_W(NUM_CORES_W)
+)
+u_coherence
+(
+    // Inputs
+     .clk_i(clk_i)
+    ,.rst_i(rst_i)
+    ,.acq_req_i(acq_req_w)
+    ,.acq_addr_i(acq_addr_w)
+    ,.snp_ack_i(snp_ack_w)
+
+    // Outputs
+    ,.acq_gnt_o(acq_gnt_w)
+    ,.snp_req_o(snp_req_w)
+    ,.snp_addr_o(snp_addr_w)
+);
+
+smp_axi_arb
+#(
+     .NUM_PORTS(NUM_PORTS)
+    ,.NUM_PORTS_W(NUM_PORTS_W)
+    ,.AXI_DATA_W(AXI_DATA_W)
+)
+u_axi_arb
+(
+    // Inputs
+     .clk_i(clk_i)
+    ,.rst_i(rst_i)
+    ,.inport_awvalid_i(arb_awvalid_w)
+    ,.inport_awaddr_i(arb_awaddr_w)
+    ,.inport_awid_i(arb_awid_w)
+    ,.inport_awlen_i(arb_awlen_w)
+    ,.inport_awburst_i(arb_awburst_w)
+    ,.inport_wvalid_i(arb_wvalid_w)
+    ,.inport_wdata_i(arb_wdata_w)
+    ,.inport_wstrb_i(arb_wstrb_w)
+    ,.inport_wlast_i(arb_wlast_w)
+    ,.inport_bready_i(arb_bready_w)
+    ,.inport_arvalid_i(arb_arvalid_w)
+    ,.inport_araddr_i(arb_araddr_w)
+    ,.inport_arid_i(arb_arid_w)
+    ,.inport_arlen_i(arb_arlen_w)
+    ,.inport_arburst_i(arb_arburst_w)
+    ,.inport_rready_i(arb_rready_w)
+    ,.outport_awready_i(axi_awready_i)
+    ,.outport_wready_i(axi_wready_i)
+    ,.outport_bvalid_i(axi_bvalid_i)
+    ,.outport_bresp_i(axi_bresp_i)
+    ,.outport_bid_i(axi_bid_i)
+    ,.outport_arready_i(axi_arready_i)
+    ,.outport_rvalid_i(axi_rvalid_i)
+    ,.outport_rdata_i(axi_rdata_i)
+    ,.outport_rresp_i(axi_rresp_i)
+    ,.outport_rid_i(axi_rid_i)
+    ,.outport_rlast_i(axi_rlast_i)
+
+    // Outputs
+    ,.inport_awready_o(arb_awready_w)
+    ,.inport_wready_o(arb_wready_w)
+    ,.inport_bvalid_o(arb_bvalid_w)
+    ,.inport_bresp_o(arb_bresp_w)
+    ,.inport_bid_o(arb_bid_w)
+    ,.inport_arready_o(arb_arready_w)
+    ,.inport_rvalid_o(arb_rvalid_w)
+    ,.inport_rdata_o(arb_rdata_w)
+    ,.inport_rresp_o(arb_rresp_w)
+    ,.inport_rid_o(arb_rid_w)
+    ,.inport_rlast_o(arb_rlast_w)
+    ,.outport_awvalid_o(axi_awvalid_o)
+    ,.outport_awaddr_o(axi_awaddr_o)
+    ,.outport_awid_o(axi_awid_o)
+    ,.outport_awlen_o(axi_awlen_o)
+    ,.outport_awburst_o(axi_awburst_o)
+    ,.outport_wvalid_o(axi_wvalid_o)
+    ,.outport_wdata_o(axi_wdata_o)
+    ,.outport_wstrb_o(axi_wstrb_o)
+    ,.outport_wlast_o(axi_wlast_o)
+    ,.outport_bready_o(axi_bready_o)
+    ,.outport_arvalid_o(axi_arvalid_o)
+    ,.outport_araddr_o(axi_araddr_o)
+    ,.outport_arid_o(axi_arid_o)
+    ,.outport_arlen_o(axi_arlen_o)
+    ,.outport_arburst_o(axi_arburst_o)
+    ,.outport_rready_o(axi_rready_o)
+);
+
+endmodule
@@ -31,6 +31,15 @@ module riscv_tcm_top
      parameter BOOT_VECTOR      = 32'h00000000
     ,parameter CORE_ID          = 0
     ,parameter TCM_MEM_BASE     = 32'h00000000
+    ,parameter TCM_MEM_SIZE     = 65536
+    ,parameter TCM_MEM_SIZE_W   = 16
+    ,parameter TCM_NUM_BANKS    = 1
+    ,parameter TCM_NUM_BANKS_W  = 0
+    ,parameter SUPPORT_DMA      = 0
+    ,parameter DMA_BASE         = 32'h94000000
+    ,parameter DMA_IRQ_LINE     = 31
+    ,parameter SUPPORT_CLINT    = 0
+    ,parameter CLINT_BASE       = 32'h02000000
     ,parameter SUPPORT_BRANCH_PREDICTION = 1
     ,parameter SUPPORT_MULDIV   = 1
     ,parameter SUPPORT_SUPER    = 0
@@ -51,6 +60,21 @@ module riscv_tcm_top
     ,parameter BHT_ENABLE       = 1
     ,parameter NUM_RAS_ENTRIES  = 8
     ,parameter NUM_RAS_ENTRIES_W = 3
+    ,parameter DIV_BITS_PER_CYCLE = 1
+    ,parameter DIV_EARLY_OUT    = 0
+    ,parameter SUPPORT_RVC      = 0
+    ,parameter SUPPORT_BITMANIP = 0
+    ,parameter SUPPORT_FUSION   = 0
+    ,parameter SUPPORT_NONBLOCKING_LOAD = 0
+    ,parameter SUPPORT_DUAL_LSU = 0
+    ,parameter SUPPORT_STORE_FWD = 0
+    ,parameter SUPPORT_CLIC     = 0
+    ,parameter ITLB_ENTRIES     = 8
+    ,parameter ITLB_ENTRIES_W   = 3
+    ,parameter DTLB_ENTRIES     = 8
+    ,parameter DTLB_ENTRIES_W   = 3
+    ,parameter PTW_CACHE_ENTRIES   = 4
+    ,parameter PTW_CACHE_ENTRIES_W = 2
 )
 //-----------------------------------------------------------------
 // Ports
@@ -84,6 +108,17 @@ module riscv_tcm_top
     ,input  [  7:0]  axi_t_arlen_i
     ,input  [  1:0]  axi_t_arburst_i
     ,input           axi_t_rready_i
+    ,input           axi_dma_awready_i
+    ,input           axi_dma_wready_i
+    ,input           axi_dma_bvalid_i
+    ,input  [  1:0]  axi_dma_bresp_i
+    ,input  [  3:0]  axi_dma_bid_i
+    ,input           axi_dma_arready_i
+    ,input           axi_dma_rvalid_i
+    ,input  [ 31:0]  axi_dma_rdata_i
+    ,input  [  1:0]  axi_dma_rresp_i
+    ,input  [  3:0]  axi_dma_rid_i
+    ,input           axi_dma_rlast_i
     ,input  [ 31:0]  intr_i
 
     // Outputs
@@ -107,6 +142,22 @@ module riscv_tcm_top
     ,output [  1:0]  axi_t_rresp_o
     ,output [  3:0]  axi_t_rid_o
     ,output          axi_t_rlast_o
+    ,output          axi_dma_awvalid_o
+    ,output [ 31:0]  axi_dma_awaddr_o
+    ,output [  3:0]  axi_dma_awid_o
+    ,output [  7:0]  axi_dma_awlen_o
+    ,output [  1:0]  axi_dma_awburst_o
+    ,output          axi_dma_wvalid_o
+    ,output [ 31:0]  axi_dma_wdata_o
+    ,output [  3:0]  axi_dma_wstrb_o
+    ,output          axi_dma_wlast_o
+    ,output          axi_dma_bready_o
+    ,output          axi_dma_arvalid_o
+    ,output [ 31:0]  axi_dma_araddr_o
+    ,output [  3:0]  axi_dma_arid_o
+    ,output [  7:0]  axi_dma_arlen_o
+    ,output [  1:0]  axi_dma_arburst_o
+    ,output          axi_dma_rready_o
 );
 
 wire  [ 31:0]  ifetch_pc_w;
@@ -161,6 +212,45 @@ wire  [  3:0]  dport_axi_wr_w;
 wire           dport_axi_flush_w;
 wire           dport_tcm_error_w;
 wire           dport_accept_w;
+wire  [ 31:0]  periph_addr_w;
+wire  [ 31:0]  periph_data_wr_w;
+wire           periph_rd_w;
+wire  [  3:0]  periph_wr_w;
+wire           periph_cacheable_w;
+wire  [ 10:0]  periph_req_tag_w;
+wire           periph_invalidate_w;
+wire           periph_writeback_w;
+wire           periph_flush_w;
+wire  [ 31:0]  periph_data_rd_w;
+wire           periph_accept_w;
+wire           periph_ack_w;
+wire           periph_error_w;
+wire  [ 10:0]  periph_resp_tag_w;
+wire           dma_tcm_rd_w;
+wire  [  3:0]  dma_tcm_wr_w;
+wire  [ 31:0]  dma_tcm_addr_w;
+wire  [ 31:0]  dma_tcm_data_wr_w;
+wire           dma_tcm_accept_w;
+wire           dma_tcm_ack_w;
+wire  [ 31:0]  dma_tcm_data_rd_w;
+wire           dma_irq_w;
+wire           dma_busy_w;
+wire  [ 31:0]  mmio_addr_w;
+wire  [ 31:0]  mmio_data_wr_w;
+wire           mmio_rd_w;
+wire  [  3:0]  mmio_wr_w;
+wire           mmio_cacheable_w;
+wire  [ 10:0]  mmio_req_tag_w;
+wire           mmio_invalidate_w;
+wire           mmio_writeback_w;
+wire           mmio_flush_w;
+wire  [ 31:0]  mmio_data_rd_w;
+wire           mmio_accept_w;
+wire           mmio_ack_w;
+wire           mmio_error_w;
+wire  [ 10:0]  mmio_resp_tag_w;
+wire           clint_irq_w;
+wire  [ 31:0]  intr_w = intr_i | ({31'b0, dma_irq_w} << DMA_IRQ_LINE);
 
 
 riscv_core
@@ -185,6 +275,21 @@ riscv_core
     ,.BHT_ENABLE(BHT_ENABLE)
     ,.NUM_RAS_ENTRIES(NUM_RAS_ENTRIES)
     ,.NUM_RAS_ENTRIES_W(NUM_RAS_ENTRIES_W)
+    ,.DIV_BITS_PER_CYCLE(DIV_BITS_PER_CYCLE)
+    ,.DIV_EARLY_OUT(DIV_EARLY_OUT)
+    ,.SUPPORT_RVC(SUPPORT_RVC)
+    ,.SUPPORT_BITMANIP(SUPPORT_BITMANIP)
+    ,.SUPPORT_FUSION(SUPPORT_FUSION)
+    ,.SUPPORT_NONBLOCKING_LOAD(SUPPORT_NONBLOCKING_LOAD)
+    ,.SUPPORT_DUAL_LSU(SUPPORT_DUAL_LSU)
+    ,.SUPPORT_STORE_FWD(SUPPORT_STORE_FWD)
+    ,.SUPPORT_CLIC(SUPPORT_CLIC)
+    ,.ITLB_ENTRIES(ITLB_ENTRIES)
+    ,.ITLB_ENTRIES_W(ITLB_ENTRIES_W)
+    ,.DTLB_ENTRIES(DTLB_ENTRIES)
+    ,.DTLB_ENTRIES_W(DTLB_ENTRIES_W)
+    ,.PTW_CACHE_ENTRIES(PTW_CACHE_ENTRIES)
+    ,.PTW_CACHE_ENTRIES_W(PTW_CACHE_ENTRIES_W)
 )
 u_core
 (
@@ -196,11 +301,17 @@ u_core
     ,.mem_d_ack_i(dport_ack_w)
     ,.mem_d_error_i(dport_error_w)
     ,.mem_d_resp_tag_i(dport_resp_tag_w)
+    ,.mem_d_store_error_i(1'b0)
+    ,.mem_d_store_error_addr_i(32'b0)
+    ,.mem_d_store_empty_i(1'b1)
+    ,.mem_d_fill_error_i(1'b0)
+    ,.mem_d_fill_error_addr_i(32'b0)
     ,.mem_i_accept_i(ifetch_accept_w)
     ,.mem_i_valid_i(ifetch_valid_w)
     ,.mem_i_error_i(ifetch_error_w)
     ,.mem_i_inst_i(ifetch_inst_w)
-    ,.intr_i(|intr_i)
+    ,.intr_i(intr_w)
+    ,.timer_intr_i(clint_irq_w)
     ,.reset_vector_i(boot_vector_w)
     ,.cpu_id_i(cpu_id_w)
 
@@ -214,6 +325,7 @@ u_core
     ,.mem_d_invalidate_o(dport_invalidate_w)
     ,.mem_d_writeback_o(dport_writeback_w)
     ,.mem_d_flush_o(dport_flush_w)
+    ,.mem_d_pc_o()
     ,.mem_i_rd_o(ifetch_rd_w)
     ,.mem_i_flush_o(ifetch_flush_w)
     ,.mem_i_invalidate_o(ifetch_invalidate_w)
@@ -224,6 +336,7 @@ u_core
 dport_mux
 #(
      .TCM_MEM_BASE(TCM_MEM_BASE)
+    ,.TCM_MEM_SIZE(TCM_MEM_SIZE)
 )
 u_dmux
 (
@@ -278,6 +391,12 @@ u_dmux
 
 
 tcm_mem
+#(
+     .TCM_MEM_SIZE(TCM_MEM_SIZE)
+    ,.TCM_MEM_SIZE_W(TCM_MEM_SIZE_W)
+    ,.TCM_NUM_BANKS(TCM_NUM_BANKS)
+    ,.TCM_NUM_BANKS_W(TCM_NUM_BANKS_W)
+)
 u_tcm
 (
     // Inputs
@@ -312,6 +431,10 @@ u_tcm
     ,.axi_arlen_i(axi_t_arlen_i)
     ,.axi_arburst_i(axi_t_arburst_i)
     ,.axi_rready_i(axi_t_rready_i)
+    ,.dma_rd_i(dma_tcm_rd_w)
+    ,.dma_wr_i(dma_tcm_wr_w)
+    ,.dma_addr_i(dma_tcm_addr_w)
+    ,.dma_data_wr_i(dma_tcm_data_wr_w)
 
     // Outputs
     ,.mem_i_accept_o(ifetch_accept_w)
@@ -334,8 +457,336 @@ u_tcm
     ,.axi_rresp_o(axi_t_rresp_o)
     ,.axi_rid_o(axi_t_rid_o)
     ,.axi_rlast_o(axi_t_rlast_o)
+    ,.dma_accept_o(dma_tcm_accept_w)
+    ,.dma_ack_o(dma_tcm_ack_w)
+    ,.dma_data_rd_o(dma_tcm_data_rd_w)
 );
 
+//-----------------------------------------------------------------
+// CLINT: 64-bit mtime / mtimecmp decoded from the peripheral leg
+// at CLINT_BASE, timer interrupt routed to mip.MTIP.
+//-----------------------------------------------------------------
+generate
+if (SUPPORT_CLINT)
+begin: CLINT
+    wire  [ 31:0]  cfg_addr_w;
+    wire  [ 31:0]  cfg_data_wr_w;
+    wire           cfg_rd_w;
+    wire  [  3:0]  cfg_wr_w;
+    wire           cfg_cacheable_w;
+    wire  [ 10:0]  cfg_req_tag_w;
+    wire           cfg_invalidate_w;
+    wire           cfg_writeback_w;
+    wire           cfg_flush_w;
+    wire  [ 31:0]  cfg_data_rd_w;
+    wire           cfg_accept_w;
+    wire           cfg_ack_w;
+    wire           cfg_error_w;
+    wire  [ 10:0]  cfg_resp_tag_w;
+
+    dport_mux
+    #(
+         .TCM_MEM_BASE(CLINT_BASE)
+        ,.TCM_MEM_SIZE(65536)
+    )
+    u_cmux
+    (
+        // Inputs
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.mem_addr_i(dport_axi_addr_w)
+        ,.mem_data_wr_i(dport_axi_data_wr_w)
+        ,.mem_rd_i(dport_axi_rd_w)
+        ,.mem_wr_i(dport_axi_wr_w)
+        ,.mem_cacheable_i(dport_axi_cacheable_w)
+        ,.mem_req_tag_i(dport_axi_req_tag_w)
+        ,.mem_invalidate_i(dport_axi_invalidate_w)
+        ,.mem_writeback_i(dport_axi_writeback_w)
+        ,.mem_flush_i(dport_axi_flush_w)
+        ,.mem_tcm_data_rd_i(cfg_data_rd_w)
+        ,.mem_tcm_accept_i(cfg_accept_w)
+        ,.mem_tcm_ack_i(cfg_ack_w)
+        ,.mem_tcm_error_i(cfg_error_w)
+        ,.mem_tcm_resp_tag_i(cfg_resp_tag_w)
+        ,.mem_ext_data_rd_i(mmio_data_rd_w)
+        ,.mem_ext_accept_i(mmio_accept_w)
+        ,.mem_ext_ack_i(mmio_ack_w)
+        ,.mem_ext_error_i(mmio_error_w)
+        ,.mem_ext_resp_tag_i(mmio_resp_tag_w)
+
+        // Outputs
+        ,.mem_data_rd_o(dport_axi_data_rd_w)
+        ,.mem_accept_o(dport_axi_accept_w)
+        ,.mem_ack_o(dport_axi_ack_w)
+        ,.mem_error_o(dport_axi_error_w)
+        ,.mem_resp_tag_o(dport_axi_resp_tag_w)
+        ,.mem_tcm_addr_o(cfg_addr_w)
+        ,.mem_tcm_data_wr_o(cfg_data_wr_w)
+        ,.mem_tcm_rd_o(cfg_rd_w)
+        ,.mem_tcm_wr_o(cfg_wr_w)
+        ,.mem_tcm_cacheable_o(cfg_cacheable_w)
+        ,.mem_tcm_req_tag_o(cfg_req_tag_w)
+        ,.mem_tcm_invalidate_o(cfg_invalidate_w)
+        ,.mem_tcm_writeback_o(cfg_writeback_w)
+        ,.mem_tcm_flush_o(cfg_flush_w)
+        ,.mem_ext_addr_o(mmio_addr_w)
+        ,.mem_ext_data_wr_o(mmio_data_wr_w)
+        ,.mem_ext_rd_o(mmio_rd_w)
+        ,.mem_ext_wr_o(mmio_wr_w)
+        ,.mem_ext_cacheable_o(mmio_cacheable_w)
+        ,.mem_ext_req_tag_o(mmio_req_tag_w)
+        ,.mem_ext_invalidate_o(mmio_invalidate_w)
+        ,.mem_ext_writeback_o(mmio_writeback_w)
+        ,.mem_ext_flush_o(mmio_flush_w)
+    );
+
+    tcm_clint
+    u_clint
+    (
+        // Inputs
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.cfg_addr_i(cfg_addr_w)
+        ,.cfg_data_wr_i(cfg_data_wr_w)
+        ,.cfg_rd_i(cfg_rd_w)
+        ,.cfg_wr_i(cfg_wr_w)
+        ,.cfg_cacheable_i(cfg_cacheable_w)
+        ,.cfg_req_tag_i(cfg_req_tag_w)
+        ,.cfg_invalidate_i(cfg_invalidate_w)
+        ,.cfg_writeback_i(cfg_writeback_w)
+        ,.cfg_flush_i(cfg_flush_w)
+
+        // Outputs
+        ,.cfg_data_rd_o(cfg_data_rd_w)
+        ,.cfg_accept_o(cfg_accept_w)
+        ,.cfg_ack_o(cfg_ack_w)
+        ,.cfg_error_o(cfg_error_w)
+        ,.cfg_resp_tag_o(cfg_resp_tag_w)
+        ,.timer_irq_o(clint_irq_w)
+    );
+end
+else
+begin: NO_CLINT
+    assign mmio_addr_w          = dport_axi_addr_w;
+    assign mmio_data_wr_w       = dport_axi_data_wr_w;
+    assign mmio_rd_w            = dport_axi_rd_w;
+    assign mmio_wr_w            = dport_axi_wr_w;
+    assign mmio_cacheable_w     = dport_axi_cacheable_w;
+    assign mmio_req_tag_w       = dport_axi_req_tag_w;
+    assign mmio_invalidate_w    = dport_axi_invalidate_w;
+    assign mmio_writeback_w     = dport_axi_writeback_w;
+    assign mmio_flush_w         = dport_axi_flush_w;
+    assign dport_axi_data_rd_w  = mmio_data_rd_w;
+    assign dport_axi_accept_w   = mmio_accept_w;
+    assign dport_axi_ack_w      = mmio_ack_w;
+    assign dport_axi_error_w    = mmio_error_w;
+    assign dport_axi_resp_tag_w = mmio_resp_tag_w;
+
+    assign clint_irq_w          = 1'b0;
+end
+endgenerate
+
+//-----------------------------------------------------------------
+// DMA engine: registers decoded from the peripheral (AXI4-Lite)
+// leg at DMA_BASE, data moved via TCM port / AXI4 master.
+//-----------------------------------------------------------------
+generate
+if (SUPPORT_DMA)
+begin: DMA
+    wire  [ 31:0]  cfg_addr_w;
+    wire  [ 31:0]  cfg_data_wr_w;
+    wire           cfg_rd_w;
+    wire  [  3:0]  cfg_wr_w;
+    wire           cfg_cacheable_w;
+    wire  [ 10:0]  cfg_req_tag_w;
+    wire           cfg_invalidate_w;
+    wire           cfg_writeback_w;
+    wire           cfg_flush_w;
+    wire  [ 31:0]  cfg_data_rd_w;
+    wire           cfg_accept_w;
+    wire           cfg_ack_w;
+    wire           cfg_error_w;
+    wire  [ 10:0]  cfg_resp_tag_w;
+
+    dport_mux
+    #(
+         .TCM_MEM_BASE(DMA_BASE)
+        ,.TCM_MEM_SIZE(256)
+    )
+    u_pmux
+    (
+        // Inputs
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.mem_addr_i(mmio_addr_w)
+        ,.mem_data_wr_i(mmio_data_wr_w)
+        ,.mem_rd_i(mmio_rd_w)
+        ,.mem_wr_i(mmio_wr_w)
+        ,.mem_cacheable_i(mmio_cacheable_w)
+        ,.mem_req_tag_i(mmio_req_tag_w)
+        ,.mem_invalidate_i(mmio_invalidate_w)
+        ,.mem_writeback_i(mmio_writeback_w)
+        ,.mem_flush_i(mmio_flush_w)
+        ,.mem_tcm_data_rd_i(cfg_data_rd_w)
+        ,.mem_tcm_accept_i(cfg_accept_w)
+        ,.mem_tcm_ack_i(cfg_ack_w)
+        ,.mem_tcm_error_i(cfg_error_w)
+        ,.mem_tcm_resp_tag_i(cfg_resp_tag_w)
+        ,.mem_ext_data_rd_i(periph_data_rd_w)
+        ,.mem_ext_accept_i(periph_accept_w)
+        ,.mem_ext_ack_i(periph_ack_w)
+        ,.mem_ext_error_i(periph_error_w)
+        ,.mem_ext_resp_tag_i(periph_resp_tag_w)
+
+        // Outputs
+        ,.mem_data_rd_o(mmio_data_rd_w)
+        ,.mem_accept_o(mmio_accept_w)
+        ,.mem_ack_o(mmio_ack_w)
+        ,.mem_error_o(mmio_error_w)
+        ,.mem_resp_tag_o(mmio_resp_tag_w)
+        ,.mem_tcm_addr_o(cfg_addr_w)
+        ,.mem_tcm_data_wr_o(cfg_data_wr_w)
+        ,.mem_tcm_rd_o(cfg_rd_w)
+        ,.mem_tcm_wr_o(cfg_wr_w)
+        ,.mem_tcm_cacheable_o(cfg_cacheable_w)
+        ,.mem_tcm_req_tag_o(cfg_req_tag_w)
+        ,.mem_tcm_invalidate_o(cfg_invalidate_w)
+        ,.mem_tcm_writeback_o(cfg_writeback_w)
+        ,.mem_tcm_flush_o(cfg_flush_w)
+        ,.mem_ext_addr_o(periph_addr_w)
+        ,.mem_ext_data_wr_o(periph_data_wr_w)
+        ,.mem_ext_rd_o(periph_rd_w)
+        ,.mem_ext_wr_o(periph_wr_w)
+        ,.mem_ext_cacheable_o(periph_cacheable_w)
+        ,.mem_ext_req_tag_o(periph_req_tag_w)
+        ,.mem_ext_invalidate_o(periph_invalidate_w)
+        ,.mem_ext_writeback_o(periph_writeback_w)
+        ,.mem_ext_flush_o(periph_flush_w)
+    );
+
+    tcm_dma
+    #(
+         .TCM_MEM_BASE(TCM_MEM_BASE)
+        ,.TCM_MEM_SIZE(TCM_MEM_SIZE)
+    )
+    u_dma
+    (
+        // Inputs
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.cfg_addr_i(cfg_addr_w)
+        ,.cfg_data_wr_i(cfg_data_wr_w)
+        ,.cfg_rd_i(cfg_rd_w)
+        ,.cfg_wr_i(cfg_wr_w)
+        ,.cfg_cacheable_i(cfg_cacheable_w)
+        ,.cfg_req_tag_i(cfg_req_tag_w)
+        ,.cfg_invalidate_i(cfg_invalidate_w)
+        ,.cfg_writeback_i(cfg_writeback_w)
+        ,.cfg_flush_i(cfg_flush_w)
+        ,.tcm_accept_i(dma_tcm_accept_w)
+        ,.tcm_ack_i(dma_tcm_ack_w)
+        ,.tcm_data_rd_i(dma_tcm_data_rd_w)
+        ,.axi_awready_i(axi_dma_awready_i)
+        ,.axi_wready_i(axi_dma_wready_i)
+        ,.axi_bvalid_i(axi_dma_bvalid_i)
+        ,.axi_bresp_i(axi_dma_bresp_i)
+        ,.axi_bid_i(axi_dma_bid_i)
+        ,.axi_arready_i(axi_dma_arready_i)
+        ,.axi_rvalid_i(axi_dma_rvalid_i)
+        ,.axi_rdata_i(axi_dma_rdata_i)
+        ,.axi_rresp_i(axi_dma_rresp_i)
+        ,.axi_rid_i(axi_dma_rid_i)
+        ,.axi_rlast_i(axi_dma_rlast_i)
+
+        // Outputs
+        ,.cfg_data_rd_o(cfg_data_rd_w)
+        ,.cfg_accept_o(cfg_accept_w)
+        ,.cfg_ack_o(cfg_ack_w)
+        ,.cfg_error_o(cfg_error_w)
+        ,.cfg_resp_tag_o(cfg_resp_tag_w)
+        ,.tcm_rd_o(dma_tcm_rd_w)
+        ,.tcm_wr_o(dma_tcm_wr_w)
+        ,.tcm_addr_o(dma_tcm_addr_w)
+        ,.tcm_data_wr_o(dma_tcm_data_wr_w)
+        ,.axi_awvalid_o(axi_dma_awvalid_o)
+        ,.axi_awaddr_o(axi_dma_awaddr_o)
+        ,.axi_awid_o(axi_dma_awid_o)
+        ,.axi_awlen_o(axi_dma_awlen_o)
+        ,.axi_awburst_o(axi_dma_awburst_o)
+        ,.axi_wvalid_o(axi_dma_wvalid_o)
+        ,.axi_wdata_o(axi_dma_wdata_o)
+        ,.axi_wstrb_o(axi_dma_wstrb_o)
+        ,.axi_wlast_o(axi_dma_wlast_o)
+        ,.axi_bready_o(axi_dma_bready_o)
+        ,.axi_arvalid_o(axi_dma_arvalid_o)
+        ,.axi_araddr_o(axi_dma_araddr_o)
+        ,.axi_arid_o(axi_dma_arid_o)
+        ,.axi_arlen_o(axi_dma_arlen_o)
+        ,.axi_arburst_o(axi_dma_arburst_o)
+        ,.axi_rready_o(axi_dma_rready_o)
+        ,.irq_o(dma_irq_w)
+        ,.busy_o(dma_busy_w)
+    );
+end
+else
+begin: NO_DMA
+    assign periph_addr_w        = mmio_addr_w;
+    assign periph_data_wr_w     = mmio_data_wr_w;
+    assign periph_rd_w          = mmio_rd_w;
+    assign periph_wr_w          = mmio_wr_w;
+    assign periph_cacheable_w   = mmio_cacheable_w;
+    assign periph_req_tag_w     = mmio_req_tag_w;
+    assign periph_invalidate_w  = mmio_invalidate_w;
+    assign periph_writeback_w   = mmio_writeback_w;
+    assign periph_flush_w       = mmio_flush_w;
+    assign mmio_data_rd_w       = periph_data_rd_w;
+    assign mmio_accept_w        = periph_accept_w;
+    assign mmio_ack_w           = periph_ack_w;
+    assign mmio_error_w         = periph_error_w;
+    assign mmio_resp_tag_w      = periph_resp_tag_w;
+
+    assign dma_tcm_rd_w         = 1'b0;
+    assign dma_tcm_wr_w         = 4'b0;
+    assign dma_tcm_addr_w       = 32'b0;
+    assign dma_tcm_data_wr_w    = 32'b0;
+    assign dma_irq_w            = 1'b0;
+    assign dma_busy_w           = 1'b0;
+
+    assign axi_dma_awvalid_o    = 1'b0;
+    assign axi_dma_awaddr_o     = 32'b0;
+    assign axi_dma_awid_o       = 4'b0;
+    assign axi_dma_awlen_o      = 8'b0;
+    assign axi_dma_awburst_o    = 2'b0;
+    assign axi_dma_wvalid_o     = 1'b0;
+    assign axi_dma_wdata_o      = 32'b0;
+    assign axi_dma_wstrb_o      = 4'b0;
+    assign axi_dma_wlast_o      = 1'b0;
+    assign axi_dma_bready_o     = 1'b0;
+    assign axi_dma_arvalid_o    = 1'b0;
+    assign axi_dma_araddr_o     = 32'b0;
+    assign axi_dma_arid_o       = 4'b0;
+    assign axi_dma_arlen_o      = 8'b0;
+    assign axi_dma_arburst_o    = 2'b0;
+    assign axi_dma_rready_o     = 1'b0;
+end
+endgenerate
+
+//-----------------------------------------------------------------
+// Testbench access
+//-----------------------------------------------------------------
+`ifdef verilator
+function [0:0] get_dma_busy; /*verilator public*/
+begin
+    get_dma_busy = dma_busy_w;
+end
+endfunction
+function [0:0] get_clint; /*verilator public*/
+begin
+    get_clint = (SUPPORT_CLINT != 0);
+end
+endfunction
+`endif
+
 
 dport_axi
 u_axi
@@ -343,15 +794,15 @@ u_axi
     // Inputs
      .clk_i(clk_i)
     ,.rst_i(rst_i)
-    ,.mem_addr_i(dport_axi_addr_w)
-    ,.mem_data_wr_i(dport_axi_data_wr_w)
-    ,.mem_rd_i(dport_axi_rd_w)
-    ,.mem_wr_i(dport_axi_wr_w)
-    ,.mem_cacheable_i(dport_axi_cacheable_w)
-    ,.mem_req_tag_i(dport_axi_req_tag_w)
-    ,.mem_invalidate_i(dport_axi_invalidate_w)
-    ,.mem_writeback_i(dport_axi_writeback_w)
-    ,.mem_flush_i(dport_axi_flush_w)
+    ,.mem_addr_i(periph_addr_w)
+    ,.mem_data_wr_i(periph_data_wr_w)
+    ,.mem_rd_i(periph_rd_w)
+    ,.mem_wr_i(periph_wr_w)
+    ,.mem_cacheable_i(periph_cacheable_w)
+    ,.mem_req_tag_i(periph_req_tag_w)
+    ,.mem_invalidate_i(periph_invalidate_w)
+    ,.mem_writeback_i(periph_writeback_w)
+    ,.mem_flush_i(periph_flush_w)
     ,.axi_awready_i(axi_i_awready_i)
     ,.axi_wready_i(axi_i_wready_i)
     ,.axi_bvalid_i(axi_i_bvalid_i)
@@ -362,11 +813,11 @@ u_axi
     ,.axi_rresp_i(axi_i_rresp_i)
 
     // Outputs
-    ,.mem_data_rd_o(dport_axi_data_rd_w)
-    ,.mem_accept_o(dport_axi_accept_w)
-    ,.mem_ack_o(dport_axi_ack_w)
-    ,.mem_error_o(dport_axi_error_w)
-    ,.mem_resp_tag_o(dport_axi_resp_tag_w)
+    ,.mem_data_rd_o(periph_data_rd_w)
+    ,.mem_accept_o(periph_accept_w)
+    ,.mem_ack_o(periph_ack_w)
+    ,.mem_error_o(periph_error_w)
+    ,.mem_resp_tag_o(periph_resp_tag_w)
     ,.axi_awvalid_o(axi_i_awvalid_o)
     ,.axi_awaddr_o(axi_i_awaddr_o)
     ,.axi_wvalid_o(axi_i_wvalid_o)
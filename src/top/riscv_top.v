@@ -51,6 +51,54 @@ module riscv_top
     ,parameter BHT_ENABLE       = 1
     ,parameter NUM_RAS_ENTRIES  = 8
     ,parameter NUM_RAS_ENTRIES_W = 3
+    ,parameter DIV_BITS_PER_CYCLE = 1
+    ,parameter DIV_EARLY_OUT    = 0
+    ,parameter SUPPORT_RVC      = 0
+    ,parameter SUPPORT_BITMANIP = 0
+    ,parameter SUPPORT_FUSION   = 0
+    ,parameter SUPPORT_NONBLOCKING_LOAD = 0
+    ,parameter SUPPORT_DUAL_LSU = 0
+    ,parameter SUPPORT_STORE_FWD = 0
+    ,parameter SUPPORT_CLIC     = 0
+    ,parameter ITLB_ENTRIES     = 8
+    ,parameter ITLB_ENTRIES_W   = 3
+    ,parameter DTLB_ENTRIES     = 8
+    ,parameter DTLB_ENTRIES_W   = 3
+    ,parameter PTW_CACHE_ENTRIES   = 4
+    ,parameter PTW_CACHE_ENTRIES_W = 2
+    ,parameter ICACHE_NUM_WAYS  = 2
+    ,parameter ICACHE_NUM_WAYS_W = 1
+    ,parameter ICACHE_NUM_LINES = 256
+    ,parameter ICACHE_NUM_LINES_W = 8
+    ,parameter ICACHE_LINE_SIZE = 32
+    ,parameter ICACHE_LINE_SIZE_W = 5
+    ,parameter ICACHE_PLRU_ENABLE = 0
+    ,parameter DCACHE_NUM_WAYS  = 2
+    ,parameter DCACHE_NUM_WAYS_W = 1
+    ,parameter DCACHE_NUM_LINES = 256
+    ,parameter DCACHE_NUM_LINES_W = 8
+    ,parameter DCACHE_LINE_SIZE = 32
+    ,parameter DCACHE_LINE_SIZE_W = 5
+    ,parameter DCACHE_PLRU_ENABLE = 0
+    ,parameter DCACHE_NON_BLOCKING = 0
+    ,parameter DCACHE_NUM_MSHR  = 2
+    ,parameter DCACHE_NUM_MSHR_W = 1
+    ,parameter DCACHE_STORE_BUF = 0
+    ,parameter DCACHE_STORE_BUF_ENTRIES = 4
+    ,parameter DCACHE_STORE_BUF_ENTRIES_W = 2
+    ,parameter DCACHE_PREFETCH  = 0
+    ,parameter DCACHE_PREFETCH_ENTRIES = 8
+    ,parameter DCACHE_PREFETCH_ENTRIES_W = 3
+    ,parameter AXI_DATA_W       = 32
+    ,parameter L2_ENABLE        = 0
+    ,parameter L2_NUM_WAYS      = 4
+    ,parameter L2_NUM_WAYS_W    = 2
+    ,parameter L2_NUM_LINES     = 512
+    ,parameter L2_NUM_LINES_W   = 9
+    ,parameter L2_LINE_SIZE     = 32
+    ,parameter L2_LINE_SIZE_W   = 5
+    ,parameter L2_NUM_BANKS     = 2
+    ,parameter L2_NUM_BANKS_W   = 1
 )
 //-----------------------------------------------------------------
 // Ports
@@ -66,7 +114,7 @@ module riscv_top
     ,input  [  3:0]  axi_i_bid_i
     ,input           axi_i_arready_i
     ,input           axi_i_rvalid_i
-    ,input  [ 31:0]  axi_i_rdata_i
+    ,input  [AXI_DATA_W-1:0] axi_i_rdata_i
     ,input  [  1:0]  axi_i_rresp_i
     ,input  [  3:0]  axi_i_rid_i
     ,input           axi_i_rlast_i
@@ -77,7 +125,7 @@ module riscv_top
     ,input  [  3:0]  axi_d_bid_i
     ,input           axi_d_arready_i
     ,input           axi_d_rvalid_i
-    ,input  [ 31:0]  axi_d_rdata_i
+    ,input  [AXI_DATA_W-1:0] axi_d_rdata_i
     ,input  [  1:0]  axi_d_rresp_i
     ,input  [  3:0]  axi_d_rid_i
     ,input           axi_d_rlast_i
@@ -91,8 +139,8 @@ module riscv_top
     ,output [  7:0]  axi_i_awlen_o
     ,output [  1:0]  axi_i_awburst_o
     ,output          axi_i_wvalid_o
-    ,output [ 31:0]  axi_i_wdata_o
-    ,output [  3:0]  axi_i_wstrb_o
+    ,output [AXI_DATA_W-1:0] axi_i_wdata_o
+    ,output [(AXI_DATA_W/8)-1:0] axi_i_wstrb_o
     ,output          axi_i_wlast_o
     ,output          axi_i_bready_o
     ,output          axi_i_arvalid_o
@@ -107,8 +155,8 @@ module riscv_top
     ,output [  7:0]  axi_d_awlen_o
     ,output [  1:0]  axi_d_awburst_o
     ,output          axi_d_wvalid_o
-    ,output [ 31:0]  axi_d_wdata_o
-    ,output [  3:0]  axi_d_wstrb_o
+    ,output [AXI_DATA_W-1:0] axi_d_wdata_o
+    ,output [(AXI_DATA_W/8)-1:0] axi_d_wstrb_o
     ,output          axi_d_wlast_o
     ,output          axi_d_bready_o
     ,output          axi_d_arvalid_o
@@ -125,6 +173,11 @@ wire           dcache_flush_w;
 wire           dcache_invalidate_w;
 wire           dcache_ack_w;
 wire  [ 10:0]  dcache_resp_tag_w;
+wire           dcache_store_error_w;
+wire  [ 31:0]  dcache_store_error_addr_w;
+wire           dcache_store_empty_w;
+wire           dcache_fill_error_w;
+wire  [ 31:0]  dcache_fill_error_addr_w;
 wire  [ 63:0]  icache_inst_w;
 wire  [ 31:0]  cpu_id_w = CORE_ID;
 wire           dcache_rd_w;
@@ -142,10 +195,84 @@ wire  [ 31:0]  icache_pc_w;
 wire           icache_rd_w;
 wire           dcache_error_w;
 wire  [ 31:0]  dcache_data_wr_w;
+wire  [ 31:0]  dcache_pc_w;
+wire           icache_axi_awvalid_w;
+wire  [ 31:0]  icache_axi_awaddr_w;
+wire  [  3:0]  icache_axi_awid_w;
+wire  [  7:0]  icache_axi_awlen_w;
+wire  [  1:0]  icache_axi_awburst_w;
+wire           icache_axi_wvalid_w;
+wire  [AXI_DATA_W-1:0] icache_axi_wdata_w;
+wire  [(AXI_DATA_W/8)-1:0] icache_axi_wstrb_w;
+wire           icache_axi_wlast_w;
+wire           icache_axi_bready_w;
+wire           icache_axi_arvalid_w;
+wire  [ 31:0]  icache_axi_araddr_w;
+wire  [  3:0]  icache_axi_arid_w;
+wire  [  7:0]  icache_axi_arlen_w;
+wire  [  1:0]  icache_axi_arburst_w;
+wire           icache_axi_rready_w;
+wire           icache_axi_awready_w;
+wire           icache_axi_wready_w;
+wire           icache_axi_bvalid_w;
+wire  [  1:0]  icache_axi_bresp_w;
+wire  [  3:0]  icache_axi_bid_w;
+wire           icache_axi_arready_w;
+wire           icache_axi_rvalid_w;
+wire  [AXI_DATA_W-1:0] icache_axi_rdata_w;
+wire  [  1:0]  icache_axi_rresp_w;
+wire  [  3:0]  icache_axi_rid_w;
+wire           icache_axi_rlast_w;
+wire           dcache_axi_awvalid_w;
+wire  [ 31:0]  dcache_axi_awaddr_w;
+wire  [  3:0]  dcache_axi_awid_w;
+wire  [  7:0]  dcache_axi_awlen_w;
+wire  [  1:0]  dcache_axi_awburst_w;
+wire           dcache_axi_wvalid_w;
+wire  [AXI_DATA_W-1:0] dcache_axi_wdata_w;
+wire  [(AXI_DATA_W/8)-1:0] dcache_axi_wstrb_w;
+wire           dcache_axi_wlast_w;
+wire           dcache_axi_bready_w;
+wire           dcache_axi_arvalid_w;
+wire  [ 31:0]  dcache_axi_araddr_w;
+wire  [  3:0]  dcache_axi_arid_w;
+wire  [  7:0]  dcache_axi_arlen_w;
+wire  [  1:0]  dcache_axi_arburst_w;
+wire           dcache_axi_rready_w;
+wire           dcache_axi_awready_w;
+wire           dcache_axi_wready_w;
+wire           dcache_axi_bvalid_w;
+wire  [  1:0]  dcache_axi_bresp_w;
+wire  [  3:0]  dcache_axi_bid_w;
+wire           dcache_axi_arready_w;
+wire           dcache_axi_rvalid_w;
+wire  [AXI_DATA_W-1:0] dcache_axi_rdata_w;
+wire  [  1:0]  dcache_axi_rresp_w;
+wire  [  3:0]  dcache_axi_rid_w;
+wire           dcache_axi_rlast_w;
 
 
 dcache
-#(.AXI_ID(DCACHE_AXI_ID))
+#(
+     .AXI_ID(DCACHE_AXI_ID)
+    ,.DCACHE_NUM_WAYS(DCACHE_NUM_WAYS)
+    ,.DCACHE_NUM_WAYS_W(DCACHE_NUM_WAYS_W)
+    ,.DCACHE_NUM_LINES(DCACHE_NUM_LINES)
+    ,.DCACHE_NUM_LINES_W(DCACHE_NUM_LINES_W)
+    ,.DCACHE_LINE_SIZE(DCACHE_LINE_SIZE)
+    ,.DCACHE_LINE_SIZE_W(DCACHE_LINE_SIZE_W)
+    ,.DCACHE_PLRU_ENABLE(DCACHE_PLRU_ENABLE)
+    ,.DCACHE_NON_BLOCKING(DCACHE_NON_BLOCKING)
+    ,.DCACHE_NUM_MSHR(DCACHE_NUM_MSHR)
+    ,.DCACHE_NUM_MSHR_W(DCACHE_NUM_MSHR_W)
+    ,.DCACHE_STORE_BUF(DCACHE_STORE_BUF)
+    ,.DCACHE_STORE_BUF_ENTRIES(DCACHE_STORE_BUF_ENTRIES)
+    ,.DCACHE_STORE_BUF_ENTRIES_W(DCACHE_STORE_BUF_ENTRIES_W)
+    ,.DCACHE_PREFETCH(DCACHE_PREFETCH)
+    ,.DCACHE_PREFETCH_ENTRIES(DCACHE_PREFETCH_ENTRIES)
+    ,.DCACHE_PREFETCH_ENTRIES_W(DCACHE_PREFETCH_ENTRIES_W)
+    ,.AXI_DATA_W(AXI_DATA_W)
+)
 u_dcache
 (
     // Inputs
@@ -160,17 +287,18 @@ u_dcache
     ,.mem_invalidate_i(dcache_invalidate_w)
     ,.mem_writeback_i(dcache_writeback_w)
     ,.mem_flush_i(dcache_flush_w)
-    ,.axi_awready_i(axi_d_awready_i)
-    ,.axi_wready_i(axi_d_wready_i)
-    ,.axi_bvalid_i(axi_d_bvalid_i)
-    ,.axi_bresp_i(axi_d_bresp_i)
-    ,.axi_bid_i(axi_d_bid_i)
-    ,.axi_arready_i(axi_d_arready_i)
-    ,.axi_rvalid_i(axi_d_rvalid_i)
-    ,.axi_rdata_i(axi_d_rdata_i)
-    ,.axi_rresp_i(axi_d_rresp_i)
-    ,.axi_rid_i(axi_d_rid_i)
-    ,.axi_rlast_i(axi_d_rlast_i)
+    ,.mem_pc_i(dcache_pc_w)
+    ,.axi_awready_i(dcache_axi_awready_w)
+    ,.axi_wready_i(dcache_axi_wready_w)
+    ,.axi_bvalid_i(dcache_axi_bvalid_w)
+    ,.axi_bresp_i(dcache_axi_bresp_w)
+    ,.axi_bid_i(dcache_axi_bid_w)
+    ,.axi_arready_i(dcache_axi_arready_w)
+    ,.axi_rvalid_i(dcache_axi_rvalid_w)
+    ,.axi_rdata_i(dcache_axi_rdata_w)
+    ,.axi_rresp_i(dcache_axi_rresp_w)
+    ,.axi_rid_i(dcache_axi_rid_w)
+    ,.axi_rlast_i(dcache_axi_rlast_w)
 
     // Outputs
     ,.mem_data_rd_o(dcache_data_rd_w)
@@ -178,22 +306,27 @@ u_dcache
     ,.mem_ack_o(dcache_ack_w)
     ,.mem_error_o(dcache_error_w)
     ,.mem_resp_tag_o(dcache_resp_tag_w)
-    ,.axi_awvalid_o(axi_d_awvalid_o)
-    ,.axi_awaddr_o(axi_d_awaddr_o)
-    ,.axi_awid_o(axi_d_awid_o)
-    ,.axi_awlen_o(axi_d_awlen_o)
-    ,.axi_awburst_o(axi_d_awburst_o)
-    ,.axi_wvalid_o(axi_d_wvalid_o)
-    ,.axi_wdata_o(axi_d_wdata_o)
-    ,.axi_wstrb_o(axi_d_wstrb_o)
-    ,.axi_wlast_o(axi_d_wlast_o)
-    ,.axi_bready_o(axi_d_bready_o)
-    ,.axi_arvalid_o(axi_d_arvalid_o)
-    ,.axi_araddr_o(axi_d_araddr_o)
-    ,.axi_arid_o(axi_d_arid_o)
-    ,.axi_arlen_o(axi_d_arlen_o)
-    ,.axi_arburst_o(axi_d_arburst_o)
-    ,.axi_rready_o(axi_d_rready_o)
+    ,.mem_store_error_o(dcache_store_error_w)
+    ,.mem_store_error_addr_o(dcache_store_error_addr_w)
+    ,.mem_store_empty_o(dcache_store_empty_w)
+    ,.mem_fill_error_o(dcache_fill_error_w)
+    ,.mem_fill_error_addr_o(dcache_fill_error_addr_w)
+    ,.axi_awvalid_o(dcache_axi_awvalid_w)
+    ,.axi_awaddr_o(dcache_axi_awaddr_w)
+    ,.axi_awid_o(dcache_axi_awid_w)
+    ,.axi_awlen_o(dcache_axi_awlen_w)
+    ,.axi_awburst_o(dcache_axi_awburst_w)
+    ,.axi_wvalid_o(dcache_axi_wvalid_w)
+    ,.axi_wdata_o(dcache_axi_wdata_w)
+    ,.axi_wstrb_o(dcache_axi_wstrb_w)
+    ,.axi_wlast_o(dcache_axi_wlast_w)
+    ,.axi_bready_o(dcache_axi_bready_w)
+    ,.axi_arvalid_o(dcache_axi_arvalid_w)
+    ,.axi_araddr_o(dcache_axi_araddr_w)
+    ,.axi_arid_o(dcache_axi_arid_w)
+    ,.axi_arlen_o(dcache_axi_arlen_w)
+    ,.axi_arburst_o(dcache_axi_arburst_w)
+    ,.axi_rready_o(dcache_axi_rready_w)
 );
 
 
@@ -219,6 +352,24 @@ riscv_core
     ,.BHT_ENABLE(BHT_ENABLE)
     ,.NUM_RAS_ENTRIES(NUM_RAS_ENTRIES)
     ,.NUM_RAS_ENTRIES_W(NUM_RAS_ENTRIES_W)
+    ,.DIV_BITS_PER_CYCLE(DIV_BITS_PER_CYCLE)
+    ,.DIV_EARLY_OUT(DIV_EARLY_OUT)
+    ,.SUPPORT_RVC(SUPPORT_RVC)
+    ,.SUPPORT_BITMANIP(SUPPORT_BITMANIP)
+    ,.SUPPORT_FUSION(SUPPORT_FUSION)
+    ,.SUPPORT_NONBLOCKING_LOAD(SUPPORT_NONBLOCKING_LOAD)
+    ,.SUPPORT_DUAL_LSU(SUPPORT_DUAL_LSU)
+    ,.SUPPORT_STORE_FWD(SUPPORT_STORE_FWD)
+    ,.SUPPORT_CLIC(SUPPORT_CLIC)
+    ,.CBO_ZERO_ALLOC(1)
+    ,.CBO_BLOCK_SIZE(DCACHE_LINE_SIZE)
+    ,.CBO_BLOCK_SIZE_W(DCACHE_LINE_SIZE_W)
+    ,.ITLB_ENTRIES(ITLB_ENTRIES)
+    ,.ITLB_ENTRIES_W(ITLB_ENTRIES_W)
+    ,.DTLB_ENTRIES(DTLB_ENTRIES)
+    ,.DTLB_ENTRIES_W(DTLB_ENTRIES_W)
+    ,.PTW_CACHE_ENTRIES(PTW_CACHE_ENTRIES)
+    ,.PTW_CACHE_ENTRIES_W(PTW_CACHE_ENTRIES_W)
 )
 u_core
 (
@@ -230,11 +381,17 @@ u_core
     ,.mem_d_ack_i(dcache_ack_w)
     ,.mem_d_error_i(dcache_error_w)
     ,.mem_d_resp_tag_i(dcache_resp_tag_w)
+    ,.mem_d_store_error_i(dcache_store_error_w)
+    ,.mem_d_store_error_addr_i(dcache_store_error_addr_w)
+    ,.mem_d_store_empty_i(dcache_store_empty_w)
+    ,.mem_d_fill_error_i(dcache_fill_error_w)
+    ,.mem_d_fill_error_addr_i(dcache_fill_error_addr_w)
     ,.mem_i_accept_i(icache_accept_w)
     ,.mem_i_valid_i(icache_valid_w)
     ,.mem_i_error_i(icache_error_w)
     ,.mem_i_inst_i(icache_inst_w)
-    ,.intr_i(intr_i)
+    ,.intr_i({31'b0, intr_i})
+    ,.timer_intr_i(1'b0)
     ,.reset_vector_i(reset_vector_i)
     ,.cpu_id_i(cpu_id_w)
 
@@ -248,6 +405,7 @@ u_core
     ,.mem_d_invalidate_o(dcache_invalidate_w)
     ,.mem_d_writeback_o(dcache_writeback_w)
     ,.mem_d_flush_o(dcache_flush_w)
+    ,.mem_d_pc_o(dcache_pc_w)
     ,.mem_i_rd_o(icache_rd_w)
     ,.mem_i_flush_o(icache_flush_w)
     ,.mem_i_invalidate_o(icache_invalidate_w)
@@ -256,7 +414,17 @@ u_core
 
 
 icache
-#(.AXI_ID(ICACHE_AXI_ID))
+#(
+     .AXI_ID(ICACHE_AXI_ID)
+    ,.ICACHE_NUM_WAYS(ICACHE_NUM_WAYS)
+    ,.ICACHE_NUM_WAYS_W(ICACHE_NUM_WAYS_W)
+    ,.ICACHE_NUM_LINES(ICACHE_NUM_LINES)
+    ,.ICACHE_NUM_LINES_W(ICACHE_NUM_LINES_W)
+    ,.ICACHE_LINE_SIZE(ICACHE_LINE_SIZE)
+    ,.ICACHE_LINE_SIZE_W(ICACHE_LINE_SIZE_W)
+    ,.ICACHE_PLRU_ENABLE(ICACHE_PLRU_ENABLE)
+    ,.AXI_DATA_W(AXI_DATA_W)
+)
 u_icache
 (
     // Inputs
@@ -266,41 +434,227 @@ u_icache
     ,.req_flush_i(icache_flush_w)
     ,.req_invalidate_i(icache_invalidate_w)
     ,.req_pc_i(icache_pc_w)
-    ,.axi_awready_i(axi_i_awready_i)
-    ,.axi_wready_i(axi_i_wready_i)
-    ,.axi_bvalid_i(axi_i_bvalid_i)
-    ,.axi_bresp_i(axi_i_bresp_i)
-    ,.axi_bid_i(axi_i_bid_i)
-    ,.axi_arready_i(axi_i_arready_i)
-    ,.axi_rvalid_i(axi_i_rvalid_i)
-    ,.axi_rdata_i(axi_i_rdata_i)
-    ,.axi_rresp_i(axi_i_rresp_i)
-    ,.axi_rid_i(axi_i_rid_i)
-    ,.axi_rlast_i(axi_i_rlast_i)
+    ,.axi_awready_i(icache_axi_awready_w)
+    ,.axi_wready_i(icache_axi_wready_w)
+    ,.axi_bvalid_i(icache_axi_bvalid_w)
+    ,.axi_bresp_i(icache_axi_bresp_w)
+    ,.axi_bid_i(icache_axi_bid_w)
+    ,.axi_arready_i(icache_axi_arready_w)
+    ,.axi_rvalid_i(icache_axi_rvalid_w)
+    ,.axi_rdata_i(icache_axi_rdata_w)
+    ,.axi_rresp_i(icache_axi_rresp_w)
+    ,.axi_rid_i(icache_axi_rid_w)
+    ,.axi_rlast_i(icache_axi_rlast_w)
 
     // Outputs
     ,.req_accept_o(icache_accept_w)
     ,.req_valid_o(icache_valid_w)
     ,.req_error_o(icache_error_w)
     ,.req_inst_o(icache_inst_w)
-    ,.axi_awvalid_o(axi_i_awvalid_o)
-    ,.axi_awaddr_o(axi_i_awaddr_o)
-    ,.axi_awid_o(axi_i_awid_o)
-    ,.axi_awlen_o(axi_i_awlen_o)
-    ,.axi_awburst_o(axi_i_awburst_o)
-    ,.axi_wvalid_o(axi_i_wvalid_o)
-    ,.axi_wdata_o(axi_i_wdata_o)
-    ,.axi_wstrb_o(axi_i_wstrb_o)
-    ,.axi_wlast_o(axi_i_wlast_o)
-    ,.axi_bready_o(axi_i_bready_o)
-    ,.axi_arvalid_o(axi_i_arvalid_o)
-    ,.axi_araddr_o(axi_i_araddr_o)
-    ,.axi_arid_o(axi_i_arid_o)
-    ,.axi_arlen_o(axi_i_arlen_o)
-    ,.axi_arburst_o(axi_i_arburst_o)
-    ,.axi_rready_o(axi_i_rready_o)
+    ,.axi_awvalid_o(icache_axi_awvalid_w)
+    ,.axi_awaddr_o(icache_axi_awaddr_w)
+    ,.axi_awid_o(icache_axi_awid_w)
+    ,.axi_awlen_o(icache_axi_awlen_w)
+    ,.axi_awburst_o(icache_axi_awburst_w)
+    ,.axi_wvalid_o(icache_axi_wvalid_w)
+    ,.axi_wdata_o(icache_axi_wdata_w)
+    ,.axi_wstrb_o(icache_axi_wstrb_w)
+    ,.axi_wlast_o(icache_axi_wlast_w)
+    ,.axi_bready_o(icache_axi_bready_w)
+    ,.axi_arvalid_o(icache_axi_arvalid_w)
+    ,.axi_araddr_o(icache_axi_araddr_w)
+    ,.axi_arid_o(icache_axi_arid_w)
+    ,.axi_arlen_o(icache_axi_arlen_w)
+    ,.axi_arburst_o(icache_axi_arburst_w)
+    ,.axi_rready_o(icache_axi_rready_w)
 );
 
 
+//-----------------------------------------------------------------
+// Optional shared L2 cache (all memory traffic on axi_d_*)
+//-----------------------------------------------------------------
+generate
+if (L2_ENABLE)
+begin : L2
+    l2cache
+    #(
+         .L2_NUM_WAYS(L2_NUM_WAYS)
+        ,.L2_NUM_WAYS_W(L2_NUM_WAYS_W)
+        ,.L2_NUM_LINES(L2_NUM_LINES)
+        ,.L2_NUM_LINES_W(L2_NUM_LINES_W)
+        ,.L2_LINE_SIZE(L2_LINE_SIZE)
+        ,.L2_LINE_SIZE_W(L2_LINE_SIZE_W)
+        ,.L2_NUM_BANKS(L2_NUM_BANKS)
+        ,.L2_NUM_BANKS_W(L2_NUM_BANKS_W)
+        ,.AXI_DATA_W(AXI_DATA_W)
+        ,.MEM_CACHE_ADDR_MIN(MEM_CACHE_ADDR_MIN)
+        ,.MEM_CACHE_ADDR_MAX(MEM_CACHE_ADDR_MAX)
+    )
+    u_l2
+    (
+        // Inputs
+         .clk_i(clk_i)
+        ,.rst_i(rst_i)
+        ,.inport_i_awvalid_i(icache_axi_awvalid_w)
+        ,.inport_i_awaddr_i(icache_axi_awaddr_w)
+        ,.inport_i_awid_i(icache_axi_awid_w)
+        ,.inport_i_awlen_i(icache_axi_awlen_w)
+        ,.inport_i_awburst_i(icache_axi_awburst_w)
+        ,.inport_i_wvalid_i(icache_axi_wvalid_w)
+        ,.inport_i_wdata_i(icache_axi_wdata_w)
+        ,.inport_i_wstrb_i(icache_axi_wstrb_w)
+        ,.inport_i_wlast_i(icache_axi_wlast_w)
+        ,.inport_i_bready_i(icache_axi_bready_w)
+        ,.inport_i_arvalid_i(icache_axi_arvalid_w)
+        ,.inport_i_araddr_i(icache_axi_araddr_w)
+        ,.inport_i_arid_i(icache_axi_arid_w)
+        ,.inport_i_arlen_i(icache_axi_arlen_w)
+        ,.inport_i_arburst_i(icache_axi_arburst_w)
+        ,.inport_i_rready_i(icache_axi_rready_w)
+        ,.inport_d_awvalid_i(dcache_axi_awvalid_w)
+        ,.inport_d_awaddr_i(dcache_axi_awaddr_w)
+        ,.inport_d_awid_i(dcache_axi_awid_w)
+        ,.inport_d_awlen_i(dcache_axi_awlen_w)
+        ,.inport_d_awburst_i(dcache_axi_awburst_w)
+        ,.inport_d_wvalid_i(dcache_axi_wvalid_w)
+        ,.inport_d_wdata_i(dcache_axi_wdata_w)
+        ,.inport_d_wstrb_i(dcache_axi_wstrb_w)
+        ,.inport_d_wlast_i(dcache_axi_wlast_w)
+        ,.inport_d_bready_i(dcache_axi_bready_w)
+        ,.inport_d_arvalid_i(dcache_axi_arvalid_w)
+        ,.inport_d_araddr_i(dcache_axi_araddr_w)
+        ,.inport_d_arid_i(dcache_axi_arid_w)
+        ,.inport_d_arlen_i(dcache_axi_arlen_w)
+        ,.inport_d_arburst_i(dcache_axi_arburst_w)
+        ,.inport_d_rready_i(dcache_axi_rready_w)
+        ,.outport_awready_i(axi_d_awready_i)
+        ,.outport_wready_i(axi_d_wready_i)
+        ,.outport_bvalid_i(axi_d_bvalid_i)
+        ,.outport_bresp_i(axi_d_bresp_i)
+        ,.outport_bid_i(axi_d_bid_i)
+        ,.outport_arready_i(axi_d_arready_i)
+        ,.outport_rvalid_i(axi_d_rvalid_i)
+        ,.outport_rdata_i(axi_d_rdata_i)
+        ,.outport_rresp_i(axi_d_rresp_i)
+        ,.outport_rid_i(axi_d_rid_i)
+        ,.outport_rlast_i(axi_d_rlast_i)
+
+        // Outputs
+        ,.inport_i_awready_o(icache_axi_awready_w)
+        ,.inport_i_wready_o(icache_axi_wready_w)
+        ,.inport_i_bvalid_o(icache_axi_bvalid_w)
+        ,.inport_i_bresp_o(icache_axi_bresp_w)
+        ,.inport_i_bid_o(icache_axi_bid_w)
+        ,.inport_i_arready_o(icache_axi_arready_w)
+        ,.inport_i_rvalid_o(icache_axi_rvalid_w)
+        ,.inport_i_rdata_o(icache_axi_rdata_w)
+        ,.inport_i_rresp_o(icache_axi_rresp_w)
+        ,.inport_i_rid_o(icache_axi_rid_w)
+        ,.inport_i_rlast_o(icache_axi_rlast_w)
+        ,.inport_d_awready_o(dcache_axi_awready_w)
+        ,.inport_d_wready_o(dcache_axi_wready_w)
+        ,.inport_d_bvalid_o(dcache_axi_bvalid_w)
+        ,.inport_d_bresp_o(dcache_axi_bresp_w)
+        ,.inport_d_bid_o(dcache_axi_bid_w)
+        ,.inport_d_arready_o(dcache_axi_arready_w)
+        ,.inport_d_rvalid_o(dcache_axi_rvalid_w)
+        ,.inport_d_rdata_o(dcache_axi_rdata_w)
+        ,.inport_d_rresp_o(dcache_axi_rresp_w)
+        ,.inport_d_rid_o(dcache_axi_rid_w)
+        ,.inport_d_rlast_o(dcache_axi_rlast_w)
+        ,.outport_awvalid_o(axi_d_awvalid_o)
+        ,.outport_awaddr_o(axi_d_awaddr_o)
+        ,.outport_awid_o(axi_d_awid_o)
+        ,.outport_awlen_o(axi_d_awlen_o)
+        ,.outport_awburst_o(axi_d_awburst_o)
+        ,.outport_wvalid_o(axi_d_wvalid_o)
+        ,.outport_wdata_o(axi_d_wdata_o)
+        ,.outport_wstrb_o(axi_d_wstrb_o)
+        ,.outport_wlast_o(axi_d_wlast_o)
+        ,.outport_bready_o(axi_d_bready_o)
+        ,.outport_arvalid_o(axi_d_arvalid_o)
+        ,.outport_araddr_o(axi_d_araddr_o)
+        ,.outport_arid_o(axi_d_arid_o)
+        ,.outport_arlen_o(axi_d_arlen_o)
+        ,.outport_arburst_o(axi_d_arburst_o)
+        ,.outport_rready_o(axi_d_rready_o)
+    );
+
+    assign axi_i_awvalid_o = 1'b0;
+    assign axi_i_awaddr_o  = 32'b0;
+    assign axi_i_awid_o    = 4'b0;
+    assign axi_i_awlen_o   = 8'b0;
+    assign axi_i_awburst_o = 2'b0;
+    assign axi_i_wvalid_o  = 1'b0;
+    assign axi_i_wdata_o   = {AXI_DATA_W{1'b0}};
+    assign axi_i_wstrb_o   = {(AXI_DATA_W/8){1'b0}};
+    assign axi_i_wlast_o   = 1'b0;
+    assign axi_i_bready_o  = 1'b0;
+    assign axi_i_arvalid_o = 1'b0;
+    assign axi_i_araddr_o  = 32'b0;
+    assign axi_i_arid_o    = 4'b0;
+    assign axi_i_arlen_o   = 8'b0;
+    assign axi_i_arburst_o = 2'b0;
+    assign axi_i_rready_o  = 1'b0;
+end
+else
+begin : NO_L2
+    assign axi_i_awvalid_o  = icache_axi_awvalid_w;
+    assign axi_i_awaddr_o   = icache_axi_awaddr_w;
+    assign axi_i_awid_o     = icache_axi_awid_w;
+    assign axi_i_awlen_o    = icache_axi_awlen_w;
+    assign axi_i_awburst_o  = icache_axi_awburst_w;
+    assign axi_i_wvalid_o   = icache_axi_wvalid_w;
+    assign axi_i_wdata_o    = icache_axi_wdata_w;
+    assign axi_i_wstrb_o    = icache_axi_wstrb_w;
+    assign axi_i_wlast_o    = icache_axi_wlast_w;
+    assign axi_i_bready_o   = icache_axi_bready_w;
+    assign axi_i_arvalid_o  = icache_axi_arvalid_w;
+    assign axi_i_araddr_o   = icache_axi_araddr_w;
+    assign axi_i_arid_o     = icache_axi_arid_w;
+    assign axi_i_arlen_o    = icache_axi_arlen_w;
+    assign axi_i_arburst_o  = icache_axi_arburst_w;
+    assign axi_i_rready_o   = icache_axi_rready_w;
+    assign icache_axi_awready_w = axi_i_awready_i;
+    assign icache_axi_wready_w  = axi_i_wready_i;
+    assign icache_axi_bvalid_w  = axi_i_bvalid_i;
+    assign icache_axi_bresp_w   = axi_i_bresp_i;
+    assign icache_axi_bid_w     = axi_i_bid_i;
+    assign icache_axi_arready_w = axi_i_arready_i;
+    assign icache_axi_rvalid_w  = axi_i_rvalid_i;
+    assign icache_axi_rdata_w   = axi_i_rdata_i;
+    assign icache_axi_rresp_w   = axi_i_rresp_i;
+    assign icache_axi_rid_w     = axi_i_rid_i;
+    assign icache_axi_rlast_w   = axi_i_rlast_i;
+    assign axi_d_awvalid_o  = dcache_axi_awvalid_w;
+    assign axi_d_awaddr_o   = dcache_axi_awaddr_w;
+    assign axi_d_awid_o     = dcache_axi_awid_w;
+    assign axi_d_awlen_o    = dcache_axi_awlen_w;
+    assign axi_d_awburst_o  = dcache_axi_awburst_w;
+    assign axi_d_wvalid_o   = dcache_axi_wvalid_w;
+    assign axi_d_wdata_o    = dcache_axi_wdata_w;
+    assign axi_d_wstrb_o    = dcache_axi_wstrb_w;
+    assign axi_d_wlast_o    = dcache_axi_wlast_w;
+    assign axi_d_bready_o   = dcache_axi_bready_w;
+    assign axi_d_arvalid_o  = dcache_axi_arvalid_w;
+    assign axi_d_araddr_o   = dcache_axi_araddr_w;
+    assign axi_d_arid_o     = dcache_axi_arid_w;
+    assign axi_d_arlen_o    = dcache_axi_arlen_w;
+    assign axi_d_arburst_o  = dcache_axi_arburst_w;
+    assign axi_d_rready_o   = dcache_axi_rready_w;
+    assign dcache_axi_awready_w = axi_d_awready_i;
+    assign dcache_axi_wready_w  = axi_d_wready_i;
+    assign dcache_axi_bvalid_w  = axi_d_bvalid_i;
+    assign dcache_axi_bresp_w   = axi_d_bresp_i;
+    assign dcache_axi_bid_w     = axi_d_bid_i;
+    assign dcache_axi_arready_w = axi_d_arready_i;
+    assign dcache_axi_rvalid_w  = axi_d_rvalid_i;
+    assign dcache_axi_rdata_w   = axi_d_rdata_i;
+    assign dcache_axi_rresp_w   = axi_d_rresp_i;
+    assign dcache_axi_rid_w     = axi_d_rid_i;
+    assign dcache_axi_rlast_w   = axi_d_rlast_i;
+end
+endgenerate
+
 
 endmodule
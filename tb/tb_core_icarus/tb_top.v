@@ -78,11 +78,17 @@ u_dut
     ,.mem_d_ack_i(mem_d_ack_w)
     ,.mem_d_error_i(mem_d_error_w)
     ,.mem_d_resp_tag_i(mem_d_resp_tag_w)
+    ,.mem_d_store_error_i(1'b0)
+    ,.mem_d_store_error_addr_i(32'b0)
+    ,.mem_d_store_empty_i(1'b1)
+    ,.mem_d_fill_error_i(1'b0)
+    ,.mem_d_fill_error_addr_i(32'b0)
     ,.mem_i_accept_i(mem_i_accept_w)
     ,.mem_i_valid_i(mem_i_valid_w)
     ,.mem_i_error_i(mem_i_error_w)
     ,.mem_i_inst_i(mem_i_inst_w)
-    ,.intr_i(1'b0)
+    ,.intr_i(32'b0)
+    ,.timer_intr_i(1'b0)
     ,.reset_vector_i(32'h80000000)
     ,.cpu_id_i('b0)
 
@@ -96,6 +102,7 @@ u_dut
     ,.mem_d_invalidate_o(mem_d_invalidate_w)
     ,.mem_d_writeback_o(mem_d_writeback_w)
     ,.mem_d_flush_o(mem_d_flush_w)
+    ,.mem_d_pc_o()
     ,.mem_i_rd_o(mem_i_rd_w)
     ,.mem_i_flush_o(mem_i_flush_w)
     ,.mem_i_invalidate_o(mem_i_invalidate_w)
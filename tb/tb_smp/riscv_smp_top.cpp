@@ -0,0 +1,137 @@
+
+#include "riscv_smp_top.h"
+#include "Vriscv_smp_top.h"
+
+#if VM_TRACE
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#endif
+
+//-------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------
+riscv_smp_top::riscv_smp_top(sc_module_name name): sc_module(name)
+{
+    m_rtl = new Vriscv_smp_top("Vriscv_smp_top");
+    m_rtl->clk_i(m_clk_in);
+    m_rtl->rst_i(m_rst_in);
+    m_rtl->axi_awready_i(m_axi_awready_in);
+    m_rtl->axi_wready_i(m_axi_wready_in);
+    m_rtl->axi_bvalid_i(m_axi_bvalid_in);
+    m_rtl->axi_bresp_i(m_axi_bresp_in);
+    m_rtl->axi_bid_i(m_axi_bid_in);
+    m_rtl->axi_arready_i(m_axi_arready_in);
+    m_rtl->axi_rvalid_i(m_axi_rvalid_in);
+    m_rtl->axi_rdata_i(m_axi_rdata_in);
+    m_rtl->axi_rresp_i(m_axi_rresp_in);
+    m_rtl->axi_rid_i(m_axi_rid_in);
+    m_rtl->axi_rlast_i(m_axi_rlast_in);
+    m_rtl->intr_i(m_intr_in);
+    m_rtl->reset_vector_i(m_reset_vector_in);
+    m_rtl->axi_awvalid_o(m_axi_awvalid_out);
+    m_rtl->axi_awaddr_o(m_axi_awaddr_out);
+    m_rtl->axi_awid_o(m_axi_awid_out);
+    m_rtl->axi_awlen_o(m_axi_awlen_out);
+    m_rtl->axi_awburst_o(m_axi_awburst_out);
+    m_rtl->axi_wvalid_o(m_axi_wvalid_out);
+    m_rtl->axi_wdata_o(m_axi_wdata_out);
+    m_rtl->axi_wstrb_o(m_axi_wstrb_out);
+    m_rtl->axi_wlast_o(m_axi_wlast_out);
+    m_rtl->axi_bready_o(m_axi_bready_out);
+    m_rtl->axi_arvalid_o(m_axi_arvalid_out);
+    m_rtl->axi_araddr_o(m_axi_araddr_out);
+    m_rtl->axi_arid_o(m_axi_arid_out);
+    m_rtl->axi_arlen_o(m_axi_arlen_out);
+    m_rtl->axi_arburst_o(m_axi_arburst_out);
+    m_rtl->axi_rready_o(m_axi_rready_out);
+
+    SC_METHOD(async_outputs);
+    sensitive << clk_in;
+    sensitive << rst_in;
+    sensitive << intr_in;
+    sensitive << reset_vector_in;
+    sensitive << axi_in;
+    sensitive << m_axi_awvalid_out;
+    sensitive << m_axi_awaddr_out;
+    sensitive << m_axi_awid_out;
+    sensitive << m_axi_awlen_out;
+    sensitive << m_axi_awburst_out;
+    sensitive << m_axi_wvalid_out;
+    sensitive << m_axi_wdata_out;
+    sensitive << m_axi_wstrb_out;
+    sensitive << m_axi_wlast_out;
+    sensitive << m_axi_bready_out;
+    sensitive << m_axi_arvalid_out;
+    sensitive << m_axi_araddr_out;
+    sensitive << m_axi_arid_out;
+    sensitive << m_axi_arlen_out;
+    sensitive << m_axi_arburst_out;
+    sensitive << m_axi_rready_out;
+
+#if VM_TRACE
+    m_vcd         = NULL;
+    m_delay_waves = false;
+#endif
+}
+//-------------------------------------------------------------
+// trace_enable
+//-------------------------------------------------------------
+void riscv_smp_top::trace_enable(VerilatedVcdC * p)
+{
+#if VM_TRACE
+    m_vcd = p;
+    m_rtl->trace (m_vcd, 99);
+#endif
+}
+void riscv_smp_top::trace_enable(VerilatedVcdC *p, sc_core::sc_time start_time)
+{
+#if VM_TRACE
+    m_vcd = p;
+    m_delay_waves = true;
+    m_waves_start = start_time;
+    //m_rtl->trace (m_vcd, 99);
+#endif
+}
+//-------------------------------------------------------------
+// async_outputs
+//-------------------------------------------------------------
+void riscv_smp_top::async_outputs(void)
+{
+    m_clk_in.write(clk_in.read());
+    m_rst_in.write(rst_in.read());
+    m_intr_in.write(intr_in.read());
+    m_reset_vector_in.write(reset_vector_in.read());
+
+    axi4_slave axi_i = axi_in.read();
+    m_axi_awready_in.write(axi_i.AWREADY); 
+    m_axi_wready_in.write(axi_i.WREADY); 
+    m_axi_bvalid_in.write(axi_i.BVALID); 
+    m_axi_bresp_in.write(axi_i.BRESP); 
+    m_axi_bid_in.write(axi_i.BID); 
+    m_axi_arready_in.write(axi_i.ARREADY); 
+    m_axi_rvalid_in.write(axi_i.RVALID); 
+    m_axi_rdata_in.write(axi_i.RDATA); 
+    m_axi_rresp_in.write(axi_i.RRESP); 
+    m_axi_rid_in.write(axi_i.RID); 
+    m_axi_rlast_in.write(axi_i.RLAST); 
+
+    axi4_master axi_o;
+    axi_o.AWVALID = m_axi_awvalid_out.read(); 
+    axi_o.AWADDR = m_axi_awaddr_out.read(); 
+    axi_o.AWID = m_axi_awid_out.read(); 
+    axi_o.AWLEN = m_axi_awlen_out.read(); 
+    axi_o.AWBURST = m_axi_awburst_out.read(); 
+    axi_o.WVALID = m_axi_wvalid_out.read(); 
+    axi_o.WDATA = m_axi_wdata_out.read(); 
+    axi_o.WSTRB = m_axi_wstrb_out.read(); 
+    axi_o.WLAST = m_axi_wlast_out.read(); 
+    axi_o.BREADY = m_axi_bready_out.read(); 
+    axi_o.ARVALID = m_axi_arvalid_out.read(); 
+    axi_o.ARADDR = m_axi_araddr_out.read(); 
+    axi_o.ARID = m_axi_arid_out.read(); 
+    axi_o.ARLEN = m_axi_arlen_out.read(); 
+    axi_o.ARBURST = m_axi_arburst_out.read(); 
+    axi_o.RREADY = m_axi_rready_out.read(); 
+    axi_out.write(axi_o);
+
+}
@@ -0,0 +1,100 @@
+
+#ifndef RISCV_SMP_TOP_H
+#define RISCV_SMP_TOP_H
+#include <systemc.h>
+
+#include "axi4.h"
+
+class Vriscv_smp_top;
+class VerilatedVcdC;
+
+//-------------------------------------------------------------
+// riscv_smp_top: RTL wrapper class
+//-------------------------------------------------------------
+class riscv_smp_top: public sc_module
+{
+public:
+    sc_in <bool> clk_in;
+    sc_in <bool> rst_in;
+    sc_in <sc_uint<8> > intr_in;
+    sc_in <sc_uint<32> > reset_vector_in;
+
+    sc_in  <axi4_slave>  axi_in;
+    sc_out <axi4_master> axi_out;
+
+    //-------------------------------------------------------------
+    // Constructor
+    //-------------------------------------------------------------
+    SC_HAS_PROCESS(riscv_smp_top);
+    riscv_smp_top(sc_module_name name);
+
+    //-------------------------------------------------------------
+    // Trace
+    //-------------------------------------------------------------
+    virtual void add_trace(sc_trace_file *vcd, std::string prefix)
+    {
+        #undef  TRACE_SIGNAL
+        #define TRACE_SIGNAL(s) sc_trace(vcd,s,prefix + #s)
+
+        TRACE_SIGNAL(clk_in);
+        TRACE_SIGNAL(rst_in);
+        TRACE_SIGNAL(intr_in);
+        TRACE_SIGNAL(reset_vector_in);
+        TRACE_SIGNAL(axi_in);
+        TRACE_SIGNAL(axi_out);
+
+        #undef  TRACE_SIGNAL
+    }
+
+    void async_outputs(void);
+    void trace_rtl(void);
+    void trace_enable(VerilatedVcdC *p);
+    void trace_enable(VerilatedVcdC *p, sc_core::sc_time start_time);
+
+    //-------------------------------------------------------------
+    // Signals
+    //-------------------------------------------------------------
+private:
+    sc_signal <bool> m_clk_in;
+    sc_signal <bool> m_rst_in;
+    sc_signal <bool> m_axi_awready_in;
+    sc_signal <bool> m_axi_wready_in;
+    sc_signal <bool> m_axi_bvalid_in;
+    sc_signal <sc_uint<2> > m_axi_bresp_in;
+    sc_signal <sc_uint<4> > m_axi_bid_in;
+    sc_signal <bool> m_axi_arready_in;
+    sc_signal <bool> m_axi_rvalid_in;
+    sc_signal <axi4_data_t > m_axi_rdata_in;
+    sc_signal <sc_uint<2> > m_axi_rresp_in;
+    sc_signal <sc_uint<4> > m_axi_rid_in;
+    sc_signal <bool> m_axi_rlast_in;
+    sc_signal <sc_uint<8> > m_intr_in;
+    sc_signal <sc_uint<32> > m_reset_vector_in;
+
+    sc_signal <bool> m_axi_awvalid_out;
+    sc_signal <sc_uint<32> > m_axi_awaddr_out;
+    sc_signal <sc_uint<4> > m_axi_awid_out;
+    sc_signal <sc_uint<8> > m_axi_awlen_out;
+    sc_signal <sc_uint<2> > m_axi_awburst_out;
+    sc_signal <bool> m_axi_wvalid_out;
+    sc_signal <axi4_data_t > m_axi_wdata_out;
+    sc_signal <axi4_strb_t > m_axi_wstrb_out;
+    sc_signal <bool> m_axi_wlast_out;
+    sc_signal <bool> m_axi_bready_out;
+    sc_signal <bool> m_axi_arvalid_out;
+    sc_signal <sc_uint<32> > m_axi_araddr_out;
+    sc_signal <sc_uint<4> > m_axi_arid_out;
+    sc_signal <sc_uint<8> > m_axi_arlen_out;
+    sc_signal <sc_uint<2> > m_axi_arburst_out;
+    sc_signal <bool> m_axi_rready_out;
+
+public:
+    Vriscv_smp_top *m_rtl;
+#if VM_TRACE
+    VerilatedVcdC  * m_vcd;
+    bool             m_delay_waves;
+    sc_core::sc_time m_waves_start;
+#endif 
+};
+
+#endif
\ No newline at end of file
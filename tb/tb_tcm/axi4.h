@@ -2,6 +2,17 @@
 #define AXI4_H
 
 #include <systemc.h>
+#include "axi4_defines.h"
+
+//----------------------------------------------------------------
+// Data types (the RTL uses sc_biguint ports above 64-bits)
+//----------------------------------------------------------------
+#if AXI4_DATA_W > 64
+typedef sc_biguint <AXI4_DATA_W> axi4_data_t;
+#else
+typedef sc_uint <AXI4_DATA_W>    axi4_data_t;
+#endif
+typedef sc_uint <AXI4_STRB_W>    axi4_strb_t;
 
 //----------------------------------------------------------------
 // Interface (master)
@@ -16,8 +27,8 @@ public:
     sc_uint <8> AWLEN;
     sc_uint <2> AWBURST;
     sc_uint <1> WVALID;
-    sc_uint <32> WDATA;
-    sc_uint <4> WSTRB;
+    axi4_data_t WDATA;
+    axi4_strb_t WSTRB;
     sc_uint <1> WLAST;
     sc_uint <1> BREADY;
     sc_uint <1> ARVALID;
@@ -153,7 +164,7 @@ public:
     sc_uint <4> BID;
     sc_uint <1> ARREADY;
     sc_uint <1> RVALID;
-    sc_uint <32> RDATA;
+    axi4_data_t RDATA;
     sc_uint <2> RRESP;
     sc_uint <4> RID;
     sc_uint <1> RLAST;
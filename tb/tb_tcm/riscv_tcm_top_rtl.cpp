@@ -39,6 +39,17 @@ riscv_tcm_top_rtl::riscv_tcm_top_rtl(sc_module_name name): sc_module(name)
     m_rtl->axi_t_arlen_i(m_axi_t_arlen_in);
     m_rtl->axi_t_arburst_i(m_axi_t_arburst_in);
     m_rtl->axi_t_rready_i(m_axi_t_rready_in);
+    m_rtl->axi_dma_awready_i(m_axi_dma_awready_in);
+    m_rtl->axi_dma_wready_i(m_axi_dma_wready_in);
+    m_rtl->axi_dma_bvalid_i(m_axi_dma_bvalid_in);
+    m_rtl->axi_dma_bresp_i(m_axi_dma_bresp_in);
+    m_rtl->axi_dma_bid_i(m_axi_dma_bid_in);
+    m_rtl->axi_dma_arready_i(m_axi_dma_arready_in);
+    m_rtl->axi_dma_rvalid_i(m_axi_dma_rvalid_in);
+    m_rtl->axi_dma_rdata_i(m_axi_dma_rdata_in);
+    m_rtl->axi_dma_rresp_i(m_axi_dma_rresp_in);
+    m_rtl->axi_dma_rid_i(m_axi_dma_rid_in);
+    m_rtl->axi_dma_rlast_i(m_axi_dma_rlast_in);
     m_rtl->intr_i(m_intr_in);
     m_rtl->axi_i_awvalid_o(m_axi_i_awvalid_out);
     m_rtl->axi_i_awaddr_o(m_axi_i_awaddr_out);
@@ -60,6 +71,22 @@ riscv_tcm_top_rtl::riscv_tcm_top_rtl(sc_module_name name): sc_module(name)
     m_rtl->axi_t_rresp_o(m_axi_t_rresp_out);
     m_rtl->axi_t_rid_o(m_axi_t_rid_out);
     m_rtl->axi_t_rlast_o(m_axi_t_rlast_out);
+    m_rtl->axi_dma_awvalid_o(m_axi_dma_awvalid_out);
+    m_rtl->axi_dma_awaddr_o(m_axi_dma_awaddr_out);
+    m_rtl->axi_dma_awid_o(m_axi_dma_awid_out);
+    m_rtl->axi_dma_awlen_o(m_axi_dma_awlen_out);
+    m_rtl->axi_dma_awburst_o(m_axi_dma_awburst_out);
+    m_rtl->axi_dma_wvalid_o(m_axi_dma_wvalid_out);
+    m_rtl->axi_dma_wdata_o(m_axi_dma_wdata_out);
+    m_rtl->axi_dma_wstrb_o(m_axi_dma_wstrb_out);
+    m_rtl->axi_dma_wlast_o(m_axi_dma_wlast_out);
+    m_rtl->axi_dma_bready_o(m_axi_dma_bready_out);
+    m_rtl->axi_dma_arvalid_o(m_axi_dma_arvalid_out);
+    m_rtl->axi_dma_araddr_o(m_axi_dma_araddr_out);
+    m_rtl->axi_dma_arid_o(m_axi_dma_arid_out);
+    m_rtl->axi_dma_arlen_o(m_axi_dma_arlen_out);
+    m_rtl->axi_dma_arburst_o(m_axi_dma_arburst_out);
+    m_rtl->axi_dma_rready_o(m_axi_dma_rready_out);
 
     SC_METHOD(async_outputs);
     sensitive << clk_in;
@@ -68,6 +95,7 @@ riscv_tcm_top_rtl::riscv_tcm_top_rtl(sc_module_name name): sc_module(name)
     sensitive << intr_in;
     sensitive << axi_i_in;
     sensitive << axi_t_in;
+    sensitive << axi_dma_in;
     sensitive << m_axi_i_awvalid_out;
     sensitive << m_axi_i_awaddr_out;
     sensitive << m_axi_i_wvalid_out;
@@ -88,6 +116,22 @@ riscv_tcm_top_rtl::riscv_tcm_top_rtl(sc_module_name name): sc_module(name)
     sensitive << m_axi_t_rresp_out;
     sensitive << m_axi_t_rid_out;
     sensitive << m_axi_t_rlast_out;
+    sensitive << m_axi_dma_awvalid_out;
+    sensitive << m_axi_dma_awaddr_out;
+    sensitive << m_axi_dma_awid_out;
+    sensitive << m_axi_dma_awlen_out;
+    sensitive << m_axi_dma_awburst_out;
+    sensitive << m_axi_dma_wvalid_out;
+    sensitive << m_axi_dma_wdata_out;
+    sensitive << m_axi_dma_wstrb_out;
+    sensitive << m_axi_dma_wlast_out;
+    sensitive << m_axi_dma_bready_out;
+    sensitive << m_axi_dma_arvalid_out;
+    sensitive << m_axi_dma_araddr_out;
+    sensitive << m_axi_dma_arid_out;
+    sensitive << m_axi_dma_arlen_out;
+    sensitive << m_axi_dma_arburst_out;
+    sensitive << m_axi_dma_rready_out;
 
 #if VM_TRACE
     m_vcd         = NULL;
@@ -197,5 +241,37 @@ void riscv_tcm_top_rtl::async_outputs(void)
     axi_t_o.RID = m_axi_t_rid_out.read(); 
     axi_t_o.RLAST = m_axi_t_rlast_out.read(); 
     axi_t_out.write(axi_t_o);
+    axi4_slave axi_dma_i = axi_dma_in.read();
+    m_axi_dma_awready_in.write(axi_dma_i.AWREADY); 
+    m_axi_dma_wready_in.write(axi_dma_i.WREADY); 
+    m_axi_dma_bvalid_in.write(axi_dma_i.BVALID); 
+    m_axi_dma_bresp_in.write(axi_dma_i.BRESP); 
+    m_axi_dma_bid_in.write(axi_dma_i.BID); 
+    m_axi_dma_arready_in.write(axi_dma_i.ARREADY); 
+    m_axi_dma_rvalid_in.write(axi_dma_i.RVALID); 
+    m_axi_dma_rdata_in.write(axi_dma_i.RDATA); 
+    m_axi_dma_rresp_in.write(axi_dma_i.RRESP); 
+    m_axi_dma_rid_in.write(axi_dma_i.RID); 
+    m_axi_dma_rlast_in.write(axi_dma_i.RLAST); 
+
+
+    axi4_master axi_dma_o;
+    axi_dma_o.AWVALID = m_axi_dma_awvalid_out.read(); 
+    axi_dma_o.AWADDR = m_axi_dma_awaddr_out.read(); 
+    axi_dma_o.AWID = m_axi_dma_awid_out.read(); 
+    axi_dma_o.AWLEN = m_axi_dma_awlen_out.read(); 
+    axi_dma_o.AWBURST = m_axi_dma_awburst_out.read(); 
+    axi_dma_o.WVALID = m_axi_dma_wvalid_out.read(); 
+    axi_dma_o.WDATA = m_axi_dma_wdata_out.read(); 
+    axi_dma_o.WSTRB = m_axi_dma_wstrb_out.read(); 
+    axi_dma_o.WLAST = m_axi_dma_wlast_out.read(); 
+    axi_dma_o.BREADY = m_axi_dma_bready_out.read(); 
+    axi_dma_o.ARVALID = m_axi_dma_arvalid_out.read(); 
+    axi_dma_o.ARADDR = m_axi_dma_araddr_out.read(); 
+    axi_dma_o.ARID = m_axi_dma_arid_out.read(); 
+    axi_dma_o.ARLEN = m_axi_dma_arlen_out.read(); 
+    axi_dma_o.ARBURST = m_axi_dma_arburst_out.read(); 
+    axi_dma_o.RREADY = m_axi_dma_rready_out.read(); 
+    axi_dma_out.write(axi_dma_o);
 
 }
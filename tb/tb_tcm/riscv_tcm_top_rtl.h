@@ -24,6 +24,8 @@ public:
     sc_out <axi4_lite_master> axi_i_out;
     sc_in  <axi4_master>  axi_t_in;
     sc_out <axi4_slave> axi_t_out;
+    sc_in  <axi4_slave>  axi_dma_in;
+    sc_out <axi4_master> axi_dma_out;
 
     //-------------------------------------------------------------
     // Constructor
@@ -47,6 +49,8 @@ public:
         TRACE_SIGNAL(axi_i_out);
         TRACE_SIGNAL(axi_t_in);
         TRACE_SIGNAL(axi_t_out);
+        TRACE_SIGNAL(axi_dma_in);
+        TRACE_SIGNAL(axi_dma_out);
 
         #undef  TRACE_SIGNAL
     }
@@ -87,6 +91,17 @@ private:
     sc_signal <sc_uint<8> > m_axi_t_arlen_in;
     sc_signal <sc_uint<2> > m_axi_t_arburst_in;
     sc_signal <bool> m_axi_t_rready_in;
+    sc_signal <bool> m_axi_dma_awready_in;
+    sc_signal <bool> m_axi_dma_wready_in;
+    sc_signal <bool> m_axi_dma_bvalid_in;
+    sc_signal <sc_uint<2> > m_axi_dma_bresp_in;
+    sc_signal <sc_uint<4> > m_axi_dma_bid_in;
+    sc_signal <bool> m_axi_dma_arready_in;
+    sc_signal <bool> m_axi_dma_rvalid_in;
+    sc_signal <sc_uint<32> > m_axi_dma_rdata_in;
+    sc_signal <sc_uint<2> > m_axi_dma_rresp_in;
+    sc_signal <sc_uint<4> > m_axi_dma_rid_in;
+    sc_signal <bool> m_axi_dma_rlast_in;
     sc_signal <sc_uint <32> > m_intr_in;
 
     sc_signal <bool> m_axi_i_awvalid_out;
@@ -109,6 +124,22 @@ private:
     sc_signal <sc_uint<2> > m_axi_t_rresp_out;
     sc_signal <sc_uint<4> > m_axi_t_rid_out;
     sc_signal <bool> m_axi_t_rlast_out;
+    sc_signal <bool> m_axi_dma_awvalid_out;
+    sc_signal <sc_uint<32> > m_axi_dma_awaddr_out;
+    sc_signal <sc_uint<4> > m_axi_dma_awid_out;
+    sc_signal <sc_uint<8> > m_axi_dma_awlen_out;
+    sc_signal <sc_uint<2> > m_axi_dma_awburst_out;
+    sc_signal <bool> m_axi_dma_wvalid_out;
+    sc_signal <sc_uint<32> > m_axi_dma_wdata_out;
+    sc_signal <sc_uint<4> > m_axi_dma_wstrb_out;
+    sc_signal <bool> m_axi_dma_wlast_out;
+    sc_signal <bool> m_axi_dma_bready_out;
+    sc_signal <bool> m_axi_dma_arvalid_out;
+    sc_signal <sc_uint<32> > m_axi_dma_araddr_out;
+    sc_signal <sc_uint<4> > m_axi_dma_arid_out;
+    sc_signal <sc_uint<8> > m_axi_dma_arlen_out;
+    sc_signal <sc_uint<2> > m_axi_dma_arburst_out;
+    sc_signal <bool> m_axi_dma_rready_out;
 
 public:
     Vriscv_tcm_top *m_rtl;
@@ -0,0 +1,72 @@
+#ifndef TB_PERIPH_H
+#define TB_PERIPH_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+//-------------------------------------------------------------
+// tb_irq_sink: Receiver of interrupt line changes
+//-------------------------------------------------------------
+class tb_irq_sink
+{
+public:
+    virtual ~tb_irq_sink() {}
+    virtual void set_irq(int line, bool level) = 0;
+};
+
+//-------------------------------------------------------------
+// tb_periph: Memory mapped peripheral model (word registers).
+// Accesses are made from the bus between clock edges, so models
+// only do work when they are accessed or their own events fire.
+//-------------------------------------------------------------
+class tb_periph
+{
+public:
+    tb_periph()
+    {
+        m_irq_sink = NULL;
+        m_irq_line = 0;
+        m_irq      = false;
+    }
+    virtual ~tb_periph() {}
+
+    //-------------------------------------------------------------
+    // API
+    //-------------------------------------------------------------
+    virtual uint32_t read32(uint32_t offset) = 0;
+    virtual void     write32(uint32_t offset, uint32_t data, uint8_t strb) = 0;
+
+    void connect_irq(tb_irq_sink *sink, int line)
+    {
+        m_irq_sink = sink;
+        m_irq_line = line;
+    }
+    bool irq(void) { return m_irq; }
+
+protected:
+    void update_irq(bool level)
+    {
+        if (level == m_irq)
+            return;
+
+        m_irq = level;
+        if (m_irq_sink)
+            m_irq_sink->set_irq(m_irq_line, level);
+    }
+
+    static uint32_t merge(uint32_t old, uint32_t data, uint8_t strb)
+    {
+        uint32_t mask = 0;
+        for (int i=0;i<4;i++)
+            if (strb & (1 << i))
+                mask |= 0xFFu << (8 * i);
+        return (old & ~mask) | (data & mask);
+    }
+
+protected:
+    tb_irq_sink *m_irq_sink;
+    int          m_irq_line;
+    bool         m_irq;
+};
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef TB_PERIPH_BLK_H
+#define TB_PERIPH_BLK_H
+
+#include <stdio.h>
+#include "tb_periph.h"
+#include "mem_api.h"
+
+//-------------------------------------------------------------
+// Registers
+//-------------------------------------------------------------
+#define BLK_CMD             0x00
+    #define BLK_CMD_READ            1   // Disk -> memory
+    #define BLK_CMD_WRITE           2   // Memory -> disk
+#define BLK_STATUS          0x04
+    #define BLK_STATUS_DONE         (1 << 0)
+    #define BLK_STATUS_ERROR        (1 << 1)
+#define BLK_SECTOR          0x08
+#define BLK_COUNT           0x0C
+#define BLK_ADDR            0x10
+#define BLK_CAPACITY        0x14
+#define BLK_IRQ_EN          0x18
+#define BLK_SIZE            0x1000
+
+#define BLK_SECTOR_SIZE     512
+
+//-------------------------------------------------------------
+// tb_periph_blk: Block device backed by a host file.
+// A command moves COUNT sectors between the file and memory
+// (through the testbench memory backdoor) in one go, then sets
+// DONE (or ERROR).  The interrupt is level: IRQ_EN & STATUS.
+//-------------------------------------------------------------
+class tb_periph_blk: public tb_periph
+{
+public:
+    tb_periph_blk()
+    {
+        m_file     = NULL;
+        m_mem      = NULL;
+        m_sectors  = 0;
+        m_status   = 0;
+        m_sector   = 0;
+        m_count    = 0;
+        m_addr     = 0;
+        m_irq_en   = 0;
+        m_reads    = 0;
+        m_writes   = 0;
+    }
+    ~tb_periph_blk()
+    {
+        if (m_file)
+            fclose(m_file);
+    }
+
+    //-------------------------------------------------------------
+    // open: Attach host file (capacity rounded down to sectors)
+    //-------------------------------------------------------------
+    bool open(const char *filename)
+    {
+        m_file = fopen(filename, "r+b");
+        if (!m_file)
+            return false;
+
+        fseek(m_file, 0, SEEK_END);
+        m_sectors = (uint32_t)(ftell(m_file) / BLK_SECTOR_SIZE);
+        return true;
+    }
+
+    void     set_memory(mem_api *mem) { m_mem = mem; }
+    uint32_t get_sectors_read(void)    { return m_reads; }
+    uint32_t get_sectors_written(void) { return m_writes; }
+
+    //-------------------------------------------------------------
+    // tb_periph
+    //-------------------------------------------------------------
+    uint32_t read32(uint32_t offset)
+    {
+        switch (offset)
+        {
+            case BLK_STATUS:   return m_status;
+            case BLK_SECTOR:   return m_sector;
+            case BLK_COUNT:    return m_count;
+            case BLK_ADDR:     return m_addr;
+            case BLK_CAPACITY: return m_sectors;
+            case BLK_IRQ_EN:   return m_irq_en;
+            default:           return 0;
+        }
+    }
+
+    void write32(uint32_t offset, uint32_t data, uint8_t strb)
+    {
+        switch (offset)
+        {
+            case BLK_CMD:
+                m_status |= command(data) ? BLK_STATUS_DONE : BLK_STATUS_ERROR;
+            break;
+            case BLK_STATUS:
+                m_status &= ~data;
+            break;
+            case BLK_SECTOR:
+                m_sector = merge(m_sector, data, strb);
+            break;
+            case BLK_COUNT:
+                m_count  = merge(m_count, data, strb);
+            break;
+            case BLK_ADDR:
+                m_addr   = merge(m_addr, data, strb);
+            break;
+            case BLK_IRQ_EN:
+                m_irq_en = merge(m_irq_en, data, strb) & 1;
+            break;
+            default:
+            break;
+        }
+
+        update_irq(m_irq_en && m_status);
+    }
+
+protected:
+    bool command(uint32_t cmd)
+    {
+        if (!m_file || !m_mem || (cmd != BLK_CMD_READ && cmd != BLK_CMD_WRITE))
+            return false;
+        if (m_sector >= m_sectors || m_count > (m_sectors - m_sector))
+            return false;
+
+        uint8_t  buf[BLK_SECTOR_SIZE];
+        uint32_t addr = m_addr;
+
+        fseek(m_file, (long)m_sector * BLK_SECTOR_SIZE, SEEK_SET);
+
+        for (uint32_t s=0;s<m_count;s++)
+        {
+            if (cmd == BLK_CMD_READ)
+            {
+                if (fread(buf, 1, BLK_SECTOR_SIZE, m_file) != BLK_SECTOR_SIZE)
+                    return false;
+                for (int i=0;i<BLK_SECTOR_SIZE;i++)
+                    m_mem->write(addr + i, buf[i]);
+                m_reads++;
+            }
+            else
+            {
+                for (int i=0;i<BLK_SECTOR_SIZE;i++)
+                    buf[i] = m_mem->read(addr + i);
+                if (fwrite(buf, 1, BLK_SECTOR_SIZE, m_file) != BLK_SECTOR_SIZE)
+                    return false;
+                m_writes++;
+            }
+
+            addr += BLK_SECTOR_SIZE;
+        }
+
+        fflush(m_file);
+        return true;
+    }
+
+protected:
+    FILE     *m_file;
+    mem_api  *m_mem;
+    uint32_t  m_sectors;
+    uint32_t  m_status;
+    uint32_t  m_sector;
+    uint32_t  m_count;
+    uint32_t  m_addr;
+    uint32_t  m_irq_en;
+    uint32_t  m_reads;
+    uint32_t  m_writes;
+};
+
+#endif
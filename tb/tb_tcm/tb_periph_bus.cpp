@@ -0,0 +1,155 @@
+#include "tb_periph_bus.h"
+#include "axi4_defines.h"
+
+//-----------------------------------------------------------------
+// add_device: Map a peripheral at [base, base + size)
+//-----------------------------------------------------------------
+bool tb_periph_bus::add_device(uint32_t base, uint32_t size, tb_periph *dev, const char *name)
+{
+    for (size_t i=0;i<m_regions.size();i++)
+    {
+        tb_periph_region &r = m_regions[i];
+        if (base < (r.base + r.size) && r.base < (base + size))
+        {
+            fprintf(stderr, "PERIPH: %s overlaps %s\n", name, r.name.c_str());
+            return false;
+        }
+    }
+
+    tb_periph_region r;
+    r.base = base;
+    r.size = size;
+    r.dev  = dev;
+    r.name = name;
+    m_regions.push_back(r);
+    return true;
+}
+//-----------------------------------------------------------------
+// find_device: Address decode (NULL if unmapped)
+//-----------------------------------------------------------------
+tb_periph_bus::tb_periph_region *tb_periph_bus::find_device(uint32_t addr)
+{
+    for (size_t i=0;i<m_regions.size();i++)
+        if (addr >= m_regions[i].base && (addr - m_regions[i].base) < m_regions[i].size)
+            return &m_regions[i];
+
+    return NULL;
+}
+//-----------------------------------------------------------------
+// print_map: Dump address map
+//-----------------------------------------------------------------
+void tb_periph_bus::print_map(void)
+{
+    for (size_t i=0;i<m_regions.size();i++)
+        printf("  %-8s 0x%08x - 0x%08x\n", m_regions[i].name.c_str(),
+               m_regions[i].base, m_regions[i].base + m_regions[i].size - 1);
+}
+//-----------------------------------------------------------------
+// set_irq: Interrupt line change from a peripheral
+//-----------------------------------------------------------------
+void tb_periph_bus::set_irq(int line, bool level)
+{
+    uint32_t intr = m_intr;
+
+    if (level)
+        intr |= (1u << line);
+    else
+        intr &= ~(1u << line);
+
+    if (intr != m_intr)
+    {
+        m_intr = intr;
+        m_intr_event.notify(SC_ZERO_TIME);
+    }
+}
+//-----------------------------------------------------------------
+// update_intr: Drive intr_out (single writer for the signal)
+//-----------------------------------------------------------------
+void tb_periph_bus::update_intr(void)
+{
+    intr_out.write(m_intr);
+}
+//-----------------------------------------------------------------
+// process: Handle AXI4-Lite requests
+//-----------------------------------------------------------------
+void tb_periph_bus::process(void)
+{
+    axi4_lite_master axi_i = axi_in.read();
+    axi4_lite_slave  axi_o = axi_out.read();
+
+    if (rst_in.read())
+    {
+        axi_o.init();
+        m_aw_valid = false;
+        m_w_valid  = false;
+    }
+    else if (clk_in.posedge())
+    {
+        // Response accepted
+        if (axi_o.BVALID && axi_i.BREADY)
+            axi_o.BVALID = false;
+        if (axi_o.RVALID && axi_i.RREADY)
+            axi_o.RVALID = false;
+
+        // Write address / data
+        if (axi_i.AWVALID && axi_o.AWREADY)
+        {
+            m_aw_valid = true;
+            m_aw_addr  = axi_i.AWADDR;
+        }
+        if (axi_i.WVALID && axi_o.WREADY)
+        {
+            m_w_valid  = true;
+            m_w_data   = axi_i.WDATA;
+            m_w_strb   = axi_i.WSTRB;
+        }
+
+        if (m_aw_valid && m_w_valid && !axi_o.BVALID)
+        {
+            tb_periph_region *r = find_device(m_aw_addr);
+
+            if (r)
+                r->dev->write32((m_aw_addr - r->base) & ~3, m_w_data, m_w_strb);
+            else
+                m_errors++;
+
+            m_writes++;
+            axi_o.BVALID = true;
+            axi_o.BRESP  = r ? AXI4_RESP_OKAY : AXI4_RESP_DECERR;
+            m_aw_valid   = false;
+            m_w_valid    = false;
+        }
+
+        // Read
+        if (axi_i.ARVALID && axi_o.ARREADY)
+        {
+            uint32_t          addr = axi_i.ARADDR;
+            tb_periph_region *r    = find_device(addr);
+
+            if (!r)
+                m_errors++;
+
+            m_reads++;
+            axi_o.RVALID = true;
+            axi_o.RDATA  = r ? r->dev->read32((addr - r->base) & ~3) : 0;
+            axi_o.RRESP  = r ? AXI4_RESP_OKAY : AXI4_RESP_DECERR;
+        }
+    }
+
+    // One outstanding request per direction
+    axi_o.AWREADY = !rst_in.read() && !m_aw_valid && !axi_o.BVALID;
+    axi_o.WREADY  = !rst_in.read() && !m_w_valid  && !axi_o.BVALID;
+    axi_o.ARREADY = !rst_in.read() && !axi_o.RVALID;
+
+    axi_out.write(axi_o);
+
+    // Step on clock edges whilst anything is in flight, otherwise
+    // sleep until the master (or reset) changes.
+    bool busy = axi_o.BVALID || axi_o.RVALID || m_aw_valid || m_w_valid ||
+                axi_i.AWVALID || axi_i.WVALID || axi_i.ARVALID;
+
+    if (busy && !rst_in.read())
+        next_trigger(clk_in.posedge_event());
+    else
+        next_trigger(axi_in.value_changed_event() | rst_in.value_changed_event());
+}
@@ -0,0 +1,111 @@
+#ifndef TB_PERIPH_BUS_H
+#define TB_PERIPH_BUS_H
+
+#include <systemc.h>
+#include <vector>
+#include <string>
+
+#include "axi4_lite.h"
+#include "tb_periph.h"
+
+//-------------------------------------------------------------
+// tb_periph_bus: AXI4-Lite slave decoding onto peripheral models.
+// The bus only clocks while a transaction is in flight - when
+// idle it waits for the master to change its outputs.
+//-------------------------------------------------------------
+class tb_periph_bus: public sc_module, public tb_irq_sink
+{
+public:
+    //-------------------------------------------------------------
+    // Interface I/O
+    //-------------------------------------------------------------
+    sc_in <bool>                clk_in;
+    sc_in <bool>                rst_in;
+
+    sc_in <axi4_lite_master>    axi_in;
+    sc_out <axi4_lite_slave>    axi_out;
+
+    sc_out < sc_uint <32> >     intr_out;
+
+    //-------------------------------------------------------------
+    // Constructor
+    //-------------------------------------------------------------
+    SC_HAS_PROCESS(tb_periph_bus);
+    tb_periph_bus(sc_module_name name): sc_module(name)
+    {
+        SC_METHOD(process);
+
+        SC_METHOD(update_intr);
+        sensitive << m_intr_event;
+        dont_initialize();
+
+        m_aw_valid  = false;
+        m_aw_addr   = 0;
+        m_w_valid   = false;
+        m_w_data    = 0;
+        m_w_strb    = 0;
+        m_intr      = 0;
+        m_reads     = 0;
+        m_writes    = 0;
+        m_errors    = 0;
+    }
+
+    //-------------------------------------------------------------
+    // Trace
+    //-------------------------------------------------------------
+    void add_trace(sc_trace_file *vcd, std::string prefix)
+    {
+        #undef  TRACE_SIGNAL
+        #define TRACE_SIGNAL(s) sc_trace(vcd,s,prefix + #s)
+
+        TRACE_SIGNAL(axi_out);
+        TRACE_SIGNAL(axi_in);
+        TRACE_SIGNAL(intr_out);
+
+        #undef  TRACE_SIGNAL
+    }
+
+    //-------------------------------------------------------------
+    // API
+    //-------------------------------------------------------------
+    bool         add_device(uint32_t base, uint32_t size, tb_periph *dev, const char *name);
+    void         set_irq(int line, bool level);
+    void         print_map(void);
+
+    uint32_t     get_reads(void)  { return m_reads; }
+    uint32_t     get_writes(void) { return m_writes; }
+    uint32_t     get_errors(void) { return m_errors; }
+
+    void         process(void);
+    void         update_intr(void);
+
+protected:
+    struct tb_periph_region
+    {
+        uint32_t    base;
+        uint32_t    size;
+        tb_periph  *dev;
+        std::string name;
+    };
+
+    tb_periph_region *find_device(uint32_t addr);
+
+protected:
+    std::vector <tb_periph_region> m_regions;
+
+    // Write address / data accepted (independently)
+    bool         m_aw_valid;
+    uint32_t     m_aw_addr;
+    bool         m_w_valid;
+    uint32_t     m_w_data;
+    uint8_t      m_w_strb;
+
+    uint32_t     m_intr;
+    sc_event     m_intr_event;
+
+    uint32_t     m_reads;
+    uint32_t     m_writes;
+    uint32_t     m_errors;
+};
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef TB_PERIPH_CLINT_H
+#define TB_PERIPH_CLINT_H
+
+#include <systemc.h>
+#include "tb_periph.h"
+
+//-------------------------------------------------------------
+// Registers (SiFive CLINT layout, hart 0)
+//-------------------------------------------------------------
+#define CLINT_MSIP          0x0000
+#define CLINT_MTIMECMP_LO   0x4000
+#define CLINT_MTIMECMP_HI   0x4004
+#define CLINT_MTIME_LO      0xBFF8
+#define CLINT_MTIME_HI      0xBFFC
+#define CLINT_SIZE          0x10000
+
+// Longest single wait scheduled (re-armed on expiry)
+#define CLINT_MAX_WAIT      (1ULL << 32)
+
+//-------------------------------------------------------------
+// tb_periph_clint: 64-bit timer + software interrupt.
+// mtime is derived from simulation time when read, and the
+// timer interrupt is an event scheduled for the mtimecmp match,
+// so nothing runs per clock cycle.
+//-------------------------------------------------------------
+class tb_periph_clint: public sc_module, public tb_periph
+{
+public:
+    //-------------------------------------------------------------
+    // Constructor
+    //-------------------------------------------------------------
+    SC_HAS_PROCESS(tb_periph_clint);
+    tb_periph_clint(sc_module_name name): sc_module(name)
+    {
+        SC_METHOD(timer_expired);
+        sensitive << m_timer_event;
+        dont_initialize();
+
+        m_tick        = SC_ZERO_TIME;
+        m_mtime_base  = 0;
+        m_mtime_ref   = SC_ZERO_TIME;
+        m_mtimecmp    = (uint64_t)-1;
+        m_msip        = false;
+        m_sw_sink     = NULL;
+        m_sw_line     = 0;
+    }
+
+    //-------------------------------------------------------------
+    // API
+    //-------------------------------------------------------------
+    // mtime increments once per tick (normally the CPU clock period)
+    void set_tick(sc_time tick) { m_mtime_base = mtime(); m_mtime_ref = sc_time_stamp(); m_tick = tick; }
+
+    // MSIP drives a separate line to MTIP
+    void connect_sw_irq(tb_irq_sink *sink, int line)
+    {
+        m_sw_sink = sink;
+        m_sw_line = line;
+    }
+
+    uint64_t mtime(void)
+    {
+        if (m_tick == SC_ZERO_TIME)
+            return m_mtime_base;
+        return m_mtime_base + (uint64_t)((sc_time_stamp() - m_mtime_ref) / m_tick);
+    }
+
+    //-------------------------------------------------------------
+    // tb_periph
+    //-------------------------------------------------------------
+    uint32_t read32(uint32_t offset)
+    {
+        switch (offset)
+        {
+            case CLINT_MSIP:        return m_msip ? 1 : 0;
+            case CLINT_MTIMECMP_LO: return (uint32_t)m_mtimecmp;
+            case CLINT_MTIMECMP_HI: return (uint32_t)(m_mtimecmp >> 32);
+            case CLINT_MTIME_LO:    return (uint32_t)mtime();
+            case CLINT_MTIME_HI:    return (uint32_t)(mtime() >> 32);
+            default:                return 0;
+        }
+    }
+
+    void write32(uint32_t offset, uint32_t data, uint8_t strb)
+    {
+        uint64_t value;
+
+        switch (offset)
+        {
+            case CLINT_MSIP:
+                m_msip = (merge(m_msip ? 1 : 0, data, strb) & 1) != 0;
+                if (m_sw_sink)
+                    m_sw_sink->set_irq(m_sw_line, m_msip);
+            break;
+            case CLINT_MTIMECMP_LO:
+            case CLINT_MTIMECMP_HI:
+                m_mtimecmp = write_half(m_mtimecmp, offset == CLINT_MTIMECMP_HI, data, strb);
+                schedule();
+            break;
+            case CLINT_MTIME_LO:
+            case CLINT_MTIME_HI:
+                value        = write_half(mtime(), offset == CLINT_MTIME_HI, data, strb);
+                m_mtime_base = value;
+                m_mtime_ref  = sc_time_stamp();
+                schedule();
+            break;
+            default:
+            break;
+        }
+    }
+
+    //-------------------------------------------------------------
+    // timer_expired: mtimecmp match (or re-arm of a long wait)
+    //-------------------------------------------------------------
+    void timer_expired(void) { schedule(); }
+
+protected:
+    static uint64_t write_half(uint64_t old, bool hi, uint32_t data, uint8_t strb)
+    {
+        if (hi)
+            return (old & 0xFFFFFFFFULL) | ((uint64_t)merge((uint32_t)(old >> 32), data, strb) << 32);
+        else
+            return (old & ~0xFFFFFFFFULL) | merge((uint32_t)old, data, strb);
+    }
+
+    //-------------------------------------------------------------
+    // schedule: Update MTIP and arm the event for the next match
+    //-------------------------------------------------------------
+    void schedule(void)
+    {
+        uint64_t now = mtime();
+
+        m_timer_event.cancel();
+
+        if (m_mtimecmp <= now)
+            update_irq(true);
+        else
+        {
+            update_irq(false);
+
+            if (m_tick != SC_ZERO_TIME)
+            {
+                uint64_t target = m_mtimecmp;
+                if ((target - now) > CLINT_MAX_WAIT)
+                    target = now + CLINT_MAX_WAIT;
+
+                // Time at which mtime reaches target
+                sc_time when = m_mtime_ref + m_tick * (double)(target - m_mtime_base);
+                if (when > sc_time_stamp())
+                    m_timer_event.notify(when - sc_time_stamp());
+                else
+                    m_timer_event.notify(m_tick);
+            }
+        }
+    }
+
+protected:
+    sc_time      m_tick;
+    uint64_t     m_mtime_base;
+    sc_time      m_mtime_ref;
+    uint64_t     m_mtimecmp;
+    bool         m_msip;
+    sc_event     m_timer_event;
+
+    tb_irq_sink *m_sw_sink;
+    int          m_sw_line;
+};
+
+#endif
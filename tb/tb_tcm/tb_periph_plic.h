@@ -0,0 +1,160 @@
+#ifndef TB_PERIPH_PLIC_H
+#define TB_PERIPH_PLIC_H
+
+#include "tb_periph.h"
+
+//-------------------------------------------------------------
+// Registers (SiFive PLIC layout, single context)
+//-------------------------------------------------------------
+#define PLIC_PRIORITY       0x000000    // + 4 * source
+#define PLIC_PENDING        0x001000
+#define PLIC_ENABLE         0x002000
+#define PLIC_THRESHOLD      0x200000
+#define PLIC_CLAIM          0x200004
+#define PLIC_SIZE           0x400000
+
+#define PLIC_SOURCES        32          // Source 0 is reserved
+#define PLIC_PRIORITY_MASK  0x7
+
+//-------------------------------------------------------------
+// tb_periph_plic: Interrupt controller.  Sources are connected
+// as irq lines (connect_irq(plic, id)), a rising edge or level
+// sets pending, claim clears it until the source is completed.
+//-------------------------------------------------------------
+class tb_periph_plic: public tb_periph, public tb_irq_sink
+{
+public:
+    tb_periph_plic()
+    {
+        m_level     = 0;
+        m_pending   = 0;
+        m_claimed   = 0;
+        m_enable    = 0;
+        m_threshold = 0;
+        m_claims    = 0;
+
+        for (int i=0;i<PLIC_SOURCES;i++)
+            m_priority[i] = 0;
+    }
+
+    uint32_t get_claims(void) { return m_claims; }
+
+    //-------------------------------------------------------------
+    // tb_irq_sink: Source line change
+    //-------------------------------------------------------------
+    void set_irq(int id, bool level)
+    {
+        uint32_t bit = 1u << id;
+
+        if (id <= 0 || id >= PLIC_SOURCES)
+            return;
+
+        if (level)
+        {
+            m_level |= bit;
+            if (!(m_claimed & bit))
+                m_pending |= bit;
+        }
+        else
+            m_level &= ~bit;
+
+        update();
+    }
+
+    //-------------------------------------------------------------
+    // tb_periph
+    //-------------------------------------------------------------
+    uint32_t read32(uint32_t offset)
+    {
+        if (offset < (4 * PLIC_SOURCES))
+            return m_priority[offset / 4];
+
+        switch (offset)
+        {
+            case PLIC_PENDING:   return m_pending;
+            case PLIC_ENABLE:    return m_enable;
+            case PLIC_THRESHOLD: return m_threshold;
+            case PLIC_CLAIM:
+            {
+                int id = best();
+                if (id)
+                {
+                    m_pending &= ~(1u << id);
+                    m_claimed |=  (1u << id);
+                    m_claims++;
+                    update();
+                }
+                return id;
+            }
+            default:             return 0;
+        }
+    }
+
+    void write32(uint32_t offset, uint32_t data, uint8_t strb)
+    {
+        if (offset < (4 * PLIC_SOURCES))
+        {
+            if (offset)
+                m_priority[offset / 4] = merge(m_priority[offset / 4], data, strb) & PLIC_PRIORITY_MASK;
+            update();
+            return;
+        }
+
+        switch (offset)
+        {
+            case PLIC_ENABLE:
+                m_enable = merge(m_enable, data, strb) & ~1u;
+            break;
+            case PLIC_THRESHOLD:
+                m_threshold = merge(m_threshold, data, strb) & PLIC_PRIORITY_MASK;
+            break;
+            case PLIC_CLAIM:
+                // Complete - level sources still asserted become pending again
+                if (data > 0 && data < PLIC_SOURCES)
+                {
+                    uint32_t bit = 1u << data;
+                    m_claimed &= ~bit;
+                    if (m_level & bit)
+                        m_pending |= bit;
+                }
+            break;
+            default:
+            break;
+        }
+
+        update();
+    }
+
+protected:
+    //-------------------------------------------------------------
+    // best: Highest priority pending + enabled source above the
+    // threshold (lowest ID wins a tie), 0 if none
+    //-------------------------------------------------------------
+    int best(void)
+    {
+        int      id   = 0;
+        uint32_t prio = m_threshold;
+
+        for (int i=1;i<PLIC_SOURCES;i++)
+            if ((m_pending & m_enable & (1u << i)) && m_priority[i] > prio)
+            {
+                id   = i;
+                prio = m_priority[i];
+            }
+
+        return id;
+    }
+
+    void update(void) { update_irq(best() != 0); }
+
+protected:
+    uint32_t m_level;
+    uint32_t m_pending;
+    uint32_t m_claimed;
+    uint32_t m_enable;
+    uint32_t m_priority[PLIC_SOURCES];
+    uint32_t m_threshold;
+    uint32_t m_claims;
+};
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef TB_PERIPH_UART_H
+#define TB_PERIPH_UART_H
+
+#include <stdio.h>
+#include <deque>
+#include "tb_periph.h"
+
+//-------------------------------------------------------------
+// Registers (Xilinx UART Lite layout)
+//-------------------------------------------------------------
+#define UART_RX         0x0
+#define UART_TX         0x4
+#define UART_STATUS     0x8
+    #define UART_STATUS_RX_VALID    (1 << 0)
+    #define UART_STATUS_RX_FULL     (1 << 1)
+    #define UART_STATUS_TX_EMPTY    (1 << 2)
+    #define UART_STATUS_TX_FULL     (1 << 3)
+    #define UART_STATUS_IE          (1 << 4)
+#define UART_CTRL       0xC
+    #define UART_CTRL_RST_TX        (1 << 0)
+    #define UART_CTRL_RST_RX        (1 << 1)
+    #define UART_CTRL_IE            (1 << 4)
+#define UART_SIZE       0x1000
+
+//-------------------------------------------------------------
+// tb_periph_uart: Console UART. TX goes straight to stdout,
+// RX is fed from a host file (if any). The interrupt is an
+// edge (TX done or RX data available) - use a PLIC gateway.
+//-------------------------------------------------------------
+class tb_periph_uart: public tb_periph
+{
+public:
+    tb_periph_uart()
+    {
+        m_ie       = false;
+        m_tx_out   = stdout;
+        m_tx_count = 0;
+    }
+
+    //-------------------------------------------------------------
+    // load_rx: Queue contents of a host file as RX data
+    //-------------------------------------------------------------
+    bool load_rx(const char *filename)
+    {
+        FILE *f = fopen(filename, "rb");
+        if (!f)
+            return false;
+
+        int c;
+        while ((c = fgetc(f)) != EOF)
+            m_rx.push_back((uint8_t)c);
+
+        fclose(f);
+        return true;
+    }
+
+    uint32_t get_tx_count(void) { return m_tx_count; }
+
+    //-------------------------------------------------------------
+    // tb_periph
+    //-------------------------------------------------------------
+    uint32_t read32(uint32_t offset)
+    {
+        switch (offset)
+        {
+            case UART_RX:
+            {
+                uint32_t data = 0;
+                if (!m_rx.empty())
+                {
+                    data = m_rx.front();
+                    m_rx.pop_front();
+                }
+                return data;
+            }
+            case UART_STATUS:
+                return (m_rx.empty() ? 0 : UART_STATUS_RX_VALID) |
+                       UART_STATUS_TX_EMPTY |
+                       (m_ie ? UART_STATUS_IE : 0);
+            default:
+                return 0;
+        }
+    }
+
+    void write32(uint32_t offset, uint32_t data, uint8_t strb)
+    {
+        switch (offset)
+        {
+            case UART_TX:
+                fputc(data & 0xFF, m_tx_out);
+                m_tx_count++;
+                if (m_ie)
+                    pulse_irq();
+            break;
+            case UART_CTRL:
+                if (data & UART_CTRL_RST_RX)
+                    m_rx.clear();
+
+                // Enabling interrupts with RX data waiting raises one
+                if ((data & UART_CTRL_IE) && !m_ie && !m_rx.empty())
+                {
+                    m_ie = true;
+                    pulse_irq();
+                }
+                m_ie = (data & UART_CTRL_IE) != 0;
+            break;
+            default:
+            break;
+        }
+    }
+
+protected:
+    void pulse_irq(void)
+    {
+        update_irq(true);
+        update_irq(false);
+    }
+
+protected:
+    bool                  m_ie;
+    FILE                 *m_tx_out;
+    uint32_t              m_tx_count;
+    std::deque <uint8_t>  m_rx;
+};
+
+#endif
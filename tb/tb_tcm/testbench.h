@@ -1,9 +1,16 @@
 #include "testbench_vbase.h"
 #include "elf_load.h"
+#include "sim_host.h"
 #include <getopt.h>
 #include <unistd.h>
 
 #include "riscv_tcm_top_rtl.h"
+#include "tb_axi4_mem.h"
+#include "tb_periph_bus.h"
+#include "tb_periph_uart.h"
+#include "tb_periph_clint.h"
+#include "tb_periph_plic.h"
+#include "tb_periph_blk.h"
 #include "Vriscv_tcm_top.h"
 #include "Vriscv_tcm_top__Syms.h"
 
@@ -11,17 +18,341 @@
 #include "verilated_vcd_sc.h"
 
 #define MEM_BASE 0x00000000
-#define MEM_SIZE (64 * 1024)
+
+// External memory behind the DMA AXI4 master
+#define EXT_MEM_BASE     0x80000000
+#define EXT_MEM_SIZE     (1 << 20)
+
+//-----------------------------------------------------------------
+// Peripherals on the AXI4-Lite port (axi_i_*)
+//-----------------------------------------------------------------
+#define CLINT_BASE       0x02000000
+#define PLIC_BASE        0x0C000000
+#define UART_BASE        0x92000000
+#define BLK_BASE         0x93000000
+
+// intr_in lines
+#define IRQ_LINE_PLIC    1
+#define IRQ_LINE_MTIP    2
+#define IRQ_LINE_MSIP    3
+
+// PLIC sources
+#define PLIC_SRC_UART    1
+#define PLIC_SRC_BLK     2
+
+//-----------------------------------------------------------------
+// Idle skipping: whilst the core sleeps in WFI (and nothing else is
+// in flight) the DUT clock is stopped, mcycle is advanced on wake.
+//-----------------------------------------------------------------
+// Quiet cycles required before the clock is stopped
+#define IDLE_SETTLE      4
+// Cycles left to run before a CSR mtimecmp match (mtime tick)
+#define IDLE_TIMER_LEAD  2
+
+//-----------------------------------------------------------------
+// DMA bench (--dma-bench): CPU memcpy vs DMA (needs SUPPORT_DMA=1)
+//-----------------------------------------------------------------
+#define BENCH_DMA_BASE   0x94000000
+#define BENCH_DESC0      0x400
+#define BENCH_DESC1      0x440
+#define BENCH_FLAG       0x600
+#define BENCH_PARAMS     0x700
+#define BENCH_DATA       0x1000
+#define BENCH_MAX_CYCLES 10000000
+
+// Params: [0] src, [1] dst, [2] bytes, [3] DMA base, [4] first descriptor
+// Flag: 1 memcpy start, 2 memcpy done, 3 descriptor 0 done, 4 chain done
+static const uint32_t dma_bench_prog[] =
+{
+    0x70000293, //        addi t0, x0, 0x700
+    0x0002a503, //        lw   a0, 0(t0)
+    0x0042a583, //        lw   a1, 4(t0)
+    0x0082a603, //        lw   a2, 8(t0)
+    0x00c2a683, //        lw   a3, 12(t0)
+    0x0102a703, //        lw   a4, 16(t0)
+    0x00a60633, //        add  a2, a2, a0
+    0x00100313, //        addi t1, x0, 1
+    0xf062a023, //        sw   t1, -256(t0)
+    0x00052383, // loop:  lw   t2, 0(a0)
+    0x00452e03, //        lw   t3, 4(a0)
+    0x00852e83, //        lw   t4, 8(a0)
+    0x00c52f03, //        lw   t5, 12(a0)
+    0x0075a023, //        sw   t2, 0(a1)
+    0x01c5a223, //        sw   t3, 4(a1)
+    0x01d5a423, //        sw   t4, 8(a1)
+    0x01e5a623, //        sw   t5, 12(a1)
+    0x01050513, //        addi a0, a0, 16
+    0x01058593, //        addi a1, a1, 16
+    0xfcc56ce3, //        bltu a0, a2, loop
+    0x00200313, //        addi t1, x0, 2
+    0xf062a023, //        sw   t1, -256(t0)
+    0x00e6a423, //        sw   a4, 8(a3)        DESC
+    0x00100313, //        addi t1, x0, 1
+    0x0066a023, //        sw   t1, 0(a3)        CTRL.START
+    0x00c6a383, // poll0: lw   t2, 12(a3)       COUNT
+    0xfe038ee3, //        beq  t2, x0, poll0
+    0x00300313, //        addi t1, x0, 3
+    0xf062a023, //        sw   t1, -256(t0)
+    0x0046a383, // poll1: lw   t2, 4(a3)        STATUS
+    0x0023f393, //        andi t2, t2, 2        DONE
+    0xfe038ce3, //        beq  t2, x0, poll1
+    0x00400313, //        addi t1, x0, 4
+    0xf062a023, //        sw   t1, -256(t0)
+    0x0000006f  // spin:  j    spin
+};
+
+//-----------------------------------------------------------------
+// Self tests (--test NAME): hand encoded programs which store their
+// register results to TEST_RESULT then set TEST_FLAG.  The results
+// and the final contents of TEST_DATA are checked on completion.
+//-----------------------------------------------------------------
+#define TEST_FLAG        0x600
+#define TEST_DATA        0x1000
+#define TEST_RESULT      0x1100
+#define TEST_WORDS       32
+#define TEST_POISON      0xA5A5A5A5
+#define TEST_MAX_CYCLES  100000
+
+// AMO / LR / SC
+static const uint32_t test_amo_prog[] =
+{
+    0x00001437, //        lui  s0, 0x1                   TEST_DATA
+    0x10040493, //        addi s1, s0, 0x100             TEST_RESULT
+    0x00300293, //        addi t0, x0, 3
+    0x0054252f, //        amoadd.w a0, t0, (s0)
+    0x00440313, //        addi t1, s0, 4
+    0x00700293, //        addi t0, x0, 7
+    0x085325af, //        amoswap.w a1, t0, (t1)
+    0x00840313, //        addi t1, s0, 8
+    0x0ff00293, //        addi t0, x0, 0xff
+    0x6053262f, //        amoand.w a2, t0, (t1)
+    0x00c40313, //        addi t1, s0, 12
+    0x00100293, //        addi t0, x0, 1
+    0xa05326af, //        amomax.w a3, t0, (t1)
+    0xfff00393, //        addi t2, x0, -1
+    0xe073272f, //        amomaxu.w a4, t2, (t1)
+    0xff800e13, //        addi t3, x0, -8
+    0x81c327af, //        amomin.w a5, t3, (t1)
+    0x01040313, //        addi t1, s0, 16
+    0x0f000293, //        addi t0, x0, 0xf0
+    0x4053282f, //        amoor.w a6, t0, (t1)
+    0x0ff00293, //        addi t0, x0, 0xff
+    0x205328af, //        amoxor.w a7, t0, (t1)
+    0x01440313, //        addi t1, s0, 20
+    0x00200293, //        addi t0, x0, 2
+    0xc0532baf, //        amominu.w s7, t0, (t1)
+    0x01840313, //        addi t1, s0, 24
+    0x1003292f, //        lr.w s2, (t1)
+    0x00190293, //        addi t0, s2, 1
+    0x185329af, //        sc.w s3, t0, (t1)              reserved: succeeds
+    0x03300293, //        addi t0, x0, 0x33
+    0x18532a2f, //        sc.w s4, t0, (t1)              reservation cleared: fails
+    0x10032aaf, //        lr.w s5, (t1)
+    0x01c40393, //        addi t2, s0, 28
+    0x1853ab2f, //        sc.w s6, t0, (t2)              other word: fails
+    0x00a4a023, //        sw   a0, 0(s1)
+    0x00b4a223, //        sw   a1, 4(s1)
+    0x00c4a423, //        sw   a2, 8(s1)
+    0x00d4a623, //        sw   a3, 12(s1)
+    0x00e4a823, //        sw   a4, 16(s1)
+    0x00f4aa23, //        sw   a5, 20(s1)
+    0x0104ac23, //        sw   a6, 24(s1)
+    0x0114ae23, //        sw   a7, 28(s1)
+    0x0374a023, //        sw   s7, 32(s1)
+    0x0324a223, //        sw   s2, 36(s1)
+    0x0334a423, //        sw   s3, 40(s1)
+    0x0344a623, //        sw   s4, 44(s1)
+    0x0354a823, //        sw   s5, 48(s1)
+    0x0364aa23, //        sw   s6, 52(s1)
+    0x00100293, //        addi t0, x0, 1
+    0x60502023, //        sw   t0, 0x600(x0)             TEST_FLAG
+    0x0000006f  // spin:  j    spin
+};
+
+// Zba / Zbb (needs SUPPORT_BITMANIP=1)
+static const uint32_t test_zb_prog[] =
+{
+    0x0e400293, //        addi t0, x0, trap
+    0x30529073, //        csrw mtvec, t0
+    0x000014b7, //        lui  s1, 0x1
+    0x10048493, //        addi s1, s1, 0x100             TEST_RESULT
+    0x12345937, //        lui  s2, 0x12345
+    0x67890913, //        addi s2, s2, 0x678             0x12345678
+    0x8000f9b7, //        lui  s3, 0x8000f
+    0x0f098993, //        addi s3, s3, 0xf0              0x8000f0f0
+    0x00300a13, //        addi s4, x0, 3
+    0x212a2533, //        sh1add a0, s4, s2
+    0x212a45b3, //        sh2add a1, s4, s2
+    0x212a6633, //        sh3add a2, s4, s2
+    0x413976b3, //        andn a3, s2, s3
+    0x41396733, //        orn  a4, s2, s3
+    0x413947b3, //        xnor a5, s2, s3
+    0x00a4a023, //        sw   a0, 0(s1)
+    0x00b4a223, //        sw   a1, 4(s1)
+    0x00c4a423, //        sw   a2, 8(s1)
+    0x00d4a623, //        sw   a3, 12(s1)
+    0x00e4a823, //        sw   a4, 16(s1)
+    0x00f4aa23, //        sw   a5, 20(s1)
+    0x60091513, //        clz  a0, s2
+    0x60199593, //        ctz  a1, s3
+    0x60299613, //        cpop a2, s3
+    0x0b3966b3, //        max  a3, s2, s3
+    0x0b397733, //        maxu a4, s2, s3
+    0x0b3947b3, //        min  a5, s2, s3
+    0x0b395833, //        minu a6, s2, s3
+    0x00a4ac23, //        sw   a0, 24(s1)
+    0x00b4ae23, //        sw   a1, 28(s1)
+    0x02c4a023, //        sw   a2, 32(s1)
+    0x02d4a223, //        sw   a3, 36(s1)
+    0x02e4a423, //        sw   a4, 40(s1)
+    0x02f4a623, //        sw   a5, 44(s1)
+    0x0304a823, //        sw   a6, 48(s1)
+    0x60499513, //        sext.b a0, s3
+    0x60599593, //        sext.h a1, s3
+    0x0809c633, //        zext.h a2, s3
+    0x614916b3, //        rol  a3, s2, s4
+    0x61495733, //        ror  a4, s2, s4
+    0x61f95793, //        rori a5, s2, 31
+    0x2879d813, //        orc.b a6, s3
+    0x69895893, //        rev8 a7, s2
+    0x02a4aa23, //        sw   a0, 52(s1)
+    0x02b4ac23, //        sw   a1, 56(s1)
+    0x02c4ae23, //        sw   a2, 60(s1)
+    0x04d4a023, //        sw   a3, 64(s1)
+    0x04e4a223, //        sw   a4, 68(s1)
+    0x04f4a423, //        sw   a5, 72(s1)
+    0x0504a623, //        sw   a6, 76(s1)
+    0x0514a823, //        sw   a7, 80(s1)
+    0x00000793, //        addi a5, x0, 0
+    0x62095793, //        .word 0x62095793               rori a5, s2, 32 (illegal on RV32)
+    0x04f4aa23, //        sw   a5, 84(s1)
+    0x00100293, //        addi t0, x0, 1
+    0x60502023, //        sw   t0, 0x600(x0)             TEST_FLAG
+    0x0000006f, // spin:  j    spin
+    0x34202373, // trap:  csrr t1, mcause
+    0x0464ac23, //        sw   t1, 88(s1)
+    0x34102373, //        csrr t1, mepc
+    0x00430313, //        addi t1, t1, 4
+    0x34131073, //        csrw mepc, t1
+    0x30200073  //        mret
+};
+
+// Store buffer drain ahead of an AMO / cbo.zero (needs SUPPORT_DUAL_LSU=1 and
+// MEM_CACHE_ADDR_MIN/MAX covering the TCM so the paired stores are buffered)
+static const uint32_t test_sb_prog[] =
+{
+    0x00001437, //        lui  s0, 0x1                   TEST_DATA
+    0x10040493, //        addi s1, s0, 0x100             TEST_RESULT
+    0x01100293, //        addi t0, x0, 0x11
+    0x00300313, //        addi t1, x0, 3
+    0x00440e13, //        addi t3, s0, 4
+    0x02040913, //        addi s2, s0, 32
+    0x00042383, //        lw   t2, 0(s0)                 paired: store buffered
+    0x00542223, //        sw   t0, 4(s0)
+    0x006e252f, //        amoadd.w a0, t1, (t3)          waits for the store to drain
+    0x02200e93, //        addi t4, x0, 0x22
+    0x00442f03, //        lw   t5, 4(s0)                 paired: store buffered
+    0x03d42223, //        sw   t4, 36(s0)
+    0x0049200f, //        cbo.zero (s2)                  waits for the store to drain
+    0x02442f83, //        lw   t6, 36(s0)
+    0x0074a023, //        sw   t2, 0(s1)
+    0x00a4a223, //        sw   a0, 4(s1)
+    0x01e4a423, //        sw   t5, 8(s1)
+    0x01f4a623, //        sw   t6, 12(s1)
+    0x00100293, //        addi t0, x0, 1
+    0x60502023, //        sw   t0, 0x600(x0)             TEST_FLAG
+    0x0000006f  // spin:  j    spin
+};
+
+// Store forwarding, then a buffered store followed by an AMO / cbo.zero (needs
+// SUPPORT_STORE_FWD=1 and MEM_CACHE_ADDR_MIN/MAX covering the TCM)
+static const uint32_t test_fwd_prog[] =
+{
+    0x00001437, //        lui  s0, 0x1                   TEST_DATA
+    0x10040493, //        addi s1, s0, 0x100             TEST_RESULT
+    0x01100293, //        addi t0, x0, 0x11
+    0x00300313, //        addi t1, x0, 3
+    0x00840e13, //        addi t3, s0, 8
+    0x02040913, //        addi s2, s0, 32
+    0x02200e93, //        addi t4, x0, 0x22
+    0x00542223, //        sw   t0, 4(s0)                 buffered
+    0x00442383, //        lw   t2, 4(s0)                 forwarded
+    0x01d42423, //        sw   t4, 8(s0)                 buffered
+    0x006e252f, //        amoadd.w a0, t1, (t3)          waits for the store to drain
+    0x02542223, //        sw   t0, 36(s0)                buffered
+    0x0049200f, //        cbo.zero (s2)                  waits for the store to drain
+    0x02442f83, //        lw   t6, 36(s0)
+    0x0074a023, //        sw   t2, 0(s1)
+    0x00a4a223, //        sw   a0, 4(s1)
+    0x01f4a423, //        sw   t6, 8(s1)
+    0x00100293, //        addi t0, x0, 1
+    0x60502023, //        sw   t0, 0x600(x0)             TEST_FLAG
+    0x0000006f  // spin:  j    spin
+};
+
+struct tb_self_test
+{
+    const char     *name;
+    const uint32_t *prog;
+    uint32_t        prog_words;
+    uint32_t        data_words;
+    uint32_t        data[TEST_WORDS];      // TEST_DATA before
+    uint32_t        data_exp[TEST_WORDS];  // TEST_DATA after
+    uint32_t        result_words;
+    uint32_t        result[TEST_WORDS];    // TEST_RESULT after
+};
+
+#define TEST_PROG(p) p, sizeof(p)/sizeof(p[0])
+
+static const tb_self_test self_tests[] =
+{
+    {
+        "amo", TEST_PROG(test_amo_prog),
+        8, { 5, 0x10, 0xf0f0, 0xfffffffd, 0x0f0f, 9, 7, 0x55 },
+           { 8, 7,    0xf0,   0xfffffff8, 0x0f00, 2, 8, 0x55 },
+        14, { 5, 0x10, 0xf0f0, 0xfffffffd, 1, 0xffffffff, 0x0f0f, 0x0fff, 9,  // amo*
+              7, 0, 1, 8, 1 }                                                // lr / sc
+    },
+    {
+        "zb", TEST_PROG(test_zb_prog),
+        0, { 0 }, { 0 },
+        23, { 0x1234567e, 0x12345684, 0x12345690, 0x12340608, 0x7fff5f7f, 0x6dcb5977,  // shNadd / andn / orn / xnor
+              0x00000003, 0x00000004, 0x00000009,                                      // clz / ctz / cpop
+              0x12345678, 0x8000f0f0, 0x8000f0f0, 0x12345678,                          // max / maxu / min / minu
+              0xfffffff0, 0xfffff0f0, 0x0000f0f0,                                      // sext.b / sext.h / zext.h
+              0x91a2b3c0, 0x02468acf, 0x2468acf0, 0xff00ffff, 0x78563412,              // rol / ror / rori / orc.b / rev8
+              0, 2 }                                                                   // rori shamt[5]: illegal
+    },
+    {
+        "sb", TEST_PROG(test_sb_prog),
+        16, { 5, 0x10, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8 },
+            { 5, 0x14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        4, { 5, 0x11, 0x14, 0 }                                                      // lw / amoadd / lw / lw after cbo.zero
+    },
+    {
+        "fwd", TEST_PROG(test_fwd_prog),
+        16, { 5, 0x10, 7, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8 },
+            { 5, 0x11, 0x25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        3, { 0x11, 0x22, 0 }                                                         // forwarded lw / amoadd / lw after cbo.zero
+    },
+};
 
 //-----------------------------------------------------------------
 // Command line options
 //-----------------------------------------------------------------
-#define GETOPTS_ARGS "f:c:h"
+#define GETOPTS_ARGS "f:c:i:l:d:b:u:t:nh"
 
 static struct option long_options[] =
 {
     {"elf",        required_argument, 0, 'f'},
     {"cycles",     required_argument, 0, 'c'},
+    {"irq-period", required_argument, 0, 'i'},
+    {"irq-line",   required_argument, 0, 'l'},
+    {"dma-bench",  required_argument, 0, 'd'},
+    {"blk",        required_argument, 0, 'b'},
+    {"uart-in",    required_argument, 0, 'u'},
+    {"test",       required_argument, 0, 't'},
+    {"no-idle-skip", no_argument,     0, 'n'},
     {"help",       no_argument,       0, 'h'},
     {0, 0, 0, 0}
 };
@@ -31,6 +362,16 @@ static void help_options(void)
     fprintf (stderr,"Usage:\n");
     fprintf (stderr,"  --elf         | -f FILE       File to load\n");
     fprintf (stderr,"  --cycles      | -c NUM        Max instructions to execute\n");
+    fprintf (stderr,"  --irq-period  | -i NUM        Raise intr_in every NUM cycles (measure latency)\n");
+    fprintf (stderr,"  --irq-line    | -l NUM        intr_in line to raise (default 0)\n");
+    fprintf (stderr,"  --dma-bench   | -d BYTES      Run CPU memcpy vs DMA bench (no ELF)\n");
+    fprintf (stderr,"  --blk         | -b FILE       Block device image (sector 0 at BLK_BASE)\n");
+    fprintf (stderr,"  --uart-in     | -u FILE       Feed FILE to the UART RX\n");
+    fprintf (stderr,"  --test        | -t NAME       Run a built-in self test (no ELF):");
+    for (uint32_t i=0;i<sizeof(self_tests)/sizeof(self_tests[0]);i++)
+        fprintf (stderr," %s", self_tests[i].name);
+    fprintf (stderr,"\n");
+    fprintf (stderr,"  --no-idle-skip | -n           Clock the core whilst it sleeps in WFI\n");
     exit(-1);
 }
 
@@ -44,13 +385,43 @@ public:
     // Instances / Members
     //-----------------------------------------------------------------      
     riscv_tcm_top_rtl           *m_dut;
+    tb_axi4_mem                 *m_ext_mem;
+
+    tb_periph_bus               *m_periph;
+    tb_periph_clint             *m_clint;
+    tb_periph_plic               m_plic;
+    tb_periph_uart               m_uart;
+    tb_periph_blk                m_blk;
 
     int                          m_argc;
     char**                       m_argv;
+
+    uint64_t                     m_irq_lat_count;
+    uint64_t                     m_irq_lat_total;
+    uint64_t                     m_irq_lat_min;
+    uint64_t                     m_irq_lat_max;
+
+    sim_host                     m_host;
+
+    bool                         m_idle_skip;
+    uint32_t                     m_idle_cycles;
+    uint32_t                     m_idle_intr;
+    uint32_t                     m_skip_count;
+    uint64_t                     m_skip_total;
+    uint64_t                     m_skip_wakes;
+    int                          m_axi_rd_pending;
+    int                          m_axi_wr_pending;
+
+    uint32_t                     m_bench_bytes;
+    uint32_t                     m_bench_flag;
+    uint64_t                     m_bench_time[5];
+
+    const tb_self_test          *m_test;
     //-----------------------------------------------------------------
     // Signals
     //-----------------------------------------------------------------    
     sc_signal <bool>            rst_cpu_in;
+    sc_signal <bool>            clk_dut;
 
     sc_signal <axi4_master>      axi_t_in;
     sc_signal <axi4_slave>       axi_t_out;
@@ -58,7 +429,12 @@ public:
     sc_signal <axi4_lite_master> axi_i_out;
     sc_signal <axi4_lite_slave>  axi_i_in;
 
+    sc_signal <axi4_master>      axi_dma_out;
+    sc_signal <axi4_slave>       axi_dma_in;
+
     sc_signal < sc_uint <32> >   intr_in;
+    sc_signal < sc_uint <32> >   periph_intr;
+    sc_signal < sc_uint <32> >   tb_intr;
 
 
     //-----------------------------------------------------------------
@@ -70,6 +446,12 @@ public:
         int64_t        max_cycles     = (int64_t)-1;
         const char *   filename       = NULL;
         int            help           = 0;
+        uint32_t       irq_period     = 0;
+        int            irq_line       = 0;
+        uint32_t       bench_bytes    = 0;
+        const char *   blk_file       = NULL;
+        const char *   uart_file      = NULL;
+        const char *   test_name      = NULL;
         int c;        
 
         int option_index = 0;
@@ -83,6 +465,27 @@ public:
                 case 'c':
                     max_cycles = (int64_t)strtoull(optarg, NULL, 0);
                     break;
+                case 'i':
+                    irq_period = (uint32_t)strtoul(optarg, NULL, 0);
+                    break;
+                case 'l':
+                    irq_line = (int)strtoul(optarg, NULL, 0) & 31;
+                    break;
+                case 'd':
+                    bench_bytes = (uint32_t)strtoul(optarg, NULL, 0);
+                    break;
+                case 'b':
+                    blk_file = optarg;
+                    break;
+                case 'u':
+                    uart_file = optarg;
+                    break;
+                case 't':
+                    test_name = optarg;
+                    break;
+                case 'n':
+                    m_idle_skip = false;
+                    break;
                 case '?':
                 default:
                     help = 1;   
@@ -90,7 +493,7 @@ public:
             }
         }        
 
-        if (help || filename == NULL)
+        if (help || (filename == NULL && bench_bytes == 0 && test_name == NULL))
         {
             help_options();
             sc_stop();
@@ -99,49 +502,589 @@ public:
 
         // Force CPU into reset
         rst_cpu_in.write(true);
-        
-        // Load Firmware
-        printf("Running: %s\n", filename);
-        elf_load elf(filename, this);
-        if (!elf.load())
+
+        // Peripherals
+        m_clint->set_tick(clock_period());
+
+        // The RTL CLINT (SUPPORT_CLINT=1) counts on the core clock and
+        // is not compensated for skipped cycles
+        if (get_clint() && m_idle_skip)
+        {
+            printf("Idle skip: disabled (SUPPORT_CLINT)\n");
+            m_idle_skip = false;
+        }
+
+        if (blk_file && !m_blk.open(blk_file))
         {
-            fprintf (stderr,"Error: Could not open %s\n", filename);
+            fprintf (stderr,"Error: Could not open block device %s\n", blk_file);
             sc_stop();
+            return;
+        }
+
+        if (uart_file && !m_uart.load_rx(uart_file))
+        {
+            fprintf (stderr,"Error: Could not open %s\n", uart_file);
+            sc_stop();
+            return;
+        }
+
+        // Self test program + data
+        if (test_name)
+        {
+            if (!self_test_setup(test_name))
+            {
+                sc_stop();
+                return;
+            }
+
+            if (max_cycles == -1)
+                max_cycles = TEST_MAX_CYCLES;
+        }
+        // Bench program + descriptors
+        else if (bench_bytes)
+        {
+            if (!dma_bench_setup(bench_bytes))
+            {
+                sc_stop();
+                return;
+            }
+
+            if (max_cycles == -1)
+                max_cycles = BENCH_MAX_CYCLES;
+        }
+        // Load Firmware
+        else
+        {
+            printf("Running: %s\n", filename);
+            elf_load elf(filename, this);
+            if (!elf.load())
+            {
+                fprintf (stderr,"Error: Could not open %s\n", filename);
+                sc_stop();
+            }
         }
         
         // Release CPU reset after TCM memory loaded
         wait();
         rst_cpu_in.write(false);
 
+        // Interrupt latency: intr_in assertion -> trap entry
+        bool     irq_active   = false;
+        uint64_t irq_start    = 0;
+        uint32_t irq_entries  = 0;
+
+        uint32_t host_reqs    = 0;
+
         while (true)
         {
             cycles += 1;
             if (cycles >= max_cycles && max_cycles != -1)
                 break;
 
+            // Semihosting request posted
+            if (get_host_req_count() != host_reqs)
+            {
+                host_reqs = get_host_req_count();
+                m_host.service(get_host_req_addr(), cycles);
+                if (m_host.exit_requested())
+                    exit(m_host.get_exit_code());
+            }
+
+            if (bench_bytes && dma_bench_poll(cycles))
+                break;
+
+            if (m_test && read32(TEST_FLAG) != 0)
+                break;
+
+            if (irq_period)
+            {
+                if (!irq_active && (cycles % irq_period) == 0)
+                {
+                    irq_entries = get_irq_count();
+                    irq_start   = cycles;
+                    irq_active  = true;
+                    tb_intr.write(1u << irq_line);
+                }
+                // Trap taken - release the line (auto-ack)
+                else if (irq_active && get_irq_count() != irq_entries)
+                {
+                    uint64_t latency = cycles - irq_start;
+                    m_irq_lat_count += 1;
+                    m_irq_lat_total += latency;
+                    if (latency < m_irq_lat_min) m_irq_lat_min = latency;
+                    if (latency > m_irq_lat_max) m_irq_lat_max = latency;
+
+                    irq_active = false;
+                    tb_intr.write(0);
+                }
+            }
+
             wait();
         }
 
+        if (bench_bytes)
+            dma_bench_report();
+
+        if (m_test && !self_test_report(cycles))
+            exit(1);
+
         sc_stop();        
     }
 
+    //-----------------------------------------------------------------
+    // dma_bench_setup: Load bench program, data and descriptors.
+    // Descriptor 0 copies TCM -> TCM (same job as the CPU memcpy),
+    // descriptor 1 copies external memory -> TCM as 4 rows (2D).
+    //-----------------------------------------------------------------
+    bool dma_bench_setup(uint32_t bytes)
+    {
+        bytes = (bytes + 15) & ~15;
+
+        uint32_t src     = BENCH_DATA;
+        uint32_t cpu_dst = src + bytes;
+        uint32_t dma_dst = src + (2 * bytes);
+        uint32_t ext_dst = src + (3 * bytes);
+        uint32_t row     = bytes / 4;
+
+        if (bytes > 0xFFF0 || (ext_dst + bytes) > mem_size() || bytes > EXT_MEM_SIZE)
+        {
+            fprintf (stderr,"Error: DMA bench size %u too large for TCM\n", bytes);
+            return false;
+        }
+
+        printf("Running: DMA bench (%u bytes)\n", bytes);
+        m_bench_bytes = bytes;
+        m_bench_flag  = 0;
+        for (int i=0;i<5;i++)
+            m_bench_time[i] = 0;
+
+        for (uint32_t i=0;i<sizeof(dma_bench_prog)/sizeof(dma_bench_prog[0]);i++)
+            write32(MEM_BASE + (i * 4), dma_bench_prog[i]);
+
+        for (uint32_t i=0;i<bytes;i+=4)
+        {
+            write32(src + i,     0x12345678 ^ (i * 0x01010101));
+            write32(cpu_dst + i, 0);
+            write32(dma_dst + i, 0);
+            write32(ext_dst + i, 0);
+            m_ext_mem->write32(EXT_MEM_BASE + i, 0x87654321 ^ (i * 0x00010001));
+        }
+
+        write32(BENCH_FLAG,        0);
+        write32(BENCH_PARAMS + 0,  src);
+        write32(BENCH_PARAMS + 4,  cpu_dst);
+        write32(BENCH_PARAMS + 8,  bytes);
+        write32(BENCH_PARAMS + 12, BENCH_DMA_BASE);
+        write32(BENCH_PARAMS + 16, BENCH_DESC0);
+
+        write32(BENCH_DESC0 + 0x00, BENCH_DESC1);
+        write32(BENCH_DESC0 + 0x04, src);
+        write32(BENCH_DESC0 + 0x08, dma_dst);
+        write32(BENCH_DESC0 + 0x0C, bytes);
+        write32(BENCH_DESC0 + 0x10, 0);
+        write32(BENCH_DESC0 + 0x14, 0);
+        write32(BENCH_DESC0 + 0x18, 0);
+
+        write32(BENCH_DESC1 + 0x00, 0);
+        write32(BENCH_DESC1 + 0x04, EXT_MEM_BASE);
+        write32(BENCH_DESC1 + 0x08, ext_dst);
+        write32(BENCH_DESC1 + 0x0C, (4 << 16) | row);
+        write32(BENCH_DESC1 + 0x10, row);
+        write32(BENCH_DESC1 + 0x14, row);
+        write32(BENCH_DESC1 + 0x18, 0);
+        return true;
+    }
+    //-----------------------------------------------------------------
+    // dma_bench_poll: Timestamp progress flag changes, true when done
+    //-----------------------------------------------------------------
+    bool dma_bench_poll(uint64_t cycles)
+    {
+        uint32_t flag = read32(BENCH_FLAG);
+
+        if (flag != m_bench_flag && flag < 5)
+        {
+            m_bench_time[flag] = cycles;
+            m_bench_flag       = flag;
+        }
+
+        return m_bench_flag == 4;
+    }
+    //-----------------------------------------------------------------
+    // dma_bench_report: Check copies and print bytes/cycle
+    //-----------------------------------------------------------------
+    void dma_bench_report(void)
+    {
+        uint32_t bytes   = m_bench_bytes;
+        uint32_t src     = BENCH_DATA;
+        uint32_t cpu_dst = src + bytes;
+        uint32_t dma_dst = src + (2 * bytes);
+        uint32_t ext_dst = src + (3 * bytes);
+        bool     ok      = (m_bench_flag == 4);
+
+        for (uint32_t i=0;i<bytes && ok;i+=4)
+        {
+            ok &= read32(cpu_dst + i) == read32(src + i);
+            ok &= read32(dma_dst + i) == read32(src + i);
+            ok &= read32(ext_dst + i) == m_ext_mem->read32(EXT_MEM_BASE + i);
+        }
+
+        if (m_bench_flag != 4)
+        {
+            printf("DMA bench: did not complete (flag=%u) - is SUPPORT_DMA=1?\n", m_bench_flag);
+            return;
+        }
+
+        uint64_t cpu_cycles = m_bench_time[2] - m_bench_time[1];
+        uint64_t dma_cycles = m_bench_time[3] - m_bench_time[2];
+        uint64_t ext_cycles = m_bench_time[4] - m_bench_time[3];
+
+        printf("DMA bench: %u bytes\n", bytes);
+        printf("  CPU memcpy TCM->TCM:  %8llu cycles, %.2f bytes/cycle\n",
+               (unsigned long long)cpu_cycles, (double)bytes / cpu_cycles);
+        printf("  DMA        TCM->TCM:  %8llu cycles, %.2f bytes/cycle\n",
+               (unsigned long long)dma_cycles, (double)bytes / dma_cycles);
+        printf("  DMA 2D     AXI->TCM:  %8llu cycles, %.2f bytes/cycle\n",
+               (unsigned long long)ext_cycles, (double)bytes / ext_cycles);
+        printf("  Memory: %u read bursts, %u write bursts\n",
+               m_ext_mem->get_read_bursts(), m_ext_mem->get_write_bursts());
+        printf("  Data check: %s\n", ok ? "PASSED" : "FAILED");
+    }
+
+    //-----------------------------------------------------------------
+    // self_test_setup: Load a self test program and its data
+    //-----------------------------------------------------------------
+    bool self_test_setup(const char *name)
+    {
+        m_test = NULL;
+        for (uint32_t i=0;i<sizeof(self_tests)/sizeof(self_tests[0]);i++)
+            if (!strcmp(self_tests[i].name, name))
+                m_test = &self_tests[i];
+
+        if (!m_test)
+        {
+            fprintf (stderr,"Error: Unknown self test %s\n", name);
+            return false;
+        }
+
+        printf("Running: self test %s\n", name);
+
+        for (uint32_t i=0;i<m_test->prog_words;i++)
+            write32(MEM_BASE + (i * 4), m_test->prog[i]);
+
+        for (uint32_t i=0;i<TEST_WORDS;i++)
+        {
+            write32(TEST_DATA + (i * 4),   m_test->data[i]);
+            write32(TEST_RESULT + (i * 4), TEST_POISON);
+        }
+
+        write32(TEST_FLAG, 0);
+        return true;
+    }
+    //-----------------------------------------------------------------
+    // self_test_report: Check results / memory, true if passed
+    //-----------------------------------------------------------------
+    bool self_test_report(uint64_t cycles)
+    {
+        bool ok = true;
+
+        if (read32(TEST_FLAG) == 0)
+        {
+            printf("Self test %s: did not complete\n", m_test->name);
+            return false;
+        }
+
+        for (uint32_t i=0;i<m_test->result_words;i++)
+        {
+            uint32_t value = read32(TEST_RESULT + (i * 4));
+            if (value != m_test->result[i])
+            {
+                printf("  result[%u] = %08x, expected %08x\n", i, value, m_test->result[i]);
+                ok = false;
+            }
+        }
+
+        for (uint32_t i=0;i<m_test->data_words;i++)
+        {
+            uint32_t value = read32(TEST_DATA + (i * 4));
+            if (value != m_test->data_exp[i])
+            {
+                printf("  data[%u] = %08x, expected %08x\n", i, value, m_test->data_exp[i]);
+                ok = false;
+            }
+        }
+
+        printf("Self test %s: %s (%llu cycles)\n", m_test->name, ok ? "PASSED" : "FAILED",
+               (unsigned long long)cycles);
+        return ok;
+    }
+
+    //-----------------------------------------------------------------
+    // clock_gate: Drive clk_dut from clk, stopping it whilst idle
+    //-----------------------------------------------------------------
+    void clock_gate(void)
+    {
+        if (!clk.read())
+        {
+            clk_dut.write(false);
+            return;
+        }
+
+        bool gate = m_idle_skip && core_idle();
+
+        // Waking - account for the cycles the core slept through
+        if (!gate && m_skip_count)
+        {
+            m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_csr__u_csrfile.skip_cycles(m_skip_count);
+            m_skip_total += m_skip_count;
+            m_skip_wakes += 1;
+            m_skip_count  = 0;
+            m_idle_cycles = 0;
+        }
+
+        if (gate)
+            m_skip_count++;
+        else
+            track_axi();
+
+        clk_dut.write(!gate);
+    }
+    //-----------------------------------------------------------------
+    // core_idle: Core asleep in WFI, no interrupt change, nothing
+    // outstanding on its buses and no CSR timer match due.
+    //-----------------------------------------------------------------
+    bool core_idle(void)
+    {
+        uint32_t intr  = periph_intr.read() | tb_intr.read();
+        bool     quiet = !rst.read() && !rst_cpu_in.read() && get_wfi_sleep() && !get_dma_busy() &&
+                         !m_axi_rd_pending && !m_axi_wr_pending && !axi_busy() &&
+                         intr == m_idle_intr;
+
+        if (quiet)
+        {
+            uint32_t timer = get_timer_cycles();
+            quiet = (timer == 0xFFFFFFFF) || ((uint64_t)timer > ((uint64_t)m_skip_count + IDLE_TIMER_LEAD));
+        }
+
+        m_idle_intr = intr;
+
+        // Clock stopped - stay stopped whilst quiet
+        if (m_skip_count)
+            return quiet;
+
+        m_idle_cycles = quiet ? (m_idle_cycles + 1) : 0;
+        return m_idle_cycles > IDLE_SETTLE;
+    }
+    //-----------------------------------------------------------------
+    // axi_busy: Any request / response valid on the core's masters
+    //-----------------------------------------------------------------
+    bool axi_busy(void)
+    {
+        axi4_lite_master i_o = axi_i_out.read();
+        axi4_lite_slave  i_i = axi_i_in.read();
+        axi4_master      d_o = axi_dma_out.read();
+        axi4_slave       d_i = axi_dma_in.read();
+
+        return i_o.AWVALID || i_o.WVALID || i_o.ARVALID || i_i.BVALID || i_i.RVALID ||
+               d_o.AWVALID || d_o.WVALID || d_o.ARVALID || d_i.BVALID || d_i.RVALID;
+    }
+    //-----------------------------------------------------------------
+    // track_axi: Count accepted requests awaiting a response (sampled
+    // on the clock edges the DUT sees)
+    //-----------------------------------------------------------------
+    void track_axi(void)
+    {
+        axi4_lite_master i_o = axi_i_out.read();
+        axi4_lite_slave  i_i = axi_i_in.read();
+        axi4_master      d_o = axi_dma_out.read();
+        axi4_slave       d_i = axi_dma_in.read();
+
+        if (i_o.ARVALID && i_i.ARREADY)                 m_axi_rd_pending++;
+        if (i_i.RVALID  && i_o.RREADY)                  m_axi_rd_pending--;
+        if (i_o.AWVALID && i_i.AWREADY)                 m_axi_wr_pending++;
+        if (i_i.BVALID  && i_o.BREADY)                  m_axi_wr_pending--;
+
+        if (d_o.ARVALID && d_i.ARREADY)                 m_axi_rd_pending++;
+        if (d_i.RVALID  && d_o.RREADY && d_i.RLAST)     m_axi_rd_pending--;
+        if (d_o.AWVALID && d_i.AWREADY)                 m_axi_wr_pending++;
+        if (d_i.BVALID  && d_o.BREADY)                  m_axi_wr_pending--;
+    }
+    //-----------------------------------------------------------------
+    // clock_period: Period of the testbench clock
+    //-----------------------------------------------------------------
+    sc_time clock_period(void)
+    {
+        sc_clock *c = dynamic_cast<sc_clock *>(clk.get_interface());
+        return c ? c->period() : sc_time(10, SC_NS);
+    }
+
+    //-----------------------------------------------------------------
+    // abort: Called on exit (including $finish) - report IRQ latency
+    //-----------------------------------------------------------------
+    void abort(void)
+    {
+        if (m_irq_lat_count)
+        {
+            printf("IRQ latency: %llu interrupts, min %llu, avg %.1f, max %llu cycles\n",
+                   (unsigned long long)m_irq_lat_count, (unsigned long long)m_irq_lat_min,
+                   (double)m_irq_lat_total / m_irq_lat_count, (unsigned long long)m_irq_lat_max);
+            m_irq_lat_count = 0;
+        }
+
+        if (m_skip_wakes)
+        {
+            printf("Idle skip: %llu cycles skipped in %llu WFI sleeps\n",
+                   (unsigned long long)m_skip_total, (unsigned long long)m_skip_wakes);
+            m_skip_wakes = 0;
+        }
+
+        if (get_lsu_pair_count() || get_store_fwd_count())
+            printf("Store buffer: %u paired, %u conflicts, %u forwarded, %u waits\n",
+                   get_lsu_pair_count(), get_lsu_conflict_count(), get_store_fwd_count(), get_store_wait_count());
+
+        testbench_vbase::abort();
+    }
+
+    //-----------------------------------------------------------------
+    // update_intr: Peripheral + generated interrupt lines
+    //-----------------------------------------------------------------
+    void update_intr(void)
+    {
+        intr_in.write(periph_intr.read() | tb_intr.read());
+    }
+
+    uint32_t get_irq_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_csr__u_csrfile.get_irq_count();
+    }
+
     void set_argcv(int argc, char* argv[]) { m_argc = argc; m_argv = argv; }
 
+    bool get_wfi_sleep(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_issue.get_wfi_sleep();
+    }
+    uint32_t get_lsu_pair_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_issue.get_lsu_pair_count();
+    }
+    uint32_t get_lsu_conflict_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_issue.get_lsu_conflict_count();
+    }
+    uint32_t get_store_wait_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_lsu.get_store_wait_count();
+    }
+    uint32_t get_store_fwd_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_lsu.get_store_fwd_count();
+    }
+    bool get_dma_busy(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v.get_dma_busy();
+    }
+    uint32_t get_timer_cycles(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_csr__u_csrfile.get_timer_cycles();
+    }
+    bool get_clint(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v.get_clint();
+    }
+
+    //-----------------------------------------------------------------
+    // Semihosting / exit status
+    //-----------------------------------------------------------------
+    uint32_t get_host_req_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_csr__u_csrfile.get_host_req_count();
+    }
+    uint32_t get_host_req_addr(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_csr__u_csrfile.get_host_req_addr();
+    }
+    int get_exit_code(void)
+    {
+        if (m_host.exit_requested())
+            return m_host.get_exit_code();
+
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_csr__u_csrfile.get_exit_code();
+    }
+
     //-----------------------------------------------------------------
     // Construction
     //-----------------------------------------------------------------
     SC_HAS_PROCESS(testbench);
     testbench(sc_module_name name): testbench_vbase(name)
     {
+        m_irq_lat_count = 0;
+        m_irq_lat_total = 0;
+        m_irq_lat_min   = (uint64_t)-1;
+        m_irq_lat_max   = 0;
+
+        m_host.set_memory(this);
+
+        m_bench_bytes   = 0;
+        m_bench_flag    = 0;
+
+        m_test          = NULL;
+
+        m_idle_skip      = true;
+        m_idle_cycles    = 0;
+        m_idle_intr      = 0;
+        m_skip_count     = 0;
+        m_skip_total     = 0;
+        m_skip_wakes     = 0;
+        m_axi_rd_pending = 0;
+        m_axi_wr_pending = 0;
+
         m_dut = new riscv_tcm_top_rtl("DUT");
-        m_dut->clk_in(clk);
+        m_dut->clk_in(clk_dut);
         m_dut->rst_in(rst);
         m_dut->rst_cpu_in(rst_cpu_in);
         m_dut->axi_t_out(axi_t_out);
         m_dut->axi_t_in(axi_t_in);
         m_dut->axi_i_out(axi_i_out);
         m_dut->axi_i_in(axi_i_in);
+        m_dut->axi_dma_out(axi_dma_out);
+        m_dut->axi_dma_in(axi_dma_in);
         m_dut->intr_in(intr_in);
+
+        // External memory (DMA AXI4 master)
+        m_ext_mem = new tb_axi4_mem("EXT_MEM");
+        m_ext_mem->clk_in(clk_dut);
+        m_ext_mem->rst_in(rst);
+        m_ext_mem->axi_in(axi_dma_out);
+        m_ext_mem->axi_out(axi_dma_in);
+        m_ext_mem->add_region(EXT_MEM_BASE, EXT_MEM_SIZE);
+
+        // Peripherals (AXI4-Lite)
+        m_periph = new tb_periph_bus("PERIPH");
+        m_periph->clk_in(clk_dut);
+        m_periph->rst_in(rst);
+        m_periph->axi_in(axi_i_out);
+        m_periph->axi_out(axi_i_in);
+        m_periph->intr_out(periph_intr);
+
+        m_clint = new tb_periph_clint("CLINT");
+        m_clint->connect_irq(m_periph, IRQ_LINE_MTIP);
+        m_clint->connect_sw_irq(m_periph, IRQ_LINE_MSIP);
+        m_plic.connect_irq(m_periph, IRQ_LINE_PLIC);
+        m_uart.connect_irq(&m_plic, PLIC_SRC_UART);
+        m_blk.connect_irq(&m_plic, PLIC_SRC_BLK);
+        m_blk.set_memory(this);
+
+        m_periph->add_device(CLINT_BASE, CLINT_SIZE, m_clint, "CLINT");
+        m_periph->add_device(PLIC_BASE,  PLIC_SIZE,  &m_plic, "PLIC");
+        m_periph->add_device(UART_BASE,  UART_SIZE,  &m_uart, "UART");
+        m_periph->add_device(BLK_BASE,   BLK_SIZE,   &m_blk,  "BLK");
+
+        SC_METHOD(update_intr);
+        sensitive << periph_intr << tb_intr;
+
+        // DUT + bus models run from the gated clock
+        SC_METHOD(clock_gate);
+        sensitive << clk;
 		
 		verilator_trace_enable("verilator.vcd", m_dut);
     }
@@ -166,10 +1109,17 @@ public:
     //-----------------------------------------------------------------
     bool create_memory(uint32_t base, uint32_t size, uint8_t *mem = NULL)
     {
-        sc_assert(base >= MEM_BASE && ((base + size) < (MEM_BASE + MEM_SIZE)));
+        sc_assert(base >= MEM_BASE && ((base + size) < (MEM_BASE + mem_size())));
         return true;
     }
     //-----------------------------------------------------------------
+    // mem_size: TCM size (from the RTL parameters)
+    //-----------------------------------------------------------------
+    uint32_t mem_size(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_tcm.get_size();
+    }
+    //-----------------------------------------------------------------
     // valid_addr: Check address range
     //-----------------------------------------------------------------
     bool valid_addr(uint32_t addr) { return true; } 
@@ -187,4 +1137,19 @@ public:
     {
         return m_dut->m_rtl->__VlSymsp->TOP__v__u_tcm.read(addr);
     }
+    //-----------------------------------------------------------------
+    // write32 / read32: Word access (little endian)
+    //-----------------------------------------------------------------
+    void write32(uint32_t addr, uint32_t data)
+    {
+        for (int i=0;i<4;i++)
+            write(addr + i, data >> (8 * i));
+    }
+    uint32_t read32(uint32_t addr)
+    {
+        uint32_t data = 0;
+        for (int i=0;i<4;i++)
+            data |= ((uint32_t)read(addr + i)) << (8 * i);
+        return data;
+    }
 };
@@ -5,7 +5,10 @@
 // Defines
 //--------------------------------------------------------------------
 #define AXI4_ADDR_W        32
+#ifndef AXI4_DATA_W
 #define AXI4_DATA_W        32
+#endif
+#define AXI4_STRB_W        (AXI4_DATA_W/8)
 #define AXI4_AXLEN_W        8
 #define AXI4_AXBURST_W      2
 #define AXI4_RESP_W         2
@@ -62,8 +62,8 @@ static void exit_override(void)
 //--------------------------------------------------------------------
 void vl_finish (const char* filename, int linenum, const char* hier)
 { 
-    // Jump to exit handler!
-    exit(0);    
+    // Jump to exit handler (with the exit code from SIM_CTRL / semihosting)
+    exit(tb ? tb->get_exit_code() : 0);    
 }
 //-----------------------------------------------------------------
 // sigint_handler
@@ -69,7 +69,7 @@ private:
     sc_signal <sc_uint<4> > m_axi_i_bid_in;
     sc_signal <bool> m_axi_i_arready_in;
     sc_signal <bool> m_axi_i_rvalid_in;
-    sc_signal <sc_uint<32> > m_axi_i_rdata_in;
+    sc_signal <axi4_data_t > m_axi_i_rdata_in;
     sc_signal <sc_uint<2> > m_axi_i_rresp_in;
     sc_signal <sc_uint<4> > m_axi_i_rid_in;
     sc_signal <bool> m_axi_i_rlast_in;
@@ -80,7 +80,7 @@ private:
     sc_signal <sc_uint<4> > m_axi_d_bid_in;
     sc_signal <bool> m_axi_d_arready_in;
     sc_signal <bool> m_axi_d_rvalid_in;
-    sc_signal <sc_uint<32> > m_axi_d_rdata_in;
+    sc_signal <axi4_data_t > m_axi_d_rdata_in;
     sc_signal <sc_uint<2> > m_axi_d_rresp_in;
     sc_signal <sc_uint<4> > m_axi_d_rid_in;
     sc_signal <bool> m_axi_d_rlast_in;
@@ -93,8 +93,8 @@ private:
     sc_signal <sc_uint<8> > m_axi_i_awlen_out;
     sc_signal <sc_uint<2> > m_axi_i_awburst_out;
     sc_signal <bool> m_axi_i_wvalid_out;
-    sc_signal <sc_uint<32> > m_axi_i_wdata_out;
-    sc_signal <sc_uint<4> > m_axi_i_wstrb_out;
+    sc_signal <axi4_data_t > m_axi_i_wdata_out;
+    sc_signal <axi4_strb_t > m_axi_i_wstrb_out;
     sc_signal <bool> m_axi_i_wlast_out;
     sc_signal <bool> m_axi_i_bready_out;
     sc_signal <bool> m_axi_i_arvalid_out;
@@ -109,8 +109,8 @@ private:
     sc_signal <sc_uint<8> > m_axi_d_awlen_out;
     sc_signal <sc_uint<2> > m_axi_d_awburst_out;
     sc_signal <bool> m_axi_d_wvalid_out;
-    sc_signal <sc_uint<32> > m_axi_d_wdata_out;
-    sc_signal <sc_uint<4> > m_axi_d_wstrb_out;
+    sc_signal <axi4_data_t > m_axi_d_wdata_out;
+    sc_signal <axi4_strb_t > m_axi_d_wstrb_out;
     sc_signal <bool> m_axi_d_wlast_out;
     sc_signal <bool> m_axi_d_bready_out;
     sc_signal <bool> m_axi_d_arvalid_out;
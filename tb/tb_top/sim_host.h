@@ -0,0 +1,185 @@
+#ifndef SIM_HOST_H
+#define SIM_HOST_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include "mem_api.h"
+
+//-----------------------------------------------------------------
+// Semihosting request block (word offsets), posted by writing its
+// address to CSR_SIM_HOST (0x8b3).  Firmware fills in OP / ARGx,
+// clears DONE, writes the CSR and spins until DONE is non-zero.
+//-----------------------------------------------------------------
+#define SIM_HOST_OP         0x00
+#define SIM_HOST_ARG0       0x04
+#define SIM_HOST_ARG1       0x08
+#define SIM_HOST_ARG2       0x0C
+#define SIM_HOST_RESULT     0x10
+#define SIM_HOST_DONE       0x14
+
+enum eSIM_HOST_OP
+{
+    SIM_HOST_WRITE = 1, // ARG0=fd, ARG1=buf, ARG2=len -> bytes written
+    SIM_HOST_READ  = 2, // ARG0=fd, ARG1=buf, ARG2=len -> bytes read
+    SIM_HOST_OPEN  = 3, // ARG0=path, ARG1=mode (0 read, 1 write, 2 append) -> fd
+    SIM_HOST_CLOSE = 4, // ARG0=fd -> 0
+    SIM_HOST_CLOCK = 5, // -> cycles[31:0], ARG0 <- cycles[63:32]
+    SIM_HOST_EXIT  = 6  // ARG0=exit code
+};
+
+#define SIM_HOST_MAX_FILES  16
+#define SIM_HOST_MAX_PATH   256
+
+//-----------------------------------------------------------------
+// sim_host: Services semihosting requests from simulated memory
+//-----------------------------------------------------------------
+class sim_host
+{
+public:
+    sim_host()
+    {
+        m_mem       = NULL;
+        m_exit      = false;
+        m_exit_code = 0;
+        m_requests  = 0;
+
+        for (int i=0;i<SIM_HOST_MAX_FILES;i++)
+            m_files[i] = NULL;
+
+        m_files[0] = stdin;
+        m_files[1] = stdout;
+        m_files[2] = stderr;
+    }
+
+    void     set_memory(mem_api *mem) { m_mem = mem; }
+    bool     exit_requested(void)     { return m_exit; }
+    int      get_exit_code(void)      { return m_exit_code; }
+    uint32_t get_requests(void)       { return m_requests; }
+
+    //-------------------------------------------------------------
+    // service: Handle request block at addr
+    //-------------------------------------------------------------
+    void service(uint32_t addr, uint64_t cycles)
+    {
+        uint32_t op     = read32(addr + SIM_HOST_OP);
+        uint32_t arg0   = read32(addr + SIM_HOST_ARG0);
+        uint32_t arg1   = read32(addr + SIM_HOST_ARG1);
+        uint32_t arg2   = read32(addr + SIM_HOST_ARG2);
+        int32_t  result = -1;
+
+        m_requests++;
+
+        switch (op)
+        {
+            case SIM_HOST_WRITE:
+            {
+                FILE *f = get_file(arg0);
+                if (f && arg2)
+                {
+                    std::vector <uint8_t> buf(arg2);
+                    for (uint32_t i=0;i<arg2;i++)
+                        buf[i] = m_mem->read(arg1 + i);
+                    result = (int32_t)fwrite(&buf[0], 1, arg2, f);
+                }
+                else if (f)
+                    result = 0;
+            }
+            break;
+            case SIM_HOST_READ:
+            {
+                FILE *f = get_file(arg0);
+                if (f && arg2)
+                {
+                    std::vector <uint8_t> buf(arg2);
+                    result = (int32_t)fread(&buf[0], 1, arg2, f);
+                    for (int32_t i=0;i<result;i++)
+                        m_mem->write(arg1 + i, buf[i]);
+                }
+                else if (f)
+                    result = 0;
+            }
+            break;
+            case SIM_HOST_OPEN:
+            {
+                char path[SIM_HOST_MAX_PATH];
+                int  i;
+                for (i=0;i<SIM_HOST_MAX_PATH-1;i++)
+                    if ((path[i] = (char)m_mem->read(arg0 + i)) == 0)
+                        break;
+                path[i] = 0;
+
+                const char *mode = (arg1 == 1) ? "wb" : (arg1 == 2) ? "ab" : "rb";
+
+                for (int fd=3;fd<SIM_HOST_MAX_FILES;fd++)
+                    if (!m_files[fd])
+                    {
+                        m_files[fd] = fopen(path, mode);
+                        if (m_files[fd])
+                            result = fd;
+                        break;
+                    }
+            }
+            break;
+            case SIM_HOST_CLOSE:
+                if (arg0 >= 3 && get_file(arg0))
+                {
+                    fclose(m_files[arg0]);
+                    m_files[arg0] = NULL;
+                    result = 0;
+                }
+            break;
+            case SIM_HOST_CLOCK:
+                write32(addr + SIM_HOST_ARG0, (uint32_t)(cycles >> 32));
+                result = (int32_t)(uint32_t)cycles;
+            break;
+            case SIM_HOST_EXIT:
+                m_exit      = true;
+                m_exit_code = (int)arg0;
+                result      = 0;
+            break;
+            default:
+                fprintf(stderr, "SIM_HOST: Unknown request %u @ 0x%08x\n", op, addr);
+            break;
+        }
+
+        write32(addr + SIM_HOST_RESULT, (uint32_t)result);
+        write32(addr + SIM_HOST_DONE,   1);
+    }
+
+    //-------------------------------------------------------------
+    // flush: Flush host side output streams
+    //-------------------------------------------------------------
+    void flush(void)
+    {
+        for (int i=1;i<SIM_HOST_MAX_FILES;i++)
+            if (m_files[i])
+                fflush(m_files[i]);
+    }
+
+protected:
+    FILE *get_file(uint32_t fd) { return (fd < SIM_HOST_MAX_FILES) ? m_files[fd] : NULL; }
+
+    uint32_t read32(uint32_t addr)
+    {
+        uint32_t data = 0;
+        for (int i=0;i<4;i++)
+            data |= ((uint32_t)m_mem->read(addr + i)) << (8 * i);
+        return data;
+    }
+
+    void write32(uint32_t addr, uint32_t data)
+    {
+        for (int i=0;i<4;i++)
+            m_mem->write(addr + i, data >> (8 * i));
+    }
+
+protected:
+    mem_api  *m_mem;
+    FILE     *m_files[SIM_HOST_MAX_FILES];
+    bool      m_exit;
+    int       m_exit_code;
+    uint32_t  m_requests;
+};
+
+#endif
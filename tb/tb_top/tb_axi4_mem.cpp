@@ -8,6 +8,8 @@ void tb_axi4_mem::process(void)
 {
     std::queue <axi4_master> axi_rd_q;
     std::queue <axi4_master> axi_wr_q;
+    std::queue <uint64_t>    axi_rd_time_q;
+    std::queue <uint64_t>    axi_wr_time_q;
 
     axi4_master axi_wr_req;
 
@@ -22,6 +24,8 @@ void tb_axi4_mem::process(void)
             sc_uint <AXI4_ADDR_W> next_addr = axi_i.ARADDR & ~calc_wrap_mask(0);
             axi4_master           axi_first = axi_i;
 
+            m_rd_bursts++;
+
             // Unroll burst
             for (int i=0;i<((int)(axi_first.ARLEN) + 1);i++)
             {
@@ -32,6 +36,7 @@ void tb_axi4_mem::process(void)
                 item.WLAST    = (i == axi_first.ARLEN);
 
                 axi_rd_q.push(item);
+                axi_rd_time_q.push(m_cycles + m_latency);
 
                 // Generate next address
                 next_addr = calc_next_addr(next_addr, axi_first.ARBURST, axi_first.ARLEN);
@@ -43,6 +48,7 @@ void tb_axi4_mem::process(void)
         {
             // Record command
             axi_wr_req = axi_i;
+            m_wr_bursts++;
         }
 
         // Write data
@@ -61,6 +67,7 @@ void tb_axi4_mem::process(void)
             item.WLAST   = axi_i.WLAST;
 
             axi_wr_q.push(item);
+            axi_wr_time_q.push(m_cycles + m_latency);
 
             // Generate next address
             axi_wr_req.AWADDR = calc_next_addr(axi_wr_req.AWADDR, axi_wr_req.AWBURST, axi_wr_req.AWLEN);
@@ -79,13 +86,14 @@ void tb_axi4_mem::process(void)
             axi_o.RLAST  = false;
         }
 
-        if (!axi_o.RVALID && axi_rd_q.size() > 0 && !delay_cycle())
+        if (!axi_o.RVALID && axi_rd_q.size() > 0 && axi_rd_time_q.front() <= m_cycles && !delay_cycle())
         {
             axi4_master item = axi_rd_q.front();
             axi_rd_q.pop();
+            axi_rd_time_q.pop();
 
             axi_o.RVALID = true;
-            axi_o.RDATA  = read32((uint32_t)item.ARADDR);
+            axi_o.RDATA  = read_beat((uint32_t)item.ARADDR);
             axi_o.RID    = item.ARID;
             axi_o.RLAST  = item.WLAST;
             axi_o.RRESP  = AXI4_RESP_OKAY;
@@ -98,12 +106,13 @@ void tb_axi4_mem::process(void)
             axi_o.BRESP  = 0;
         }
 
-        if (!axi_o.BVALID && axi_wr_q.size() > 0 && !delay_cycle())
+        if (!axi_o.BVALID && axi_wr_q.size() > 0 && axi_wr_time_q.front() <= m_cycles && !delay_cycle())
         {
             axi4_master item = axi_wr_q.front();
             axi_wr_q.pop();
+            axi_wr_time_q.pop();
 
-            write32((uint32_t)item.AWADDR, (uint32_t)item.WDATA, (uint8_t)item.WSTRB);
+            write_beat((uint32_t)item.AWADDR, item.WDATA, item.WSTRB);
 
             axi_o.BVALID = item.WLAST;
             axi_o.BID    = item.AWID;
@@ -118,6 +127,7 @@ void tb_axi4_mem::process(void)
 
         axi_out.write(axi_o);
 
+        m_cycles++;
         wait();
     }
 }
@@ -126,7 +136,7 @@ void tb_axi4_mem::process(void)
 //-----------------------------------------------------------------
 sc_uint <AXI4_ADDR_W> tb_axi4_mem::calc_next_addr(sc_uint <AXI4_ADDR_W> addr, sc_uint <AXI4_AXBURST_W> type, sc_uint <AXI4_AXLEN_W> len)
 {
-    sc_uint <AXI4_AXLEN_W> mask = calc_wrap_mask(len);
+    sc_uint <AXI4_ADDR_W> mask = calc_wrap_mask(len);
 
     switch (type)
     {
@@ -144,21 +154,21 @@ sc_uint <AXI4_ADDR_W> tb_axi4_mem::calc_next_addr(sc_uint <AXI4_ADDR_W> addr, sc
 //-----------------------------------------------------------------
 // calc_wrap_mask: Calculate wrap mask for wrapping bursts
 //-----------------------------------------------------------------
-sc_uint <AXI4_AXLEN_W> tb_axi4_mem::calc_wrap_mask(sc_uint <AXI4_AXLEN_W> len)
+sc_uint <AXI4_ADDR_W> tb_axi4_mem::calc_wrap_mask(sc_uint <AXI4_AXLEN_W> len)
 {
     switch (len)
     {
       case (1 - 1):
-          return 0x03;
+          return (1 * (AXI4_DATA_W/8)) - 1;
       case (2 - 1):
-          return 0x07;
+          return (2 * (AXI4_DATA_W/8)) - 1;
       case (4 - 1):
-          return 0x0F;
+          return (4 * (AXI4_DATA_W/8)) - 1;
       case (8 - 1):
-          return 0x1F;
+          return (8 * (AXI4_DATA_W/8)) - 1;
       case (16 - 1):
       default:
-          return 0x3F;
+          return (16 * (AXI4_DATA_W/8)) - 1;
     }
 
     return 0; // Invalid
@@ -183,6 +193,30 @@ uint32_t tb_axi4_mem::read32(uint32_t addr)
     return data;
 }
 //-----------------------------------------------------------------
+// write_beat: Write a bus width beat to memory (byte lanes from addr)
+//-----------------------------------------------------------------
+void tb_axi4_mem::write_beat(uint32_t addr, axi4_data_t data, axi4_strb_t strb)
+{
+    addr &= ~(uint32_t)(AXI4_STRB_W - 1);
+
+    for (int i=0;i<AXI4_STRB_W;i++)
+        if (strb[i])
+            tb_memory::write(addr + i, (uint8_t)data.range(i*8+7, i*8).to_uint());
+}
+//-----------------------------------------------------------------
+// read_beat: Read a bus width beat from memory (byte lanes from addr)
+//-----------------------------------------------------------------
+axi4_data_t tb_axi4_mem::read_beat(uint32_t addr)
+{
+    axi4_data_t data = 0;
+
+    addr &= ~(uint32_t)(AXI4_STRB_W - 1);
+
+    for (int i=0;i<AXI4_STRB_W;i++)
+        data.range(i*8+7, i*8) = tb_memory::read(addr + i);
+    return data;
+}
+//-----------------------------------------------------------------
 // write: Byte write
 //-----------------------------------------------------------------
 void tb_axi4_mem::write(uint32_t addr, uint8_t data)
@@ -1,9 +1,12 @@
 #include "testbench_vbase.h"
 #include "elf_load.h"
+#include "sim_host.h"
 #include <getopt.h>
 #include <unistd.h>
 
 #include "riscv_top.h"
+#include "Vriscv_top.h"
+#include "Vriscv_top__Syms.h"
 #include "tb_axi4_mem.h"
 
 #include "verilated.h"
@@ -11,15 +14,24 @@
 
 #define MEM_BASE 0x80000000
 
+#ifndef DCACHE_PREFETCH
+    #define DCACHE_PREFETCH 0
+#endif
+
+#ifndef L2_ENABLE
+    #define L2_ENABLE 0
+#endif
+
 //-----------------------------------------------------------------
 // Command line options
 //-----------------------------------------------------------------
-#define GETOPTS_ARGS "f:c:h"
+#define GETOPTS_ARGS "f:c:l:h"
 
 static struct option long_options[] =
 {
     {"elf",        required_argument, 0, 'f'},
     {"cycles",     required_argument, 0, 'c'},
+    {"latency",    required_argument, 0, 'l'},
     {"help",       no_argument,       0, 'h'},
     {0, 0, 0, 0}
 };
@@ -29,6 +41,7 @@ static void help_options(void)
     fprintf (stderr,"Usage:\n");
     fprintf (stderr,"  --elf         | -f FILE       File to load\n");
     fprintf (stderr,"  --cycles      | -c NUM        Max instructions to execute\n");
+    fprintf (stderr,"  --latency     | -l NUM        Memory latency (cycles)\n");
     exit(-1);
 }
 
@@ -48,6 +61,8 @@ public:
     int                          m_argc;
     char**                       m_argv;
 
+    sim_host                     m_host;
+
     sc_signal <axi4_slave>      mem_i_in;
     sc_signal <axi4_master>     mem_i_out;
 
@@ -58,12 +73,13 @@ public:
 
     sc_signal < sc_uint <32> >  reset_vector_in;
 
+    uint64_t                    m_cycles;
+
     //-----------------------------------------------------------------
     // process: Main loop for CPU execution
     //-----------------------------------------------------------------
     void process(void) 
     {
-        uint64_t       cycles         = 0;
         int64_t        max_cycles     = (int64_t)-1;
         const char *   filename       = NULL;
         int            help           = 0;
@@ -80,6 +96,10 @@ public:
                 case 'c':
                     max_cycles = (int64_t)strtoull(optarg, NULL, 0);
                     break;
+                case 'l':
+                    m_icache_mem->set_latency((int)strtoul(optarg, NULL, 0));
+                    m_dcache_mem->set_latency((int)strtoul(optarg, NULL, 0));
+                    break;
                 case '?':
                 default:
                     help = 1;   
@@ -106,26 +126,138 @@ public:
         // Set reset vector
         reset_vector_in.write(MEM_BASE);
         
+        uint32_t host_reqs = 0;
+
         while (true)
         {
-            cycles += 1;
-            if (cycles >= max_cycles && max_cycles != -1)
+            m_cycles += 1;
+            if (m_cycles >= max_cycles && max_cycles != -1)
                 break;
 
+            // Semihosting request posted
+            if (get_host_req_count() != host_reqs)
+            {
+                host_reqs = get_host_req_count();
+                m_host.service(get_host_req_addr(), m_cycles);
+                if (m_host.exit_requested())
+                    exit(m_host.get_exit_code());
+            }
+
             wait();
         }
 
         sc_stop();        
     }
 
+    //-----------------------------------------------------------------
+    // abort: Called on exit (including $finish) - report memory traffic
+    // and cache / TLB statistics
+    //-----------------------------------------------------------------
+    void abort(void)
+    {
+        printf("Cycles: %llu\n", (unsigned long long)m_cycles);
+        printf("Memory: %u read bursts, %u write bursts\n",
+               m_icache_mem->get_read_bursts() + m_dcache_mem->get_read_bursts(),
+               m_icache_mem->get_write_bursts() + m_dcache_mem->get_write_bursts());
+#if L2_ENABLE
+        printf("L2: %u hits, %u misses, %u evictions\n",
+               get_l2_hit_count(), get_l2_miss_count(), get_l2_evict_count());
+#endif
+
+        uint32_t accesses = get_dcache_access_count();
+        uint32_t hits     = get_dcache_hit_count();
+        if (accesses)
+            printf("DCache: %u accesses, %u hits (%.1f%%)\n",
+                   accesses, hits, (100.0 * hits) / accesses);
+
+#if DCACHE_PREFETCH
+        uint32_t issued   = get_prefetch_issued();
+        uint32_t useful   = get_prefetch_useful();
+        printf("Prefetch: %u issued, %u useful (%.1f%%)\n",
+               issued, useful, issued ? ((100.0 * useful) / issued) : 0.0);
+#endif
+
+        if (get_itlb_miss_count() || get_dtlb_miss_count())
+            printf("TLB: %u ITLB misses, %u DTLB misses\n",
+                   get_itlb_miss_count(), get_dtlb_miss_count());
+
+        testbench_vbase::abort();
+    }
+
     void set_argcv(int argc, char* argv[]) { m_argc = argc; m_argv = argv; }
 
+    //-----------------------------------------------------------------
+    // Cache / TLB statistics
+    //-----------------------------------------------------------------
+    uint32_t get_dcache_access_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_dcache__u_core.get_access_count();
+    }
+    uint32_t get_dcache_hit_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_dcache__u_core.get_hit_count();
+    }
+#if DCACHE_PREFETCH
+    uint32_t get_prefetch_issued(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_dcache__u_core__PREFETCH__u_prefetch.get_prefetch_issued();
+    }
+    uint32_t get_prefetch_useful(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_dcache__u_core__PREFETCH__u_prefetch.get_prefetch_useful();
+    }
+#endif
+#if L2_ENABLE
+    uint32_t get_l2_hit_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__L2__u_l2.get_hit_count();
+    }
+    uint32_t get_l2_miss_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__L2__u_l2.get_miss_count();
+    }
+    uint32_t get_l2_evict_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__L2__u_l2.get_evict_count();
+    }
+#endif
+    uint32_t get_itlb_miss_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_mmu.get_itlb_miss_count();
+    }
+    uint32_t get_dtlb_miss_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_mmu.get_dtlb_miss_count();
+    }
+
+    //-----------------------------------------------------------------
+    // Semihosting / exit status
+    //-----------------------------------------------------------------
+    uint32_t get_host_req_count(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_csr__u_csrfile.get_host_req_count();
+    }
+    uint32_t get_host_req_addr(void)
+    {
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_csr__u_csrfile.get_host_req_addr();
+    }
+    int get_exit_code(void)
+    {
+        if (m_host.exit_requested())
+            return m_host.get_exit_code();
+
+        return m_dut->m_rtl->__VlSymsp->TOP__v__u_core__u_csr__u_csrfile.get_exit_code();
+    }
+
     //-----------------------------------------------------------------
     // Construction
     //-----------------------------------------------------------------
     SC_HAS_PROCESS(testbench);
     testbench(sc_module_name name): testbench_vbase(name)
     {
+        m_cycles = 0;
+        m_host.set_memory(this);
+
         m_dut = new riscv_top("DUT");
         m_dut->clk_in(clk);
         m_dut->rst_in(rst);